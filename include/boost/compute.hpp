@@ -21,6 +21,7 @@
 #include <boost/compute/container.hpp>
 #include <boost/compute/context.hpp>
 #include <boost/compute/device.hpp>
+#include <boost/compute/fft.hpp>
 #include <boost/compute/functional.hpp>
 #include <boost/compute/image.hpp>
 #include <boost/compute/iterator.hpp>
@@ -36,6 +37,7 @@
 #include <boost/compute/user_event.hpp>
 #include <boost/compute/utility.hpp>
 #include <boost/compute/version.hpp>
+#include <boost/compute/view.hpp>
 
 #ifdef BOOST_COMPUTE_HAVE_HDR_CL_EXT
 #include <boost/compute/cl_ext.hpp>
@@ -40,6 +40,7 @@
 #include <boost/compute/algorithm/gather.hpp>
 #include <boost/compute/algorithm/generate.hpp>
 #include <boost/compute/algorithm/generate_n.hpp>
+#include <boost/compute/algorithm/histogram.hpp>
 #include <boost/compute/algorithm/inclusive_scan.hpp>
 #include <boost/compute/algorithm/includes.hpp>
 #include <boost/compute/algorithm/inner_product.hpp>
@@ -65,6 +66,7 @@
 #include <boost/compute/algorithm/reduce.hpp>
 #include <boost/compute/algorithm/reduce_by_key.hpp>
 #include <boost/compute/algorithm/remove.hpp>
+#include <boost/compute/algorithm/remove_copy_if.hpp>
 #include <boost/compute/algorithm/remove_if.hpp>
 #include <boost/compute/algorithm/replace.hpp>
 #include <boost/compute/algorithm/replace_copy.hpp>
@@ -72,8 +74,11 @@
 #include <boost/compute/algorithm/reverse_copy.hpp>
 #include <boost/compute/algorithm/rotate.hpp>
 #include <boost/compute/algorithm/rotate_copy.hpp>
+#include <boost/compute/algorithm/run_length_decode.hpp>
+#include <boost/compute/algorithm/run_length_encode.hpp>
 #include <boost/compute/algorithm/scatter.hpp>
 #include <boost/compute/algorithm/search.hpp>
+#include <boost/compute/algorithm/search_any.hpp>
 #include <boost/compute/algorithm/search_n.hpp>
 #include <boost/compute/algorithm/set_difference.hpp>
 #include <boost/compute/algorithm/set_intersection.hpp>
@@ -20,6 +20,7 @@
 #include <boost/compute/algorithm/detail/serial_accumulate.hpp>
 #include <boost/compute/container/array.hpp>
 #include <boost/compute/container/vector.hpp>
+#include <boost/compute/detail/command_tracer.hpp>
 #include <boost/compute/detail/iterator_range_size.hpp>
 
 namespace boost {
@@ -167,6 +168,8 @@ inline T accumulate(InputIterator first,
                     BinaryFunction function,
                     command_queue &queue = system::default_queue())
 {
+    detail::trace_scope trace("accumulate");
+
     return detail::dispatch_accumulate(first, last, init, function, queue);
 }
 
@@ -177,6 +180,8 @@ inline T accumulate(InputIterator first,
                     T init,
                     command_queue &queue = system::default_queue())
 {
+    detail::trace_scope trace("accumulate");
+
     typedef typename std::iterator_traits<InputIterator>::value_type IT;
 
     return detail::dispatch_accumulate(first, last, init, plus<IT>(), queue);
@@ -14,6 +14,8 @@
 #include <boost/compute/system.hpp>
 #include <boost/compute/command_queue.hpp>
 #include <boost/compute/algorithm/lower_bound.hpp>
+#include <boost/compute/algorithm/detail/vectorized_binary_search.hpp>
+#include <boost/compute/detail/iterator_range_size.hpp>
 
 namespace boost {
 namespace compute {
@@ -33,6 +35,27 @@ inline bool binary_search(InputIterator first,
     return position != last && position.read(queue) == value;
 }
 
+/// Searches the sorted range [\p first, \p last) for each value in the
+/// range [\p needles_first, \p needles_last) and stores \c 1 in
+/// \p result if the value was found or \c 0 otherwise.
+///
+/// Space complexity: \Omega(1) for small batches, \Omega(m) otherwise
+template<class InputIterator, class NeedleIterator, class OutputIterator>
+inline OutputIterator
+binary_search(InputIterator first,
+              InputIterator last,
+              NeedleIterator needles_first,
+              NeedleIterator needles_last,
+              OutputIterator result,
+              command_queue &queue = system::default_queue())
+{
+    detail::vectorized_search(first, last, needles_first, needles_last,
+                              detail::vectorized_binary_search,
+                              result, result, queue);
+
+    return result + detail::iterator_range_size(needles_first, needles_last);
+}
+
 } // end compute namespace
 } // end boost namespace
 
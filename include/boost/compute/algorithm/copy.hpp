@@ -28,6 +28,7 @@
 #include <boost/compute/algorithm/detail/copy_to_host.hpp>
 #include <boost/compute/async/future.hpp>
 #include <boost/compute/container/mapped_view.hpp>
+#include <boost/compute/detail/command_tracer.hpp>
 #include <boost/compute/detail/device_ptr.hpp>
 #include <boost/compute/detail/is_contiguous_iterator.hpp>
 #include <boost/compute/detail/iterator_range_size.hpp>
@@ -835,6 +836,8 @@ inline OutputIterator copy(InputIterator first,
                            OutputIterator result,
                            command_queue &queue = system::default_queue())
 {
+    detail::trace_scope trace("copy");
+
     return detail::dispatch_copy(first, last, result, queue);
 }
 
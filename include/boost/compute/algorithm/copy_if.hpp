@@ -11,7 +11,18 @@
 #ifndef BOOST_COMPUTE_ALGORITHM_COPY_IF_HPP
 #define BOOST_COMPUTE_ALGORITHM_COPY_IF_HPP
 
+#include <vector>
+
+#include <boost/compute/multi_queue.hpp>
+#include <boost/compute/algorithm/copy.hpp>
+#include <boost/compute/algorithm/exclusive_scan.hpp>
+#include <boost/compute/algorithm/fill_n.hpp>
 #include <boost/compute/algorithm/transform_if.hpp>
+#include <boost/compute/algorithm/detail/multi_device.hpp>
+#include <boost/compute/container/vector.hpp>
+#include <boost/compute/detail/command_tracer.hpp>
+#include <boost/compute/detail/iterator_range_size.hpp>
+#include <boost/compute/detail/meta_kernel.hpp>
 #include <boost/compute/functional/identity.hpp>
 
 namespace boost {
@@ -39,7 +50,7 @@ inline OutputIterator copy_index_if(InputIterator first,
 /// Copies each element in the range [\p first, \p last) for which
 /// \p predicate returns \c true to the range beginning at \p result.
 ///
-/// Space complexity: \Omega(2n)
+/// Space complexity: \Omega(n / 16)
 template<class InputIterator, class OutputIterator, class Predicate>
 inline OutputIterator copy_if(InputIterator first,
                               InputIterator last,
@@ -47,6 +58,8 @@ inline OutputIterator copy_if(InputIterator first,
                               Predicate predicate,
                               command_queue &queue = system::default_queue())
 {
+    detail::trace_scope trace("copy_if");
+
     typedef typename std::iterator_traits<InputIterator>::value_type T;
 
     return ::boost::compute::transform_if(
@@ -54,6 +67,163 @@ inline OutputIterator copy_if(InputIterator first,
     );
 }
 
+/// Copies each element in the range [\p first, \p last) for which
+/// \p predicate returns \c true to the range beginning at \p result. The
+/// copy is performed asynchronously and the returned future holds the end
+/// of the copied elements once the number of copied elements has been read
+/// back.
+///
+/// For example, to copy the positive values and continue with other work
+/// before the end of the output is needed:
+/// \code
+/// future<vector<int>::iterator> end = boost::compute::copy_if_async(
+///     input.begin(), input.end(), output.begin(), _1 > 0, queue
+/// );
+/// ...
+/// size_t count = std::distance(output.begin(), end.get());
+/// \endcode
+///
+/// Space complexity: \Omega(n / 16)
+///
+/// \see copy_if()
+template<class InputIterator, class OutputIterator, class Predicate>
+inline future<OutputIterator>
+copy_if_async(InputIterator first,
+              InputIterator last,
+              OutputIterator result,
+              Predicate predicate,
+              command_queue &queue = system::default_queue())
+{
+    typedef typename std::iterator_traits<InputIterator>::value_type T;
+
+    return ::boost::compute::transform_if_async(
+        first, last, result, identity<T>(), predicate, queue
+    );
+}
+
+/// \overload
+///
+/// Copies the elements with all of the devices in \p queues. Each device
+/// flags and scans its part of the range, the per-device counts are read
+/// back once and then each device copies its values to a temporary buffer.
+/// The values are then copied to their final position in the output range
+/// on the first queue.
+///
+/// Space complexity: \Omega(n)
+///
+/// \see multi_queue
+template<class InputIterator, class OutputIterator, class Predicate>
+inline OutputIterator copy_if(InputIterator first,
+                              InputIterator last,
+                              OutputIterator result,
+                              Predicate predicate,
+                              multi_queue &queues)
+{
+    typedef typename
+        std::iterator_traits<InputIterator>::difference_type
+        input_difference_type;
+    typedef typename
+        std::iterator_traits<OutputIterator>::difference_type
+        difference_type;
+    typedef typename
+        std::iterator_traits<OutputIterator>::value_type
+        output_type;
+
+    const size_t count = detail::iterator_range_size(first, last);
+    if(count == 0){
+        return result;
+    }
+
+    const context context = queues.get_context();
+
+    detail::multi_device_launch launch(queues, count);
+
+    // number of values copied by each device (one for each non-empty part)
+    std::vector<size_t> count_sizes(launch.size(), 0);
+    for(size_t i = 0; i < launch.size(); i++){
+        count_sizes[i] = launch.count(i) ? 1 : 0;
+    }
+
+    // destination index of each value within its device's part
+    detail::multi_device_parts<uint_> indices(context, launch.counts());
+    detail::multi_device_parts<uint_> counts(context, count_sizes);
+
+    for(size_t i = 0; i < launch.size(); i++){
+        if(launch.count(i) == 0){
+            continue;
+        }
+
+        InputIterator part_first =
+            first + static_cast<input_difference_type>(launch.begin(i));
+
+        detail::meta_kernel k1("copy_if_write_flags");
+        k1 << indices.begin(i)[k1.get_global_id(0)] << " = "
+           << predicate(part_first[k1.get_global_id(0)]) << " ? 1 : 0;\n";
+        k1.exec_1d(launch.queue(i), 0, launch.count(i));
+
+        // the last flag is lost by the in-place scan so the count is
+        // computed from the last index and the predicate
+        const uint_ last_index = static_cast<uint_>(launch.count(i) - 1);
+
+        ::boost::compute::exclusive_scan(
+            indices.begin(i), indices.end(i), indices.begin(i), launch.queue(i)
+        );
+
+        detail::meta_kernel k2("copy_if_write_count");
+        size_t last_arg = k2.add_arg<const uint_>("last");
+        k2 << counts.begin(i)[k2.expr<uint_>("0")] << " = "
+           << indices.begin(i)[k2.var<uint_>("last")] << " + ("
+           << predicate(part_first[k2.var<uint_>("last")]) << " ? 1 : 0);\n";
+        k2.set_arg(last_arg, last_index);
+        k2.exec(launch.queue(i));
+    }
+    launch.wait();
+
+    std::vector<uint_> compact_counts(launch.size());
+    counts.copy_to(compact_counts.begin(), queues.get_queue(0));
+
+    std::vector<size_t> host_counts(launch.size(), 0);
+    for(size_t i = 0, j = 0; i < launch.size(); i++){
+        if(launch.count(i)){
+            host_counts[i] = compact_counts[j++];
+        }
+    }
+
+    // copy the values for each device to a buffer of its own using the same
+    // partition as the first pass
+    detail::multi_device_parts<output_type> values(context, host_counts);
+
+    detail::multi_device_launch scatter(queues, launch.offsets());
+    for(size_t i = 0; i < scatter.size(); i++){
+        if(host_counts[i] == 0){
+            continue;
+        }
+
+        InputIterator part_first =
+            first + static_cast<input_difference_type>(scatter.begin(i));
+
+        detail::meta_kernel k3("copy_if_scatter");
+        k3 << "if(" << predicate(part_first[k3.get_global_id(0)]) << "){\n"
+           << "    const uint index = "
+           << indices.begin(i)[k3.get_global_id(0)] << ";\n"
+           << "    " << values.begin(i)[k3.var<uint_>("index")] << " = "
+           << part_first[k3.get_global_id(0)] << ";\n"
+           << "}\n";
+        k3.exec_1d(scatter.queue(i), 0, scatter.count(i));
+    }
+    scatter.wait();
+
+    // the values of all devices are written to the output on one queue
+    values.copy_to(result, queues.get_queue(0));
+
+    size_t total = 0;
+    for(size_t i = 0; i < host_counts.size(); i++){
+        total += host_counts[i];
+    }
+
+    return result + static_cast<difference_type>(total);
+}
+
 } // end compute namespace
 } // end boost namespace
 
@@ -18,6 +18,7 @@
 #include <boost/compute/algorithm/detail/count_if_with_reduce.hpp>
 #include <boost/compute/algorithm/detail/count_if_with_threads.hpp>
 #include <boost/compute/algorithm/detail/serial_count_if.hpp>
+#include <boost/compute/detail/command_tracer.hpp>
 #include <boost/compute/detail/iterator_range_size.hpp>
 
 namespace boost {
@@ -34,6 +35,8 @@ inline size_t count_if(InputIterator first,
                        Predicate predicate,
                        command_queue &queue = system::default_queue())
 {
+    detail::trace_scope trace("count_if");
+
     const device &device = queue.get_device();
 
     size_t input_size = detail::iterator_range_size(first, last);
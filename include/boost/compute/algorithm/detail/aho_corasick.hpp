@@ -0,0 +1,376 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://boostorg.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#ifndef BOOST_COMPUTE_ALGORITHM_DETAIL_AHO_CORASICK_HPP
+#define BOOST_COMPUTE_ALGORITHM_DETAIL_AHO_CORASICK_HPP
+
+#include <algorithm>
+#include <deque>
+#include <iterator>
+#include <vector>
+
+#include <boost/compute/kernel.hpp>
+#include <boost/compute/command_queue.hpp>
+#include <boost/compute/algorithm/exclusive_scan.hpp>
+#include <boost/compute/container/vector.hpp>
+#include <boost/compute/detail/meta_kernel.hpp>
+#include <boost/compute/detail/iterator_range_size.hpp>
+#include <boost/compute/detail/read_write_single_value.hpp>
+#include <boost/compute/memory/local_buffer.hpp>
+
+namespace boost {
+namespace compute {
+namespace detail {
+
+// number of transitions of each state of the automaton (one per byte)
+const uint_ aho_corasick_alphabet_size = 256;
+
+// the aho-corasick automaton for a set of byte patterns. the automaton is
+// built on the host as a dense table of transitions (with the failure
+// links folded in) so that matching needs a single table lookup per text
+// byte. the patterns found in each state (including those of the states
+// reached by its failure links) are stored in a flat list.
+class aho_corasick_automaton
+{
+public:
+    // builds the automaton for the patterns in [first, last), each pattern
+    // is a host container of byte values. empty patterns never match.
+    template<class PatternIterator>
+    aho_corasick_automaton(PatternIterator first, PatternIterator last)
+        : m_max_length(0)
+    {
+        std::vector<std::vector<uint_> > outputs(1);
+
+        // build the trie of the patterns
+        m_delta.assign(aho_corasick_alphabet_size, 0);
+        std::vector<bool> has_edge(aho_corasick_alphabet_size, false);
+
+        uint_ id = 0;
+        for(PatternIterator i = first; i != last; ++i, ++id){
+            uint_ state = 0;
+            uint_ length = 0;
+            for(typename std::iterator_traits<PatternIterator>::value_type::const_iterator
+                    j = i->begin(); j != i->end(); ++j, ++length){
+                const uint_ c = static_cast<unsigned char>(*j);
+                if(!has_edge[state * aho_corasick_alphabet_size + c]){
+                    const uint_ next = static_cast<uint_>(outputs.size());
+                    outputs.push_back(std::vector<uint_>());
+                    m_delta.resize(m_delta.size() + aho_corasick_alphabet_size, 0);
+                    has_edge.resize(has_edge.size() + aho_corasick_alphabet_size, false);
+
+                    m_delta[state * aho_corasick_alphabet_size + c] = next;
+                    has_edge[state * aho_corasick_alphabet_size + c] = true;
+                }
+                state = m_delta[state * aho_corasick_alphabet_size + c];
+            }
+
+            m_lengths.push_back(length);
+            if(length > 0){
+                outputs[state].push_back(id);
+                m_max_length = (std::max)(m_max_length, length);
+            }
+        }
+
+        // fold the failure links into the transitions in breadth-first
+        // order, the missing transitions of the root stay at the root
+        std::vector<uint_> fail(outputs.size(), 0);
+        std::deque<uint_> queue;
+        for(uint_ c = 0; c < aho_corasick_alphabet_size; c++){
+            if(has_edge[c]){
+                queue.push_back(m_delta[c]);
+            }
+        }
+
+        while(!queue.empty()){
+            const uint_ state = queue.front();
+            queue.pop_front();
+
+            const std::vector<uint_> &inherited = outputs[fail[state]];
+            outputs[state].insert(
+                outputs[state].end(), inherited.begin(), inherited.end()
+            );
+
+            for(uint_ c = 0; c < aho_corasick_alphabet_size; c++){
+                const size_t edge = state * aho_corasick_alphabet_size + c;
+                const uint_ fallback = m_delta[fail[state] * aho_corasick_alphabet_size + c];
+
+                if(has_edge[edge]){
+                    fail[m_delta[edge]] = fallback;
+                    queue.push_back(m_delta[edge]);
+                }
+                else {
+                    m_delta[edge] = fallback;
+                }
+            }
+        }
+
+        // flatten the outputs of each state
+        m_output_offsets.push_back(0);
+        for(size_t state = 0; state < outputs.size(); state++){
+            m_output_ids.insert(
+                m_output_ids.end(), outputs[state].begin(), outputs[state].end()
+            );
+            m_output_offsets.push_back(static_cast<uint_>(m_output_ids.size()));
+        }
+    }
+
+    // returns the number of states
+    size_t states() const
+    {
+        return m_output_offsets.size() - 1;
+    }
+
+    // returns the length of the longest pattern
+    uint_ max_length() const
+    {
+        return m_max_length;
+    }
+
+    // returns true if the automaton can not match anything
+    bool empty() const
+    {
+        return m_output_ids.empty();
+    }
+
+    // the next state for state s and byte c is
+    // delta()[s * aho_corasick_alphabet_size + c]
+    const std::vector<uint_>& delta() const
+    {
+        return m_delta;
+    }
+
+    // the ids of the patterns found in state s are
+    // output_ids()[output_offsets()[s], output_offsets()[s + 1])
+    const std::vector<uint_>& output_offsets() const
+    {
+        return m_output_offsets;
+    }
+
+    const std::vector<uint_>& output_ids() const
+    {
+        return m_output_ids;
+    }
+
+    // the length of each pattern
+    const std::vector<uint_>& lengths() const
+    {
+        return m_lengths;
+    }
+
+private:
+    uint_ m_max_length;
+    std::vector<uint_> m_delta;
+    std::vector<uint_> m_output_offsets;
+    std::vector<uint_> m_output_ids;
+    std::vector<uint_> m_lengths;
+};
+
+// number of text positions scanned by each work-item
+const uint_ aho_corasick_chunk_size = 64;
+
+// the automaton in device memory
+struct aho_corasick_device_automaton
+{
+    aho_corasick_device_automaton(const aho_corasick_automaton &automaton,
+                                  command_queue &queue)
+        : delta(automaton.delta().begin(), automaton.delta().end(), queue),
+          output_offsets(automaton.output_offsets().begin(),
+                         automaton.output_offsets().end(),
+                         queue),
+          output_ids(automaton.output_ids().begin(),
+                     automaton.output_ids().end(),
+                     queue),
+          lengths(automaton.lengths().begin(), automaton.lengths().end(), queue),
+          max_length(automaton.max_length())
+    {
+    }
+
+    vector<uint_> delta;
+    vector<uint_> output_offsets;
+    vector<uint_> output_ids;
+    vector<uint_> lengths;
+    uint_ max_length;
+};
+
+// runs the automaton over [t_first, t_first + n). each work-item scans a chunk
+// of the text and handles the matches which end in it, starting
+// max_length - 1 values before the chunk so that matches which begin in
+// the previous chunk are found. the text of each work-group is loaded into
+// a tile in local memory (unless it does not fit).
+//
+// if write_matches is false the number of matches of each work-item is
+// written to counts, otherwise counts holds the output offset of each
+// work-item and each match is written to result as a uint2 of its position
+// and pattern id. matches whose offset is capacity or more are not written.
+template<class TextIterator, class OutputIterator>
+inline void aho_corasick_scan(TextIterator t_first,
+                              size_t n,
+                              const aho_corasick_device_automaton &automaton,
+                              vector<uint_> &counts,
+                              OutputIterator result,
+                              uint_ capacity,
+                              bool write_matches,
+                              size_t work_group_size,
+                              command_queue &queue)
+{
+    typedef typename std::iterator_traits<TextIterator>::value_type T;
+
+    const context &context = queue.get_context();
+    const device &device = queue.get_device();
+
+    const uint_ chunk_size = aho_corasick_chunk_size;
+    const size_t work_items = counts.size() - 1;
+    const size_t tile_size = work_group_size * chunk_size + automaton.max_length - 1;
+    const bool use_tile = tile_size * sizeof(T) <= device.local_memory_size();
+
+    meta_kernel k(write_matches ? "aho_corasick_write" : "aho_corasick_count");
+    k.add_set_arg<const uint_>("n", uint_(n));
+    k.add_set_arg<const uint_>("max_length", automaton.max_length);
+    if(write_matches){
+        k.add_set_arg<const uint_>("capacity", capacity);
+    }
+    size_t delta_arg = k.add_arg<const uint_ *>(memory_object::global_memory, "delta");
+    size_t output_offsets_arg =
+        k.add_arg<const uint_ *>(memory_object::global_memory, "output_offsets");
+    size_t output_ids_arg =
+        k.add_arg<const uint_ *>(memory_object::global_memory, "output_ids");
+    size_t lengths_arg = k.add_arg<const uint_ *>(memory_object::global_memory, "lengths");
+    size_t counts_arg = k.add_arg<uint_ *>(memory_object::global_memory, "counts");
+    size_t tile_arg = 0;
+    if(use_tile){
+        tile_arg = k.add_arg<T *>(memory_object::local_memory, "tile");
+    }
+
+    k <<
+        "const uint gid = get_global_id(0);\n" <<
+        "const uint lid = get_local_id(0);\n" <<
+        "const uint lsize = get_local_size(0);\n" <<
+        "const uint begin = gid * " << chunk_size << ";\n" <<
+        "const uint end = min(begin + " << chunk_size << ", n);\n";
+
+    if(use_tile){
+        k <<
+            "const uint group_begin = get_group_id(0) * lsize * " << chunk_size << ";\n" <<
+            "const uint tile_begin = group_begin - min(group_begin, max_length - 1);\n" <<
+            "const uint tile_end = min(group_begin + lsize * " << chunk_size << ", n);\n" <<
+            "for(uint i = tile_begin + lid; i < tile_end; i += lsize){\n" <<
+            "    tile[i - tile_begin] = " << t_first[k.var<uint_>("i")] << ";\n" <<
+            "}\n" <<
+            "barrier(CLK_LOCAL_MEM_FENCE);\n";
+    }
+
+    k <<
+        "uint matches = " << (write_matches ? "counts[gid]" : "0") << ";\n" <<
+        "if(begin < n){\n" <<
+        "    uint state = 0;\n" <<
+        "    for(uint p = begin - min(begin, max_length - 1); p < end; p++){\n" <<
+        "        const uint c = (uint)(uchar) ";
+    if(use_tile){
+        k << "tile[p - tile_begin]";
+    }
+    else {
+        k << t_first[k.var<uint_>("p")];
+    }
+    k << ";\n" <<
+        "        state = delta[state * " << aho_corasick_alphabet_size << " + c];\n" <<
+        "        if(p < begin){\n" <<
+        "            continue;\n" <<
+        "        }\n" <<
+        "        for(uint o = output_offsets[state]; o < output_offsets[state+1]; o++){\n";
+    if(write_matches){
+        k <<
+        "            if(matches < capacity){\n" <<
+        "                const uint id = output_ids[o];\n" <<
+        "                " << result[k.var<uint_>("matches")] <<
+                             " = (uint2)(p + 1 - lengths[id], id);\n" <<
+        "            }\n";
+    }
+    k <<
+        "            matches++;\n" <<
+        "        }\n" <<
+        "    }\n" <<
+        "}\n";
+    if(!write_matches){
+        k << "counts[gid] = matches;\n";
+    }
+
+    kernel kernel = k.compile(context);
+    kernel.set_arg(delta_arg, automaton.delta.get_buffer());
+    kernel.set_arg(output_offsets_arg, automaton.output_offsets.get_buffer());
+    kernel.set_arg(output_ids_arg, automaton.output_ids.get_buffer());
+    kernel.set_arg(lengths_arg, automaton.lengths.get_buffer());
+    kernel.set_arg(counts_arg, counts.get_buffer());
+    if(use_tile){
+        kernel.set_arg(tile_arg, local_buffer<T>(tile_size));
+    }
+
+    queue.enqueue_1d_range_kernel(kernel, 0, work_items, work_group_size);
+}
+
+// writes the (position, pattern id) pairs of the first capacity matches of
+// the patterns of automaton in [t_first, t_last) to result and returns the
+// number of all matches. the matches are ordered by the position of their
+// last value.
+//
+// the text is scanned twice: the first pass counts the matches of each
+// work-item, the counts are scanned to get the output offsets and the
+// second pass writes the matches.
+template<class TextIterator, class OutputIterator>
+inline size_t aho_corasick_search(TextIterator t_first,
+                                  TextIterator t_last,
+                                  const aho_corasick_automaton &automaton,
+                                  OutputIterator result,
+                                  size_t capacity,
+                                  command_queue &queue)
+{
+    const size_t n = iterator_range_size(t_first, t_last);
+    if(n == 0 || automaton.empty()){
+        return 0;
+    }
+
+    const device &device = queue.get_device();
+    const size_t work_group_size =
+        (std::min)(size_t(128), device.max_work_group_size());
+    const size_t chunks =
+        (n + aho_corasick_chunk_size - 1) / aho_corasick_chunk_size;
+    const size_t work_groups = (chunks + work_group_size - 1) / work_group_size;
+    const size_t work_items = work_groups * work_group_size;
+
+    aho_corasick_device_automaton device_automaton(automaton, queue);
+    vector<uint_> counts(work_items + 1, queue.get_context());
+
+    aho_corasick_scan(
+        t_first, n, device_automaton, counts, result, 0, false, work_group_size, queue
+    );
+
+    ::boost::compute::exclusive_scan(
+        counts.begin(), counts.end(), counts.begin(), queue
+    );
+
+    const uint_ match_count =
+        read_single_value<uint_>(counts.get_buffer(), work_items, queue);
+    if(match_count == 0 || capacity == 0){
+        return match_count;
+    }
+
+    aho_corasick_scan(
+        t_first, n, device_automaton, counts, result,
+        static_cast<uint_>((std::min)(capacity, size_t(match_count))),
+        true, work_group_size, queue
+    );
+
+    return match_count;
+}
+
+} // end detail namespace
+} // end compute namespace
+} // end boost namespace
+
+#endif // BOOST_COMPUTE_ALGORITHM_DETAIL_AHO_CORASICK_HPP
@@ -28,6 +28,29 @@ namespace boost {
 namespace compute {
 namespace detail {
 
+// Emits "result[index] = first[index];" into the copy kernel.
+template<class InputIterator, class OutputIterator>
+inline void copy_element(meta_kernel &k,
+                         InputIterator first,
+                         OutputIterator result,
+                         const char *index)
+{
+    k << result[k.var<uint_>(index)] << '=' << first[k.var<uint_>(index)] << ";\n";
+}
+
+// half values are stored with vstore_half() as assigning to half requires
+// the cl_khr_fp16 extension
+template<class InputIterator>
+inline void copy_element(meta_kernel &k,
+                         InputIterator first,
+                         buffer_iterator<half_> result,
+                         const char *index)
+{
+    k << "vstore_half((float)(" << first[k.var<uint_>(index)] << "), " <<
+             uint_(result.get_index()) << '+' << index << ", " <<
+             k.get_buffer_identifier<half_>(result.get_buffer()) << ");\n";
+}
+
 template<class InputIterator, class OutputIterator>
 inline event copy_on_device_cpu(InputIterator first,
                                 OutputIterator result,
@@ -42,9 +65,9 @@ inline event copy_on_device_cpu(InputIterator first,
             "(uint)ceil(((float)count)/get_global_size(0));\n" <<
         "uint index = get_global_id(0) * block;\n" <<
         "uint end = min(count, index + block);\n" <<
-        "while(index < end){\n" <<
-            result[k.var<uint_>("index")] << '=' <<
-                first[k.var<uint_>("index")] << ";\n" <<
+        "while(index < end){\n";
+    copy_element(k, first, result, "index");
+    k <<
             "index++;\n" <<
         "}\n";
 
@@ -77,9 +100,9 @@ inline event copy_on_device_gpu(InputIterator first,
         "uint index = get_local_id(0) + " <<
             "(" << vpt * tpb << " * get_group_id(0));\n" <<
         "for(uint i = 0; i < " << vpt << "; i++){\n" <<
-        "    if(index < count){\n" <<
-                result[k.var<uint_>("index")] << '=' <<
-                    first[k.var<uint_>("index")] << ";\n" <<
+        "    if(index < count){\n";
+    copy_element(k, first, result, "index");
+    k <<
         "       index += " << tpb << ";\n"
         "    }\n"
         "}\n";
@@ -19,6 +19,7 @@
 #include <boost/compute/async/future.hpp>
 #include <boost/compute/iterator/buffer_iterator.hpp>
 #include <boost/compute/memory/svm_ptr.hpp>
+#include <boost/compute/detail/host_ptr_alias.hpp>
 
 namespace boost {
 namespace compute {
@@ -44,6 +45,19 @@ inline DeviceIterator copy_to_device(HostIterator first,
 
     size_t offset = result.get_index();
 
+    // the buffer already uses the host memory (e.g. copying from the host
+    // pointer of a mapped_view) so only synchronize it
+    if(is_host_ptr_alias(result.get_buffer(),
+                         offset * sizeof(value_type),
+                         ::boost::addressof(*first))){
+        sync_host_ptr_to_device(result.get_buffer(),
+                                offset * sizeof(value_type),
+                                count * sizeof(value_type),
+                                queue).wait();
+
+        return result + static_cast<difference_type>(count);
+    }
+
     queue.enqueue_write_buffer(result.get_buffer(),
                                offset * sizeof(value_type),
                                count * sizeof(value_type),
@@ -115,6 +129,18 @@ inline future<DeviceIterator> copy_to_device_async(HostIterator first,
 
     size_t offset = result.get_index();
 
+    if(is_host_ptr_alias(result.get_buffer(),
+                         offset * sizeof(value_type),
+                         ::boost::addressof(*first))){
+        event event_ =
+            sync_host_ptr_to_device(result.get_buffer(),
+                                    offset * sizeof(value_type),
+                                    count * sizeof(value_type),
+                                    queue);
+
+        return make_future(result + static_cast<difference_type>(count), event_);
+    }
+
     event event_ =
         queue.enqueue_write_buffer_async(result.get_buffer(),
                                          offset * sizeof(value_type),
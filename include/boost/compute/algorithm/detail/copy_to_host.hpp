@@ -19,6 +19,7 @@
 #include <boost/compute/async/future.hpp>
 #include <boost/compute/iterator/buffer_iterator.hpp>
 #include <boost/compute/memory/svm_ptr.hpp>
+#include <boost/compute/detail/host_ptr_alias.hpp>
 #include <boost/compute/detail/iterator_plus_distance.hpp>
 
 namespace boost {
@@ -43,6 +44,19 @@ inline HostIterator copy_to_host(DeviceIterator first,
     const buffer &buffer = first.get_buffer();
     size_t offset = first.get_index();
 
+    // the buffer already uses the host memory (e.g. copying to the host
+    // pointer of a mapped_view) so only synchronize it
+    if(is_host_ptr_alias(buffer,
+                         offset * sizeof(value_type),
+                         ::boost::addressof(*result))){
+        sync_host_ptr_to_host(buffer,
+                              offset * sizeof(value_type),
+                              count * sizeof(value_type),
+                              queue).wait();
+
+        return iterator_plus_distance(result, count);
+    }
+
     queue.enqueue_read_buffer(buffer,
                               offset * sizeof(value_type),
                               count * sizeof(value_type),
@@ -116,6 +130,18 @@ inline future<HostIterator> copy_to_host_async(DeviceIterator first,
     const buffer &buffer = first.get_buffer();
     size_t offset = first.get_index();
 
+    if(is_host_ptr_alias(buffer,
+                         offset * sizeof(value_type),
+                         ::boost::addressof(*result))){
+        event event_ =
+            sync_host_ptr_to_host(buffer,
+                                  offset * sizeof(value_type),
+                                  count * sizeof(value_type),
+                                  queue);
+
+        return make_future(iterator_plus_distance(result, count), event_);
+    }
+
     event event_ =
         queue.enqueue_read_buffer_async(buffer,
                                         offset * sizeof(value_type),
@@ -0,0 +1,50 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://boostorg.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#ifndef BOOST_COMPUTE_ALGORITHM_DETAIL_HALF_FUNCTION_HPP
+#define BOOST_COMPUTE_ALGORITHM_DETAIL_HALF_FUNCTION_HPP
+
+#include <boost/compute/types/fundamental.hpp>
+
+namespace boost {
+namespace compute {
+namespace detail {
+
+// Maps a function used with half values to the function which is used
+// to compute with their float values. Function objects for half values
+// (e.g. less<half_>) are replaced with their float versions, any other
+// function is expected to take float arguments and is used as is.
+template<class Function>
+struct half_function
+{
+    typedef Function type;
+
+    static type make(const Function &function)
+    {
+        return function;
+    }
+};
+
+template<template<class> class Function>
+struct half_function<Function<half_> >
+{
+    typedef Function<float_> type;
+
+    static type make(const Function<half_> &)
+    {
+        return type();
+    }
+};
+
+} // end detail namespace
+} // end compute namespace
+} // end boost namespace
+
+#endif // BOOST_COMPUTE_ALGORITHM_DETAIL_HALF_FUNCTION_HPP
@@ -0,0 +1,461 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://boostorg.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#ifndef BOOST_COMPUTE_ALGORITHM_DETAIL_HOST_BACKEND_HPP
+#define BOOST_COMPUTE_ALGORITHM_DETAIL_HOST_BACKEND_HPP
+
+#include <algorithm>
+#include <cstring>
+#include <functional>
+#include <iterator>
+#include <numeric>
+#include <string>
+
+#include <boost/shared_ptr.hpp>
+#include <boost/mpl/if.hpp>
+#include <boost/type_traits/is_fundamental.hpp>
+#include <boost/type_traits/is_same.hpp>
+#include <boost/type_traits/remove_cv.hpp>
+#include <boost/utility/enable_if.hpp>
+
+#include <boost/compute/cl.hpp>
+#include <boost/compute/command_queue.hpp>
+#include <boost/compute/algorithm/copy_n.hpp>
+#include <boost/compute/functional/operator.hpp>
+#include <boost/compute/iterator/buffer_iterator.hpp>
+#include <boost/compute/detail/iterator_range_size.hpp>
+#include <boost/compute/detail/parameter_cache.hpp>
+#include <boost/compute/type_traits/is_device_iterator.hpp>
+#include <boost/compute/type_traits/type_name.hpp>
+
+namespace boost {
+namespace compute {
+namespace detail {
+
+// Small ranges are processed on the host instead of the device: for them
+// the kernel launch, program lookup and read back cost more than the work
+// itself. Ranges given by host iterators are used directly and ranges of
+// buffer iterators are mapped to host memory.
+//
+// The host backend is only used if BOOST_COMPUTE_USE_HOST_BACKEND is
+// defined, otherwise all ranges are processed on the device.
+//
+// The crossover sizes are stored per device, algorithm and value type in
+// the parameter cache ("__boost_<algorithm>_<type>"). The "host_crossover"
+// parameter applies to host iterators and the "mapped_host_crossover"
+// parameter to buffer iterators, ranges smaller than the crossover are
+// processed on the host. Both are measured by perf_host_crossover --tune.
+
+// Maps the function object used on the device to the equivalent host
+// function object for values of type T. Only the builtin operators on
+// fundamental types have a host equivalent.
+template<class Function, class T, class Enable = void>
+struct host_function
+{
+    static const bool value = false;
+};
+
+// Orders floating-point values by the same bit pattern keys as the radix
+// sort on the device: -nan < -inf < ... < -0 < +0 < ... < +inf < +nan. This
+// is a strict weak ordering even for ranges which contain nan values.
+template<class T>
+struct host_float_order
+{
+    typedef typename boost::mpl::if_c<sizeof(T) == 4, uint_, ulong_>::type key_type;
+
+    static key_type key(T value)
+    {
+        const key_type sign_bit = key_type(1) << (sizeof(T) * 8 - 1);
+
+        key_type bits;
+        std::memcpy(&bits, &value, sizeof(T));
+        return (bits & sign_bit) ? key_type(~bits) : key_type(bits ^ sign_bit);
+    }
+};
+
+// true for the floating-point types supported by OpenCL devices
+template<class T>
+struct is_device_float
+{
+    static const bool value =
+        boost::is_same<T, float>::value || boost::is_same<T, double>::value;
+};
+
+template<class T>
+struct host_float_less
+{
+    bool operator()(T a, T b) const
+    {
+        return host_float_order<T>::key(a) < host_float_order<T>::key(b);
+    }
+};
+
+template<class T>
+struct host_float_greater
+{
+    bool operator()(T a, T b) const
+    {
+        return host_float_order<T>::key(b) < host_float_order<T>::key(a);
+    }
+};
+
+#define BOOST_COMPUTE_DETAIL_DECLARE_HOST_FUNCTION(name, host_name, enable) \
+    template<class T> \
+    struct host_function< \
+        name<T>, T, typename boost::enable_if_c<enable>::type \
+    > \
+    { \
+        static const bool value = true; \
+        typedef host_name<T> type; \
+    };
+
+BOOST_COMPUTE_DETAIL_DECLARE_HOST_FUNCTION(
+    less, std::less,
+    boost::is_fundamental<T>::value && !is_device_float<T>::value
+)
+BOOST_COMPUTE_DETAIL_DECLARE_HOST_FUNCTION(
+    greater, std::greater,
+    boost::is_fundamental<T>::value && !is_device_float<T>::value
+)
+BOOST_COMPUTE_DETAIL_DECLARE_HOST_FUNCTION(
+    less, host_float_less, is_device_float<T>::value
+)
+BOOST_COMPUTE_DETAIL_DECLARE_HOST_FUNCTION(
+    greater, host_float_greater, is_device_float<T>::value
+)
+BOOST_COMPUTE_DETAIL_DECLARE_HOST_FUNCTION(
+    plus, std::plus, boost::is_fundamental<T>::value
+)
+
+#undef BOOST_COMPUTE_DETAIL_DECLARE_HOST_FUNCTION
+
+// Host iterators can be used by the host algorithms directly and buffer
+// iterators after mapping their buffer. Other device iterators (e.g. a
+// transform_iterator) are always processed on the device.
+template<class Iterator, class Enable = void>
+struct is_host_accessible : boost::false_type {};
+
+template<class Iterator>
+struct is_host_accessible<
+    Iterator, typename boost::disable_if<is_device_iterator<Iterator> >::type
+> : boost::true_type {};
+
+template<class T>
+struct is_host_accessible<buffer_iterator<T> > : boost::true_type {};
+
+// Makes the range [first, last) accessible on the host. Host iterators are
+// used as they are.
+template<class Iterator, class Enable = void>
+class host_access_range
+{
+public:
+    typedef Iterator iterator;
+
+    host_access_range(Iterator first,
+                      Iterator last,
+                      cl_map_flags flags,
+                      command_queue &queue)
+        : m_first(first),
+          m_last(last)
+    {
+        (void) flags;
+        (void) queue;
+    }
+
+    iterator begin() const
+    {
+        return m_first;
+    }
+
+    iterator end() const
+    {
+        return m_last;
+    }
+
+    static bool is_mapped()
+    {
+        return false;
+    }
+
+private:
+    Iterator m_first;
+    Iterator m_last;
+};
+
+// Buffer iterators are mapped to host memory for the lifetime of the range.
+template<class T>
+class host_access_range<buffer_iterator<T> >
+{
+public:
+    typedef T* iterator;
+
+    host_access_range(buffer_iterator<T> first,
+                      buffer_iterator<T> last,
+                      cl_map_flags flags,
+                      command_queue &queue)
+        : m_buffer(first.get_buffer()),
+          m_size(iterator_range_size(first, last)),
+          m_queue(queue),
+          m_ptr(0)
+    {
+        if(m_size == 0){
+            return;
+        }
+
+        m_ptr = static_cast<T *>(
+            m_queue.enqueue_map_buffer(
+                m_buffer, flags, first.get_index() * sizeof(T), m_size * sizeof(T)
+            )
+        );
+    }
+
+    ~host_access_range()
+    {
+        if(m_ptr){
+            m_queue.enqueue_unmap_buffer(m_buffer, m_ptr).wait();
+        }
+    }
+
+    iterator begin() const
+    {
+        return m_ptr;
+    }
+
+    iterator end() const
+    {
+        return m_ptr + m_size;
+    }
+
+    static bool is_mapped()
+    {
+        return true;
+    }
+
+private:
+    host_access_range(const host_access_range &);
+    host_access_range& operator=(const host_access_range &);
+
+private:
+    buffer m_buffer;
+    size_t m_size;
+    command_queue m_queue;
+    T *m_ptr;
+};
+
+// Returns the crossover of algorithm which is used until it is measured
+// for the device. Sorting on the host costs more per value than reducing
+// or searching so the host only sorts smaller ranges.
+inline uint_ default_host_crossover(const std::string &algorithm, bool mapped)
+{
+    if(algorithm == "sort"){
+        return mapped ? 1024 : 4096;
+    }
+
+    return mapped ? 16384 : 65536;
+}
+
+// Returns true if count values of type T should be processed by algorithm
+// on the host.
+template<class T>
+inline bool use_host_backend(const std::string &algorithm,
+                             size_t count,
+                             bool mapped,
+                             command_queue &queue)
+{
+#ifndef BOOST_COMPUTE_USE_HOST_BACKEND
+    (void) algorithm;
+    (void) count;
+    (void) mapped;
+    (void) queue;
+
+    return false;
+#else
+    std::string cache_key =
+        std::string("__boost_") + algorithm + "_" + type_name<T>();
+    boost::shared_ptr<parameter_cache> parameters =
+        parameter_cache::get_global_cache(queue.get_device());
+
+    const uint_ crossover = parameters->get(
+        cache_key,
+        mapped ? "mapped_host_crossover" : "host_crossover",
+        default_host_crossover(algorithm, mapped)
+    );
+
+    return count < crossover;
+#endif // BOOST_COMPUTE_USE_HOST_BACKEND
+}
+
+template<class Iterator, class Compare>
+struct can_sort_on_host
+{
+    typedef typename boost::remove_cv<
+        typename std::iterator_traits<Iterator>::value_type
+    >::type value_type;
+
+    static const bool value =
+        is_host_accessible<Iterator>::value &&
+        host_function<Compare, value_type>::value;
+};
+
+// Sorts [first, last) on the host and returns true if the range is smaller
+// than the crossover, otherwise returns false and leaves it unchanged.
+template<class Iterator, class Compare>
+inline bool sort_on_host(Iterator first,
+                         Iterator last,
+                         Compare compare,
+                         bool stable,
+                         command_queue &queue,
+                         typename boost::enable_if_c<
+                             can_sort_on_host<Iterator, Compare>::value
+                         >::type* = 0)
+{
+    typedef typename can_sort_on_host<Iterator, Compare>::value_type value_type;
+    typedef typename host_function<Compare, value_type>::type host_compare;
+
+    (void) compare;
+
+    const size_t count = iterator_range_size(first, last);
+    if(!use_host_backend<value_type>(
+           "sort", count, host_access_range<Iterator>::is_mapped(), queue)){
+        return false;
+    }
+
+    host_access_range<Iterator> range(
+        first, last, CL_MAP_READ | CL_MAP_WRITE, queue
+    );
+    if(stable){
+        std::stable_sort(range.begin(), range.end(), host_compare());
+    }
+    else {
+        std::sort(range.begin(), range.end(), host_compare());
+    }
+
+    return true;
+}
+
+template<class Iterator, class Compare>
+inline bool sort_on_host(Iterator,
+                         Iterator,
+                         Compare,
+                         bool,
+                         command_queue &,
+                         typename boost::disable_if_c<
+                             can_sort_on_host<Iterator, Compare>::value
+                         >::type* = 0)
+{
+    return false;
+}
+
+template<class InputIterator, class BinaryFunction>
+struct can_reduce_on_host
+{
+    typedef typename boost::remove_cv<
+        typename std::iterator_traits<InputIterator>::value_type
+    >::type value_type;
+
+    static const bool value =
+        is_host_accessible<InputIterator>::value &&
+        host_function<BinaryFunction, value_type>::value;
+};
+
+// Reduces the non-empty range [first, last) on the host and writes the
+// result to result if it is smaller than the crossover. Returns false
+// otherwise.
+template<class InputIterator, class OutputIterator, class BinaryFunction>
+inline bool reduce_on_host(InputIterator first,
+                           InputIterator last,
+                           OutputIterator result,
+                           BinaryFunction function,
+                           command_queue &queue,
+                           typename boost::enable_if_c<
+                               can_reduce_on_host<InputIterator, BinaryFunction>::value
+                           >::type* = 0)
+{
+    typedef typename
+        can_reduce_on_host<InputIterator, BinaryFunction>::value_type value_type;
+    typedef typename
+        host_function<BinaryFunction, value_type>::type host_reduce;
+
+    (void) function;
+
+    const size_t count = iterator_range_size(first, last);
+    if(count == 0 ||
+       !use_host_backend<value_type>(
+           "reduce", count, host_access_range<InputIterator>::is_mapped(), queue)){
+        return false;
+    }
+
+    value_type value;
+    {
+        host_access_range<InputIterator> range(first, last, CL_MAP_READ, queue);
+        typename host_access_range<InputIterator>::iterator begin = range.begin();
+        value = *begin;
+        value = std::accumulate(++begin, range.end(), value, host_reduce());
+    }
+
+    ::boost::compute::copy_n(&value, 1, result, queue);
+
+    return true;
+}
+
+template<class InputIterator, class OutputIterator, class BinaryFunction>
+inline bool reduce_on_host(InputIterator,
+                           InputIterator,
+                           OutputIterator,
+                           BinaryFunction,
+                           command_queue &,
+                           typename boost::disable_if_c<
+                               can_reduce_on_host<InputIterator, BinaryFunction>::value
+                           >::type* = 0)
+{
+    return false;
+}
+
+// Finds value in the range [first, last) of a buffer on the host and
+// stores the position in result if the range is smaller than the
+// crossover. Returns false otherwise.
+template<class T, class Value>
+inline bool find_on_host(buffer_iterator<T> first,
+                         buffer_iterator<T> last,
+                         const Value &value,
+                         buffer_iterator<T> &result,
+                         command_queue &queue,
+                         typename boost::enable_if<
+                             boost::is_fundamental<T>
+                         >::type* = 0)
+{
+    const size_t count = iterator_range_size(first, last);
+    if(!use_host_backend<T>("find", count, true, queue)){
+        return false;
+    }
+
+    host_access_range<buffer_iterator<T> > range(first, last, CL_MAP_READ, queue);
+    result = first + std::distance(
+        range.begin(), std::find(range.begin(), range.end(), value)
+    );
+
+    return true;
+}
+
+template<class InputIterator, class Value>
+inline bool find_on_host(InputIterator,
+                         InputIterator,
+                         const Value &,
+                         InputIterator &,
+                         command_queue &)
+{
+    return false;
+}
+
+} // end detail namespace
+} // end compute namespace
+} // end boost namespace
+
+#endif // BOOST_COMPUTE_ALGORITHM_DETAIL_HOST_BACKEND_HPP
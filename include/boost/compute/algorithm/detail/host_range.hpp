@@ -0,0 +1,184 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://boostorg.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#ifndef BOOST_COMPUTE_ALGORITHM_DETAIL_HOST_RANGE_HPP
+#define BOOST_COMPUTE_ALGORITHM_DETAIL_HOST_RANGE_HPP
+
+#include <iterator>
+
+#include <boost/type_traits/remove_cv.hpp>
+#include <boost/utility/addressof.hpp>
+#include <boost/utility/enable_if.hpp>
+
+#include <boost/compute/buffer.hpp>
+#include <boost/compute/device.hpp>
+#include <boost/compute/command_queue.hpp>
+#include <boost/compute/algorithm/copy.hpp>
+#include <boost/compute/iterator/buffer_iterator.hpp>
+#include <boost/compute/detail/host_ptr_alias.hpp>
+#include <boost/compute/detail/is_contiguous_iterator.hpp>
+#include <boost/compute/detail/iterator_range_size.hpp>
+
+namespace boost {
+namespace compute {
+namespace detail {
+
+// returns true if buffers created with use_host_ptr are used in place by
+// device (instead of being copied to device memory)
+inline bool is_zero_copy_device(const device &device)
+{
+    if(device.type() & device::cpu){
+        return true;
+    }
+
+    #ifdef BOOST_COMPUTE_CL_VERSION_1_1
+    return device.get_info<CL_DEVICE_HOST_UNIFIED_MEMORY>();
+    #else
+    return false;
+    #endif
+}
+
+inline buffer make_host_ptr_buffer(const context &context, void *ptr, size_t size)
+{
+    return buffer(context, size, buffer::read_write | buffer::use_host_ptr, ptr);
+}
+
+inline buffer make_host_ptr_buffer(const context &context, const void *ptr, size_t size)
+{
+    return buffer(
+        context, size, buffer::read_only | buffer::use_host_ptr, const_cast<void *>(ptr)
+    );
+}
+
+// makes the host range [first, last) available to algorithms as a device
+// range. on zero-copy devices (e.g. CPUs) contiguous ranges are wrapped in
+// a buffer using the host memory, otherwise they are copied to a temporary
+// buffer. the values written on the device are made visible in the host
+// range by update_host() and finish() waits until the device no longer uses
+// the host memory.
+template<class Iterator>
+class host_range
+{
+public:
+    typedef typename boost::remove_cv<
+        typename std::iterator_traits<Iterator>::value_type
+    >::type value_type;
+    typedef buffer_iterator<value_type> iterator;
+
+    host_range(Iterator first,
+               Iterator last,
+               command_queue &queue,
+               bool copy_values = true)
+        : m_first(first),
+          m_size(iterator_range_size(first, last)),
+          m_queue(queue),
+          m_zero_copy(false)
+    {
+        if(m_size == 0){
+            return;
+        }
+
+        if(is_contiguous_iterator<Iterator>::value &&
+           is_zero_copy_device(queue.get_device())){
+            m_buffer = make_buffer(first, is_contiguous_iterator<Iterator>());
+            m_zero_copy = true;
+        }
+        else {
+            m_buffer = buffer(queue.get_context(), m_size * sizeof(value_type));
+            if(copy_values){
+                ::boost::compute::copy(first, last, begin(), queue);
+            }
+        }
+    }
+
+    iterator begin() const
+    {
+        return make_buffer_iterator<value_type>(m_buffer, 0);
+    }
+
+    iterator end() const
+    {
+        return make_buffer_iterator<value_type>(m_buffer, m_size);
+    }
+
+    size_t size() const
+    {
+        return m_size;
+    }
+
+    // returns true if the device uses the host memory directly
+    bool is_zero_copy() const
+    {
+        return m_zero_copy;
+    }
+
+    // blocks until the device is done with the host memory if it is used
+    // directly. algorithms which return before their commands complete call
+    // this so that the caller may change or free the host range afterwards.
+    void finish()
+    {
+        if(m_zero_copy){
+            m_queue.finish();
+        }
+    }
+
+    // makes the values written on the device visible in the host range
+    void update_host()
+    {
+        if(m_size == 0){
+            return;
+        }
+
+        if(m_zero_copy){
+            sync_host_ptr_to_host(
+                m_buffer, 0, m_size * sizeof(value_type), m_queue
+            ).wait();
+        }
+        else {
+            ::boost::compute::copy(begin(), end(), m_first, m_queue);
+        }
+    }
+
+private:
+    buffer make_buffer(Iterator first, boost::true_type)
+    {
+        return make_host_ptr_buffer(
+            m_queue.get_context(),
+            ::boost::addressof(*first),
+            m_size * sizeof(value_type)
+        );
+    }
+
+    buffer make_buffer(Iterator, boost::false_type)
+    {
+        return buffer();
+    }
+
+private:
+    Iterator m_first;
+    size_t m_size;
+    command_queue m_queue;
+    buffer m_buffer;
+    bool m_zero_copy;
+};
+
+// returns true if the host iterators point to the same element
+template<class Iterator1, class Iterator2>
+inline bool is_same_host_element(Iterator1 a, Iterator2 b)
+{
+    return static_cast<const void *>(::boost::addressof(*a)) ==
+           static_cast<const void *>(::boost::addressof(*b));
+}
+
+} // end detail namespace
+} // end compute namespace
+} // end boost namespace
+
+#endif // BOOST_COMPUTE_ALGORITHM_DETAIL_HOST_RANGE_HPP
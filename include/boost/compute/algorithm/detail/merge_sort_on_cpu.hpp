@@ -15,19 +15,25 @@
 #include <boost/compute/program.hpp>
 #include <boost/compute/command_queue.hpp>
 #include <boost/compute/algorithm/detail/merge_with_merge_path.hpp>
+#include <boost/compute/algorithm/detail/sample_sort_on_cpu.hpp>
 #include <boost/compute/container/vector.hpp>
 #include <boost/compute/detail/meta_kernel.hpp>
 #include <boost/compute/detail/iterator_range_size.hpp>
+#include <boost/compute/detail/parameter_cache.hpp>
 
 namespace boost {
 namespace compute {
 namespace detail {
 
-template<class KeyIterator, class ValueIterator, class Compare>
+template<class KeyIterator,
+         class ValueIterator,
+         class KeyResultIterator,
+         class ValueResultIterator,
+         class Compare>
 inline void merge_blocks(KeyIterator keys_first,
                          ValueIterator values_first,
-                         KeyIterator keys_result,
-                         ValueIterator values_result,
+                         KeyResultIterator keys_result,
+                         ValueResultIterator values_result,
                          Compare compare,
                          size_t count,
                          const size_t block_size,
@@ -111,23 +117,24 @@ inline void merge_blocks(KeyIterator keys_first,
     queue.enqueue_1d_range_kernel(kernel, 0, global_size, 0);
 }
 
-template<class Iterator, class Compare>
+template<class Iterator, class ResultIterator, class Compare>
 inline void merge_blocks(Iterator first,
-                         Iterator result,
+                         ResultIterator result,
                          Compare compare,
                          size_t count,
                          const size_t block_size,
                          const bool sort_by_key,
                          command_queue &queue)
 {
-    // dummy iterator as it's not sort by key
+    // dummy iterators as it's not sort by key
     Iterator dummy;
-    merge_blocks(first, dummy, result, dummy, compare, count, block_size, false, queue);
+    ResultIterator result_dummy;
+    merge_blocks(first, dummy, result, result_dummy, compare, count, block_size, false, queue);
 }
 
-template<class Iterator, class Compare>
+template<class Iterator, class ResultIterator, class Compare>
 inline void dispatch_merge_blocks(Iterator first,
-                                  Iterator result,
+                                  ResultIterator result,
                                   Compare compare,
                                   size_t count,
                                   const size_t block_size,
@@ -148,7 +155,7 @@ inline void dispatch_merge_blocks(Iterator first,
             Iterator last1 = (std::min)(first1 + block_size, last);
             Iterator first2 = last1;
             Iterator last2 = (std::min)(first2 + block_size, last);
-            Iterator block_result = (std::min)(result + i, result + count);
+            ResultIterator block_result = (std::min)(result + i, result + count);
             merge_with_merge_path(first1, last1, first2, last2,
                                   block_result, compare, queue);
         }
@@ -272,6 +279,20 @@ inline void merge_sort_on_cpu(Iterator first,
 
     const size_t block_size =
         parameters->get(cache_key, "insertion_sort_block_size", 64);
+
+    // large inputs are sorted with a sample sort which makes a constant
+    // number of passes over memory (instead of one per merge level)
+    const size_t sample_sort_input_size_threshold =
+        parameters->get(cache_key, "sample_sort_input_size_threshold", 262144);
+    const size_t sample_sort_bucket_size =
+        parameters->get(cache_key, "sample_sort_bucket_size", 16384);
+    if(count >= sample_sort_input_size_threshold){
+        Iterator dummy;
+        sample_sort_on_cpu(first, dummy, compare, count,
+                           sample_sort_bucket_size, block_size, false, queue);
+        return;
+    }
+
     block_insertion_sort(first, compare, count, block_size, queue);
 
     // temporary buffer for merge result
@@ -332,6 +353,18 @@ inline void merge_sort_by_key_on_cpu(KeyIterator keys_first,
 
     const size_t block_size =
         parameters->get(cache_key, "insertion_sort_by_key_block_size", 64);
+
+    // large inputs are sorted with a sample sort (see merge_sort_on_cpu())
+    const size_t sample_sort_input_size_threshold =
+        parameters->get(cache_key, "sample_sort_input_size_threshold", 262144);
+    const size_t sample_sort_bucket_size =
+        parameters->get(cache_key, "sample_sort_bucket_size", 16384);
+    if(count >= sample_sort_input_size_threshold){
+        sample_sort_on_cpu(keys_first, values_first, compare, count,
+                           sample_sort_bucket_size, block_size, true, queue);
+        return;
+    }
+
     block_insertion_sort(keys_first, values_first, compare,
                          count, block_size, true, queue);
 
@@ -310,11 +310,15 @@ inline size_t block_sort(KeyIterator keys_first,
 }
 
 /// space: O(n + m); n - number of keys, m - number of values
-template<class KeyIterator, class ValueIterator, class Compare>
+template<class KeyIterator,
+         class ValueIterator,
+         class OutKeyIterator,
+         class OutValueIterator,
+         class Compare>
 inline void merge_blocks_on_gpu(KeyIterator keys_first,
                                 ValueIterator values_first,
-                                KeyIterator out_keys_first,
-                                ValueIterator out_values_first,
+                                OutKeyIterator out_keys_first,
+                                OutValueIterator out_values_first,
                                 Compare compare,
                                 const size_t count,
                                 const size_t block_size,
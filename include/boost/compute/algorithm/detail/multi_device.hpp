@@ -0,0 +1,240 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://boostorg.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#ifndef BOOST_COMPUTE_ALGORITHM_DETAIL_MULTI_DEVICE_HPP
+#define BOOST_COMPUTE_ALGORITHM_DETAIL_MULTI_DEVICE_HPP
+
+#include <vector>
+
+#include <boost/assert.hpp>
+
+#include <boost/compute/buffer.hpp>
+#include <boost/compute/event.hpp>
+#include <boost/compute/context.hpp>
+#include <boost/compute/multi_queue.hpp>
+#include <boost/compute/command_queue.hpp>
+#include <boost/compute/algorithm/copy.hpp>
+#include <boost/compute/iterator/buffer_iterator.hpp>
+
+namespace boost {
+namespace compute {
+namespace detail {
+
+// splits count elements across the queues in a multi_queue and measures the
+// time each device takes for its part. usage:
+//
+//   multi_device_launch launch(queues, count);
+//   for(size_t i = 0; i < launch.size(); i++){
+//       if(launch.count(i)){
+//           // enqueue work for [launch.begin(i), launch.end(i)) on
+//           // launch.queue(i)
+//       }
+//   }
+//   launch.wait();
+class multi_device_launch
+{
+public:
+    multi_device_launch(multi_queue &queues, size_t count)
+        : m_queues(queues),
+          m_offsets(queues.partition(count))
+    {
+        start();
+    }
+
+    // splits the work with explicit offsets (size() + 1 entries)
+    multi_device_launch(multi_queue &queues, const std::vector<size_t> &offsets)
+        : m_queues(queues),
+          m_offsets(offsets)
+    {
+        BOOST_ASSERT(m_offsets.size() == queues.size() + 1);
+
+        start();
+    }
+
+    size_t size() const
+    {
+        return m_queues.size();
+    }
+
+    size_t begin(size_t i) const
+    {
+        return m_offsets[i];
+    }
+
+    size_t end(size_t i) const
+    {
+        return m_offsets[i+1];
+    }
+
+    size_t count(size_t i) const
+    {
+        return m_offsets[i+1] - m_offsets[i];
+    }
+
+    const std::vector<size_t>& offsets() const
+    {
+        return m_offsets;
+    }
+
+    // returns the size of each part
+    std::vector<size_t> counts() const
+    {
+        std::vector<size_t> counts(size());
+        for(size_t i = 0; i < size(); i++){
+            counts[i] = count(i);
+        }
+
+        return counts;
+    }
+
+    command_queue& queue(size_t i)
+    {
+        return m_queues.get_queue(i);
+    }
+
+    // blocks until every device has finished its part and updates the
+    // weights with the measured throughput. the counts default to the
+    // size of each part but can be overridden when the work done by a
+    // device is not proportional to its part (e.g. for merges).
+    void wait()
+    {
+        wait(counts());
+    }
+
+    void wait(const std::vector<size_t> &counts)
+    {
+        std::vector<event> end_markers(size());
+        for(size_t i = 0; i < size(); i++){
+            if(m_start_markers[i].get()){
+                end_markers[i] = queue(i).enqueue_marker();
+            }
+        }
+
+        m_queues.finish();
+
+        if(!m_measure){
+            return;
+        }
+
+        std::vector<double> nanoseconds(size(), 0.0);
+        for(size_t i = 0; i < size(); i++){
+            if(end_markers[i].get()){
+                const ulong_ start =
+                    m_start_markers[i].get_profiling_info<ulong_>(CL_PROFILING_COMMAND_END);
+                const ulong_ end =
+                    end_markers[i].get_profiling_info<ulong_>(CL_PROFILING_COMMAND_END);
+
+                nanoseconds[i] = end > start ? static_cast<double>(end - start) : 0.0;
+            }
+        }
+
+        m_queues.update_weights(counts, nanoseconds);
+    }
+
+private:
+    void start()
+    {
+        m_start_markers.resize(size());
+
+        // only measure if every device taking part can be measured
+        m_measure = m_queues.load_balancing() && size() > 1;
+        for(size_t i = 0; i < size() && m_measure; i++){
+            if(count(i) && !m_queues.can_measure(i)){
+                m_measure = false;
+            }
+        }
+
+        if(m_measure){
+            for(size_t i = 0; i < size(); i++){
+                if(count(i)){
+                    m_start_markers[i] = queue(i).enqueue_marker();
+                }
+            }
+        }
+    }
+
+private:
+    multi_queue &m_queues;
+    std::vector<size_t> m_offsets;
+    std::vector<event> m_start_markers;
+    bool m_measure;
+};
+
+// a separate buffer for each part of a multi-device launch. OpenCL does not
+// define the result of writing to one memory object from several command
+// queues at the same time (even if the regions written do not overlap), so
+// each device writes its part of an output to a buffer of its own and the
+// parts are then copied to the output on a single queue. usage:
+//
+//   multi_device_parts<T> parts(context, launch.counts());
+//   for(size_t i = 0; i < launch.size(); i++){
+//       // write part i to [parts.begin(i), parts.end(i)) on launch.queue(i)
+//   }
+//   launch.wait();
+//   parts.copy_to(result, queue);
+template<class T>
+class multi_device_parts
+{
+public:
+    multi_device_parts(const context &context, const std::vector<size_t> &sizes)
+        : m_sizes(sizes),
+          m_buffers(sizes.size())
+    {
+        for(size_t i = 0; i < sizes.size(); i++){
+            if(sizes[i]){
+                m_buffers[i] = buffer(context, sizes[i] * sizeof(T));
+            }
+        }
+    }
+
+    size_t size() const
+    {
+        return m_sizes.size();
+    }
+
+    size_t count(size_t i) const
+    {
+        return m_sizes[i];
+    }
+
+    buffer_iterator<T> begin(size_t i) const
+    {
+        return make_buffer_iterator<T>(m_buffers[i], 0);
+    }
+
+    buffer_iterator<T> end(size_t i) const
+    {
+        return make_buffer_iterator<T>(m_buffers[i], m_sizes[i]);
+    }
+
+    // copies the parts one after another to the range beginning at result
+    // and waits until the copies have completed
+    template<class OutputIterator>
+    void copy_to(OutputIterator result, command_queue &queue) const
+    {
+        for(size_t i = 0; i < size(); i++){
+            if(m_sizes[i]){
+                result = ::boost::compute::copy(begin(i), end(i), result, queue);
+            }
+        }
+
+        queue.finish();
+    }
+
+private:
+    std::vector<size_t> m_sizes;
+    std::vector<buffer> m_buffers;
+};
+
+} // end detail namespace
+} // end compute namespace
+} // end boost namespace
+
+#endif // BOOST_COMPUTE_ALGORITHM_DETAIL_MULTI_DEVICE_HPP
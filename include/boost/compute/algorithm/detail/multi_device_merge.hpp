@@ -0,0 +1,209 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://boostorg.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#ifndef BOOST_COMPUTE_ALGORITHM_DETAIL_MULTI_DEVICE_MERGE_HPP
+#define BOOST_COMPUTE_ALGORITHM_DETAIL_MULTI_DEVICE_MERGE_HPP
+
+#include <iterator>
+#include <vector>
+
+#include <boost/compute/multi_queue.hpp>
+#include <boost/compute/command_queue.hpp>
+#include <boost/compute/algorithm/copy.hpp>
+#include <boost/compute/algorithm/detail/multi_device.hpp>
+#include <boost/compute/algorithm/detail/merge_with_merge_path.hpp>
+#include <boost/compute/container/vector.hpp>
+#include <boost/compute/detail/iterator_range_size.hpp>
+#include <boost/compute/detail/meta_kernel.hpp>
+
+namespace boost {
+namespace compute {
+namespace detail {
+
+// finds the merge path split points for a set of diagonals. each split is
+// described by four values in params: the index of the first element of the
+// first run, the size of the first run, the size of the second run (which
+// directly follows the first) and the diagonal. the number of elements taken
+// from the first run before the diagonal is stored in splits.
+template<class Iterator, class Compare>
+inline void multi_device_merge_splits(Iterator first,
+                                      const vector<uint_> &params,
+                                      vector<uint_> &splits,
+                                      Compare compare,
+                                      command_queue &queue)
+{
+    meta_kernel k("multi_device_merge_splits");
+    k <<
+        "const uint i = get_global_id(0);\n" <<
+        "const uint a_first = " << params.begin()[k.expr<uint_>("4*i")] << ";\n" <<
+        "const uint a_count = " << params.begin()[k.expr<uint_>("4*i+1")] << ";\n" <<
+        "const uint b_count = " << params.begin()[k.expr<uint_>("4*i+2")] << ";\n" <<
+        "const uint diagonal = " << params.begin()[k.expr<uint_>("4*i+3")] << ";\n" <<
+        "const uint b_first = a_first + a_count;\n" <<
+        "uint start = diagonal > b_count ? diagonal - b_count : 0;\n" <<
+        "uint end = min(diagonal, a_count);\n" <<
+        "while(start < end){\n" <<
+        "    const uint mid = (start + end) / 2;\n" <<
+        "    if(!(" << compare(first[k.expr<uint_>("b_first + diagonal - mid - 1")],
+                              first[k.expr<uint_>("a_first + mid")]) << "))\n" <<
+        "        start = mid + 1;\n" <<
+        "    else\n" <<
+        "        end = mid;\n" <<
+        "}\n" <<
+        splits.begin()[k.var<uint_>("i")] << " = start;\n";
+
+    k.exec_1d(queue, 0, splits.size());
+}
+
+// merges pairs of adjacent sorted runs from input into output. the runs are
+// given by their boundaries (runs.front() == 0 and runs.back() == count) and
+// the boundaries of the merged runs are returned. the output of each merge
+// is split across the devices along its merge path. each device writes its
+// pieces of the output to a buffer of its own, which are then copied to the
+// output on the first queue.
+template<class InputIterator, class OutputIterator, class Compare>
+inline std::vector<size_t>
+multi_device_merge_runs(InputIterator input,
+                        OutputIterator output,
+                        const std::vector<size_t> &runs,
+                        Compare compare,
+                        multi_queue &queues)
+{
+    typedef typename std::iterator_traits<OutputIterator>::value_type value_type;
+
+    const size_t devices = queues.size();
+    const size_t run_count = runs.size() - 1;
+    const size_t pair_count = (run_count + 1) / 2;
+
+    std::vector<size_t> merged_runs(1, 0);
+
+    // the diagonals splitting each merged run across the devices
+    std::vector<uint_> host_params;
+    host_params.reserve(pair_count * (devices + 1) * 4);
+    for(size_t p = 0; p < pair_count; p++){
+        const size_t a_first = runs[2*p];
+        const size_t a_count = runs[2*p+1] - a_first;
+        const size_t b_count =
+            2*p+2 < runs.size() ? runs[2*p+2] - runs[2*p+1] : 0;
+
+        const std::vector<size_t> diagonals = queues.partition(a_count + b_count);
+        for(size_t j = 0; j <= devices; j++){
+            host_params.push_back(static_cast<uint_>(a_first));
+            host_params.push_back(static_cast<uint_>(a_count));
+            host_params.push_back(static_cast<uint_>(b_count));
+            host_params.push_back(static_cast<uint_>(diagonals[j]));
+        }
+
+        merged_runs.push_back(a_first + a_count + b_count);
+    }
+
+    command_queue &queue = queues.get_queue(0);
+    const context &context = queue.get_context();
+
+    vector<uint_> params(host_params.begin(), host_params.end(), queue);
+    vector<uint_> splits(pair_count * (devices + 1), context);
+    multi_device_merge_splits(input, params, splits, compare, queue);
+
+    std::vector<uint_> host_splits(splits.size());
+    ::boost::compute::copy(splits.begin(), splits.end(), host_splits.begin(), queue);
+
+    // number of elements written by each device
+    std::vector<size_t> offsets(devices + 1, 0);
+    for(size_t j = 0; j < devices; j++){
+        size_t count = 0;
+        for(size_t p = 0; p < pair_count; p++){
+            const size_t s = p * (devices + 1) + j;
+            count += host_params[4*(s+1)+3] - host_params[4*s+3];
+        }
+        offsets[j+1] = offsets[j] + count;
+    }
+
+    multi_device_launch launch(queues, offsets);
+    multi_device_parts<value_type> parts(context, launch.counts());
+    for(size_t j = 0; j < devices; j++){
+        if(launch.count(j) == 0){
+            continue;
+        }
+
+        // position of the next piece in the device's buffer
+        size_t position = 0;
+
+        for(size_t p = 0; p < pair_count; p++){
+            const size_t s = p * (devices + 1) + j;
+
+            const size_t a_first = host_params[4*s];
+            const size_t b_first = a_first + host_params[4*s+1];
+            const size_t d0 = host_params[4*s+3];
+            const size_t d1 = host_params[4*(s+1)+3];
+            const size_t a0 = host_splits[s];
+            const size_t a1 = host_splits[s+1];
+            const size_t b0 = d0 - a0;
+            const size_t b1 = d1 - a1;
+
+            if(d0 == d1){
+                continue;
+            }
+            else if(a0 == a1 || b0 == b1){
+                // only one of the runs contributes to this part
+                const size_t from = a0 == a1 ? b_first + b0 : a_first + a0;
+
+                ::boost::compute::copy(
+                    input + from,
+                    input + from + (d1 - d0),
+                    parts.begin(j) + position,
+                    launch.queue(j)
+                );
+            }
+            else {
+                merge_with_merge_path(
+                    input + a_first + a0, input + a_first + a1,
+                    input + b_first + b0, input + b_first + b1,
+                    parts.begin(j) + position,
+                    compare,
+                    launch.queue(j)
+                );
+            }
+
+            position += d1 - d0;
+        }
+    }
+    launch.wait();
+
+    // copy the pieces to the output, the pieces of each device are in the
+    // same order as above
+    for(size_t j = 0; j < devices; j++){
+        size_t position = 0;
+        for(size_t p = 0; p < pair_count; p++){
+            const size_t s = p * (devices + 1) + j;
+            const size_t a_first = host_params[4*s];
+            const size_t d0 = host_params[4*s+3];
+            const size_t d1 = host_params[4*(s+1)+3];
+
+            if(d0 != d1){
+                ::boost::compute::copy(
+                    parts.begin(j) + position,
+                    parts.begin(j) + position + (d1 - d0),
+                    output + a_first + d0,
+                    queue
+                );
+                position += d1 - d0;
+            }
+        }
+    }
+    queue.finish();
+
+    return merged_runs;
+}
+
+} // end detail namespace
+} // end compute namespace
+} // end boost namespace
+
+#endif // BOOST_COMPUTE_ALGORITHM_DETAIL_MULTI_DEVICE_MERGE_HPP
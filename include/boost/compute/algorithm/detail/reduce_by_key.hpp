@@ -17,9 +17,13 @@
 #include <boost/compute/command_queue.hpp>
 #include <boost/compute/functional.hpp>
 #include <boost/compute/container/vector.hpp>
+#include <boost/compute/container/detail/scalar.hpp>
 #include <boost/compute/detail/iterator_range_size.hpp>
+#include <boost/compute/detail/read_write_single_value.hpp>
 #include <boost/compute/algorithm/detail/serial_reduce_by_key.hpp>
+#include <boost/compute/algorithm/detail/reduce_by_key_with_look_back.hpp>
 #include <boost/compute/algorithm/detail/reduce_by_key_with_scan.hpp>
+#include <boost/compute/iterator/buffer_iterator.hpp>
 #include <boost/compute/type_traits.hpp>
 
 namespace boost {
@@ -38,6 +42,19 @@ size_t reduce_by_key_on_gpu(InputKeyIterator keys_first,
                             BinaryPredicate predicate,
                             command_queue &queue)
 {
+    const size_t count = detail::iterator_range_size(keys_first, keys_last);
+    if(reduce_by_key_with_look_back_requirements_met(keys_first, values_first,
+                                                     keys_result, values_result,
+                                                     count, queue)){
+        scalar<uint_> result_size(queue.get_context());
+        detail::reduce_by_key_with_look_back(keys_first, keys_last, values_first,
+                                             keys_result, values_result, function,
+                                             predicate,
+                                             make_buffer_iterator<uint_>(result_size.get_buffer()),
+                                             queue);
+        return result_size.read(queue);
+    }
+
     return detail::reduce_by_key_with_scan(keys_first, keys_last, values_first,
                                            keys_result, values_result, function,
                                            predicate, queue);
@@ -55,9 +72,12 @@ bool reduce_by_key_on_gpu_requirements_met(InputKeyIterator keys_first,
     const device &device = queue.get_device();
     return (count > 256)
                && !(device.type() & device::cpu)
-               && reduce_by_key_with_scan_requirements_met(keys_first, values_first,
-                                                           keys_result,values_result,
-                                                           count, queue);
+               && (reduce_by_key_with_look_back_requirements_met(keys_first, values_first,
+                                                                 keys_result, values_result,
+                                                                 count, queue)
+                   || reduce_by_key_with_scan_requirements_met(keys_first, values_first,
+                                                               keys_result,values_result,
+                                                               count, queue));
     return true;
 }
 
@@ -112,6 +132,47 @@ dispatch_reduce_by_key(InputKeyIterator keys_first,
         );
 }
 
+// same as dispatch_reduce_by_key() but stores the number of reduced values
+// in result_size. when the single-pass reduction is used the number stays
+// on the device.
+template<class InputKeyIterator, class InputValueIterator,
+         class OutputKeyIterator, class OutputValueIterator,
+         class BinaryFunction, class BinaryPredicate>
+inline void
+dispatch_reduce_by_key(InputKeyIterator keys_first,
+                       InputKeyIterator keys_last,
+                       InputValueIterator values_first,
+                       OutputKeyIterator keys_result,
+                       OutputValueIterator values_result,
+                       BinaryFunction function,
+                       BinaryPredicate predicate,
+                       buffer_iterator<uint_> result_size,
+                       command_queue &queue)
+{
+    const size_t count = detail::iterator_range_size(keys_first, keys_last);
+    if(count >= 2
+       && reduce_by_key_on_gpu_requirements_met(keys_first, values_first, keys_result,
+                                                values_result, count, queue)
+       && reduce_by_key_with_look_back_requirements_met(keys_first, values_first,
+                                                        keys_result, values_result,
+                                                        count, queue)){
+        detail::reduce_by_key_with_look_back(keys_first, keys_last, values_first,
+                                             keys_result, values_result, function,
+                                             predicate, result_size, queue);
+        return;
+    }
+
+    std::pair<OutputKeyIterator, OutputValueIterator> result_end =
+        dispatch_reduce_by_key(keys_first, keys_last, values_first,
+                               keys_result, values_result, function,
+                               predicate, queue);
+
+    write_single_value<uint_>(
+        static_cast<uint_>(std::distance(keys_result, result_end.first)),
+        result_size.get_buffer(), result_size.get_index(), queue
+    );
+}
+
 } // end detail namespace
 } // end compute namespace
 } // end boost namespace
@@ -0,0 +1,433 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://boostorg.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#ifndef BOOST_COMPUTE_ALGORITHM_DETAIL_REDUCE_BY_KEY_WITH_LOOK_BACK_HPP
+#define BOOST_COMPUTE_ALGORITHM_DETAIL_REDUCE_BY_KEY_WITH_LOOK_BACK_HPP
+
+#include <algorithm>
+#include <iterator>
+#include <string>
+
+#include <boost/compute/command_queue.hpp>
+#include <boost/compute/functional.hpp>
+#include <boost/compute/algorithm/fill.hpp>
+#include <boost/compute/container/vector.hpp>
+#include <boost/compute/detail/meta_kernel.hpp>
+#include <boost/compute/detail/iterator_range_size.hpp>
+#include <boost/compute/detail/parameter_cache.hpp>
+#include <boost/compute/iterator/buffer_iterator.hpp>
+#include <boost/compute/memory/local_buffer.hpp>
+#include <boost/compute/type_traits.hpp>
+
+namespace boost {
+namespace compute {
+namespace detail {
+
+// states of a tile in the look-back status array. the low bits hold the
+// state and the next bit whether the tile contains the start of a segment.
+const uint_ look_back_aggregate_available = 1;
+const uint_ look_back_prefix_available = 2;
+const uint_ look_back_state_mask = 3;
+const uint_ look_back_head_flag = 4;
+
+/// \internal_
+/// Emits "a = a (+) b" for the segmented reduction operator on the
+/// (valid, flag, value, count) tuples stored in the variables named
+/// prefix + "_valid", prefix + "_flag", etc. If b starts a segment its value
+/// replaces the value of a, otherwise the values are combined.
+template<class ValueType, class BinaryFunction>
+inline void look_back_combine(meta_kernel &k,
+                              const std::string &a,
+                              const std::string &b,
+                              BinaryFunction function)
+{
+    k <<
+        "if(" << b << "_valid){\n" <<
+        "    if(" << a << "_valid && !" << b << "_flag){\n" <<
+        "        " << a << "_value = " <<
+                 function(k.var<ValueType>(a + "_value"),
+                          k.var<ValueType>(b + "_value")) << ";\n" <<
+        "    }\n" <<
+        "    else {\n" <<
+        "        " << a << "_value = " << b << "_value;\n" <<
+        "    }\n" <<
+        "    " << a << "_count = " << a << "_count + " << b << "_count;\n" <<
+        "    " << a << "_flag = " << a << "_flag || " << b << "_flag;\n" <<
+        "    " << a << "_valid = true;\n" <<
+        "}\n";
+}
+
+/// \internal_
+/// Declares the variables of a (valid, flag, value, count) tuple.
+template<class ValueType>
+inline void look_back_declare(meta_kernel &k, const std::string &name)
+{
+    k <<
+        "bool " << name << "_valid = false;\n" <<
+        "bool " << name << "_flag = false;\n" <<
+        k.decl<ValueType>(name + "_value") << ";\n" <<
+        "uint " << name << "_count = 0;\n";
+}
+
+/// \internal_
+/// Returns the work-group size and the values per work-item used by
+/// reduce_by_key_with_look_back().
+template<class KeyType, class ValueType>
+inline void get_look_back_parameters(const device &device,
+                                     size_t &work_group_size,
+                                     size_t &values_per_thread)
+{
+    std::string cache_key = std::string("__boost_reduce_by_key_with_look_back_")
+        + "k_" + type_name<KeyType>() + "_v_" + type_name<ValueType>();
+
+    boost::shared_ptr<parameter_cache> parameters =
+        detail::parameter_cache::get_global_cache(device);
+
+    work_group_size = (std::min)(
+        static_cast<size_t>(parameters->get(cache_key, "wgsize", 128)),
+        device.max_work_group_size()
+    );
+    values_per_thread = parameters->get(cache_key, "vpt", 8);
+}
+
+/// \internal_
+///
+/// Single-pass reduction by key. Every work-group reduces one tile of
+/// work_group_size * values_per_thread consecutive pairs:
+///
+/// 1. Each work-item reduces its values into a (flag, value, count) tuple
+///    where flag tells whether a segment starts in its values, value is the
+///    reduction of the values since the last segment start and count is the
+///    number of segment starts.
+/// 2. The tuples are scanned in local memory giving the tile aggregate.
+/// 3. The first work-item publishes the aggregate and finds the prefix of
+///    the tile by looking back at the aggregates (or, once available, the
+///    inclusive prefixes) of the previous tiles. It then publishes the
+///    inclusive prefix of the tile (decoupled look-back).
+/// 4. Each work-item walks its values again, starting from its exclusive
+///    prefix, and writes the result of every segment ending in its values.
+///
+/// Tiles are numbered in the order the work-groups start (using an atomic
+/// counter) so that a work-group only waits for work-groups which are
+/// already running. The number of segments is written to \p result_size
+/// on the device.
+///
+/// Temporary space: O(number of tiles)
+template<class InputKeyIterator, class InputValueIterator,
+         class OutputKeyIterator, class OutputValueIterator,
+         class BinaryFunction, class BinaryPredicate>
+inline void reduce_by_key_with_look_back(InputKeyIterator keys_first,
+                                         InputKeyIterator keys_last,
+                                         InputValueIterator values_first,
+                                         OutputKeyIterator keys_result,
+                                         OutputValueIterator values_result,
+                                         BinaryFunction function,
+                                         BinaryPredicate predicate,
+                                         buffer_iterator<uint_> result_size,
+                                         command_queue &queue)
+{
+    typedef typename
+        std::iterator_traits<InputValueIterator>::value_type value_type;
+    typedef typename
+        std::iterator_traits<InputKeyIterator>::value_type key_type;
+    typedef typename
+        std::iterator_traits<OutputValueIterator>::value_type value_out_type;
+
+    const context &context = queue.get_context();
+    const device &device = queue.get_device();
+
+    const size_t count = detail::iterator_range_size(keys_first, keys_last);
+
+    size_t work_group_size = 0;
+    size_t values_per_thread = 0;
+    get_look_back_parameters<key_type, value_type>(
+        device, work_group_size, values_per_thread
+    );
+
+    const size_t tile_size = work_group_size * values_per_thread;
+    const size_t tiles = (count + tile_size - 1) / tile_size;
+
+    // the first element holds the tile counter
+    vector<uint_> status(tiles + 1, context);
+    vector<uint_> counts(2 * tiles, context);
+    vector<value_out_type> values(2 * tiles, context);
+    ::boost::compute::fill(status.begin(), status.end(), uint_(0), queue);
+
+    meta_kernel k("reduce_by_key_with_look_back");
+    k.add_set_arg<const uint_>("count", uint_(count));
+    k.add_set_arg<const uint_>("vpt", uint_(values_per_thread));
+    size_t status_arg =
+        k.add_arg<volatile uint_ *>(memory_object::global_memory, "status");
+    size_t counts_arg =
+        k.add_arg<volatile uint_ *>(memory_object::global_memory, "counts");
+    size_t values_arg =
+        k.add_arg<volatile value_out_type *>(memory_object::global_memory, "values");
+    size_t result_size_arg =
+        k.add_arg<uint_ *>(memory_object::global_memory, "result_size");
+    size_t local_flags_arg =
+        k.add_arg<uint_ *>(memory_object::local_memory, "lflags");
+    size_t local_counts_arg =
+        k.add_arg<uint_ *>(memory_object::local_memory, "lcounts");
+    size_t local_values_arg =
+        k.add_arg<value_out_type *>(memory_object::local_memory, "lvalues");
+
+    // the aggregate of tile t is stored at t and its inclusive prefix at
+    // tiles + t in counts and values
+    k.add_set_arg<const uint_>("tiles", uint_(tiles));
+
+    k <<
+        "__local uint tile_id;\n" <<
+        k.decl<const uint_>("lid") << " = get_local_id(0);\n" <<
+        k.decl<const uint_>("lsize") << " = get_local_size(0);\n" <<
+        "if(lid == 0){\n" <<
+        "    tile_id = atomic_inc(&status[0]);\n" <<
+        "}\n" <<
+        "barrier(CLK_LOCAL_MEM_FENCE);\n" <<
+        k.decl<const uint_>("tile") << " = tile_id;\n" <<
+        k.decl<const uint_>("begin") <<
+            " = min(tile * lsize * vpt + lid * vpt, count);\n" <<
+        k.decl<const uint_>("end") << " = min(begin + vpt, count);\n";
+
+    // 1. reduce the values of the work-item
+    look_back_declare<value_out_type>(k, "t");
+    k <<
+        "for(uint i = begin; i < end; i++){\n" <<
+        "    " << k.decl<value_out_type>("v") << " = " <<
+                    values_first[k.var<const uint_>("i")] << ";\n" <<
+        "    bool head = i == 0 || !(" <<
+                predicate(keys_first[k.var<const uint_>("i - 1")],
+                          keys_first[k.var<const uint_>("i")]) << ");\n" <<
+        "    if(head){\n" <<
+        "        t_value = v;\n" <<
+        "        t_count++;\n" <<
+        "        t_flag = true;\n" <<
+        "    }\n" <<
+        "    else if(i == begin){\n" <<
+        "        t_value = v;\n" <<
+        "    }\n" <<
+        "    else {\n" <<
+        "        t_value = " << function(k.var<value_out_type>("t_value"),
+                                         k.var<value_out_type>("v")) << ";\n" <<
+        "    }\n" <<
+        "}\n" <<
+        "t_valid = begin < end;\n";
+
+    // 2. inclusive scan of the work-item tuples in local memory
+    look_back_declare<value_out_type>(k, "p");
+    k <<
+        "lflags[lid] = (t_valid ? 2 : 0) | (t_flag ? 1 : 0);\n" <<
+        "lcounts[lid] = t_count;\n" <<
+        "lvalues[lid] = t_value;\n" <<
+        "for(uint offset = 1; offset < lsize; offset <<= 1){\n" <<
+        "    barrier(CLK_LOCAL_MEM_FENCE);\n" <<
+        "    if(lid >= offset){\n" <<
+        "        p_valid = (lflags[lid - offset] & 2) != 0;\n" <<
+        "        p_flag = (lflags[lid - offset] & 1) != 0;\n" <<
+        "        p_count = lcounts[lid - offset];\n" <<
+        "        p_value = lvalues[lid - offset];\n" <<
+        "    }\n" <<
+        "    barrier(CLK_LOCAL_MEM_FENCE);\n" <<
+        "    if(lid >= offset){\n";
+    look_back_combine<value_out_type>(k, "p", "t", function);
+    k <<
+        "        t_valid = p_valid;\n" <<
+        "        t_flag = p_flag;\n" <<
+        "        t_count = p_count;\n" <<
+        "        t_value = p_value;\n" <<
+        "        lflags[lid] = (t_valid ? 2 : 0) | (t_flag ? 1 : 0);\n" <<
+        "        lcounts[lid] = t_count;\n" <<
+        "        lvalues[lid] = t_value;\n" <<
+        "    }\n" <<
+        "}\n" <<
+        "barrier(CLK_LOCAL_MEM_FENCE);\n";
+
+    // 3. decoupled look-back, the tile prefix is passed to the other
+    //    work-items through local memory slot lsize - 1 once every work-item
+    //    has read its exclusive prefix
+    look_back_declare<value_out_type>(k, "e");
+    k <<
+        "if(lid > 0){\n" <<
+        "    e_valid = (lflags[lid - 1] & 2) != 0;\n" <<
+        "    e_flag = (lflags[lid - 1] & 1) != 0;\n" <<
+        "    e_count = lcounts[lid - 1];\n" <<
+        "    e_value = lvalues[lid - 1];\n" <<
+        "}\n";
+    look_back_declare<value_out_type>(k, "a");
+    look_back_declare<value_out_type>(k, "b");
+    k <<
+        "a_valid = true;\n" <<
+        "a_flag = (lflags[lsize - 1] & 1) != 0;\n" <<
+        "a_count = lcounts[lsize - 1];\n" <<
+        "a_value = lvalues[lsize - 1];\n" <<
+        "barrier(CLK_LOCAL_MEM_FENCE);\n" <<
+        "if(lid == 0){\n" <<
+        "    const uint flag_bit = a_flag ? " << look_back_head_flag << " : 0;\n" <<
+        "    if(tile == 0){\n" <<
+        "        counts[tiles] = a_count;\n" <<
+        "        values[tiles] = a_value;\n" <<
+        "        mem_fence(CLK_GLOBAL_MEM_FENCE);\n" <<
+        "        atomic_xchg(&status[1], " << look_back_prefix_available << " | flag_bit);\n" <<
+        "    }\n" <<
+        "    else {\n" <<
+        "        counts[tile] = a_count;\n" <<
+        "        values[tile] = a_value;\n" <<
+        "        mem_fence(CLK_GLOBAL_MEM_FENCE);\n" <<
+        "        atomic_xchg(&status[tile + 1], " << look_back_aggregate_available << " | flag_bit);\n" <<
+
+        // b is the prefix of the tiles looked at so far and p the tile
+        // being looked at
+        "        uint t = tile;\n" <<
+        "        for(;;){\n" <<
+        "            t--;\n" <<
+        "            uint state;\n" <<
+        "            do {\n" <<
+        "                state = atomic_or(&status[t + 1], 0);\n" <<
+        "            } while((state & " << look_back_state_mask << ") == 0);\n" <<
+        "            mem_fence(CLK_GLOBAL_MEM_FENCE);\n" <<
+        "            const uint index = (state & " << look_back_state_mask << ") == " <<
+                         look_back_prefix_available << " ? tiles + t : t;\n" <<
+        "            p_valid = true;\n" <<
+        "            p_flag = (state & " << look_back_head_flag << ") != 0;\n" <<
+        "            p_count = counts[index];\n" <<
+        "            p_value = values[index];\n";
+    look_back_combine<value_out_type>(k, "p", "b", function);
+    k <<
+        "            b_valid = p_valid;\n" <<
+        "            b_flag = p_flag;\n" <<
+        "            b_count = p_count;\n" <<
+        "            b_value = p_value;\n" <<
+        "            if((state & " << look_back_state_mask << ") == " <<
+                         look_back_prefix_available << "){\n" <<
+        "                break;\n" <<
+        "            }\n" <<
+        "        }\n" <<
+        "        p_valid = b_valid;\n" <<
+        "        p_flag = b_flag;\n" <<
+        "        p_count = b_count;\n" <<
+        "        p_value = b_value;\n";
+    look_back_combine<value_out_type>(k, "p", "a", function);
+    k <<
+        "        counts[tiles + tile] = p_count;\n" <<
+        "        values[tiles + tile] = p_value;\n" <<
+        "        mem_fence(CLK_GLOBAL_MEM_FENCE);\n" <<
+        "        atomic_xchg(&status[tile + 1], " << look_back_prefix_available << " | " <<
+                     "(p_flag ? " << look_back_head_flag << " : 0));\n" <<
+        "        lflags[lsize - 1] = (b_flag ? 1 : 0);\n" <<
+        "        lcounts[lsize - 1] = b_count;\n" <<
+        "        lvalues[lsize - 1] = b_value;\n" <<
+        "    }\n" <<
+        "}\n" <<
+        "barrier(CLK_LOCAL_MEM_FENCE);\n" <<
+        "if(tile > 0){\n" <<
+        "    b_valid = true;\n" <<
+        "    b_flag = (lflags[lsize - 1] & 1) != 0;\n" <<
+        "    b_count = lcounts[lsize - 1];\n" <<
+        "    b_value = lvalues[lsize - 1];\n";
+    look_back_combine<value_out_type>(k, "b", "e", function);
+    k <<
+        "    e_valid = b_valid;\n" <<
+        "    e_count = b_count;\n" <<
+        "    e_value = b_value;\n" <<
+        "}\n";
+
+    // 4. write the result of each segment ending in the work-item's values
+    k <<
+        "uint segment = e_count;\n" <<
+        k.decl<value_out_type>("acc") << " = e_value;\n" <<
+        "for(uint i = begin; i < end; i++){\n" <<
+        "    " << k.decl<value_out_type>("v") << " = " <<
+                    values_first[k.var<const uint_>("i")] << ";\n" <<
+        "    if(i == 0 || !(" <<
+                predicate(keys_first[k.var<const uint_>("i - 1")],
+                          keys_first[k.var<const uint_>("i")]) << ")){\n" <<
+        "        acc = v;\n" <<
+        "        segment++;\n" <<
+        "    }\n" <<
+        "    else {\n" <<
+        "        acc = " << function(k.var<value_out_type>("acc"),
+                                     k.var<value_out_type>("v")) << ";\n" <<
+        "    }\n" <<
+        "    if(i + 1 == count || !(" <<
+                predicate(keys_first[k.var<const uint_>("i")],
+                          keys_first[k.var<const uint_>("i + 1")]) << ")){\n" <<
+        "        " << keys_result[k.var<const uint_>("segment - 1")] << " = " <<
+                     keys_first[k.var<const uint_>("i")] << ";\n" <<
+        "        " << values_result[k.var<const uint_>("segment - 1")] << " = acc;\n" <<
+        "    }\n" <<
+        "}\n" <<
+        "if(begin < end && end == count){\n" <<
+        "    result_size[0] = segment;\n" <<
+        "}\n";
+
+    kernel kernel = k.compile(context);
+    kernel.set_arg(status_arg, status.get_buffer());
+    kernel.set_arg(counts_arg, counts.get_buffer());
+    kernel.set_arg(values_arg, values.get_buffer());
+    kernel.set_arg(result_size_arg, result_size.get_buffer());
+    kernel.set_arg(local_flags_arg, local_buffer<uint_>(work_group_size));
+    kernel.set_arg(local_counts_arg, local_buffer<uint_>(work_group_size));
+    kernel.set_arg(local_values_arg, local_buffer<value_out_type>(work_group_size));
+
+    queue.enqueue_1d_range_kernel(kernel,
+                                  0,
+                                  tiles * work_group_size,
+                                  work_group_size);
+}
+
+/// \internal_
+/// Return true if requirements for running reduce by key with look-back on
+/// given device are met (the local scan fits in local memory).
+template<class InputKeyIterator, class InputValueIterator,
+         class OutputKeyIterator, class OutputValueIterator>
+bool reduce_by_key_with_look_back_requirements_met(InputKeyIterator keys_first,
+                                                   InputValueIterator values_first,
+                                                   OutputKeyIterator keys_result,
+                                                   OutputValueIterator values_result,
+                                                   const size_t count,
+                                                   command_queue &queue)
+{
+    typedef typename
+        std::iterator_traits<InputValueIterator>::value_type value_type;
+    typedef typename
+        std::iterator_traits<InputKeyIterator>::value_type key_type;
+    typedef typename
+        std::iterator_traits<OutputValueIterator>::value_type value_out_type;
+
+    (void) keys_first;
+    (void) values_first;
+    (void) keys_result;
+    (void) values_result;
+    (void) count;
+
+    const device &device = queue.get_device();
+    // device must have dedicated local memory storage
+    if(device.get_info<CL_DEVICE_LOCAL_MEM_TYPE>() != CL_LOCAL)
+    {
+        return false;
+    }
+
+    size_t work_group_size = 0;
+    size_t values_per_thread = 0;
+    get_look_back_parameters<key_type, value_type>(
+        device, work_group_size, values_per_thread
+    );
+
+    const size_t local_mem_size = device.get_info<CL_DEVICE_LOCAL_MEM_SIZE>();
+    const size_t required_local_mem_size =
+        (2 * sizeof(uint_) + sizeof(value_out_type)) * work_group_size;
+
+    return (required_local_mem_size <= local_mem_size);
+}
+
+} // end detail namespace
+} // end compute namespace
+} // end boost namespace
+
+#endif // BOOST_COMPUTE_ALGORITHM_DETAIL_REDUCE_BY_KEY_WITH_LOOK_BACK_HPP
@@ -0,0 +1,343 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://boostorg.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#ifndef BOOST_COMPUTE_ALGORITHM_DETAIL_REDUCE_MULTIPLE_HPP
+#define BOOST_COMPUTE_ALGORITHM_DETAIL_REDUCE_MULTIPLE_HPP
+
+#include <string>
+#include <iterator>
+#include <algorithm>
+
+#include <boost/lexical_cast.hpp>
+#include <boost/mpl/back_inserter.hpp>
+#include <boost/mpl/transform.hpp>
+#include <boost/mpl/vector.hpp>
+#include <boost/tuple/tuple.hpp>
+#include <boost/type_traits/remove_cv.hpp>
+
+#include <boost/compute/command_queue.hpp>
+#include <boost/compute/container/array.hpp>
+#include <boost/compute/container/vector.hpp>
+#include <boost/compute/algorithm/copy_n.hpp>
+#include <boost/compute/detail/meta_kernel.hpp>
+#include <boost/compute/detail/iterator_range_size.hpp>
+#include <boost/compute/detail/mpl_vector_to_tuple.hpp>
+#include <boost/compute/detail/parameter_cache.hpp>
+#include <boost/compute/memory/local_buffer.hpp>
+#include <boost/compute/type_traits/type_name.hpp>
+#include <boost/compute/types/tuple.hpp>
+
+namespace boost {
+namespace compute {
+namespace detail {
+
+// meta-function returning the result type of a (transform, function, init)
+// reduction triple (which is the type of its initial value)
+template<class Reduction>
+struct reduction_result_type
+{
+    typedef typename
+        boost::remove_cv<
+            typename boost::tuples::element<2, Reduction>::type
+        >::type type;
+};
+
+// meta-function returning the boost::tuple<> of result types for a tuple
+// of reduction triples
+template<class Reductions>
+struct reduce_multiple_result_type
+{
+    typedef typename
+        mpl_vector_to_tuple<
+            typename mpl::transform<
+                Reductions,
+                reduction_result_type<mpl::_1>,
+                mpl::back_inserter<mpl::vector<> >
+            >::type
+        >::type type;
+};
+
+// emits one statement per reduction for each phase of the reduce_multiple
+// kernels. the accumulators are stored in a tuple variable and the I'th
+// reduction is accumulated in its I'th field (e.g. "acc.v2").
+template<class Reductions, size_t I, size_t N>
+struct reduce_multiple_emitter
+{
+    typedef typename boost::tuples::element<I, Reductions>::type reduction_type;
+    typedef typename reduction_result_type<reduction_type>::type result_type;
+    typedef reduce_multiple_emitter<Reductions, I + 1, N> next;
+
+    // acc.vI = transform(x)
+    template<class T>
+    static void init(meta_kernel &k,
+                     const Reductions &reductions,
+                     const std::string &acc,
+                     const meta_kernel_variable<T> &x)
+    {
+        const reduction_type &r = boost::get<I>(reductions);
+
+        k << field(acc) << " = " << boost::get<0>(r)(x) << ";\n";
+
+        next::init(k, reductions, acc, x);
+    }
+
+    // acc.vI = function(acc.vI, transform(x))
+    template<class T>
+    static void accumulate(meta_kernel &k,
+                           const Reductions &reductions,
+                           const std::string &acc,
+                           const meta_kernel_variable<T> &x)
+    {
+        const reduction_type &r = boost::get<I>(reductions);
+
+        k << field(acc) << " = " <<
+            boost::get<1>(r)(k.var<result_type>(field(acc)),
+                             boost::get<0>(r)(x)) << ";\n";
+
+        next::accumulate(k, reductions, acc, x);
+    }
+
+    // acc.vI = function(acc.vI, other.vI)
+    static void combine(meta_kernel &k,
+                        const Reductions &reductions,
+                        const std::string &acc,
+                        const std::string &other)
+    {
+        const reduction_type &r = boost::get<I>(reductions);
+
+        k << field(acc) << " = " <<
+            boost::get<1>(r)(k.var<result_type>(field(acc)),
+                             k.var<result_type>(field(other))) << ";\n";
+
+        next::combine(k, reductions, acc, other);
+    }
+
+    // acc.vI = function(init, acc.vI)
+    static void finish(meta_kernel &k,
+                       const Reductions &reductions,
+                       const std::string &acc)
+    {
+        const reduction_type &r = boost::get<I>(reductions);
+
+        k << field(acc) << " = " <<
+            boost::get<1>(r)(k.lit<result_type>(boost::get<2>(r)),
+                             k.var<result_type>(field(acc))) << ";\n";
+
+        next::finish(k, reductions, acc);
+    }
+
+    // stores the initial values in result (used for empty ranges)
+    template<class Result>
+    static void initial_values(const Reductions &reductions, Result &result)
+    {
+        boost::get<I>(result) = boost::get<2>(boost::get<I>(reductions));
+
+        next::initial_values(reductions, result);
+    }
+
+    static std::string field(const std::string &tuple)
+    {
+        return tuple + ".v" + boost::lexical_cast<std::string>(I);
+    }
+};
+
+template<class Reductions, size_t N>
+struct reduce_multiple_emitter<Reductions, N, N>
+{
+    template<class T>
+    static void init(meta_kernel&, const Reductions&,
+                     const std::string&, const meta_kernel_variable<T>&)
+    {
+    }
+
+    template<class T>
+    static void accumulate(meta_kernel&, const Reductions&,
+                           const std::string&, const meta_kernel_variable<T>&)
+    {
+    }
+
+    static void combine(meta_kernel&, const Reductions&,
+                        const std::string&, const std::string&)
+    {
+    }
+
+    static void finish(meta_kernel&, const Reductions&, const std::string&)
+    {
+    }
+
+    template<class Result>
+    static void initial_values(const Reductions&, Result&)
+    {
+    }
+};
+
+// Reduces [first, last) with every (transform, function, init) triple in
+// reductions at once and writes the tuple of results to result. The input
+// is read once by a single kernel which leaves one partial result tuple per
+// work-group (or per compute unit on CPU devices). A second single work-item
+// kernel combines the partial results and applies the initial values.
+//
+// Space complexity: O(compute units)
+template<class InputIterator, class Reductions, class OutputIterator>
+inline void reduce_multiple(InputIterator first,
+                            InputIterator last,
+                            const Reductions &reductions,
+                            OutputIterator result,
+                            command_queue &queue)
+{
+    typedef typename
+        std::iterator_traits<InputIterator>::value_type input_type;
+    typedef typename
+        reduce_multiple_result_type<Reductions>::type result_type;
+    typedef reduce_multiple_emitter<
+        Reductions, 0, boost::tuples::length<Reductions>::value
+    > emitter;
+
+    const device &device = queue.get_device();
+    const context &context = queue.get_context();
+
+    size_t count = detail::iterator_range_size(first, last);
+    if(count == 0){
+        result_type value;
+        emitter::initial_values(reductions, value);
+        copy_n(&value, 1, result, queue);
+        return;
+    }
+
+    const bool is_cpu = (device.type() & device::cpu) != 0;
+    const uint_ compute_units = device.compute_units();
+
+    std::string cache_key =
+        std::string("__boost_reduce_multiple_") + type_name<result_type>();
+    boost::shared_ptr<parameter_cache> parameters =
+        detail::parameter_cache::get_global_cache(device);
+
+    size_t tpb = 1;
+    size_t work_groups = 0;
+    size_t block_size = 0;
+    if(is_cpu){
+        // each work-item reduces one contiguous block
+        block_size = (count + compute_units - 1) / compute_units;
+        work_groups = (count + block_size - 1) / block_size;
+    }
+    else {
+        uint_ vpt = parameters->get(cache_key, "vpt", 8);
+        tpb = parameters->get(cache_key, "tpb", 128);
+        tpb = (std::min)(tpb, device.max_work_group_size());
+
+        // every work-group must have at least one input value
+        work_groups = (count + vpt * tpb - 1) / (vpt * tpb);
+        work_groups = (std::min)(work_groups, size_t(compute_units * 16));
+    }
+
+    // first pass, reduce the input to one tuple per work-group
+    meta_kernel k("reduce_multiple");
+    size_t count_arg = k.add_arg<const uint_>("count");
+    size_t block_arg = k.add_arg<const uint_>("block");
+    size_t output_arg =
+        k.add_arg<result_type *>(memory_object::global_memory, "output");
+    size_t scratch_arg =
+        k.add_arg<result_type *>(memory_object::local_memory, "scratch");
+
+    k <<
+        k.decl<const uint_>("lid") << " = get_local_id(0);\n" <<
+        k.decl<const uint_>("lsize") << " = get_local_size(0);\n" <<
+        "uint index, end, stride;\n" <<
+        "if(block > 0){\n" <<
+        "    index = get_global_id(0) * block;\n" <<
+        "    end = min(count, index + block);\n" <<
+        "    stride = 1;\n" <<
+        "}\n" <<
+        "else {\n" <<
+        "    index = get_global_id(0);\n" <<
+        "    end = count;\n" <<
+        "    stride = get_global_size(0);\n" <<
+        "}\n" <<
+        k.decl<result_type>("acc") << ";\n" <<
+        k.decl<result_type>("other") << ";\n" <<
+        "const bool valid = index < end;\n" <<
+
+        // private reduction
+        "if(valid){\n" <<
+        k.decl<input_type>("x") << " = " << first[k.var<uint_>("index")] << ";\n";
+    emitter::init(k, reductions, "acc", k.var<input_type>("x"));
+    k <<
+        "}\n" <<
+        "for(index += stride; index < end; index += stride){\n" <<
+        k.decl<input_type>("x") << " = " << first[k.var<uint_>("index")] << ";\n";
+    emitter::accumulate(k, reductions, "acc", k.var<input_type>("x"));
+    k <<
+        "}\n" <<
+
+        // local reduction, work-items without values have a higher local
+        // id than all the work-items with values and never get combined
+        "scratch[lid] = acc;\n" <<
+        "for(uint i = 1; i < lsize; i <<= 1){\n" <<
+        "    barrier(CLK_LOCAL_MEM_FENCE);\n" <<
+        "    uint mask = (i << 1) - 1;\n" <<
+        "    if((lid & mask) == 0 && lid + i < lsize && " <<
+                "get_global_id(0) + i < count){\n" <<
+        "        other = scratch[lid+i];\n";
+    emitter::combine(k, reductions, "acc", "other");
+    k <<
+        "        scratch[lid] = acc;\n" <<
+        "    }\n" <<
+        "}\n" <<
+
+        // write the work-group result
+        "if(lid == 0){\n" <<
+        "    output[get_group_id(0)] = acc;\n" <<
+        "}\n";
+
+    array<result_type, 1> value(context);
+    vector<result_type> partials(work_groups, context);
+
+    kernel reduce_kernel = k.compile(context);
+    reduce_kernel.set_arg(count_arg, static_cast<uint_>(count));
+    reduce_kernel.set_arg(block_arg, static_cast<uint_>(block_size));
+    reduce_kernel.set_arg(output_arg, partials.get_buffer());
+    reduce_kernel.set_arg(scratch_arg, local_buffer<result_type>(tpb));
+
+    queue.enqueue_1d_range_kernel(reduce_kernel, 0, work_groups * tpb, tpb);
+
+    // second pass, combine the partial results and apply the initial values
+    meta_kernel f("reduce_multiple_finish");
+    size_t partials_count_arg = f.add_arg<const uint_>("count");
+    size_t partials_arg =
+        f.add_arg<const result_type *>(memory_object::global_memory, "partials");
+    size_t result_arg =
+        f.add_arg<result_type *>(memory_object::global_memory, "result");
+
+    f <<
+        f.decl<result_type>("acc") << " = partials[0];\n" <<
+        f.decl<result_type>("other") << ";\n" <<
+        "for(uint i = 1; i < count; i++){\n" <<
+        "    other = partials[i];\n";
+    emitter::combine(f, reductions, "acc", "other");
+    f << "}\n";
+    emitter::finish(f, reductions, "acc");
+    f << "result[0] = acc;\n";
+
+    kernel finish_kernel = f.compile(context);
+    finish_kernel.set_arg(partials_count_arg, static_cast<uint_>(work_groups));
+    finish_kernel.set_arg(partials_arg, partials.get_buffer());
+    finish_kernel.set_arg(result_arg, value.get_buffer());
+
+    queue.enqueue_task(finish_kernel);
+
+    // copy the result tuple to the result iterator
+    copy_n(value.begin(), 1, result, queue);
+}
+
+} // end detail namespace
+} // end compute namespace
+} // end boost namespace
+
+#endif // BOOST_COMPUTE_ALGORITHM_DETAIL_REDUCE_MULTIPLE_HPP
@@ -0,0 +1,409 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://boostorg.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#ifndef BOOST_COMPUTE_ALGORITHM_DETAIL_SAMPLE_SORT_ON_CPU_HPP
+#define BOOST_COMPUTE_ALGORITHM_DETAIL_SAMPLE_SORT_ON_CPU_HPP
+
+#include <iterator>
+
+#include <boost/compute/kernel.hpp>
+#include <boost/compute/command_queue.hpp>
+#include <boost/compute/algorithm/exclusive_scan.hpp>
+#include <boost/compute/container/vector.hpp>
+#include <boost/compute/detail/meta_kernel.hpp>
+#include <boost/compute/detail/iterator_range_size.hpp>
+
+namespace boost {
+namespace compute {
+namespace detail {
+
+// emits the code moving the key (and value) at from_index in the from
+// ranges to to_index in the to ranges
+template<class FromKeyIterator,
+         class FromValueIterator,
+         class ToKeyIterator,
+         class ToValueIterator>
+inline void sample_sort_emit_move(meta_kernel &k,
+                                  FromKeyIterator from_keys,
+                                  FromValueIterator from_values,
+                                  const char *from_index,
+                                  ToKeyIterator to_keys,
+                                  ToValueIterator to_values,
+                                  const char *to_index,
+                                  const bool sort_by_key)
+{
+    k << to_keys[k.var<uint_>(to_index)] << " = " <<
+         from_keys[k.var<uint_>(from_index)] << ";\n";
+    if(sort_by_key){
+        k << to_values[k.var<uint_>(to_index)] << " = " <<
+             from_values[k.var<uint_>(from_index)] << ";\n";
+    }
+}
+
+// emits the code merging each pair of sorted runs of width values in
+// [begin, end) of the a ranges into the b ranges (stable)
+template<class AKeyIterator,
+         class AValueIterator,
+         class BKeyIterator,
+         class BValueIterator,
+         class Compare>
+inline void sample_sort_emit_merge(meta_kernel &k,
+                                   AKeyIterator a_keys,
+                                   AValueIterator a_values,
+                                   BKeyIterator b_keys,
+                                   BValueIterator b_values,
+                                   Compare compare,
+                                   const bool sort_by_key)
+{
+    k <<
+        "for(uint left = begin; left < end; left += 2 * width){\n" <<
+        "    const uint mid = min(left + width, end);\n" <<
+        "    const uint right = min(mid + width, end);\n" <<
+        "    uint i = left;\n" <<
+        "    uint j = mid;\n" <<
+        "    uint o = left;\n" <<
+        "    while(i < mid && j < right){\n" <<
+        "        if(" << compare(a_keys[k.var<uint_>("j")],
+                                 a_keys[k.var<uint_>("i")]) << "){\n";
+    sample_sort_emit_move(k, a_keys, a_values, "j", b_keys, b_values, "o", sort_by_key);
+    k <<
+        "            j++;\n" <<
+        "        }\n" <<
+        "        else {\n";
+    sample_sort_emit_move(k, a_keys, a_values, "i", b_keys, b_values, "o", sort_by_key);
+    k <<
+        "            i++;\n" <<
+        "        }\n" <<
+        "        o++;\n" <<
+        "    }\n" <<
+        "    for(; i < mid; i++, o++){\n";
+    sample_sort_emit_move(k, a_keys, a_values, "i", b_keys, b_values, "o", sort_by_key);
+    k <<
+        "    }\n" <<
+        "    for(; j < right; j++, o++){\n";
+    sample_sort_emit_move(k, a_keys, a_values, "j", b_keys, b_values, "o", sort_by_key);
+    k <<
+        "    }\n" <<
+        "}\n";
+}
+
+// sorts each bucket [bucket_offsets[b], bucket_offsets[b+1]) of the source
+// ranges with one work-item per bucket and writes the sorted bucket to the
+// same positions in the result ranges (the source ranges are used as
+// scratch space). each work-item insertion sorts runs of run_size values
+// and then merges them, alternating between the source and the result, so
+// a bucket which fits in the cache is sorted without touching memory.
+// the sort is stable.
+template<class KeyIterator,
+         class ValueIterator,
+         class KeyResultIterator,
+         class ValueResultIterator,
+         class Compare>
+inline void sample_sort_buckets(KeyIterator keys_first,
+                                ValueIterator values_first,
+                                KeyResultIterator keys_result,
+                                ValueResultIterator values_result,
+                                const vector<uint_> &bucket_offsets,
+                                Compare compare,
+                                const size_t run_size,
+                                const bool sort_by_key,
+                                command_queue &queue)
+{
+    typedef typename std::iterator_traits<KeyIterator>::value_type K;
+    typedef typename std::iterator_traits<ValueIterator>::value_type T;
+
+    meta_kernel k("sample_sort_on_cpu_sort_buckets");
+    size_t offsets_arg =
+        k.add_arg<const uint_ *>(memory_object::global_memory, "bucket_offsets");
+    k.add_set_arg<const uint_>("run_size", uint_(run_size));
+
+    k <<
+        "const uint bucket = get_global_id(0);\n" <<
+        "const uint begin = bucket_offsets[bucket];\n" <<
+        "const uint end = bucket_offsets[bucket+1];\n" <<
+
+        // insertion sort runs (stable)
+        "for(uint start = begin; start < end; start += run_size){\n" <<
+        "    const uint run_end = min(start + run_size, end);\n" <<
+        "    for(uint i = start + 1; i < run_end; i++){\n" <<
+        "        " << k.decl<const K>("key") << " = " <<
+                      keys_first[k.var<uint_>("i")] << ";\n";
+    if(sort_by_key){
+        k <<
+        "        " << k.decl<const T>("value") << " = " <<
+                      values_first[k.var<uint_>("i")] << ";\n";
+    }
+    k <<
+        "        uint pos = i;\n" <<
+        "        while(pos > start && " <<
+                       compare(k.var<const K>("key"),
+                               keys_first[k.var<uint_>("pos-1")]) << "){\n";
+    sample_sort_emit_move(
+        k, keys_first, values_first, "pos-1", keys_first, values_first, "pos", sort_by_key
+    );
+    k <<
+        "            pos--;\n" <<
+        "        }\n" <<
+        "        " << keys_first[k.var<uint_>("pos")] << " = key;\n";
+    if(sort_by_key){
+        k <<
+        "        " << values_first[k.var<uint_>("pos")] << " = value;\n";
+    }
+    k <<
+        "    }\n" <<
+        "}\n" <<
+
+        // merge the runs
+        "bool in_source = true;\n" <<
+        "for(uint width = run_size; width < end - begin; width *= 2){\n" <<
+        "    if(in_source){\n";
+    sample_sort_emit_merge(
+        k, keys_first, values_first, keys_result, values_result, compare, sort_by_key
+    );
+    k <<
+        "    }\n" <<
+        "    else {\n";
+    sample_sort_emit_merge(
+        k, keys_result, values_result, keys_first, values_first, compare, sort_by_key
+    );
+    k <<
+        "    }\n" <<
+        "    in_source = !in_source;\n" <<
+        "}\n" <<
+        "if(in_source){\n" <<
+        "    for(uint i = begin; i < end; i++){\n";
+    sample_sort_emit_move(
+        k, keys_first, values_first, "i", keys_result, values_result, "i", sort_by_key
+    );
+    k <<
+        "    }\n" <<
+        "}\n";
+
+    kernel kernel = k.compile(queue.get_context());
+    kernel.set_arg(offsets_arg, bucket_offsets.get_buffer());
+    queue.enqueue_1d_range_kernel(kernel, 0, bucket_offsets.size() - 1, 0);
+}
+
+// returns the number of buckets the sample sort of count values splits them
+// into (at least two per compute unit, so that each has work, and enough
+// for each bucket to have about bucket_size values)
+inline size_t sample_sort_bucket_count(size_t count,
+                                       size_t bucket_size,
+                                       const device &device)
+{
+    return (std::max)(
+        (count + bucket_size - 1) / bucket_size,
+        size_t(2) * device.compute_units()
+    );
+}
+
+// stable sample sort for cpu devices. the sort makes a constant number of
+// passes over the values instead of one per merge level:
+//
+// 1. a sample of oversampling values per bucket is taken from the keys and
+//    sorted (by a single work-item), every oversampling-th sample is a
+//    splitter between two buckets.
+// 2. each work-item finds the bucket of each key of a chunk of the input
+//    with a binary search over the splitters and counts the keys of each
+//    bucket. the counts are stored bucket-major and scanned so that the
+//    keys of each bucket are in input order.
+// 3. each work-item moves the values of its chunk to their bucket in the
+//    temporary ranges.
+// 4. each bucket is sorted by a single work-item (see sample_sort_buckets())
+//    and written back to the input ranges.
+//
+// keys equal to a run of several equal splitters (e.g. when there are few
+// distinct keys) are spread over the buckets between those splitters by
+// their position in the input instead of all going to one bucket. the
+// buckets of equal keys are in input order, so the sort is stable.
+template<class KeyIterator, class ValueIterator, class Compare>
+inline void sample_sort_on_cpu(KeyIterator keys_first,
+                               ValueIterator values_first,
+                               Compare compare,
+                               const size_t count,
+                               const size_t bucket_size,
+                               const size_t run_size,
+                               const bool sort_by_key,
+                               command_queue &queue)
+{
+    typedef typename std::iterator_traits<KeyIterator>::value_type K;
+    typedef typename std::iterator_traits<ValueIterator>::value_type T;
+
+    const context &context = queue.get_context();
+    const device &device = queue.get_device();
+
+    if(count < 2){
+        return;
+    }
+
+    // each bucket needs oversampling values in the sample
+    const size_t oversampling = 16;
+    const size_t buckets = (std::max)(
+        size_t(1),
+        (std::min)(sample_sort_bucket_count(count, bucket_size, device),
+                   count / oversampling)
+    );
+    const size_t sample_count = (std::min)(buckets * oversampling, count);
+    const size_t chunks = (std::max)(
+        size_t(1),
+        (std::min)(size_t(4) * device.compute_units(), count / 4096)
+    );
+    const size_t chunk_size = (count + chunks - 1) / chunks;
+
+    // 1. take the sample and sort it
+    vector<K> samples(sample_count, context);
+    vector<K> sorted_samples(sample_count, context);
+
+    meta_kernel sample_kernel("sample_sort_on_cpu_sample");
+    sample_kernel.add_set_arg<const uint_>("stride", uint_(count / sample_count));
+    sample_kernel <<
+        "const uint i = get_global_id(0);\n" <<
+        "const uint position = i * stride + ((i * 2654435761u) >> 8) % stride;\n" <<
+        samples.begin()[sample_kernel.var<uint_>("i")] << " = " <<
+            keys_first[sample_kernel.var<uint_>("position")] << ";\n";
+    kernel kernel = sample_kernel.compile(context);
+    queue.enqueue_1d_range_kernel(kernel, 0, sample_count, 0);
+
+    const uint_ sample_offsets_data[] = { 0, static_cast<uint_>(sample_count) };
+    vector<uint_> sample_offsets(sample_offsets_data, sample_offsets_data + 2, queue);
+    sample_sort_buckets(
+        samples.begin(), values_first, sorted_samples.begin(), values_first,
+        sample_offsets, compare, run_size, false, queue
+    );
+
+    // 2. find and count the bucket of each key
+    vector<uint_> key_buckets(count, context);
+    vector<uint_> bucket_counts(buckets * chunks + 1, context);
+
+    meta_kernel count_kernel("sample_sort_on_cpu_count");
+    count_kernel.add_set_arg<const uint_>("count", uint_(count));
+    count_kernel.add_set_arg<const uint_>("chunk_size", uint_(chunk_size));
+    count_kernel.add_set_arg<const uint_>("chunks", uint_(chunks));
+    count_kernel.add_set_arg<const uint_>("buckets", uint_(buckets));
+    count_kernel.add_set_arg<const uint_>("oversampling", uint_(oversampling));
+    size_t key_buckets_arg =
+        count_kernel.add_arg<uint_ *>(memory_object::global_memory, "key_buckets");
+    size_t counts_arg =
+        count_kernel.add_arg<uint_ *>(memory_object::global_memory, "counts");
+    count_kernel <<
+        "const uint chunk = get_global_id(0);\n" <<
+        "const uint begin = chunk * chunk_size;\n" <<
+        "const uint end = min(begin + chunk_size, count);\n" <<
+        "for(uint b = 0; b < buckets; b++){\n" <<
+        "    counts[b * chunks + chunk] = 0;\n" <<
+        "}\n" <<
+        "for(uint i = begin; i < end; i++){\n" <<
+        "    " << count_kernel.decl<const K>("key") << " = " <<
+                  keys_first[count_kernel.var<uint_>("i")] << ";\n" <<
+        // the bucket is the index of the first splitter greater than key
+        "    uint lo = 0;\n" <<
+        "    uint hi = buckets - 1;\n" <<
+        "    while(lo < hi){\n" <<
+        "        const uint mid = (lo + hi) / 2;\n" <<
+        "        if(" << compare(count_kernel.var<const K>("key"),
+                                 sorted_samples.begin()[
+                                     count_kernel.var<uint_>("(mid + 1) * oversampling")
+                                 ]) << "){\n" <<
+        "            hi = mid;\n" <<
+        "        }\n" <<
+        "        else {\n" <<
+        "            lo = mid + 1;\n" <<
+        "        }\n" <<
+        "    }\n" <<
+        // if key equals the previous splitter, find the first splitter
+        // which is not less than key and spread the equal keys over the
+        // buckets in between by their position
+        "    uint bucket = lo;\n" <<
+        "    if(lo > 0 && !(" << compare(sorted_samples.begin()[
+                                          count_kernel.var<uint_>("lo * oversampling")
+                                      ],
+                                      count_kernel.var<const K>("key")) << ")){\n" <<
+        "        uint first = 0;\n" <<
+        "        hi = lo - 1;\n" <<
+        "        while(first < hi){\n" <<
+        "            const uint mid = (first + hi) / 2;\n" <<
+        "            if(" << compare(sorted_samples.begin()[
+                                         count_kernel.var<uint_>("(mid + 1) * oversampling")
+                                     ],
+                                     count_kernel.var<const K>("key")) << "){\n" <<
+        "                first = mid + 1;\n" <<
+        "            }\n" <<
+        "            else {\n" <<
+        "                hi = mid;\n" <<
+        "            }\n" <<
+        "        }\n" <<
+        "        bucket = first + (uint)(((ulong) i * (lo - first + 1)) / count);\n" <<
+        "    }\n" <<
+        "    key_buckets[i] = bucket;\n" <<
+        "    counts[bucket * chunks + chunk]++;\n" <<
+        "}\n";
+    kernel = count_kernel.compile(context);
+    kernel.set_arg(key_buckets_arg, key_buckets.get_buffer());
+    kernel.set_arg(counts_arg, bucket_counts.get_buffer());
+    queue.enqueue_1d_range_kernel(kernel, 0, chunks, 0);
+
+    ::boost::compute::exclusive_scan(
+        bucket_counts.begin(), bucket_counts.end(), bucket_counts.begin(), queue
+    );
+
+    // 3. move the values to their buckets. the first chunk also stores the
+    // offset of each bucket (before its offsets are advanced)
+    vector<K> keys_temp(count, context);
+    vector<T> values_temp(sort_by_key ? count : 0, context);
+    vector<uint_> bucket_offsets(buckets + 1, context);
+
+    meta_kernel scatter_kernel("sample_sort_on_cpu_scatter");
+    scatter_kernel.add_set_arg<const uint_>("count", uint_(count));
+    scatter_kernel.add_set_arg<const uint_>("chunk_size", uint_(chunk_size));
+    scatter_kernel.add_set_arg<const uint_>("chunks", uint_(chunks));
+    scatter_kernel.add_set_arg<const uint_>("buckets", uint_(buckets));
+    key_buckets_arg =
+        scatter_kernel.add_arg<const uint_ *>(memory_object::global_memory, "key_buckets");
+    counts_arg = scatter_kernel.add_arg<uint_ *>(memory_object::global_memory, "offsets");
+    size_t bucket_offsets_arg =
+        scatter_kernel.add_arg<uint_ *>(memory_object::global_memory, "bucket_offsets");
+    scatter_kernel <<
+        "const uint chunk = get_global_id(0);\n" <<
+        "const uint begin = chunk * chunk_size;\n" <<
+        "const uint end = min(begin + chunk_size, count);\n" <<
+        "if(chunk == 0){\n" <<
+        "    for(uint b = 0; b < buckets; b++){\n" <<
+        "        bucket_offsets[b] = offsets[b * chunks];\n" <<
+        "    }\n" <<
+        "    bucket_offsets[buckets] = count;\n" <<
+        "}\n" <<
+        "for(uint i = begin; i < end; i++){\n" <<
+        "    const uint counter = key_buckets[i] * chunks + chunk;\n" <<
+        "    const uint o = offsets[counter];\n" <<
+        "    offsets[counter] = o + 1;\n";
+    sample_sort_emit_move(
+        scatter_kernel, keys_first, values_first, "i",
+        keys_temp.begin(), values_temp.begin(), "o", sort_by_key
+    );
+    scatter_kernel <<
+        "}\n";
+    kernel = scatter_kernel.compile(context);
+    kernel.set_arg(key_buckets_arg, key_buckets.get_buffer());
+    kernel.set_arg(counts_arg, bucket_counts.get_buffer());
+    kernel.set_arg(bucket_offsets_arg, bucket_offsets.get_buffer());
+    queue.enqueue_1d_range_kernel(kernel, 0, chunks, 0);
+
+    // 4. sort each bucket
+    sample_sort_buckets(
+        keys_temp.begin(), values_temp.begin(), keys_first, values_first,
+        bucket_offsets, compare, run_size, sort_by_key, queue
+    );
+}
+
+} // end detail namespace
+} // end compute namespace
+} // end boost namespace
+
+#endif // BOOST_COMPUTE_ALGORITHM_DETAIL_SAMPLE_SORT_ON_CPU_HPP
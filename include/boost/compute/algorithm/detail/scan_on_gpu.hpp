@@ -17,6 +17,7 @@
 #include <boost/compute/container/vector.hpp>
 #include <boost/compute/detail/iterator_range_size.hpp>
 #include <boost/compute/memory/local_buffer.hpp>
+#include <boost/compute/memory/svm_ptr.hpp>
 #include <boost/compute/iterator/buffer_iterator.hpp>
 
 namespace boost {
@@ -141,6 +142,7 @@ public:
         m_output_arg = add_arg<T *>(memory_object::global_memory, "output");
         m_block_sums_arg = add_arg<const T *>(memory_object::global_memory, "block_sums");
         m_count_arg = add_arg<const cl_uint>("count");
+        m_offset_arg = add_arg<const cl_uint>("offset");
 
         // work-item parameters
         *this <<
@@ -154,8 +156,8 @@ public:
 
         // write output
         *this <<
-            "output[gid] = " <<
-                op(var<T>("block_sums[block_id]"), var<T>("output[gid] ")) << ";\n";
+            "output[offset + gid] = " <<
+                op(var<T>("block_sums[block_id]"), var<T>("output[offset + gid] ")) << ";\n";
 
         if(checked){
             *this << "}\n";
@@ -165,8 +167,31 @@ public:
     size_t m_output_arg;
     size_t m_block_sums_arg;
     size_t m_count_arg;
+    size_t m_offset_arg;
 };
 
+// binds the scan output to the write_scanned_output kernel
+template<class T, class BinaryOperator, class OutputType>
+inline void set_scanned_output_args(kernel &kernel,
+                                    const write_scanned_output_kernel<T, BinaryOperator> &k,
+                                    const buffer_iterator<OutputType> &result)
+{
+    kernel.set_arg(k.m_output_arg, result.get_buffer());
+    kernel.set_arg(k.m_offset_arg, static_cast<cl_uint>(result.get_index()));
+}
+
+// svm pointers require OpenCL 2.0
+#if defined(BOOST_COMPUTE_CL_VERSION_2_0) || defined(BOOST_COMPUTE_DOXYGEN_INVOKED)
+template<class T, class BinaryOperator, class OutputType>
+inline void set_scanned_output_args(kernel &kernel,
+                                    const write_scanned_output_kernel<T, BinaryOperator> &k,
+                                    const svm_ptr<OutputType> &result)
+{
+    kernel.set_arg_svm_ptr(k.m_output_arg, result.get());
+    kernel.set_arg(k.m_offset_arg, static_cast<cl_uint>(0));
+}
+#endif
+
 template<class InputIterator>
 inline size_t pick_scan_block_size(InputIterator first, InputIterator last)
 {
@@ -253,7 +278,7 @@ inline OutputIterator scan_impl(InputIterator first,
         write_scanned_output_kernel<input_type, BinaryOperator>
             write_output_kernel(op);
         kernel = write_output_kernel.compile(context);
-        kernel.set_arg(write_output_kernel.m_output_arg, result.get_buffer());
+        set_scanned_output_args(kernel, write_output_kernel, result);
         kernel.set_arg(write_output_kernel.m_block_sums_arg, block_sums);
         kernel.set_arg(write_output_kernel.m_count_arg, static_cast<cl_uint>(count));
 
@@ -0,0 +1,269 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://boostorg.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#ifndef BOOST_COMPUTE_ALGORITHM_DETAIL_SEARCH_HORSPOOL_HPP
+#define BOOST_COMPUTE_ALGORITHM_DETAIL_SEARCH_HORSPOOL_HPP
+
+#include <iterator>
+#include <vector>
+
+#include <boost/type_traits/is_integral.hpp>
+
+#include <boost/compute/event.hpp>
+#include <boost/compute/kernel.hpp>
+#include <boost/compute/command_queue.hpp>
+#include <boost/compute/algorithm/copy.hpp>
+#include <boost/compute/algorithm/exclusive_scan.hpp>
+#include <boost/compute/algorithm/detail/search_all.hpp>
+#include <boost/compute/algorithm/detail/stream_compact.hpp>
+#include <boost/compute/container/vector.hpp>
+#include <boost/compute/container/detail/scalar.hpp>
+#include <boost/compute/detail/meta_kernel.hpp>
+#include <boost/compute/detail/iterator_range_size.hpp>
+#include <boost/compute/memory/local_buffer.hpp>
+
+namespace boost {
+namespace compute {
+namespace detail {
+
+// number of entries in the horspool skip table. values are hashed into
+// the table with their low eight bits, which for larger types gives each
+// entry the smallest shift of the values sharing it (and so never skips
+// a match).
+const uint_ horspool_table_size = 256;
+
+template<class T>
+inline uint_ horspool_hash(const T &value)
+{
+    return static_cast<uint_>(value) & (horspool_table_size - 1);
+}
+
+// builds the horspool bad character table for pattern
+template<class T>
+inline std::vector<uint_> horspool_skip_table(const std::vector<T> &pattern)
+{
+    const size_t m = pattern.size();
+
+    std::vector<uint_> table(horspool_table_size, static_cast<uint_>(m));
+    for(size_t i = 0; i + 1 < m; i++){
+        table[horspool_hash(pattern[i])] = static_cast<uint_>(m - 1 - i);
+    }
+
+    return table;
+}
+
+// returns true if the tiled horspool search can be used for the pattern
+// of m values (the text tile, the pattern and the skip table must fit in
+// local memory)
+template<class T>
+inline bool can_search_with_horspool(size_t m,
+                                     size_t work_group_size,
+                                     const device &device)
+{
+    const size_t tile_size = work_group_size * stream_compact_block_size + m - 1;
+    const size_t local_memory =
+        (tile_size + m) * sizeof(T) + horspool_table_size * sizeof(uint_);
+
+    return boost::is_integral<T>::value &&
+           local_memory <= device.local_memory_size();
+}
+
+// writes the positions of the matches of [p_first, p_last) in
+// [t_first, t_last) to the output range beginning at result, in order, and
+// stores their number in match_count.
+//
+// each work-group loads a tile of the text (plus the m - 1 values after
+// it) and the pattern into local memory. each work-item then checks the
+// positions of a block of 32 in its tile, comparing the pattern from its
+// end and skipping ahead with the horspool table, and writes the matches
+// as a bit mask. the masks are compacted to positions as by
+// stream_compact().
+template<class TextIterator, class PatternIterator, class OutputIterator>
+inline event search_positions_with_horspool(TextIterator t_first,
+                                            TextIterator t_last,
+                                            PatternIterator p_first,
+                                            PatternIterator p_last,
+                                            OutputIterator result,
+                                            scalar<uint_> &match_count,
+                                            size_t work_group_size,
+                                            command_queue &queue)
+{
+    typedef typename std::iterator_traits<TextIterator>::value_type T;
+
+    const context &context = queue.get_context();
+
+    const size_t n = iterator_range_size(t_first, t_last);
+    const size_t m = iterator_range_size(p_first, p_last);
+    const size_t positions = n - m + 1;
+    const size_t block_size = stream_compact_block_size;
+    const size_t blocks = (positions + block_size - 1) / block_size;
+    const size_t work_groups = (blocks + work_group_size - 1) / work_group_size;
+
+    // build the skip table on the host
+    std::vector<T> host_pattern(m);
+    ::boost::compute::copy(p_first, p_last, host_pattern.begin(), queue);
+    std::vector<uint_> host_table = horspool_skip_table(host_pattern);
+    vector<uint_> table(host_table.begin(), host_table.end(), queue);
+
+    vector<uint_> masks(blocks, context);
+    vector<uint_> offsets(blocks + 1, context);
+
+    meta_kernel k("search_horspool");
+    k.add_set_arg<const uint_>("positions", uint_(positions));
+    k.add_set_arg<const uint_>("m", uint_(m));
+    k.add_set_arg<const uint_>("blocks", uint_(blocks));
+    size_t table_arg = k.add_arg<const uint_ *>(memory_object::global_memory, "table");
+    size_t masks_arg = k.add_arg<uint_ *>(memory_object::global_memory, "masks");
+    size_t offsets_arg = k.add_arg<uint_ *>(memory_object::global_memory, "offsets");
+    size_t tile_arg = k.add_arg<T *>(memory_object::local_memory, "tile");
+    size_t pattern_arg = k.add_arg<T *>(memory_object::local_memory, "pattern");
+    size_t local_table_arg = k.add_arg<uint_ *>(memory_object::local_memory, "ltable");
+
+    k <<
+        "const uint lid = get_local_id(0);\n" <<
+        "const uint lsize = get_local_size(0);\n" <<
+        "const uint block = get_global_id(0);\n" <<
+        "const uint tile_begin = get_group_id(0) * lsize * " << block_size << ";\n" <<
+        "const uint tile_positions = min(lsize * " << block_size << ", positions - tile_begin);\n" <<
+        "const uint tile_size = tile_positions + m - 1;\n" <<
+
+        // load the text tile, the pattern and the table
+        "for(uint i = lid; i < tile_size; i += lsize){\n" <<
+        "    tile[i] = " << t_first[k.var<uint_>("tile_begin + i")] << ";\n" <<
+        "}\n" <<
+        "for(uint i = lid; i < m; i += lsize){\n" <<
+        "    pattern[i] = " << p_first[k.var<uint_>("i")] << ";\n" <<
+        "}\n" <<
+        "for(uint i = lid; i < " << horspool_table_size << "; i += lsize){\n" <<
+        "    ltable[i] = table[i];\n" <<
+        "}\n" <<
+        "barrier(CLK_LOCAL_MEM_FENCE);\n" <<
+
+        // check the positions of the work-item's block
+        "if(block < blocks){\n" <<
+        "    const uint begin = lid * " << block_size << ";\n" <<
+        "    const uint end = min(begin + " << block_size << ", tile_positions);\n" <<
+        "    uint mask = 0;\n" <<
+        "    uint matches = 0;\n" <<
+        "    uint pos = begin;\n" <<
+        "    while(pos < end){\n" <<
+        "        int j = (int) m - 1;\n" <<
+        "        while(j >= 0 && tile[pos + j] == pattern[j]){\n" <<
+        "            j--;\n" <<
+        "        }\n" <<
+        "        if(j < 0){\n" <<
+        "            mask |= 1u << (pos - begin);\n" <<
+        "            matches++;\n" <<
+        "        }\n" <<
+        "        pos += ltable[((uint) tile[pos + m - 1]) & " <<
+                     (horspool_table_size - 1) << "];\n" <<
+        "    }\n" <<
+        "    masks[block] = mask;\n" <<
+        "    offsets[block] = matches;\n" <<
+        "    if(block == blocks - 1){\n" <<
+        "        offsets[blocks] = 0;\n" <<
+        "    }\n" <<
+        "}\n";
+
+    const size_t tile_size = work_group_size * block_size + m - 1;
+
+    kernel kernel = k.compile(context);
+    kernel.set_arg(table_arg, table.get_buffer());
+    kernel.set_arg(masks_arg, masks.get_buffer());
+    kernel.set_arg(offsets_arg, offsets.get_buffer());
+    kernel.set_arg(tile_arg, local_buffer<T>(tile_size));
+    kernel.set_arg(pattern_arg, local_buffer<T>(m));
+    kernel.set_arg(local_table_arg, local_buffer<uint_>(horspool_table_size));
+
+    queue.enqueue_1d_range_kernel(
+        kernel, 0, work_groups * work_group_size, work_group_size
+    );
+
+    ::boost::compute::exclusive_scan(
+        offsets.begin(), offsets.end(), offsets.begin(), queue
+    );
+
+    return stream_compact_scatter(
+        masks, offsets, result, compact_index_value(), match_count, queue
+    );
+}
+
+// flag function for stream_compact() which keeps the positions flagged
+// by search_kernel
+template<class Iterator>
+struct search_match_flag
+{
+    explicit search_match_flag(Iterator flags)
+        : m_flags(flags)
+    {
+    }
+
+    void operator()(meta_kernel &k, const std::string &index) const
+    {
+        k << m_flags[k.var<uint_>(index)] << " == 1";
+    }
+
+    Iterator m_flags;
+};
+
+// writes the positions of the matches of [p_first, p_last) in
+// [t_first, t_last) to the output range beginning at result, in order, and
+// stores their number in match_count. the pattern must not be empty or
+// longer than the text.
+//
+// integral values are searched with the tiled horspool search, other
+// values (or patterns too long for local memory) are compared at every
+// position by search_kernel.
+template<class TextIterator, class PatternIterator, class OutputIterator>
+inline event search_positions(TextIterator t_first,
+                              TextIterator t_last,
+                              PatternIterator p_first,
+                              PatternIterator p_last,
+                              OutputIterator result,
+                              scalar<uint_> &match_count,
+                              command_queue &queue)
+{
+    typedef typename std::iterator_traits<TextIterator>::value_type T;
+
+    const device &device = queue.get_device();
+    const size_t n = iterator_range_size(t_first, t_last);
+    const size_t m = iterator_range_size(p_first, p_last);
+
+    const size_t work_group_size =
+        (std::min)(size_t(64), device.max_work_group_size());
+
+    if(can_search_with_horspool<T>(m, work_group_size, device)){
+        return search_positions_with_horspool(
+            t_first, t_last, p_first, p_last, result, match_count,
+            work_group_size, queue
+        );
+    }
+
+    vector<uint_> flags(n - m + 1, queue.get_context());
+
+    search_kernel<PatternIterator, TextIterator, vector<uint_>::iterator> kernel;
+    kernel.set_range(p_first, p_last, t_first, t_last, flags.begin());
+    kernel.exec(queue);
+
+    return stream_compact(
+        flags.size(),
+        result,
+        search_match_flag<vector<uint_>::iterator>(flags.begin()),
+        compact_index_value(),
+        match_count,
+        queue
+    );
+}
+
+} // end detail namespace
+} // end compute namespace
+} // end boost namespace
+
+#endif // BOOST_COMPUTE_ALGORITHM_DETAIL_SEARCH_HORSPOOL_HPP
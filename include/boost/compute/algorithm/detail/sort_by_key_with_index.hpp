@@ -0,0 +1,110 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://boostorg.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#ifndef BOOST_COMPUTE_ALGORITHM_DETAIL_SORT_BY_KEY_WITH_INDEX_HPP
+#define BOOST_COMPUTE_ALGORITHM_DETAIL_SORT_BY_KEY_WITH_INDEX_HPP
+
+#include <iterator>
+#include <string>
+
+#include <boost/shared_ptr.hpp>
+
+#include <boost/compute/command_queue.hpp>
+#include <boost/compute/algorithm/copy.hpp>
+#include <boost/compute/algorithm/gather.hpp>
+#include <boost/compute/container/vector.hpp>
+#include <boost/compute/detail/iterator_range_size.hpp>
+#include <boost/compute/detail/parameter_cache.hpp>
+#include <boost/compute/iterator/counting_iterator.hpp>
+#include <boost/compute/type_traits/type_name.hpp>
+#include <boost/compute/types/fundamental.hpp>
+
+namespace boost {
+namespace compute {
+namespace detail {
+
+// Returns true if the values of a sort by key are wide enough that it is
+// cheaper to sort the keys with their uint_ indices and gather the values
+// once at the end than to move the values through every pass of the sort.
+//
+// The values are sorted with their indices if they are larger than the
+// "index_payload_size_threshold" parameter (in bytes, default 16).
+template<class KeyIterator, class ValueIterator>
+inline bool use_sort_by_key_with_index(KeyIterator keys_first,
+                                       KeyIterator keys_last,
+                                       ValueIterator values_first,
+                                       command_queue &queue)
+{
+    typedef typename std::iterator_traits<KeyIterator>::value_type key_type;
+    typedef typename std::iterator_traits<ValueIterator>::value_type value_type;
+
+    (void) values_first;
+
+    // the indices are never narrower than the values
+    if(sizeof(value_type) <= sizeof(uint_)){
+        return false;
+    }
+
+    // small inputs are sorted with a single insertion sort
+    const size_t count = iterator_range_size(keys_first, keys_last);
+    if(count < 32){
+        return false;
+    }
+
+    std::string cache_key =
+        std::string("__boost_sort_by_key_") + type_name<key_type>();
+    boost::shared_ptr<parameter_cache> parameters =
+        parameter_cache::get_global_cache(queue.get_device());
+
+    const size_t index_payload_size_threshold =
+        parameters->get(cache_key, "index_payload_size_threshold", 16);
+
+    return sizeof(value_type) > index_payload_size_threshold;
+}
+
+// Fills indices with 0, 1, ..., count - 1.
+inline void make_sort_by_key_indices(vector<uint_> &indices,
+                                     command_queue &queue)
+{
+    ::boost::compute::copy(
+        counting_iterator<uint_>(0),
+        counting_iterator<uint_>(static_cast<uint_>(indices.size())),
+        indices.begin(),
+        queue
+    );
+}
+
+// Reorders the values in the range [values_first, values_first +
+// indices.size()) so that the value at i is the value which was at
+// indices[i]. The values are copied once to a temporary vector and then
+// gathered back in their sorted order.
+template<class ValueIterator>
+inline void gather_sorted_values(const vector<uint_> &indices,
+                                 ValueIterator values_first,
+                                 command_queue &queue)
+{
+    typedef typename std::iterator_traits<ValueIterator>::value_type value_type;
+
+    const size_t count = indices.size();
+
+    vector<value_type> values(count, queue.get_context());
+    ::boost::compute::copy(
+        values_first, values_first + count, values.begin(), queue
+    );
+    ::boost::compute::gather(
+        indices.begin(), indices.end(), values.begin(), values_first, queue
+    );
+}
+
+} // end detail namespace
+} // end compute namespace
+} // end boost namespace
+
+#endif // BOOST_COMPUTE_ALGORITHM_DETAIL_SORT_BY_KEY_WITH_INDEX_HPP
@@ -0,0 +1,347 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://boostorg.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#ifndef BOOST_COMPUTE_ALGORITHM_DETAIL_STREAM_COMPACT_HPP
+#define BOOST_COMPUTE_ALGORITHM_DETAIL_STREAM_COMPACT_HPP
+
+#include <iterator>
+#include <string>
+
+#include <boost/shared_ptr.hpp>
+
+#include <boost/compute/event.hpp>
+#include <boost/compute/kernel.hpp>
+#include <boost/compute/command_queue.hpp>
+#include <boost/compute/algorithm/exclusive_scan.hpp>
+#include <boost/compute/async/future.hpp>
+#include <boost/compute/container/vector.hpp>
+#include <boost/compute/container/detail/scalar.hpp>
+#include <boost/compute/detail/meta_kernel.hpp>
+
+namespace boost {
+namespace compute {
+namespace detail {
+
+// flag function for stream_compact() which keeps the values in
+// [first, first + count) for which predicate returns true
+template<class InputIterator, class Predicate>
+struct compact_if_flag
+{
+    compact_if_flag(InputIterator first, Predicate predicate)
+        : m_first(first),
+          m_predicate(predicate)
+    {
+    }
+
+    void operator()(meta_kernel &k, const std::string &index) const
+    {
+        k << m_predicate(m_first[k.var<uint_>(index)]);
+    }
+
+    InputIterator m_first;
+    Predicate m_predicate;
+};
+
+// value function for stream_compact() which writes function(first[i])
+template<class InputIterator, class UnaryFunction>
+struct compact_transform_value
+{
+    compact_transform_value(InputIterator first, UnaryFunction function)
+        : m_first(first),
+          m_function(function)
+    {
+    }
+
+    void operator()(meta_kernel &k, const std::string &index) const
+    {
+        k << m_function(m_first[k.var<uint_>(index)]);
+    }
+
+    InputIterator m_first;
+    UnaryFunction m_function;
+};
+
+// value function for stream_compact() which writes the index of the value
+struct compact_index_value
+{
+    void operator()(meta_kernel &k, const std::string &index) const
+    {
+        k << index;
+    }
+};
+
+// number of values handled by each work-item of stream_compact() and
+// stream_partition(), the flags of a work-item are stored as the bits of
+// a uint
+const uint_ stream_compact_block_size = 32;
+
+// evaluates flag(i) for each i in [0, count) once and writes the flags of
+// each block of stream_compact_block_size values as a bit mask to masks.
+// offsets is set to the exclusive scan of the number of flags set in each
+// block, its last element holds the total number of flags set. masks must
+// have a value for each block and offsets one more.
+template<class FlagFunction>
+inline void stream_compact_flags(size_t count,
+                                 FlagFunction flag,
+                                 vector<uint_> &masks,
+                                 vector<uint_> &offsets,
+                                 command_queue &queue)
+{
+    const uint_ block_size = stream_compact_block_size;
+    const size_t blocks = masks.size();
+
+    meta_kernel k("stream_compact_flags");
+    k.add_set_arg<const uint_>("count", uint_(count));
+    k.add_set_arg<const uint_>("blocks", uint_(blocks));
+    size_t masks_arg = k.add_arg<uint_ *>(memory_object::global_memory, "masks");
+    size_t offsets_arg = k.add_arg<uint_ *>(memory_object::global_memory, "offsets");
+    k <<
+        "const uint block = get_global_id(0);\n" <<
+        "const uint begin = block * " << block_size << ";\n" <<
+        "const uint end = min(begin + " << block_size << ", count);\n" <<
+        "uint mask = 0;\n" <<
+        "uint flags = 0;\n" <<
+        "for(uint i = begin; i < end; i++){\n" <<
+        "    if(";
+    flag(k, "i");
+    k <<
+        "){\n" <<
+        "        mask |= 1u << (i - begin);\n" <<
+        "        flags++;\n" <<
+        "    }\n" <<
+        "}\n" <<
+        "masks[block] = mask;\n" <<
+        "offsets[block] = flags;\n" <<
+        "if(block == blocks - 1){\n" <<
+        "    offsets[blocks] = 0;\n" <<
+        "}\n";
+
+    kernel kernel = k.compile(queue.get_context());
+    kernel.set_arg(masks_arg, masks.get_buffer());
+    kernel.set_arg(offsets_arg, offsets.get_buffer());
+    queue.enqueue_1d_range_kernel(kernel, 0, blocks, 0);
+
+    ::boost::compute::exclusive_scan(
+        offsets.begin(), offsets.end(), offsets.begin(), queue
+    );
+}
+
+// writes value(i) to the output range beginning at result for each i in
+// [0, count) whose bit is set in masks, in order. offsets holds the
+// exclusive scan of the number of bits set in each mask (as written by
+// stream_compact_flags()). the total number of values written is stored
+// in compacted_count.
+template<class OutputIterator, class ValueFunction>
+inline event stream_compact_scatter(vector<uint_> &masks,
+                                    vector<uint_> &offsets,
+                                    OutputIterator result,
+                                    ValueFunction value,
+                                    scalar<uint_> &compacted_count,
+                                    command_queue &queue)
+{
+    const uint_ block_size = stream_compact_block_size;
+    const size_t blocks = masks.size();
+
+    meta_kernel k("stream_compact_scatter");
+    k.add_set_arg<const uint_>("blocks", uint_(blocks));
+    size_t masks_arg = k.add_arg<const uint_ *>(memory_object::global_memory, "masks");
+    size_t offsets_arg = k.add_arg<const uint_ *>(memory_object::global_memory, "offsets");
+    size_t count_arg = k.add_arg<uint_ *>(memory_object::global_memory, "compacted_count");
+    k <<
+        "const uint block = get_global_id(0);\n" <<
+        "uint mask = masks[block];\n" <<
+        "uint out = offsets[block];\n" <<
+        "for(uint i = block * " << block_size << "; mask != 0; i++, mask >>= 1){\n" <<
+        "    if(mask & 1){\n" <<
+        "        " << result[k.var<uint_>("out")] << " = ";
+    value(k, "i");
+    k <<
+        ";\n" <<
+        "        out++;\n" <<
+        "    }\n" <<
+        "}\n" <<
+        "if(block == 0){\n" <<
+        "    *compacted_count = offsets[blocks];\n" <<
+        "}\n";
+
+    kernel kernel = k.compile(queue.get_context());
+    kernel.set_arg(masks_arg, masks.get_buffer());
+    kernel.set_arg(offsets_arg, offsets.get_buffer());
+    kernel.set_arg(count_arg, compacted_count.get_buffer());
+    return queue.enqueue_1d_range_kernel(kernel, 0, blocks, 0);
+}
+
+// writes value(i) to the output range beginning at result for each i in
+// [0, count) for which flag(i) is true, in order. flag and value are
+// function objects which emit the expression for index i with
+// operator()(meta_kernel &k, const std::string &i). the number of values
+// written is stored in compacted_count on the device and the event of the
+// last command is returned, so the count is only read back if the caller
+// needs it on the host.
+//
+// 1. each work-item evaluates the flags of a block of 32 values (each
+//    flag is evaluated once) and writes them as a bit mask along with
+//    the number of set bits.
+// 2. the block counts (count / 32 values) are scanned to get the output
+//    offset of each block, the last element holds the total count.
+// 3. each work-item writes the values whose bits are set in its mask
+//    starting at the offset of its block.
+template<class OutputIterator, class FlagFunction, class ValueFunction>
+inline event stream_compact(size_t count,
+                            OutputIterator result,
+                            FlagFunction flag,
+                            ValueFunction value,
+                            scalar<uint_> &compacted_count,
+                            command_queue &queue)
+{
+    const context &context = queue.get_context();
+
+    if(count == 0){
+        return compacted_count.write(uint_(0), queue);
+    }
+
+    const uint_ block_size = stream_compact_block_size;
+    const size_t blocks = (count + block_size - 1) / block_size;
+
+    vector<uint_> masks(blocks, context);
+    vector<uint_> offsets(blocks + 1, context);
+    stream_compact_flags(count, flag, masks, offsets, queue);
+
+    return stream_compact_scatter(
+        masks, offsets, result, value, compacted_count, queue
+    );
+}
+
+// end of the output range of stream_compact() computed on the host from
+// the count read back by make_compacted_future()
+template<class OutputIterator>
+struct compacted_end
+{
+    typedef typename
+        std::iterator_traits<OutputIterator>::difference_type difference_type;
+
+    compacted_end(OutputIterator result, const boost::shared_ptr<uint_> &count)
+        : m_result(result),
+          m_count(count)
+    {
+    }
+
+    OutputIterator operator()() const
+    {
+        return m_result + static_cast<difference_type>(*m_count);
+    }
+
+    OutputIterator m_result;
+    boost::shared_ptr<uint_> m_count;
+};
+
+// enqueues a non-blocking read of compacted_count after the compacted
+// event and returns a future for the end of the output range beginning at
+// result. the count is owned by the future so the caller does not block.
+template<class OutputIterator>
+inline future<OutputIterator>
+make_compacted_future(OutputIterator result,
+                      const scalar<uint_> &compacted_count,
+                      const event &compacted,
+                      command_queue &queue)
+{
+    boost::shared_ptr<uint_> count(new uint_(0));
+    event read = compacted_count.read_async(
+        count.get(), queue, wait_list(compacted)
+    );
+
+    return future<OutputIterator>(
+        read, compacted_end<OutputIterator>(result, count)
+    );
+}
+
+// writes value(i) for each i in [0, count) to the range beginning at
+// first_true if flag(i) is true and to the range beginning at first_false
+// otherwise, preserving the order of the values in both ranges. the
+// flags are evaluated and scanned as by stream_compact(), the position of
+// a false value is its index minus the number of true values before it.
+// both outputs are written by the same kernel.
+//
+// if false_after_true is true the false values are written after the
+// true values (i.e. to first_false + the number of true values), which
+// partitions the values into a single range when first_false is
+// first_true. the number of true values is stored in true_count on the
+// device.
+template<class OutputIterator1,
+         class OutputIterator2,
+         class FlagFunction,
+         class ValueFunction>
+inline event stream_partition(size_t count,
+                              OutputIterator1 first_true,
+                              OutputIterator2 first_false,
+                              FlagFunction flag,
+                              ValueFunction value,
+                              bool false_after_true,
+                              scalar<uint_> &true_count,
+                              command_queue &queue)
+{
+    const context &context = queue.get_context();
+
+    if(count == 0){
+        return true_count.write(uint_(0), queue);
+    }
+
+    const uint_ block_size = stream_compact_block_size;
+    const size_t blocks = (count + block_size - 1) / block_size;
+
+    vector<uint_> masks(blocks, context);
+    vector<uint_> offsets(blocks + 1, context);
+    stream_compact_flags(count, flag, masks, offsets, queue);
+
+    meta_kernel k("stream_partition_scatter");
+    k.add_set_arg<const uint_>("count", uint_(count));
+    k.add_set_arg<const uint_>("blocks", uint_(blocks));
+    size_t masks_arg = k.add_arg<const uint_ *>(memory_object::global_memory, "masks");
+    size_t offsets_arg = k.add_arg<const uint_ *>(memory_object::global_memory, "offsets");
+    size_t count_arg = k.add_arg<uint_ *>(memory_object::global_memory, "true_count");
+    k <<
+        "const uint block = get_global_id(0);\n" <<
+        "const uint begin = block * " << block_size << ";\n" <<
+        "const uint end = min(begin + " << block_size << ", count);\n" <<
+        "uint mask = masks[block];\n" <<
+        "uint t = offsets[block];\n" <<
+        "uint f = begin - t" << (false_after_true ? " + offsets[blocks]" : "") << ";\n" <<
+        "for(uint i = begin; i < end; i++, mask >>= 1){\n" <<
+        "    if(mask & 1){\n" <<
+        "        " << first_true[k.var<uint_>("t")] << " = ";
+    value(k, "i");
+    k <<
+        ";\n" <<
+        "        t++;\n" <<
+        "    }\n" <<
+        "    else {\n" <<
+        "        " << first_false[k.var<uint_>("f")] << " = ";
+    value(k, "i");
+    k <<
+        ";\n" <<
+        "        f++;\n" <<
+        "    }\n" <<
+        "}\n" <<
+        "if(block == 0){\n" <<
+        "    *true_count = offsets[blocks];\n" <<
+        "}\n";
+
+    kernel kernel = k.compile(context);
+    kernel.set_arg(masks_arg, masks.get_buffer());
+    kernel.set_arg(offsets_arg, offsets.get_buffer());
+    kernel.set_arg(count_arg, true_count.get_buffer());
+    return queue.enqueue_1d_range_kernel(kernel, 0, blocks, 0);
+}
+
+} // end detail namespace
+} // end compute namespace
+} // end boost namespace
+
+#endif // BOOST_COMPUTE_ALGORITHM_DETAIL_STREAM_COMPACT_HPP
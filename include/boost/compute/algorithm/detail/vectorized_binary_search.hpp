@@ -0,0 +1,321 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://boostorg.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#ifndef BOOST_COMPUTE_ALGORITHM_DETAIL_VECTORIZED_BINARY_SEARCH_HPP
+#define BOOST_COMPUTE_ALGORITHM_DETAIL_VECTORIZED_BINARY_SEARCH_HPP
+
+#include <cmath>
+#include <iterator>
+
+#include <boost/compute/command_queue.hpp>
+#include <boost/compute/algorithm/copy.hpp>
+#include <boost/compute/algorithm/iota.hpp>
+#include <boost/compute/algorithm/scatter.hpp>
+#include <boost/compute/algorithm/sort_by_key.hpp>
+#include <boost/compute/container/vector.hpp>
+#include <boost/compute/detail/meta_kernel.hpp>
+#include <boost/compute/detail/iterator_range_size.hpp>
+#include <boost/compute/detail/parameter_cache.hpp>
+#include <boost/compute/functional/operator.hpp>
+
+namespace boost {
+namespace compute {
+namespace detail {
+
+// what is written for each needle by the vectorized searches
+enum vectorized_search_kind {
+    vectorized_lower_bound,   // index of the first element not less than needle
+    vectorized_upper_bound,   // index of the first element greater than needle
+    vectorized_binary_search, // 1 if needle is in the range, 0 otherwise
+    vectorized_equal_range    // both lower and upper bound
+};
+
+// Searches for every needle in [needles, needles + m) with a binary search
+// in [first, first + n) using one work-item per needle.
+//
+// Space complexity: O(1)
+template<class InputIterator, class NeedleIterator,
+         class OutputIterator1, class OutputIterator2>
+inline void vectorized_binary_search_kernel(InputIterator first,
+                                            size_t n,
+                                            NeedleIterator needles,
+                                            size_t m,
+                                            vectorized_search_kind kind,
+                                            OutputIterator1 result1,
+                                            OutputIterator2 result2,
+                                            command_queue &queue)
+{
+    typedef typename std::iterator_traits<NeedleIterator>::value_type T;
+
+    ::boost::compute::less<T> less_than;
+
+    meta_kernel k("vectorized_binary_search");
+    size_t n_arg = k.add_arg<const uint_>("n");
+
+    k <<
+        "const uint gid = get_global_id(0);\n" <<
+        k.decl<const T>("needle") << " = " << needles[k.var<uint_>("gid")] << ";\n" <<
+        "uint lo = 0;\n" <<
+        "uint hi = n;\n" <<
+        "while(lo < hi){\n" <<
+        "    const uint mid = (lo + hi) / 2;\n";
+    if(kind == vectorized_upper_bound){
+        k <<
+        "    if(!(" << less_than(k.var<const T>("needle"),
+                                 first[k.var<uint_>("mid")]) << "))\n";
+    }
+    else {
+        k <<
+        "    if(" << less_than(first[k.var<uint_>("mid")],
+                               k.var<const T>("needle")) << ")\n";
+    }
+    k <<
+        "        lo = mid + 1;\n" <<
+        "    else\n" <<
+        "        hi = mid;\n" <<
+        "}\n";
+
+    if(kind == vectorized_binary_search){
+        k << result1[k.var<uint_>("gid")] << " = lo < n && !(" <<
+                 less_than(k.var<const T>("needle"),
+                           first[k.var<uint_>("lo")]) << ");\n";
+    }
+    else {
+        k << result1[k.var<uint_>("gid")] << " = lo;\n";
+    }
+
+    if(kind == vectorized_equal_range){
+        // the upper bound is not before the lower bound
+        k <<
+            "hi = n;\n" <<
+            "while(lo < hi){\n" <<
+            "    const uint mid = (lo + hi) / 2;\n" <<
+            "    if(!(" << less_than(k.var<const T>("needle"),
+                                     first[k.var<uint_>("mid")]) << "))\n" <<
+            "        lo = mid + 1;\n" <<
+            "    else\n" <<
+            "        hi = mid;\n" <<
+            "}\n" <<
+            result2[k.var<uint_>("gid")] << " = lo;\n";
+    }
+
+    kernel kernel = k.compile(queue.get_context());
+    kernel.set_arg(n_arg, static_cast<uint_>(n));
+
+    queue.enqueue_1d_range_kernel(kernel, 0, m, 0);
+}
+
+// Searches for the sorted needles in [needles, needles + m) by walking the
+// merge path of the two sorted ranges. Each work-item finds its starting
+// point on the path with a binary search along its diagonal and then
+// merges values_per_thread steps serially. This needs O(n + m) work in
+// total instead of O(m log n) and is used when there are many needles.
+//
+// Space complexity: O(1)
+template<class InputIterator, class NeedleIterator, class OutputIterator>
+inline void vectorized_merge_path_search_kernel(InputIterator first,
+                                                size_t n,
+                                                NeedleIterator needles,
+                                                size_t m,
+                                                vectorized_search_kind kind,
+                                                OutputIterator result,
+                                                uint_ values_per_thread,
+                                                command_queue &queue)
+{
+    typedef typename std::iterator_traits<NeedleIterator>::value_type T;
+
+    ::boost::compute::less<T> less_than;
+
+    // for the upper bound, equal values in [first, last) are taken before
+    // the needle
+    const bool take_equal = kind == vectorized_upper_bound;
+
+    meta_kernel k("vectorized_merge_path_search");
+    size_t n_arg = k.add_arg<const uint_>("n");
+    size_t m_arg = k.add_arg<const uint_>("m");
+    size_t vpt_arg = k.add_arg<const uint_>("vpt");
+
+    k <<
+        "const uint total = n + m;\n" <<
+        "const uint diag = min(get_global_id(0) * vpt, total);\n" <<
+        "const uint diag_end = min(diag + vpt, total);\n" <<
+
+        // find the starting point on the merge path
+        "uint lo = diag > m ? diag - m : 0;\n" <<
+        "uint hi = min(diag, n);\n" <<
+        "while(lo < hi){\n" <<
+        "    const uint mid = (lo + hi) / 2;\n";
+    if(take_equal){
+        k <<
+        "    if(!(" << less_than(needles[k.expr<uint_>("diag - 1 - mid")],
+                                 first[k.var<uint_>("mid")]) << "))\n";
+    }
+    else {
+        k <<
+        "    if(" << less_than(first[k.var<uint_>("mid")],
+                               needles[k.expr<uint_>("diag - 1 - mid")]) << ")\n";
+    }
+    k <<
+        "        lo = mid + 1;\n" <<
+        "    else\n" <<
+        "        hi = mid;\n" <<
+        "}\n" <<
+
+        // walk the merge path
+        "uint i = lo;\n" <<
+        "uint j = diag - lo;\n" <<
+        "for(uint d = diag; d < diag_end; d++){\n" <<
+        "    bool take_needle = j < m;\n" <<
+        "    if(take_needle && i < n){\n";
+    if(take_equal){
+        k <<
+        "        take_needle = " << less_than(needles[k.var<uint_>("j")],
+                                              first[k.var<uint_>("i")]) << ";\n";
+    }
+    else {
+        k <<
+        "        take_needle = !(" << less_than(first[k.var<uint_>("i")],
+                                                needles[k.var<uint_>("j")]) << ");\n";
+    }
+    k <<
+        "    }\n" <<
+        "    if(take_needle){\n";
+    if(kind == vectorized_binary_search){
+        k <<
+        "        " << result[k.var<uint_>("j")] << " = i < n && !(" <<
+                 less_than(needles[k.var<uint_>("j")],
+                           first[k.var<uint_>("i")]) << ");\n";
+    }
+    else {
+        k <<
+        "        " << result[k.var<uint_>("j")] << " = i;\n";
+    }
+    k <<
+        "        j++;\n" <<
+        "    }\n" <<
+        "    else {\n" <<
+        "        i++;\n" <<
+        "    }\n" <<
+        "}\n";
+
+    size_t work_size = (n + m + values_per_thread - 1) / values_per_thread;
+
+    kernel kernel = k.compile(queue.get_context());
+    kernel.set_arg(n_arg, static_cast<uint_>(n));
+    kernel.set_arg(m_arg, static_cast<uint_>(m));
+    kernel.set_arg(vpt_arg, values_per_thread);
+
+    queue.enqueue_1d_range_kernel(kernel, 0, work_size, 0);
+}
+
+// Searches the sorted range [first, last) for every value in
+// [needles_first, needles_last). Large batches of needles are sorted first
+// (keeping track of their original positions) so that neighbouring
+// work-items follow similar search paths, or, when there are enough of
+// them, so that the searches can be done by walking the merge path. The
+// results are then scattered back to the original needle order.
+//
+// Space complexity: O(1) for small batches, O(m) otherwise
+template<class InputIterator, class NeedleIterator,
+         class OutputIterator1, class OutputIterator2>
+inline void vectorized_search(InputIterator first,
+                              InputIterator last,
+                              NeedleIterator needles_first,
+                              NeedleIterator needles_last,
+                              vectorized_search_kind kind,
+                              OutputIterator1 result1,
+                              OutputIterator2 result2,
+                              command_queue &queue)
+{
+    typedef typename std::iterator_traits<NeedleIterator>::value_type T;
+
+    const size_t n = iterator_range_size(first, last);
+    const size_t m = iterator_range_size(needles_first, needles_last);
+    if(m == 0){
+        return;
+    }
+
+    const device &device = queue.get_device();
+    const context &context = queue.get_context();
+
+    boost::shared_ptr<parameter_cache> parameters =
+        detail::parameter_cache::get_global_cache(device);
+
+    std::string cache_key =
+        std::string("__boost_vectorized_search_") + type_name<T>();
+    uint_ sort_threshold = parameters->get(cache_key, "sort_threshold", 65536);
+    uint_ vpt = parameters->get(cache_key, "vpt", 8);
+
+    if(m < sort_threshold || n == 0){
+        vectorized_binary_search_kernel(
+            first, n, needles_first, m, kind, result1, result2, queue
+        );
+        return;
+    }
+
+    // sort the needles and remember their original positions
+    vector<T> sorted_needles(needles_first, needles_last, queue);
+    vector<uint_> positions(m, context);
+    ::boost::compute::iota(positions.begin(), positions.end(), uint_(0), queue);
+    ::boost::compute::sort_by_key(
+        sorted_needles.begin(), sorted_needles.end(), positions.begin(), queue
+    );
+
+    vector<uint_> sorted_result1(m, context);
+
+    // walking the merge path touches every value once while the binary
+    // searches touch log(n) values for each needle
+    const double log_n = std::log(static_cast<double>(n) + 1.0) / std::log(2.0);
+    const bool use_merge_path =
+        kind != vectorized_equal_range &&
+        static_cast<double>(m) * log_n > static_cast<double>(n + m);
+
+    if(use_merge_path){
+        vectorized_merge_path_search_kernel(
+            first, n, sorted_needles.begin(), m, kind,
+            sorted_result1.begin(), vpt, queue
+        );
+        ::boost::compute::scatter(
+            sorted_result1.begin(), sorted_result1.end(),
+            positions.begin(), result1, queue
+        );
+    }
+    else if(kind == vectorized_equal_range){
+        vector<uint_> sorted_result2(m, context);
+        vectorized_binary_search_kernel(
+            first, n, sorted_needles.begin(), m, kind,
+            sorted_result1.begin(), sorted_result2.begin(), queue
+        );
+        ::boost::compute::scatter(
+            sorted_result1.begin(), sorted_result1.end(),
+            positions.begin(), result1, queue
+        );
+        ::boost::compute::scatter(
+            sorted_result2.begin(), sorted_result2.end(),
+            positions.begin(), result2, queue
+        );
+    }
+    else {
+        vectorized_binary_search_kernel(
+            first, n, sorted_needles.begin(), m, kind,
+            sorted_result1.begin(), sorted_result1.begin(), queue
+        );
+        ::boost::compute::scatter(
+            sorted_result1.begin(), sorted_result1.end(),
+            positions.begin(), result1, queue
+        );
+    }
+}
+
+} // end detail namespace
+} // end compute namespace
+} // end boost namespace
+
+#endif // BOOST_COMPUTE_ALGORITHM_DETAIL_VECTORIZED_BINARY_SEARCH_HPP
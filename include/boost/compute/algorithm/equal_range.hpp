@@ -17,6 +17,8 @@
 #include <boost/compute/command_queue.hpp>
 #include <boost/compute/algorithm/lower_bound.hpp>
 #include <boost/compute/algorithm/upper_bound.hpp>
+#include <boost/compute/algorithm/detail/vectorized_binary_search.hpp>
+#include <boost/compute/detail/iterator_range_size.hpp>
 
 namespace boost {
 namespace compute {
@@ -38,6 +40,35 @@ equal_range(InputIterator first,
            );
 }
 
+/// Searches the sorted range [\p first, \p last) for each value in the
+/// range [\p needles_first, \p needles_last) and stores the index of the
+/// first element not less than the value in \p lower_result and the index
+/// of the first element greater than the value in \p upper_result.
+///
+/// Both bounds are found by the same kernel.
+///
+/// Space complexity: \Omega(1) for small batches, \Omega(m) otherwise
+template<class InputIterator, class NeedleIterator,
+         class OutputIterator1, class OutputIterator2>
+inline std::pair<OutputIterator1, OutputIterator2>
+equal_range(InputIterator first,
+            InputIterator last,
+            NeedleIterator needles_first,
+            NeedleIterator needles_last,
+            OutputIterator1 lower_result,
+            OutputIterator2 upper_result,
+            command_queue &queue = system::default_queue())
+{
+    detail::vectorized_search(first, last, needles_first, needles_last,
+                              detail::vectorized_equal_range,
+                              lower_result, upper_result, queue);
+
+    const size_t count =
+        detail::iterator_range_size(needles_first, needles_last);
+
+    return std::make_pair(lower_result + count, upper_result + count);
+}
+
 } // end compute namespace
 } // end boost namespace
 
@@ -15,6 +15,7 @@
 #include <boost/compute/system.hpp>
 #include <boost/compute/command_queue.hpp>
 #include <boost/compute/algorithm/detail/scan.hpp>
+#include <boost/compute/detail/command_tracer.hpp>
 
 namespace boost {
 namespace compute {
@@ -58,6 +59,8 @@ exclusive_scan(InputIterator first,
                BinaryOperator binary_op,
                command_queue &queue = system::default_queue())
 {
+    detail::trace_scope trace("exclusive_scan");
+
     return detail::scan(first, last, result, true, init, binary_op, queue);
 }
 
@@ -70,6 +73,8 @@ exclusive_scan(InputIterator first,
                T init,
                command_queue &queue = system::default_queue())
 {
+    detail::trace_scope trace("exclusive_scan");
+
     typedef typename
         std::iterator_traits<OutputIterator>::value_type output_type;
 
@@ -86,6 +91,8 @@ exclusive_scan(InputIterator first,
                OutputIterator result,
                command_queue &queue = system::default_queue())
 {
+    detail::trace_scope trace("exclusive_scan");
+
     typedef typename
         std::iterator_traits<OutputIterator>::value_type output_type;
 
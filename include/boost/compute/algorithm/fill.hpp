@@ -25,6 +25,7 @@
 #include <boost/compute/async/future.hpp>
 #include <boost/compute/iterator/constant_iterator.hpp>
 #include <boost/compute/iterator/discard_iterator.hpp>
+#include <boost/compute/detail/command_tracer.hpp>
 #include <boost/compute/detail/is_buffer_iterator.hpp>
 #include <boost/compute/detail/iterator_range_size.hpp>
 
@@ -280,6 +281,8 @@ inline void fill(BufferIterator first,
                  const T &value,
                  command_queue &queue = system::default_queue())
 {
+    detail::trace_scope trace("fill");
+
     size_t count = detail::iterator_range_size(first, last);
     if(count == 0){
         return;
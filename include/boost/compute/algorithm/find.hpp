@@ -15,6 +15,7 @@
 #include <boost/compute/system.hpp>
 #include <boost/compute/command_queue.hpp>
 #include <boost/compute/algorithm/find_if.hpp>
+#include <boost/compute/algorithm/detail/host_backend.hpp>
 #include <boost/compute/type_traits/vector_size.hpp>
 
 namespace boost {
@@ -23,6 +24,9 @@ namespace compute {
 /// Returns an iterator pointing to the first element in the range
 /// [\p first, \p last) that equals \p value.
 ///
+/// If \c BOOST_COMPUTE_USE_HOST_BACKEND is defined, small ranges of
+/// fundamental values are mapped and searched on the host.
+///
 /// Space complexity: \Omega(1)
 template<class InputIterator, class T>
 inline InputIterator find(InputIterator first,
@@ -35,6 +39,11 @@ inline InputIterator find(InputIterator first,
     using ::boost::compute::_1;
     using ::boost::compute::lambda::all;
 
+    InputIterator result = last;
+    if(detail::find_on_host(first, last, value, result, queue)){
+        return result;
+    }
+
     if(vector_size<value_type>::value == 1){
         return ::boost::compute::find_if(
                    first,
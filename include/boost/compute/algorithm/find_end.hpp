@@ -11,71 +11,15 @@
 #ifndef BOOST_COMPUTE_ALGORITHM_FIND_END_HPP
 #define BOOST_COMPUTE_ALGORITHM_FIND_END_HPP
 
-#include <boost/compute/algorithm/copy.hpp>
-#include <boost/compute/algorithm/detail/search_all.hpp>
+#include <boost/compute/algorithm/detail/search_horspool.hpp>
 #include <boost/compute/container/detail/scalar.hpp>
 #include <boost/compute/container/vector.hpp>
 #include <boost/compute/detail/iterator_range_size.hpp>
-#include <boost/compute/detail/meta_kernel.hpp>
+#include <boost/compute/detail/read_write_single_value.hpp>
 #include <boost/compute/system.hpp>
 
 namespace boost {
 namespace compute {
-namespace detail {
-
-///
-/// \brief Helper function for find_end
-///
-/// Basically a copy of find_if which returns last occurrence
-/// instead of first occurrence
-///
-template<class InputIterator, class UnaryPredicate>
-inline InputIterator find_end_helper(InputIterator first,
-                                     InputIterator last,
-                                     UnaryPredicate predicate,
-                                     command_queue &queue)
-{
-    typedef typename std::iterator_traits<InputIterator>::value_type value_type;
-    typedef typename std::iterator_traits<InputIterator>::difference_type difference_type;
-
-    size_t count = detail::iterator_range_size(first, last);
-    if(count == 0){
-        return last;
-    }
-
-    const context &context = queue.get_context();
-
-    detail::meta_kernel k("find_end");
-    size_t index_arg = k.add_arg<int *>(memory_object::global_memory, "index");
-    atomic_max<int_> atomic_max_int;
-
-    k << k.decl<const int_>("i") << " = get_global_id(0);\n"
-      << k.decl<const value_type>("value") << "="
-      <<     first[k.var<const int_>("i")] << ";\n"
-      << "if(" << predicate(k.var<const value_type>("value")) << "){\n"
-      << "    " << atomic_max_int(k.var<int_ *>("index"), k.var<int_>("i")) << ";\n"
-      << "}\n";
-
-    kernel kernel = k.compile(context);
-
-    scalar<int_> index(context);
-    kernel.set_arg(index_arg, index.get_buffer());
-
-    index.write(static_cast<int_>(-1), queue);
-
-    queue.enqueue_1d_range_kernel(kernel, 0, count, 0);
-
-    int result = static_cast<int>(index.read(queue));
-
-    if(result == -1){
-        return last;
-    }
-    else {
-        return first + static_cast<difference_type>(result);
-    }
-}
-
-} // end detail namespace
 
 ///
 /// \brief Substring matching algorithm
@@ -90,6 +34,8 @@ inline InputIterator find_end_helper(InputIterator first,
 /// \param p_last Iterator pointing to end of pattern
 /// \param queue Queue on which to execute
 ///
+/// The matches are found as by search(), the last one is returned.
+///
 /// Space complexity: \Omega(n)
 ///
 template<class TextIterator, class PatternIterator>
@@ -99,37 +45,37 @@ inline TextIterator find_end(TextIterator t_first,
                              PatternIterator p_last,
                              command_queue &queue = system::default_queue())
 {
+    typedef typename std::iterator_traits<TextIterator>::difference_type difference_type;
+
     const context &context = queue.get_context();
 
-    // there is no need to check if pattern starts at last n - 1 indices
-    vector<uint_> matching_indices(
-        detail::iterator_range_size(t_first, t_last)
-            + 1 - detail::iterator_range_size(p_first, p_last),
-        context
-    );
+    const size_t n = detail::iterator_range_size(t_first, t_last);
+    const size_t m = detail::iterator_range_size(p_first, p_last);
 
-    detail::search_kernel<PatternIterator,
-                          TextIterator,
-                          vector<uint_>::iterator> kernel;
+    if(m == 0 || m > n){
+        return t_last;
+    }
 
-    kernel.set_range(p_first, p_last, t_first, t_last, matching_indices.begin());
-    kernel.exec(queue);
+    // positions of the matches in order
+    vector<uint_> positions(n - m + 1, context);
+    detail::scalar<uint_> match_count(context);
 
-    using boost::compute::_1;
+    detail::search_positions(
+        t_first, t_last, p_first, p_last,
+        positions.begin(), match_count, queue
+    );
 
-    vector<uint_>::iterator index =
-        detail::find_end_helper(
-            matching_indices.begin(),
-            matching_indices.end(),
-            _1 == 1,
-            queue
-        );
+    const uint_ count = match_count.read(queue);
 
     // pattern was not found
-    if(index == matching_indices.end())
+    if(count == 0){
         return t_last;
+    }
+
+    const uint_ last_match =
+        detail::read_single_value<uint_>(positions.get_buffer(), count - 1, queue);
 
-    return t_first + detail::iterator_range_size(matching_indices.begin(), index);
+    return t_first + static_cast<difference_type>(last_match);
 }
 
 } //end compute namespace
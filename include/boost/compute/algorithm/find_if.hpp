@@ -14,6 +14,7 @@
 #include <boost/compute/system.hpp>
 #include <boost/compute/command_queue.hpp>
 #include <boost/compute/algorithm/detail/find_if_with_atomics.hpp>
+#include <boost/compute/detail/command_tracer.hpp>
 
 namespace boost {
 namespace compute {
@@ -28,6 +29,8 @@ inline InputIterator find_if(InputIterator first,
                              UnaryPredicate predicate,
                              command_queue &queue = system::default_queue())
 {
+    detail::trace_scope trace("find_if");
+
     return detail::find_if_with_atomics(first, last, predicate, queue);
 }
 
@@ -12,6 +12,7 @@
 #define BOOST_COMPUTE_ALGORITHM_GATHER_HPP
 
 #include <boost/compute/command_queue.hpp>
+#include <boost/compute/detail/command_tracer.hpp>
 #include <boost/compute/detail/iterator_range_size.hpp>
 #include <boost/compute/detail/meta_kernel.hpp>
 #include <boost/compute/exception.hpp>
@@ -72,6 +73,8 @@ inline void gather(MapIterator first,
                    OutputIterator result,
                    command_queue &queue = system::default_queue())
 {
+    detail::trace_scope trace("gather");
+
     detail::gather_kernel<InputIterator, MapIterator, OutputIterator> kernel;
     
     kernel.set_range(first, last, input, result);
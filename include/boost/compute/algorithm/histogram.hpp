@@ -0,0 +1,445 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://boostorg.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#ifndef BOOST_COMPUTE_ALGORITHM_HISTOGRAM_HPP
+#define BOOST_COMPUTE_ALGORITHM_HISTOGRAM_HPP
+
+#include <iterator>
+#include <algorithm>
+
+#include <boost/static_assert.hpp>
+#include <boost/type_traits/is_floating_point.hpp>
+
+#include <boost/compute/system.hpp>
+#include <boost/compute/command_queue.hpp>
+#include <boost/compute/algorithm/copy.hpp>
+#include <boost/compute/algorithm/fill.hpp>
+#include <boost/compute/algorithm/reduce_by_key.hpp>
+#include <boost/compute/algorithm/scatter.hpp>
+#include <boost/compute/algorithm/sort.hpp>
+#include <boost/compute/container/vector.hpp>
+#include <boost/compute/functional/atomic.hpp>
+#include <boost/compute/iterator/constant_iterator.hpp>
+#include <boost/compute/detail/meta_kernel.hpp>
+#include <boost/compute/detail/iterator_range_size.hpp>
+#include <boost/compute/detail/parameter_cache.hpp>
+#include <boost/compute/memory/local_buffer.hpp>
+#include <boost/compute/type_traits/is_device_iterator.hpp>
+#include <boost/compute/type_traits/type_name.hpp>
+
+namespace boost {
+namespace compute {
+namespace detail {
+
+// computes the bin index for evenly spaced bins in [lower, upper). values
+// outside of the range are assigned to the "bins" bin and are not counted.
+template<class T, bool IsFloatingPoint = boost::is_floating_point<T>::value>
+struct histogram_even_binning
+{
+    histogram_even_binning(uint_ bins, T lower, T upper)
+        : m_lower(lower),
+          m_upper(upper),
+          m_scale(static_cast<T>(bins) / (upper - lower))
+    {
+    }
+
+    void declare(meta_kernel &k) const
+    {
+        k.add_set_arg<const T>("lower", m_lower);
+        k.add_set_arg<const T>("upper", m_upper);
+        k.add_set_arg<const T>("scale", m_scale);
+    }
+
+    void operator()(meta_kernel &k, const std::string &x) const
+    {
+        k << "bin = bins;\n" <<
+             "if(" << x << " >= lower && " << x << " < upper){\n" <<
+             "    bin = min((uint)((" << x << " - lower) * scale), bins - 1);\n" <<
+             "}\n";
+    }
+
+    T m_lower;
+    T m_upper;
+    T m_scale;
+};
+
+template<class T>
+struct histogram_even_binning<T, false>
+{
+    histogram_even_binning(uint_ bins, T lower, T upper)
+        : m_lower(lower),
+          m_upper(upper),
+          m_range(static_cast<ulong_>(long_(upper) - long_(lower)))
+    {
+        (void) bins;
+    }
+
+    void declare(meta_kernel &k) const
+    {
+        k.add_set_arg<const T>("lower", m_lower);
+        k.add_set_arg<const T>("upper", m_upper);
+        k.add_set_arg<const ulong_>("range", m_range);
+    }
+
+    void operator()(meta_kernel &k, const std::string &x) const
+    {
+        k << "bin = bins;\n" <<
+             "if(" << x << " >= lower && " << x << " < upper){\n" <<
+             "    bin = (uint)(((ulong)((long)" << x << " - (long)lower) * bins) / range);\n" <<
+             "}\n";
+    }
+
+    T m_lower;
+    T m_upper;
+    ulong_ m_range;
+};
+
+// computes the bin index for the bins defined by the sorted boundaries
+// range using a binary search. value x is in bin i if
+// boundaries[i] <= x < boundaries[i+1].
+template<class BoundaryIterator>
+struct histogram_range_binning
+{
+    histogram_range_binning(BoundaryIterator first, uint_ count)
+        : m_first(first),
+          m_count(count)
+    {
+    }
+
+    void declare(meta_kernel &k) const
+    {
+        k.add_set_arg<const uint_>("boundary_count", m_count);
+    }
+
+    void operator()(meta_kernel &k, const std::string &x) const
+    {
+        k << "uint lo = 0;\n" <<
+             "uint hi = boundary_count;\n" <<
+             "while(lo < hi){\n" <<
+             "    uint mid = (lo + hi) / 2;\n" <<
+             "    if(" << x << " < " << m_first[k.var<uint_>("mid")] << ")\n" <<
+             "        hi = mid;\n" <<
+             "    else\n" <<
+             "        lo = mid + 1;\n" <<
+             "}\n" <<
+             "bin = (lo > 0 && lo < boundary_count) ? lo - 1 : bins;\n";
+    }
+
+    BoundaryIterator m_first;
+    uint_ m_count;
+};
+
+// Each work-group counts its values into a private histogram in local
+// memory using local atomics. The per-work-group histograms are then
+// summed up by a second kernel with one work-item per bin.
+//
+// Space complexity: O(bins * work-groups)
+template<class InputIterator, class Binning, class OutputIterator>
+inline void histogram_with_local_atomics(InputIterator first,
+                                         InputIterator last,
+                                         const Binning &binning,
+                                         uint_ bins,
+                                         OutputIterator result,
+                                         command_queue &queue)
+{
+    typedef typename std::iterator_traits<InputIterator>::value_type T;
+
+    const device &device = queue.get_device();
+    const context &context = queue.get_context();
+
+    size_t count = iterator_range_size(first, last);
+
+    size_t tpb = 1;
+    size_t work_groups = device.compute_units();
+    if(!(device.type() & device::cpu)){
+        boost::shared_ptr<parameter_cache> parameters =
+            detail::parameter_cache::get_global_cache(device);
+
+        std::string cache_key =
+            std::string("__boost_histogram_") + type_name<T>();
+
+        tpb = parameters->get(cache_key, "tpb", 256);
+        tpb = (std::min)(tpb, device.max_work_group_size());
+        work_groups = device.compute_units() *
+            parameters->get(cache_key, "groups_per_cu", 4);
+    }
+    work_groups = (std::max)(size_t(1),
+                             (std::min)(work_groups, (count + tpb - 1) / tpb));
+
+    vector<uint_> partials(work_groups * bins, context);
+
+    meta_kernel k("histogram_local");
+    size_t count_arg = k.add_arg<const uint_>("count");
+    size_t bins_arg = k.add_arg<const uint_>("bins");
+    size_t partials_arg =
+        k.add_arg<uint_ *>(memory_object::global_memory, "partials");
+    size_t hist_arg =
+        k.add_arg<uint_ *>(memory_object::local_memory, "hist");
+    binning.declare(k);
+
+    atomic_inc<uint_> atomic_inc_uint;
+
+    k <<
+        k.decl<const uint_>("lid") << " = get_local_id(0);\n" <<
+        k.decl<const uint_>("lsize") << " = get_local_size(0);\n" <<
+        "for(uint i = lid; i < bins; i += lsize){\n" <<
+        "    hist[i] = 0;\n" <<
+        "}\n" <<
+        "barrier(CLK_LOCAL_MEM_FENCE);\n" <<
+        "for(uint i = get_global_id(0); i < count; i += get_global_size(0)){\n" <<
+        "    " << k.decl<const T>("x") << " = " << first[k.var<uint_>("i")] << ";\n" <<
+        "    uint bin;\n";
+    binning(k, "x");
+    k <<
+        "    if(bin < bins){\n" <<
+        "        " << atomic_inc_uint(k.var<uint_ *>("&hist[bin]")) << ";\n" <<
+        "    }\n" <<
+        "}\n" <<
+        "barrier(CLK_LOCAL_MEM_FENCE);\n" <<
+        "for(uint i = lid; i < bins; i += lsize){\n" <<
+        "    partials[get_group_id(0) * bins + i] = hist[i];\n" <<
+        "}\n";
+
+    kernel local_kernel = k.compile(context);
+    local_kernel.set_arg(count_arg, static_cast<uint_>(count));
+    local_kernel.set_arg(bins_arg, bins);
+    local_kernel.set_arg(partials_arg, partials.get_buffer());
+    local_kernel.set_arg(hist_arg, local_buffer<uint_>(bins));
+
+    queue.enqueue_1d_range_kernel(local_kernel, 0, work_groups * tpb, tpb);
+
+    // merge the per-work-group histograms
+    meta_kernel m("histogram_merge");
+    size_t m_groups_arg = m.add_arg<const uint_>("groups");
+    size_t m_bins_arg = m.add_arg<const uint_>("bins");
+    size_t m_partials_arg =
+        m.add_arg<const uint_ *>(memory_object::global_memory, "partials");
+
+    m <<
+        "const uint bin = get_global_id(0);\n" <<
+        "uint sum = 0;\n" <<
+        "for(uint g = 0; g < groups; g++){\n" <<
+        "    sum += partials[g * bins + bin];\n" <<
+        "}\n" <<
+        result[m.var<uint_>("bin")] << " = sum;\n";
+
+    kernel merge_kernel = m.compile(context);
+    merge_kernel.set_arg(m_groups_arg, static_cast<uint_>(work_groups));
+    merge_kernel.set_arg(m_bins_arg, bins);
+    merge_kernel.set_arg(m_partials_arg, partials.get_buffer());
+
+    queue.enqueue_1d_range_kernel(merge_kernel, 0, bins, 0);
+}
+
+// Computes the bin index of every value, sorts the bin indices and counts
+// each run with reduce_by_key(). Used when the histogram is too large to
+// fit in local memory.
+//
+// Space complexity: O(n + bins)
+template<class InputIterator, class Binning, class OutputIterator>
+inline void histogram_with_sort(InputIterator first,
+                                InputIterator last,
+                                const Binning &binning,
+                                uint_ bins,
+                                OutputIterator result,
+                                command_queue &queue)
+{
+    typedef typename std::iterator_traits<InputIterator>::value_type T;
+
+    const context &context = queue.get_context();
+
+    size_t count = iterator_range_size(first, last);
+
+    vector<uint_> keys(count, context);
+
+    meta_kernel k("histogram_bin_index");
+    size_t bins_arg = k.add_arg<const uint_>("bins");
+    binning.declare(k);
+
+    k <<
+        "const uint i = get_global_id(0);\n" <<
+        k.decl<const T>("x") << " = " << first[k.var<uint_>("i")] << ";\n" <<
+        "uint bin;\n";
+    binning(k, "x");
+    k <<
+        keys.begin()[k.var<uint_>("i")] << " = bin;\n";
+
+    kernel bin_kernel = k.compile(context);
+    bin_kernel.set_arg(bins_arg, bins);
+
+    queue.enqueue_1d_range_kernel(bin_kernel, 0, count, 0);
+
+    ::boost::compute::sort(keys.begin(), keys.end(), queue);
+
+    // values outside of the bins are counted in the extra last bin
+    vector<uint_> unique_keys(count, context);
+    vector<uint_> counts(count, context);
+    std::pair<vector<uint_>::iterator, vector<uint_>::iterator> end =
+        ::boost::compute::reduce_by_key(keys.begin(),
+                                        keys.end(),
+                                        make_constant_iterator<uint_>(1),
+                                        unique_keys.begin(),
+                                        counts.begin(),
+                                        queue);
+
+    vector<uint_> histogram(bins + 1, context);
+    ::boost::compute::fill(histogram.begin(), histogram.end(), uint_(0), queue);
+    ::boost::compute::scatter(counts.begin(),
+                              end.second,
+                              unique_keys.begin(),
+                              histogram.begin(),
+                              queue);
+    ::boost::compute::copy(histogram.begin(),
+                           histogram.begin() + bins,
+                           result,
+                           queue);
+}
+
+template<class InputIterator, class Binning, class OutputIterator>
+inline void dispatch_histogram(InputIterator first,
+                               InputIterator last,
+                               const Binning &binning,
+                               uint_ bins,
+                               OutputIterator result,
+                               command_queue &queue)
+{
+    typedef typename std::iterator_traits<OutputIterator>::value_type count_type;
+
+    if(bins == 0){
+        return;
+    }
+
+    if(first == last){
+        ::boost::compute::fill_n(result, bins, count_type(0), queue);
+        return;
+    }
+
+    const device &device = queue.get_device();
+
+    boost::shared_ptr<parameter_cache> parameters =
+        detail::parameter_cache::get_global_cache(device);
+
+    // use at most half of the local memory for the histogram
+    uint_ max_local_bins = parameters->get(
+        "__boost_histogram", "max_local_bins",
+        static_cast<uint_>(device.local_memory_size() / sizeof(uint_) / 2)
+    );
+
+    if(bins <= max_local_bins){
+        histogram_with_local_atomics(first, last, binning, bins, result, queue);
+    }
+    else {
+        histogram_with_sort(first, last, binning, bins, result, queue);
+    }
+}
+
+} // end detail namespace
+
+/// Computes the histogram of the values in the range [\p first, \p last)
+/// using \p bins evenly spaced bins between \p lower (inclusive) and
+/// \p upper (exclusive) and stores the count for each bin in the range
+/// [\p result, \p result + \p bins).
+///
+/// The value \c x is counted in bin
+/// <tt>(x - lower) * bins / (upper - lower)</tt>. Values outside of
+/// [\p lower, \p upper) are not counted.
+///
+/// \param first first element in the input range
+/// \param last last element in the input range
+/// \param bins number of bins
+/// \param lower lower bound of the first bin
+/// \param upper upper bound of the last bin
+/// \param result first element in the output range of bin counts
+/// \param queue command queue to perform the operation
+///
+/// For example, to count values in ten bins between \c 0 and \c 100:
+///
+/// \snippet test/test_histogram.cpp histogram_even
+///
+/// Histograms which fit in local memory are accumulated per work-group with
+/// local atomics and then merged. Larger histograms are computed by sorting
+/// the bin index of each value and counting the runs with reduce_by_key().
+///
+/// Space complexity: \Omega(bins * work-groups) or \Omega(n) for histograms
+/// which do not fit in local memory
+///
+/// \see histogram_range()
+template<class InputIterator, class T, class OutputIterator>
+inline void histogram_even(InputIterator first,
+                           InputIterator last,
+                           uint_ bins,
+                           const T &lower,
+                           const T &upper,
+                           OutputIterator result,
+                           command_queue &queue = system::default_queue())
+{
+    BOOST_STATIC_ASSERT(is_device_iterator<InputIterator>::value);
+    BOOST_STATIC_ASSERT(is_device_iterator<OutputIterator>::value);
+    typedef typename std::iterator_traits<InputIterator>::value_type value_type;
+
+    detail::histogram_even_binning<value_type> binning(
+        bins, static_cast<value_type>(lower), static_cast<value_type>(upper)
+    );
+
+    detail::dispatch_histogram(first, last, binning, bins, result, queue);
+}
+
+/// Computes the histogram of the values in the range [\p first, \p last)
+/// with the bins defined by the sorted range of boundaries
+/// [\p boundaries_first, \p boundaries_last) and stores the count for each
+/// bin in \p result.
+///
+/// Given \c n boundaries, there are <tt>n - 1</tt> bins and the value \c x
+/// is counted in bin \c i if <tt>boundaries[i] <= x < boundaries[i+1]</tt>.
+/// Values outside of [\c boundaries[0], \c boundaries[n-1]) are not
+/// counted.
+///
+/// \param first first element in the input range
+/// \param last last element in the input range
+/// \param boundaries_first first element in the range of bin boundaries
+/// \param boundaries_last last element in the range of bin boundaries
+/// \param result first element in the output range of bin counts
+/// \param queue command queue to perform the operation
+///
+/// Space complexity: \Omega(bins * work-groups) or \Omega(n) for histograms
+/// which do not fit in local memory
+///
+/// \see histogram_even()
+template<class InputIterator, class BoundaryIterator, class OutputIterator>
+inline void histogram_range(InputIterator first,
+                            InputIterator last,
+                            BoundaryIterator boundaries_first,
+                            BoundaryIterator boundaries_last,
+                            OutputIterator result,
+                            command_queue &queue = system::default_queue())
+{
+    BOOST_STATIC_ASSERT(is_device_iterator<InputIterator>::value);
+    BOOST_STATIC_ASSERT(is_device_iterator<BoundaryIterator>::value);
+    BOOST_STATIC_ASSERT(is_device_iterator<OutputIterator>::value);
+
+    size_t boundary_count =
+        detail::iterator_range_size(boundaries_first, boundaries_last);
+    if(boundary_count < 2){
+        return;
+    }
+
+    detail::histogram_range_binning<BoundaryIterator> binning(
+        boundaries_first, static_cast<uint_>(boundary_count)
+    );
+
+    detail::dispatch_histogram(first, last, binning,
+                               static_cast<uint_>(boundary_count - 1),
+                               result, queue);
+}
+
+} // end compute namespace
+} // end boost namespace
+
+#endif // BOOST_COMPUTE_ALGORITHM_HISTOGRAM_HPP
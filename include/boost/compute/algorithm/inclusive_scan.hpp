@@ -15,6 +15,7 @@
 #include <boost/compute/system.hpp>
 #include <boost/compute/command_queue.hpp>
 #include <boost/compute/algorithm/detail/scan.hpp>
+#include <boost/compute/detail/command_tracer.hpp>
 
 namespace boost {
 namespace compute {
@@ -55,6 +56,8 @@ inclusive_scan(InputIterator first,
                BinaryOperator binary_op,
                command_queue &queue = system::default_queue())
 {
+    detail::trace_scope trace("inclusive_scan");
+
     typedef typename
         std::iterator_traits<OutputIterator>::value_type output_type;
 
@@ -71,6 +74,8 @@ inclusive_scan(InputIterator first,
                OutputIterator result,
                command_queue &queue = system::default_queue())
 {
+    detail::trace_scope trace("inclusive_scan");
+
     typedef typename
         std::iterator_traits<OutputIterator>::value_type output_type;
 
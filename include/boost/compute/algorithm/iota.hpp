@@ -15,6 +15,7 @@
 #include <boost/compute/command_queue.hpp>
 #include <boost/compute/algorithm/copy.hpp>
 #include <boost/compute/iterator/counting_iterator.hpp>
+#include <boost/compute/detail/command_tracer.hpp>
 
 namespace boost {
 namespace compute {
@@ -34,6 +35,8 @@ inline void iota(BufferIterator first,
                  const T &value,
                  command_queue &queue = system::default_queue())
 {
+    detail::trace_scope trace("iota");
+
     T count = static_cast<T>(detail::iterator_range_size(first, last));
 
     copy(
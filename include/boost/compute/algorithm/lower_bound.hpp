@@ -15,6 +15,8 @@
 #include <boost/compute/system.hpp>
 #include <boost/compute/command_queue.hpp>
 #include <boost/compute/algorithm/detail/binary_find.hpp>
+#include <boost/compute/algorithm/detail/vectorized_binary_search.hpp>
+#include <boost/compute/detail/iterator_range_size.hpp>
 
 namespace boost {
 namespace compute {
@@ -40,6 +42,38 @@ lower_bound(InputIterator first,
     return position;
 }
 
+/// Searches the sorted range [\p first, \p last) for each value in the
+/// range [\p needles_first, \p needles_last) and stores the index of the
+/// first element that is not less than the value in \p result.
+///
+/// All values are searched for at once with a single kernel. Large batches
+/// of values are sorted before searching for better memory locality and,
+/// when there are enough of them, searched for by walking the merge path
+/// of the two sorted ranges.
+///
+/// For example, to find the positions of several values in a sorted vector:
+///
+/// \snippet test/test_binary_search.cpp vectorized_lower_bound
+///
+/// Space complexity: \Omega(1) for small batches, \Omega(m) otherwise
+///
+/// \see upper_bound(), equal_range()
+template<class InputIterator, class NeedleIterator, class OutputIterator>
+inline OutputIterator
+lower_bound(InputIterator first,
+            InputIterator last,
+            NeedleIterator needles_first,
+            NeedleIterator needles_last,
+            OutputIterator result,
+            command_queue &queue = system::default_queue())
+{
+    detail::vectorized_search(first, last, needles_first, needles_last,
+                              detail::vectorized_lower_bound,
+                              result, result, queue);
+
+    return result + detail::iterator_range_size(needles_first, needles_last);
+}
+
 } // end compute namespace
 } // end boost namespace
 
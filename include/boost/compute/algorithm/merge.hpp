@@ -16,6 +16,7 @@
 #include <boost/compute/algorithm/copy.hpp>
 #include <boost/compute/algorithm/detail/merge_with_merge_path.hpp>
 #include <boost/compute/algorithm/detail/serial_merge.hpp>
+#include <boost/compute/detail/command_tracer.hpp>
 #include <boost/compute/detail/iterator_range_size.hpp>
 #include <boost/compute/detail/parameter_cache.hpp>
 
@@ -52,6 +53,8 @@ inline OutputIterator merge(InputIterator1 first1,
                             Compare comp,
                             command_queue &queue = system::default_queue())
 {
+    detail::trace_scope trace("merge");
+
     typedef typename std::iterator_traits<InputIterator1>::value_type input1_type;
     typedef typename std::iterator_traits<InputIterator2>::value_type input2_type;
     typedef typename std::iterator_traits<OutputIterator>::value_type output_type;
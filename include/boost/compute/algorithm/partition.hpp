@@ -22,7 +22,7 @@ namespace compute {
 /// Partitions the elements in the range [\p first, \p last) according to
 /// \p predicate. Order of the elements need not be preserved.
 ///
-/// Space complexity: \Omega(3n)
+/// Space complexity: \Omega(n)
 ///
 /// \see is_partitioned() and stable_partition()
 ///
@@ -11,10 +11,16 @@
 #ifndef BOOST_COMPUTE_ALGORITHM_PARTITION_COPY_HPP
 #define BOOST_COMPUTE_ALGORITHM_PARTITION_COPY_HPP
 
+#include <utility>
+
 #include <boost/compute/system.hpp>
 #include <boost/compute/functional.hpp>
 #include <boost/compute/command_queue.hpp>
 #include <boost/compute/algorithm/copy_if.hpp>
+#include <boost/compute/algorithm/detail/stream_compact.hpp>
+#include <boost/compute/container/detail/scalar.hpp>
+#include <boost/compute/detail/command_tracer.hpp>
+#include <boost/compute/detail/iterator_range_size.hpp>
 
 namespace boost {
 namespace compute {
@@ -24,7 +30,13 @@ namespace compute {
 /// and all of the elements for which \p predicate returns \c false to
 /// the range beginning at \p first_false.
 ///
-/// Space complexity: \Omega(2n)
+/// The input is read and the predicate is evaluated once for each element.
+/// The positions of the true values are computed with a scan of the
+/// predicate flags and the position of each false value is its index minus
+/// the number of true values before it, so both ranges are written by the
+/// same kernel.
+///
+/// Space complexity: \Omega(n / 16)
 ///
 /// \see partition()
 template<class InputIterator,
@@ -39,24 +51,40 @@ partition_copy(InputIterator first,
                UnaryPredicate predicate,
                command_queue &queue = system::default_queue())
 {
-    // copy true values
-    OutputIterator1 last_true =
-        ::boost::compute::copy_if(first,
-                                  last,
-                                  first_true,
-                                  predicate,
-                                  queue);
+    detail::trace_scope trace("partition_copy");
+
+    typedef typename std::iterator_traits<InputIterator>::value_type value_type;
+    typedef typename
+        std::iterator_traits<OutputIterator1>::difference_type difference_type1;
+    typedef typename
+        std::iterator_traits<OutputIterator2>::difference_type difference_type2;
+
+    const size_t count = detail::iterator_range_size(first, last);
+    if(count == 0){
+        return std::make_pair(first_true, first_false);
+    }
+
+    detail::scalar<uint_> true_count(queue.get_context());
+    detail::stream_partition(
+        count,
+        first_true,
+        first_false,
+        detail::compact_if_flag<InputIterator, UnaryPredicate>(first, predicate),
+        detail::compact_transform_value<InputIterator, identity<value_type> >(
+            first, identity<value_type>()
+        ),
+        false,
+        true_count,
+        queue
+    );
 
-    // copy false values
-    OutputIterator2 last_false =
-        ::boost::compute::copy_if(first,
-                                  last,
-                                  first_false,
-                                  not1(predicate),
-                                  queue);
+    const size_t copied_true = true_count.read(queue);
 
     // return iterators to the end of the true and the false ranges
-    return std::make_pair(last_true, last_false);
+    return std::make_pair(
+        first_true + static_cast<difference_type1>(copied_true),
+        first_false + static_cast<difference_type2>(count - copied_true)
+    );
 }
 
 } // end compute namespace
@@ -13,18 +13,34 @@
 
 #include <iterator>
 
+#include <boost/mpl/and.hpp>
+#include <boost/mpl/not.hpp>
+#include <boost/preprocessor/repetition/enum_params.hpp>
+#include <boost/tuple/tuple.hpp>
+#include <boost/type_traits/is_same.hpp>
+#include <boost/utility/enable_if.hpp>
+
 #include <boost/compute/system.hpp>
 #include <boost/compute/functional.hpp>
+#include <boost/compute/detail/command_tracer.hpp>
 #include <boost/compute/detail/meta_kernel.hpp>
 #include <boost/compute/command_queue.hpp>
+#include <boost/compute/multi_queue.hpp>
 #include <boost/compute/container/array.hpp>
 #include <boost/compute/container/vector.hpp>
 #include <boost/compute/algorithm/copy_n.hpp>
+#include <boost/compute/algorithm/detail/half_function.hpp>
+#include <boost/compute/algorithm/detail/host_backend.hpp>
+#include <boost/compute/algorithm/detail/host_range.hpp>
 #include <boost/compute/algorithm/detail/inplace_reduce.hpp>
+#include <boost/compute/algorithm/detail/multi_device.hpp>
 #include <boost/compute/algorithm/detail/reduce_on_gpu.hpp>
 #include <boost/compute/algorithm/detail/reduce_on_cpu.hpp>
+#include <boost/compute/algorithm/detail/reduce_multiple.hpp>
 #include <boost/compute/detail/iterator_range_size.hpp>
+#include <boost/compute/iterator/transform_iterator.hpp>
 #include <boost/compute/memory/local_buffer.hpp>
+#include <boost/compute/type_traits/is_device_iterator.hpp>
 #include <boost/compute/type_traits/result_of.hpp>
 
 namespace boost {
@@ -204,8 +220,23 @@ inline void dispatch_reduce(InputIterator first,
                             InputIterator last,
                             OutputIterator result,
                             const plus<T> &function,
-                            command_queue &queue)
+                            command_queue &queue,
+                            typename boost::enable_if<
+                                mpl::and_<
+                                    is_device_iterator<InputIterator>,
+                                    mpl::not_<
+                                        boost::is_same<
+                                            InputIterator, buffer_iterator<half_>
+                                        >
+                                    >
+                                >
+                            >::type* = 0)
 {
+    // small ranges are reduced on the host
+    if(reduce_on_host(first, last, result, function, queue)){
+        return;
+    }
+
     const context &context = queue.get_context();
     const device &device = queue.get_device();
 
@@ -227,11 +258,54 @@ inline void dispatch_reduce(InputIterator first,
                             InputIterator last,
                             OutputIterator result,
                             BinaryFunction function,
-                            command_queue &queue)
+                            command_queue &queue,
+                            typename boost::enable_if<
+                                is_device_iterator<InputIterator>
+                            >::type* = 0)
 {
     generic_reduce(first, last, result, function, queue);
 }
 
+// reduce() for half values. the values are loaded as float values and
+// reduced with the float version of the function.
+template<class OutputIterator, class BinaryFunction>
+inline void dispatch_reduce(buffer_iterator<half_> first,
+                            buffer_iterator<half_> last,
+                            OutputIterator result,
+                            BinaryFunction function,
+                            command_queue &queue)
+{
+    dispatch_reduce(
+        ::boost::compute::make_transform_iterator(first, convert<float_>()),
+        ::boost::compute::make_transform_iterator(last, convert<float_>()),
+        result,
+        half_function<BinaryFunction>::make(function),
+        queue
+    );
+}
+
+// reduce() for host iterators. on cpu devices the host memory is reduced
+// in place instead of being copied to the device first.
+template<class InputIterator, class OutputIterator, class BinaryFunction>
+inline void dispatch_reduce(InputIterator first,
+                            InputIterator last,
+                            OutputIterator result,
+                            BinaryFunction function,
+                            command_queue &queue,
+                            typename boost::disable_if<
+                                is_device_iterator<InputIterator>
+                            >::type* = 0)
+{
+    if(reduce_on_host(first, last, result, function, queue)){
+        return;
+    }
+
+    host_range<InputIterator> input(first, last, queue);
+
+    dispatch_reduce(input.begin(), input.end(), result, function, queue);
+    input.finish();
+}
+
 } // end detail namespace
 
 /// Returns the result of applying \p function to the elements in the
@@ -255,6 +329,13 @@ inline void dispatch_reduce(InputIterator first,
 /// result argument. This allows for values to be reduced and copied
 /// to the host all with a single function call.
 ///
+/// The input range may also be given by host iterators. On CPU devices the
+/// host memory is then reduced directly without being copied.
+///
+/// If \c BOOST_COMPUTE_USE_HOST_BACKEND is defined, small ranges of
+/// fundamental values reduced with \c plus are reduced on the host,
+/// mapping them first if they are in device memory.
+///
 /// For example, to calculate the sum of the values in a device vector and
 /// copy the result to a value on the host:
 ///
@@ -276,6 +357,8 @@ inline void reduce(InputIterator first,
                    BinaryFunction function,
                    command_queue &queue = system::default_queue())
 {
+    detail::trace_scope trace("reduce");
+
     if(first == last){
         return;
     }
@@ -290,6 +373,8 @@ inline void reduce(InputIterator first,
                    OutputIterator result,
                    command_queue &queue = system::default_queue())
 {
+    detail::trace_scope trace("reduce");
+
     typedef typename std::iterator_traits<InputIterator>::value_type T;
 
     if(first == last){
@@ -299,6 +384,138 @@ inline void reduce(InputIterator first,
     detail::dispatch_reduce(first, last, result, plus<T>(), queue);
 }
 
+/// \overload
+///
+/// Computes several independent reductions of the range [\p first, \p last)
+/// in a single pass and stores their results as a \c boost::tuple<> in
+/// \p result.
+///
+/// Each element of \p reductions is a \c boost::tuple<> of a unary transform
+/// function, a binary reduction function and an initial value. The result of
+/// each reduction is equal to
+/// <tt>function(init, reduce(transform(first..last), function))</tt> and has
+/// the type of its initial value. For empty ranges the initial values are
+/// stored in \p result.
+///
+/// For example, to calculate the sum, sum of squares, minimum and maximum
+/// of a vector of floats with one pass over the input and one read-back:
+///
+/// \code
+/// using boost::compute::lambda::_1;
+///
+/// boost::tuple<float, float, float, float> stats;
+/// boost::compute::reduce(
+///     vec.begin(), vec.end(),
+///     boost::make_tuple(
+///         boost::make_tuple(_1, plus<float>(), 0.f),
+///         boost::make_tuple(_1 * _1, plus<float>(), 0.f),
+///         boost::make_tuple(_1, min<float>(), FLT_MAX),
+///         boost::make_tuple(_1, max<float>(), -FLT_MAX)
+///     ),
+///     &stats,
+///     queue
+/// );
+/// \endcode
+///
+/// As the input is distributed over all work-items, the reduction functions
+/// must be both associative and commutative.
+///
+/// Space complexity: \Omega(compute units)
+template<class InputIterator,
+         BOOST_PP_ENUM_PARAMS(10, class Reduction),
+         class OutputIterator>
+inline void reduce(InputIterator first,
+                   InputIterator last,
+                   const boost::tuple<BOOST_PP_ENUM_PARAMS(10, Reduction)> &reductions,
+                   OutputIterator result,
+                   command_queue &queue = system::default_queue())
+{
+    detail::trace_scope trace("reduce");
+
+    detail::reduce_multiple(first, last, reductions, result, queue);
+}
+
+/// \overload
+///
+/// Reduces the range [\p first, \p last) with all of the devices in
+/// \p queues. Each device reduces its part of the range to a temporary
+/// buffer and the partial results are then reduced on the first queue.
+///
+/// \see multi_queue
+template<class InputIterator, class OutputIterator, class BinaryFunction>
+inline void reduce(InputIterator first,
+                   InputIterator last,
+                   OutputIterator result,
+                   BinaryFunction function,
+                   multi_queue &queues)
+{
+    typedef typename
+        std::iterator_traits<InputIterator>::value_type
+        input_type;
+    typedef typename
+        std::iterator_traits<InputIterator>::difference_type
+        difference_type;
+    typedef typename
+        boost::compute::result_of<BinaryFunction(input_type, input_type)>::type
+        result_type;
+
+    if(first == last){
+        return;
+    }
+
+    const size_t count = detail::iterator_range_size(first, last);
+
+    detail::multi_device_launch launch(queues, count);
+
+    // one partial result for each device with a non-empty part
+    std::vector<size_t> partial_sizes(launch.size(), 0);
+    size_t partial_count = 0;
+    for(size_t i = 0; i < launch.size(); i++){
+        if(launch.count(i)){
+            partial_sizes[i] = 1;
+            partial_count++;
+        }
+    }
+
+    const context &context = queues.get_context();
+    detail::multi_device_parts<result_type> parts(context, partial_sizes);
+    for(size_t i = 0; i < launch.size(); i++){
+        if(launch.count(i)){
+            ::boost::compute::reduce(
+                first + static_cast<difference_type>(launch.begin(i)),
+                first + static_cast<difference_type>(launch.end(i)),
+                parts.begin(i),
+                function,
+                launch.queue(i)
+            );
+        }
+    }
+    launch.wait();
+
+    vector<result_type> partials(partial_count, context);
+    parts.copy_to(partials.begin(), queues.get_queue(0));
+
+    ::boost::compute::reduce(
+        partials.begin(),
+        partials.begin() + static_cast<difference_type>(partial_count),
+        result,
+        function,
+        queues.get_queue(0)
+    );
+}
+
+/// \overload
+template<class InputIterator, class OutputIterator>
+inline void reduce(InputIterator first,
+                   InputIterator last,
+                   OutputIterator result,
+                   multi_queue &queues)
+{
+    typedef typename std::iterator_traits<InputIterator>::value_type T;
+
+    ::boost::compute::reduce(first, last, result, plus<T>(), queues);
+}
+
 } // end compute namespace
 } // end boost namespace
 
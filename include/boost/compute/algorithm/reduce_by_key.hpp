@@ -19,6 +19,7 @@
 #include <boost/compute/functional.hpp>
 #include <boost/compute/system.hpp>
 #include <boost/compute/algorithm/detail/reduce_by_key.hpp>
+#include <boost/compute/detail/command_tracer.hpp>
 
 namespace boost {
 namespace compute {
@@ -68,6 +69,8 @@ reduce_by_key(InputKeyIterator keys_first,
               BinaryPredicate predicate,
               command_queue &queue = system::default_queue())
 {
+    detail::trace_scope trace("reduce_by_key");
+
     return detail::dispatch_reduce_by_key(keys_first, keys_last, values_first,
                                           keys_result, values_result,
                                           function, predicate,
@@ -115,6 +118,36 @@ reduce_by_key(InputKeyIterator keys_first,
                          queue);
 }
 
+/// \overload
+///
+/// Stores the number of reduced values in \p result_size instead of
+/// returning the ends of the result ranges. On devices where the single-pass
+/// reduction is used the number is not read back to the host, so it can be
+/// passed on to subsequent kernels without a synchronization.
+///
+/// \snippet test/test_reduce_by_key.cpp reduce_by_key_result_size
+template<class InputKeyIterator, class InputValueIterator,
+         class OutputKeyIterator, class OutputValueIterator,
+         class BinaryFunction, class BinaryPredicate>
+inline void
+reduce_by_key(InputKeyIterator keys_first,
+              InputKeyIterator keys_last,
+              InputValueIterator values_first,
+              OutputKeyIterator keys_result,
+              OutputValueIterator values_result,
+              BinaryFunction function,
+              BinaryPredicate predicate,
+              buffer_iterator<uint_> result_size,
+              command_queue &queue = system::default_queue())
+{
+    detail::trace_scope trace("reduce_by_key");
+
+    detail::dispatch_reduce_by_key(keys_first, keys_last, values_first,
+                                   keys_result, values_result,
+                                   function, predicate, result_size,
+                                   queue);
+}
+
 } // end compute namespace
 } // end boost namespace
 
@@ -22,7 +22,7 @@ namespace compute {
 /// Removes each element equal to \p value in the range [\p first,
 /// \p last).
 ///
-/// Space complexity: \Omega(3n)
+/// Space complexity: \Omega(n)
 ///
 /// \see remove_if()
 template<class Iterator, class T>
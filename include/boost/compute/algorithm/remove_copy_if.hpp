@@ -0,0 +1,74 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://boostorg.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#ifndef BOOST_COMPUTE_ALGORITHM_REMOVE_COPY_IF_HPP
+#define BOOST_COMPUTE_ALGORITHM_REMOVE_COPY_IF_HPP
+
+#include <boost/compute/system.hpp>
+#include <boost/compute/command_queue.hpp>
+#include <boost/compute/algorithm/transform_if.hpp>
+#include <boost/compute/async/future.hpp>
+#include <boost/compute/detail/command_tracer.hpp>
+#include <boost/compute/functional/identity.hpp>
+#include <boost/compute/functional/logical.hpp>
+
+namespace boost {
+namespace compute {
+
+/// Copies each element in the range [\p first, \p last) for which
+/// \p predicate returns \c false to the range beginning at \p result.
+/// Returns an iterator to the end of the copied elements.
+///
+/// Space complexity: \Omega(n / 16)
+///
+/// \see remove_if(), copy_if()
+template<class InputIterator, class OutputIterator, class Predicate>
+inline OutputIterator remove_copy_if(InputIterator first,
+                                     InputIterator last,
+                                     OutputIterator result,
+                                     Predicate predicate,
+                                     command_queue &queue = system::default_queue())
+{
+    detail::trace_scope trace("remove_copy_if");
+
+    typedef typename std::iterator_traits<InputIterator>::value_type T;
+
+    return ::boost::compute::transform_if(
+        first, last, result, identity<T>(), not1(predicate), queue
+    );
+}
+
+/// Copies each element in the range [\p first, \p last) for which
+/// \p predicate returns \c false to the range beginning at \p result. The
+/// copy is performed asynchronously, the returned future holds the end of
+/// the copied elements.
+///
+/// Space complexity: \Omega(n / 16)
+///
+/// \see remove_copy_if(), copy_if_async()
+template<class InputIterator, class OutputIterator, class Predicate>
+inline future<OutputIterator>
+remove_copy_if_async(InputIterator first,
+                     InputIterator last,
+                     OutputIterator result,
+                     Predicate predicate,
+                     command_queue &queue = system::default_queue())
+{
+    typedef typename std::iterator_traits<InputIterator>::value_type T;
+
+    return ::boost::compute::transform_if_async(
+        first, last, result, identity<T>(), not1(predicate), queue
+    );
+}
+
+} // end compute namespace
+} // end boost namespace
+
+#endif // BOOST_COMPUTE_ALGORITHM_REMOVE_COPY_IF_HPP
@@ -12,9 +12,8 @@
 #define BOOST_COMPUTE_ALGORITHM_REMOVE_IF_HPP
 
 #include <boost/compute/system.hpp>
-#include <boost/compute/algorithm/copy_if.hpp>
+#include <boost/compute/algorithm/remove_copy_if.hpp>
 #include <boost/compute/container/vector.hpp>
-#include <boost/compute/functional/logical.hpp>
 
 namespace boost {
 namespace compute {
@@ -22,9 +21,9 @@ namespace compute {
 /// Removes each element for which \p predicate returns \c true in the
 /// range [\p first, \p last).
 ///
-/// Space complexity: \Omega(3n)
+/// Space complexity: \Omega(n)
 ///
-/// \see remove()
+/// \see remove(), remove_copy_if()
 template<class Iterator, class Predicate>
 inline Iterator remove_if(Iterator first,
                           Iterator last,
@@ -36,11 +35,11 @@ inline Iterator remove_if(Iterator first,
     // temporary storage for the input data
     ::boost::compute::vector<value_type> tmp(first, last, queue);
 
-    return ::boost::compute::copy_if(tmp.begin(),
-                                     tmp.end(),
-                                     first,
-                                     not1(predicate),
-                                     queue);
+    return ::boost::compute::remove_copy_if(tmp.begin(),
+                                            tmp.end(),
+                                            first,
+                                            predicate,
+                                            queue);
 }
 
 } // end compute namespace
@@ -0,0 +1,113 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://boostorg.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#ifndef BOOST_COMPUTE_ALGORITHM_RUN_LENGTH_DECODE_HPP
+#define BOOST_COMPUTE_ALGORITHM_RUN_LENGTH_DECODE_HPP
+
+#include <iterator>
+
+#include <boost/static_assert.hpp>
+
+#include <boost/compute/system.hpp>
+#include <boost/compute/command_queue.hpp>
+#include <boost/compute/algorithm/gather.hpp>
+#include <boost/compute/algorithm/inclusive_scan.hpp>
+#include <boost/compute/algorithm/detail/vectorized_binary_search.hpp>
+#include <boost/compute/container/vector.hpp>
+#include <boost/compute/iterator/counting_iterator.hpp>
+#include <boost/compute/detail/iterator_range_size.hpp>
+#include <boost/compute/detail/parameter_cache.hpp>
+#include <boost/compute/detail/read_write_single_value.hpp>
+#include <boost/compute/type_traits/is_device_iterator.hpp>
+
+namespace boost {
+namespace compute {
+
+/// Expands the runs described by the range of values [\p values_first,
+/// \p values_last) and the range of run lengths beginning at
+/// \p counts_first by writing each value as many times as its run length
+/// to the range beginning at \p result.
+///
+/// Returns an iterator at the end of the result range. Only the total
+/// length of the result is read back to the host.
+///
+/// \param values_first first element in the run value range
+/// \param values_last last element in the run value range
+/// \param counts_first first element in the run length range
+/// \param result first element in the output range
+/// \param queue command queue to perform the operation
+///
+/// For example:
+///
+/// \snippet test/test_run_length_encode.cpp run_length_decode_int
+///
+/// Space complexity: \Omega(n + r) where r is the number of runs
+///
+/// \see run_length_encode()
+template<class ValueIterator, class CountIterator, class OutputIterator>
+inline OutputIterator
+run_length_decode(ValueIterator values_first,
+                  ValueIterator values_last,
+                  CountIterator counts_first,
+                  OutputIterator result,
+                  command_queue &queue = system::default_queue())
+{
+    BOOST_STATIC_ASSERT(is_device_iterator<ValueIterator>::value);
+    BOOST_STATIC_ASSERT(is_device_iterator<CountIterator>::value);
+    BOOST_STATIC_ASSERT(is_device_iterator<OutputIterator>::value);
+
+    typedef typename
+        std::iterator_traits<OutputIterator>::difference_type difference_type;
+
+    const context &context = queue.get_context();
+
+    const size_t runs = detail::iterator_range_size(values_first, values_last);
+    if(runs == 0){
+        return result;
+    }
+
+    // the end offset of each run in the output
+    vector<uint_> ends(runs, context);
+    ::boost::compute::inclusive_scan(
+        counts_first, counts_first + runs, ends.begin(), queue
+    );
+
+    const uint_ count =
+        detail::read_single_value<uint_>(ends.get_buffer(), runs - 1, queue);
+    if(count == 0){
+        return result;
+    }
+
+    // the run of each output index is the upper bound of the index in the
+    // run ends. the indices are already sorted so the searches are done by
+    // walking the merge path of the run ends and the indices.
+    boost::shared_ptr<detail::parameter_cache> parameters =
+        detail::parameter_cache::get_global_cache(queue.get_device());
+    uint_ vpt = parameters->get("__boost_run_length_decode", "vpt", 8);
+
+    vector<uint_> run_indices(count, context);
+    detail::vectorized_merge_path_search_kernel(
+        ends.begin(), runs,
+        make_counting_iterator<uint_>(0), count,
+        detail::vectorized_upper_bound,
+        run_indices.begin(), vpt, queue
+    );
+
+    ::boost::compute::gather(
+        run_indices.begin(), run_indices.end(), values_first, result, queue
+    );
+
+    return result + static_cast<difference_type>(count);
+}
+
+} // end compute namespace
+} // end boost namespace
+
+#endif // BOOST_COMPUTE_ALGORITHM_RUN_LENGTH_DECODE_HPP
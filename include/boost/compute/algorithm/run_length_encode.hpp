@@ -0,0 +1,79 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://boostorg.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#ifndef BOOST_COMPUTE_ALGORITHM_RUN_LENGTH_ENCODE_HPP
+#define BOOST_COMPUTE_ALGORITHM_RUN_LENGTH_ENCODE_HPP
+
+#include <iterator>
+#include <utility>
+
+#include <boost/static_assert.hpp>
+
+#include <boost/compute/system.hpp>
+#include <boost/compute/command_queue.hpp>
+#include <boost/compute/algorithm/reduce_by_key.hpp>
+#include <boost/compute/functional/operator.hpp>
+#include <boost/compute/iterator/constant_iterator.hpp>
+#include <boost/compute/type_traits/is_device_iterator.hpp>
+
+namespace boost {
+namespace compute {
+
+/// Compresses the range [\p first, \p last) by replacing each run of
+/// consecutive equal values with a single value and the length of the run.
+/// The values are written to the range beginning at \p values_result and
+/// the run lengths to the range beginning at \p counts_result.
+///
+/// Returns a pair of iterators at the end of the ranges [\p values_result,
+/// values_result_last) and [\p counts_result, counts_result_last).
+///
+/// \param first first element in the input range
+/// \param last last element in the input range
+/// \param values_result first element in the run value output range
+/// \param counts_result first element in the run length output range
+/// \param queue command queue to perform the operation
+///
+/// For example:
+///
+/// \snippet test/test_run_length_encode.cpp run_length_encode_int
+///
+/// Space complexity on GPUs: \Omega(2n)<br>
+/// Space complexity on CPUs: \Omega(1)
+///
+/// \see run_length_decode(), reduce_by_key(), unique_copy()
+template<class InputIterator, class OutputValueIterator, class OutputCountIterator>
+inline std::pair<OutputValueIterator, OutputCountIterator>
+run_length_encode(InputIterator first,
+                  InputIterator last,
+                  OutputValueIterator values_result,
+                  OutputCountIterator counts_result,
+                  command_queue &queue = system::default_queue())
+{
+    BOOST_STATIC_ASSERT(is_device_iterator<InputIterator>::value);
+    BOOST_STATIC_ASSERT(is_device_iterator<OutputValueIterator>::value);
+    BOOST_STATIC_ASSERT(is_device_iterator<OutputCountIterator>::value);
+
+    typedef typename
+        std::iterator_traits<InputIterator>::value_type value_type;
+    typedef typename
+        std::iterator_traits<OutputCountIterator>::value_type count_type;
+
+    // each run is the sum of a one for each of its values
+    return ::boost::compute::reduce_by_key(
+        first, last, make_constant_iterator(count_type(1)),
+        values_result, counts_result,
+        plus<count_type>(), equal_to<value_type>(), queue
+    );
+}
+
+} // end compute namespace
+} // end boost namespace
+
+#endif // BOOST_COMPUTE_ALGORITHM_RUN_LENGTH_ENCODE_HPP
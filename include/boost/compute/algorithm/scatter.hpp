@@ -18,6 +18,7 @@
 #include <boost/compute/command_queue.hpp>
 #include <boost/compute/iterator/buffer_iterator.hpp>
 #include <boost/compute/type_traits/type_name.hpp>
+#include <boost/compute/detail/command_tracer.hpp>
 #include <boost/compute/detail/iterator_range_size.hpp>
 #include <boost/compute/detail/meta_kernel.hpp>
 
@@ -38,19 +39,14 @@ public:
                    OutputIterator result)
     {
         m_count = iterator_range_size(first, last);
-        m_input_offset = first.get_index();
-        m_output_offset = result.get_index();
-
-        m_input_offset_arg = add_arg<uint_>("input_offset");
-        m_output_offset_arg = add_arg<uint_>("output_offset");
 
+        // the offsets of first and result are applied by their index
+        // expressions so any device iterator (e.g. svm_ptr) can be used
         *this <<
             "const uint i = get_global_id(0);\n" <<
-            "uint i1 = " << map[expr<uint_>("i")] << 
-                " + output_offset;\n" <<
-            "uint i2 = i + input_offset;\n" <<
-            result[expr<uint_>("i1")] << "=" << 
-                first[expr<uint_>("i2")] << ";\n";
+            "uint i1 = " << map[expr<uint_>("i")] << ";\n" <<
+            result[expr<uint_>("i1")] << "=" <<
+                first[expr<uint_>("i")] << ";\n";
     }
 
     event exec(command_queue &queue)
@@ -59,18 +55,11 @@ public:
             return event();
         }
 
-        set_arg(m_input_offset_arg, uint_(m_input_offset));
-        set_arg(m_output_offset_arg, uint_(m_output_offset));
-
         return exec_1d(queue, 0, m_count);
     }
 
 private:
     size_t m_count;
-    size_t m_input_offset;    
-    size_t m_input_offset_arg;    
-    size_t m_output_offset;    
-    size_t m_output_offset_arg;    
 };
 
 } // end detail namespace
@@ -89,6 +78,8 @@ inline void scatter(InputIterator first,
                     OutputIterator result,
                     command_queue &queue = system::default_queue())
 {
+    detail::trace_scope trace("scatter");
+
     detail::scatter_kernel<InputIterator, MapIterator, OutputIterator> kernel;
     
     kernel.set_range(first, last, map, result);
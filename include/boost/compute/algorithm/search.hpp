@@ -11,11 +11,11 @@
 #ifndef BOOST_COMPUTE_ALGORITHM_SEARCH_HPP
 #define BOOST_COMPUTE_ALGORITHM_SEARCH_HPP
 
-#include <boost/compute/algorithm/detail/search_all.hpp>
-#include <boost/compute/algorithm/find.hpp>
+#include <boost/compute/algorithm/detail/search_horspool.hpp>
 #include <boost/compute/container/vector.hpp>
+#include <boost/compute/container/detail/scalar.hpp>
 #include <boost/compute/detail/iterator_range_size.hpp>
-#include <boost/compute/detail/meta_kernel.hpp>
+#include <boost/compute/detail/read_write_single_value.hpp>
 #include <boost/compute/system.hpp>
 
 namespace boost {
@@ -34,7 +34,13 @@ namespace compute {
 /// \param p_last Iterator pointing to end of pattern
 /// \param queue Queue on which to execute
 ///
+/// For integral values the text is searched in tiles held in local memory
+/// with the Boyer-Moore-Horspool skip table of the pattern, so positions
+/// which cannot match are skipped without being compared.
+///
 /// Space complexity: \Omega(distance(\p t_first, \p t_last))
+///
+/// \see search_any()
 template<class TextIterator, class PatternIterator>
 inline TextIterator search(TextIterator t_first,
                            TextIterator t_last,
@@ -42,30 +48,36 @@ inline TextIterator search(TextIterator t_first,
                            PatternIterator p_last,
                            command_queue &queue = system::default_queue())
 {
-    // there is no need to check if pattern starts at last n - 1 indices
-    vector<uint_> matching_indices(
-        detail::iterator_range_size(t_first, t_last)
-            - detail::iterator_range_size(p_first, p_last) + 1,
-        queue.get_context()
-    );
+    const size_t n = detail::iterator_range_size(t_first, t_last);
+    const size_t m = detail::iterator_range_size(p_first, p_last);
 
-    // search_kernel puts value 1 at every index in vector where pattern starts at
-    detail::search_kernel<PatternIterator,
-                          TextIterator,
-                          vector<uint_>::iterator> kernel;
+    if(m == 0){
+        return t_first;
+    }
+    else if(m > n){
+        return t_last;
+    }
 
-    kernel.set_range(p_first, p_last, t_first, t_last, matching_indices.begin());
-    kernel.exec(queue);
+    // positions of the matches in order
+    vector<uint_> positions(n - m + 1, queue.get_context());
+    detail::scalar<uint_> match_count(queue.get_context());
 
-    vector<uint_>::iterator index = ::boost::compute::find(
-        matching_indices.begin(), matching_indices.end(), uint_(1), queue
+    detail::search_positions(
+        t_first, t_last, p_first, p_last,
+        positions.begin(), match_count, queue
     );
 
     // pattern was not found
-    if(index == matching_indices.end())
+    if(match_count.read(queue) == 0){
         return t_last;
+    }
+
+    typedef typename std::iterator_traits<TextIterator>::difference_type difference_type;
+
+    const uint_ first_match =
+        detail::read_single_value<uint_>(positions.get_buffer(), 0, queue);
 
-    return t_first + detail::iterator_range_size(matching_indices.begin(), index);
+    return t_first + static_cast<difference_type>(first_match);
 }
 
 } //end compute namespace
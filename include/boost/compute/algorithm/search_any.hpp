@@ -0,0 +1,149 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://boostorg.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#ifndef BOOST_COMPUTE_ALGORITHM_SEARCH_ANY_HPP
+#define BOOST_COMPUTE_ALGORITHM_SEARCH_ANY_HPP
+
+#include <iterator>
+
+#include <boost/static_assert.hpp>
+#include <boost/type_traits/is_integral.hpp>
+
+#include <boost/compute/system.hpp>
+#include <boost/compute/command_queue.hpp>
+#include <boost/compute/algorithm/detail/aho_corasick.hpp>
+#include <boost/compute/detail/command_tracer.hpp>
+
+namespace boost {
+namespace compute {
+
+/// Searches the text [\p t_first, \p t_last) for each of the patterns in
+/// [\p patterns_first, \p patterns_last) and writes a \c uint2_ of the
+/// position and the pattern index of each match to the range beginning at
+/// \p result. Returns an iterator to the end of the written matches.
+///
+/// The result range must be large enough for all the matches. As patterns
+/// may overlap there can be more matches than values in the text, use the
+/// overload taking the end of the result range when the number of matches
+/// is not known in advance.
+///
+/// The text must have a one byte integral value type (e.g. \c char_) and
+/// each pattern is a host container of characters (e.g. \c std::string).
+/// The matches are ordered by the position of their last character,
+/// overlapping matches and matches of different patterns at the same
+/// position are all written. Empty patterns are ignored.
+///
+/// For example, to find the words in a text:
+/// \code
+/// std::vector<std::string> words;
+/// words.push_back("he");
+/// words.push_back("she");
+/// words.push_back("hers");
+///
+/// // for "ushers" the matches are (1, 1) for "she", (2, 0) for "he"
+/// // and (2, 2) for "hers"
+/// vector<uint2_>::iterator end = boost::compute::search_any(
+///     text.begin(), text.end(), words.begin(), words.end(), matches.begin(), queue
+/// );
+/// \endcode
+///
+/// The patterns are compiled on the host into an Aho-Corasick automaton
+/// which is copied to the device, so all the patterns are found by the
+/// same scan of the text (instead of one search per pattern). Each
+/// work-item runs the automaton over a chunk of the text held in local
+/// memory. The text is scanned twice: once to count the matches of each
+/// chunk and once to write them.
+///
+/// Space complexity: \Omega(256 * p + n / 64) where \c p is the total
+/// length of the patterns
+///
+/// \see search()
+template<class TextIterator, class PatternIterator, class OutputIterator>
+inline OutputIterator search_any(TextIterator t_first,
+                                 TextIterator t_last,
+                                 PatternIterator patterns_first,
+                                 PatternIterator patterns_last,
+                                 OutputIterator result,
+                                 command_queue &queue = system::default_queue())
+{
+    typedef typename std::iterator_traits<TextIterator>::value_type T;
+
+    BOOST_STATIC_ASSERT_MSG(
+        boost::is_integral<T>::value && sizeof(T) == 1,
+        "search_any() is only supported for texts of one byte integral values"
+    );
+
+    detail::trace_scope trace("search_any");
+
+    detail::aho_corasick_automaton automaton(patterns_first, patterns_last);
+
+    const size_t match_count = detail::aho_corasick_search(
+        t_first, t_last, automaton, result, ~size_t(0), queue
+    );
+
+    return result + static_cast<
+        typename std::iterator_traits<OutputIterator>::difference_type
+    >(match_count);
+}
+
+/// Searches the text [\p t_first, \p t_last) for each of the patterns in
+/// [\p patterns_first, \p patterns_last) and writes the first matches
+/// which fit into the range [\p result, \p result_last). Returns the number
+/// of all the matches in the text, which may be larger than the size of
+/// the result range.
+///
+/// The matches are written as by the overload without \p result_last. To
+/// first count the matches and then write all of them:
+/// \code
+/// size_t count = boost::compute::search_any(
+///     text.begin(), text.end(), words.begin(), words.end(),
+///     matches.begin(), matches.begin(), queue
+/// );
+/// matches.resize(count, queue);
+/// boost::compute::search_any(
+///     text.begin(), text.end(), words.begin(), words.end(),
+///     matches.begin(), matches.end(), queue
+/// );
+/// \endcode
+///
+/// If the result range is empty the text is only scanned once.
+///
+/// Space complexity: \Omega(256 * p + n / 64) where \c p is the total
+/// length of the patterns
+template<class TextIterator, class PatternIterator, class OutputIterator>
+inline size_t search_any(TextIterator t_first,
+                         TextIterator t_last,
+                         PatternIterator patterns_first,
+                         PatternIterator patterns_last,
+                         OutputIterator result,
+                         OutputIterator result_last,
+                         command_queue &queue = system::default_queue())
+{
+    typedef typename std::iterator_traits<TextIterator>::value_type T;
+
+    BOOST_STATIC_ASSERT_MSG(
+        boost::is_integral<T>::value && sizeof(T) == 1,
+        "search_any() is only supported for texts of one byte integral values"
+    );
+
+    detail::trace_scope trace("search_any");
+
+    detail::aho_corasick_automaton automaton(patterns_first, patterns_last);
+
+    return detail::aho_corasick_search(
+        t_first, t_last, automaton, result,
+        static_cast<size_t>(std::distance(result, result_last)), queue
+    );
+}
+
+} // end compute namespace
+} // end boost namespace
+
+#endif // BOOST_COMPUTE_ALGORITHM_SEARCH_ANY_HPP
@@ -17,12 +17,21 @@
 
 #include <boost/compute/system.hpp>
 #include <boost/compute/command_queue.hpp>
+#include <boost/compute/multi_queue.hpp>
+#include <boost/compute/algorithm/copy.hpp>
+#include <boost/compute/algorithm/detail/half_function.hpp>
+#include <boost/compute/algorithm/detail/host_backend.hpp>
+#include <boost/compute/algorithm/detail/host_range.hpp>
 #include <boost/compute/algorithm/detail/merge_sort_on_cpu.hpp>
 #include <boost/compute/algorithm/detail/merge_sort_on_gpu.hpp>
+#include <boost/compute/algorithm/detail/multi_device.hpp>
+#include <boost/compute/algorithm/detail/multi_device_merge.hpp>
 #include <boost/compute/algorithm/detail/radix_sort.hpp>
 #include <boost/compute/algorithm/detail/insertion_sort.hpp>
 #include <boost/compute/algorithm/reverse.hpp>
 #include <boost/compute/container/mapped_view.hpp>
+#include <boost/compute/container/vector.hpp>
+#include <boost/compute/detail/command_tracer.hpp>
 #include <boost/compute/detail/iterator_range_size.hpp>
 #include <boost/compute/iterator/buffer_iterator.hpp>
 #include <boost/compute/type_traits/is_device_iterator.hpp>
@@ -114,6 +123,11 @@ inline void dispatch_sort(Iterator first,
                               is_device_iterator<Iterator>
                           >::type* = 0)
 {
+    // small ranges are sorted on the host
+    if(sort_on_host(first, last, compare, false, queue)){
+        return;
+    }
+
     if(queue.get_device().type() & device::gpu) {
         dispatch_gpu_sort(first, last, compare, queue);
         return;
@@ -121,6 +135,30 @@ inline void dispatch_sort(Iterator first,
     ::boost::compute::detail::merge_sort_on_cpu(first, last, compare, queue);
 }
 
+// sort() for half values. the values are sorted as float values and
+// stored back as half values, which also works on devices without the
+// cl_khr_fp16 extension.
+template<class Compare>
+inline void dispatch_sort(buffer_iterator<half_> first,
+                          buffer_iterator<half_> last,
+                          Compare compare,
+                          command_queue &queue)
+{
+    const size_t count = detail::iterator_range_size(first, last);
+    if(count < 2){
+        return;
+    }
+
+    vector<float_> values(count, queue.get_context());
+    ::boost::compute::copy(first, last, values.begin(), queue);
+
+    dispatch_sort(
+        values.begin(), values.end(), half_function<Compare>::make(compare), queue
+    );
+
+    ::boost::compute::copy(values.begin(), values.end(), first, queue);
+}
+
 // sort() for host iterators
 template<class Iterator, class Compare>
 inline void dispatch_sort(Iterator first,
@@ -131,20 +169,18 @@ inline void dispatch_sort(Iterator first,
                               is_device_iterator<Iterator>
                           >::type* = 0)
 {
-    typedef typename std::iterator_traits<Iterator>::value_type T;
-
-    size_t size = static_cast<size_t>(std::distance(first, last));
+    if(sort_on_host(first, last, compare, false, queue)){
+        return;
+    }
 
-    // create mapped buffer
-    mapped_view<T> view(
-        boost::addressof(*first), size, queue.get_context()
-    );
+    // use the host memory directly on cpu devices
+    host_range<Iterator> range(first, last, queue);
 
-    // sort mapped buffer
-    dispatch_sort(view.begin(), view.end(), compare, queue);
+    // sort on the device
+    dispatch_sort(range.begin(), range.end(), compare, queue);
 
     // return results to host
-    view.map(queue);
+    range.update_host();
 }
 
 } // end detail namespace
@@ -176,6 +212,11 @@ inline void dispatch_sort(Iterator first,
 /// boost::compute::sort(data.begin(), data.end(), queue);
 /// \endcode
 ///
+/// If \c BOOST_COMPUTE_USE_HOST_BACKEND is defined, small ranges of
+/// fundamental values sorted with \c less or \c greater are sorted on the
+/// host (after mapping them for device ranges) as the kernel launches
+/// would take longer than the sort itself.
+///
 /// Space complexity: \Omega(n)
 ///
 /// \see is_sorted()
@@ -185,6 +226,8 @@ inline void sort(Iterator first,
                  Compare compare,
                  command_queue &queue = system::default_queue())
 {
+    detail::trace_scope trace("sort");
+
     ::boost::compute::detail::dispatch_sort(first, last, compare, queue);
 }
 
@@ -201,6 +244,103 @@ inline void sort(Iterator first,
     );
 }
 
+/// \overload
+///
+/// Sorts the range with all of the devices in \p queues. Each device sorts
+/// a copy of its part of the range, then the sorted parts are merged
+/// pairwise with every merge split across the devices at the points where
+/// its merge path crosses the device boundaries of the output. The range
+/// must be given by device iterators.
+///
+/// Space complexity: \Omega(n)
+///
+/// \see multi_queue
+template<class Iterator, class Compare>
+inline void sort(Iterator first,
+                 Iterator last,
+                 Compare compare,
+                 multi_queue &queues)
+{
+    typedef typename std::iterator_traits<Iterator>::value_type value_type;
+    typedef typename std::iterator_traits<Iterator>::difference_type difference_type;
+
+    const size_t count = detail::iterator_range_size(first, last);
+    if(count < 2){
+        return;
+    }
+
+    // sort each part in a buffer of its own and copy the sorted parts back
+    // on a single queue
+    detail::multi_device_launch launch(queues, count);
+    detail::multi_device_parts<value_type> parts(
+        queues.get_context(), launch.counts()
+    );
+    for(size_t i = 0; i < launch.size(); i++){
+        if(launch.count(i)){
+            ::boost::compute::copy(
+                first + static_cast<difference_type>(launch.begin(i)),
+                first + static_cast<difference_type>(launch.end(i)),
+                parts.begin(i),
+                launch.queue(i)
+            );
+            ::boost::compute::sort(
+                parts.begin(i), parts.end(i), compare, launch.queue(i)
+            );
+        }
+    }
+    launch.wait();
+    parts.copy_to(first, queues.get_queue(0));
+
+    // boundaries of the sorted runs
+    std::vector<size_t> runs(1, 0);
+    for(size_t i = 0; i < launch.size(); i++){
+        if(launch.count(i)){
+            runs.push_back(launch.end(i));
+        }
+    }
+    if(runs.size() <= 2){
+        return;
+    }
+
+    // merge the runs, alternating between the input and a temporary buffer
+    vector<value_type> temp(count, queues.get_context());
+
+    bool in_temp = false;
+    while(runs.size() > 2){
+        if(in_temp){
+            runs = detail::multi_device_merge_runs(
+                temp.begin(), first, runs, compare, queues
+            );
+        }
+        else {
+            runs = detail::multi_device_merge_runs(
+                first, temp.begin(), runs, compare, queues
+            );
+        }
+
+        in_temp = !in_temp;
+    }
+
+    if(in_temp){
+        command_queue &queue = queues.get_queue(0);
+        ::boost::compute::copy(temp.begin(), temp.end(), first, queue);
+        queue.finish();
+    }
+}
+
+/// \overload
+template<class Iterator>
+inline void sort(Iterator first,
+                 Iterator last,
+                 multi_queue &queues)
+{
+    typedef typename std::iterator_traits<Iterator>::value_type value_type;
+
+    ::boost::compute::sort(
+        first, last, ::boost::compute::less<value_type>(), queues
+    );
+}
+
 } // end compute namespace
 } // end boost namespace
 
@@ -21,7 +21,10 @@
 #include <boost/compute/algorithm/detail/merge_sort_on_gpu.hpp>
 #include <boost/compute/algorithm/detail/insertion_sort.hpp>
 #include <boost/compute/algorithm/detail/radix_sort.hpp>
+#include <boost/compute/algorithm/detail/sort_by_key_with_index.hpp>
 #include <boost/compute/algorithm/reverse.hpp>
+#include <boost/compute/detail/command_tracer.hpp>
+#include <boost/compute/detail/is_buffer_iterator.hpp>
 #include <boost/compute/detail/iterator_range_size.hpp>
 
 namespace boost {
@@ -37,6 +40,8 @@ dispatch_gpu_sort_by_key(KeyIterator keys_first,
                          less<typename std::iterator_traits<KeyIterator>::value_type> compare,
                          command_queue &queue,
                          typename boost::enable_if_c<
+                             is_buffer_iterator<KeyIterator>::value &&
+                             is_buffer_iterator<ValueIterator>::value &&
                              is_radix_sortable<
                                  typename std::iterator_traits<KeyIterator>::value_type
                              >::value
@@ -64,6 +69,8 @@ dispatch_gpu_sort_by_key(KeyIterator keys_first,
                          greater<typename std::iterator_traits<KeyIterator>::value_type> compare,
                          command_queue &queue,
                          typename boost::enable_if_c<
+                             is_buffer_iterator<KeyIterator>::value &&
+                             is_buffer_iterator<ValueIterator>::value &&
                              is_radix_sortable<
                                  typename std::iterator_traits<KeyIterator>::value_type
                              >::value
@@ -111,6 +118,18 @@ inline void dispatch_sort_by_key(KeyIterator keys_first,
                                  Compare compare,
                                  command_queue &queue)
 {
+    // sort the keys with the indices of the values and move the (wide)
+    // values only once at the end
+    if(use_sort_by_key_with_index(keys_first, keys_last, values_first, queue)){
+        vector<uint_> indices(
+            iterator_range_size(keys_first, keys_last), queue.get_context()
+        );
+        make_sort_by_key_indices(indices, queue);
+        dispatch_sort_by_key(keys_first, keys_last, indices.begin(), compare, queue);
+        gather_sorted_values(indices, values_first, queue);
+        return;
+    }
+
     if(queue.get_device().type() & device::gpu) {
         dispatch_gpu_sort_by_key(keys_first, keys_last, values_first, compare, queue);
         return;
@@ -128,6 +147,11 @@ inline void dispatch_sort_by_key(KeyIterator keys_first,
 ///
 /// If no compare function is specified, \c less is used.
 ///
+/// Values wider than the \c "index_payload_size_threshold" parameter of the
+/// device's parameter cache (16 bytes by default) are not moved by the sort
+/// itself: the keys are sorted with the indices of the values, which are then
+/// gathered once.
+///
 /// Space complexity: \Omega(2n)
 ///
 /// \see sort()
@@ -138,6 +162,8 @@ inline void sort_by_key(KeyIterator keys_first,
                         Compare compare,
                         command_queue &queue = system::default_queue())
 {
+    detail::trace_scope trace("sort_by_key");
+
     ::boost::compute::detail::dispatch_sort_by_key(
         keys_first, keys_last, values_first, compare, queue
     );
@@ -16,7 +16,11 @@
 #include <boost/compute/functional.hpp>
 #include <boost/compute/command_queue.hpp>
 #include <boost/compute/algorithm/copy_if.hpp>
+#include <boost/compute/algorithm/detail/stream_compact.hpp>
 #include <boost/compute/container/vector.hpp>
+#include <boost/compute/container/detail/scalar.hpp>
+#include <boost/compute/detail/command_tracer.hpp>
+#include <boost/compute/detail/iterator_range_size.hpp>
 
 namespace boost {
 namespace compute {
@@ -33,7 +37,10 @@ namespace compute {
 /// \param predicate Unary predicate to be applied on each element
 /// \param queue Queue on which to execute
 ///
-/// Space complexity: \Omega(3n)
+/// The values are copied to a temporary vector and partitioned back into
+/// the range with the same single-pass engine as partition_copy().
+///
+/// Space complexity: \Omega(n)
 ///
 /// \see is_partitioned() and partition()
 ///
@@ -43,29 +50,39 @@ inline Iterator stable_partition(Iterator first,
                                  UnaryPredicate predicate,
                                  command_queue &queue = system::default_queue())
 {
+    detail::trace_scope trace("stable_partition");
+
     typedef typename std::iterator_traits<Iterator>::value_type value_type;
+    typedef typename std::iterator_traits<Iterator>::difference_type difference_type;
+    typedef typename ::boost::compute::vector<value_type>::iterator temp_iterator;
+
+    const size_t count = detail::iterator_range_size(first, last);
+    if(count == 0){
+        return first;
+    }
 
     // make temporary copy of the input
     ::boost::compute::vector<value_type> tmp(first, last, queue);
 
-    // copy true values
-    Iterator last_true =
-        ::boost::compute::copy_if(tmp.begin(),
-                                  tmp.end(),
-                                  first,
-                                  predicate,
-                                  queue);
-
-    // copy false values
-    Iterator last_false =
-        ::boost::compute::copy_if(tmp.begin(),
-                                  tmp.end(),
-                                  last_true,
-                                  not1(predicate),
-                                  queue);
+    // write the true values followed by the false values with one kernel
+    detail::scalar<uint_> true_count(queue.get_context());
+    detail::stream_partition(
+        count,
+        first,
+        first,
+        detail::compact_if_flag<temp_iterator, UnaryPredicate>(
+            tmp.begin(), predicate
+        ),
+        detail::compact_transform_value<temp_iterator, identity<value_type> >(
+            tmp.begin(), identity<value_type>()
+        ),
+        true,
+        true_count,
+        queue
+    );
 
     // return iterator pointing to the last true value
-    return last_true;
+    return first + static_cast<difference_type>(true_count.read(queue));
 }
 
 } // end compute namespace
@@ -13,15 +13,21 @@
 
 #include <iterator>
 
+#include <boost/utility/enable_if.hpp>
+
 #include <boost/compute/system.hpp>
 #include <boost/compute/command_queue.hpp>
+#include <boost/compute/algorithm/detail/host_backend.hpp>
+#include <boost/compute/algorithm/detail/host_range.hpp>
 #include <boost/compute/algorithm/detail/merge_sort_on_cpu.hpp>
 #include <boost/compute/algorithm/detail/merge_sort_on_gpu.hpp>
 #include <boost/compute/algorithm/detail/radix_sort.hpp>
 #include <boost/compute/algorithm/detail/insertion_sort.hpp>
 #include <boost/compute/algorithm/reverse.hpp>
 #include <boost/compute/functional/operator.hpp>
+#include <boost/compute/detail/command_tracer.hpp>
 #include <boost/compute/detail/iterator_range_size.hpp>
+#include <boost/compute/type_traits/is_device_iterator.hpp>
 
 namespace boost {
 namespace compute {
@@ -67,11 +73,62 @@ dispatch_gpu_stable_sort(buffer_iterator<T> first,
     ::boost::compute::detail::radix_sort(first, last, false, queue);
 }
 
+// stable_sort() for device iterators
+template<class Iterator, class Compare>
+inline void dispatch_stable_sort(Iterator first,
+                                 Iterator last,
+                                 Compare compare,
+                                 command_queue &queue,
+                                 typename boost::enable_if<
+                                     is_device_iterator<Iterator>
+                                 >::type* = 0)
+{
+    // small ranges are sorted on the host
+    if(sort_on_host(first, last, compare, true, queue)){
+        return;
+    }
+
+    if(queue.get_device().type() & device::gpu) {
+        ::boost::compute::detail::dispatch_gpu_stable_sort(
+            first, last, compare, queue
+        );
+        return;
+    }
+    ::boost::compute::detail::merge_sort_on_cpu(first, last, compare, queue);
+}
+
+// stable_sort() for host iterators
+template<class Iterator, class Compare>
+inline void dispatch_stable_sort(Iterator first,
+                                 Iterator last,
+                                 Compare compare,
+                                 command_queue &queue,
+                                 typename boost::disable_if<
+                                     is_device_iterator<Iterator>
+                                 >::type* = 0)
+{
+    if(sort_on_host(first, last, compare, true, queue)){
+        return;
+    }
+
+    // use the host memory directly on cpu devices
+    host_range<Iterator> range(first, last, queue);
+
+    // sort on the device
+    dispatch_stable_sort(range.begin(), range.end(), compare, queue);
+
+    // return results to host
+    range.update_host();
+}
+
 } // end detail namespace
 
 /// Sorts the values in the range [\p first, \p last) according to
 /// \p compare. The relative order of identical values is preserved.
 ///
+/// Like sort(), stable_sort() can also be used directly with host
+/// iterators.
+///
 /// Space complexity: \Omega(n)
 ///
 /// \see sort(), is_sorted()
@@ -81,13 +138,11 @@ inline void stable_sort(Iterator first,
                         Compare compare,
                         command_queue &queue = system::default_queue())
 {
-    if(queue.get_device().type() & device::gpu) {
-        ::boost::compute::detail::dispatch_gpu_stable_sort(
-            first, last, compare, queue
-        );
-        return;
-    }
-    ::boost::compute::detail::merge_sort_on_cpu(first, last, compare, queue);
+    detail::trace_scope trace("stable_sort");
+
+    ::boost::compute::detail::dispatch_stable_sort(
+        first, last, compare, queue
+    );
 }
 
 /// \overload
@@ -16,6 +16,7 @@
 #include <boost/compute/system.hpp>
 #include <boost/compute/command_queue.hpp>
 #include <boost/compute/algorithm/sort_by_key.hpp>
+#include <boost/compute/detail/command_tracer.hpp>
 #include <boost/compute/detail/iterator_range_size.hpp>
 
 namespace boost {
@@ -107,6 +108,18 @@ inline void dispatch_ssort_by_key(KeyIterator keys_first,
                                   Compare compare,
                                   command_queue &queue)
 {
+    // the indices are sorted stably, so gathering the values keeps the
+    // order of the values with equal keys
+    if(use_sort_by_key_with_index(keys_first, keys_last, values_first, queue)){
+        vector<uint_> indices(
+            iterator_range_size(keys_first, keys_last), queue.get_context()
+        );
+        make_sort_by_key_indices(indices, queue);
+        dispatch_ssort_by_key(keys_first, keys_last, indices.begin(), compare, queue);
+        gather_sorted_values(indices, values_first, queue);
+        return;
+    }
+
     if(queue.get_device().type() & device::gpu) {
         dispatch_gpu_ssort_by_key(
             keys_first, keys_last, values_first, compare, queue
@@ -126,6 +139,11 @@ inline void dispatch_ssort_by_key(KeyIterator keys_first,
 ///
 /// If no compare function is specified, \c less is used.
 ///
+/// Values wider than the \c "index_payload_size_threshold" parameter of the
+/// device's parameter cache (16 bytes by default) are not moved by the sort
+/// itself: the keys are sorted with the indices of the values, which are then
+/// gathered once.
+///
 /// Space complexity: \Omega(2n)
 ///
 /// \see sort()
@@ -136,6 +154,8 @@ inline void stable_sort_by_key(KeyIterator keys_first,
                                Compare compare,
                                command_queue &queue = system::default_queue())
 {
+    detail::trace_scope trace("stable_sort_by_key");
+
     ::boost::compute::detail::dispatch_ssort_by_key(
         keys_first, keys_last, values_first, compare, queue
     );
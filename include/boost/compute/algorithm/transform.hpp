@@ -11,16 +11,238 @@
 #ifndef BOOST_COMPUTE_ALGORITHM_TRANSFORM_HPP
 #define BOOST_COMPUTE_ALGORITHM_TRANSFORM_HPP
 
+#include <boost/mpl/and.hpp>
+#include <boost/mpl/not.hpp>
+#include <boost/utility/enable_if.hpp>
+
 #include <boost/compute/system.hpp>
 #include <boost/compute/command_queue.hpp>
+#include <boost/compute/multi_queue.hpp>
 #include <boost/compute/algorithm/copy.hpp>
+#include <boost/compute/algorithm/detail/host_range.hpp>
+#include <boost/compute/algorithm/detail/multi_device.hpp>
 #include <boost/compute/iterator/transform_iterator.hpp>
 #include <boost/compute/iterator/zip_iterator.hpp>
 #include <boost/compute/functional/detail/unpack.hpp>
+#include <boost/compute/detail/command_tracer.hpp>
+#include <boost/compute/detail/iterator_plus_distance.hpp>
+#include <boost/compute/detail/iterator_range_size.hpp>
+#include <boost/compute/type_traits/is_device_iterator.hpp>
 
 namespace boost {
 namespace compute {
 
+namespace detail {
+
+// transform() for device iterators
+template<class InputIterator, class OutputIterator, class UnaryOperator>
+inline OutputIterator
+dispatch_transform(InputIterator first,
+                   InputIterator last,
+                   OutputIterator result,
+                   UnaryOperator op,
+                   command_queue &queue,
+                   typename boost::enable_if<
+                       is_device_iterator<InputIterator>
+                   >::type* = 0)
+{
+    return copy(
+               ::boost::compute::make_transform_iterator(first, op),
+               ::boost::compute::make_transform_iterator(last, op),
+               result,
+               queue
+           );
+}
+
+// transform() for host input iterators and device output iterators
+template<class InputIterator, class OutputIterator, class UnaryOperator>
+inline OutputIterator
+dispatch_transform(InputIterator first,
+                   InputIterator last,
+                   OutputIterator result,
+                   UnaryOperator op,
+                   command_queue &queue,
+                   typename boost::enable_if<
+                       mpl::and_<
+                           mpl::not_<is_device_iterator<InputIterator> >,
+                           is_device_iterator<OutputIterator>
+                       >
+                   >::type* = 0)
+{
+    host_range<InputIterator> input(first, last, queue);
+
+    OutputIterator result_last =
+        dispatch_transform(input.begin(), input.end(), result, op, queue);
+    input.finish();
+
+    return result_last;
+}
+
+// transform() for host iterators. on cpu devices the host memory is used
+// directly for both the input and the output.
+template<class InputIterator, class OutputIterator, class UnaryOperator>
+inline OutputIterator
+dispatch_transform(InputIterator first,
+                   InputIterator last,
+                   OutputIterator result,
+                   UnaryOperator op,
+                   command_queue &queue,
+                   typename boost::enable_if<
+                       mpl::and_<
+                           mpl::not_<is_device_iterator<InputIterator> >,
+                           mpl::not_<is_device_iterator<OutputIterator> >
+                       >
+                   >::type* = 0)
+{
+    typedef typename host_range<InputIterator>::value_type input_type;
+
+    const size_t n = iterator_range_size(first, last);
+    if(n == 0){
+        return result;
+    }
+
+    OutputIterator result_last = iterator_plus_distance(result, n);
+
+    // when transforming in place the output range is also the input
+    const bool in_place = is_same_host_element(first, result);
+
+    host_range<OutputIterator> output(result, result_last, queue, in_place);
+    host_range<InputIterator> input(in_place ? last : first, last, queue);
+
+    buffer_iterator<input_type> input_first = in_place ?
+        make_buffer_iterator<input_type>(output.begin().get_buffer(), 0) :
+        input.begin();
+
+    dispatch_transform(
+        input_first, input_first + n, output.begin(), op, queue
+    );
+    output.update_host();
+
+    return result_last;
+}
+
+// binary transform() for device iterators
+template<class InputIterator1,
+         class InputIterator2,
+         class OutputIterator,
+         class BinaryOperator>
+inline OutputIterator
+dispatch_binary_transform(InputIterator1 first1,
+                          InputIterator1 last1,
+                          InputIterator2 first2,
+                          OutputIterator result,
+                          BinaryOperator op,
+                          command_queue &queue,
+                          typename boost::enable_if<
+                              is_device_iterator<InputIterator1>
+                          >::type* = 0)
+{
+    typedef typename std::iterator_traits<InputIterator1>::difference_type difference_type;
+
+    difference_type n = std::distance(first1, last1);
+
+    return dispatch_transform(
+               make_zip_iterator(boost::make_tuple(first1, first2)),
+               make_zip_iterator(boost::make_tuple(last1, first2 + n)),
+               result,
+               detail::unpack(op),
+               queue
+           );
+}
+
+// binary transform() for host input iterators and device output iterators
+template<class InputIterator1,
+         class InputIterator2,
+         class OutputIterator,
+         class BinaryOperator>
+inline OutputIterator
+dispatch_binary_transform(InputIterator1 first1,
+                          InputIterator1 last1,
+                          InputIterator2 first2,
+                          OutputIterator result,
+                          BinaryOperator op,
+                          command_queue &queue,
+                          typename boost::enable_if<
+                              mpl::and_<
+                                  mpl::not_<is_device_iterator<InputIterator1> >,
+                                  is_device_iterator<OutputIterator>
+                              >
+                          >::type* = 0)
+{
+    const size_t n = iterator_range_size(first1, last1);
+
+    host_range<InputIterator1> input1(first1, last1, queue);
+    host_range<InputIterator2> input2(
+        first2, iterator_plus_distance(first2, n), queue
+    );
+
+    OutputIterator result_last = dispatch_binary_transform(
+        input1.begin(), input1.end(), input2.begin(), result, op, queue
+    );
+    input1.finish();
+    input2.finish();
+
+    return result_last;
+}
+
+// binary transform() for host iterators. on cpu devices the host memory is
+// used directly for the inputs and the output.
+template<class InputIterator1,
+         class InputIterator2,
+         class OutputIterator,
+         class BinaryOperator>
+inline OutputIterator
+dispatch_binary_transform(InputIterator1 first1,
+                          InputIterator1 last1,
+                          InputIterator2 first2,
+                          OutputIterator result,
+                          BinaryOperator op,
+                          command_queue &queue,
+                          typename boost::enable_if<
+                              mpl::and_<
+                                  mpl::not_<is_device_iterator<InputIterator1> >,
+                                  mpl::not_<is_device_iterator<OutputIterator> >
+                              >
+                          >::type* = 0)
+{
+    typedef typename host_range<InputIterator1>::value_type input1_type;
+    typedef typename host_range<InputIterator2>::value_type input2_type;
+
+    const size_t n = iterator_range_size(first1, last1);
+    if(n == 0){
+        return result;
+    }
+
+    InputIterator2 last2 = iterator_plus_distance(first2, n);
+    OutputIterator result_last = iterator_plus_distance(result, n);
+
+    // when transforming in place the output range is also an input
+    const bool in_place1 = is_same_host_element(first1, result);
+    const bool in_place2 = is_same_host_element(first2, result);
+
+    host_range<OutputIterator> output(
+        result, result_last, queue, in_place1 || in_place2
+    );
+    host_range<InputIterator1> input1(in_place1 ? last1 : first1, last1, queue);
+    host_range<InputIterator2> input2(in_place2 ? last2 : first2, last2, queue);
+
+    buffer_iterator<input1_type> input1_first = in_place1 ?
+        make_buffer_iterator<input1_type>(output.begin().get_buffer(), 0) :
+        input1.begin();
+    buffer_iterator<input2_type> input2_first = in_place2 ?
+        make_buffer_iterator<input2_type>(output.begin().get_buffer(), 0) :
+        input2.begin();
+
+    dispatch_binary_transform(
+        input1_first, input1_first + n, input2_first, output.begin(), op, queue
+    );
+    output.update_host();
+
+    return result_last;
+}
+
+} // end detail namespace
+
 /// Transforms the elements in the range [\p first, \p last) using
 /// operator \p op and stores the results in the range beginning at
 /// \p result.
@@ -29,6 +251,10 @@ namespace compute {
 ///
 /// \snippet test/test_transform.cpp transform_abs
 ///
+/// The transform() algorithm can also be used directly with host iterators
+/// (e.g. for a \c std::vector). On CPU devices the host memory is then used
+/// by the device without being copied.
+///
 /// Space complexity: \Omega(1)
 ///
 /// \see copy()
@@ -39,12 +265,9 @@ inline OutputIterator transform(InputIterator first,
                                 UnaryOperator op,
                                 command_queue &queue = system::default_queue())
 {
-    return copy(
-               ::boost::compute::make_transform_iterator(first, op),
-               ::boost::compute::make_transform_iterator(last, op),
-               result,
-               queue
-           );
+    detail::trace_scope trace("transform");
+
+    return detail::dispatch_transform(first, last, result, op, queue);
 }
 
 /// \overload
@@ -58,6 +281,65 @@ inline OutputIterator transform(InputIterator1 first1,
                                 OutputIterator result,
                                 BinaryOperator op,
                                 command_queue &queue = system::default_queue())
+{
+    detail::trace_scope trace("transform");
+
+    return detail::dispatch_binary_transform(
+        first1, last1, first2, result, op, queue
+    );
+}
+
+/// Transforms the elements in the range [\p first, \p last) using
+/// operator \p op and stores the results in the range beginning at
+/// \p result. The range is split across the devices in \p queues
+/// proportionally to their weights. Each device writes its part of the
+/// results to a temporary buffer which is then copied to \p result on the
+/// first queue.
+///
+/// \see multi_queue
+template<class InputIterator, class OutputIterator, class UnaryOperator>
+inline OutputIterator transform(InputIterator first,
+                                InputIterator last,
+                                OutputIterator result,
+                                UnaryOperator op,
+                                multi_queue &queues)
+{
+    typedef typename std::iterator_traits<InputIterator>::difference_type difference_type;
+    typedef typename std::iterator_traits<OutputIterator>::value_type output_type;
+
+    const size_t n = static_cast<size_t>(std::distance(first, last));
+
+    detail::multi_device_launch launch(queues, n);
+    detail::multi_device_parts<output_type> parts(
+        queues.get_context(), launch.counts()
+    );
+    for(size_t i = 0; i < launch.size(); i++){
+        if(launch.count(i)){
+            const difference_type begin = static_cast<difference_type>(launch.begin(i));
+            const difference_type end = static_cast<difference_type>(launch.end(i));
+
+            ::boost::compute::transform(
+                first + begin, first + end, parts.begin(i), op, launch.queue(i)
+            );
+        }
+    }
+    launch.wait();
+    parts.copy_to(result, queues.get_queue(0));
+
+    return result + static_cast<difference_type>(n);
+}
+
+/// \overload
+template<class InputIterator1,
+         class InputIterator2,
+         class OutputIterator,
+         class BinaryOperator>
+inline OutputIterator transform(InputIterator1 first1,
+                                InputIterator1 last1,
+                                InputIterator2 first2,
+                                OutputIterator result,
+                                BinaryOperator op,
+                                multi_queue &queues)
 {
     typedef typename std::iterator_traits<InputIterator1>::difference_type difference_type;
 
@@ -68,7 +350,7 @@ inline OutputIterator transform(InputIterator1 first1,
                make_zip_iterator(boost::make_tuple(last1, first2 + n)),
                result,
                detail::unpack(op),
-               queue
+               queues
            );
 }
 
@@ -16,9 +16,9 @@
 #include <boost/compute/command_queue.hpp>
 #include <boost/compute/algorithm/count.hpp>
 #include <boost/compute/algorithm/count_if.hpp>
-#include <boost/compute/algorithm/exclusive_scan.hpp>
-#include <boost/compute/container/vector.hpp>
-#include <boost/compute/detail/meta_kernel.hpp>
+#include <boost/compute/algorithm/detail/stream_compact.hpp>
+#include <boost/compute/async/future.hpp>
+#include <boost/compute/container/detail/scalar.hpp>
 #include <boost/compute/detail/iterator_range_size.hpp>
 #include <boost/compute/iterator/discard_iterator.hpp>
 
@@ -26,7 +26,50 @@ namespace boost {
 namespace compute {
 namespace detail {
 
-// Space complexity: O(2n)
+// compacts the values without blocking, the returned future holds the end
+// of the output range once the number of values has been read back.
+//
+// Space complexity: O(n / 16)
+template<class InputIterator, class OutputIterator, class UnaryFunction, class Predicate>
+inline future<OutputIterator>
+transform_if_async_impl(InputIterator first,
+                        InputIterator last,
+                        OutputIterator result,
+                        UnaryFunction function,
+                        Predicate predicate,
+                        bool copyIndex,
+                        command_queue &queue)
+{
+    size_t count = detail::iterator_range_size(first, last);
+
+    scalar<uint_> copied_element_count(queue.get_context());
+
+    event compacted;
+    if(copyIndex){
+        compacted = stream_compact(
+            count,
+            result,
+            compact_if_flag<InputIterator, Predicate>(first, predicate),
+            compact_index_value(),
+            copied_element_count,
+            queue
+        );
+    }
+    else {
+        compacted = stream_compact(
+            count,
+            result,
+            compact_if_flag<InputIterator, Predicate>(first, predicate),
+            compact_transform_value<InputIterator, UnaryFunction>(first, function),
+            copied_element_count,
+            queue
+        );
+    }
+
+    return make_compacted_future(result, copied_element_count, compacted, queue);
+}
+
+// Space complexity: O(n / 16)
 template<class InputIterator, class OutputIterator, class UnaryFunction, class Predicate>
 inline OutputIterator transform_if_impl(InputIterator first,
                                         InputIterator last,
@@ -36,46 +79,13 @@ inline OutputIterator transform_if_impl(InputIterator first,
                                         bool copyIndex,
                                         command_queue &queue)
 {
-    typedef typename std::iterator_traits<OutputIterator>::difference_type difference_type;
-
-    size_t count = detail::iterator_range_size(first, last);
-    if(count == 0){
+    if(first == last){
         return result;
     }
 
-    const context &context = queue.get_context();
-
-    // storage for destination indices
-    ::boost::compute::vector<cl_uint> indices(count, context);
-
-    // write counts
-    ::boost::compute::detail::meta_kernel k1("transform_if_write_counts");
-    k1 << indices.begin()[k1.get_global_id(0)] << " = "
-           << predicate(first[k1.get_global_id(0)]) << " ? 1 : 0;\n";
-    k1.exec_1d(queue, 0, count);
-
-    // scan indices
-    size_t copied_element_count = (indices.cend() - 1).read(queue);
-    ::boost::compute::exclusive_scan(
-        indices.begin(), indices.end(), indices.begin(), queue
-    );
-    copied_element_count += (indices.cend() - 1).read(queue); // last scan element plus last mask element
-
-    // copy values
-    ::boost::compute::detail::meta_kernel k2("transform_if_do_copy");
-    k2 << "if(" << predicate(first[k2.get_global_id(0)]) << ")" <<
-          "    " << result[indices.begin()[k2.get_global_id(0)]] << "=";
-
-    if(copyIndex){
-        k2 << k2.get_global_id(0) << ";\n";
-    }
-    else {
-        k2 << function(first[k2.get_global_id(0)]) << ";\n";
-    }
-
-    k2.exec_1d(queue, 0, count);
-
-    return result + static_cast<difference_type>(copied_element_count);
+    return transform_if_async_impl(
+        first, last, result, function, predicate, copyIndex, queue
+    ).get();
 }
 
 template<class InputIterator, class UnaryFunction, class Predicate>
@@ -98,7 +108,12 @@ inline discard_iterator transform_if_impl(InputIterator first,
 /// Copies each element in the range [\p first, \p last) for which
 /// \p predicate returns \c true to the range beginning at \p result.
 ///
-/// Space complexity: O(2n)
+/// The predicate is evaluated once for each element and \p function once
+/// for each copied element. The input is compacted by three kernels (the
+/// flags of each block of values, a scan of the block counts and the
+/// scatter) and the number of copied elements is read back once.
+///
+/// Space complexity: O(n / 16)
 template<class InputIterator, class OutputIterator, class UnaryFunction, class Predicate>
 inline OutputIterator transform_if(InputIterator first,
                                    InputIterator last,
@@ -112,6 +127,29 @@ inline OutputIterator transform_if(InputIterator first,
     );
 }
 
+/// Copies each element in the range [\p first, \p last) for which
+/// \p predicate returns \c true to the range beginning at \p result. The
+/// elements are copied asynchronously and the number of copied elements is
+/// read back without blocking. Returns a future for the end of the copied
+/// elements.
+///
+/// Space complexity: O(n / 16)
+///
+/// \see transform_if()
+template<class InputIterator, class OutputIterator, class UnaryFunction, class Predicate>
+inline future<OutputIterator>
+transform_if_async(InputIterator first,
+                   InputIterator last,
+                   OutputIterator result,
+                   UnaryFunction function,
+                   Predicate predicate,
+                   command_queue &queue = system::default_queue())
+{
+    return detail::transform_if_async_impl(
+        first, last, result, function, predicate, false, queue
+    );
+}
+
 } // end compute namespace
 } // end boost namespace
 
@@ -16,6 +16,7 @@
 #include <boost/compute/iterator/transform_iterator.hpp>
 #include <boost/compute/iterator/zip_iterator.hpp>
 #include <boost/compute/functional/detail/unpack.hpp>
+#include <boost/compute/detail/command_tracer.hpp>
 #include <boost/compute/detail/iterator_range_size.hpp>
 
 namespace boost {
@@ -45,6 +46,8 @@ inline void transform_reduce(InputIterator first,
                              BinaryReduceFunction reduce_function,
                              command_queue &queue = system::default_queue())
 {
+    detail::trace_scope trace("transform_reduce");
+
     ::boost::compute::reduce(
         ::boost::compute::make_transform_iterator(first, transform_function),
         ::boost::compute::make_transform_iterator(last, transform_function),
@@ -16,6 +16,7 @@
 #include <boost/compute/algorithm/unique_copy.hpp>
 #include <boost/compute/container/vector.hpp>
 #include <boost/compute/functional/operator.hpp>
+#include <boost/compute/detail/command_tracer.hpp>
 
 namespace boost {
 namespace compute {
@@ -31,7 +32,7 @@ namespace compute {
 ///
 /// \return \c InputIterator to the new logical end of the range
 ///
-/// Space complexity: \Omega(4n)
+/// Space complexity: \Omega(n)
 ///
 /// \see unique_copy()
 template<class InputIterator, class BinaryPredicate>
@@ -40,6 +41,8 @@ inline InputIterator unique(InputIterator first,
                             BinaryPredicate op,
                             command_queue &queue = system::default_queue())
 {
+    detail::trace_scope trace("unique");
+
     typedef typename std::iterator_traits<InputIterator>::value_type value_type;
 
     vector<value_type> temp(first, last, queue);
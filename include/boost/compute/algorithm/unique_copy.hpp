@@ -14,12 +14,14 @@
 #include <boost/compute/command_queue.hpp>
 #include <boost/compute/lambda.hpp>
 #include <boost/compute/system.hpp>
-#include <boost/compute/algorithm/copy_if.hpp>
-#include <boost/compute/algorithm/transform.hpp>
-#include <boost/compute/algorithm/gather.hpp>
+#include <boost/compute/algorithm/copy_n.hpp>
+#include <boost/compute/algorithm/detail/stream_compact.hpp>
+#include <boost/compute/async/future.hpp>
 #include <boost/compute/container/vector.hpp>
+#include <boost/compute/container/detail/scalar.hpp>
 #include <boost/compute/detail/iterator_range_size.hpp>
 #include <boost/compute/detail/meta_kernel.hpp>
+#include <boost/compute/functional/identity.hpp>
 #include <boost/compute/functional/operator.hpp>
 
 namespace boost {
@@ -73,6 +75,56 @@ inline OutputIterator serial_unique_copy(InputIterator first,
     return result + unique_count;
 }
 
+// flag function for stream_compact() which keeps the first value and each
+// value which is not equal (determined by op) to the value before it
+template<class InputIterator, class BinaryPredicate>
+struct unique_copy_flag
+{
+    unique_copy_flag(InputIterator first, BinaryPredicate op)
+        : m_first(first),
+          m_op(op)
+    {
+    }
+
+    void operator()(meta_kernel &k, const std::string &index) const
+    {
+        k << index << " == 0 || !("
+          << m_op(m_first[k.var<uint_>(index + " - 1")],
+                  m_first[k.var<uint_>(index)])
+          << ")";
+    }
+
+    InputIterator m_first;
+    BinaryPredicate m_op;
+};
+
+template<class InputIterator, class OutputIterator, class BinaryPredicate>
+inline future<OutputIterator> unique_copy_async(InputIterator first,
+                                                InputIterator last,
+                                                OutputIterator result,
+                                                BinaryPredicate op,
+                                                command_queue &queue)
+{
+    typedef typename std::iterator_traits<InputIterator>::value_type value_type;
+
+    size_t count = detail::iterator_range_size(first, last);
+
+    // copy each unique value (the first value of each run of equal values)
+    scalar<uint_> unique_count(queue.get_context());
+    event compacted = stream_compact(
+        count,
+        result,
+        unique_copy_flag<InputIterator, BinaryPredicate>(first, op),
+        compact_transform_value<InputIterator, identity<value_type> >(
+            first, identity<value_type>()
+        ),
+        unique_count,
+        queue
+    );
+
+    return make_compacted_future(result, unique_count, compacted, queue);
+}
+
 template<class InputIterator, class OutputIterator, class BinaryPredicate>
 inline OutputIterator unique_copy(InputIterator first,
                                   InputIterator last,
@@ -84,33 +136,8 @@ inline OutputIterator unique_copy(InputIterator first,
         return result;
     }
 
-    const context &context = queue.get_context();
-    size_t count = detail::iterator_range_size(first, last);
-
-    // flags marking unique elements
-    vector<uint_> flags(count, context);
-
-    // find each unique element and mark it with a one
-    transform(
-        first, last - 1, first + 1, flags.begin() + 1, not2(op), queue
-    );
-
-    // first element is always unique
-    fill_n(flags.begin(), 1, 1, queue);
-
-    // storage for desination indices
-    vector<uint_> indices(count, context);
-
-    // copy indices for each unique element
-    vector<uint_>::iterator last_index = detail::copy_index_if(
-        flags.begin(), flags.end(), indices.begin(), lambda::_1 == 1, queue
-    );
-
-    // copy unique values from input to output using the computed indices
-    gather(indices.begin(), last_index, first, result, queue);
-
     // return an iterator to the end of the unique output range
-    return result + std::distance(indices.begin(), last_index);
+    return detail::unique_copy_async(first, last, result, op, queue).get();
 }
 
 } // end detail namespace
@@ -127,7 +154,7 @@ inline OutputIterator unique_copy(InputIterator first,
 ///
 /// \return \c OutputIterator to the end of the result range
 ///
-/// Space complexity: \Omega(4n)
+/// Space complexity: \Omega(n / 16)
 ///
 /// \see unique()
 template<class InputIterator, class OutputIterator, class BinaryPredicate>
@@ -160,6 +187,40 @@ inline OutputIterator unique_copy(InputIterator first,
     );
 }
 
+/// Makes a copy of the range [first, last) without the consecutive
+/// duplicate elements (determined by \p op) like unique_copy(). The copy is
+/// performed asynchronously and the returned future holds the end of the
+/// result range once the number of unique elements has been read back.
+///
+/// Space complexity: \Omega(n / 16)
+///
+/// \see unique_copy()
+template<class InputIterator, class OutputIterator, class BinaryPredicate>
+inline future<OutputIterator>
+unique_copy_async(InputIterator first,
+                  InputIterator last,
+                  OutputIterator result,
+                  BinaryPredicate op,
+                  command_queue &queue = system::default_queue())
+{
+    return detail::unique_copy_async(first, last, result, op, queue);
+}
+
+/// \overload
+template<class InputIterator, class OutputIterator>
+inline future<OutputIterator>
+unique_copy_async(InputIterator first,
+                  InputIterator last,
+                  OutputIterator result,
+                  command_queue &queue = system::default_queue())
+{
+    typedef typename std::iterator_traits<InputIterator>::value_type value_type;
+
+    return detail::unique_copy_async(
+        first, last, result, ::boost::compute::equal_to<value_type>(), queue
+    );
+}
+
 } // end compute namespace
 } // end boost namespace
 
@@ -15,6 +15,8 @@
 #include <boost/compute/system.hpp>
 #include <boost/compute/command_queue.hpp>
 #include <boost/compute/algorithm/detail/binary_find.hpp>
+#include <boost/compute/algorithm/detail/vectorized_binary_search.hpp>
+#include <boost/compute/detail/iterator_range_size.hpp>
 
 namespace boost {
 namespace compute {
@@ -39,6 +41,29 @@ upper_bound(InputIterator first,
     return position;
 }
 
+/// Searches the sorted range [\p first, \p last) for each value in the
+/// range [\p needles_first, \p needles_last) and stores the index of the
+/// first element that is greater than the value in \p result.
+///
+/// Space complexity: \Omega(1) for small batches, \Omega(m) otherwise
+///
+/// \see lower_bound()
+template<class InputIterator, class NeedleIterator, class OutputIterator>
+inline OutputIterator
+upper_bound(InputIterator first,
+            InputIterator last,
+            NeedleIterator needles_first,
+            NeedleIterator needles_last,
+            OutputIterator result,
+            command_queue &queue = system::default_queue())
+{
+    detail::vectorized_search(first, last, needles_first, needles_last,
+                              detail::vectorized_upper_bound,
+                              result, result, queue);
+
+    return result + detail::iterator_range_size(needles_first, needles_last);
+}
+
 } // end compute namespace
 } // end boost namespace
 
@@ -16,6 +16,7 @@
 /// Meta-header to include all Boost.Compute allocator headers.
 
 #include <boost/compute/allocator/buffer_allocator.hpp>
+#include <boost/compute/allocator/host_ptr_allocator.hpp>
 #include <boost/compute/allocator/pinned_allocator.hpp>
 
 #endif // BOOST_COMPUTE_ALLOCATOR_HPP
@@ -0,0 +1,178 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://boostorg.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#ifndef BOOST_COMPUTE_ALLOCATOR_HOST_PTR_ALLOCATOR_HPP
+#define BOOST_COMPUTE_ALLOCATOR_HOST_PTR_ALLOCATOR_HPP
+
+#include <cstdlib>
+#include <new>
+
+#include <boost/throw_exception.hpp>
+
+#include <boost/compute/allocator/buffer_allocator.hpp>
+
+namespace boost {
+namespace compute {
+
+/// \class host_ptr_allocator
+/// \brief An allocator which places buffers in page-aligned host memory.
+///
+/// The host_ptr_allocator allocates page-aligned host memory and creates
+/// the buffers with \c CL_MEM_USE_HOST_PTR so that the device uses the
+/// host memory directly. On CPU devices (and other devices which share
+/// memory with the host) this allows data to be moved between the host and
+/// the device without copying it: mapping the buffer returns the host
+/// memory and copy() between the buffer and its host memory only
+/// synchronizes the buffer.
+///
+/// For example, to create a vector which can be filled on the host and
+/// used on a CPU device without any copies:
+/// \code
+/// typedef boost::compute::host_ptr_allocator<float> allocator;
+/// boost::compute::vector<float, allocator> vec(n, context);
+///
+/// float *host = static_cast<float *>(
+///     vec.get_buffer().get_info<void *>(CL_MEM_HOST_PTR)
+/// );
+/// std::fill(host, host + n, 1.0f);
+///
+/// // only synchronizes the buffer with the host memory
+/// boost::compute::copy(host, host + n, vec.begin(), queue);
+/// \endcode
+///
+/// On discrete GPUs the device accesses the host memory over the bus (or
+/// the driver copies it to the device) so the default buffer_allocator is
+/// usually faster.
+///
+/// \see buffer_allocator, pinned_allocator, mapped_view
+template<class T>
+class host_ptr_allocator : public buffer_allocator<T>
+{
+public:
+    typedef typename buffer_allocator<T>::pointer pointer;
+    typedef typename buffer_allocator<T>::size_type size_type;
+
+    explicit host_ptr_allocator(const context &context)
+        : buffer_allocator<T>(context)
+    {
+    }
+
+    host_ptr_allocator(const host_ptr_allocator<T> &other)
+        : buffer_allocator<T>(other)
+    {
+    }
+
+    host_ptr_allocator<T>& operator=(const host_ptr_allocator<T> &other)
+    {
+        if(this != &other){
+            buffer_allocator<T>::operator=(other);
+        }
+
+        return *this;
+    }
+
+    ~host_ptr_allocator()
+    {
+    }
+
+    pointer allocate(size_type n)
+    {
+        // zero-copy buffers must be page-aligned and, on some platforms, a
+        // multiple of the cache line size
+        size_t size = (std::max)(n * sizeof(T), size_t(1));
+        size = (size + cache_line_size - 1) & ~(cache_line_size - 1);
+
+        void *host_ptr = aligned_malloc(size);
+        if(!host_ptr){
+            BOOST_THROW_EXCEPTION(std::bad_alloc());
+        }
+
+        buffer buf;
+        try {
+            buf = buffer(
+                this->get_context(),
+                size,
+                buffer::read_write | buffer::use_host_ptr,
+                host_ptr
+            );
+        }
+        catch(...){
+            aligned_free(host_ptr);
+            throw;
+        }
+
+        #ifdef BOOST_COMPUTE_CL_VERSION_1_1
+        // free the host memory once the buffer is no longer used by any
+        // command (not when it is deallocated)
+        buf.set_destructor_callback(free_host_memory, host_ptr);
+        #endif
+
+        clRetainMemObject(buf.get());
+        return detail::device_ptr<T>(buf);
+    }
+
+    void deallocate(pointer p, size_type n)
+    {
+        BOOST_ASSERT(p.get_buffer().get_context() == this->get_context());
+
+        (void) n;
+
+        #ifndef BOOST_COMPUTE_CL_VERSION_1_1
+        void *host_ptr = p.get_buffer().template get_memory_info<void *>(CL_MEM_HOST_PTR);
+        #endif
+
+        clReleaseMemObject(p.get_buffer().get());
+
+        #ifndef BOOST_COMPUTE_CL_VERSION_1_1
+        aligned_free(host_ptr);
+        #endif
+    }
+
+private:
+    BOOST_STATIC_CONSTANT(size_t, page_size = 4096);
+    BOOST_STATIC_CONSTANT(size_t, cache_line_size = 64);
+
+    // allocates size bytes aligned to page_size. the pointer returned by
+    // malloc() is stored just before the aligned memory.
+    static void* aligned_malloc(size_t size)
+    {
+        void *ptr = std::malloc(size + page_size + sizeof(void *));
+        if(!ptr){
+            return 0;
+        }
+
+        size_t address = reinterpret_cast<size_t>(ptr) + sizeof(void *);
+        address = (address + page_size - 1) & ~(page_size - 1);
+
+        void *aligned = reinterpret_cast<void *>(address);
+        static_cast<void **>(aligned)[-1] = ptr;
+        return aligned;
+    }
+
+    static void aligned_free(void *aligned)
+    {
+        if(aligned){
+            std::free(static_cast<void **>(aligned)[-1]);
+        }
+    }
+
+    #ifdef BOOST_COMPUTE_CL_VERSION_1_1
+    static void BOOST_COMPUTE_CL_CALLBACK
+    free_host_memory(cl_mem, void *host_ptr)
+    {
+        aligned_free(host_ptr);
+    }
+    #endif
+};
+
+} // end compute namespace
+} // end boost namespace
+
+#endif // BOOST_COMPUTE_ALLOCATOR_HOST_PTR_ALLOCATOR_HPP
@@ -15,6 +15,7 @@
 ///
 /// Meta-header to include all Boost.Compute async headers.
 
+#include <boost/compute/async/event_chain.hpp>
 #include <boost/compute/async/future.hpp>
 #include <boost/compute/async/wait_guard.hpp>
 
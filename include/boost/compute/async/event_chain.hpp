@@ -0,0 +1,163 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://boostorg.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#ifndef BOOST_COMPUTE_ASYNC_EVENT_CHAIN_HPP
+#define BOOST_COMPUTE_ASYNC_EVENT_CHAIN_HPP
+
+#include <boost/assert.hpp>
+#include <boost/noncopyable.hpp>
+
+#include <boost/compute/event.hpp>
+#include <boost/compute/command_queue.hpp>
+#include <boost/compute/utility/wait_list.hpp>
+#include <boost/compute/detail/event_chain.hpp>
+
+namespace boost {
+namespace compute {
+
+/// \class event_chain
+/// \brief Orders the commands enqueued by a sequence of operations through
+///        their events.
+///
+/// While an event_chain object is alive, every command enqueued on its
+/// queue by the current thread waits for the previous command in the chain,
+/// and the first command also waits for the events passed to the
+/// constructor. This makes algorithms, which internally enqueue several
+/// dependent commands, safe to use on out-of-order command queues, and lets
+/// independent algorithm calls overlap on devices which support it.
+///
+/// On an in-order command queue, the commands are already executed in order
+/// and only the first command waits for the events passed to the
+/// constructor.
+///
+/// For example, to sort two vectors concurrently on an out-of-order queue and
+/// then merge them:
+/// \code
+/// command_queue queue(context, device, command_queue::enable_out_of_order_execution);
+///
+/// wait_list sorted;
+/// {
+///     event_chain chain(queue);
+///     sort(a.begin(), a.end(), queue);
+///     sorted.insert(chain.last_event());
+/// }
+/// {
+///     event_chain chain(queue);
+///     sort(b.begin(), b.end(), queue);
+///     sorted.insert(chain.last_event());
+/// }
+/// {
+///     event_chain chain(queue, sorted);
+///     merge(a.begin(), a.end(), b.begin(), b.end(), c.begin(), queue);
+///     chain.last_event().wait();
+/// }
+/// \endcode
+///
+/// Chains may be nested. Commands in a nested chain on the same queue are
+/// ordered after the previous command of the enclosing chain and the
+/// enclosing chain continues after the last command of the nested chain.
+///
+/// \see wait_list, command_queue
+class event_chain : boost::noncopyable
+{
+public:
+    /// Creates a new event chain for commands enqueued on \p queue. The first
+    /// command enqueued in the chain waits for \p events.
+    explicit event_chain(command_queue &queue,
+                         const wait_list &events = wait_list())
+        : m_queue(queue),
+          m_state(
+              queue.get(),
+              (queue.get_properties() & CL_QUEUE_OUT_OF_ORDER_EXEC_MODE_ENABLE) != 0
+          )
+    {
+        m_state.pending = events;
+
+        // continue from the enclosing chain on the same queue
+        detail::event_chain_state *parent = detail::current_event_chain();
+        if(parent && parent->queue == m_state.queue){
+            for(size_t i = 0; i < parent->pending.size(); i++){
+                m_state.pending.insert(parent->pending[i]);
+            }
+            if(parent->last.get()){
+                m_state.pending.insert(parent->last);
+            }
+        }
+
+        m_state.parent = parent;
+        detail::thread_hook<detail::event_chain_state>::install(&m_state);
+    }
+
+    /// Destroys the event chain.
+    ~event_chain()
+    {
+        BOOST_ASSERT(detail::current_event_chain() == &m_state);
+
+        detail::event_chain_state *parent = m_state.parent;
+        if(parent && parent->queue == m_state.queue && m_state.last.get()){
+            parent->last = m_state.last;
+            parent->pending.clear();
+        }
+
+        detail::thread_hook<detail::event_chain_state>::install(parent);
+    }
+
+    /// Returns the command queue for the chain.
+    const command_queue& get_queue() const
+    {
+        return m_queue;
+    }
+
+    /// Returns \c true if no commands have been enqueued in the chain.
+    bool empty() const
+    {
+        return m_state.last.get() == 0;
+    }
+
+    /// Returns an event which completes once all of the commands enqueued in
+    /// the chain so far have completed.
+    ///
+    /// If no commands have been enqueued, a marker which waits for the
+    /// events passed to the constructor is enqueued and its event returned.
+    event last_event()
+    {
+        if(!m_state.last.get()){
+            #ifdef BOOST_COMPUTE_CL_VERSION_1_2
+            // the marker is part of the chain and waits for the pending events
+            m_queue.enqueue_marker(wait_list());
+            #else
+            m_state.last = m_queue.enqueue_marker();
+            #endif
+        }
+
+        return m_state.last;
+    }
+
+    /// Blocks until all of the commands enqueued in the chain so far have
+    /// completed.
+    void wait()
+    {
+        if(m_state.last.get()){
+            m_state.last.wait();
+        }
+        else {
+            m_state.pending.wait();
+        }
+    }
+
+private:
+    command_queue m_queue;
+    detail::event_chain_state m_state;
+};
+
+} // end compute namespace
+} // end boost namespace
+
+#endif // BOOST_COMPUTE_ASYNC_EVENT_CHAIN_HPP
@@ -11,6 +11,8 @@
 #ifndef BOOST_COMPUTE_ASYNC_FUTURE_HPP
 #define BOOST_COMPUTE_ASYNC_FUTURE_HPP
 
+#include <boost/function.hpp>
+
 #include <boost/compute/event.hpp>
 
 namespace boost {
@@ -35,9 +37,21 @@ public:
     {
     }
 
+    /// \internal_
+    ///
+    /// Creates a future whose result is computed on the host by \p result
+    /// once \p event has completed (e.g. from a value read back by a
+    /// non-blocking read).
+    future(const event &event, const boost::function<T()> &result)
+        : m_event(event),
+          m_deferred(result)
+    {
+    }
+
     future(const future<T> &other)
         : m_result(other.m_result),
-          m_event(other.m_event)
+          m_event(other.m_event),
+          m_deferred(other.m_deferred)
     {
     }
 
@@ -46,6 +60,7 @@ public:
         if(this != &other){
             m_result = other.m_result;
             m_event = other.m_event;
+            m_deferred = other.m_deferred;
         }
 
         return *this;
@@ -61,6 +76,11 @@ public:
     {
         wait();
 
+        if(m_deferred){
+            m_result = m_deferred();
+            m_deferred.clear();
+        }
+
         return m_result;
     }
 
@@ -85,6 +105,7 @@ public:
 private:
     T m_result;
     event m_event;
+    boost::function<T()> m_deferred;
 };
 
 /// \internal_
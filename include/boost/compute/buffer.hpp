@@ -15,6 +15,7 @@
 #include <boost/compute/context.hpp>
 #include <boost/compute/exception.hpp>
 #include <boost/compute/memory_object.hpp>
+#include <boost/compute/detail/command_tracer.hpp>
 #include <boost/compute/detail/get_object_info.hpp>
 
 namespace boost {
@@ -85,6 +86,10 @@ public:
         if(!m_mem){
             BOOST_THROW_EXCEPTION(opencl_error(error));
         }
+
+        if(detail::command_tracer *tracer = detail::current_command_tracer()){
+            tracer->trace_allocation(size);
+        }
     }
 
     /// Creates a new buffer object as a copy of \p other.
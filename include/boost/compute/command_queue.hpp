@@ -30,7 +30,10 @@
 #include <boost/compute/utility/wait_list.hpp>
 #include <boost/compute/detail/get_object_info.hpp>
 #include <boost/compute/detail/assert_cl_success.hpp>
+#include <boost/compute/detail/command_recorder.hpp>
+#include <boost/compute/detail/command_tracer.hpp>
 #include <boost/compute/detail/diagnostic.hpp>
+#include <boost/compute/detail/event_chain.hpp>
 #include <boost/compute/utility/extents.hpp>
 
 namespace boost {
@@ -306,6 +309,7 @@ public:
         BOOST_ASSERT(host_ptr != 0);
 
         event event_;
+        detail::chained_wait_list chained_events(m_queue, events);
 
         cl_int ret = clEnqueueReadBuffer(
             m_queue,
@@ -314,8 +318,8 @@ public:
             offset,
             size,
             host_ptr,
-            events.size(),
-            events.get_event_ptr(),
+            chained_events.size(),
+            chained_events.get_event_ptr(),
             &event_.get()
         );
 
@@ -323,6 +327,14 @@ public:
             BOOST_THROW_EXCEPTION(opencl_error(ret));
         }
 
+        chained_events.enqueued(event_);
+
+        if(detail::command_recorder *recorder = detail::current_command_recorder()){
+            recorder->record_read_buffer(m_queue, buffer.get(), offset, size, host_ptr);
+        }
+
+        trace_transfer(detail::trace_record::read, size, event_);
+
         return event_;
     }
 
@@ -344,6 +356,7 @@ public:
         BOOST_ASSERT(host_ptr != 0);
 
         event event_;
+        detail::chained_wait_list chained_events(m_queue, events);
 
         cl_int ret = clEnqueueReadBuffer(
             m_queue,
@@ -352,8 +365,8 @@ public:
             offset,
             size,
             host_ptr,
-            events.size(),
-            events.get_event_ptr(),
+            chained_events.size(),
+            chained_events.get_event_ptr(),
             &event_.get()
         );
 
@@ -361,6 +374,14 @@ public:
             BOOST_THROW_EXCEPTION(opencl_error(ret));
         }
 
+        chained_events.enqueued(event_);
+
+        if(detail::command_recorder *recorder = detail::current_command_recorder()){
+            recorder->record_read_buffer(m_queue, buffer.get(), offset, size, host_ptr);
+        }
+
+        trace_transfer(detail::trace_record::read, size, event_);
+
         return event_;
     }
 
@@ -387,6 +408,7 @@ public:
         BOOST_ASSERT(host_ptr != 0);
 
         event event_;
+        detail::chained_wait_list chained_events(m_queue, events);
 
         cl_int ret = clEnqueueReadBufferRect(
             m_queue,
@@ -400,8 +422,8 @@ public:
             host_row_pitch,
             host_slice_pitch,
             host_ptr,
-            events.size(),
-            events.get_event_ptr(),
+            chained_events.size(),
+            chained_events.get_event_ptr(),
             &event_.get()
         );
 
@@ -409,6 +431,10 @@ public:
             BOOST_THROW_EXCEPTION(opencl_error(ret));
         }
 
+        chained_events.enqueued(event_);
+
+        record_unsupported_command();
+
         return event_;
     }
 
@@ -434,6 +460,7 @@ public:
         BOOST_ASSERT(host_ptr != 0);
 
         event event_;
+        detail::chained_wait_list chained_events(m_queue, events);
 
         cl_int ret = clEnqueueReadBufferRect(
             m_queue,
@@ -447,8 +474,8 @@ public:
             host_row_pitch,
             host_slice_pitch,
             host_ptr,
-            events.size(),
-            events.get_event_ptr(),
+            chained_events.size(),
+            chained_events.get_event_ptr(),
             &event_.get()
         );
 
@@ -456,6 +483,10 @@ public:
             BOOST_THROW_EXCEPTION(opencl_error(ret));
         }
 
+        chained_events.enqueued(event_);
+
+        record_unsupported_command();
+
         return event_;
     }
     #endif // BOOST_COMPUTE_CL_VERSION_1_1
@@ -477,6 +508,7 @@ public:
         BOOST_ASSERT(host_ptr != 0);
 
         event event_;
+        detail::chained_wait_list chained_events(m_queue, events);
 
         cl_int ret = clEnqueueWriteBuffer(
             m_queue,
@@ -485,8 +517,8 @@ public:
             offset,
             size,
             host_ptr,
-            events.size(),
-            events.get_event_ptr(),
+            chained_events.size(),
+            chained_events.get_event_ptr(),
             &event_.get()
         );
 
@@ -494,6 +526,14 @@ public:
             BOOST_THROW_EXCEPTION(opencl_error(ret));
         }
 
+        chained_events.enqueued(event_);
+
+        if(detail::command_recorder *recorder = detail::current_command_recorder()){
+            recorder->record_write_buffer(m_queue, buffer.get(), offset, size, host_ptr);
+        }
+
+        trace_transfer(detail::trace_record::write, size, event_);
+
         return event_;
     }
 
@@ -515,6 +555,7 @@ public:
         BOOST_ASSERT(host_ptr != 0);
 
         event event_;
+        detail::chained_wait_list chained_events(m_queue, events);
 
         cl_int ret = clEnqueueWriteBuffer(
             m_queue,
@@ -523,8 +564,8 @@ public:
             offset,
             size,
             host_ptr,
-            events.size(),
-            events.get_event_ptr(),
+            chained_events.size(),
+            chained_events.get_event_ptr(),
             &event_.get()
         );
 
@@ -532,6 +573,14 @@ public:
             BOOST_THROW_EXCEPTION(opencl_error(ret));
         }
 
+        chained_events.enqueued(event_);
+
+        if(detail::command_recorder *recorder = detail::current_command_recorder()){
+            recorder->record_write_buffer(m_queue, buffer.get(), offset, size, host_ptr);
+        }
+
+        trace_transfer(detail::trace_record::write, size, event_);
+
         return event_;
     }
 
@@ -558,6 +607,7 @@ public:
         BOOST_ASSERT(host_ptr != 0);
 
         event event_;
+        detail::chained_wait_list chained_events(m_queue, events);
 
         cl_int ret = clEnqueueWriteBufferRect(
             m_queue,
@@ -571,8 +621,8 @@ public:
             host_row_pitch,
             host_slice_pitch,
             host_ptr,
-            events.size(),
-            events.get_event_ptr(),
+            chained_events.size(),
+            chained_events.get_event_ptr(),
             &event_.get()
         );
 
@@ -580,6 +630,10 @@ public:
             BOOST_THROW_EXCEPTION(opencl_error(ret));
         }
 
+        chained_events.enqueued(event_);
+
+        record_unsupported_command();
+
         return event_;
     }
 
@@ -605,6 +659,7 @@ public:
         BOOST_ASSERT(host_ptr != 0);
 
         event event_;
+        detail::chained_wait_list chained_events(m_queue, events);
 
         cl_int ret = clEnqueueWriteBufferRect(
             m_queue,
@@ -618,8 +673,8 @@ public:
             host_row_pitch,
             host_slice_pitch,
             host_ptr,
-            events.size(),
-            events.get_event_ptr(),
+            chained_events.size(),
+            chained_events.get_event_ptr(),
             &event_.get()
         );
 
@@ -627,6 +682,10 @@ public:
             BOOST_THROW_EXCEPTION(opencl_error(ret));
         }
 
+        chained_events.enqueued(event_);
+
+        record_unsupported_command();
+
         return event_;
     }
     #endif // BOOST_COMPUTE_CL_VERSION_1_1
@@ -651,6 +710,7 @@ public:
         BOOST_ASSERT(dst_buffer.get_context() == this->get_context());
 
         event event_;
+        detail::chained_wait_list chained_events(m_queue, events);
 
         cl_int ret = clEnqueueCopyBuffer(
             m_queue,
@@ -659,8 +719,8 @@ public:
             src_offset,
             dst_offset,
             size,
-            events.size(),
-            events.get_event_ptr(),
+            chained_events.size(),
+            chained_events.get_event_ptr(),
             &event_.get()
         );
 
@@ -668,6 +728,16 @@ public:
             BOOST_THROW_EXCEPTION(opencl_error(ret));
         }
 
+        chained_events.enqueued(event_);
+
+        if(detail::command_recorder *recorder = detail::current_command_recorder()){
+            recorder->record_copy_buffer(
+                m_queue, src_buffer.get(), dst_buffer.get(), src_offset, dst_offset, size
+            );
+        }
+
+        trace_transfer(detail::trace_record::copy, size, event_);
+
         return event_;
     }
 
@@ -694,6 +764,7 @@ public:
         BOOST_ASSERT(dst_buffer.get_context() == this->get_context());
 
         event event_;
+        detail::chained_wait_list chained_events(m_queue, events);
 
         cl_int ret = clEnqueueCopyBufferRect(
             m_queue,
@@ -706,8 +777,8 @@ public:
             buffer_slice_pitch,
             host_row_pitch,
             host_slice_pitch,
-            events.size(),
-            events.get_event_ptr(),
+            chained_events.size(),
+            chained_events.get_event_ptr(),
             &event_.get()
         );
 
@@ -715,6 +786,10 @@ public:
             BOOST_THROW_EXCEPTION(opencl_error(ret));
         }
 
+        chained_events.enqueued(event_);
+
+        record_unsupported_command();
+
         return event_;
     }
     #endif // BOOST_COMPUTE_CL_VERSION_1_1
@@ -739,6 +814,7 @@ public:
         BOOST_ASSERT(buffer.get_context() == this->get_context());
 
         event event_;
+        detail::chained_wait_list chained_events(m_queue, events);
 
         cl_int ret = clEnqueueFillBuffer(
             m_queue,
@@ -747,8 +823,8 @@ public:
             pattern_size,
             offset,
             size,
-            events.size(),
-            events.get_event_ptr(),
+            chained_events.size(),
+            chained_events.get_event_ptr(),
             &event_.get()
         );
 
@@ -756,6 +832,16 @@ public:
             BOOST_THROW_EXCEPTION(opencl_error(ret));
         }
 
+        chained_events.enqueued(event_);
+
+        if(detail::command_recorder *recorder = detail::current_command_recorder()){
+            recorder->record_fill_buffer(
+                m_queue, buffer.get(), pattern, pattern_size, offset, size
+            );
+        }
+
+        trace_transfer(detail::trace_record::fill, size, event_);
+
         return event_;
     }
     #endif // BOOST_COMPUTE_CL_VERSION_1_2
@@ -776,6 +862,8 @@ public:
         BOOST_ASSERT(offset + size <= buffer.size());
         BOOST_ASSERT(buffer.get_context() == this->get_context());
 
+        detail::chained_wait_list chained_events(m_queue, events);
+
         cl_int ret = 0;
         void *pointer = clEnqueueMapBuffer(
             m_queue,
@@ -784,8 +872,8 @@ public:
             flags,
             offset,
             size,
-            events.size(),
-            events.get_event_ptr(),
+            chained_events.size(),
+            chained_events.get_event_ptr(),
             &map_buffer_event.get(),
             &ret
         );
@@ -794,6 +882,11 @@ public:
             BOOST_THROW_EXCEPTION(opencl_error(ret));
         }
 
+        chained_events.enqueued(map_buffer_event);
+
+        record_unsupported_command();
+        trace_transfer(detail::trace_record::map, size, map_buffer_event);
+
         return pointer;
     }
 
@@ -827,6 +920,8 @@ public:
         BOOST_ASSERT(offset + size <= buffer.size());
         BOOST_ASSERT(buffer.get_context() == this->get_context());
 
+        detail::chained_wait_list chained_events(m_queue, events);
+
         cl_int ret = 0;
         void *pointer = clEnqueueMapBuffer(
             m_queue,
@@ -835,8 +930,8 @@ public:
             flags,
             offset,
             size,
-            events.size(),
-            events.get_event_ptr(),
+            chained_events.size(),
+            chained_events.get_event_ptr(),
             &map_buffer_event.get(),
             &ret
         );
@@ -845,6 +940,11 @@ public:
             BOOST_THROW_EXCEPTION(opencl_error(ret));
         }
 
+        chained_events.enqueued(map_buffer_event);
+
+        record_unsupported_command();
+        trace_transfer(detail::trace_record::map, size, map_buffer_event);
+
         return pointer;
     }
 
@@ -870,13 +970,14 @@ public:
         BOOST_ASSERT(m_queue != 0);
 
         event event_;
+        detail::chained_wait_list chained_events(m_queue, events);
 
         cl_int ret = clEnqueueUnmapMemObject(
             m_queue,
             mem,
             mapped_ptr,
-            events.size(),
-            events.get_event_ptr(),
+            chained_events.size(),
+            chained_events.get_event_ptr(),
             &event_.get()
         );
 
@@ -884,6 +985,10 @@ public:
             BOOST_THROW_EXCEPTION(opencl_error(ret));
         }
 
+        chained_events.enqueued(event_);
+
+        record_unsupported_command();
+
         return event_;
     }
 
@@ -901,6 +1006,7 @@ public:
         BOOST_ASSERT(m_queue != 0);
 
         event event_;
+        detail::chained_wait_list chained_events(m_queue, events);
 
         cl_int ret = clEnqueueReadImage(
             m_queue,
@@ -911,8 +1017,8 @@ public:
             row_pitch,
             slice_pitch,
             host_ptr,
-            events.size(),
-            events.get_event_ptr(),
+            chained_events.size(),
+            chained_events.get_event_ptr(),
             &event_.get()
         );
 
@@ -920,6 +1026,10 @@ public:
             BOOST_THROW_EXCEPTION(opencl_error(ret));
         }
 
+        chained_events.enqueued(event_);
+
+        record_unsupported_command();
+
         return event_;
     }
 
@@ -960,6 +1070,7 @@ public:
         BOOST_ASSERT(m_queue != 0);
 
         event event_;
+        detail::chained_wait_list chained_events(m_queue, events);
 
         cl_int ret = clEnqueueWriteImage(
             m_queue,
@@ -970,8 +1081,8 @@ public:
             input_row_pitch,
             input_slice_pitch,
             host_ptr,
-            events.size(),
-            events.get_event_ptr(),
+            chained_events.size(),
+            chained_events.get_event_ptr(),
             &event_.get()
         );
 
@@ -979,6 +1090,10 @@ public:
             BOOST_THROW_EXCEPTION(opencl_error(ret));
         }
 
+        chained_events.enqueued(event_);
+
+        record_unsupported_command();
+
         return event_;
     }
 
@@ -1023,6 +1138,8 @@ public:
         BOOST_ASSERT(m_queue != 0);
         BOOST_ASSERT(image.get_context() == this->get_context());
 
+        detail::chained_wait_list chained_events(m_queue, events);
+
         cl_int ret = 0;
         void *pointer = clEnqueueMapImage(
             m_queue,
@@ -1033,8 +1150,8 @@ public:
             region,
             &output_row_pitch,
             &output_slice_pitch,
-            events.size(),
-            events.get_event_ptr(),
+            chained_events.size(),
+            chained_events.get_event_ptr(),
             &map_image_event.get(),
             &ret
         );
@@ -1043,6 +1160,10 @@ public:
             BOOST_THROW_EXCEPTION(opencl_error(ret));
         }
 
+        chained_events.enqueued(map_image_event);
+
+        record_unsupported_command();
+
         return pointer;
     }
 
@@ -1124,6 +1245,8 @@ public:
         BOOST_ASSERT(m_queue != 0);
         BOOST_ASSERT(image.get_context() == this->get_context());
 
+        detail::chained_wait_list chained_events(m_queue, events);
+
         cl_int ret = 0;
         void *pointer = clEnqueueMapImage(
             m_queue,
@@ -1134,8 +1257,8 @@ public:
             region,
             &output_row_pitch,
             &output_slice_pitch,
-            events.size(),
-            events.get_event_ptr(),
+            chained_events.size(),
+            chained_events.get_event_ptr(),
             &map_image_event.get(),
             &ret
         );
@@ -1144,6 +1267,10 @@ public:
             BOOST_THROW_EXCEPTION(opencl_error(ret));
         }
 
+        chained_events.enqueued(map_image_event);
+
+        record_unsupported_command();
+
         return pointer;
     }
 
@@ -1197,6 +1324,7 @@ public:
         BOOST_ASSERT(m_queue != 0);
 
         event event_;
+        detail::chained_wait_list chained_events(m_queue, events);
 
         cl_int ret = clEnqueueCopyImage(
             m_queue,
@@ -1205,8 +1333,8 @@ public:
             src_origin,
             dst_origin,
             region,
-            events.size(),
-            events.get_event_ptr(),
+            chained_events.size(),
+            chained_events.get_event_ptr(),
             &event_.get()
         );
 
@@ -1214,6 +1342,10 @@ public:
             BOOST_THROW_EXCEPTION(opencl_error(ret));
         }
 
+        chained_events.enqueued(event_);
+
+        record_unsupported_command();
+
         return event_;
     }
 
@@ -1257,6 +1389,7 @@ public:
         BOOST_ASSERT(m_queue != 0);
 
         event event_;
+        detail::chained_wait_list chained_events(m_queue, events);
 
         cl_int ret = clEnqueueCopyImageToBuffer(
             m_queue,
@@ -1265,8 +1398,8 @@ public:
             src_origin,
             region,
             dst_offset,
-            events.size(),
-            events.get_event_ptr(),
+            chained_events.size(),
+            chained_events.get_event_ptr(),
             &event_.get()
         );
 
@@ -1274,6 +1407,10 @@ public:
             BOOST_THROW_EXCEPTION(opencl_error(ret));
         }
 
+        chained_events.enqueued(event_);
+
+        record_unsupported_command();
+
         return event_;
     }
 
@@ -1290,6 +1427,7 @@ public:
         BOOST_ASSERT(m_queue != 0);
 
         event event_;
+        detail::chained_wait_list chained_events(m_queue, events);
 
         cl_int ret = clEnqueueCopyBufferToImage(
             m_queue,
@@ -1298,8 +1436,8 @@ public:
             src_offset,
             dst_origin,
             region,
-            events.size(),
-            events.get_event_ptr(),
+            chained_events.size(),
+            chained_events.get_event_ptr(),
             &event_.get()
         );
 
@@ -1307,6 +1445,10 @@ public:
             BOOST_THROW_EXCEPTION(opencl_error(ret));
         }
 
+        chained_events.enqueued(event_);
+
+        record_unsupported_command();
+
         return event_;
     }
 
@@ -1325,6 +1467,7 @@ public:
         BOOST_ASSERT(m_queue != 0);
 
         event event_;
+        detail::chained_wait_list chained_events(m_queue, events);
 
         cl_int ret = clEnqueueFillImage(
             m_queue,
@@ -1332,8 +1475,8 @@ public:
             fill_color,
             origin,
             region,
-            events.size(),
-            events.get_event_ptr(),
+            chained_events.size(),
+            chained_events.get_event_ptr(),
             &event_.get()
         );
 
@@ -1341,6 +1484,10 @@ public:
             BOOST_THROW_EXCEPTION(opencl_error(ret));
         }
 
+        chained_events.enqueued(event_);
+
+        record_unsupported_command();
+
         return event_;
     }
 
@@ -1378,14 +1525,15 @@ public:
         BOOST_ASSERT(m_queue != 0);
 
         event event_;
+        detail::chained_wait_list chained_events(m_queue, events);
 
         cl_int ret = clEnqueueMigrateMemObjects(
             m_queue,
             num_mem_objects,
             mem_objects,
             flags,
-            events.size(),
-            events.get_event_ptr(),
+            chained_events.size(),
+            chained_events.get_event_ptr(),
             &event_.get()
         );
 
@@ -1393,6 +1541,8 @@ public:
             BOOST_THROW_EXCEPTION(opencl_error(ret));
         }
 
+        chained_events.enqueued(event_);
+
         return event_;
     }
     #endif // BOOST_COMPUTE_CL_VERSION_1_2
@@ -1411,6 +1561,7 @@ public:
         BOOST_ASSERT(kernel.get_context() == this->get_context());
 
         event event_;
+        detail::chained_wait_list chained_events(m_queue, events);
 
         cl_int ret = clEnqueueNDRangeKernel(
             m_queue,
@@ -1419,8 +1570,8 @@ public:
             global_work_offset,
             global_work_size,
             local_work_size,
-            events.size(),
-            events.get_event_ptr(),
+            chained_events.size(),
+            chained_events.get_event_ptr(),
             &event_.get()
         );
 
@@ -1428,6 +1579,30 @@ public:
             BOOST_THROW_EXCEPTION(opencl_error(ret));
         }
 
+        chained_events.enqueued(event_);
+
+        if(detail::command_recorder *recorder = detail::current_command_recorder()){
+            recorder->record_nd_range_kernel(
+                m_queue,
+                kernel,
+                work_dim,
+                global_work_offset,
+                global_work_size,
+                local_work_size
+            );
+        }
+
+        if(detail::command_tracer *tracer = detail::current_command_tracer()){
+            tracer->trace_kernel(
+                m_queue,
+                kernel.name(),
+                work_dim,
+                global_work_size,
+                local_work_size,
+                event_.get()
+            );
+        }
+
         return event_;
     }
 
@@ -1476,6 +1651,7 @@ public:
         BOOST_ASSERT(kernel.get_context() == this->get_context());
 
         event event_;
+        detail::chained_wait_list chained_events(m_queue, events);
 
         // clEnqueueTask() was deprecated in OpenCL 2.0. In that case we
         // just forward to the equivalent clEnqueueNDRangeKernel() call.
@@ -1483,11 +1659,11 @@ public:
         size_t one = 1;
         cl_int ret = clEnqueueNDRangeKernel(
             m_queue, kernel, 1, 0, &one, &one,
-            events.size(), events.get_event_ptr(), &event_.get()
+            chained_events.size(), chained_events.get_event_ptr(), &event_.get()
         );
         #else
         cl_int ret = clEnqueueTask(
-            m_queue, kernel, events.size(), events.get_event_ptr(), &event_.get()
+            m_queue, kernel, chained_events.size(), chained_events.get_event_ptr(), &event_.get()
         );
         #endif
 
@@ -1495,6 +1671,18 @@ public:
             BOOST_THROW_EXCEPTION(opencl_error(ret));
         }
 
+        chained_events.enqueued(event_);
+
+        if(detail::command_recorder *recorder = detail::current_command_recorder()){
+            size_t one = 1;
+            recorder->record_nd_range_kernel(m_queue, kernel, 1, 0, &one, &one);
+        }
+
+        if(detail::command_tracer *tracer = detail::current_command_tracer()){
+            size_t one = 1;
+            tracer->trace_kernel(m_queue, kernel.name(), 1, &one, &one, event_.get());
+        }
+
         return event_;
     }
 
@@ -1510,6 +1698,7 @@ public:
         BOOST_ASSERT(m_queue != 0);
 
         event event_;
+        detail::chained_wait_list chained_events(m_queue, events);
         cl_int ret = clEnqueueNativeKernel(
             m_queue,
             user_func,
@@ -1518,14 +1707,18 @@ public:
             num_mem_objects,
             mem_list,
             args_mem_loc,
-            events.size(),
-            events.get_event_ptr(),
+            chained_events.size(),
+            chained_events.get_event_ptr(),
             &event_.get()
         );
         if(ret != CL_SUCCESS){
             BOOST_THROW_EXCEPTION(opencl_error(ret));
         }
 
+        chained_events.enqueued(event_);
+
+        record_unsupported_command();
+
         return event_;
     }
 
@@ -1603,16 +1796,19 @@ public:
         BOOST_ASSERT(m_queue != 0);
 
         event event_;
+        detail::chained_wait_list chained_events(m_queue, events);
         cl_int ret = CL_SUCCESS;
 
         ret = clEnqueueBarrierWithWaitList(
-            m_queue, events.size(), events.get_event_ptr(), &event_.get()
+            m_queue, chained_events.size(), chained_events.get_event_ptr(), &event_.get()
         );
 
         if(ret != CL_SUCCESS){
             BOOST_THROW_EXCEPTION(opencl_error(ret));
         }
 
+        chained_events.enqueued(event_);
+
         return event_;
     }
     #endif // BOOST_COMPUTE_CL_VERSION_1_2
@@ -1651,15 +1847,18 @@ public:
     event enqueue_marker(const wait_list &events)
     {
         event event_;
+        detail::chained_wait_list chained_events(m_queue, events);
 
         cl_int ret = clEnqueueMarkerWithWaitList(
-            m_queue, events.size(), events.get_event_ptr(), &event_.get()
+            m_queue, chained_events.size(), chained_events.get_event_ptr(), &event_.get()
         );
 
         if(ret != CL_SUCCESS){
             BOOST_THROW_EXCEPTION(opencl_error(ret));
         }
 
+        chained_events.enqueued(event_);
+
         return event_;
     }
     #endif // BOOST_COMPUTE_CL_VERSION_1_2
@@ -1677,6 +1876,7 @@ public:
                              const wait_list &events = wait_list())
     {
         event event_;
+        detail::chained_wait_list chained_events(m_queue, events);
 
         cl_int ret = clEnqueueSVMMemcpy(
             m_queue,
@@ -1684,8 +1884,8 @@ public:
             dst_ptr,
             src_ptr,
             size,
-            events.size(),
-            events.get_event_ptr(),
+            chained_events.size(),
+            chained_events.get_event_ptr(),
             &event_.get()
         );
 
@@ -1693,6 +1893,10 @@ public:
             BOOST_THROW_EXCEPTION(opencl_error(ret));
         }
 
+        chained_events.enqueued(event_);
+
+        record_unsupported_command();
+
         return event_;
     }
 
@@ -1708,6 +1912,7 @@ public:
                                    const wait_list &events = wait_list())
     {
         event event_;
+        detail::chained_wait_list chained_events(m_queue, events);
 
         cl_int ret = clEnqueueSVMMemcpy(
             m_queue,
@@ -1715,8 +1920,8 @@ public:
             dst_ptr,
             src_ptr,
             size,
-            events.size(),
-            events.get_event_ptr(),
+            chained_events.size(),
+            chained_events.get_event_ptr(),
             &event_.get()
         );
 
@@ -1724,6 +1929,10 @@ public:
             BOOST_THROW_EXCEPTION(opencl_error(ret));
         }
 
+        chained_events.enqueued(event_);
+
+        record_unsupported_command();
+
         return event_;
     }
 
@@ -1741,6 +1950,7 @@ public:
 
     {
         event event_;
+        detail::chained_wait_list chained_events(m_queue, events);
 
         cl_int ret = clEnqueueSVMMemFill(
             m_queue,
@@ -1748,8 +1958,8 @@ public:
             pattern,
             pattern_size,
             size,
-            events.size(),
-            events.get_event_ptr(),
+            chained_events.size(),
+            chained_events.get_event_ptr(),
             &event_.get()
         );
 
@@ -1757,6 +1967,10 @@ public:
             BOOST_THROW_EXCEPTION(opencl_error(ret));
         }
 
+        chained_events.enqueued(event_);
+
+        record_unsupported_command();
+
         return event_;
     }
 
@@ -1771,6 +1985,7 @@ public:
                            const wait_list &events = wait_list())
     {
         event event_;
+        detail::chained_wait_list chained_events(m_queue, events);
 
         cl_int ret = clEnqueueSVMFree(
             m_queue,
@@ -1778,8 +1993,8 @@ public:
             &svm_ptr,
             0,
             0,
-            events.size(),
-            events.get_event_ptr(),
+            chained_events.size(),
+            chained_events.get_event_ptr(),
             &event_.get()
         );
 
@@ -1787,6 +2002,10 @@ public:
             BOOST_THROW_EXCEPTION(opencl_error(ret));
         }
 
+        chained_events.enqueued(event_);
+
+        record_unsupported_command();
+
         return event_;
     }
 
@@ -1801,6 +2020,7 @@ public:
                           const wait_list &events = wait_list())
     {
         event event_;
+        detail::chained_wait_list chained_events(m_queue, events);
 
         cl_int ret = clEnqueueSVMMap(
             m_queue,
@@ -1808,8 +2028,8 @@ public:
             flags,
             svm_ptr,
             size,
-            events.size(),
-            events.get_event_ptr(),
+            chained_events.size(),
+            chained_events.get_event_ptr(),
             &event_.get()
         );
 
@@ -1817,6 +2037,10 @@ public:
             BOOST_THROW_EXCEPTION(opencl_error(ret));
         }
 
+        chained_events.enqueued(event_);
+
+        record_unsupported_command();
+
         return event_;
     }
 
@@ -1829,12 +2053,13 @@ public:
                             const wait_list &events = wait_list())
     {
         event event_;
+        detail::chained_wait_list chained_events(m_queue, events);
 
         cl_int ret = clEnqueueSVMUnmap(
             m_queue,
             svm_ptr,
-            events.size(),
-            events.get_event_ptr(),
+            chained_events.size(),
+            chained_events.get_event_ptr(),
             &event_.get()
         );
 
@@ -1842,6 +2067,10 @@ public:
             BOOST_THROW_EXCEPTION(opencl_error(ret));
         }
 
+        chained_events.enqueued(event_);
+
+        record_unsupported_command();
+
         return event_;
     }
     #endif // BOOST_COMPUTE_CL_VERSION_2_0
@@ -1865,6 +2094,7 @@ public:
     {
         BOOST_ASSERT(svm_ptrs.size() == sizes.size() || sizes.size() == 0);
         event event_;
+        detail::chained_wait_list chained_events(m_queue, events);
 
         cl_int ret = clEnqueueSVMMigrateMem(
             m_queue,
@@ -1872,8 +2102,8 @@ public:
             const_cast<void const **>(&svm_ptrs[0]),
             sizes.size() > 0 ? &sizes[0] : NULL,
             flags,
-            events.size(),
-            events.get_event_ptr(),
+            chained_events.size(),
+            chained_events.get_event_ptr(),
             &event_.get()
         );
 
@@ -1881,6 +2111,8 @@ public:
             BOOST_THROW_EXCEPTION(opencl_error(ret));
         }
 
+        chained_events.enqueued(event_);
+
         return event_;
     }
 
@@ -1900,6 +2132,7 @@ public:
                                      const wait_list &events = wait_list())
     {
         event event_;
+        detail::chained_wait_list chained_events(m_queue, events);
 
         cl_int ret = clEnqueueSVMMigrateMem(
             m_queue,
@@ -1907,8 +2140,8 @@ public:
             &svm_ptr,
             &size,
             flags,
-            events.size(),
-            events.get_event_ptr(),
+            chained_events.size(),
+            chained_events.get_event_ptr(),
             &event_.get()
         );
 
@@ -1916,6 +2149,8 @@ public:
             BOOST_THROW_EXCEPTION(opencl_error(ret));
         }
 
+        chained_events.enqueued(event_);
+
         return event_;
     }
     #endif // BOOST_COMPUTE_CL_VERSION_2_1
@@ -1944,6 +2179,25 @@ public:
         return get_device().check_version(major, minor);
     }
 
+private:
+    /// \internal_
+    void record_unsupported_command() const
+    {
+        if(detail::command_recorder *recorder = detail::current_command_recorder()){
+            recorder->record_unsupported_command(m_queue);
+        }
+    }
+
+    /// \internal_
+    void trace_transfer(detail::trace_record::kind_type kind,
+                        size_t size,
+                        const event &event_) const
+    {
+        if(detail::command_tracer *tracer = detail::current_command_tracer()){
+            tracer->trace_transfer(m_queue, kind, size, event_.get());
+        }
+    }
+
 private:
     cl_command_queue m_queue;
 };
@@ -63,4 +63,8 @@
 #  define BOOST_COMPUTE_NO_HDR_CHRONO
 #endif // BOOST_NO_CXX11_HDR_CHRONO
 
+#if defined(BOOST_NO_CXX11_HDR_MUTEX)
+#  define BOOST_COMPUTE_NO_HDR_MUTEX
+#endif // BOOST_NO_CXX11_HDR_MUTEX
+
 #endif // BOOST_COMPUTE_CONFIG_HPP
@@ -21,7 +21,9 @@
 #include <boost/compute/container/flat_map.hpp>
 #include <boost/compute/container/flat_set.hpp>
 #include <boost/compute/container/mapped_view.hpp>
+#include <boost/compute/container/soa_vector.hpp>
 #include <boost/compute/container/string.hpp>
+#include <boost/compute/container/string_column.hpp>
 #include <boost/compute/container/vector.hpp>
 
 #endif // BOOST_COMPUTE_CONTAINER_HPP
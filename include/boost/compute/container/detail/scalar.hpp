@@ -13,7 +13,9 @@
 
 #include <boost/compute/buffer.hpp>
 #include <boost/compute/event.hpp>
+#include <boost/compute/command_queue.hpp>
 #include <boost/compute/detail/read_write_single_value.hpp>
+#include <boost/compute/utility/wait_list.hpp>
 
 namespace boost {
 namespace compute {
@@ -41,6 +43,16 @@ public:
         return read_single_value<T>(m_buffer, 0, queue);
     }
 
+    // enqueues a non-blocking read of the value to host_ptr
+    event read_async(T *host_ptr,
+                     command_queue &queue,
+                     const wait_list &events = wait_list()) const
+    {
+        return queue.enqueue_read_buffer_async(
+            m_buffer, 0, sizeof(T), host_ptr, events
+        );
+    }
+
     event write(const T &value, command_queue &queue)
     {
         return write_single_value<T>(value, m_buffer, 0, queue);
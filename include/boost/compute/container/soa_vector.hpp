@@ -0,0 +1,577 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://boostorg.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#ifndef BOOST_COMPUTE_CONTAINER_SOA_VECTOR_HPP
+#define BOOST_COMPUTE_CONTAINER_SOA_VECTOR_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+#include <boost/assert.hpp>
+#include <boost/static_assert.hpp>
+#include <boost/preprocessor/comma_if.hpp>
+#include <boost/preprocessor/repetition.hpp>
+#include <boost/tuple/tuple.hpp>
+
+#include <boost/compute/buffer.hpp>
+#include <boost/compute/config.hpp>
+#include <boost/compute/context.hpp>
+#include <boost/compute/system.hpp>
+#include <boost/compute/command_queue.hpp>
+#include <boost/compute/algorithm/copy.hpp>
+#include <boost/compute/algorithm/gather.hpp>
+#include <boost/compute/algorithm/iota.hpp>
+#include <boost/compute/algorithm/stable_sort_by_key.hpp>
+#include <boost/compute/container/vector.hpp>
+#include <boost/compute/detail/meta_kernel.hpp>
+#include <boost/compute/functional/operator.hpp>
+#include <boost/compute/iterator/buffer_iterator.hpp>
+#include <boost/compute/iterator/zip_iterator.hpp>
+#include <boost/compute/types/struct.hpp>
+#include <boost/compute/type_traits/type_name.hpp>
+
+namespace boost {
+namespace compute {
+namespace detail {
+
+// returns the offset in bytes of member in Struct
+template<class Struct, class T>
+inline size_t soa_member_offset(T Struct::*member)
+{
+    const Struct s = Struct();
+
+    return static_cast<size_t>(
+        reinterpret_cast<const char *>(&(s.*member)) -
+        reinterpret_cast<const char *>(&s)
+    );
+}
+
+// collects the offset and size of each member
+template<class Struct>
+struct soa_layout_visitor
+{
+    template<class T>
+    void operator()(T Struct::*member, const char *)
+    {
+        offsets.push_back(soa_member_offset(member));
+        sizes.push_back(sizeof(T));
+    }
+
+    template<class T, int N>
+    void operator()(T (Struct::*)[N], const char *)
+    {
+        BOOST_STATIC_ASSERT_MSG(
+            N == 0, "soa_vector does not support structs with array members"
+        );
+    }
+
+    std::vector<size_t> offsets;
+    std::vector<size_t> sizes;
+};
+
+// writes the members of the struct "s" to the row "r" of the columns
+template<class Struct>
+struct soa_split_visitor
+{
+    soa_split_visitor(meta_kernel &k, const std::vector<buffer> &columns)
+        : k(k), columns(columns), index(0)
+    {
+    }
+
+    template<class T>
+    void operator()(T Struct::*, const char *name)
+    {
+        buffer_iterator<T> column =
+            make_buffer_iterator<T>(columns[index++], 0);
+
+        k << column[k.var<uint_>("r")] << " = s." << name << ";\n";
+    }
+
+    meta_kernel &k;
+    const std::vector<buffer> &columns;
+    size_t index;
+};
+
+// reads the members of the struct "s" from the row "r" of the columns
+template<class Struct>
+struct soa_merge_visitor
+{
+    soa_merge_visitor(meta_kernel &k, const std::vector<buffer> &columns)
+        : k(k), columns(columns), index(0)
+    {
+    }
+
+    template<class T>
+    void operator()(T Struct::*, const char *name)
+    {
+        buffer_iterator<T> column =
+            make_buffer_iterator<T>(columns[index++], 0);
+
+        k << "s." << name << " = " << column[k.var<uint_>("r")] << ";\n";
+    }
+
+    meta_kernel &k;
+    const std::vector<buffer> &columns;
+    size_t index;
+};
+
+// reorders the rows of each column so that row i is the previous row
+// indices[i]
+template<class Struct>
+struct soa_gather_visitor
+{
+    soa_gather_visitor(std::vector<buffer> &columns,
+                       const vector<uint_> &indices,
+                       command_queue &queue)
+        : columns(columns), indices(indices), queue(queue), index(0)
+    {
+    }
+
+    template<class T>
+    void operator()(T Struct::*, const char *)
+    {
+        buffer &column = columns[index++];
+        buffer sorted(queue.get_context(), column.size());
+
+        ::boost::compute::gather(
+            indices.begin(),
+            indices.end(),
+            make_buffer_iterator<T>(column, 0),
+            make_buffer_iterator<T>(sorted, 0),
+            queue
+        );
+
+        column = sorted;
+    }
+
+    std::vector<buffer> &columns;
+    const vector<uint_> &indices;
+    command_queue &queue;
+    size_t index;
+};
+
+} // end detail namespace
+
+/// \class soa_vector
+/// \brief A structure-of-arrays container for adapted structs.
+///
+/// The \c soa_vector class stores the values of a struct adapted with
+/// \ref BOOST_COMPUTE_ADAPT_STRUCT "BOOST_COMPUTE_ADAPT_STRUCT()" with each
+/// member in its own buffer (column), instead of one buffer of structs
+/// like \ref vector "vector<Struct>". Kernels which only use a few of the
+/// members then only read those columns.
+///
+/// The columns are accessed with the member pointers of the struct.
+/// begin() and end() return a \ref buffer_iterator "buffer_iterator" for
+/// a single column and zip_begin() and zip_end() a \ref zip_iterator
+/// "zip_iterator" over several columns, so the existing algorithms can be
+/// used on the columns:
+/// \code
+/// struct tick
+/// {
+///     float price;
+///     uint_ volume;
+///     ulong_ time;
+/// };
+///
+/// BOOST_COMPUTE_ADAPT_STRUCT(tick, tick, (price, volume, time))
+///
+/// // converts the ticks to columns
+/// boost::compute::soa_vector<tick> ticks(host_ticks.begin(), host_ticks.end(), queue);
+///
+/// // only the price column is read
+/// float total = 0;
+/// boost::compute::reduce(
+///     ticks.begin(&tick::price), ticks.end(&tick::price), &total, queue
+/// );
+///
+/// // sorts the rows by time
+/// ticks.sort_by(&tick::time, queue);
+/// \endcode
+///
+/// The values are converted between structs and columns by a single kernel
+/// in assign() and copy_to(). Structs with array members are not supported.
+///
+/// \see vector, zip_iterator
+template<class Struct>
+class soa_vector
+{
+public:
+    typedef Struct value_type;
+    typedef size_t size_type;
+
+    /// Creates an empty soa_vector in \p context.
+    explicit soa_vector(const context &context = system::default_context())
+        : m_context(context),
+          m_size(0)
+    {
+        init_layout();
+        allocate_columns(0);
+    }
+
+    /// Creates a soa_vector with \p count uninitialized rows in \p context.
+    explicit soa_vector(size_type count,
+                        const context &context = system::default_context())
+        : m_context(context),
+          m_size(count)
+    {
+        init_layout();
+        allocate_columns(count);
+    }
+
+    /// Creates a soa_vector with the structs in [\p first, \p last) which
+    /// may be given by host or device iterators.
+    template<class InputIterator>
+    soa_vector(InputIterator first,
+               InputIterator last,
+               command_queue &queue = system::default_queue())
+        : m_context(queue.get_context()),
+          m_size(0)
+    {
+        init_layout();
+        assign(first, last, queue);
+    }
+
+    /// Creates a new soa_vector as a copy of \p other.
+    soa_vector(const soa_vector &other,
+               command_queue &queue = system::default_queue())
+        : m_context(other.m_context),
+          m_size(0),
+          m_offsets(other.m_offsets),
+          m_sizes(other.m_sizes)
+    {
+        allocate_columns(other.m_size);
+        m_size = other.m_size;
+        copy_columns(other, queue);
+    }
+
+    /// Copies the rows from \p other to \c *this.
+    soa_vector& operator=(const soa_vector &other)
+    {
+        if(this != &other){
+            command_queue queue(m_context, m_context.get_device());
+            allocate_columns(other.m_size);
+            m_size = other.m_size;
+            copy_columns(other, queue);
+            queue.finish();
+        }
+
+        return *this;
+    }
+
+    /// Destroys the soa_vector.
+    ~soa_vector()
+    {
+    }
+
+    /// Returns the number of rows.
+    size_type size() const
+    {
+        return m_size;
+    }
+
+    /// Returns \c true if the soa_vector has no rows.
+    bool empty() const
+    {
+        return m_size == 0;
+    }
+
+    /// Returns the number of columns (the number of members of \c Struct).
+    static size_type columns()
+    {
+        return detail::adapted_struct_members<Struct>::size;
+    }
+
+    /// Returns the buffer holding the column of \p member.
+    template<class T>
+    const buffer& get_buffer(T Struct::*member) const
+    {
+        return m_columns[column_index(member)];
+    }
+
+    /// Returns an iterator to the first value of the column of \p member.
+    template<class T>
+    buffer_iterator<T> begin(T Struct::*member) const
+    {
+        return make_buffer_iterator<T>(get_buffer(member), 0);
+    }
+
+    /// Returns an iterator to one past the last value of the column of
+    /// \p member.
+    template<class T>
+    buffer_iterator<T> end(T Struct::*member) const
+    {
+        return make_buffer_iterator<T>(get_buffer(member), m_size);
+    }
+
+    /// \fn zip_begin(T0 Struct::*m0, T1 Struct::*m1, ...) const
+    /// Returns a zip_iterator to the first row of the columns of \p m0,
+    /// \p m1, etc.
+
+    /// \fn zip_end(T0 Struct::*m0, T1 Struct::*m1, ...) const
+    /// Returns a zip_iterator to one past the last row of the columns of
+    /// \p m0, \p m1, etc.
+
+    /// \internal_
+    #define BOOST_COMPUTE_DETAIL_SOA_ITERATOR_TYPE(z, n, unused) \
+        BOOST_PP_COMMA_IF(n) buffer_iterator<T##n>
+
+    /// \internal_
+    #define BOOST_COMPUTE_DETAIL_SOA_BEGIN(z, n, unused) \
+        BOOST_PP_COMMA_IF(n) begin(m##n)
+
+    /// \internal_
+    #define BOOST_COMPUTE_DETAIL_SOA_END(z, n, unused) \
+        BOOST_PP_COMMA_IF(n) end(m##n)
+
+    /// \internal_
+    #define BOOST_COMPUTE_DETAIL_SOA_ZIP(z, n, unused) \
+    template<BOOST_PP_ENUM_PARAMS(n, class T)> \
+    zip_iterator<boost::tuple<BOOST_PP_REPEAT(n, BOOST_COMPUTE_DETAIL_SOA_ITERATOR_TYPE, ~)> > \
+    zip_begin(BOOST_PP_ENUM_BINARY_PARAMS(n, T, Struct::*m)) const \
+    { \
+        return make_zip_iterator( \
+            boost::make_tuple(BOOST_PP_REPEAT(n, BOOST_COMPUTE_DETAIL_SOA_BEGIN, ~)) \
+        ); \
+    } \
+    \
+    template<BOOST_PP_ENUM_PARAMS(n, class T)> \
+    zip_iterator<boost::tuple<BOOST_PP_REPEAT(n, BOOST_COMPUTE_DETAIL_SOA_ITERATOR_TYPE, ~)> > \
+    zip_end(BOOST_PP_ENUM_BINARY_PARAMS(n, T, Struct::*m)) const \
+    { \
+        return make_zip_iterator( \
+            boost::make_tuple(BOOST_PP_REPEAT(n, BOOST_COMPUTE_DETAIL_SOA_END, ~)) \
+        ); \
+    }
+
+    BOOST_PP_REPEAT_FROM_TO(1, BOOST_COMPUTE_MAX_ARITY, BOOST_COMPUTE_DETAIL_SOA_ZIP, ~)
+
+    #undef BOOST_COMPUTE_DETAIL_SOA_ZIP
+    #undef BOOST_COMPUTE_DETAIL_SOA_END
+    #undef BOOST_COMPUTE_DETAIL_SOA_BEGIN
+    #undef BOOST_COMPUTE_DETAIL_SOA_ITERATOR_TYPE
+
+    /// Resizes the soa_vector to \p count rows. The values of the first
+    /// \c min(size(), count) rows are kept.
+    void resize(size_type count, command_queue &queue = system::default_queue())
+    {
+        std::vector<buffer> columns;
+        columns.swap(m_columns);
+        allocate_columns(count);
+
+        const size_type kept = (std::min)(m_size, count);
+        if(kept > 0){
+            for(size_t i = 0; i < m_columns.size(); i++){
+                queue.enqueue_copy_buffer(
+                    columns[i], m_columns[i], 0, 0, kept * m_sizes[i]
+                );
+            }
+        }
+
+        m_size = count;
+    }
+
+    /// Replaces the rows with the structs in [\p first, \p last).
+    void assign(buffer_iterator<Struct> first,
+                buffer_iterator<Struct> last,
+                command_queue &queue = system::default_queue())
+    {
+        const size_type count = detail::iterator_range_size(first, last);
+
+        allocate_columns(count);
+        m_size = count;
+        if(count == 0){
+            return;
+        }
+
+        detail::meta_kernel k("soa_vector_split");
+        k << "const uint r = get_global_id(0);\n"
+          << "const " << type_name<Struct>() << " s = "
+          << first[k.var<uint_>("r")] << ";\n";
+
+        detail::soa_split_visitor<Struct> visitor(k, m_columns);
+        detail::adapted_struct_members<Struct>::for_each(visitor);
+
+        k.exec_1d(queue, 0, count);
+    }
+
+    /// \overload
+    template<class InputIterator>
+    void assign(InputIterator first,
+                InputIterator last,
+                command_queue &queue = system::default_queue())
+    {
+        vector<Struct> structs(first, last, queue);
+
+        assign(structs.begin(), structs.end(), queue);
+    }
+
+    /// Copies the rows as structs to the range beginning at \p result.
+    void copy_to(buffer_iterator<Struct> result,
+                 command_queue &queue = system::default_queue()) const
+    {
+        copy_rows_to(0, m_size, result, queue);
+    }
+
+    /// \overload
+    template<class OutputIterator>
+    void copy_to(OutputIterator result,
+                 command_queue &queue = system::default_queue()) const
+    {
+        vector<Struct> structs(m_size, m_context);
+        copy_rows_to(0, m_size, structs.begin(), queue);
+
+        ::boost::compute::copy(structs.begin(), structs.end(), result, queue);
+    }
+
+    /// Returns a copy of the row at \p index as a struct on the host.
+    Struct get(size_type index, command_queue &queue = system::default_queue()) const
+    {
+        BOOST_ASSERT(index < m_size);
+
+        vector<Struct> value(1, m_context);
+        copy_rows_to(index, 1, value.begin(), queue);
+
+        return value.begin().read(queue);
+    }
+
+    /// Stably sorts the rows by the values of the column of \p key
+    /// according to \p compare.
+    ///
+    /// The keys are sorted with the row indices, which are then used to
+    /// gather each of the other columns.
+    template<class T, class Compare>
+    void sort_by(T Struct::*key,
+                 Compare compare,
+                 command_queue &queue = system::default_queue())
+    {
+        if(m_size < 2){
+            return;
+        }
+
+        vector<T> keys(begin(key), end(key), queue);
+        vector<uint_> indices(m_size, m_context);
+        ::boost::compute::iota(indices.begin(), indices.end(), uint_(0), queue);
+
+        ::boost::compute::stable_sort_by_key(
+            keys.begin(), keys.end(), indices.begin(), compare, queue
+        );
+
+        detail::soa_gather_visitor<Struct> visitor(m_columns, indices, queue);
+        detail::adapted_struct_members<Struct>::for_each(visitor);
+    }
+
+    /// \overload
+    template<class T>
+    void sort_by(T Struct::*key, command_queue &queue = system::default_queue())
+    {
+        sort_by(key, less<T>(), queue);
+    }
+
+    /// Swaps the contents of \c *this with \p other.
+    void swap(soa_vector &other)
+    {
+        std::swap(m_context, other.m_context);
+        std::swap(m_size, other.m_size);
+        m_columns.swap(other.m_columns);
+    }
+
+private:
+    /// \internal_
+    void init_layout()
+    {
+        detail::soa_layout_visitor<Struct> visitor;
+        detail::adapted_struct_members<Struct>::for_each(visitor);
+
+        m_offsets.swap(visitor.offsets);
+        m_sizes.swap(visitor.sizes);
+    }
+
+    /// \internal_
+    void allocate_columns(size_type count)
+    {
+        // the columns always hold at least one value since empty buffers
+        // can not be created
+        m_columns.clear();
+        for(size_t i = 0; i < m_sizes.size(); i++){
+            m_columns.push_back(
+                buffer(m_context, (std::max)(count, size_type(1)) * m_sizes[i])
+            );
+        }
+    }
+
+    /// \internal_
+    void copy_columns(const soa_vector &other, command_queue &queue)
+    {
+        if(m_size == 0){
+            return;
+        }
+
+        for(size_t i = 0; i < m_columns.size(); i++){
+            queue.enqueue_copy_buffer(
+                other.m_columns[i], m_columns[i], 0, 0, m_size * m_sizes[i]
+            );
+        }
+    }
+
+    /// \internal_
+    template<class T>
+    size_t column_index(T Struct::*member) const
+    {
+        const size_t offset = detail::soa_member_offset(member);
+
+        const size_t index = static_cast<size_t>(
+            std::find(m_offsets.begin(), m_offsets.end(), offset) -
+            m_offsets.begin()
+        );
+        BOOST_ASSERT(index < m_offsets.size());
+
+        return index;
+    }
+
+    /// \internal_
+    void copy_rows_to(size_type first,
+                      size_type count,
+                      buffer_iterator<Struct> result,
+                      command_queue &queue) const
+    {
+        if(count == 0){
+            return;
+        }
+
+        detail::meta_kernel k("soa_vector_merge");
+        size_t first_arg = k.add_arg<const uint_>("first");
+        k << "const uint i = get_global_id(0);\n"
+          << "const uint r = first + i;\n"
+          << type_name<Struct>() << " s;\n";
+
+        detail::soa_merge_visitor<Struct> visitor(k, m_columns);
+        detail::adapted_struct_members<Struct>::for_each(visitor);
+
+        k << result[k.var<uint_>("i")] << " = s;\n";
+
+        kernel kernel = k.compile(queue.get_context());
+        kernel.set_arg(first_arg, static_cast<uint_>(first));
+        queue.enqueue_1d_range_kernel(kernel, 0, count, 0);
+    }
+
+private:
+    context m_context;
+    size_type m_size;
+    std::vector<buffer> m_columns;
+    std::vector<size_t> m_offsets;
+    std::vector<size_t> m_sizes;
+};
+
+} // end compute namespace
+} // end boost namespace
+
+#endif // BOOST_COMPUTE_CONTAINER_SOA_VECTOR_HPP
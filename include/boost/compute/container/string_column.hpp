@@ -0,0 +1,790 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://boostorg.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#ifndef BOOST_COMPUTE_CONTAINER_STRING_COLUMN_HPP
+#define BOOST_COMPUTE_CONTAINER_STRING_COLUMN_HPP
+
+#include <iterator>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <boost/assert.hpp>
+#include <boost/static_assert.hpp>
+#include <boost/type_traits/is_integral.hpp>
+
+#include <boost/compute/closure.hpp>
+#include <boost/compute/system.hpp>
+#include <boost/compute/command_queue.hpp>
+#include <boost/compute/algorithm/copy.hpp>
+#include <boost/compute/algorithm/copy_if.hpp>
+#include <boost/compute/algorithm/exclusive_scan.hpp>
+#include <boost/compute/algorithm/gather.hpp>
+#include <boost/compute/algorithm/inclusive_scan.hpp>
+#include <boost/compute/algorithm/iota.hpp>
+#include <boost/compute/algorithm/sort_by_key.hpp>
+#include <boost/compute/algorithm/stable_sort_by_key.hpp>
+#include <boost/compute/container/vector.hpp>
+#include <boost/compute/detail/meta_kernel.hpp>
+#include <boost/compute/detail/read_write_single_value.hpp>
+#include <boost/compute/functional/hash.hpp>
+#include <boost/compute/iterator/counting_iterator.hpp>
+#include <boost/compute/type_traits/type_name.hpp>
+#include <boost/compute/types/fundamental.hpp>
+
+namespace boost {
+namespace compute {
+
+/// \class basic_string_column
+/// \brief A column of variable-length strings stored on the device.
+///
+/// The \c basic_string_column class stores many strings in two buffers: the
+/// characters of all the strings one after the other and an offsets buffer
+/// with the position of the first character of each string (plus one at
+/// the end with the total number of characters). This is most commonly used
+/// through the \c string_column typedef (for \c basic_string_column<char>).
+///
+/// Unlike a \ref vector "vector" of \ref basic_string "basic_string"'s, the
+/// strings of a column are processed by a single kernel with one work-item
+/// per string. The column provides hashing, comparison, prefix extraction
+/// and sorting of its strings on the device, which allows dictionary
+/// encoding and grouping by string keys without copying the strings back
+/// to the host.
+///
+/// For example, to sort a set of words on the device:
+/// \code
+/// std::vector<std::string> words = ...
+///
+/// boost::compute::string_column column(words.begin(), words.end(), queue);
+/// column.sort(queue);
+///
+/// column.copy_to(words.begin(), queue);
+/// \endcode
+///
+/// The characters are compared as unsigned values (like
+/// \c std::char_traits<char>::compare()). The total number of characters in
+/// a column must fit in a \c uint_.
+///
+/// \see \ref basic_string "basic_string<CharT>"
+template<class CharT>
+class basic_string_column
+{
+public:
+    typedef CharT char_type;
+    typedef std::basic_string<CharT> value_type;
+    typedef size_t size_type;
+
+    BOOST_STATIC_ASSERT_MSG(
+        boost::is_integral<CharT>::value && sizeof(CharT) == 1,
+        "basic_string_column only supports one byte integral character types"
+    );
+
+    /// Creates an empty column in \p context.
+    explicit basic_string_column(const context &context = system::default_context())
+        : m_offsets(context),
+          m_chars(context)
+    {
+    }
+
+    /// Creates a column with the strings in [\p first, \p last). Each value
+    /// in the range is a host string (e.g. a \c std::string).
+    template<class InputIterator>
+    basic_string_column(InputIterator first,
+                        InputIterator last,
+                        command_queue &queue = system::default_queue())
+        : m_offsets(queue.get_context()),
+          m_chars(queue.get_context())
+    {
+        assign(first, last, queue);
+    }
+
+    /// Creates a column from the device buffers \p offsets and \p chars.
+    /// \p offsets must hold the position of the first character of each
+    /// string in \p chars followed by the total number of characters.
+    basic_string_column(const vector<uint_> &offsets,
+                        const vector<CharT> &chars,
+                        command_queue &queue = system::default_queue())
+        : m_offsets(offsets, queue),
+          m_chars(chars, queue)
+    {
+    }
+
+    /// Creates a new column as a copy of \p other.
+    basic_string_column(const basic_string_column &other)
+        : m_offsets(other.m_offsets),
+          m_chars(other.m_chars)
+    {
+    }
+
+    /// Copies the strings from \p other to \c *this.
+    basic_string_column& operator=(const basic_string_column &other)
+    {
+        if(this != &other){
+            m_offsets = other.m_offsets;
+            m_chars = other.m_chars;
+        }
+
+        return *this;
+    }
+
+    /// Destroys the column.
+    ~basic_string_column()
+    {
+    }
+
+    /// Returns the number of strings in the column.
+    size_type size() const
+    {
+        return m_offsets.empty() ? 0 : m_offsets.size() - 1;
+    }
+
+    /// Returns \c true if the column contains no strings.
+    bool empty() const
+    {
+        return size() == 0;
+    }
+
+    /// Returns the total number of characters in the column.
+    size_type chars_size() const
+    {
+        return m_chars.size();
+    }
+
+    /// Returns the offsets buffer. The characters of string \c i are at
+    /// [\c offsets[i], \c offsets[i+1]) in chars().
+    const vector<uint_>& offsets() const
+    {
+        return m_offsets;
+    }
+
+    /// Returns the characters buffer.
+    const vector<CharT>& chars() const
+    {
+        return m_chars;
+    }
+
+    /// Replaces the strings in the column with the host strings in
+    /// [\p first, \p last).
+    template<class InputIterator>
+    void assign(InputIterator first, InputIterator last, command_queue &queue)
+    {
+        std::vector<uint_> host_offsets(1, 0);
+        std::vector<CharT> host_chars;
+        for(InputIterator i = first; i != last; ++i){
+            host_chars.insert(host_chars.end(), i->begin(), i->end());
+            host_offsets.push_back(static_cast<uint_>(host_chars.size()));
+        }
+
+        m_offsets.resize(host_offsets.size(), queue);
+        ::boost::compute::copy(
+            host_offsets.begin(), host_offsets.end(), m_offsets.begin(), queue
+        );
+
+        m_chars.resize(host_chars.size(), queue);
+        if(!host_chars.empty()){
+            ::boost::compute::copy(
+                host_chars.begin(), host_chars.end(), m_chars.begin(), queue
+            );
+        }
+    }
+
+    /// Returns a copy of the string at \p index on the host.
+    value_type get(size_type index, command_queue &queue) const
+    {
+        const uint_ begin =
+            detail::read_single_value<uint_>(m_offsets.get_buffer(), index, queue);
+        const uint_ end =
+            detail::read_single_value<uint_>(m_offsets.get_buffer(), index + 1, queue);
+
+        value_type string(end - begin, CharT(0));
+        if(end != begin){
+            ::boost::compute::copy(
+                m_chars.begin() + begin, m_chars.begin() + end, string.begin(), queue
+            );
+        }
+
+        return string;
+    }
+
+    /// Copies the strings in the column to the host strings beginning at
+    /// \p result.
+    template<class OutputIterator>
+    OutputIterator copy_to(OutputIterator result, command_queue &queue) const
+    {
+        if(empty()){
+            return result;
+        }
+
+        std::vector<uint_> host_offsets(m_offsets.size());
+        ::boost::compute::copy(
+            m_offsets.begin(), m_offsets.end(), host_offsets.begin(), queue
+        );
+
+        std::vector<CharT> host_chars(m_chars.size());
+        if(!host_chars.empty()){
+            ::boost::compute::copy(
+                m_chars.begin(), m_chars.end(), host_chars.begin(), queue
+            );
+        }
+
+        for(size_type i = 0; i < size(); i++){
+            *result++ = value_type(
+                host_chars.begin() + host_offsets[i],
+                host_chars.begin() + host_offsets[i+1]
+            );
+        }
+
+        return result;
+    }
+
+    /// Writes the hash value (a \c ulong_) of each string to the range
+    /// beginning at \p result. The characters are combined with FNV-1a and
+    /// the result is mixed with \ref hash "hash<uint_>".
+    template<class OutputIterator>
+    void hash(OutputIterator result, command_queue &queue) const
+    {
+        if(empty()){
+            return;
+        }
+
+        ::boost::compute::hash<uint_> hash_function;
+
+        detail::meta_kernel k("string_column_hash");
+        size_t offsets_arg = k.add_arg<const uint_ *>(memory_object::global_memory, "offsets");
+        size_t chars_arg = k.add_arg<const CharT *>(memory_object::global_memory, "chars");
+        k <<
+            "const uint i = get_global_id(0);\n" <<
+            "const uint end = offsets[i+1];\n" <<
+            "uint h = 2166136261u;\n" <<
+            "for(uint j = offsets[i]; j < end; j++){\n" <<
+            "    h = (h ^ (uint)(uchar) chars[j]) * 16777619u;\n" <<
+            "}\n" <<
+            result[k.var<uint_>("i")] << " = " <<
+                hash_function(k.var<uint_>("h")) << ";\n";
+
+        run(k, offsets_arg, chars_arg, queue);
+    }
+
+    /// Writes \c 1 to the range beginning at \p result for each string
+    /// which is equal to the string at the same index in \p other and \c 0
+    /// for the others. \p other must have the same size as the column.
+    template<class OutputIterator>
+    void equal(const basic_string_column &other,
+               OutputIterator result,
+               command_queue &queue) const
+    {
+        pairwise("string_column_equal", other, result, true, queue);
+    }
+
+    /// Compares each string with the string at the same index in \p other
+    /// and writes \c -1, \c 0 or \c 1 (as an \c int_) to the range beginning
+    /// at \p result if it is less than, equal to or greater than the other
+    /// string. \p other must have the same size as the column.
+    template<class OutputIterator>
+    void compare(const basic_string_column &other,
+                 OutputIterator result,
+                 command_queue &queue) const
+    {
+        pairwise("string_column_compare", other, result, false, queue);
+    }
+
+    /// Writes the first eight characters of each string packed into a
+    /// \c ulong_ (with the first character in the most significant byte and
+    /// shorter strings padded with zeros) to the range beginning at
+    /// \p result. The packed prefixes of two strings compare like the
+    /// strings themselves unless they are equal.
+    template<class OutputIterator>
+    void packed_prefixes(OutputIterator result, command_queue &queue) const
+    {
+        if(empty()){
+            return;
+        }
+
+        detail::meta_kernel k("string_column_packed_prefixes");
+        size_t offsets_arg = k.add_arg<const uint_ *>(memory_object::global_memory, "offsets");
+        size_t chars_arg = k.add_arg<const CharT *>(memory_object::global_memory, "chars");
+        k <<
+            "const uint i = get_global_id(0);\n" <<
+            "const uint begin = offsets[i];\n" <<
+            "const uint length = offsets[i+1] - begin;\n" <<
+            "ulong prefix = 0;\n" <<
+            "for(uint j = 0; j < 8; j++){\n" <<
+            "    prefix <<= 8;\n" <<
+            "    if(j < length){\n" <<
+            "        prefix |= (ulong)(uchar) chars[begin + j];\n" <<
+            "    }\n" <<
+            "}\n" <<
+            result[k.var<uint_>("i")] << " = prefix;\n";
+
+        run(k, offsets_arg, chars_arg, queue);
+    }
+
+    /// Returns a column with the first \p length characters of each string
+    /// (or the whole string if it is shorter).
+    basic_string_column prefix(size_type length, command_queue &queue) const
+    {
+        return copy_strings(0, size(), static_cast<uint_>(length), queue);
+    }
+
+    /// Returns a column with the strings at \p indices (in that order).
+    basic_string_column gather(const vector<uint_> &indices,
+                               command_queue &queue) const
+    {
+        return copy_strings(&indices, indices.size(), uint_(-1), queue);
+    }
+
+    /// Writes the indices of the strings in sorted order to \p indices
+    /// (which is resized to the size of the column).
+    ///
+    /// The indices are first sorted by the first seven characters of the
+    /// strings packed together with their lengths (with a radix sort on
+    /// GPUs). Only the runs of strings which are still tied (i.e. their
+    /// first seven characters are equal and both have more characters) are
+    /// then sorted further, each pass sorting them by their next seven
+    /// characters and their lengths within their run until no such runs are
+    /// left.
+    void sort_indices(vector<uint_> &indices, command_queue &queue) const
+    {
+        const context &context = queue.get_context();
+        const size_type n = size();
+
+        indices.resize(n, queue);
+        if(n == 0){
+            return;
+        }
+
+        vector<ulong_> windows(n, context);
+        first_windows(windows, queue);
+
+        ::boost::compute::iota(indices.begin(), indices.end(), uint_(0), queue);
+        ::boost::compute::sort_by_key(
+            windows.begin(), windows.end(), indices.begin(), queue
+        );
+
+        // ties[i] is 1 if the strings at i-1 and i in the sorted order can
+        // still be out of order, ties[0] and ties[n] are always 0
+        vector<uint_> ties(n + 1, context);
+        window_ties(windows, ties, queue);
+
+        BOOST_COMPUTE_CLOSURE(bool, string_column_tied, (uint_ i), (ties),
+        {
+            return ties[i] || ties[i+1];
+        });
+
+        // positions of the strings in runs which are not sorted yet
+        vector<uint_> positions(n, context);
+        vector<uint_> next_positions(n, context);
+        size_type count = static_cast<size_type>(std::distance(
+            positions.begin(),
+            ::boost::compute::copy_if(
+                make_counting_iterator<uint_>(0),
+                make_counting_iterator<uint_>(static_cast<uint_>(n)),
+                positions.begin(),
+                string_column_tied,
+                queue
+            )
+        ));
+
+        for(uint_ depth = 7; count > 0; depth += 7){
+            sort_tied_runs(indices, ties, positions, count, depth, queue);
+
+            count = static_cast<size_type>(std::distance(
+                next_positions.begin(),
+                ::boost::compute::copy_if(
+                    positions.begin(),
+                    positions.begin() + count,
+                    next_positions.begin(),
+                    string_column_tied,
+                    queue
+                )
+            ));
+            positions.swap(next_positions);
+        }
+    }
+
+    /// Sorts the strings in the column.
+    ///
+    /// \see sort_indices()
+    void sort(command_queue &queue)
+    {
+        vector<uint_> indices(queue.get_context());
+        sort_indices(indices, queue);
+
+        basic_string_column sorted = gather(indices, queue);
+        swap(sorted);
+    }
+
+    /// Swaps the strings in the column with \p other.
+    void swap(basic_string_column &other)
+    {
+        m_offsets.swap(other.m_offsets);
+        m_chars.swap(other.m_chars);
+    }
+
+private:
+    // runs the kernel with one work-item per string
+    void run(detail::meta_kernel &k,
+             size_t offsets_arg,
+             size_t chars_arg,
+             command_queue &queue) const
+    {
+        kernel kernel = k.compile(queue.get_context());
+        kernel.set_arg(offsets_arg, m_offsets.get_buffer());
+        kernel.set_arg(chars_arg, m_chars.get_buffer());
+        queue.enqueue_1d_range_kernel(kernel, 0, size(), 0);
+    }
+
+    // compares each string with the string at the same index in other
+    template<class OutputIterator>
+    void pairwise(const char *name,
+                  const basic_string_column &other,
+                  OutputIterator result,
+                  bool equal_only,
+                  command_queue &queue) const
+    {
+        BOOST_ASSERT(size() == other.size());
+
+        if(empty()){
+            return;
+        }
+
+        detail::meta_kernel k(name);
+        size_t offsets_arg = k.add_arg<const uint_ *>(memory_object::global_memory, "offsets");
+        size_t chars_arg = k.add_arg<const CharT *>(memory_object::global_memory, "chars");
+        size_t other_offsets_arg =
+            k.add_arg<const uint_ *>(memory_object::global_memory, "other_offsets");
+        size_t other_chars_arg =
+            k.add_arg<const CharT *>(memory_object::global_memory, "other_chars");
+        k <<
+            "const uint i = get_global_id(0);\n" <<
+            "const uint a_begin = offsets[i];\n" <<
+            "const uint a_length = offsets[i+1] - a_begin;\n" <<
+            "const uint b_begin = other_offsets[i];\n" <<
+            "const uint b_length = other_offsets[i+1] - b_begin;\n" <<
+            "const uint length = min(a_length, b_length);\n" <<
+            "int result = (a_length > b_length) - (a_length < b_length);\n";
+        if(equal_only){
+            k <<
+                "if(result == 0){\n" <<
+                "    for(uint j = 0; j < length; j++){\n" <<
+                "        if(chars[a_begin + j] != other_chars[b_begin + j]){\n" <<
+                "            result = 1;\n" <<
+                "            break;\n" <<
+                "        }\n" <<
+                "    }\n" <<
+                "}\n" <<
+                result[k.var<uint_>("i")] << " = result == 0;\n";
+        }
+        else {
+            k <<
+                "for(uint j = 0; j < length; j++){\n" <<
+                "    const uchar ca = chars[a_begin + j];\n" <<
+                "    const uchar cb = other_chars[b_begin + j];\n" <<
+                "    if(ca != cb){\n" <<
+                "        result = ca < cb ? -1 : 1;\n" <<
+                "        break;\n" <<
+                "    }\n" <<
+                "}\n" <<
+                result[k.var<uint_>("i")] << " = result;\n";
+        }
+
+        kernel kernel = k.compile(queue.get_context());
+        kernel.set_arg(offsets_arg, m_offsets.get_buffer());
+        kernel.set_arg(chars_arg, m_chars.get_buffer());
+        kernel.set_arg(other_offsets_arg, other.m_offsets.get_buffer());
+        kernel.set_arg(other_chars_arg, other.m_chars.get_buffer());
+        queue.enqueue_1d_range_kernel(kernel, 0, size(), 0);
+    }
+
+    // writes the window of each string at depth 0 (see add_window_function())
+    // to windows
+    void first_windows(vector<ulong_> &windows, command_queue &queue) const
+    {
+        detail::meta_kernel k("string_column_first_windows");
+        add_window_function(k);
+        size_t offsets_arg = k.add_arg<const uint_ *>(memory_object::global_memory, "offsets");
+        size_t chars_arg = k.add_arg<const CharT *>(memory_object::global_memory, "chars");
+        size_t windows_arg = k.add_arg<ulong_ *>(memory_object::global_memory, "windows");
+        k <<
+            "const uint i = get_global_id(0);\n" <<
+            "windows[i] = string_column_window(offsets, chars, i, 0);\n";
+
+        kernel kernel = k.compile(queue.get_context());
+        kernel.set_arg(offsets_arg, m_offsets.get_buffer());
+        kernel.set_arg(chars_arg, m_chars.get_buffer());
+        kernel.set_arg(windows_arg, windows.get_buffer());
+        queue.enqueue_1d_range_kernel(kernel, 0, size(), 0);
+    }
+
+    // sets ties[i] to 1 for each pair of strings at i-1 and i with equal
+    // sorted windows which both have more characters. as equal windows have
+    // equal low bytes the strings tied with each other form runs.
+    void window_ties(const vector<ulong_> &sorted_windows,
+                     vector<uint_> &ties,
+                     command_queue &queue) const
+    {
+        const size_type n = size();
+
+        detail::meta_kernel k("string_column_window_ties");
+        k.add_set_arg<const uint_>("n", static_cast<uint_>(n));
+        size_t windows_arg =
+            k.add_arg<const ulong_ *>(memory_object::global_memory, "windows");
+        size_t ties_arg = k.add_arg<uint_ *>(memory_object::global_memory, "ties");
+        k <<
+            "const uint i = get_global_id(0);\n" <<
+            "ties[i] = i > 0 && i < n &&\n" <<
+            "          windows[i] == windows[i-1] && (windows[i] & 0xff) == 15;\n";
+
+        kernel kernel = k.compile(queue.get_context());
+        kernel.set_arg(windows_arg, sorted_windows.get_buffer());
+        kernel.set_arg(ties_arg, ties.get_buffer());
+        queue.enqueue_1d_range_kernel(kernel, 0, n + 1, 0);
+    }
+
+    // adds the string_column_window() function to k. it returns the seven
+    // characters of string s from depth on packed into the high bytes of a
+    // ulong (padded with zeros) and min(length, depth + 7) + 8 - depth in
+    // the low byte. strings whose first depth characters are equal compare
+    // like their windows unless both windows end in 15, in which case both
+    // strings have more characters. the low byte is not negative as strings
+    // which are still tied at depth have at least depth characters.
+    void add_window_function(detail::meta_kernel &k) const
+    {
+        std::stringstream source;
+        source <<
+            "inline ulong string_column_window(__global const uint *offsets,\n" <<
+            "                                  __global const " <<
+                type_name<CharT>() << " *chars,\n" <<
+            "                                  const uint s,\n" <<
+            "                                  const uint depth)\n" <<
+            "{\n" <<
+            "    const uint begin = offsets[s];\n" <<
+            "    const uint length = offsets[s+1] - begin;\n" <<
+            "    ulong window = 0;\n" <<
+            "    for(uint j = depth; j < depth + 7; j++){\n" <<
+            "        window <<= 8;\n" <<
+            "        if(j < length){\n" <<
+            "            window |= (ulong)(uchar) chars[begin + j];\n" <<
+            "        }\n" <<
+            "    }\n" <<
+            "    return (window << 8) | (min(length, depth + 7) + 8 - depth);\n" <<
+            "}\n";
+
+        k.add_function("string_column_window", source.str());
+    }
+
+    // sorts the strings at the count positions in each run of tied strings
+    // by their windows at depth (see add_window_function()) and updates the
+    // ties between them. the positions are in order and each run is either
+    // included completely or not at all.
+    //
+    // the runs are sorted with two stable sorts, first by the windows and
+    // then by the index of their run.
+    void sort_tied_runs(vector<uint_> &indices,
+                        vector<uint_> &ties,
+                        const vector<uint_> &positions,
+                        size_type count,
+                        uint_ depth,
+                        command_queue &queue) const
+    {
+        const context &context = queue.get_context();
+
+        vector<ulong_> windows(count, context);
+        vector<uint_> runs(count, context);
+        vector<uint_> strings(count, context);
+
+        // the window of each string and the index of its run (the number of
+        // run heads up to and including it)
+        detail::meta_kernel k1("string_column_tied_windows");
+        add_window_function(k1);
+        k1.add_set_arg<const uint_>("depth", depth);
+        size_t offsets_arg = k1.add_arg<const uint_ *>(memory_object::global_memory, "offsets");
+        size_t chars_arg = k1.add_arg<const CharT *>(memory_object::global_memory, "chars");
+        size_t positions_arg =
+            k1.add_arg<const uint_ *>(memory_object::global_memory, "positions");
+        size_t indices_arg = k1.add_arg<const uint_ *>(memory_object::global_memory, "indices");
+        size_t ties_arg = k1.add_arg<const uint_ *>(memory_object::global_memory, "ties");
+        size_t windows_arg = k1.add_arg<ulong_ *>(memory_object::global_memory, "windows");
+        size_t runs_arg = k1.add_arg<uint_ *>(memory_object::global_memory, "runs");
+        size_t strings_arg = k1.add_arg<uint_ *>(memory_object::global_memory, "strings");
+        k1 <<
+            "const uint j = get_global_id(0);\n" <<
+            "const uint p = positions[j];\n" <<
+            "const uint s = indices[p];\n" <<
+            "windows[j] = string_column_window(offsets, chars, s, depth);\n" <<
+            "runs[j] = ties[p] ? 0 : 1;\n" <<
+            "strings[j] = s;\n";
+
+        kernel kernel = k1.compile(context);
+        kernel.set_arg(offsets_arg, m_offsets.get_buffer());
+        kernel.set_arg(chars_arg, m_chars.get_buffer());
+        kernel.set_arg(positions_arg, positions.get_buffer());
+        kernel.set_arg(indices_arg, indices.get_buffer());
+        kernel.set_arg(ties_arg, ties.get_buffer());
+        kernel.set_arg(windows_arg, windows.get_buffer());
+        kernel.set_arg(runs_arg, runs.get_buffer());
+        kernel.set_arg(strings_arg, strings.get_buffer());
+        queue.enqueue_1d_range_kernel(kernel, 0, count, 0);
+
+        ::boost::compute::inclusive_scan(runs.begin(), runs.end(), runs.begin(), queue);
+
+        // order of the strings within their runs
+        vector<uint_> order(count, context);
+        ::boost::compute::iota(order.begin(), order.end(), uint_(0), queue);
+        ::boost::compute::stable_sort_by_key(
+            windows.begin(), windows.end(), order.begin(), queue
+        );
+
+        vector<uint_> sorted_runs(count, context);
+        ::boost::compute::gather(
+            order.begin(), order.end(), runs.begin(), sorted_runs.begin(), queue
+        );
+        ::boost::compute::stable_sort_by_key(
+            sorted_runs.begin(), sorted_runs.end(), order.begin(), queue
+        );
+
+        // write the sorted strings back to the positions of their runs
+        detail::meta_kernel k2("string_column_scatter_tied");
+        positions_arg = k2.add_arg<const uint_ *>(memory_object::global_memory, "positions");
+        size_t order_arg = k2.add_arg<const uint_ *>(memory_object::global_memory, "order");
+        strings_arg = k2.add_arg<const uint_ *>(memory_object::global_memory, "strings");
+        indices_arg = k2.add_arg<uint_ *>(memory_object::global_memory, "indices");
+        k2 <<
+            "const uint j = get_global_id(0);\n" <<
+            "indices[positions[j]] = strings[order[j]];\n";
+
+        kernel = k2.compile(context);
+        kernel.set_arg(positions_arg, positions.get_buffer());
+        kernel.set_arg(order_arg, order.get_buffer());
+        kernel.set_arg(strings_arg, strings.get_buffer());
+        kernel.set_arg(indices_arg, indices.get_buffer());
+        queue.enqueue_1d_range_kernel(kernel, 0, count, 0);
+
+        // strings stay tied if their windows are equal and both continue
+        detail::meta_kernel k3("string_column_update_ties");
+        add_window_function(k3);
+        k3.add_set_arg<const uint_>("depth", depth);
+        offsets_arg = k3.add_arg<const uint_ *>(memory_object::global_memory, "offsets");
+        chars_arg = k3.add_arg<const CharT *>(memory_object::global_memory, "chars");
+        positions_arg = k3.add_arg<const uint_ *>(memory_object::global_memory, "positions");
+        indices_arg = k3.add_arg<const uint_ *>(memory_object::global_memory, "indices");
+        size_t update_ties_arg = k3.add_arg<uint_ *>(memory_object::global_memory, "ties");
+        k3 <<
+            "const uint p = positions[get_global_id(0)];\n" <<
+            "if(ties[p]){\n" <<
+            "    const ulong a = string_column_window(offsets, chars, indices[p-1], depth);\n" <<
+            "    const ulong b = string_column_window(offsets, chars, indices[p], depth);\n" <<
+            "    ties[p] = a == b && (a & 0xff) == 15;\n" <<
+            "}\n";
+
+        kernel = k3.compile(context);
+        kernel.set_arg(offsets_arg, m_offsets.get_buffer());
+        kernel.set_arg(chars_arg, m_chars.get_buffer());
+        kernel.set_arg(positions_arg, positions.get_buffer());
+        kernel.set_arg(indices_arg, indices.get_buffer());
+        kernel.set_arg(update_ties_arg, ties.get_buffer());
+        queue.enqueue_1d_range_kernel(kernel, 0, count, 0);
+    }
+
+    // returns a column with the strings at indices[i] (or at i if indices
+    // is null) for i in [0, count), truncated to max_length characters
+    basic_string_column copy_strings(const vector<uint_> *indices,
+                                     size_type count,
+                                     uint_ max_length,
+                                     command_queue &queue) const
+    {
+        const context &context = queue.get_context();
+
+        basic_string_column result(context);
+        if(count == 0){
+            return result;
+        }
+
+        const std::string source_index = indices ? "indices[i]" : "i";
+
+        // compute the offsets of the copied strings
+        vector<uint_> offsets(count + 1, context);
+
+        detail::meta_kernel lengths_kernel("string_column_copy_lengths");
+        lengths_kernel.add_set_arg<const uint_>("max_length", max_length);
+        size_t offsets_arg =
+            lengths_kernel.add_arg<const uint_ *>(memory_object::global_memory, "offsets");
+        size_t indices_arg =
+            lengths_kernel.add_arg<const uint_ *>(memory_object::global_memory, "indices");
+        size_t lengths_arg =
+            lengths_kernel.add_arg<uint_ *>(memory_object::global_memory, "lengths");
+        lengths_kernel <<
+            "const uint i = get_global_id(0);\n" <<
+            "const uint s = " << source_index << ";\n" <<
+            "lengths[i] = min(offsets[s+1] - offsets[s], max_length);\n";
+
+        kernel kernel = lengths_kernel.compile(context);
+        kernel.set_arg(offsets_arg, m_offsets.get_buffer());
+        kernel.set_arg(indices_arg, indices ? indices->get_buffer() : m_offsets.get_buffer());
+        kernel.set_arg(lengths_arg, offsets.get_buffer());
+        queue.enqueue_1d_range_kernel(kernel, 0, count, 0);
+
+        ::boost::compute::exclusive_scan(
+            offsets.begin(), offsets.end(), offsets.begin(), queue
+        );
+
+        const uint_ chars_size =
+            detail::read_single_value<uint_>(offsets.get_buffer(), count, queue);
+        vector<CharT> chars(chars_size, context);
+
+        // copy the characters of each string
+        if(chars_size > 0){
+            detail::meta_kernel k("string_column_copy_chars");
+            size_t src_offsets_arg =
+                k.add_arg<const uint_ *>(memory_object::global_memory, "src_offsets");
+            size_t src_chars_arg =
+                k.add_arg<const CharT *>(memory_object::global_memory, "src_chars");
+            size_t indices_arg =
+                k.add_arg<const uint_ *>(memory_object::global_memory, "indices");
+            size_t dst_offsets_arg =
+                k.add_arg<const uint_ *>(memory_object::global_memory, "dst_offsets");
+            size_t dst_chars_arg =
+                k.add_arg<CharT *>(memory_object::global_memory, "dst_chars");
+            k <<
+                "const uint i = get_global_id(0);\n" <<
+                "const uint src = src_offsets[" << source_index << "];\n" <<
+                "const uint dst = dst_offsets[i];\n" <<
+                "const uint length = dst_offsets[i+1] - dst;\n" <<
+                "for(uint j = 0; j < length; j++){\n" <<
+                "    dst_chars[dst + j] = src_chars[src + j];\n" <<
+                "}\n";
+
+            kernel = k.compile(context);
+            kernel.set_arg(src_offsets_arg, m_offsets.get_buffer());
+            kernel.set_arg(src_chars_arg, m_chars.get_buffer());
+            kernel.set_arg(indices_arg, indices ? indices->get_buffer() : m_offsets.get_buffer());
+            kernel.set_arg(dst_offsets_arg, offsets.get_buffer());
+            kernel.set_arg(dst_chars_arg, chars.get_buffer());
+            queue.enqueue_1d_range_kernel(kernel, 0, count, 0);
+        }
+
+        result.m_offsets.swap(offsets);
+        result.m_chars.swap(chars);
+        return result;
+    }
+
+private:
+    vector<uint_> m_offsets;
+    vector<CharT> m_chars;
+};
+
+/// A column of \c char strings (which are copied from and to
+/// \c std::string's on the host).
+typedef basic_string_column<char> string_column;
+
+} // end compute namespace
+} // end boost namespace
+
+#endif // BOOST_COMPUTE_CONTAINER_STRING_COLUMN_HPP
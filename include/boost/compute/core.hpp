@@ -23,6 +23,7 @@
 #include <boost/compute/event.hpp>
 #include <boost/compute/kernel.hpp>
 #include <boost/compute/memory_object.hpp>
+#include <boost/compute/multi_queue.hpp>
 #include <boost/compute/platform.hpp>
 #include <boost/compute/program.hpp>
 #include <boost/compute/system.hpp>
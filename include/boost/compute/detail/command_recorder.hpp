@@ -0,0 +1,86 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://boostorg.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#ifndef BOOST_COMPUTE_DETAIL_COMMAND_RECORDER_HPP
+#define BOOST_COMPUTE_DETAIL_COMMAND_RECORDER_HPP
+
+#include <cstddef>
+
+#include <boost/compute/cl.hpp>
+#include <boost/compute/detail/thread_hook.hpp>
+
+namespace boost {
+namespace compute {
+namespace detail {
+
+// interface used by kernel and command_queue to report kernel arguments
+// and enqueued commands while a command_graph is recording. commands are
+// still executed normally, the recorder only observes them.
+class command_recorder
+{
+public:
+    virtual ~command_recorder()
+    {
+    }
+
+    virtual void record_kernel_arg(cl_kernel kernel,
+                                   size_t index,
+                                   size_t size,
+                                   const void *value,
+                                   bool is_memory_object) = 0;
+
+    virtual void record_nd_range_kernel(cl_command_queue queue,
+                                        cl_kernel kernel,
+                                        size_t work_dim,
+                                        const size_t *global_work_offset,
+                                        const size_t *global_work_size,
+                                        const size_t *local_work_size) = 0;
+
+    virtual void record_write_buffer(cl_command_queue queue,
+                                     cl_mem buffer,
+                                     size_t offset,
+                                     size_t size,
+                                     const void *host_ptr) = 0;
+
+    virtual void record_read_buffer(cl_command_queue queue,
+                                    cl_mem buffer,
+                                    size_t offset,
+                                    size_t size,
+                                    void *host_ptr) = 0;
+
+    virtual void record_copy_buffer(cl_command_queue queue,
+                                    cl_mem src_buffer,
+                                    cl_mem dst_buffer,
+                                    size_t src_offset,
+                                    size_t dst_offset,
+                                    size_t size) = 0;
+
+    virtual void record_fill_buffer(cl_command_queue queue,
+                                    cl_mem buffer,
+                                    const void *pattern,
+                                    size_t pattern_size,
+                                    size_t offset,
+                                    size_t size) = 0;
+
+    // called for commands which cannot be replayed (e.g. mapping memory)
+    virtual void record_unsupported_command(cl_command_queue queue) = 0;
+};
+
+// returns the recorder which is currently active on this thread (or null)
+inline command_recorder* current_command_recorder()
+{
+    return thread_hook<command_recorder>::get();
+}
+
+} // end detail namespace
+} // end compute namespace
+} // end boost namespace
+
+#endif // BOOST_COMPUTE_DETAIL_COMMAND_RECORDER_HPP
@@ -0,0 +1,845 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://boostorg.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#ifndef BOOST_COMPUTE_DETAIL_COMMAND_TRACER_HPP
+#define BOOST_COMPUTE_DETAIL_COMMAND_TRACER_HPP
+
+#include <cstddef>
+#include <cstdlib>
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <boost/compute/cl.hpp>
+#include <boost/compute/config.hpp>
+#include <boost/compute/detail/getenv.hpp>
+#include <boost/compute/detail/thread_hook.hpp>
+
+#ifndef BOOST_COMPUTE_NO_HDR_CHRONO
+#include <chrono>
+#endif
+
+#ifndef BOOST_COMPUTE_NO_HDR_MUTEX
+#include <mutex>
+#elif defined(BOOST_COMPUTE_THREAD_SAFE)
+#include <boost/thread/lock_guard.hpp>
+#include <boost/thread/mutex.hpp>
+#endif
+
+namespace boost {
+namespace compute {
+namespace detail {
+
+// returns the current host time in nanoseconds (or zero if <chrono> is not
+// available)
+inline cl_ulong trace_clock()
+{
+    #ifndef BOOST_COMPUTE_NO_HDR_CHRONO
+    return static_cast<cl_ulong>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()
+        ).count()
+    );
+    #else
+    return 0;
+    #endif
+}
+
+// a single entry in a trace. times are in nanoseconds, host times are from
+// trace_clock() and device times from the profiling info of the command's
+// event (if the queue has profiling enabled).
+struct trace_record
+{
+    enum kind_type {
+        algorithm,
+        kernel,
+        read,
+        write,
+        copy,
+        fill,
+        map,
+        allocation,
+        build,
+        cache_hit
+    };
+
+    trace_record()
+        : kind(algorithm),
+          queue(0),
+          bytes(0),
+          work_dim(0),
+          host_start(0),
+          host_end(0),
+          device_queued(0),
+          device_start(0),
+          device_end(0),
+          profiled(false)
+    {
+        for(size_t i = 0; i < 3; i++){
+            global_work_size[i] = 0;
+            local_work_size[i] = 0;
+        }
+    }
+
+    // returns the time the command took on the device
+    cl_ulong device_time() const
+    {
+        return profiled && device_end > device_start ? device_end - device_start : 0;
+    }
+
+    // returns the time spent on the host (for algorithm calls and builds)
+    cl_ulong host_time() const
+    {
+        return host_end > host_start ? host_end - host_start : 0;
+    }
+
+    kind_type kind;
+    // algorithm or kernel name, or program cache key
+    std::string name;
+    // enclosing algorithm calls separated by '/' (e.g. "sort/exclusive_scan")
+    std::string region;
+    cl_command_queue queue;
+    size_t bytes;
+    size_t work_dim;
+    size_t global_work_size[3];
+    size_t local_work_size[3];
+    cl_ulong host_start;
+    cl_ulong host_end;
+    cl_ulong device_queued;
+    cl_ulong device_start;
+    cl_ulong device_end;
+    bool profiled;
+};
+
+inline const char* trace_kind_name(trace_record::kind_type kind)
+{
+    static const char *names[] = {
+        "algorithm", "kernel", "read", "write", "copy", "fill", "map",
+        "allocation", "build", "cache_hit"
+    };
+
+    return names[kind];
+}
+
+// interface used by algorithms, command_queue, buffer and program_cache to
+// report what they do while tracing is enabled. unlike command_recorder it
+// also sees the events of the commands in order to measure them.
+class command_tracer
+{
+public:
+    virtual ~command_tracer()
+    {
+    }
+
+    virtual void begin_algorithm(const char *name) = 0;
+
+    virtual void end_algorithm() = 0;
+
+    virtual void trace_kernel(cl_command_queue queue,
+                              const std::string &name,
+                              size_t work_dim,
+                              const size_t *global_work_size,
+                              const size_t *local_work_size,
+                              cl_event event) = 0;
+
+    virtual void trace_transfer(cl_command_queue queue,
+                                trace_record::kind_type kind,
+                                size_t bytes,
+                                cl_event event) = 0;
+
+    virtual void trace_allocation(size_t bytes) = 0;
+
+    virtual void trace_build(const std::string &key,
+                             cl_ulong host_start,
+                             cl_ulong host_end) = 0;
+
+    virtual void trace_cache_hit(const std::string &key) = 0;
+};
+
+// stores trace records and exports them as chrome trace-event json and as
+// a text summary
+class trace_log : public command_tracer
+{
+public:
+    trace_log()
+        : m_origin(trace_clock()),
+          m_first_pending(0)
+    {
+    }
+
+    ~trace_log()
+    {
+        release_events();
+    }
+
+    void begin_algorithm(const char *name)
+    {
+        trace_record record;
+        record.kind = trace_record::algorithm;
+        record.name = name;
+        record.region = current_region();
+        record.host_start = trace_clock();
+
+        region_stack().push_back(m_records.size());
+        m_records.push_back(record);
+    }
+
+    void end_algorithm()
+    {
+        std::vector<size_t> &regions = region_stack();
+        if(regions.empty()){
+            return;
+        }
+
+        m_records[regions.back()].host_end = trace_clock();
+        regions.pop_back();
+    }
+
+    void trace_kernel(cl_command_queue queue,
+                      const std::string &name,
+                      size_t work_dim,
+                      const size_t *global_work_size,
+                      const size_t *local_work_size,
+                      cl_event event)
+    {
+        trace_record record = make_command(queue, trace_record::kernel);
+        record.name = name;
+        record.work_dim = (std::min)(work_dim, size_t(3));
+        for(size_t i = 0; i < record.work_dim; i++){
+            record.global_work_size[i] = global_work_size ? global_work_size[i] : 0;
+            record.local_work_size[i] = local_work_size ? local_work_size[i] : 0;
+        }
+
+        add_command(record, event);
+    }
+
+    void trace_transfer(cl_command_queue queue,
+                        trace_record::kind_type kind,
+                        size_t bytes,
+                        cl_event event)
+    {
+        trace_record record = make_command(queue, kind);
+        record.name = trace_kind_name(kind);
+        record.bytes = bytes;
+
+        add_command(record, event);
+    }
+
+    void trace_allocation(size_t bytes)
+    {
+        trace_record record;
+        record.kind = trace_record::allocation;
+        record.name = "allocation";
+        record.region = current_region();
+        record.bytes = bytes;
+        record.host_start = record.host_end = trace_clock();
+
+        m_records.push_back(record);
+    }
+
+    void trace_build(const std::string &key, cl_ulong host_start, cl_ulong host_end)
+    {
+        trace_record record;
+        record.kind = trace_record::build;
+        record.name = key;
+        record.region = current_region();
+        record.host_start = host_start;
+        record.host_end = host_end;
+
+        m_records.push_back(record);
+    }
+
+    void trace_cache_hit(const std::string &key)
+    {
+        trace_record record;
+        record.kind = trace_record::cache_hit;
+        record.name = key;
+        record.region = current_region();
+        record.host_start = record.host_end = trace_clock();
+
+        m_records.push_back(record);
+    }
+
+    // returns the records, waiting for any commands which have not finished
+    const std::vector<trace_record>& records()
+    {
+        resolve_events(true);
+
+        return m_records;
+    }
+
+    void clear()
+    {
+        release_events();
+
+        m_records.clear();
+        region_stack().clear();
+        m_origin = trace_clock();
+    }
+
+    void write_chrome_trace(std::ostream &stream)
+    {
+        resolve_events(true);
+
+        // each queue gets its own track, device times are shifted onto the
+        // host clock using the first profiled command on the queue
+        std::map<cl_command_queue, queue_track> queues;
+        for(size_t i = 0; i < m_records.size(); i++){
+            const trace_record &record = m_records[i];
+            if(!record.queue){
+                continue;
+            }
+
+            queue_track &track = queues[record.queue];
+            if(track.id == 0){
+                track.id = queues.size();
+            }
+            if(record.profiled && !track.aligned){
+                // unsigned arithmetic wraps if the device clock is ahead
+                track.offset = record.host_start - record.device_queued;
+                track.aligned = true;
+            }
+        }
+
+        stream << "{\"traceEvents\":[\n";
+        stream << "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":1,"
+               << "\"args\":{\"name\":\"host\"}}";
+        stream << ",\n{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":2,"
+               << "\"args\":{\"name\":\"device\"}}";
+        for(std::map<cl_command_queue, queue_track>::const_iterator
+                iter = queues.begin(); iter != queues.end(); ++iter){
+            stream << ",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":2,"
+                   << "\"tid\":" << iter->second.id << ","
+                   << "\"args\":{\"name\":\"queue " << iter->second.id << "\"}}";
+        }
+
+        for(size_t i = 0; i < m_records.size(); i++){
+            const trace_record &record = m_records[i];
+
+            stream << ",\n{\"name\":\"" << escape(record.name) << "\","
+                   << "\"cat\":\"" << trace_kind_name(record.kind) << "\",";
+
+            if(record.queue){
+                const queue_track &track = queues[record.queue];
+                const cl_ulong start =
+                    record.profiled ? record.device_start + track.offset
+                                    : record.host_start;
+
+                stream << "\"ph\":\"X\",\"pid\":2,\"tid\":" << track.id << ","
+                       << "\"ts\":" << timestamp(start) << ","
+                       << "\"dur\":" << microseconds(record.device_time());
+            }
+            else if(record.kind == trace_record::algorithm ||
+                    record.kind == trace_record::build){
+                stream << "\"ph\":\"X\",\"pid\":1,\"tid\":1,"
+                       << "\"ts\":" << timestamp(record.host_start) << ","
+                       << "\"dur\":" << microseconds(record.host_time());
+            }
+            else {
+                stream << "\"ph\":\"i\",\"s\":\"t\",\"pid\":1,\"tid\":1,"
+                       << "\"ts\":" << timestamp(record.host_start);
+            }
+
+            stream << ",\"args\":{\"region\":\"" << escape(record.region) << "\"";
+            if(record.bytes){
+                stream << ",\"bytes\":" << record.bytes;
+            }
+            if(record.kind == trace_record::kernel){
+                stream << ",\"global_work_size\":\""
+                       << format_size(record.work_dim, record.global_work_size) << "\""
+                       << ",\"local_work_size\":\""
+                       << format_size(record.work_dim, record.local_work_size) << "\"";
+            }
+            stream << "}}";
+        }
+
+        stream << "\n],\"displayTimeUnit\":\"ns\"}\n";
+    }
+
+    void print_summary(std::ostream &stream)
+    {
+        resolve_events(true);
+
+        std::map<std::string, stats> algorithms;
+        std::map<std::pair<std::string, std::string>, stats> kernels;
+        std::map<std::string, stats> transfers;
+        stats allocations;
+        stats builds;
+        stats cache_hits;
+
+        for(size_t i = 0; i < m_records.size(); i++){
+            const trace_record &record = m_records[i];
+
+            stats *s = 0;
+            cl_ulong time = record.device_time();
+            switch(record.kind){
+            case trace_record::algorithm:
+                s = &algorithms[join(record.region, record.name)];
+                time = record.host_time();
+                break;
+            case trace_record::kernel:
+                s = &kernels[std::make_pair(record.region, record.name)];
+                break;
+            case trace_record::allocation:
+                s = &allocations;
+                break;
+            case trace_record::build:
+                s = &builds;
+                time = record.host_time();
+                break;
+            case trace_record::cache_hit:
+                s = &cache_hits;
+                break;
+            default:
+                s = &transfers[record.name];
+                break;
+            }
+
+            s->count++;
+            s->bytes += record.bytes;
+            s->time += time;
+        }
+
+        stream << "algorithm calls:\n";
+        stream << "  " << std::left << std::setw(40) << "name"
+               << std::right << std::setw(10) << "calls"
+               << std::setw(16) << "host (ms)" << "\n";
+        for(std::map<std::string, stats>::const_iterator
+                iter = algorithms.begin(); iter != algorithms.end(); ++iter){
+            stream << "  " << std::left << std::setw(40) << iter->first
+                   << std::right << std::setw(10) << iter->second.count
+                   << std::setw(16) << milliseconds(iter->second.time) << "\n";
+        }
+
+        stream << "kernels:\n";
+        stream << "  " << std::left << std::setw(40) << "algorithm / kernel"
+               << std::right << std::setw(10) << "launches"
+               << std::setw(16) << "device (ms)" << "\n";
+        for(std::map<std::pair<std::string, std::string>, stats>::const_iterator
+                iter = kernels.begin(); iter != kernels.end(); ++iter){
+            const std::string &region = iter->first.first;
+            const std::string name =
+                (region.empty() ? std::string("-") : region) + " / " + iter->first.second;
+
+            stream << "  " << std::left << std::setw(40) << name
+                   << std::right << std::setw(10) << iter->second.count
+                   << std::setw(16) << milliseconds(iter->second.time) << "\n";
+        }
+
+        stream << "transfers:\n";
+        stream << "  " << std::left << std::setw(40) << "type"
+               << std::right << std::setw(10) << "count"
+               << std::setw(16) << "device (ms)"
+               << std::setw(16) << "bytes" << "\n";
+        for(std::map<std::string, stats>::const_iterator
+                iter = transfers.begin(); iter != transfers.end(); ++iter){
+            stream << "  " << std::left << std::setw(40) << iter->first
+                   << std::right << std::setw(10) << iter->second.count
+                   << std::setw(16) << milliseconds(iter->second.time)
+                   << std::setw(16) << iter->second.bytes << "\n";
+        }
+
+        stream << "allocations: " << allocations.count
+               << " (" << allocations.bytes << " bytes)\n";
+        stream << "programs: " << builds.count << " built"
+               << " (" << milliseconds(builds.time) << " ms), "
+               << cache_hits.count << " cache hits\n";
+    }
+
+protected:
+    // returns the stack of the algorithm calls which are in progress (as
+    // indices of their records)
+    virtual std::vector<size_t>& region_stack()
+    {
+        return m_regions;
+    }
+
+private:
+    struct queue_track
+    {
+        queue_track() : id(0), offset(0), aligned(false) { }
+
+        size_t id;
+        cl_ulong offset;
+        bool aligned;
+    };
+
+    struct stats
+    {
+        stats() : count(0), bytes(0), time(0) { }
+
+        size_t count;
+        size_t bytes;
+        cl_ulong time;
+    };
+
+    trace_record make_command(cl_command_queue queue, trace_record::kind_type kind)
+    {
+        trace_record record;
+        record.kind = kind;
+        record.queue = queue;
+        record.region = current_region();
+        record.host_start = record.host_end = trace_clock();
+
+        return record;
+    }
+
+    void add_command(const trace_record &record, cl_event event)
+    {
+        if(event && clRetainEvent(event) == CL_SUCCESS){
+            m_pending.push_back(std::make_pair(m_records.size(), event));
+        }
+        m_records.push_back(record);
+
+        // release the events of commands which have already finished so
+        // that long traces do not hold on to every event
+        resolve_events(false);
+    }
+
+    // reads the profiling info for pending events in order, stopping at the
+    // first one which has not completed unless wait is true
+    void resolve_events(bool wait)
+    {
+        while(m_first_pending < m_pending.size()){
+            const std::pair<size_t, cl_event> &pending = m_pending[m_first_pending];
+
+            if(wait){
+                clWaitForEvents(1, &pending.second);
+            }
+            else {
+                cl_int status = CL_COMPLETE;
+                clGetEventInfo(pending.second,
+                               CL_EVENT_COMMAND_EXECUTION_STATUS,
+                               sizeof(cl_int),
+                               &status,
+                               0);
+                if(status > CL_COMPLETE){
+                    break;
+                }
+            }
+
+            trace_record &record = m_records[pending.first];
+            record.profiled =
+                clGetEventProfilingInfo(pending.second, CL_PROFILING_COMMAND_QUEUED,
+                                        sizeof(cl_ulong), &record.device_queued, 0) == CL_SUCCESS &&
+                clGetEventProfilingInfo(pending.second, CL_PROFILING_COMMAND_START,
+                                        sizeof(cl_ulong), &record.device_start, 0) == CL_SUCCESS &&
+                clGetEventProfilingInfo(pending.second, CL_PROFILING_COMMAND_END,
+                                        sizeof(cl_ulong), &record.device_end, 0) == CL_SUCCESS;
+
+            clReleaseEvent(pending.second);
+            m_first_pending++;
+        }
+
+        if(m_first_pending == m_pending.size()){
+            m_pending.clear();
+            m_first_pending = 0;
+        }
+    }
+
+    void release_events()
+    {
+        for(size_t i = m_first_pending; i < m_pending.size(); i++){
+            clReleaseEvent(m_pending[i].second);
+        }
+        m_pending.clear();
+        m_first_pending = 0;
+    }
+
+    std::string current_region()
+    {
+        const std::vector<size_t> &regions = region_stack();
+        if(regions.empty()){
+            return std::string();
+        }
+
+        const trace_record &region = m_records[regions.back()];
+        return join(region.region, region.name);
+    }
+
+    static std::string join(const std::string &region, const std::string &name)
+    {
+        return region.empty() ? name : region + "/" + name;
+    }
+
+    // returns the host time relative to the start of the trace
+    std::string timestamp(cl_ulong time) const
+    {
+        std::stringstream s;
+        s << std::fixed << std::setprecision(3)
+          << (static_cast<double>(time) - static_cast<double>(m_origin)) / 1e3;
+        return s.str();
+    }
+
+    static std::string microseconds(cl_ulong time)
+    {
+        std::stringstream s;
+        s << std::fixed << std::setprecision(3) << static_cast<double>(time) / 1e3;
+        return s.str();
+    }
+
+    static std::string milliseconds(cl_ulong time)
+    {
+        std::stringstream s;
+        s << std::fixed << std::setprecision(3) << static_cast<double>(time) / 1e6;
+        return s.str();
+    }
+
+    static std::string format_size(size_t work_dim, const size_t *size)
+    {
+        std::stringstream s;
+        for(size_t i = 0; i < work_dim; i++){
+            if(i){
+                s << "x";
+            }
+            s << size[i];
+        }
+        return s.str();
+    }
+
+    static std::string escape(const std::string &str)
+    {
+        std::string escaped;
+        for(size_t i = 0; i < str.size(); i++){
+            const char c = str[i];
+            if(c == '"' || c == '\\'){
+                escaped += '\\';
+                escaped += c;
+            }
+            else if(static_cast<unsigned char>(c) < 0x20){
+                escaped += ' ';
+            }
+            else {
+                escaped += c;
+            }
+        }
+        return escaped;
+    }
+
+private:
+    cl_ulong m_origin;
+    std::vector<trace_record> m_records;
+    std::vector<size_t> m_regions;
+    std::vector<std::pair<size_t, cl_event> > m_pending;
+    size_t m_first_pending;
+};
+
+#ifndef BOOST_COMPUTE_NO_HDR_MUTEX
+typedef std::mutex trace_mutex;
+typedef std::lock_guard<std::mutex> trace_lock;
+#elif defined(BOOST_COMPUTE_THREAD_SAFE)
+typedef ::boost::mutex trace_mutex;
+typedef ::boost::lock_guard< ::boost::mutex> trace_lock;
+#else
+// without c++11 or boost.thread the program is assumed to be single-threaded
+struct trace_mutex { };
+struct trace_lock
+{
+    explicit trace_lock(trace_mutex&) { }
+};
+#endif
+
+// trace log enabled with the BOOST_COMPUTE_TRACE environment variable. it is
+// shared by all threads without a tracer of their own, so each call takes a
+// lock and every thread keeps its own stack of algorithm calls.
+//
+// the chrome trace is written to the file named by the variable and the
+// summary to stderr from an atexit() handler. the log is never destroyed as
+// it would otherwise call into opencl during static destruction (possibly
+// after the opencl library has been unloaded). commands traced after the
+// log has been written are ignored.
+class environment_trace_log : public trace_log
+{
+public:
+    static environment_trace_log* create(const char *path)
+    {
+        environment_trace_log *log = new environment_trace_log(path);
+        instance() = log;
+        std::atexit(&environment_trace_log::write_at_exit);
+        return log;
+    }
+
+    void begin_algorithm(const char *name)
+    {
+        trace_lock lock(m_mutex);
+        if(!m_written){
+            trace_log::begin_algorithm(name);
+        }
+    }
+
+    void end_algorithm()
+    {
+        trace_lock lock(m_mutex);
+        if(!m_written){
+            trace_log::end_algorithm();
+        }
+    }
+
+    void trace_kernel(cl_command_queue queue,
+                      const std::string &name,
+                      size_t work_dim,
+                      const size_t *global_work_size,
+                      const size_t *local_work_size,
+                      cl_event event)
+    {
+        trace_lock lock(m_mutex);
+        if(!m_written){
+            trace_log::trace_kernel(
+                queue, name, work_dim, global_work_size, local_work_size, event
+            );
+        }
+    }
+
+    void trace_transfer(cl_command_queue queue,
+                        trace_record::kind_type kind,
+                        size_t bytes,
+                        cl_event event)
+    {
+        trace_lock lock(m_mutex);
+        if(!m_written){
+            trace_log::trace_transfer(queue, kind, bytes, event);
+        }
+    }
+
+    void trace_allocation(size_t bytes)
+    {
+        trace_lock lock(m_mutex);
+        if(!m_written){
+            trace_log::trace_allocation(bytes);
+        }
+    }
+
+    void trace_build(const std::string &key, cl_ulong host_start, cl_ulong host_end)
+    {
+        trace_lock lock(m_mutex);
+        if(!m_written){
+            trace_log::trace_build(key, host_start, host_end);
+        }
+    }
+
+    void trace_cache_hit(const std::string &key)
+    {
+        trace_lock lock(m_mutex);
+        if(!m_written){
+            trace_log::trace_cache_hit(key);
+        }
+    }
+
+protected:
+    std::vector<size_t>& region_stack()
+    {
+        // allocated once for each thread and never freed, like the log
+        static BOOST_COMPUTE_DETAIL_THREAD_LOCAL std::vector<size_t> *regions = 0;
+        if(!regions){
+            regions = new std::vector<size_t>;
+        }
+
+        return *regions;
+    }
+
+private:
+    explicit environment_trace_log(const char *path)
+        : m_path(path),
+          m_written(false)
+    {
+    }
+
+    static environment_trace_log*& instance()
+    {
+        static environment_trace_log *log = 0;
+        return log;
+    }
+
+    static void write_at_exit()
+    {
+        environment_trace_log *log = instance();
+
+        trace_lock lock(log->m_mutex);
+        try {
+            std::ofstream file(log->m_path.c_str());
+            log->write_chrome_trace(file);
+
+            std::cerr << "Boost.Compute trace written to " << log->m_path << "\n";
+            log->print_summary(std::cerr);
+        }
+        catch(...){
+        }
+        log->m_written = true;
+    }
+
+private:
+    std::string m_path;
+    bool m_written;
+    trace_mutex m_mutex;
+};
+
+inline command_tracer* environment_command_tracer()
+{
+    static const char *path = detail::getenv("BOOST_COMPUTE_TRACE");
+    if(!path || !*path){
+        return 0;
+    }
+
+    static environment_trace_log *log = environment_trace_log::create(path);
+    return log;
+}
+
+// returns the tracer which is currently active on this thread (or null).
+// threads without a tracer of their own use the BOOST_COMPUTE_TRACE log.
+inline command_tracer* current_command_tracer()
+{
+    if(command_tracer *tracer = thread_hook<command_tracer>::get()){
+        return tracer;
+    }
+
+    return environment_command_tracer();
+}
+
+// marks the commands enqueued during its lifetime as belonging to the
+// algorithm call with name. usage:
+//
+//   trace_scope trace("sort");
+class trace_scope
+{
+public:
+    explicit trace_scope(const char *name)
+        : m_tracer(current_command_tracer())
+    {
+        if(m_tracer){
+            m_tracer->begin_algorithm(name);
+        }
+    }
+
+    ~trace_scope()
+    {
+        if(m_tracer){
+            m_tracer->end_algorithm();
+        }
+    }
+
+private:
+    trace_scope(const trace_scope&);
+    trace_scope& operator=(const trace_scope&);
+
+private:
+    command_tracer *m_tracer;
+};
+
+} // end detail namespace
+} // end compute namespace
+} // end boost namespace
+
+#endif // BOOST_COMPUTE_DETAIL_COMMAND_TRACER_HPP
@@ -0,0 +1,114 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://boostorg.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#ifndef BOOST_COMPUTE_DETAIL_EVENT_CHAIN_HPP
+#define BOOST_COMPUTE_DETAIL_EVENT_CHAIN_HPP
+
+#include <boost/compute/cl.hpp>
+#include <boost/compute/event.hpp>
+#include <boost/compute/utility/wait_list.hpp>
+#include <boost/compute/detail/thread_hook.hpp>
+
+namespace boost {
+namespace compute {
+namespace detail {
+
+// state for the event_chain which is currently active on this thread
+struct event_chain_state
+{
+    event_chain_state(cl_command_queue queue_, bool out_of_order_)
+        : queue(queue_),
+          out_of_order(out_of_order_),
+          parent(0)
+    {
+    }
+
+    // the queue whose commands are chained
+    cl_command_queue queue;
+
+    // true if commands must be ordered through their events
+    bool out_of_order;
+
+    // events which the next command must wait for
+    wait_list pending;
+
+    // event for the last command enqueued in the chain
+    event last;
+
+    // the enclosing chain (if any)
+    event_chain_state *parent;
+};
+
+// returns the event chain which is currently active on this thread (or null)
+inline event_chain_state* current_event_chain()
+{
+    return thread_hook<event_chain_state>::get();
+}
+
+// wait list for a command enqueued on queue. if an event chain is active for
+// the queue, the command also waits for the previous command in the chain.
+class chained_wait_list
+{
+public:
+    chained_wait_list(cl_command_queue queue, const wait_list &events)
+        : m_events(&events),
+          m_chain(current_event_chain())
+    {
+        if(m_chain && m_chain->queue != queue){
+            m_chain = 0;
+        }
+
+        if(m_chain){
+            const bool wait_for_last =
+                m_chain->out_of_order && m_chain->last.get() != 0;
+
+            if(wait_for_last || !m_chain->pending.empty()){
+                m_merged = events;
+                for(size_t i = 0; i < m_chain->pending.size(); i++){
+                    m_merged.insert(m_chain->pending[i]);
+                }
+                if(wait_for_last){
+                    m_merged.insert(m_chain->last);
+                }
+                m_events = &m_merged;
+            }
+        }
+    }
+
+    uint_ size() const
+    {
+        return m_events->size();
+    }
+
+    const cl_event* get_event_ptr() const
+    {
+        return m_events->get_event_ptr();
+    }
+
+    // called with the event for the command once it has been enqueued
+    void enqueued(const event &event_)
+    {
+        if(m_chain){
+            m_chain->last = event_;
+            m_chain->pending.clear();
+        }
+    }
+
+private:
+    const wait_list *m_events;
+    wait_list m_merged;
+    event_chain_state *m_chain;
+};
+
+} // end detail namespace
+} // end compute namespace
+} // end boost namespace
+
+#endif // BOOST_COMPUTE_DETAIL_EVENT_CHAIN_HPP
@@ -0,0 +1,93 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://boostorg.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#ifndef BOOST_COMPUTE_DETAIL_HOST_PTR_ALIAS_HPP
+#define BOOST_COMPUTE_DETAIL_HOST_PTR_ALIAS_HPP
+
+#include <boost/assert.hpp>
+
+#include <boost/compute/cl.hpp>
+#include <boost/compute/buffer.hpp>
+#include <boost/compute/event.hpp>
+#include <boost/compute/command_queue.hpp>
+
+namespace boost {
+namespace compute {
+namespace detail {
+
+// returns true if the memory at offset in buffer is the host memory at
+// host_ptr. this is the case when buffer was created with use_host_ptr
+// over the same host memory (e.g. by mapped_view or host_ptr_allocator)
+// and copying between them only needs to synchronize the buffer.
+inline bool is_host_ptr_alias(const buffer &buffer,
+                              size_t offset,
+                              const void *host_ptr)
+{
+    if(!buffer.get() ||
+       !(buffer.get_memory_info<cl_mem_flags>(CL_MEM_FLAGS) & CL_MEM_USE_HOST_PTR)){
+        return false;
+    }
+
+    const char *buffer_ptr =
+        static_cast<const char *>(buffer.get_memory_info<void *>(CL_MEM_HOST_PTR));
+
+    return buffer_ptr + offset == static_cast<const char *>(host_ptr);
+}
+
+// makes the values written to the aliased host memory in
+// [offset, offset + size) visible to the device. mapping a use_host_ptr
+// buffer returns the host pointer so on devices which use the host memory
+// directly (e.g. CPUs) this does not copy anything.
+inline event sync_host_ptr_to_device(const buffer &buffer,
+                                     size_t offset,
+                                     size_t size,
+                                     command_queue &queue)
+{
+    #ifdef BOOST_COMPUTE_CL_VERSION_1_2
+    // the current contents of the buffer are not needed
+    const cl_map_flags flags = CL_MAP_WRITE_INVALIDATE_REGION;
+    #else
+    const cl_map_flags flags = CL_MAP_WRITE;
+    #endif
+
+    event map_event;
+    void *pointer = queue.enqueue_map_buffer_async(
+        buffer, flags, offset, size, map_event
+    );
+    BOOST_ASSERT(
+        pointer == static_cast<char *>(buffer.get_memory_info<void *>(CL_MEM_HOST_PTR)) + offset
+    );
+
+    return queue.enqueue_unmap_buffer(buffer, pointer, map_event);
+}
+
+// makes the values written by the device to [offset, offset + size) of the
+// buffer visible in the aliased host memory.
+inline event sync_host_ptr_to_host(const buffer &buffer,
+                                   size_t offset,
+                                   size_t size,
+                                   command_queue &queue)
+{
+    event map_event;
+    void *pointer = queue.enqueue_map_buffer_async(
+        buffer, CL_MAP_READ, offset, size, map_event
+    );
+    BOOST_ASSERT(
+        pointer == static_cast<char *>(buffer.get_memory_info<void *>(CL_MEM_HOST_PTR)) + offset
+    );
+
+    return queue.enqueue_unmap_buffer(buffer, pointer, map_event);
+}
+
+} // end detail namespace
+} // end compute namespace
+} // end boost namespace
+
+#endif // BOOST_COMPUTE_DETAIL_HOST_PTR_ALIAS_HPP
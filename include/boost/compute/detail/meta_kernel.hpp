@@ -119,6 +119,47 @@ private:
     T m_value;
 };
 
+// a literal value which is passed to the kernel as an argument instead of
+// being written into its source (see meta_kernel::hoist()). this lets the
+// same program be reused when only the value changes.
+template<class T>
+class meta_kernel_hoisted_literal
+{
+public:
+    typedef T result_type;
+
+    meta_kernel_hoisted_literal(const T &value)
+        : m_value(value)
+    {
+    }
+
+    meta_kernel_hoisted_literal(const meta_kernel_hoisted_literal &other)
+        : m_value(other.m_value)
+    {
+    }
+
+    meta_kernel_hoisted_literal& operator=(const meta_kernel_hoisted_literal &other)
+    {
+        if(this != &other){
+            m_value = other.m_value;
+        }
+
+        return *this;
+    }
+
+    ~meta_kernel_hoisted_literal()
+    {
+    }
+
+    const T& value() const
+    {
+        return m_value;
+    }
+
+private:
+    T m_value;
+};
+
 struct meta_kernel_stored_arg
 {
     meta_kernel_stored_arg()
@@ -296,7 +337,8 @@ public:
     };
 
     explicit meta_kernel(const std::string &name)
-        : m_name(name)
+        : m_name(name),
+          m_hoist_literals(true)
     {
     }
 
@@ -304,6 +346,7 @@ public:
     {
         m_source.str(other.m_source.str());
         m_options = other.m_options;
+        m_hoist_literals = other.m_hoist_literals;
     }
 
     meta_kernel& operator=(const meta_kernel &other)
@@ -311,6 +354,7 @@ public:
         if(this != &other){
             m_source.str(other.m_source.str());
             m_options = other.m_options;
+            m_hoist_literals = other.m_hoist_literals;
         }
 
         return *this;
@@ -346,9 +390,13 @@ public:
         // add external function source
         stream << m_external_function_source.str() << "\n";
 
+        // hoisted literals are passed after all other arguments
+        std::vector<std::string> args = m_args;
+        args.insert(args.end(), m_hoisted_args.begin(), m_hoisted_args.end());
+
         // add kernel source
         stream << "__kernel void " << m_name
-               << "(" << boost::join(m_args, ", ") << ")\n"
+               << "(" << boost::join(args, ", ") << ")\n"
                << "{\n" << m_source.str() << "\n}\n";
 
         return stream.str();
@@ -367,7 +415,10 @@ public:
         boost::shared_ptr<program_cache> cache =
             program_cache::get_global_cache(context);
 
-        std::string compile_options = m_options + options;
+        std::string compile_options = m_options;
+        if(!options.empty()){
+            compile_options += " " + options;
+        }
 
         // load (or build) program from cache
         ::boost::compute::program program =
@@ -385,6 +436,13 @@ public:
             }
         }
 
+        // bind hoisted literal args
+        for(size_t i = 0; i < m_hoisted_values.size(); i++){
+            const detail::meta_kernel_stored_arg &arg = m_hoisted_values[i];
+
+            kernel.set_arg(m_args.size() + i, arg.m_size, arg.m_value);
+        }
+
         // bind buffer args
         for(size_t i = 0; i < m_stored_buffers.size(); i++){
             const detail::meta_kernel_buffer_info &bi = m_stored_buffers[i];
@@ -392,6 +450,14 @@ public:
             kernel.set_arg(bi.index, bi.m_mem);
         }
 
+        // bind memory object args
+        for(size_t i = 0; i < m_stored_memory_objects.size(); i++){
+            kernel.set_arg(
+                m_stored_memory_objects[i].first,
+                m_stored_memory_objects[i].second
+            );
+        }
+
         // bind svm args
         for(size_t i = 0; i < m_stored_svm_ptrs.size(); i++){
             const detail::meta_kernel_svm_info &spi = m_stored_svm_ptrs[i];
@@ -434,7 +500,13 @@ public:
 
     void set_arg(size_t index, const memory_object &mem)
     {
-        set_arg<cl_mem>(index, mem.get());
+        // memory objects are bound with kernel::set_arg(size_t, cl_mem) in
+        // compile() so that they are seen as memory objects by the kernel
+        if(index < m_stored_args.size()){
+            m_stored_args[index] = detail::meta_kernel_stored_arg();
+        }
+
+        m_stored_memory_objects.push_back(std::make_pair(index, mem.get()));
     }
 
     void set_arg(size_t index, const image_sampler &sampler)
@@ -450,6 +522,31 @@ public:
         return index;
     }
 
+    // passes value to the kernel as an argument and returns a variable
+    // referring to it. the kernel source then only depends on the type of
+    // value and not on the value itself.
+    template<class T>
+    detail::meta_kernel_variable<T> hoist(const T &value)
+    {
+        std::string name =
+            "_lit" + boost::lexical_cast<std::string>(m_hoisted_args.size());
+
+        m_hoisted_args.push_back(decl<const T>(name));
+        m_hoisted_values.push_back(detail::meta_kernel_stored_arg(value));
+
+        return make_var<T>(name);
+    }
+
+    // returns true if hoisted literals are passed as kernel arguments
+    bool can_hoist_literals() const
+    {
+    #ifdef BOOST_COMPUTE_NO_LITERAL_HOISTING
+        return false;
+    #else
+        return m_hoist_literals;
+    #endif
+    }
+
     void add_extension_pragma(const std::string &extension,
                               const std::string &value = "enable")
     {
@@ -505,6 +602,7 @@ public:
     std::string decl(const std::string &name, const Expr &init) const
     {
         meta_kernel tmp((std::string()));
+        tmp.m_hoist_literals = false;
         tmp << tmp.decl<T>(name) << " = " << init;
         return tmp.m_source.str();
     }
@@ -570,6 +668,12 @@ public:
         return *this << literal.value();
     }
 
+    template<class T>
+    meta_kernel& operator<<(const meta_kernel_hoisted_literal<T> &literal)
+    {
+        return stream_hoisted_literal(literal.value(), is_fundamental<T>());
+    }
+
     meta_kernel& operator<<(const meta_kernel_literal<bool> &literal)
     {
         return *this << (literal.value() ? "true" : "false");
@@ -652,6 +756,12 @@ public:
         return detail::meta_kernel_literal<T>(value);
     }
 
+    template<class T>
+    static detail::meta_kernel_hoisted_literal<T> make_hoisted_lit(const T &value)
+    {
+        return detail::meta_kernel_hoisted_literal<T>(value);
+    }
+
     template<class T>
     static detail::meta_kernel_variable<T> make_expr(const std::string &expr)
     {
@@ -790,6 +900,7 @@ public:
     static std::string expr_to_string(const Expr &expr)
     {
         meta_kernel tmp((std::string()));
+        tmp.m_hoist_literals = false;
         tmp << expr;
         return tmp.m_source.str();
     }
@@ -932,6 +1043,23 @@ public:
     }
 
 private:
+    template<class T>
+    meta_kernel& stream_hoisted_literal(const T &value, boost::true_type)
+    {
+        if(can_hoist_literals()){
+            return *this << hoist(value);
+        }
+
+        return *this << lit(value);
+    }
+
+    // only built-in scalar and vector types can be passed as arguments
+    template<class T>
+    meta_kernel& stream_hoisted_literal(const T &value, boost::false_type)
+    {
+        return *this << lit(value);
+    }
+
     template<class T>
     size_t add_arg_with_qualifiers(const char *qualifiers, const std::string &name)
     {
@@ -957,6 +1085,10 @@ private:
     std::vector<detail::meta_kernel_stored_arg> m_stored_args;
     std::vector<detail::meta_kernel_buffer_info> m_stored_buffers;
     std::vector<detail::meta_kernel_svm_info> m_stored_svm_ptrs;
+    std::vector<std::pair<size_t, cl_mem> > m_stored_memory_objects;
+    std::vector<std::string> m_hoisted_args;
+    std::vector<detail::meta_kernel_stored_arg> m_hoisted_values;
+    bool m_hoist_literals;
 };
 
 template<class ResultType, class ArgTuple>
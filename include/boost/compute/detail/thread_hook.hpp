@@ -0,0 +1,74 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://boostorg.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#ifndef BOOST_COMPUTE_DETAIL_THREAD_HOOK_HPP
+#define BOOST_COMPUTE_DETAIL_THREAD_HOOK_HPP
+
+#include <boost/config.hpp>
+
+#include <boost/compute/config.hpp>
+
+// storage class for the thread-local hook pointers. the pointers are
+// trivially constructible so the compiler extensions can be used where
+// c++11 thread_local is not available.
+#if defined(BOOST_COMPUTE_HAVE_THREAD_LOCAL) || !defined(BOOST_NO_CXX11_THREAD_LOCAL)
+#  define BOOST_COMPUTE_DETAIL_THREAD_LOCAL thread_local
+#elif defined(_MSC_VER)
+#  define BOOST_COMPUTE_DETAIL_THREAD_LOCAL __declspec(thread)
+#elif defined(__GNUC__)
+#  define BOOST_COMPUTE_DETAIL_THREAD_LOCAL __thread
+#else
+#  error "Boost.Compute requires thread-local storage for its command hooks"
+#endif
+
+namespace boost {
+namespace compute {
+namespace detail {
+
+// Pointer to the Hook object (e.g. a command_recorder) which observes the
+// commands enqueued by the calling thread. Each thread has its own hook,
+// commands enqueued by other threads are not seen by it. usage:
+//
+//   Hook *previous = thread_hook<Hook>::install(&hook);
+//   ...
+//   thread_hook<Hook>::install(previous);
+template<class Hook>
+class thread_hook
+{
+public:
+    // returns the hook installed on the calling thread (or null)
+    static Hook* get()
+    {
+        return slot();
+    }
+
+    // installs hook on the calling thread and returns the previous hook
+    static Hook* install(Hook *hook)
+    {
+        Hook *&current = slot();
+        Hook *previous = current;
+        current = hook;
+        return previous;
+    }
+
+private:
+    static Hook*& slot()
+    {
+        static BOOST_COMPUTE_DETAIL_THREAD_LOCAL Hook *hook = 0;
+
+        return hook;
+    }
+};
+
+} // end detail namespace
+} // end compute namespace
+} // end boost namespace
+
+#endif // BOOST_COMPUTE_DETAIL_THREAD_HOOK_HPP
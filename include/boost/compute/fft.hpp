@@ -0,0 +1,20 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://boostorg.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#ifndef BOOST_COMPUTE_FFT_HPP
+#define BOOST_COMPUTE_FFT_HPP
+
+/// \file
+///
+/// Meta-header to include all Boost.Compute fft headers.
+
+#include <boost/compute/fft/fft_plan.hpp>
+
+#endif // BOOST_COMPUTE_FFT_HPP
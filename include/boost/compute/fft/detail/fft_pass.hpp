@@ -0,0 +1,570 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://boostorg.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#ifndef BOOST_COMPUTE_FFT_DETAIL_FFT_PASS_HPP
+#define BOOST_COMPUTE_FFT_DETAIL_FFT_PASS_HPP
+
+#include <algorithm>
+#include <cmath>
+#include <complex>
+#include <iomanip>
+#include <limits>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <boost/shared_ptr.hpp>
+#include <boost/throw_exception.hpp>
+#include <boost/type_traits/is_same.hpp>
+
+#include <boost/compute/buffer.hpp>
+#include <boost/compute/command_queue.hpp>
+#include <boost/compute/context.hpp>
+#include <boost/compute/device.hpp>
+#include <boost/compute/kernel.hpp>
+#include <boost/compute/detail/meta_kernel.hpp>
+#include <boost/compute/detail/parameter_cache.hpp>
+#include <boost/compute/types/complex.hpp>
+#include <boost/compute/type_traits/type_name.hpp>
+
+namespace boost {
+namespace compute {
+namespace detail {
+
+// Splits length into the radices of the Stockham stages. Powers of two
+// use radix 4 stages (and one radix 2 stage for odd powers) followed by
+// the radix 3 and 5 stages. Returns false if length has other factors.
+inline bool fft_factorize(size_t length, std::vector<size_t> &radices)
+{
+    radices.clear();
+    if(length == 0){
+        return false;
+    }
+
+    while(length % 4 == 0){
+        radices.push_back(4);
+        length /= 4;
+    }
+    if(length % 2 == 0){
+        radices.push_back(2);
+        length /= 2;
+    }
+    while(length % 3 == 0){
+        radices.push_back(3);
+        length /= 3;
+    }
+    while(length % 5 == 0){
+        radices.push_back(5);
+        length /= 5;
+    }
+
+    return length == 1;
+}
+
+// The position of the values of the transforms in a batch. Transform b
+// starts at (b / inner_count) * outer_distance + (b % inner_count) *
+// inner_distance and its values are stride values apart.
+struct fft_layout
+{
+    size_t length;
+    size_t stride;
+    size_t count;
+    size_t inner_count;
+    size_t inner_distance;
+    size_t outer_distance;
+};
+
+// formats value as a literal of type T with full precision
+template<class T>
+inline std::string fft_literal(const double value)
+{
+    std::stringstream stream;
+    stream << std::setprecision(std::numeric_limits<T>::digits10 + 3)
+           << std::showpoint
+           << value;
+    if(boost::is_same<T, float>::value){
+        stream << 'f';
+    }
+    return stream.str();
+}
+
+// Emits the radix butterfly computing y[k] = sum(v[j] * w^(j*k)) with
+// w = exp(sign * 2 * pi * i / radix) for the variables v0, v1, ... and
+// y0, y1, .... The multiplications with 1 and i are not emitted and for
+// odd radices v[j] and v[radix-j] are combined before the multiplication.
+template<class T>
+inline void fft_emit_butterfly(std::stringstream &s, size_t radix, int sign)
+{
+    const char *type = type_name<std::complex<T> >();
+
+    if(radix == 2){
+        s << type << " y0 = v0 + v1;\n"
+          << type << " y1 = v0 - v1;\n";
+    }
+    else if(radix == 4){
+        // sign * i * (v1 - v3)
+        s << type << " t0 = v0 + v2;\n"
+          << type << " t1 = v0 - v2;\n"
+          << type << " t2 = v1 + v3;\n"
+          << type << " t3 = v1 - v3;\n"
+          << "t3 = (" << type << ")("
+              << (sign < 0 ? "t3.y, -t3.x" : "-t3.y, t3.x") << ");\n"
+          << type << " y0 = t0 + t2;\n"
+          << type << " y1 = t1 + t3;\n"
+          << type << " y2 = t0 - t2;\n"
+          << type << " y3 = t1 - t3;\n";
+    }
+    else {
+        const size_t half = (radix - 1) / 2;
+        const double pi = 3.14159265358979323846;
+
+        for(size_t j = 1; j <= half; j++){
+            s << type << " a" << j << " = v" << j << " + v" << radix - j << ";\n"
+              << type << " b" << j << " = v" << j << " - v" << radix - j << ";\n";
+        }
+
+        s << type << " y0 = v0";
+        for(size_t j = 1; j <= half; j++){
+            s << " + a" << j;
+        }
+        s << ";\n";
+
+        for(size_t k = 1; k < radix; k++){
+            std::stringstream re;
+            std::stringstream im;
+            re << "v0.x";
+            im << "v0.y";
+            for(size_t j = 1; j <= half; j++){
+                const double angle = 2 * pi * double((j * k) % radix) / radix;
+                const std::string c = fft_literal<T>(std::cos(angle));
+                const std::string si = fft_literal<T>(sign * std::sin(angle));
+                const std::string nsi = fft_literal<T>(-sign * std::sin(angle));
+
+                re << " + (" << c << ")*a" << j << ".x + (" << nsi << ")*b" << j << ".y";
+                im << " + (" << c << ")*a" << j << ".y + (" << si << ")*b" << j << ".x";
+            }
+            s << type << " y" << k << " = (" << type << ")("
+              << re.str() << ", " << im.str() << ");\n";
+        }
+    }
+}
+
+// Emits the complex multiplication functions used for the twiddles. The
+// inverse transforms multiply with the conjugate twiddles.
+template<class T>
+inline void fft_add_functions(meta_kernel &k)
+{
+    const std::string type = type_name<std::complex<T> >();
+
+    k.add_function(
+        "fft_mul",
+        type + " fft_mul(" + type + " a, " + type + " b)\n"
+        "{\n"
+        "    return (" + type + ")(a.x*b.x - a.y*b.y, a.x*b.y + a.y*b.x);\n"
+        "}\n"
+    );
+    k.add_function(
+        "fft_mul_conj",
+        type + " fft_mul_conj(" + type + " a, " + type + " b)\n"
+        "{\n"
+        "    return (" + type + ")(a.x*b.x + a.y*b.y, a.y*b.x - a.x*b.y);\n"
+        "}\n"
+    );
+}
+
+// Returns the largest length which is transformed in local memory by
+// default, half of the local memory is used for the ping-pong buffers.
+template<class T>
+inline uint_ fft_default_max_local_length(const device &device)
+{
+    return static_cast<uint_>(
+        device.local_memory_size() / 2 / (2 * sizeof(std::complex<T>))
+    );
+}
+
+// One batched one-dimensional transform for a fixed layout. The pass
+// caches the twiddle factors and the compiled kernels of each direction.
+//
+// The transform is computed with Stockham stages. Stage s with radix r
+// combines the transforms of length ns (the product of the previous
+// radices) into transforms of length ns * r and writes them in natural
+// order, so no bit reversal is needed. If the two ping-pong buffers of a
+// transform fit into local memory all stages run in one kernel with
+// transforms_per_group transforms per work-group, otherwise each stage
+// is a kernel which reads and writes global memory.
+template<class T>
+class fft_pass
+{
+public:
+    typedef std::complex<T> value_type;
+
+    fft_pass(const fft_layout &layout, const context &context)
+        : m_layout(layout),
+          m_context(context)
+    {
+        if(!fft_factorize(layout.length, m_radices)){
+            BOOST_THROW_EXCEPTION(
+                std::invalid_argument("fft length must be a product of 2, 3 and 5")
+            );
+        }
+
+        // twiddle factors exp(-2 * pi * i * k / length)
+        const double pi = 3.14159265358979323846;
+        std::vector<value_type> twiddles(layout.length);
+        for(size_t k = 0; k < layout.length; k++){
+            const double angle = -2 * pi * double(k) / double(layout.length);
+            twiddles[k] = value_type(T(std::cos(angle)), T(std::sin(angle)));
+        }
+        m_twiddles = buffer(
+            context,
+            twiddles.size() * sizeof(value_type),
+            buffer::read_only | buffer::copy_host_ptr,
+            &twiddles[0]
+        );
+
+        const device &device = context.get_device();
+        boost::shared_ptr<parameter_cache> parameters =
+            parameter_cache::get_global_cache(device);
+        const std::string cache_key =
+            std::string("__boost_fft_") + type_name<value_type>();
+
+        const size_t local_bytes =
+            static_cast<size_t>(device.local_memory_size()) / 2;
+        const size_t max_local_length = parameters->get(
+            cache_key, "max_local_length", fft_default_max_local_length<T>(device)
+        );
+        const size_t group_size = parameters->get(cache_key, "group_size", 64);
+
+        m_local = layout.length <= max_local_length;
+
+        // threads for the stage with the most butterflies
+        m_threads_per_transform = 1;
+        for(size_t i = 0; i < m_radices.size(); i++){
+            m_threads_per_transform =
+                (std::max)(m_threads_per_transform, layout.length / m_radices[i]);
+        }
+        m_threads_per_transform = (std::min)(
+            m_threads_per_transform,
+            (std::min)(size_t(256), device.max_work_group_size())
+        );
+
+        m_transforms_per_group = 1;
+        if(m_local){
+            m_transforms_per_group = (std::max)(
+                size_t(1), group_size / m_threads_per_transform
+            );
+            m_transforms_per_group = (std::min)(
+                m_transforms_per_group,
+                (std::max)(size_t(1), local_bytes / (2 * layout.length * sizeof(value_type)))
+            );
+            m_transforms_per_group = (std::min)(
+                m_transforms_per_group, (std::max)(size_t(1), layout.count)
+            );
+        }
+        else if(layout.count != 0){
+            const size_t temp_size = layout.count * layout.length * sizeof(value_type);
+            m_temp[0] = buffer(context, temp_size);
+            if(m_radices.size() > 2){
+                m_temp[1] = buffer(context, temp_size);
+            }
+        }
+    }
+
+    // transforms the values at input_offset in input and stores the
+    // result to output_offset in output
+    void run(const buffer &input,
+             size_t input_offset,
+             const buffer &output,
+             size_t output_offset,
+             bool inverse,
+             command_queue &queue)
+    {
+        std::vector<kernel> &kernels = m_kernels[inverse ? 1 : 0];
+        if(kernels.empty()){
+            build_kernels(inverse);
+        }
+
+        if(m_local){
+            kernel &k = kernels[0];
+            set_args(k, input, input_offset, output, output_offset);
+
+            const size_t group_count =
+                (m_layout.count + m_transforms_per_group - 1) / m_transforms_per_group;
+            const size_t local_size = m_threads_per_transform * m_transforms_per_group;
+
+            queue.enqueue_1d_range_kernel(k, 0, group_count * local_size, local_size);
+            return;
+        }
+
+        const size_t stages = m_radices.size();
+        for(size_t s = 0; s < stages; s++){
+            kernel &k = kernels[s];
+
+            // ping-pong between the temporary buffers
+            const buffer &src = s == 0 ? input : m_temp[(s - 1) % 2];
+            const buffer &dst = s == stages - 1 ? output : m_temp[s % 2];
+
+            set_args(
+                k,
+                src, s == 0 ? input_offset : 0,
+                dst, s == stages - 1 ? output_offset : 0
+            );
+
+            const size_t work_items =
+                m_layout.count * (m_layout.length / m_radices[s]);
+            queue.enqueue_1d_range_kernel(k, 0, work_items, 0);
+        }
+    }
+
+private:
+    void set_args(kernel &k,
+                  const buffer &input,
+                  size_t input_offset,
+                  const buffer &output,
+                  size_t output_offset)
+    {
+        k.set_arg(0, input);
+        k.set_arg(1, static_cast<uint_>(input_offset));
+        k.set_arg(2, output);
+        k.set_arg(3, static_cast<uint_>(output_offset));
+        k.set_arg(4, m_twiddles);
+    }
+
+    void add_args(meta_kernel &k)
+    {
+        k.add_arg<value_type *>(memory_object::global_memory, "input");
+        k.add_arg<const uint_>("input_offset");
+        k.add_arg<value_type *>(memory_object::global_memory, "output");
+        k.add_arg<const uint_>("output_offset");
+        k.add_arg<value_type *>(memory_object::global_memory, "twiddles");
+
+        k.inject_type<T>();
+        fft_add_functions<T>(k);
+    }
+
+    // the offset of transform b in the layout
+    std::string layout_offset(const char *b) const
+    {
+        std::stringstream s;
+        if(m_layout.inner_count >= m_layout.count){
+            s << b << " * " << m_layout.inner_distance;
+        }
+        else {
+            s << "(" << b << " / " << m_layout.inner_count << ") * "
+              << m_layout.outer_distance << " + (" << b << " % "
+              << m_layout.inner_count << ") * " << m_layout.inner_distance;
+        }
+        return s.str();
+    }
+
+    // Emits the loads of stage s from src[base + (j + r * n / radix) *
+    // src_stride], the twiddle multiplications and the butterfly. The
+    // index of the first output value is stored in d.
+    void emit_stage(std::stringstream &s, size_t stage, bool inverse) const
+    {
+        const char *type = type_name<value_type>();
+        const size_t n = m_layout.length;
+        const size_t radix = m_radices[stage];
+        size_t ns = 1;
+        for(size_t i = 0; i < stage; i++){
+            ns *= m_radices[i];
+        }
+
+        if(ns == 1){
+            s << "const uint k = 0;\n";
+        }
+        else {
+            s << "const uint k = j % " << ns << ";\n";
+        }
+
+        for(size_t r = 0; r < radix; r++){
+            s << type << " v" << r << " = "
+              << "src[src_base + (j + " << r * (n / radix) << ") * src_stride];\n";
+            if(r != 0 && ns != 1){
+                s << "v" << r << " = " << (inverse ? "fft_mul_conj" : "fft_mul")
+                  << "(v" << r << ", twiddles[k * " << r * (n / (ns * radix)) << "]);\n";
+            }
+        }
+
+        fft_emit_butterfly<T>(s, radix, inverse ? 1 : -1);
+
+        s << "const uint d = (j / " << ns << ") * " << ns * radix << " + k;\n";
+    }
+
+    // Emits the stores of the butterfly outputs to dst[dst_base + (d + r
+    // * ns) * dst_stride], scaled for the last stage of inverse transforms.
+    void emit_store(std::stringstream &s, size_t stage, bool scale) const
+    {
+        size_t ns = 1;
+        for(size_t i = 0; i < stage; i++){
+            ns *= m_radices[i];
+        }
+
+        for(size_t r = 0; r < m_radices[stage]; r++){
+            s << "dst[dst_base + (d + " << r * ns << ") * dst_stride] = y" << r;
+            if(scale){
+                s << " * " << fft_literal<T>(1.0 / double(m_layout.length));
+            }
+            s << ";\n";
+        }
+    }
+
+    void build_kernels(bool inverse)
+    {
+        std::vector<kernel> &kernels = m_kernels[inverse ? 1 : 0];
+
+        if(m_local){
+            kernels.push_back(build_local_kernel(inverse));
+        }
+        else {
+            for(size_t s = 0; s < m_radices.size(); s++){
+                kernels.push_back(build_stage_kernel(s, inverse));
+            }
+        }
+    }
+
+    kernel build_local_kernel(bool inverse)
+    {
+        const char *type = type_name<value_type>();
+        const size_t n = m_layout.length;
+        const size_t tpt = m_threads_per_transform;
+        const size_t tpg = m_transforms_per_group;
+
+        meta_kernel k("fft_local");
+        add_args(k);
+
+        std::stringstream s;
+        s << "__local " << type << " buffer0[" << tpg * n << "];\n"
+          << "__local " << type << " buffer1[" << tpg * n << "];\n"
+          << "const uint lid = get_local_id(0);\n";
+
+        // the threads of strided transforms are interleaved so that
+        // neighbouring threads access neighbouring values
+        if(m_layout.stride == 1){
+            s << "const uint t = lid / " << tpt << ";\n"
+              << "const uint l = lid % " << tpt << ";\n";
+        }
+        else {
+            s << "const uint t = lid % " << tpg << ";\n"
+              << "const uint l = lid / " << tpg << ";\n";
+        }
+        s << "const uint b = get_group_id(0) * " << tpg << " + t;\n"
+          << "const uint base = t * " << n << ";\n"
+          << "const uint src_stride = 1;\n"
+          << "const uint dst_stride = 1;\n"
+          << "const uint src_base = base;\n"
+          << "const uint dst_base = base;\n";
+
+        // load the transform
+        s << "if(b < " << m_layout.count << "){\n"
+          << "    const uint offset = input_offset + " << layout_offset("b") << ";\n"
+          << "    for(uint i = l; i < " << n << "; i += " << tpt << "){\n"
+          << "        buffer0[base + i] = input[offset + i * " << m_layout.stride << "];\n"
+          << "    }\n"
+          << "}\n"
+          << "barrier(CLK_LOCAL_MEM_FENCE);\n";
+
+        // the stages alternate between the local buffers
+        for(size_t stage = 0; stage < m_radices.size(); stage++){
+            const char *src = stage % 2 == 0 ? "buffer0" : "buffer1";
+            const char *dst = stage % 2 == 0 ? "buffer1" : "buffer0";
+
+            s << "{\n"
+              << "__local " << type << " *src = " << src << ";\n"
+              << "__local " << type << " *dst = " << dst << ";\n"
+              << "for(uint j = l; j < " << n / m_radices[stage] << "; j += " << tpt << "){\n";
+            emit_stage(s, stage, inverse);
+            emit_store(s, stage, false);
+            s << "}\n"
+              << "}\n"
+              << "barrier(CLK_LOCAL_MEM_FENCE);\n";
+        }
+
+        // store the transform
+        const char *result = m_radices.size() % 2 == 0 ? "buffer0" : "buffer1";
+        s << "if(b < " << m_layout.count << "){\n"
+          << "    const uint offset = output_offset + " << layout_offset("b") << ";\n"
+          << "    for(uint i = l; i < " << n << "; i += " << tpt << "){\n"
+          << "        output[offset + i * " << m_layout.stride << "] = "
+          << result << "[base + i]";
+        if(inverse){
+            s << " * " << fft_literal<T>(1.0 / double(n));
+        }
+        s << ";\n"
+          << "    }\n"
+          << "}\n";
+
+        k << s.str();
+
+        return k.compile(m_context);
+    }
+
+    kernel build_stage_kernel(size_t stage, bool inverse)
+    {
+        const size_t n = m_layout.length;
+        const size_t radix = m_radices[stage];
+        const bool first = stage == 0;
+        const bool last = stage == m_radices.size() - 1;
+
+        meta_kernel k("fft_stage");
+        add_args(k);
+
+        std::stringstream s;
+        s << "const uint gid = get_global_id(0);\n"
+          << "const uint b = gid / " << n / radix << ";\n"
+          << "const uint j = gid % " << n / radix << ";\n"
+          << "__global " << type_name<value_type>() << " *src = input;\n"
+          << "__global " << type_name<value_type>() << " *dst = output;\n";
+
+        // the first stage reads and the last stage writes the layout of the
+        // transforms, the other stages use the temporary buffers
+        if(first){
+            s << "const uint src_base = input_offset + " << layout_offset("b") << ";\n"
+              << "const uint src_stride = " << m_layout.stride << ";\n";
+        }
+        else {
+            s << "const uint src_base = input_offset + b * " << n << ";\n"
+              << "const uint src_stride = 1;\n";
+        }
+        if(last){
+            s << "const uint dst_base = output_offset + " << layout_offset("b") << ";\n"
+              << "const uint dst_stride = " << m_layout.stride << ";\n";
+        }
+        else {
+            s << "const uint dst_base = output_offset + b * " << n << ";\n"
+              << "const uint dst_stride = 1;\n";
+        }
+
+        emit_stage(s, stage, inverse);
+        emit_store(s, stage, last && inverse);
+
+        k << s.str();
+
+        return k.compile(m_context);
+    }
+
+private:
+    fft_layout m_layout;
+    context m_context;
+    std::vector<size_t> m_radices;
+    buffer m_twiddles;
+    buffer m_temp[2];
+    bool m_local;
+    size_t m_threads_per_transform;
+    size_t m_transforms_per_group;
+    std::vector<kernel> m_kernels[2];
+};
+
+} // end detail namespace
+} // end compute namespace
+} // end boost namespace
+
+#endif // BOOST_COMPUTE_FFT_DETAIL_FFT_PASS_HPP
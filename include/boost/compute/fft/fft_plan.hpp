@@ -0,0 +1,184 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://boostorg.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#ifndef BOOST_COMPUTE_FFT_FFT_PLAN_HPP
+#define BOOST_COMPUTE_FFT_FFT_PLAN_HPP
+
+#include <complex>
+#include <vector>
+
+#include <boost/static_assert.hpp>
+#include <boost/type_traits/is_same.hpp>
+
+#include <boost/compute/command_queue.hpp>
+#include <boost/compute/context.hpp>
+#include <boost/compute/fft/detail/fft_pass.hpp>
+#include <boost/compute/iterator/buffer_iterator.hpp>
+
+namespace boost {
+namespace compute {
+
+/// \class fft_plan
+/// \brief Batched fast Fourier transforms of complex values.
+///
+/// The fft_plan class computes batches of one- or two-dimensional discrete
+/// Fourier transforms of \c std::complex<T> values (where \c T is \c float
+/// or \c double). The length of each dimension must be a product of 2, 3
+/// and 5 (see is_supported_length()).
+///
+/// Creating the plan uploads the twiddle factors and the kernels are
+/// compiled for the first transform in each direction. Both are reused by
+/// later transforms so a plan should be kept for repeated transforms of
+/// the same size:
+///
+/// \code
+/// // 64 transforms of 1024 values each
+/// boost::compute::fft_plan<float> plan(1024, 64, context);
+///
+/// plan.forward(signals.begin(), spectra.begin(), queue);
+/// plan.inverse(spectra.begin(), signals.begin(), queue);
+/// \endcode
+///
+/// The transforms of a batch are stored one after the other, the values of
+/// two-dimensional transforms in row-major order. The input and output may
+/// be the same range. The inverse transform is scaled by the reciprocal of
+/// the transform size so that it reverses forward().
+///
+/// Transforms which fit into local memory run all radix stages in a single
+/// kernel, larger transforms run one kernel per stage.
+template<class T>
+class fft_plan
+{
+public:
+    BOOST_STATIC_ASSERT((boost::is_same<T, float>::value ||
+                         boost::is_same<T, double>::value));
+
+    typedef T scalar_type;
+    typedef std::complex<T> value_type;
+
+    /// Creates a plan for \p batch_size one-dimensional transforms of
+    /// \p length values.
+    fft_plan(size_t length, size_t batch_size, const context &context)
+        : m_size(length),
+          m_batch_size(batch_size)
+    {
+        detail::fft_layout layout;
+        layout.length = length;
+        layout.stride = 1;
+        layout.count = batch_size;
+        layout.inner_count = batch_size;
+        layout.inner_distance = length;
+        layout.outer_distance = 0;
+
+        m_passes.push_back(detail::fft_pass<T>(layout, context));
+    }
+
+    /// Creates a plan for \p batch_size two-dimensional transforms of
+    /// \p height rows of \p width values.
+    fft_plan(size_t width, size_t height, size_t batch_size, const context &context)
+        : m_size(width * height),
+          m_batch_size(batch_size)
+    {
+        // the rows of all transforms
+        detail::fft_layout rows;
+        rows.length = width;
+        rows.stride = 1;
+        rows.count = height * batch_size;
+        rows.inner_count = height * batch_size;
+        rows.inner_distance = width;
+        rows.outer_distance = 0;
+
+        // the columns of each transform
+        detail::fft_layout columns;
+        columns.length = height;
+        columns.stride = width;
+        columns.count = width * batch_size;
+        columns.inner_count = width;
+        columns.inner_distance = 1;
+        columns.outer_distance = width * height;
+
+        m_passes.push_back(detail::fft_pass<T>(rows, context));
+        m_passes.push_back(detail::fft_pass<T>(columns, context));
+    }
+
+    /// Returns the number of values in each transform.
+    size_t size() const
+    {
+        return m_size;
+    }
+
+    /// Returns the number of transforms in the batch.
+    size_t batch_size() const
+    {
+        return m_batch_size;
+    }
+
+    /// Returns \c true if transforms of \p length values are supported.
+    static bool is_supported_length(size_t length)
+    {
+        std::vector<size_t> radices;
+
+        return detail::fft_factorize(length, radices);
+    }
+
+    /// Computes the forward transforms of the batch starting at \p first
+    /// and stores them to \p result.
+    void forward(buffer_iterator<value_type> first,
+                 buffer_iterator<value_type> result,
+                 command_queue &queue)
+    {
+        run(first, result, false, queue);
+    }
+
+    /// Computes the inverse transforms of the batch starting at \p first
+    /// and stores them to \p result.
+    void inverse(buffer_iterator<value_type> first,
+                 buffer_iterator<value_type> result,
+                 command_queue &queue)
+    {
+        run(first, result, true, queue);
+    }
+
+private:
+    void run(buffer_iterator<value_type> first,
+             buffer_iterator<value_type> result,
+             bool inverse,
+             command_queue &queue)
+    {
+        if(m_batch_size == 0){
+            return;
+        }
+
+        // the first pass reads the input, the other passes transform the
+        // result in place
+        m_passes[0].run(
+            first.get_buffer(), first.get_index(),
+            result.get_buffer(), result.get_index(),
+            inverse, queue
+        );
+        for(size_t i = 1; i < m_passes.size(); i++){
+            m_passes[i].run(
+                result.get_buffer(), result.get_index(),
+                result.get_buffer(), result.get_index(),
+                inverse, queue
+            );
+        }
+    }
+
+private:
+    size_t m_size;
+    size_t m_batch_size;
+    std::vector<detail::fft_pass<T> > m_passes;
+};
+
+} // end compute namespace
+} // end boost namespace
+
+#endif // BOOST_COMPUTE_FFT_FFT_PLAN_HPP
@@ -68,10 +68,15 @@ struct invoked_bound_function
         static const bool value = is_placeholder<nth_bound_arg>::value;
     };
 
+    // bound values of built-in types are passed to the kernel as arguments
     template<class Arg>
     struct get_arg_type
     {
-        typedef Arg type;
+        typedef typename boost::conditional<
+            is_fundamental<Arg>::value,
+            meta_kernel_hoisted_literal<Arg>,
+            Arg
+        >::type type;
     };
 
     template<int I>
@@ -102,6 +102,24 @@ inline meta_kernel& operator<<(meta_kernel &kernel,
     }
 }
 
+// half values are loaded as float values with vload_half()
+template<class IndexExpr>
+inline meta_kernel& operator<<(meta_kernel &kernel,
+                               const buffer_iterator_index_expr<half_, IndexExpr> &expr)
+{
+    kernel << "vload_half(";
+    if(expr.m_index == 0){
+        kernel << expr.m_expr;
+    }
+    else {
+        kernel << uint_(expr.m_index) << "+(" << expr.m_expr << ')';
+    }
+    return kernel <<
+               ", " <<
+               kernel.get_buffer_identifier<half_>(expr.m_buffer, expr.m_address_space) <<
+               ')';
+}
+
 } // end detail namespace
 
 /// \class buffer_iterator
@@ -26,6 +26,7 @@
 #include <boost/compute/type_traits/is_fundamental.hpp>
 #include <boost/compute/detail/get_object_info.hpp>
 #include <boost/compute/detail/assert_cl_success.hpp>
+#include <boost/compute/detail/command_recorder.hpp>
 
 namespace boost {
 namespace compute {
@@ -328,15 +329,7 @@ public:
     /// \see_opencl_ref{clSetKernelArg}
     void set_arg(size_t index, size_t size, const void *value)
     {
-        BOOST_ASSERT(index < arity());
-
-        cl_int ret = clSetKernelArg(m_kernel,
-                                    static_cast<cl_uint>(index),
-                                    size,
-                                    value);
-        if(ret != CL_SUCCESS){
-            BOOST_THROW_EXCEPTION(opencl_error(ret));
-        }
+        set_arg_value(index, size, value, false);
     }
 
     /// Sets the argument at \p index to \p value.
@@ -369,7 +362,7 @@ public:
     /// \internal_
     void set_arg(size_t index, const cl_mem mem)
     {
-        set_arg(index, sizeof(cl_mem), static_cast<const void *>(&mem));
+        set_arg_value(index, sizeof(cl_mem), static_cast<const void *>(&mem), true);
     }
 
     /// \internal_
@@ -386,6 +379,11 @@ public:
         if(ret != CL_SUCCESS){
             BOOST_THROW_EXCEPTION(opencl_error(ret));
         }
+
+        // svm pointers are not tracked by command graphs
+        if(detail::command_recorder *recorder = detail::current_command_recorder()){
+            recorder->record_unsupported_command(0);
+        }
         #else
         (void) index;
         (void) ptr;
@@ -446,6 +444,29 @@ public:
     }
 
 private:
+    /// \internal_
+    void set_arg_value(size_t index,
+                       size_t size,
+                       const void *value,
+                       bool is_memory_object)
+    {
+        BOOST_ASSERT(index < arity());
+
+        cl_int ret = clSetKernelArg(m_kernel,
+                                    static_cast<cl_uint>(index),
+                                    size,
+                                    value);
+        if(ret != CL_SUCCESS){
+            BOOST_THROW_EXCEPTION(opencl_error(ret));
+        }
+
+        if(detail::command_recorder *recorder = detail::current_command_recorder()){
+            recorder->record_kernel_arg(
+                m_kernel, index, size, value, is_memory_object
+            );
+        }
+    }
+
     #ifndef BOOST_COMPUTE_NO_VARIADIC_TEMPLATES
     /// \internal_
     template<size_t N>
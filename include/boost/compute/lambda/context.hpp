@@ -74,43 +74,79 @@ struct context : proto::callable_context<context<Args> >
     template<class T>
     void operator()(proto::tag::terminal, const T &x)
     {
-        // terminal values in lambda expressions are always literals
-        stream << stream.lit(x);
+        // terminal values in lambda expressions are passed to the kernel as
+        // arguments when possible so that new values don't need a new program
+        stream << stream.make_hoisted_lit(x);
     }
 
     void operator()(proto::tag::terminal, const uchar_ &x)
     {
-        stream << "(uchar)(" << stream.lit(uint_(x)) << "u)";
+        if(stream.can_hoist_literals()){
+            stream << stream.hoist(x);
+        }
+        else {
+            stream << "(uchar)(" << stream.lit(uint_(x)) << "u)";
+        }
     } 
 
     void operator()(proto::tag::terminal, const char_ &x)
     {
-        stream << "(char)(" << stream.lit(int_(x)) << ")";
+        if(stream.can_hoist_literals()){
+            stream << stream.hoist(x);
+        }
+        else {
+            stream << "(char)(" << stream.lit(int_(x)) << ")";
+        }
     } 
 
     void operator()(proto::tag::terminal, const ushort_ &x)
     {
-        stream << "(ushort)(" << stream.lit(x) << "u)";
+        if(stream.can_hoist_literals()){
+            stream << stream.hoist(x);
+        }
+        else {
+            stream << "(ushort)(" << stream.lit(x) << "u)";
+        }
     } 
 
     void operator()(proto::tag::terminal, const short_ &x)
     {
-        stream << "(short)(" << stream.lit(x) << ")";
+        if(stream.can_hoist_literals()){
+            stream << stream.hoist(x);
+        }
+        else {
+            stream << "(short)(" << stream.lit(x) << ")";
+        }
     } 
 
     void operator()(proto::tag::terminal, const uint_ &x)
     {
-        stream << "(" << stream.lit(x) << "u)";
+        if(stream.can_hoist_literals()){
+            stream << stream.hoist(x);
+        }
+        else {
+            stream << "(" << stream.lit(x) << "u)";
+        }
     } 
 
     void operator()(proto::tag::terminal, const ulong_ &x)
     {
-        stream << "(" << stream.lit(x) << "ul)";
+        if(stream.can_hoist_literals()){
+            stream << stream.hoist(x);
+        }
+        else {
+            stream << "(" << stream.lit(x) << "ul)";
+        }
     } 
 
     void operator()(proto::tag::terminal, const long_ &x)
     {
-        stream << "(" << stream.lit(x) << "l)";
+        if(stream.can_hoist_literals()){
+            stream << stream.hoist(x);
+        }
+        else {
+            stream << "(" << stream.lit(x) << "l)";
+        }
     } 
 
     // handle placeholders
@@ -65,13 +65,33 @@ struct svm_ptr_index_expr
         return value;
     }
 
-    const svm_ptr<T> &m_svm_ptr;
+    // stored by value so that index expressions of temporary pointers
+    // (e.g. (first + n)[i]) stay valid until the kernel is generated
+    const svm_ptr<T> m_svm_ptr;
     IndexExpr m_expr;
 };
 
 } // end detail namespace
 #endif
 
+/// \class svm_ptr
+/// \brief A pointer to shared virtual memory (SVM).
+///
+/// The svm_ptr class points to memory allocated with svm_alloc() and can
+/// be used as a device iterator with the algorithms. For example, to sort
+/// data in shared virtual memory:
+///
+/// \code
+/// boost::compute::svm_ptr<int> ptr =
+///     boost::compute::svm_alloc<int>(context, n);
+/// boost::compute::copy(host.begin(), host.end(), ptr, queue);
+///
+/// boost::compute::sort(ptr, ptr + n, queue);
+/// \endcode
+///
+/// \opencl_version_warning{2,0}
+///
+/// \see svm_alloc(), svm_free()
 template<class T>
 class svm_ptr
 {
@@ -115,18 +135,61 @@ public:
         return m_ptr;
     }
 
-    svm_ptr<T> operator+(difference_type n)
+    svm_ptr<T> operator+(difference_type n) const
     {
         return svm_ptr<T>(m_ptr + n, m_context);
     }
 
-    difference_type operator-(svm_ptr<T> other)
+    svm_ptr<T> operator-(difference_type n) const
+    {
+        return svm_ptr<T>(m_ptr - n, m_context);
+    }
+
+    difference_type operator-(const svm_ptr<T> &other) const
     {
         BOOST_ASSERT(other.m_context == m_context);
         return m_ptr - other.m_ptr;
     }
 
-    context& get_context() const
+    svm_ptr<T>& operator+=(difference_type n)
+    {
+        m_ptr += n;
+        return *this;
+    }
+
+    svm_ptr<T>& operator-=(difference_type n)
+    {
+        m_ptr -= n;
+        return *this;
+    }
+
+    svm_ptr<T>& operator++()
+    {
+        ++m_ptr;
+        return *this;
+    }
+
+    svm_ptr<T> operator++(int)
+    {
+        svm_ptr<T> tmp(*this);
+        ++m_ptr;
+        return tmp;
+    }
+
+    svm_ptr<T>& operator--()
+    {
+        --m_ptr;
+        return *this;
+    }
+
+    svm_ptr<T> operator--(int)
+    {
+        svm_ptr<T> tmp(*this);
+        --m_ptr;
+        return tmp;
+    }
+
+    const context& get_context() const
     {
         return m_context;
     }
@@ -141,6 +204,26 @@ public:
         return (other.m_context != m_context) || (m_ptr != other.m_ptr);
     }
 
+    bool operator<(const svm_ptr<T>& other) const
+    {
+        return m_ptr < other.m_ptr;
+    }
+
+    bool operator>(const svm_ptr<T>& other) const
+    {
+        return m_ptr > other.m_ptr;
+    }
+
+    bool operator<=(const svm_ptr<T>& other) const
+    {
+        return m_ptr <= other.m_ptr;
+    }
+
+    bool operator>=(const svm_ptr<T>& other) const
+    {
+        return m_ptr >= other.m_ptr;
+    }
+
     // svm functions require OpenCL 2.0
     #if defined(BOOST_COMPUTE_CL_VERSION_2_0) || defined(BOOST_COMPUTE_DOXYGEN_INVOKED)
     /// \internal_
@@ -0,0 +1,333 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://boostorg.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#ifndef BOOST_COMPUTE_MULTI_QUEUE_HPP
+#define BOOST_COMPUTE_MULTI_QUEUE_HPP
+
+#include <cmath>
+#include <algorithm>
+#include <vector>
+
+#include <boost/assert.hpp>
+#include <boost/throw_exception.hpp>
+
+#include <boost/compute/cl.hpp>
+#include <boost/compute/device.hpp>
+#include <boost/compute/context.hpp>
+#include <boost/compute/command_queue.hpp>
+#include <boost/compute/exception/opencl_error.hpp>
+
+namespace boost {
+namespace compute {
+
+/// \class multi_queue
+/// \brief A set of command queues, one per device, used to split the work
+///        of an algorithm across several devices.
+///
+/// The multi_queue class holds a command queue for each device which should
+/// take part in a computation along with a weight for each device. The
+/// algorithms which accept a multi_queue (currently \c transform(),
+/// \c reduce(), \c sort() and \c copy_if()) partition their input range
+/// into one contiguous part per device, sized proportionally to the weights,
+/// and process the parts concurrently.
+///
+/// All of the queues must share a single context so that the buffers
+/// passed to the algorithms are accessible from every device. The devices
+/// read their parts of the input directly. As OpenCL does not define
+/// concurrent writes to one buffer from several command queues, each device
+/// writes its part of the output to a temporary buffer of its own and the
+/// parts are copied to the output on the first queue. This works well with
+/// sub-devices created with device::partition_equally() or
+/// device::partition_by_affinity_domain() as well as with devices which
+/// share host memory.
+///
+/// For example, to sort a vector on both NUMA nodes of a CPU:
+/// \code
+/// std::vector<device> nodes = cpu.partition_by_affinity_domain(
+///     CL_DEVICE_AFFINITY_DOMAIN_NUMA
+/// );
+/// context context(nodes);
+/// multi_queue queues(context);
+///
+/// vector<float> vec(n, context);
+/// ...
+/// sort(vec.begin(), vec.end(), queues);
+/// \endcode
+///
+/// The initial weight of each device is its number of compute units
+/// multiplied by its clock frequency. When load balancing is enabled and
+/// the queues were created with profiling enabled (the default for the
+/// multi_queue(const context&) constructor), the weights are updated after
+/// every algorithm with the throughput measured on each device so that
+/// later calls give faster devices a larger share of the work.
+///
+/// \see command_queue, device::partition()
+class multi_queue
+{
+public:
+    /// Creates an empty multi_queue.
+    multi_queue()
+        : m_load_balancing(true)
+    {
+    }
+
+    /// Creates a multi_queue with one command queue for each device in
+    /// \p context. Profiling is enabled on the queues so that their
+    /// throughput can be measured.
+    explicit multi_queue(const context &context,
+                         cl_command_queue_properties properties =
+                             command_queue::enable_profiling)
+        : m_load_balancing(true)
+    {
+        std::vector<device> devices = context.get_devices();
+        for(size_t i = 0; i < devices.size(); i++){
+            add_queue(command_queue(context, devices[i], properties));
+        }
+    }
+
+    /// Creates a multi_queue from \p queues. All of the queues must have
+    /// been created in the same context.
+    explicit multi_queue(const std::vector<command_queue> &queues)
+        : m_load_balancing(true)
+    {
+        for(size_t i = 0; i < queues.size(); i++){
+            add_queue(queues[i]);
+        }
+    }
+
+    /// Creates a new multi_queue object as a copy of \p other.
+    multi_queue(const multi_queue &other)
+        : m_queues(other.m_queues),
+          m_weights(other.m_weights),
+          m_load_balancing(other.m_load_balancing)
+    {
+    }
+
+    /// Copies the multi_queue object from \p other to \c *this.
+    multi_queue& operator=(const multi_queue &other)
+    {
+        if(this != &other){
+            m_queues = other.m_queues;
+            m_weights = other.m_weights;
+            m_load_balancing = other.m_load_balancing;
+        }
+
+        return *this;
+    }
+
+    /// Destroys the multi_queue object.
+    ~multi_queue()
+    {
+    }
+
+    /// Adds \p queue to the set of queues with an initial weight estimated
+    /// from the properties of its device.
+    void add_queue(const command_queue &queue)
+    {
+        if(!m_queues.empty() &&
+           m_queues.front().get_context() != queue.get_context()){
+            BOOST_THROW_EXCEPTION(opencl_error(CL_INVALID_CONTEXT));
+        }
+
+        const device device = queue.get_device();
+
+        m_queues.push_back(queue);
+        m_weights.push_back(
+            (std::max)(
+                static_cast<double>(device.compute_units()) *
+                static_cast<double>(device.clock_frequency()),
+                1.0
+            )
+        );
+    }
+
+    /// Returns the number of queues.
+    size_t size() const
+    {
+        return m_queues.size();
+    }
+
+    /// Returns \c true if there are no queues.
+    bool empty() const
+    {
+        return m_queues.empty();
+    }
+
+    /// Returns the queue at \p index.
+    command_queue& get_queue(size_t index)
+    {
+        BOOST_ASSERT(index < m_queues.size());
+
+        return m_queues[index];
+    }
+
+    /// \overload
+    const command_queue& get_queue(size_t index) const
+    {
+        BOOST_ASSERT(index < m_queues.size());
+
+        return m_queues[index];
+    }
+
+    /// Returns the queues.
+    const std::vector<command_queue>& get_queues() const
+    {
+        return m_queues;
+    }
+
+    /// Returns the context shared by the queues.
+    context get_context() const
+    {
+        BOOST_ASSERT(!m_queues.empty());
+
+        return m_queues.front().get_context();
+    }
+
+    /// Returns the weight of the queue at \p index.
+    double get_weight(size_t index) const
+    {
+        BOOST_ASSERT(index < m_weights.size());
+
+        return m_weights[index];
+    }
+
+    /// Returns the weights for each queue.
+    const std::vector<double>& get_weights() const
+    {
+        return m_weights;
+    }
+
+    /// Sets the weights for each queue to \p weights. Only the ratios
+    /// between the weights are significant.
+    void set_weights(const std::vector<double> &weights)
+    {
+        if(weights.size() != m_queues.size()){
+            BOOST_THROW_EXCEPTION(opencl_error(CL_INVALID_VALUE));
+        }
+        for(size_t i = 0; i < weights.size(); i++){
+            if(!(weights[i] > 0.0)){
+                BOOST_THROW_EXCEPTION(opencl_error(CL_INVALID_VALUE));
+            }
+        }
+
+        m_weights = weights;
+    }
+
+    /// Returns \c true if the weights are updated from the throughput
+    /// measured by the algorithms.
+    bool load_balancing() const
+    {
+        return m_load_balancing;
+    }
+
+    /// Enables or disables updating the weights from the throughput
+    /// measured by the algorithms.
+    void set_load_balancing(bool enable)
+    {
+        m_load_balancing = enable;
+    }
+
+    /// Returns \c true if the throughput of the queue at \p index can be
+    /// measured (i.e. it was created with profiling enabled).
+    bool can_measure(size_t index) const
+    {
+        return (get_queue(index).get_properties() &
+                    command_queue::enable_profiling) != 0;
+    }
+
+    /// Returns the offsets which split \p count elements into one
+    /// contiguous part per queue proportionally to the weights. The
+    /// returned vector has size() + 1 entries, the part for queue \c i is
+    /// [\c offsets[i], \c offsets[i+1]).
+    std::vector<size_t> partition(size_t count) const
+    {
+        std::vector<size_t> offsets(m_queues.size() + 1, 0);
+
+        double total = 0;
+        for(size_t i = 0; i < m_weights.size(); i++){
+            total += m_weights[i];
+        }
+
+        double sum = 0;
+        for(size_t i = 1; i < m_queues.size(); i++){
+            sum += m_weights[i-1];
+
+            size_t offset =
+                static_cast<size_t>(std::floor(sum / total * count + 0.5));
+            offsets[i] = (std::min)((std::max)(offset, offsets[i-1]), count);
+        }
+        offsets[m_queues.size()] = count;
+
+        return offsets;
+    }
+
+    /// Updates the weights with the throughput of each queue given the
+    /// number of elements processed (\p counts) and the time it took in
+    /// nanoseconds (\p nanoseconds). Queues which did not process any
+    /// elements keep their weight.
+    void update_weights(const std::vector<size_t> &counts,
+                        const std::vector<double> &nanoseconds)
+    {
+        BOOST_ASSERT(counts.size() == m_queues.size());
+        BOOST_ASSERT(nanoseconds.size() == m_queues.size());
+
+        // blend the measured throughput with the current weights, scaled so
+        // that the total weight of the measured queues is unchanged
+        double old_total = 0;
+        double measured_total = 0;
+        for(size_t i = 0; i < m_queues.size(); i++){
+            if(counts[i] != 0 && nanoseconds[i] > 0){
+                old_total += m_weights[i];
+                measured_total += counts[i] / nanoseconds[i];
+            }
+        }
+        if(measured_total == 0){
+            return;
+        }
+
+        for(size_t i = 0; i < m_queues.size(); i++){
+            if(counts[i] != 0 && nanoseconds[i] > 0){
+                const double measured =
+                    counts[i] / nanoseconds[i] / measured_total * old_total;
+
+                m_weights[i] = 0.5 * m_weights[i] + 0.5 * measured;
+            }
+        }
+    }
+
+    /// Flushes all of the queues.
+    void flush()
+    {
+        for(size_t i = 0; i < m_queues.size(); i++){
+            m_queues[i].flush();
+        }
+    }
+
+    /// Blocks until all of the commands in all of the queues have
+    /// completed.
+    void finish()
+    {
+        flush();
+
+        for(size_t i = 0; i < m_queues.size(); i++){
+            m_queues[i].finish();
+        }
+    }
+
+private:
+    std::vector<command_queue> m_queues;
+    std::vector<double> m_weights;
+    bool m_load_balancing;
+};
+
+} // end compute namespace
+} // end boost namespace
+
+#endif // BOOST_COMPUTE_MULTI_QUEUE_HPP
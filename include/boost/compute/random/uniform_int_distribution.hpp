@@ -92,15 +92,10 @@ public:
             size = std::distance(tmp2_iter, tmp2.end());
         }
 
-        BOOST_COMPUTE_FUNCTION(IntType, scale_random, (const g_result_type x),
-        {
-            return LO + (x % (HI-LO+1));
-        });
-
-        scale_random.define("LO", boost::lexical_cast<std::string>(m_a));
-        scale_random.define("HI", boost::lexical_cast<std::string>(m_b));
-
-        transform(tmp2.begin(), tmp2.end(), first, scale_random, queue);
+        // the bounds are passed as kernel arguments (rather than defined in
+        // the function source) so that new bounds don't require a rebuild
+        transform(tmp2.begin(), tmp2.end(), first,
+                  m_a + (_1 % (m_b - m_a + 1)), queue);
     }
 
 private:
@@ -63,6 +63,7 @@ BOOST_COMPUTE_DEFINE_TYPE_NAME_FUNCTIONS(long)
 BOOST_COMPUTE_DEFINE_TYPE_NAME_FUNCTIONS(ulong)
 BOOST_COMPUTE_DEFINE_TYPE_NAME_FUNCTIONS(float)
 BOOST_COMPUTE_DEFINE_TYPE_NAME_FUNCTIONS(double)
+BOOST_COMPUTE_DEFINE_SCALAR_TYPE_NAME_FUNCTION(half)
 
 /// \internal_
 #define BOOST_COMPUTE_DEFINE_BUILTIN_TYPE_NAME_FUNCTION(type) \
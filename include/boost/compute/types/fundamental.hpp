@@ -36,6 +36,126 @@ typedef cl_ulong ulong_;
 typedef cl_float float_;
 typedef cl_double double_;
 
+// half-precision storage type. Only the 16 bits of the value are stored,
+// the conversions to and from float are done in software. On the device
+// half values are loaded with vload_half() and stored with vstore_half()
+// and all computations are done with float values which works on devices
+// without the cl_khr_fp16 extension.
+class half_
+{
+public:
+    half_()
+        : m_bits(0)
+    {
+    }
+
+    half_(const float value)
+        : m_bits(from_float(value))
+    {
+    }
+
+    operator float() const
+    {
+        return to_float(m_bits);
+    }
+
+    cl_ushort bits() const
+    {
+        return m_bits;
+    }
+
+    static half_ from_bits(const cl_ushort bits)
+    {
+        half_ value;
+        value.m_bits = bits;
+        return value;
+    }
+
+private:
+    // rounds to the nearest even value like vstore_half()
+    static cl_ushort from_float(const float value)
+    {
+        cl_uint x;
+        std::memcpy(&x, &value, sizeof(x));
+
+        const cl_uint sign = (x >> 16) & 0x8000;
+        const cl_uint abs = x & 0x7fffffff;
+
+        // infinity and nan
+        if(abs >= 0x7f800000){
+            return static_cast<cl_ushort>(
+                sign | 0x7c00 |
+                (abs > 0x7f800000 ? 0x200 | ((abs >> 13) & 0x3ff) : 0)
+            );
+        }
+
+        // overflow to infinity (65520 and above)
+        if(abs >= 0x477ff000){
+            return static_cast<cl_ushort>(sign | 0x7c00);
+        }
+
+        // subnormal half values and zero (below 2^-14)
+        if(abs < 0x38800000){
+            if(abs <= 0x33000000){
+                return static_cast<cl_ushort>(sign);
+            }
+
+            const cl_uint mantissa = (abs & 0x7fffff) | 0x800000;
+            const cl_uint shift = 126 - (abs >> 23);
+            const cl_uint remainder = mantissa & ((1u << shift) - 1);
+            const cl_uint halfway = 1u << (shift - 1);
+
+            cl_uint bits = mantissa >> shift;
+            if(remainder > halfway || (remainder == halfway && (bits & 1))){
+                bits++;
+            }
+            return static_cast<cl_ushort>(sign | bits);
+        }
+
+        // normal values, a carry out of the mantissa increments the exponent
+        cl_uint bits = (abs - 0x38000000) >> 13;
+        const cl_uint remainder = abs & 0x1fff;
+        if(remainder > 0x1000 || (remainder == 0x1000 && (bits & 1))){
+            bits++;
+        }
+        return static_cast<cl_ushort>(sign | bits);
+    }
+
+    static float to_float(const cl_ushort bits)
+    {
+        const cl_uint sign = static_cast<cl_uint>(bits & 0x8000) << 16;
+        const cl_uint exponent = (bits >> 10) & 0x1f;
+        cl_uint mantissa = bits & 0x3ff;
+
+        cl_uint x;
+        if(exponent == 0x1f){
+            x = sign | 0x7f800000 | (mantissa << 13);
+        }
+        else if(exponent != 0){
+            x = sign | ((exponent + 112) << 23) | (mantissa << 13);
+        }
+        else if(mantissa == 0){
+            x = sign;
+        }
+        else {
+            // normalize subnormal values
+            cl_uint e = 113;
+            while(!(mantissa & 0x400)){
+                mantissa <<= 1;
+                e--;
+            }
+            x = sign | (e << 23) | ((mantissa & 0x3ff) << 13);
+        }
+
+        float value;
+        std::memcpy(&value, &x, sizeof(value));
+        return value;
+    }
+
+private:
+    cl_ushort m_bits;
+};
+
 // converts uchar to ::boost::compute::uchar_
 #define BOOST_COMPUTE_MAKE_SCALAR_TYPE(scalar) \
     BOOST_PP_CAT(::boost::compute::scalar, _)
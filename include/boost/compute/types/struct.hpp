@@ -19,6 +19,7 @@
 #include <boost/preprocessor/stringize.hpp>
 #include <boost/preprocessor/seq/fold_left.hpp>
 #include <boost/preprocessor/seq/for_each.hpp>
+#include <boost/preprocessor/seq/size.hpp>
 #include <boost/preprocessor/seq/transform.hpp>
 
 #include <boost/compute/type_traits/type_definition.hpp>
@@ -47,6 +48,12 @@ inline std::string adapt_struct_insert_member(T (Struct::*)[N], const char *name
     return s.str();
 }
 
+// Lists the members of a struct adapted with BOOST_COMPUTE_ADAPT_STRUCT().
+// The static for_each() function calls visitor(&Struct::member, "member")
+// for each member in the order given to the macro.
+template<class Struct>
+struct adapted_struct_members;
+
 } // end detail namespace
 } // end compute namespace
 } // end boost namespace
@@ -57,6 +64,10 @@ inline std::string adapt_struct_insert_member(T (Struct::*)[N], const char *name
            &type::member, BOOST_PP_STRINGIZE(member) \
        )
 
+/// \internal_
+#define BOOST_COMPUTE_DETAIL_ADAPT_STRUCT_VISIT_MEMBER(r, type, member) \
+    visitor(&type::member, BOOST_PP_STRINGIZE(member));
+
 /// \internal_
 #define BOOST_COMPUTE_DETAIL_ADAPT_STRUCT_STREAM_MEMBER(r, data, i, elem) \
     BOOST_PP_EXPR_IF(i, << ", ") << data.elem
@@ -168,6 +179,22 @@ inline std::string adapt_struct_insert_member(T (Struct::*)[N], const char *name
                ) \
                << "}"; \
     } \
+    template<> \
+    struct adapted_struct_members<type> \
+    { \
+        static const size_t size = \
+            BOOST_PP_SEQ_SIZE(BOOST_COMPUTE_PP_TUPLE_TO_SEQ(members)); \
+        \
+        template<class Visitor> \
+        static void for_each(Visitor &visitor) \
+        { \
+            BOOST_PP_SEQ_FOR_EACH( \
+                BOOST_COMPUTE_DETAIL_ADAPT_STRUCT_VISIT_MEMBER, \
+                type, \
+                BOOST_COMPUTE_PP_TUPLE_TO_SEQ(members) \
+            ) \
+        } \
+    }; \
     }}}
 
 #endif // BOOST_COMPUTE_TYPES_STRUCT_HPP
@@ -11,9 +11,12 @@
 #ifndef BOOST_COMPUTE_UTILITY_HPP
 #define BOOST_COMPUTE_UTILITY_HPP
 
+#include <boost/compute/utility/command_graph.hpp>
 #include <boost/compute/utility/dim.hpp>
 #include <boost/compute/utility/extents.hpp>
 #include <boost/compute/utility/invoke.hpp>
+#include <boost/compute/utility/numa.hpp>
+#include <boost/compute/utility/profiler.hpp>
 #include <boost/compute/utility/program_cache.hpp>
 #include <boost/compute/utility/source.hpp>
 #include <boost/compute/utility/wait_list.hpp>
@@ -0,0 +1,679 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://boostorg.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#ifndef BOOST_COMPUTE_UTILITY_COMMAND_GRAPH_HPP
+#define BOOST_COMPUTE_UTILITY_COMMAND_GRAPH_HPP
+
+#include <map>
+#include <vector>
+#include <cstring>
+
+#include <boost/assert.hpp>
+#include <boost/noncopyable.hpp>
+
+#include <boost/compute/buffer.hpp>
+#include <boost/compute/event.hpp>
+#include <boost/compute/kernel.hpp>
+#include <boost/compute/exception.hpp>
+#include <boost/compute/command_queue.hpp>
+#include <boost/compute/utility/wait_list.hpp>
+#include <boost/compute/detail/command_recorder.hpp>
+
+namespace boost {
+namespace compute {
+
+/// \class command_graph
+/// \brief Records a sequence of commands and replays them later.
+///
+/// The command_graph class captures the kernels, kernel arguments and memory
+/// transfers enqueued on a command queue while it is recording. Once recorded,
+/// the whole sequence can be replayed with a single call to replay(). This
+/// avoids the host-side cost of generating kernel source, looking up programs
+/// in the cache, creating kernels and allocating temporary buffers each time
+/// the same sequence of algorithms is run.
+///
+/// Commands are executed normally while they are recorded, so the results of
+/// the recording pass are valid. Temporary buffers allocated by algorithms
+/// during recording are kept alive by the graph and reused on every replay.
+///
+/// For example, to record a pipeline once and replay it with new input:
+/// \code
+/// boost::compute::command_graph graph(queue);
+///
+/// graph.begin_recording();
+/// boost::compute::transform(
+///     input.begin(), input.end(), output.begin(), _1 * 2 + 1, queue
+/// );
+/// boost::compute::sort(output.begin(), output.end(), queue);
+/// graph.end_recording();
+///
+/// // run the same pipeline on a different input vector
+/// graph.rebind(input.get_buffer(), other_input.get_buffer());
+/// graph.replay().wait();
+/// \endcode
+///
+/// Values which algorithms compute on the host during recording (e.g. the
+/// number of elements written by copy_if() or the sizes of intermediate
+/// results) are fixed at the time of recording. Reads from device memory to
+/// host memory are only replayed if their host pointer has been bound with
+/// rebind(), and writes from host memory replay a copy of the data taken
+/// during recording unless their host pointer has been bound.
+///
+/// Commands which cannot be replayed (e.g. mapping memory, image and SVM
+/// commands) may still be used while recording, but they make the graph
+/// non-replayable (see replayable()).
+///
+/// \see command_queue, program_cache
+class command_graph : private detail::command_recorder, boost::noncopyable
+{
+public:
+    /// Creates a new, empty command graph which records commands enqueued
+    /// on \p queue.
+    explicit command_graph(const command_queue &queue)
+        : m_queue(queue),
+          m_recording(false),
+          m_replayable(true),
+          m_bindings_dirty(true)
+    {
+    }
+
+    /// Destroys the command graph.
+    ~command_graph()
+    {
+        if(m_recording){
+            end_recording();
+        }
+    }
+
+    /// Returns the command queue the graph records commands from.
+    const command_queue& get_queue() const
+    {
+        return m_queue;
+    }
+
+    /// Starts recording commands enqueued on the graph's queue by the
+    /// current thread.
+    ///
+    /// Only one command graph may record at a time on each thread.
+    void begin_recording()
+    {
+        BOOST_ASSERT(!m_recording);
+        BOOST_ASSERT(detail::current_command_recorder() == 0);
+
+        detail::thread_hook<detail::command_recorder>::install(this);
+        m_recording = true;
+    }
+
+    /// Stops recording commands.
+    void end_recording()
+    {
+        BOOST_ASSERT(m_recording);
+
+        detail::thread_hook<detail::command_recorder>::install(0);
+        m_recording = false;
+        m_bindings_dirty = true;
+
+        // arguments set on kernels which were never enqueued are not needed
+        m_kernel_args.clear();
+    }
+
+    /// Returns \c true if the graph is currently recording.
+    bool is_recording() const
+    {
+        return m_recording;
+    }
+
+    /// Returns the number of recorded commands.
+    size_t size() const
+    {
+        return m_commands.size();
+    }
+
+    /// Returns \c true if no commands have been recorded.
+    bool empty() const
+    {
+        return m_commands.empty();
+    }
+
+    /// Returns \c false if a command which cannot be replayed was enqueued
+    /// while recording.
+    bool replayable() const
+    {
+        return m_replayable;
+    }
+
+    /// Removes all recorded commands, bindings and retained memory objects.
+    void clear()
+    {
+        BOOST_ASSERT(!m_recording);
+
+        m_commands.clear();
+        m_memory_objects.clear();
+        m_buffer_bindings.clear();
+        m_host_bindings.clear();
+        m_replayable = true;
+        m_bindings_dirty = true;
+    }
+
+    /// Replaces \p old_buffer with \p new_buffer in every recorded command
+    /// on subsequent replays. The new buffer must be at least as large as
+    /// the region of \p old_buffer used by the recorded commands.
+    void rebind(const buffer &old_buffer, const buffer &new_buffer)
+    {
+        BOOST_ASSERT(new_buffer.get_context() == m_queue.get_context());
+
+        m_buffer_bindings[old_buffer.get()] = new_buffer;
+        m_bindings_dirty = true;
+    }
+
+    /// Replaces the host pointer \p old_ptr with \p new_ptr on subsequent
+    /// replays. Recorded writes will read from \p new_ptr and recorded reads
+    /// into \p old_ptr will write to \p new_ptr.
+    ///
+    /// Passing the same pointer for both arguments replays transfers
+    /// directly from and to the original host memory.
+    void rebind(const void *old_ptr, void *new_ptr)
+    {
+        m_host_bindings[old_ptr] = host_binding(new_ptr, true);
+        m_bindings_dirty = true;
+    }
+
+    /// \overload
+    ///
+    /// A read-only host pointer is only used as the source of recorded
+    /// writes; reads into \p old_ptr are not replayed.
+    void rebind(const void *old_ptr, const void *new_ptr)
+    {
+        m_host_bindings[old_ptr] = host_binding(new_ptr, false);
+        m_bindings_dirty = true;
+    }
+
+    /// Enqueues all recorded commands to \p queue and returns an event for
+    /// the last command. The first command waits for \p events.
+    ///
+    /// Host memory bound with rebind() must remain valid until the returned
+    /// event has completed.
+    ///
+    /// Throws an opencl_error with \c CL_INVALID_OPERATION if the graph is
+    /// not replayable.
+    event replay(command_queue &queue, const wait_list &events = wait_list())
+    {
+        BOOST_ASSERT(!m_recording);
+        BOOST_ASSERT(queue.get_context() == m_queue.get_context());
+
+        if(!m_replayable){
+            BOOST_THROW_EXCEPTION(opencl_error(CL_INVALID_OPERATION));
+        }
+
+        if(m_bindings_dirty){
+            resolve_bindings();
+        }
+
+        // commands on an out-of-order queue are chained through their events
+        const bool out_of_order =
+            (queue.get_properties() & CL_QUEUE_OUT_OF_ORDER_EXEC_MODE_ENABLE) != 0;
+
+        event last;
+        for(size_t i = 0; i < m_commands.size(); i++){
+            recorded_command &command = m_commands[i];
+
+            // the first enqueued command waits for events
+            wait_list command_events;
+            if(!last.get()){
+                command_events = events;
+            }
+            else if(out_of_order){
+                command_events.insert(last);
+            }
+
+            switch(command.type){
+            case recorded_command::nd_range_kernel:
+                last = replay_kernel(queue, command, command_events);
+                break;
+            case recorded_command::write_buffer:
+                last = queue.enqueue_write_buffer_async(
+                    command.dst, command.dst_offset, command.size,
+                    command.resolved_host_ptr, command_events
+                );
+                break;
+            case recorded_command::read_buffer:
+                if(command.resolved_host_ptr){
+                    last = queue.enqueue_read_buffer_async(
+                        command.src, command.src_offset, command.size,
+                        const_cast<void *>(command.resolved_host_ptr),
+                        command_events
+                    );
+                }
+                break;
+            case recorded_command::copy_buffer:
+                last = queue.enqueue_copy_buffer(
+                    command.src, command.dst, command.src_offset,
+                    command.dst_offset, command.size, command_events
+                );
+                break;
+            #ifdef BOOST_COMPUTE_CL_VERSION_1_2
+            case recorded_command::fill_buffer:
+                last = queue.enqueue_fill_buffer(
+                    command.dst, &command.data[0], command.data.size(),
+                    command.dst_offset, command.size, command_events
+                );
+                break;
+            #endif // BOOST_COMPUTE_CL_VERSION_1_2
+            default:
+                break;
+            }
+        }
+
+        // nothing was enqueued (e.g. an empty graph)
+        if(!last.get()){
+            #ifdef BOOST_COMPUTE_CL_VERSION_1_2
+            last = queue.enqueue_marker(events);
+            #else
+            last = queue.enqueue_marker();
+            #endif
+        }
+
+        return last;
+    }
+
+    /// \overload
+    ///
+    /// Replays the recorded commands on the queue the graph was created with.
+    event replay(const wait_list &events = wait_list())
+    {
+        return replay(m_queue, events);
+    }
+
+private:
+    struct recorded_arg
+    {
+        size_t index;
+        size_t size;
+        std::vector<unsigned char> value;
+        cl_mem mem;
+        cl_mem resolved_mem;
+    };
+
+    struct recorded_command
+    {
+        enum command_type {
+            nd_range_kernel,
+            write_buffer,
+            read_buffer,
+            copy_buffer,
+            fill_buffer
+        };
+
+        recorded_command(command_type t)
+            : type(t),
+              work_dim(0),
+              src_mem(0),
+              dst_mem(0),
+              src_offset(0),
+              dst_offset(0),
+              size(0),
+              host_ptr(0),
+              resolved_host_ptr(0)
+        {
+        }
+
+        command_type type;
+
+        // kernel commands
+        kernel kernel_;
+        std::vector<recorded_arg> args;
+        size_t work_dim;
+        std::vector<size_t> global_work_offset;
+        std::vector<size_t> global_work_size;
+        std::vector<size_t> local_work_size;
+
+        // memory commands
+        cl_mem src_mem;
+        cl_mem dst_mem;
+        buffer src;
+        buffer dst;
+        size_t src_offset;
+        size_t dst_offset;
+        size_t size;
+        const void *host_ptr;
+        const void *resolved_host_ptr;
+        std::vector<unsigned char> data;
+    };
+
+    struct host_binding
+    {
+        host_binding()
+            : ptr(0),
+              writable(false)
+        {
+        }
+
+        host_binding(const void *p, bool w)
+            : ptr(p),
+              writable(w)
+        {
+        }
+
+        const void *ptr;
+        bool writable;
+    };
+
+    struct kernel_args
+    {
+        kernel kernel_;
+        std::vector<recorded_arg> args;
+        std::vector<bool> is_set;
+    };
+
+    bool is_recorded_queue(cl_command_queue queue) const
+    {
+        return queue == m_queue.get();
+    }
+
+    // keeps mem alive for the lifetime of the graph
+    void retain_memory_object(cl_mem mem)
+    {
+        if(mem && m_memory_objects.find(mem) == m_memory_objects.end()){
+            m_memory_objects.insert(std::make_pair(mem, buffer(mem)));
+        }
+    }
+
+    bool is_known_memory_object(size_t size, const void *value) const
+    {
+        if(size != sizeof(cl_mem) || !value){
+            return false;
+        }
+
+        cl_mem mem;
+        std::memcpy(&mem, value, sizeof(cl_mem));
+
+        return m_memory_objects.find(mem) != m_memory_objects.end();
+    }
+
+    void record_kernel_arg(cl_kernel kernel_,
+                           size_t index,
+                           size_t size,
+                           const void *value,
+                           bool is_memory_object)
+    {
+        kernel_args &state = m_kernel_args[kernel_];
+        if(!state.kernel_.get()){
+            state.kernel_ = kernel(kernel_);
+        }
+
+        if(index >= state.args.size()){
+            state.args.resize(index + 1);
+            state.is_set.resize(index + 1, false);
+        }
+
+        recorded_arg &arg = state.args[index];
+        arg.index = index;
+        arg.size = size;
+        arg.mem = 0;
+        arg.resolved_mem = 0;
+
+        // a null value is used for local memory arguments
+        if(value){
+            const unsigned char *bytes = static_cast<const unsigned char *>(value);
+            arg.value.assign(bytes, bytes + size);
+        }
+        else {
+            arg.value.clear();
+        }
+
+        if(is_memory_object || is_known_memory_object(size, value)){
+            std::memcpy(&arg.mem, value, sizeof(cl_mem));
+            retain_memory_object(arg.mem);
+        }
+
+        state.is_set[index] = true;
+    }
+
+    void record_nd_range_kernel(cl_command_queue queue,
+                                cl_kernel kernel_,
+                                size_t work_dim,
+                                const size_t *global_work_offset,
+                                const size_t *global_work_size,
+                                const size_t *local_work_size)
+    {
+        if(!is_recorded_queue(queue)){
+            return;
+        }
+
+        recorded_command command(recorded_command::nd_range_kernel);
+        command.kernel_ = kernel(kernel_);
+        command.work_dim = work_dim;
+        if(global_work_offset){
+            command.global_work_offset.assign(
+                global_work_offset, global_work_offset + work_dim
+            );
+        }
+        command.global_work_size.assign(
+            global_work_size, global_work_size + work_dim
+        );
+        if(local_work_size){
+            command.local_work_size.assign(
+                local_work_size, local_work_size + work_dim
+            );
+        }
+
+        // arguments set before recording began are left as they are
+        std::map<cl_kernel, kernel_args>::const_iterator iter =
+            m_kernel_args.find(kernel_);
+        if(iter != m_kernel_args.end()){
+            const kernel_args &state = iter->second;
+            for(size_t i = 0; i < state.args.size(); i++){
+                if(state.is_set[i]){
+                    command.args.push_back(state.args[i]);
+                }
+            }
+        }
+
+        m_commands.push_back(command);
+    }
+
+    void record_write_buffer(cl_command_queue queue,
+                             cl_mem buffer_,
+                             size_t offset,
+                             size_t size,
+                             const void *host_ptr)
+    {
+        if(!is_recorded_queue(queue)){
+            return;
+        }
+
+        retain_memory_object(buffer_);
+
+        recorded_command command(recorded_command::write_buffer);
+        command.dst_mem = buffer_;
+        command.dst_offset = offset;
+        command.size = size;
+        command.host_ptr = host_ptr;
+
+        // the host memory may not outlive the call which wrote it (e.g.
+        // temporary values written by algorithms) so a copy is stored
+        const unsigned char *bytes = static_cast<const unsigned char *>(host_ptr);
+        command.data.assign(bytes, bytes + size);
+
+        m_commands.push_back(command);
+    }
+
+    void record_read_buffer(cl_command_queue queue,
+                            cl_mem buffer_,
+                            size_t offset,
+                            size_t size,
+                            void *host_ptr)
+    {
+        if(!is_recorded_queue(queue)){
+            return;
+        }
+
+        retain_memory_object(buffer_);
+
+        recorded_command command(recorded_command::read_buffer);
+        command.src_mem = buffer_;
+        command.src_offset = offset;
+        command.size = size;
+        command.host_ptr = host_ptr;
+
+        m_commands.push_back(command);
+    }
+
+    void record_copy_buffer(cl_command_queue queue,
+                            cl_mem src_buffer,
+                            cl_mem dst_buffer,
+                            size_t src_offset,
+                            size_t dst_offset,
+                            size_t size)
+    {
+        if(!is_recorded_queue(queue)){
+            return;
+        }
+
+        retain_memory_object(src_buffer);
+        retain_memory_object(dst_buffer);
+
+        recorded_command command(recorded_command::copy_buffer);
+        command.src_mem = src_buffer;
+        command.dst_mem = dst_buffer;
+        command.src_offset = src_offset;
+        command.dst_offset = dst_offset;
+        command.size = size;
+
+        m_commands.push_back(command);
+    }
+
+    void record_fill_buffer(cl_command_queue queue,
+                            cl_mem buffer_,
+                            const void *pattern,
+                            size_t pattern_size,
+                            size_t offset,
+                            size_t size)
+    {
+        if(!is_recorded_queue(queue)){
+            return;
+        }
+
+        retain_memory_object(buffer_);
+
+        recorded_command command(recorded_command::fill_buffer);
+        command.dst_mem = buffer_;
+        command.dst_offset = offset;
+        command.size = size;
+
+        const unsigned char *bytes = static_cast<const unsigned char *>(pattern);
+        command.data.assign(bytes, bytes + pattern_size);
+
+        m_commands.push_back(command);
+    }
+
+    void record_unsupported_command(cl_command_queue queue)
+    {
+        if(queue == 0 || is_recorded_queue(queue)){
+            m_replayable = false;
+        }
+    }
+
+    buffer resolve_buffer(cl_mem mem) const
+    {
+        std::map<cl_mem, buffer>::const_iterator iter =
+            m_buffer_bindings.find(mem);
+        if(iter != m_buffer_bindings.end()){
+            return iter->second;
+        }
+
+        return buffer(mem);
+    }
+
+    // updates the memory objects and host pointers used by each command
+    // after the bindings have changed
+    void resolve_bindings()
+    {
+        for(size_t i = 0; i < m_commands.size(); i++){
+            recorded_command &command = m_commands[i];
+
+            for(size_t j = 0; j < command.args.size(); j++){
+                recorded_arg &arg = command.args[j];
+                if(arg.mem){
+                    arg.resolved_mem = resolve_buffer(arg.mem).get();
+                }
+            }
+
+            if(command.type == recorded_command::read_buffer ||
+               command.type == recorded_command::copy_buffer){
+                command.src = resolve_buffer(command.src_mem);
+            }
+            if(command.type != recorded_command::nd_range_kernel &&
+               command.type != recorded_command::read_buffer){
+                command.dst = resolve_buffer(command.dst_mem);
+            }
+
+            std::map<const void *, host_binding>::const_iterator iter =
+                m_host_bindings.find(command.host_ptr);
+            const bool bound = iter != m_host_bindings.end();
+
+            if(command.type == recorded_command::write_buffer){
+                command.resolved_host_ptr =
+                    bound ? iter->second.ptr : &command.data[0];
+            }
+            else if(command.type == recorded_command::read_buffer){
+                command.resolved_host_ptr =
+                    bound && iter->second.writable ? iter->second.ptr : 0;
+            }
+        }
+
+        m_bindings_dirty = false;
+    }
+
+    event replay_kernel(command_queue &queue,
+                        recorded_command &command,
+                        const wait_list &events)
+    {
+        kernel &kernel_ = command.kernel_;
+
+        for(size_t i = 0; i < command.args.size(); i++){
+            const recorded_arg &arg = command.args[i];
+
+            if(arg.mem){
+                kernel_.set_arg(arg.index, arg.resolved_mem);
+            }
+            else {
+                kernel_.set_arg(
+                    arg.index, arg.size, arg.value.empty() ? 0 : &arg.value[0]
+                );
+            }
+        }
+
+        return queue.enqueue_nd_range_kernel(
+            kernel_,
+            command.work_dim,
+            command.global_work_offset.empty() ? 0 : &command.global_work_offset[0],
+            &command.global_work_size[0],
+            command.local_work_size.empty() ? 0 : &command.local_work_size[0],
+            events
+        );
+    }
+
+private:
+    command_queue m_queue;
+    bool m_recording;
+    bool m_replayable;
+    bool m_bindings_dirty;
+    std::vector<recorded_command> m_commands;
+    std::map<cl_kernel, kernel_args> m_kernel_args;
+    std::map<cl_mem, buffer> m_memory_objects;
+    std::map<cl_mem, buffer> m_buffer_bindings;
+    std::map<const void *, host_binding> m_host_bindings;
+};
+
+} // end compute namespace
+} // end boost namespace
+
+#endif // BOOST_COMPUTE_UTILITY_COMMAND_GRAPH_HPP
@@ -0,0 +1,246 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://boostorg.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#ifndef BOOST_COMPUTE_UTILITY_NUMA_HPP
+#define BOOST_COMPUTE_UTILITY_NUMA_HPP
+
+#include <algorithm>
+#include <iterator>
+#include <vector>
+
+#include <boost/compute/cl.hpp>
+#include <boost/compute/buffer.hpp>
+#include <boost/compute/device.hpp>
+#include <boost/compute/context.hpp>
+#include <boost/compute/multi_queue.hpp>
+#include <boost/compute/command_queue.hpp>
+#include <boost/compute/algorithm/detail/multi_device.hpp>
+#include <boost/compute/detail/meta_kernel.hpp>
+#include <boost/compute/iterator/buffer_iterator.hpp>
+#include <boost/compute/exception/opencl_error.hpp>
+
+namespace boost {
+namespace compute {
+
+/// Returns the sub-devices of \p device with one sub-device for each NUMA
+/// node. If the device does not support partitioning by NUMA node or only
+/// has a single node, a vector containing just \p device is returned.
+///
+/// \see make_numa_queues(), device::partition_by_affinity_domain()
+inline std::vector<device> partition_by_numa_node(const device &device)
+{
+    #ifdef BOOST_COMPUTE_CL_VERSION_1_2
+    if(device.check_version(1, 2)){
+        const std::vector<cl_device_partition_property> properties =
+            device.get_info<std::vector<cl_device_partition_property> >(
+                CL_DEVICE_PARTITION_PROPERTIES
+            );
+        const cl_device_affinity_domain domains =
+            device.get_info<cl_device_affinity_domain>(
+                CL_DEVICE_PARTITION_AFFINITY_DOMAIN
+            );
+
+        const bool supported =
+            std::find(properties.begin(),
+                      properties.end(),
+                      CL_DEVICE_PARTITION_BY_AFFINITY_DOMAIN) != properties.end() &&
+            (domains & CL_DEVICE_AFFINITY_DOMAIN_NUMA) != 0;
+
+        if(supported){
+            try {
+                std::vector<boost::compute::device> nodes =
+                    device.partition_by_affinity_domain(
+                        CL_DEVICE_AFFINITY_DOMAIN_NUMA
+                    );
+
+                if(nodes.size() > 1){
+                    return nodes;
+                }
+            }
+            catch(opencl_error&){
+                // partitioning fails on devices with a single node
+            }
+        }
+    }
+    #endif // BOOST_COMPUTE_CL_VERSION_1_2
+
+    return std::vector<boost::compute::device>(1, device);
+}
+
+/// Returns a multi_queue with one command queue for each NUMA node of
+/// \p device. The queues share a context created for the sub-devices.
+///
+/// Load balancing is disabled on the returned multi_queue so that each
+/// element of a buffer is always processed by the same node. Together with
+/// first_touch() this keeps the memory accessed by each node local to it.
+///
+/// For example, to sum a large vector on a dual-socket CPU:
+/// \code
+/// multi_queue queues = make_numa_queues(cpu);
+///
+/// vector<float> vec(n, queues.get_context());
+/// first_touch(vec.begin(), vec.end(), queues);
+/// copy(host.begin(), host.end(), vec.begin(), queues.get_queue(0));
+///
+/// float sum = 0;
+/// reduce(vec.begin(), vec.end(), &sum, queues);
+/// \endcode
+///
+/// \see partition_by_numa_node(), multi_queue
+inline multi_queue
+make_numa_queues(const device &device,
+                 cl_command_queue_properties properties =
+                     command_queue::enable_profiling)
+{
+    const context context(partition_by_numa_node(device));
+
+    multi_queue queues(context, properties);
+    queues.set_load_balancing(false);
+
+    return queues;
+}
+
+namespace detail {
+
+// returns the largest base address alignment (in bytes) of the devices in
+// context. sub-buffers which are used by all of them must start at a
+// multiple of it.
+inline size_t sub_buffer_alignment(const context &context)
+{
+    const std::vector<device> devices = context.get_devices();
+
+    size_t alignment = 1;
+    for(size_t i = 0; i < devices.size(); i++){
+        alignment = (std::max)(
+            alignment,
+            static_cast<size_t>(
+                devices[i].get_info<CL_DEVICE_MEM_BASE_ADDR_ALIGN>() / 8
+            )
+        );
+    }
+
+    return alignment;
+}
+
+// writes value to the count elements of buffer starting at index
+template<class T>
+inline void first_touch_buffer(const buffer &buffer,
+                               size_t index,
+                               size_t count,
+                               const T &value,
+                               command_queue &queue)
+{
+    meta_kernel k("first_touch");
+    size_t value_arg = k.add_arg<T>("value");
+    k << make_buffer_iterator<T>(buffer, index)[k.get_global_id(0)] << " = value;\n";
+    k.set_arg(value_arg, value);
+    k.exec_1d(queue, 0, count);
+}
+
+} // end detail namespace
+
+/// Writes \p value to the range [\p first, \p last) with each device in
+/// \p queues writing the part of the range it is assigned by the
+/// multi_queue algorithms. The range must be given by buffer iterators.
+///
+/// On CPU devices memory pages are usually placed on the NUMA node which
+/// first writes to them. Initializing a newly allocated buffer with this
+/// function before using it with the same \p queues places each part of
+/// the buffer on the node which will process it.
+///
+/// Each device writes its part through a sub-buffer of its own, so the
+/// part boundaries are moved to the nearest multiple of the devices' base
+/// address alignment (\c CL_DEVICE_MEM_BASE_ADDR_ALIGN). The elements
+/// before the first aligned element are written by the first queue after
+/// the devices have finished.
+template<class Iterator, class T>
+inline void first_touch(Iterator first,
+                        Iterator last,
+                        const T &value,
+                        multi_queue &queues)
+{
+    typedef typename std::iterator_traits<Iterator>::value_type value_type;
+
+    const size_t count = static_cast<size_t>(std::distance(first, last));
+    if(count == 0){
+        return;
+    }
+
+    buffer parent = first.get_buffer();
+    const size_t index = first.get_index();
+    command_queue &queue = queues.get_queue(0);
+
+    #ifdef BOOST_COMPUTE_CL_VERSION_1_1
+    // sub-buffers start at a multiple of step elements
+    const size_t alignment = detail::sub_buffer_alignment(queues.get_context());
+    size_t step = alignment;
+    while(step % sizeof(value_type) != 0){
+        step += alignment;
+    }
+    step /= sizeof(value_type);
+
+    const size_t head = (std::min)((index + step - 1) / step * step - index, count);
+
+    // round the boundaries of the parts to the nearest aligned elements
+    std::vector<size_t> offsets = queues.partition(count);
+    offsets.front() = head;
+    for(size_t i = 1; i + 1 < offsets.size(); i++){
+        const size_t boundary = (index + offsets[i] + step / 2) / step * step;
+        offsets[i] = (std::min)((std::max)(boundary - index, head), count);
+    }
+
+    detail::multi_device_launch launch(queues, offsets);
+    for(size_t i = 0; i < launch.size(); i++){
+        if(launch.count(i) == 0){
+            continue;
+        }
+
+        // a kernel (rather than clEnqueueFillBuffer()) ensures the writes
+        // are made by the compute units of the sub-device
+        // the sub-buffer inherits the flags of the buffer
+        buffer part = parent.create_subbuffer(
+            0,
+            (index + launch.begin(i)) * sizeof(value_type),
+            launch.count(i) * sizeof(value_type)
+        );
+        detail::first_touch_buffer(
+            part, 0, launch.count(i), static_cast<value_type>(value), launch.queue(i)
+        );
+    }
+    launch.wait();
+
+    if(head){
+        detail::first_touch_buffer(
+            parent, index, head, static_cast<value_type>(value), queue
+        );
+        queue.finish();
+    }
+    #else
+    // without sub-buffers the whole range is written by the first device
+    detail::first_touch_buffer(
+        parent, index, count, static_cast<value_type>(value), queue
+    );
+    queue.finish();
+    #endif // BOOST_COMPUTE_CL_VERSION_1_1
+}
+
+/// \overload
+template<class Iterator>
+inline void first_touch(Iterator first, Iterator last, multi_queue &queues)
+{
+    typedef typename std::iterator_traits<Iterator>::value_type value_type;
+
+    first_touch(first, last, value_type(), queues);
+}
+
+} // end compute namespace
+} // end boost namespace
+
+#endif // BOOST_COMPUTE_UTILITY_NUMA_HPP
@@ -0,0 +1,178 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://boostorg.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#ifndef BOOST_COMPUTE_UTILITY_PROFILER_HPP
+#define BOOST_COMPUTE_UTILITY_PROFILER_HPP
+
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <boost/assert.hpp>
+#include <boost/noncopyable.hpp>
+
+#include <boost/compute/detail/command_tracer.hpp>
+
+namespace boost {
+namespace compute {
+
+/// \class profiler
+/// \brief Records the commands run by algorithms for profiling.
+///
+/// While a profiler is running it records every algorithm call made on the
+/// current thread along with the work done for it:
+///   - kernel launches (kernel name, global and local work sizes and the time
+///     taken on the device)
+///   - memory transfers (reads, writes, copies, fills and maps with their
+///     size and device time)
+///   - buffer allocations
+///   - program builds (with the time taken to build) and program cache hits
+///
+/// Each record is attributed to the algorithm calls which were active when
+/// it was made, so for instance the time taken by a call to sort() can be
+/// broken down by the kernels it launched.
+///
+/// The records can be exported in the Chrome trace-event format (viewable
+/// in \c chrome://tracing or Perfetto) with write_chrome_trace() or
+/// summarized as text with print_summary().
+///
+/// For example:
+/// \code
+/// boost::compute::profiler profiler;
+///
+/// profiler.start();
+/// boost::compute::sort(vec.begin(), vec.end(), queue);
+/// profiler.stop();
+///
+/// profiler.write_chrome_trace("sort.json");
+/// profiler.print_summary(std::cout);
+/// \endcode
+///
+/// Device times are only available for commands enqueued on queues created
+/// with command_queue::enable_profiling. Host times require \c <chrono>.
+///
+/// Tracing can also be enabled for a whole program without changing it by
+/// setting the \c BOOST_COMPUTE_TRACE environment variable to the name of
+/// a file. The Chrome trace is then written to the file and the summary is
+/// printed to \c stderr when the program exits. This records the commands
+/// from every thread in a single unsynchronized log, so it should only be
+/// used with single-threaded programs.
+///
+/// \see event::duration(), command_graph
+class profiler : boost::noncopyable
+{
+public:
+    /// A single record in the profile.
+    typedef detail::trace_record record;
+
+    /// Creates a new profiler.
+    profiler()
+        : m_previous(0),
+          m_running(false)
+    {
+    }
+
+    /// Destroys the profiler.
+    ~profiler()
+    {
+        if(m_running){
+            stop();
+        }
+    }
+
+    /// Starts recording the commands run by the current thread.
+    ///
+    /// A profiler started while another one (or the \c BOOST_COMPUTE_TRACE
+    /// log) is active takes over from it until stop() is called.
+    void start()
+    {
+        BOOST_ASSERT(!m_running);
+
+        m_previous = detail::thread_hook<detail::command_tracer>::install(&m_log);
+        m_running = true;
+    }
+
+    /// Stops recording commands.
+    void stop()
+    {
+        BOOST_ASSERT(m_running);
+        BOOST_ASSERT(detail::current_command_tracer() == &m_log);
+
+        detail::thread_hook<detail::command_tracer>::install(m_previous);
+        m_previous = 0;
+        m_running = false;
+    }
+
+    /// Returns \c true if the profiler is recording.
+    bool is_running() const
+    {
+        return m_running;
+    }
+
+    /// Returns the records. This waits for any recorded commands which have
+    /// not yet completed.
+    const std::vector<record>& records()
+    {
+        return m_log.records();
+    }
+
+    /// Removes all of the records.
+    void clear()
+    {
+        m_log.clear();
+    }
+
+    /// Writes the records to \p stream in the Chrome trace-event JSON format.
+    ///
+    /// Algorithm calls and program builds are shown on the host track and
+    /// commands on one track per command queue.
+    void write_chrome_trace(std::ostream &stream)
+    {
+        m_log.write_chrome_trace(stream);
+    }
+
+    /// Writes the records to the file at \p path in the Chrome trace-event
+    /// JSON format.
+    void write_chrome_trace(const std::string &path)
+    {
+        std::ofstream file(path.c_str());
+        m_log.write_chrome_trace(file);
+    }
+
+    /// Prints a summary of the records to \p stream. The summary lists the
+    /// number of calls and host time for each algorithm, the number of
+    /// launches and device time for each kernel (grouped by the algorithm
+    /// which launched it), the transfers, the allocations and the program
+    /// builds and cache hits.
+    void print_summary(std::ostream &stream = std::cout)
+    {
+        m_log.print_summary(stream);
+    }
+
+    /// Returns the summary printed by print_summary() as a string.
+    std::string summary()
+    {
+        std::stringstream stream;
+        m_log.print_summary(stream);
+        return stream.str();
+    }
+
+private:
+    detail::trace_log m_log;
+    detail::command_tracer *m_previous;
+    bool m_running;
+};
+
+} // end compute namespace
+} // end boost namespace
+
+#endif // BOOST_COMPUTE_UTILITY_PROFILER_HPP
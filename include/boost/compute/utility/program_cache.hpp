@@ -21,6 +21,7 @@
 #include <boost/compute/context.hpp>
 #include <boost/compute/program.hpp>
 #include <boost/compute/detail/lru_cache.hpp>
+#include <boost/compute/detail/command_tracer.hpp>
 #include <boost/compute/detail/global_static.hpp>
 
 namespace boost {
@@ -131,11 +132,22 @@ public:
                          const std::string &source,
                          const context &context)
     {
+        detail::command_tracer *tracer = detail::current_command_tracer();
+
         boost::optional<program> p = get(key, options);
         if(!p){
+            const cl_ulong start = tracer ? detail::trace_clock() : 0;
+
             p = program::build_with_source(source, context, options);
 
             insert(key, options, *p);
+
+            if(tracer){
+                tracer->trace_build(key, start, detail::trace_clock());
+            }
+        }
+        else if(tracer){
+            tracer->trace_cache_hit(key);
         }
         return *p;
     }
@@ -0,0 +1,26 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://boostorg.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#ifndef BOOST_COMPUTE_VIEW_HPP
+#define BOOST_COMPUTE_VIEW_HPP
+
+/// \file
+///
+/// Meta-header to include all Boost.Compute view headers.
+
+#include <boost/compute/view/copy.hpp>
+#include <boost/compute/view/count.hpp>
+#include <boost/compute/view/filter_view.hpp>
+#include <boost/compute/view/range_view.hpp>
+#include <boost/compute/view/reduce.hpp>
+#include <boost/compute/view/transform_view.hpp>
+#include <boost/compute/view/zip_view.hpp>
+
+#endif // BOOST_COMPUTE_VIEW_HPP
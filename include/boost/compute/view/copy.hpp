@@ -0,0 +1,181 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://boostorg.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#ifndef BOOST_COMPUTE_VIEW_COPY_HPP
+#define BOOST_COMPUTE_VIEW_COPY_HPP
+
+#include <string>
+#include <iterator>
+
+#include <boost/utility/enable_if.hpp>
+
+#include <boost/compute/system.hpp>
+#include <boost/compute/command_queue.hpp>
+#include <boost/compute/algorithm/copy.hpp>
+#include <boost/compute/algorithm/exclusive_scan.hpp>
+#include <boost/compute/container/vector.hpp>
+#include <boost/compute/detail/meta_kernel.hpp>
+#include <boost/compute/type_traits/is_device_iterator.hpp>
+#include <boost/compute/view/detail/view_emitter.hpp>
+
+namespace boost {
+namespace compute {
+namespace detail {
+
+// copies the values of an unfiltered view with a single kernel
+template<class View, class OutputIterator>
+inline OutputIterator copy_view(const View &view,
+                                OutputIterator result,
+                                boost::false_type /* is_filtered */,
+                                command_queue &queue)
+{
+    const size_t count = view.size();
+    if(count == 0){
+        return result;
+    }
+
+    meta_kernel k("view_copy");
+    k << "const uint i = get_global_id(0);\n";
+    const std::string value = emit_view(k, view, "i");
+    k << result[k.var<uint_>("i")] << " = " << value << ";\n";
+    k.exec_1d(queue, 0, count);
+
+    return result + count;
+}
+
+// copies the values of a filtered view. the first kernel evaluates the
+// filters and writes a flag for each value, the flags are scanned to get
+// the output positions and the second kernel evaluates the view again
+// (including the transforms) and writes the kept values to their positions.
+template<class View, class OutputIterator>
+inline OutputIterator copy_view(const View &view,
+                                OutputIterator result,
+                                boost::true_type /* is_filtered */,
+                                command_queue &queue)
+{
+    const size_t count = view.size();
+    if(count == 0){
+        return result;
+    }
+
+    const context &context = queue.get_context();
+
+    // storage for destination indices
+    ::boost::compute::vector<uint_> indices(count, context);
+
+    // write flags
+    meta_kernel k1("view_copy_write_flags");
+    k1 << "const uint i = get_global_id(0);\n";
+    emit_view(k1, view, "i", false);
+    k1 << indices.begin()[k1.var<uint_>("i")] << " = "
+       << view_emitter::keep() << " ? 1 : 0;\n";
+    k1.exec_1d(queue, 0, count);
+
+    // scan flags
+    size_t copied_count = (indices.cend() - 1).read(queue);
+    ::boost::compute::exclusive_scan(
+        indices.begin(), indices.end(), indices.begin(), queue
+    );
+    copied_count += (indices.cend() - 1).read(queue); // last index plus last flag
+
+    // write values
+    meta_kernel k2("view_copy_scatter");
+    k2 << "const uint i = get_global_id(0);\n";
+    const std::string value = emit_view(k2, view, "i");
+    k2 << "if(" << view_emitter::keep() << "){\n"
+       << result[indices.begin()[k2.var<uint_>("i")]] << " = " << value << ";\n"
+       << "}\n";
+    k2.exec_1d(queue, 0, count);
+
+    return result + copied_count;
+}
+
+// device output
+template<class View, class OutputIterator>
+inline OutputIterator
+dispatch_copy_view(const View &view,
+                   OutputIterator result,
+                   command_queue &queue,
+                   typename boost::enable_if<
+                       is_device_iterator<OutputIterator>
+                   >::type* = 0)
+{
+    return copy_view(
+        view, result, boost::integral_constant<bool, View::is_filtered>(), queue
+    );
+}
+
+// host output, the values are copied to a temporary vector first
+template<class View, class OutputIterator>
+inline OutputIterator
+dispatch_copy_view(const View &view,
+                   OutputIterator result,
+                   command_queue &queue,
+                   typename boost::disable_if<
+                       is_device_iterator<OutputIterator>
+                   >::type* = 0)
+{
+    typedef typename View::value_type value_type;
+
+    const size_t count = view.size();
+    if(count == 0){
+        return result;
+    }
+
+    ::boost::compute::vector<value_type> temp(count, queue.get_context());
+    typename ::boost::compute::vector<value_type>::iterator temp_end =
+        copy_view(
+            view,
+            temp.begin(),
+            boost::integral_constant<bool, View::is_filtered>(),
+            queue
+        );
+
+    return ::boost::compute::copy(temp.begin(), temp_end, result, queue);
+}
+
+} // end detail namespace
+
+namespace view {
+
+/// Evaluates \p view and copies its values to the range beginning at
+/// \p result. Returns an iterator to the end of the copied values.
+///
+/// Unfiltered views are evaluated and written by a single kernel. For
+/// filtered views the filters are evaluated by one kernel, the output
+/// positions are computed with a scan and the transforms are applied by
+/// the kernel which writes the kept values to their positions.
+///
+/// For example, to copy the square roots of the positive values:
+/// \code
+/// view::copy(
+///     view::all(input) | view::filter(_1 > 0) | view::transform(sqrt<float>()),
+///     output.begin(),
+///     queue
+/// );
+/// \endcode
+///
+/// Space complexity: \Omega(1) for unfiltered views, \Omega(n) for
+/// filtered views.
+///
+/// \see range_view, filter_view, transform_view, zip_view
+template<class View, class OutputIterator>
+inline OutputIterator copy(const View &view,
+                           OutputIterator result,
+                           command_queue &queue = system::default_queue())
+{
+    return detail::dispatch_copy_view(view, result, queue);
+}
+
+} // end view namespace
+} // end compute namespace
+} // end boost namespace
+
+#endif // BOOST_COMPUTE_VIEW_COPY_HPP
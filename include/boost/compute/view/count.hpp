@@ -0,0 +1,124 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://boostorg.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#ifndef BOOST_COMPUTE_VIEW_COUNT_HPP
+#define BOOST_COMPUTE_VIEW_COUNT_HPP
+
+#include <string>
+
+#include <boost/config.hpp>
+
+#include <boost/compute/system.hpp>
+#include <boost/compute/command_queue.hpp>
+#include <boost/compute/container/vector.hpp>
+#include <boost/compute/functional/operator.hpp>
+#include <boost/compute/detail/meta_kernel.hpp>
+#include <boost/compute/view/detail/reduce_view.hpp>
+#include <boost/compute/view/detail/view_emitter.hpp>
+
+namespace boost {
+namespace compute {
+namespace detail {
+
+// an unfiltered view with the value 1 for each value of the filtered view
+// which passes its filters and 0 otherwise. only the filters are evaluated.
+template<class View>
+class keep_flag_view
+{
+public:
+    typedef uint_ value_type;
+
+    BOOST_STATIC_CONSTANT(bool, is_filtered = false);
+
+    explicit keep_flag_view(const View &view)
+        : m_view(view)
+    {
+    }
+
+    size_t size() const
+    {
+        return m_view.size();
+    }
+
+    std::string emit(view_emitter &e, const std::string &index) const
+    {
+        meta_kernel &k = e.kernel();
+
+        k << "bool " << view_emitter::keep() << " = true;\n";
+        const bool values_needed = e.set_values_needed(false);
+        m_view.emit(e, index);
+        e.set_values_needed(values_needed);
+
+        const std::string value = e.variable();
+        k << k.decl<uint_>(value) << " = "
+          << view_emitter::keep() << " ? 1 : 0;\n";
+
+        return value;
+    }
+
+private:
+    View m_view;
+};
+
+template<class View>
+inline size_t count_view(const View &view,
+                         boost::false_type /* is_filtered */,
+                         command_queue &queue)
+{
+    (void) queue;
+
+    return view.size();
+}
+
+template<class View>
+inline size_t count_view(const View &view,
+                         boost::true_type /* is_filtered */,
+                         command_queue &queue)
+{
+    if(view.size() == 0){
+        return 0;
+    }
+
+    vector<uint_> value(1, queue.get_context());
+    const uint_ zero = 0;
+    reduce_view<uint_>(
+        keep_flag_view<View>(view), value.begin(), plus<uint_>(), &zero, queue
+    );
+
+    return value.begin().read(queue);
+}
+
+} // end detail namespace
+
+namespace view {
+
+/// Returns the number of values in \p view which pass its filters.
+///
+/// Only the filters (and the transforms they depend on) are evaluated and
+/// the values are counted by a single kernel. The size of unfiltered views
+/// is returned without running a kernel.
+///
+/// Space complexity: \Omega(1)
+///
+/// \see view::reduce()
+template<class View>
+inline size_t count(const View &view,
+                    command_queue &queue = system::default_queue())
+{
+    return detail::count_view(
+        view, boost::integral_constant<bool, View::is_filtered>(), queue
+    );
+}
+
+} // end view namespace
+} // end compute namespace
+} // end boost namespace
+
+#endif // BOOST_COMPUTE_VIEW_COUNT_HPP
@@ -0,0 +1,224 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://boostorg.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#ifndef BOOST_COMPUTE_VIEW_DETAIL_REDUCE_VIEW_HPP
+#define BOOST_COMPUTE_VIEW_DETAIL_REDUCE_VIEW_HPP
+
+#include <algorithm>
+#include <string>
+
+#include <boost/lexical_cast.hpp>
+
+#include <boost/compute/device.hpp>
+#include <boost/compute/kernel.hpp>
+#include <boost/compute/command_queue.hpp>
+#include <boost/compute/algorithm/fill_n.hpp>
+#include <boost/compute/container/vector.hpp>
+#include <boost/compute/detail/meta_kernel.hpp>
+#include <boost/compute/memory/local_buffer.hpp>
+#include <boost/compute/view/detail/view_emitter.hpp>
+
+namespace boost {
+namespace compute {
+namespace detail {
+
+// sets the accumulator named acc (with the bool named acc_valid) to
+// function(acc, value), or to value if acc is not valid yet
+template<class T, class BinaryFunction>
+inline void reduce_view_combine(meta_kernel &k,
+                                const std::string &acc,
+                                const std::string &value,
+                                BinaryFunction function)
+{
+    k << "if(" << acc << "_valid){\n"
+      << acc << " = " << function(k.var<T>(acc), k.var<T>(value)) << ";\n"
+      << "}\n"
+      << "else {\n"
+      << acc << " = " << value << ";\n"
+      << acc << "_valid = true;\n"
+      << "}\n";
+}
+
+// reduces the values of view with a single kernel and writes the result to
+// result[0]. if init is not null the result is function(*init, reduced) (or
+// *init if no values pass the view's filters), otherwise nothing is written
+// if no values pass the filters.
+//
+// each work-item reduces its values (strided on GPUs, a contiguous block on
+// CPUs) while evaluating the view, the work-items of a work-group combine
+// their values in local memory and write them to a partial result. the
+// last work-group to finish (counted with an atomic counter) combines the
+// partial results. function must be associative and commutative.
+template<class T, class View, class OutputIterator, class BinaryFunction>
+inline void reduce_view(const View &view,
+                        OutputIterator result,
+                        BinaryFunction function,
+                        const T *init,
+                        command_queue &queue)
+{
+    const size_t count = view.size();
+    if(count == 0){
+        if(init){
+            ::boost::compute::fill_n(result, 1, *init, queue);
+        }
+        return;
+    }
+
+    const context &context = queue.get_context();
+    const device &device = queue.get_device();
+    const bool is_cpu = (device.type() & device::cpu) != 0;
+
+    size_t work_group_size;
+    size_t work_groups;
+    if(is_cpu){
+        work_group_size = 1;
+        work_groups = (std::min)(count, size_t(device.compute_units()));
+    }
+    else {
+        work_group_size = (std::min)(size_t(256), device.max_work_group_size());
+        // the local reduction requires a power of two
+        while(work_group_size & (work_group_size - 1)){
+            work_group_size &= work_group_size - 1;
+        }
+        work_groups = (std::min)(
+            (count + work_group_size - 1) / work_group_size,
+            size_t(device.compute_units()) * 8
+        );
+    }
+
+    vector<T> partials(work_groups, context);
+    vector<uint_> partials_valid(work_groups, context);
+    vector<uint_> counter(1, context);
+    ::boost::compute::fill_n(counter.begin(), 1, uint_(0), queue);
+
+    meta_kernel k("reduce_view");
+    k.add_set_arg<const uint_>("count", uint_(count));
+    size_t partials_arg =
+        k.add_arg<volatile T *>(memory_object::global_memory, "partials");
+    size_t partials_valid_arg =
+        k.add_arg<volatile uint_ *>(memory_object::global_memory, "partials_valid");
+    size_t counter_arg =
+        k.add_arg<uint_ *>(memory_object::global_memory, "counter");
+    size_t scratch_arg = 0;
+    size_t scratch_valid_arg = 0;
+    if(work_group_size > 1){
+        scratch_arg =
+            k.add_arg<T *>(memory_object::local_memory, "scratch");
+        scratch_valid_arg =
+            k.add_arg<uint_ *>(memory_object::local_memory, "scratch_valid");
+    }
+    if(init){
+        k.add_set_arg<const T>("init", *init);
+    }
+
+    // 1. reduce the values of the work-item
+    k << k.decl<T>("acc") << ";\n"
+      << "bool acc_valid = false;\n";
+    if(is_cpu){
+        k << "const uint block = (count + get_global_size(0) - 1) / get_global_size(0);\n"
+          << "const uint begin = min(count, (uint) get_global_id(0) * block);\n"
+          << "const uint end = min(count, begin + block);\n"
+          << "for(uint i = begin; i < end; i++){\n";
+    }
+    else {
+        k << "for(uint i = get_global_id(0); i < count; i += get_global_size(0)){\n";
+    }
+    const std::string value = emit_view(k, view, "i");
+    if(View::is_filtered){
+        k << "if(" << view_emitter::keep() << "){\n";
+    }
+    k << k.decl<T>("v") << " = " << value << ";\n";
+    reduce_view_combine<T>(k, "acc", "v", function);
+    if(View::is_filtered){
+        k << "}\n";
+    }
+    k << "}\n";
+
+    // 2. reduce the values of the work-group
+    if(work_group_size > 1){
+        k << "const uint lid = get_local_id(0);\n"
+          << "scratch_valid[lid] = acc_valid;\n"
+          << "if(acc_valid){\n"
+          << "    scratch[lid] = acc;\n"
+          << "}\n"
+          << "barrier(CLK_LOCAL_MEM_FENCE);\n"
+          << "for(uint offset = get_local_size(0) / 2; offset > 0; offset >>= 1){\n"
+          << "    if(lid < offset && scratch_valid[lid + offset]){\n"
+          << "        " << k.decl<T>("other") << " = scratch[lid + offset];\n"
+          << "        if(acc_valid){\n"
+          << "            acc = " << function(k.var<T>("acc"), k.var<T>("other")) << ";\n"
+          << "        }\n"
+          << "        else {\n"
+          << "            acc = other;\n"
+          << "            acc_valid = true;\n"
+          << "        }\n"
+          << "        scratch[lid] = acc;\n"
+          << "        scratch_valid[lid] = 1;\n"
+          << "    }\n"
+          << "    barrier(CLK_LOCAL_MEM_FENCE);\n"
+          << "}\n"
+          << "if(lid == 0){\n";
+    }
+    else {
+        k << "{\n";
+    }
+
+    // 3. write the partial result, the last work-group combines them
+    k << "const uint group = get_group_id(0);\n"
+      << "partials_valid[group] = acc_valid;\n"
+      << "if(acc_valid){\n"
+      << "    partials[group] = acc;\n"
+      << "}\n"
+      << "mem_fence(CLK_GLOBAL_MEM_FENCE);\n"
+      << "if(atomic_inc(counter) == get_num_groups(0) - 1){\n"
+      << "    mem_fence(CLK_GLOBAL_MEM_FENCE);\n"
+      << "    acc_valid = false;\n"
+      << "    for(uint g = 0; g < get_num_groups(0); g++){\n"
+      << "        if(partials_valid[g]){\n"
+      << "            " << k.decl<T>("p") << " = partials[g];\n";
+    reduce_view_combine<T>(k, "acc", "p", function);
+    k << "        }\n"
+      << "    }\n";
+    if(init){
+        k << "    if(acc_valid){\n"
+          << "        " << result[k.var<uint_>("0")] << " = "
+          << function(k.var<T>("init"), k.var<T>("acc")) << ";\n"
+          << "    }\n"
+          << "    else {\n"
+          << "        " << result[k.var<uint_>("0")] << " = init;\n"
+          << "    }\n";
+    }
+    else {
+        k << "    if(acc_valid){\n"
+          << "        " << result[k.var<uint_>("0")] << " = acc;\n"
+          << "    }\n";
+    }
+    k << "}\n"
+      << "}\n";
+
+    kernel kernel = k.compile(context);
+    kernel.set_arg(partials_arg, partials.get_buffer());
+    kernel.set_arg(partials_valid_arg, partials_valid.get_buffer());
+    kernel.set_arg(counter_arg, counter.get_buffer());
+    if(work_group_size > 1){
+        kernel.set_arg(scratch_arg, local_buffer<T>(work_group_size));
+        kernel.set_arg(scratch_valid_arg, local_buffer<uint_>(work_group_size));
+    }
+
+    queue.enqueue_1d_range_kernel(
+        kernel, 0, work_groups * work_group_size, work_group_size
+    );
+}
+
+} // end detail namespace
+} // end compute namespace
+} // end boost namespace
+
+#endif // BOOST_COMPUTE_VIEW_DETAIL_REDUCE_VIEW_HPP
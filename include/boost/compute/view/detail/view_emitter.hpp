@@ -0,0 +1,105 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://boostorg.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#ifndef BOOST_COMPUTE_VIEW_DETAIL_VIEW_EMITTER_HPP
+#define BOOST_COMPUTE_VIEW_DETAIL_VIEW_EMITTER_HPP
+
+#include <string>
+
+#include <boost/lexical_cast.hpp>
+
+#include <boost/compute/detail/meta_kernel.hpp>
+
+namespace boost {
+namespace compute {
+namespace detail {
+
+// state used while emitting the code which evaluates one element of a view
+// into a meta_kernel.
+//
+// each view type has an emit(view_emitter &e, const std::string &index)
+// method which writes the statements computing the element at index and
+// returns the name of the variable holding its value. views with a filter
+// stage (is_filtered == true) also clear the bool variable named by keep()
+// for elements which are filtered out. stages after a filter only evaluate
+// their function for the elements which are kept.
+//
+// when only the keep() flag is needed (e.g. when counting the values which
+// pass the filters) values_needed() is false and transform stages which are
+// not followed by a filter are not evaluated.
+class view_emitter
+{
+public:
+    view_emitter(meta_kernel &kernel, bool values_needed)
+        : m_kernel(kernel),
+          m_count(0),
+          m_values_needed(values_needed)
+    {
+    }
+
+    meta_kernel& kernel() const
+    {
+        return m_kernel;
+    }
+
+    // returns a new unique variable name
+    std::string variable()
+    {
+        return "_view" + boost::lexical_cast<std::string>(m_count++);
+    }
+
+    // name of the variable which is false if the element is filtered out
+    static std::string keep()
+    {
+        return "_view_keep";
+    }
+
+    bool values_needed() const
+    {
+        return m_values_needed;
+    }
+
+    // sets whether the values are needed and returns the previous setting
+    bool set_values_needed(bool values_needed)
+    {
+        const bool previous = m_values_needed;
+        m_values_needed = values_needed;
+        return previous;
+    }
+
+private:
+    meta_kernel &m_kernel;
+    size_t m_count;
+    bool m_values_needed;
+};
+
+// emits the code evaluating the element at index of view and returns the
+// name of the variable holding its value. for filtered views the variable
+// named by view_emitter::keep() is declared and set. if values_needed is
+// false only the keep() variable is valid after the emitted code.
+template<class View>
+inline std::string emit_view(meta_kernel &k,
+                             const View &view,
+                             const std::string &index,
+                             bool values_needed = true)
+{
+    if(View::is_filtered){
+        k << "bool " << view_emitter::keep() << " = true;\n";
+    }
+
+    view_emitter emitter(k, values_needed);
+    return view.emit(emitter, index);
+}
+
+} // end detail namespace
+} // end compute namespace
+} // end boost namespace
+
+#endif // BOOST_COMPUTE_VIEW_DETAIL_VIEW_EMITTER_HPP
@@ -0,0 +1,137 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://boostorg.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#ifndef BOOST_COMPUTE_VIEW_FILTER_VIEW_HPP
+#define BOOST_COMPUTE_VIEW_FILTER_VIEW_HPP
+
+#include <string>
+
+#include <boost/config.hpp>
+
+#include <boost/compute/detail/meta_kernel.hpp>
+#include <boost/compute/view/transform_view.hpp>
+#include <boost/compute/view/detail/view_emitter.hpp>
+
+namespace boost {
+namespace compute {
+
+/// \class filter_view
+/// \brief A view of the values of another view which satisfy a predicate.
+///
+/// Filtering does not move any values. The predicate is evaluated by the
+/// terminal operation and the values for which it returns \c false are
+/// skipped (e.g. view::reduce()) or removed (e.g. view::copy()). If the
+/// underlying view is a zip_view, the predicate is called with the
+/// elements of each tuple.
+///
+/// \see view::filter(), range_view, transform_view
+template<class View, class Predicate>
+class filter_view
+{
+public:
+    typedef typename View::value_type value_type;
+    typedef detail::view_function<Predicate, value_type> predicate_traits;
+    typedef typename predicate_traits::type predicate_type;
+
+    BOOST_STATIC_CONSTANT(bool, is_filtered = true);
+
+    filter_view(const View &view, Predicate predicate)
+        : m_view(view),
+          m_predicate(predicate)
+    {
+    }
+
+    const View& base() const
+    {
+        return m_view;
+    }
+
+    /// Returns the number of values in the underlying view (i.e. before
+    /// filtering).
+    size_t size() const
+    {
+        return m_view.size();
+    }
+
+    /// \internal_
+    std::string emit(detail::view_emitter &e, const std::string &index) const
+    {
+        detail::meta_kernel &k = e.kernel();
+        // the predicate needs the values even if the consumer does not
+        const bool values_needed = e.set_values_needed(true);
+        const std::string value = m_view.emit(e, index);
+        e.set_values_needed(values_needed);
+
+        const predicate_type predicate = predicate_traits::get(m_predicate);
+
+        k << e.keep() << " = " << e.keep() << " && ("
+          << predicate(k.var<value_type>(value)) << ");\n";
+
+        return value;
+    }
+
+private:
+    View m_view;
+    Predicate m_predicate;
+};
+
+namespace detail {
+
+template<class Predicate>
+struct filter_view_adaptor
+{
+    explicit filter_view_adaptor(Predicate predicate)
+        : m_predicate(predicate)
+    {
+    }
+
+    Predicate m_predicate;
+};
+
+template<class View, class Predicate>
+inline filter_view<View, Predicate>
+operator|(const View &view, const filter_view_adaptor<Predicate> &adaptor)
+{
+    return filter_view<View, Predicate>(view, adaptor.m_predicate);
+}
+
+} // end detail namespace
+
+namespace view {
+
+/// Returns a view of the values in \p view for which \p predicate returns
+/// \c true.
+///
+/// \see filter_view
+template<class View, class Predicate>
+inline filter_view<View, Predicate>
+filter(const View &view, Predicate predicate)
+{
+    return filter_view<View, Predicate>(view, predicate);
+}
+
+/// \overload
+///
+/// Returns an adaptor which can be applied to a view with \c operator|:
+/// \code
+/// view::all(vec) | view::filter(_1 > 0)
+/// \endcode
+template<class Predicate>
+inline detail::filter_view_adaptor<Predicate>
+filter(Predicate predicate)
+{
+    return detail::filter_view_adaptor<Predicate>(predicate);
+}
+
+} // end view namespace
+} // end compute namespace
+} // end boost namespace
+
+#endif // BOOST_COMPUTE_VIEW_FILTER_VIEW_HPP
@@ -0,0 +1,119 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://boostorg.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#ifndef BOOST_COMPUTE_VIEW_RANGE_VIEW_HPP
+#define BOOST_COMPUTE_VIEW_RANGE_VIEW_HPP
+
+#include <string>
+#include <iterator>
+
+#include <boost/config.hpp>
+#include <boost/static_assert.hpp>
+
+#include <boost/compute/detail/meta_kernel.hpp>
+#include <boost/compute/detail/iterator_range_size.hpp>
+#include <boost/compute/type_traits/is_device_iterator.hpp>
+#include <boost/compute/view/detail/view_emitter.hpp>
+
+namespace boost {
+namespace compute {
+
+/// \class range_view
+/// \brief A view of the values in a range of device iterators.
+///
+/// The range_view class is the source of a view pipeline. It is usually
+/// created with the view::all() function.
+///
+/// \see view::all(), transform_view, filter_view, zip_view
+template<class Iterator>
+class range_view
+{
+public:
+    BOOST_STATIC_ASSERT_MSG(
+        is_device_iterator<Iterator>::value,
+        "Views can only be created from device iterators"
+    );
+
+    typedef typename std::iterator_traits<Iterator>::value_type value_type;
+    typedef Iterator iterator;
+
+    BOOST_STATIC_CONSTANT(bool, is_filtered = false);
+
+    range_view(Iterator first, Iterator last)
+        : m_first(first),
+          m_last(last)
+    {
+    }
+
+    Iterator begin() const
+    {
+        return m_first;
+    }
+
+    Iterator end() const
+    {
+        return m_last;
+    }
+
+    /// Returns the number of elements in the range.
+    size_t size() const
+    {
+        return detail::iterator_range_size(m_first, m_last);
+    }
+
+    /// \internal_
+    std::string emit(detail::view_emitter &e, const std::string &index) const
+    {
+        if(!e.values_needed()){
+            return std::string();
+        }
+
+        detail::meta_kernel &k = e.kernel();
+        const std::string value = e.variable();
+
+        k << k.decl<value_type>(value) << " = "
+          << m_first[k.var<uint_>(index)] << ";\n";
+
+        return value;
+    }
+
+private:
+    Iterator m_first;
+    Iterator m_last;
+};
+
+namespace view {
+
+/// Returns a view of the values in the range [\p first, \p last).
+///
+/// \see range_view
+template<class Iterator>
+inline range_view<Iterator> all(Iterator first, Iterator last)
+{
+    return range_view<Iterator>(first, last);
+}
+
+/// \overload
+///
+/// Returns a view of the values in \p container (e.g. a vector).
+template<class Container>
+inline range_view<typename Container::const_iterator>
+all(const Container &container)
+{
+    return range_view<typename Container::const_iterator>(
+        container.begin(), container.end()
+    );
+}
+
+} // end view namespace
+} // end compute namespace
+} // end boost namespace
+
+#endif // BOOST_COMPUTE_VIEW_RANGE_VIEW_HPP
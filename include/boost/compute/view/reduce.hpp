@@ -0,0 +1,159 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://boostorg.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#ifndef BOOST_COMPUTE_VIEW_REDUCE_HPP
+#define BOOST_COMPUTE_VIEW_REDUCE_HPP
+
+#include <iterator>
+
+#include <boost/utility/enable_if.hpp>
+
+#include <boost/compute/system.hpp>
+#include <boost/compute/command_queue.hpp>
+#include <boost/compute/container/vector.hpp>
+#include <boost/compute/functional/operator.hpp>
+#include <boost/compute/type_traits/is_device_iterator.hpp>
+#include <boost/compute/view/detail/reduce_view.hpp>
+
+namespace boost {
+namespace compute {
+namespace detail {
+
+// device output
+template<class View, class OutputIterator, class BinaryFunction>
+inline void dispatch_reduce_view(const View &view,
+                                 OutputIterator result,
+                                 BinaryFunction function,
+                                 command_queue &queue,
+                                 typename boost::enable_if<
+                                     is_device_iterator<OutputIterator>
+                                 >::type* = 0)
+{
+    typedef typename View::value_type value_type;
+
+    reduce_view<value_type>(
+        view, result, function, static_cast<const value_type *>(0), queue
+    );
+}
+
+// host output, the result is reduced into a temporary vector which holds
+// the current value of *result in case no values pass the filters
+template<class View, class OutputIterator, class BinaryFunction>
+inline void dispatch_reduce_view(const View &view,
+                                 OutputIterator result,
+                                 BinaryFunction function,
+                                 command_queue &queue,
+                                 typename boost::disable_if<
+                                     is_device_iterator<OutputIterator>
+                                 >::type* = 0)
+{
+    typedef typename View::value_type value_type;
+
+    if(view.size() == 0){
+        return;
+    }
+
+    vector<value_type> value(1, queue.get_context());
+    if(View::is_filtered){
+        value.begin().write(*result, queue);
+    }
+
+    reduce_view<value_type>(
+        view, value.begin(), function, static_cast<const value_type *>(0), queue
+    );
+
+    *result = value.begin().read(queue);
+}
+
+} // end detail namespace
+
+namespace view {
+
+/// Evaluates \p view and reduces its values with \p function. The result
+/// is written to \p result which may be a device or a host iterator.
+///
+/// The view is evaluated and reduced by a single kernel. If no values pass
+/// the filters of the view, \p result is not modified.
+///
+/// For example, to sum the squares of the positive values:
+/// \code
+/// float sum = 0;
+/// view::reduce(
+///     view::all(input) | view::filter(_1 > 0) | view::transform(_1 * _1),
+///     &sum,
+///     queue
+/// );
+/// \endcode
+///
+/// \p function must be associative and commutative.
+///
+/// Space complexity: \Omega(1)
+///
+/// \see view::accumulate(), view::count()
+template<class View, class OutputIterator, class BinaryFunction>
+inline void reduce(const View &view,
+                   OutputIterator result,
+                   BinaryFunction function,
+                   command_queue &queue = system::default_queue())
+{
+    detail::dispatch_reduce_view(view, result, function, queue);
+}
+
+/// \overload
+template<class View, class OutputIterator>
+inline void reduce(const View &view,
+                   OutputIterator result,
+                   command_queue &queue = system::default_queue())
+{
+    typedef typename View::value_type value_type;
+
+    detail::dispatch_reduce_view(view, result, plus<value_type>(), queue);
+}
+
+/// Evaluates \p view and returns \p init combined with its values using
+/// \p function. Returns \p init if no values pass the filters of the view.
+///
+/// The view is evaluated and reduced by a single kernel. The values are
+/// converted to \c T before they are combined. \p function must be
+/// associative and commutative.
+///
+/// Space complexity: \Omega(1)
+///
+/// \see view::reduce()
+template<class View, class T, class BinaryFunction>
+inline T accumulate(const View &view,
+                    T init,
+                    BinaryFunction function,
+                    command_queue &queue = system::default_queue())
+{
+    if(view.size() == 0){
+        return init;
+    }
+
+    vector<T> value(1, queue.get_context());
+    detail::reduce_view<T>(view, value.begin(), function, &init, queue);
+
+    return value.begin().read(queue);
+}
+
+/// \overload
+template<class View, class T>
+inline T accumulate(const View &view,
+                    T init,
+                    command_queue &queue = system::default_queue())
+{
+    return ::boost::compute::view::accumulate(view, init, plus<T>(), queue);
+}
+
+} // end view namespace
+} // end compute namespace
+} // end boost namespace
+
+#endif // BOOST_COMPUTE_VIEW_REDUCE_HPP
@@ -0,0 +1,185 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://boostorg.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#ifndef BOOST_COMPUTE_VIEW_TRANSFORM_VIEW_HPP
+#define BOOST_COMPUTE_VIEW_TRANSFORM_VIEW_HPP
+
+#include <string>
+
+#include <boost/config.hpp>
+#include <boost/mpl/if.hpp>
+#include <boost/type_traits/integral_constant.hpp>
+#include <boost/preprocessor/repetition/enum_params.hpp>
+#include <boost/tuple/tuple.hpp>
+
+#include <boost/compute/detail/meta_kernel.hpp>
+#include <boost/compute/functional/detail/unpack.hpp>
+#include <boost/compute/type_traits/result_of.hpp>
+#include <boost/compute/view/detail/view_emitter.hpp>
+
+namespace boost {
+namespace compute {
+namespace detail {
+
+// true if T is a boost::tuple (e.g. the value type of a zip_view)
+template<class T>
+struct is_view_tuple : public boost::false_type {};
+
+template<BOOST_PP_ENUM_PARAMS(10, class T)>
+struct is_view_tuple<boost::tuple<BOOST_PP_ENUM_PARAMS(10, T)> >
+    : public boost::true_type {};
+
+// functions applied to tuple values are called with the tuple's elements
+template<class Function, class T, bool IsTuple = is_view_tuple<T>::value>
+struct view_function
+{
+    typedef Function type;
+
+    static const Function& get(const Function &function)
+    {
+        return function;
+    }
+};
+
+template<class Function, class T>
+struct view_function<Function, T, true>
+{
+    typedef unpacked<Function> type;
+
+    static unpacked<Function> get(const Function &function)
+    {
+        return unpack(function);
+    }
+};
+
+} // end detail namespace
+
+/// \class transform_view
+/// \brief A view of the values of another view transformed by a function.
+///
+/// The function is applied when the view is consumed by one of the
+/// terminal operations (e.g. view::copy() or view::reduce()) in the same
+/// kernel which evaluates the rest of the pipeline. If the underlying view
+/// is a zip_view, the function is called with the elements of each tuple.
+///
+/// \see view::transform(), range_view, filter_view
+template<class View, class UnaryFunction>
+class transform_view
+{
+public:
+    typedef typename View::value_type input_type;
+    typedef detail::view_function<UnaryFunction, input_type> function_traits;
+    typedef typename function_traits::type function_type;
+    typedef typename
+        boost::compute::result_of<function_type(input_type)>::type value_type;
+
+    BOOST_STATIC_CONSTANT(bool, is_filtered = View::is_filtered);
+
+    transform_view(const View &view, UnaryFunction function)
+        : m_view(view),
+          m_function(function)
+    {
+    }
+
+    const View& base() const
+    {
+        return m_view;
+    }
+
+    size_t size() const
+    {
+        return m_view.size();
+    }
+
+    /// \internal_
+    std::string emit(detail::view_emitter &e, const std::string &index) const
+    {
+        detail::meta_kernel &k = e.kernel();
+        const std::string input = m_view.emit(e, index);
+        if(!e.values_needed()){
+            return input;
+        }
+
+        const std::string value = e.variable();
+
+        const function_type function = function_traits::get(m_function);
+
+        if(is_filtered){
+            // only evaluate the function for the values which are kept
+            k << k.decl<value_type>(value) << ";\n"
+              << "if(" << e.keep() << "){\n"
+              << value << " = " << function(k.var<input_type>(input)) << ";\n"
+              << "}\n";
+        }
+        else {
+            k << k.decl<value_type>(value) << " = "
+              << function(k.var<input_type>(input)) << ";\n";
+        }
+
+        return value;
+    }
+
+private:
+    View m_view;
+    UnaryFunction m_function;
+};
+
+namespace detail {
+
+template<class UnaryFunction>
+struct transform_view_adaptor
+{
+    explicit transform_view_adaptor(UnaryFunction function)
+        : m_function(function)
+    {
+    }
+
+    UnaryFunction m_function;
+};
+
+template<class View, class UnaryFunction>
+inline transform_view<View, UnaryFunction>
+operator|(const View &view, const transform_view_adaptor<UnaryFunction> &adaptor)
+{
+    return transform_view<View, UnaryFunction>(view, adaptor.m_function);
+}
+
+} // end detail namespace
+
+namespace view {
+
+/// Returns a view of the values in \p view transformed by \p function.
+///
+/// \see transform_view
+template<class View, class UnaryFunction>
+inline transform_view<View, UnaryFunction>
+transform(const View &view, UnaryFunction function)
+{
+    return transform_view<View, UnaryFunction>(view, function);
+}
+
+/// \overload
+///
+/// Returns an adaptor which can be applied to a view with \c operator|:
+/// \code
+/// view::all(vec) | view::transform(abs<int>())
+/// \endcode
+template<class UnaryFunction>
+inline detail::transform_view_adaptor<UnaryFunction>
+transform(UnaryFunction function)
+{
+    return detail::transform_view_adaptor<UnaryFunction>(function);
+}
+
+} // end view namespace
+} // end compute namespace
+} // end boost namespace
+
+#endif // BOOST_COMPUTE_VIEW_TRANSFORM_VIEW_HPP
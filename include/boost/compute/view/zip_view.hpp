@@ -0,0 +1,109 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://boostorg.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#ifndef BOOST_COMPUTE_VIEW_ZIP_VIEW_HPP
+#define BOOST_COMPUTE_VIEW_ZIP_VIEW_HPP
+
+#include <string>
+#include <algorithm>
+
+#include <boost/config.hpp>
+#include <boost/static_assert.hpp>
+#include <boost/tuple/tuple.hpp>
+
+#include <boost/compute/detail/meta_kernel.hpp>
+#include <boost/compute/types/tuple.hpp>
+#include <boost/compute/type_traits/type_name.hpp>
+#include <boost/compute/view/detail/view_emitter.hpp>
+
+namespace boost {
+namespace compute {
+
+/// \class zip_view
+/// \brief A view of the values of two views combined into tuples.
+///
+/// The values of a zip_view are \c boost::tuple's containing the values of
+/// each view at the same position. Functions and predicates applied to a
+/// zip_view (e.g. with view::transform()) are called with the elements of
+/// the tuple.
+///
+/// Both views must be unfiltered (the positions of the values in a
+/// filtered view are not known until it is compacted).
+///
+/// \see view::zip(), zip_iterator
+template<class View1, class View2>
+class zip_view
+{
+public:
+    BOOST_STATIC_ASSERT_MSG(
+        !View1::is_filtered && !View2::is_filtered,
+        "Filtered views cannot be zipped"
+    );
+
+    typedef boost::tuple<
+        typename View1::value_type, typename View2::value_type
+    > value_type;
+
+    BOOST_STATIC_CONSTANT(bool, is_filtered = false);
+
+    zip_view(const View1 &view1, const View2 &view2)
+        : m_view1(view1),
+          m_view2(view2)
+    {
+    }
+
+    /// Returns the number of values in the shorter of the two views.
+    size_t size() const
+    {
+        return (std::min)(m_view1.size(), m_view2.size());
+    }
+
+    /// \internal_
+    std::string emit(detail::view_emitter &e, const std::string &index) const
+    {
+        detail::meta_kernel &k = e.kernel();
+        const std::string first = m_view1.emit(e, index);
+        const std::string second = m_view2.emit(e, index);
+        if(!e.values_needed()){
+            return std::string();
+        }
+
+        const std::string value = e.variable();
+
+        k.inject_type<value_type>();
+        k << k.decl<value_type>(value) << " = "
+          << "(" << type_name<value_type>() << "){ "
+          << first << ", " << second << " };\n";
+
+        return value;
+    }
+
+private:
+    View1 m_view1;
+    View2 m_view2;
+};
+
+namespace view {
+
+/// Returns a view of the values in \p view1 and \p view2 combined into
+/// tuples.
+///
+/// \see zip_view
+template<class View1, class View2>
+inline zip_view<View1, View2> zip(const View1 &view1, const View2 &view2)
+{
+    return zip_view<View1, View2>(view1, view2);
+}
+
+} // end view namespace
+} // end compute namespace
+} // end boost namespace
+
+#endif // BOOST_COMPUTE_VIEW_ZIP_VIEW_HPP
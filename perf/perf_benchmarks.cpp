@@ -0,0 +1,1366 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://boostorg.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+// runs the registered algorithm benchmarks over a set of input sizes and
+// distributions and reports statistics for the measured times. the results
+// can be written as JSON and compared between runs with perf_compare.py:
+//
+//   ./perf/perf_benchmarks --filter sort --sizes 1024:1048576 --distributions all --json base.json
+//   ./perf/perf_benchmarks ... --json new.json
+//   python perf/perf_compare.py base.json new.json
+
+#include <algorithm>
+#include <complex>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <numeric>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <boost/program_options.hpp>
+
+#include <boost/compute/system.hpp>
+#include <boost/compute/lambda.hpp>
+#include <boost/compute/function.hpp>
+#include <boost/compute/algorithm.hpp>
+#include <boost/compute/algorithm/detail/binary_find.hpp>
+#include <boost/compute/algorithm/detail/host_backend.hpp>
+#include <boost/compute/algorithm/histogram.hpp>
+#include <boost/compute/algorithm/nth_element.hpp>
+#include <boost/compute/container/vector.hpp>
+#include <boost/compute/detail/parameter_cache.hpp>
+#include <boost/compute/fft/fft_plan.hpp>
+#include <boost/compute/random.hpp>
+#include <boost/compute/type_traits/scalar_type.hpp>
+#include <boost/compute/type_traits/type_name.hpp>
+#include <boost/compute/types/fundamental.hpp>
+#include <boost/compute/utility/command_graph.hpp>
+#include <boost/compute/utility/numa.hpp>
+
+#include "perf_runner.hpp"
+
+namespace compute = boost::compute;
+namespace po = boost::program_options;
+
+using compute::lambda::_1;
+using compute::lambda::_2;
+
+// values in [0, 25) as used by most of the perf_* programs
+static const unsigned int small_values = 25;
+
+template<class T>
+void upload(const std::vector<T> &host,
+            compute::vector<T> &vec,
+            compute::command_queue &queue)
+{
+    compute::copy(host.begin(), host.end(), vec.begin(), queue);
+}
+
+template<class T>
+void perf_accumulate(perf_state &state)
+{
+    std::vector<T> host = state.input<T>(0, 1000);
+    compute::vector<T> vec(host.begin(), host.end(), state.queue());
+
+    while(state.keep_running()){
+        state.start_timer();
+        compute::accumulate(vec.begin(), vec.end(), T(0), state.queue());
+        state.stop_timer();
+    }
+}
+PERF_BENCHMARK("accumulate/int", perf_accumulate<int>)
+PERF_BENCHMARK("accumulate/float", perf_accumulate<float>)
+
+void perf_bernoulli_distribution(perf_state &state)
+{
+    compute::vector<compute::uint_> vec(state.size(), state.context());
+    compute::default_random_engine rng(state.queue());
+    compute::bernoulli_distribution<float> dist(0.5);
+
+    while(state.keep_running()){
+        state.start_timer();
+        dist.generate(vec.begin(), vec.end(), rng, state.queue());
+        state.stop_timer();
+    }
+}
+PERF_BENCHMARK_NO_INPUT("bernoulli_distribution", perf_bernoulli_distribution)
+
+void perf_binary_find(perf_state &state)
+{
+    std::vector<int> host = state.input<int>(0, small_values);
+    compute::vector<int> vec(host.begin(), host.end(), state.queue());
+    compute::partition(vec.begin(), vec.end(), _1 < 20, state.queue());
+
+    while(state.keep_running()){
+        state.start_timer();
+        compute::detail::binary_find(vec.begin(), vec.end(), _1 >= 20, state.queue());
+        state.stop_timer();
+    }
+}
+PERF_BENCHMARK("binary_find", perf_binary_find)
+
+// converts from cartesian coordinates (x, y) to polar coordinates (magnitude, angle)
+BOOST_COMPUTE_FUNCTION(compute::float2_, cartesian_to_polar, (compute::float2_ p),
+{
+    float x = p.x;
+    float y = p.y;
+
+    float magnitude = sqrt(x*x + y*y);
+    float angle = atan2(y, x) * 180.f / M_PI;
+
+    return (float2)(magnitude, angle);
+});
+
+void perf_cart_to_polar(perf_state &state)
+{
+    std::vector<float> host = state.input<float>(state.size() * 2, 0, 1000);
+    compute::vector<compute::float2_> vec(state.size(), state.context());
+
+    while(state.keep_running()){
+        compute::copy_n(
+            reinterpret_cast<compute::float2_ *>(&host[0]),
+            state.size(),
+            vec.begin(),
+            state.queue()
+        );
+        state.start_timer();
+        compute::transform(
+            vec.begin(), vec.end(), vec.begin(), cartesian_to_polar, state.queue()
+        );
+        state.stop_timer();
+    }
+}
+PERF_BENCHMARK("cart_to_polar", perf_cart_to_polar)
+
+void perf_command_graph(perf_state &state)
+{
+    compute::command_queue &queue = state.queue();
+    const size_t size = state.size();
+
+    std::vector<int> host_keys = state.input<int>(0, 16);
+    std::vector<int> host_values = state.input<int>(1, 1000);
+    std::vector<int> host_result(size);
+
+    compute::vector<int> keys(size, state.context());
+    compute::vector<int> values(size, state.context());
+    compute::vector<int> reduced_keys(size, state.context());
+    compute::vector<int> reduced_values(size, state.context());
+    compute::vector<int> result(size, state.context());
+
+    compute::command_graph graph(queue);
+    graph.begin_recording();
+    upload(host_keys, keys, queue);
+    upload(host_values, values, queue);
+    compute::transform(values.begin(), values.end(), values.begin(), _1 * 3 + 1, queue);
+    compute::sort_by_key(keys.begin(), keys.end(), values.begin(), queue);
+    compute::reduce_by_key(
+        keys.begin(), keys.end(), values.begin(),
+        reduced_keys.begin(), reduced_values.begin(), queue
+    );
+    compute::copy_if(
+        reduced_values.begin(), reduced_values.end(), result.begin(), _1 > 100, queue
+    );
+    compute::copy(result.begin(), result.end(), host_result.begin(), queue);
+    graph.end_recording();
+
+    while(state.keep_running()){
+        state.start_timer();
+        graph.replay().wait();
+        state.stop_timer();
+    }
+}
+PERF_BENCHMARK("command_graph", perf_command_graph)
+
+BOOST_COMPUTE_FUNCTION(bool, perf_less, (int a, int b),
+{
+    return a < b;
+});
+
+void perf_comparison_sort(perf_state &state)
+{
+    std::vector<int> host = state.input<int>();
+    compute::vector<int> vec(state.size(), state.context());
+
+    while(state.keep_running()){
+        upload(host, vec, state.queue());
+        state.start_timer();
+        compute::sort(vec.begin(), vec.end(), perf_less, state.queue());
+        state.stop_timer();
+    }
+}
+PERF_BENCHMARK("comparison_sort", perf_comparison_sort)
+
+BOOST_COMPUTE_FUNCTION(bool, is_odd, (int x),
+{
+    return x & 1;
+});
+
+void perf_copy_if(perf_state &state)
+{
+    std::vector<int> host = state.input<int>(0, 10);
+    compute::vector<int> input(host.begin(), host.end(), state.queue());
+    compute::vector<int> output(state.size(), state.context());
+
+    while(state.keep_running()){
+        state.start_timer();
+        compute::copy_if(input.begin(), input.end(), output.begin(), is_odd, state.queue());
+        state.stop_timer();
+    }
+}
+PERF_BENCHMARK("copy_if", perf_copy_if)
+
+void perf_copy_to_device(perf_state &state)
+{
+    std::vector<int> host = state.input<int>();
+    compute::vector<int> vec(state.size(), state.context());
+
+    while(state.keep_running()){
+        state.start_timer();
+        compute::copy_async(host.begin(), host.end(), vec.begin(), state.queue()).wait();
+        state.stop_timer();
+    }
+}
+PERF_BENCHMARK_NO_INPUT("copy_to_device", perf_copy_to_device)
+
+void perf_count(perf_state &state)
+{
+    std::vector<int> host = state.input<int>(0, small_values);
+    compute::vector<int> vec(host.begin(), host.end(), state.queue());
+
+    while(state.keep_running()){
+        state.start_timer();
+        compute::count(vec.begin(), vec.end(), 4, state.queue());
+        state.stop_timer();
+    }
+}
+PERF_BENCHMARK("count", perf_count)
+
+void perf_discrete_distribution(perf_state &state)
+{
+    compute::vector<compute::uint_> vec(state.size(), state.context());
+    compute::default_random_engine rng(state.queue());
+    int weights[] = { 1, 1 };
+    compute::discrete_distribution<compute::uint_> dist(weights, weights + 2);
+
+    while(state.keep_running()){
+        state.start_timer();
+        dist.generate(vec.begin(), vec.end(), rng, state.queue());
+        state.stop_timer();
+    }
+}
+PERF_BENCHMARK_NO_INPUT("discrete_distribution", perf_discrete_distribution)
+
+void perf_erase_remove(perf_state &state)
+{
+    std::vector<int> host = state.input<int>(0, small_values);
+
+    while(state.keep_running()){
+        compute::vector<int> vec(host.begin(), host.end(), state.queue());
+        state.start_timer();
+        vec.erase(compute::remove(vec.begin(), vec.end(), 4, state.queue()), vec.end());
+        state.stop_timer();
+    }
+}
+PERF_BENCHMARK("erase_remove", perf_erase_remove)
+
+void perf_exclusive_scan(perf_state &state)
+{
+    std::vector<int> host = state.input<int>(0, small_values);
+    compute::vector<int> input(host.begin(), host.end(), state.queue());
+    compute::vector<int> output(state.size(), state.context());
+
+    while(state.keep_running()){
+        state.start_timer();
+        compute::exclusive_scan(input.begin(), input.end(), output.begin(), state.queue());
+        state.stop_timer();
+    }
+}
+PERF_BENCHMARK("exclusive_scan", perf_exclusive_scan)
+
+// largest supported transform length which is at most length
+size_t fft_length(size_t length)
+{
+    while(length > 1 && !compute::fft_plan<float>::is_supported_length(length)){
+        length--;
+    }
+    return length;
+}
+
+// batched forward transforms of the input, split into transforms of up to
+// 1024 values or into square two-dimensional transforms of up to 32 * 32
+// values
+template<bool TwoDimensional>
+void perf_fft(perf_state &state)
+{
+    const size_t length =
+        fft_length((std::min)(state.size(), size_t(TwoDimensional ? 32 : 1024)));
+    const size_t values = TwoDimensional ? length * length : length;
+    const size_t batch_size = (std::max)(state.size() / values, size_t(1));
+
+    std::vector<float> host = state.input<float>(2 * values * batch_size, 0, 1000);
+    compute::vector<std::complex<float> > input(values * batch_size, state.context());
+    compute::vector<std::complex<float> > output(values * batch_size, state.context());
+    compute::copy_n(
+        reinterpret_cast<std::complex<float> *>(&host[0]),
+        values * batch_size,
+        input.begin(),
+        state.queue()
+    );
+
+    compute::fft_plan<float> plan = TwoDimensional ?
+        compute::fft_plan<float>(length, length, batch_size, state.context()) :
+        compute::fft_plan<float>(length, batch_size, state.context());
+
+    while(state.keep_running()){
+        state.start_timer();
+        plan.forward(input.begin(), output.begin(), state.queue());
+        state.stop_timer();
+    }
+}
+PERF_BENCHMARK("fft/1d", perf_fft<false>)
+PERF_BENCHMARK("fft/2d", perf_fft<true>)
+
+void perf_fill(perf_state &state)
+{
+    compute::vector<int> vec(state.size(), state.context());
+
+    int value = 0;
+    while(state.keep_running()){
+        state.start_timer();
+        compute::fill(vec.begin(), vec.end(), value++, state.queue());
+        state.stop_timer();
+    }
+}
+PERF_BENCHMARK_NO_INPUT("fill", perf_fill)
+
+void perf_find(perf_state &state)
+{
+    std::vector<int> host = state.input<int>(0, small_values);
+    compute::vector<int> vec(host.begin(), host.end(), state.queue());
+
+    while(state.keep_running()){
+        state.start_timer();
+        // not in the input so the whole range is searched
+        compute::find(vec.begin(), vec.end(), int(small_values), state.queue());
+        state.stop_timer();
+    }
+}
+PERF_BENCHMARK("find", perf_find)
+
+void perf_find_end(perf_state &state)
+{
+    std::vector<int> host = state.input<int>(0, small_values);
+    compute::vector<int> vec(host.begin(), host.end(), state.queue());
+
+    int pattern[] = { 2, 6, 6, 7, 8, 4 };
+    compute::vector<int> pattern_vec(pattern, pattern + 6, state.queue());
+
+    while(state.keep_running()){
+        state.start_timer();
+        compute::find_end(
+            vec.begin(), vec.end(), pattern_vec.begin(), pattern_vec.end(), state.queue()
+        );
+        state.stop_timer();
+    }
+}
+PERF_BENCHMARK("find_end", perf_find_end)
+
+void perf_histogram(perf_state &state)
+{
+    const compute::uint_ bins = 256;
+
+    std::vector<compute::uint_> host = state.input<compute::uint_>(0, bins);
+    compute::vector<compute::uint_> vec(host.begin(), host.end(), state.queue());
+    compute::vector<compute::uint_> counts(bins, state.context());
+
+    while(state.keep_running()){
+        state.start_timer();
+        compute::histogram_even(
+            vec.begin(), vec.end(),
+            bins, compute::uint_(0), bins,
+            counts.begin(), state.queue()
+        );
+        state.stop_timer();
+    }
+}
+PERF_BENCHMARK("histogram", perf_histogram)
+
+// the host backend is opt-in and not enabled for these benchmarks, so the
+// host side of the crossovers measured by perf_host_crossover is timed on
+// the same mapped ranges and host function objects which the backend uses
+template<bool Host>
+void perf_host_crossover_sort(perf_state &state)
+{
+    typedef compute::detail::host_function<compute::less<int>, int>::type host_less;
+
+    std::vector<int> host = state.input<int>();
+    compute::vector<int> vec(state.size(), state.context());
+
+    while(state.keep_running()){
+        upload(host, vec, state.queue());
+        state.start_timer();
+        if(Host){
+            compute::detail::host_access_range<compute::vector<int>::iterator> range(
+                vec.begin(), vec.end(), CL_MAP_READ | CL_MAP_WRITE, state.queue()
+            );
+            std::sort(range.begin(), range.end(), host_less());
+        }
+        else {
+            compute::sort(vec.begin(), vec.end(), state.queue());
+        }
+        state.stop_timer();
+    }
+}
+PERF_BENCHMARK("host_crossover/sort/host", perf_host_crossover_sort<true>)
+PERF_BENCHMARK("host_crossover/sort/device", perf_host_crossover_sort<false>)
+
+template<bool Host>
+void perf_host_crossover_reduce(perf_state &state)
+{
+    std::vector<int> host = state.input<int>(0, 1000);
+    compute::vector<int> vec(host.begin(), host.end(), state.queue());
+
+    while(state.keep_running()){
+        int sum = 0;
+        state.start_timer();
+        if(Host){
+            compute::detail::host_access_range<compute::vector<int>::iterator> range(
+                vec.begin(), vec.end(), CL_MAP_READ, state.queue()
+            );
+            sum = std::accumulate(range.begin(), range.end(), 0);
+        }
+        else {
+            compute::reduce(vec.begin(), vec.end(), &sum, state.queue());
+        }
+        state.stop_timer();
+    }
+}
+PERF_BENCHMARK("host_crossover/reduce/host", perf_host_crossover_reduce<true>)
+PERF_BENCHMARK("host_crossover/reduce/device", perf_host_crossover_reduce<false>)
+
+template<bool Host>
+void perf_host_crossover_find(perf_state &state)
+{
+    std::vector<int> host = state.input<int>(0, 1000);
+    compute::vector<int> vec(host.begin(), host.end(), state.queue());
+
+    // search for a value which is not in the range
+    while(state.keep_running()){
+        state.start_timer();
+        if(Host){
+            compute::detail::host_access_range<compute::vector<int>::iterator> range(
+                vec.begin(), vec.end(), CL_MAP_READ, state.queue()
+            );
+            std::find(range.begin(), range.end(), -1);
+        }
+        else {
+            compute::find(vec.begin(), vec.end(), -1, state.queue());
+        }
+        state.stop_timer();
+    }
+}
+PERF_BENCHMARK("host_crossover/find/host", perf_host_crossover_find<true>)
+PERF_BENCHMARK("host_crossover/find/device", perf_host_crossover_find<false>)
+
+void perf_host_sort(perf_state &state)
+{
+    std::vector<int> host = state.input<int>();
+    std::vector<int> vec;
+
+    while(state.keep_running()){
+        vec = host;
+        state.start_timer();
+        compute::sort(vec.begin(), vec.end(), state.queue());
+        state.stop_timer();
+    }
+}
+PERF_BENCHMARK("host_sort", perf_host_sort)
+
+// generates the two sorted halves of the input used by the merge and set
+// operation benchmarks
+void sorted_halves(perf_state &state,
+                   unsigned int max_value,
+                   compute::vector<int> &v1,
+                   compute::vector<int> &v2)
+{
+    std::vector<int> host = state.input<int>(0, max_value);
+    std::vector<int>::iterator middle = host.begin() + host.size() / 2;
+    std::sort(host.begin(), middle);
+    std::sort(middle, host.end());
+
+    v1.assign(host.begin(), middle, state.queue());
+    v2.assign(middle, host.end(), state.queue());
+}
+
+void perf_includes(perf_state &state)
+{
+    std::vector<int> host = state.input<int>(0, small_values);
+    std::sort(host.begin(), host.end());
+    compute::vector<int> vec(host.begin(), host.end(), state.queue());
+    compute::vector<int> subset(host.begin(), host.begin() + host.size() / 2, state.queue());
+
+    while(state.keep_running()){
+        state.start_timer();
+        compute::includes(
+            vec.begin(), vec.end(), subset.begin(), subset.end(), state.queue()
+        );
+        state.stop_timer();
+    }
+}
+PERF_BENCHMARK("includes", perf_includes)
+
+void perf_inner_product(perf_state &state)
+{
+    std::vector<int> host1 = state.input<int>(0, small_values);
+    std::vector<int> host2 = state.input<int>(1, small_values);
+    compute::vector<int> v1(host1.begin(), host1.end(), state.queue());
+    compute::vector<int> v2(host2.begin(), host2.end(), state.queue());
+
+    while(state.keep_running()){
+        state.start_timer();
+        compute::inner_product(v1.begin(), v1.end(), v2.begin(), 0, state.queue());
+        state.stop_timer();
+    }
+}
+PERF_BENCHMARK("inner_product", perf_inner_product)
+
+void perf_is_permutation(perf_state &state)
+{
+    std::vector<int> host = state.input<int>(0, small_values);
+    compute::vector<int> v1(host.begin(), host.end(), state.queue());
+    std::reverse(host.begin(), host.end());
+    compute::vector<int> v2(host.begin(), host.end(), state.queue());
+
+    while(state.keep_running()){
+        state.start_timer();
+        compute::is_permutation(v1.begin(), v1.end(), v2.begin(), v2.end(), state.queue());
+        state.stop_timer();
+    }
+}
+PERF_BENCHMARK("is_permutation", perf_is_permutation)
+
+void perf_is_sorted(perf_state &state)
+{
+    std::vector<int> host = state.input<int>();
+    std::sort(host.begin(), host.end());
+    compute::vector<int> vec(host.begin(), host.end(), state.queue());
+
+    while(state.keep_running()){
+        state.start_timer();
+        compute::is_sorted(vec.begin(), vec.end(), state.queue());
+        state.stop_timer();
+    }
+}
+PERF_BENCHMARK("is_sorted", perf_is_sorted)
+
+void perf_max_element(perf_state &state)
+{
+    std::vector<int> host = state.input<int>();
+    compute::vector<int> vec(host.begin(), host.end(), state.queue());
+
+    while(state.keep_running()){
+        state.start_timer();
+        compute::max_element(vec.begin(), vec.end(), state.queue());
+        state.stop_timer();
+    }
+}
+PERF_BENCHMARK("max_element", perf_max_element)
+
+void perf_merge(perf_state &state)
+{
+    compute::vector<int> v1(state.context());
+    compute::vector<int> v2(state.context());
+    sorted_halves(state, small_values, v1, v2);
+    compute::vector<int> result(state.size(), state.context());
+
+    while(state.keep_running()){
+        state.start_timer();
+        compute::merge(
+            v1.begin(), v1.end(), v2.begin(), v2.end(), result.begin(), state.queue()
+        );
+        state.stop_timer();
+    }
+}
+PERF_BENCHMARK("merge", perf_merge)
+
+void perf_next_permutation(perf_state &state)
+{
+    std::vector<int> host = state.input<int>(0, small_values);
+    compute::vector<int> vec(state.size(), state.context());
+
+    while(state.keep_running()){
+        upload(host, vec, state.queue());
+        state.start_timer();
+        compute::next_permutation(vec.begin(), vec.end(), state.queue());
+        state.stop_timer();
+    }
+}
+PERF_BENCHMARK("next_permutation", perf_next_permutation)
+
+void perf_nth_element(perf_state &state)
+{
+    std::vector<int> host = state.input<int>();
+    compute::vector<int> vec(state.size(), state.context());
+
+    while(state.keep_running()){
+        upload(host, vec, state.queue());
+        state.start_timer();
+        compute::nth_element(
+            vec.begin(), vec.begin() + state.size() / 2, vec.end(), state.queue()
+        );
+        state.stop_timer();
+    }
+}
+PERF_BENCHMARK("nth_element", perf_nth_element)
+
+void perf_numa(perf_state &state)
+{
+    compute::multi_queue queues = compute::make_numa_queues(state.queue().get_device());
+    const compute::context context = queues.get_context();
+
+    std::vector<float> host_x = state.input<float>(0, 1000);
+    std::vector<float> host_y = state.input<float>(1, 1000);
+
+    compute::vector<float> x(host_x.size(), context);
+    compute::vector<float> y(host_y.size(), context);
+    compute::vector<float> result(host_x.size(), context);
+    compute::first_touch(x.begin(), x.end(), queues);
+    compute::first_touch(y.begin(), y.end(), queues);
+    compute::first_touch(result.begin(), result.end(), queues);
+    compute::copy(host_x.begin(), host_x.end(), x.begin(), queues.get_queue(0));
+    compute::copy(host_y.begin(), host_y.end(), y.begin(), queues.get_queue(0));
+    queues.get_queue(0).finish();
+
+    float sum = 0;
+    while(state.keep_running()){
+        state.start_timer();
+        compute::transform(
+            x.begin(), x.end(), y.begin(), result.begin(), 2.5f * _1 + _2, queues
+        );
+        compute::reduce(result.begin(), result.end(), &sum, queues);
+        state.stop_timer();
+    }
+}
+PERF_BENCHMARK("numa", perf_numa)
+
+void perf_partial_sum(perf_state &state)
+{
+    std::vector<int> host = state.input<int>(0, small_values);
+    compute::vector<int> input(host.begin(), host.end(), state.queue());
+    compute::vector<int> output(state.size(), state.context());
+
+    while(state.keep_running()){
+        state.start_timer();
+        compute::partial_sum(input.begin(), input.end(), output.begin(), state.queue());
+        state.stop_timer();
+    }
+}
+PERF_BENCHMARK("partial_sum", perf_partial_sum)
+
+void perf_partition(perf_state &state)
+{
+    std::vector<int> host = state.input<int>(0, small_values);
+    compute::vector<int> vec(state.size(), state.context());
+
+    while(state.keep_running()){
+        upload(host, vec, state.queue());
+        state.start_timer();
+        compute::partition(vec.begin(), vec.end(), _1 < 10, state.queue());
+        state.stop_timer();
+    }
+}
+PERF_BENCHMARK("partition", perf_partition)
+
+void perf_partition_point(perf_state &state)
+{
+    std::vector<int> host = state.input<int>(0, small_values);
+    compute::vector<int> vec(host.begin(), host.end(), state.queue());
+    compute::partition(vec.begin(), vec.end(), _1 < 20, state.queue());
+
+    while(state.keep_running()){
+        state.start_timer();
+        compute::partition_point(vec.begin(), vec.end(), _1 < 20, state.queue());
+        state.stop_timer();
+    }
+}
+PERF_BENCHMARK("partition_point", perf_partition_point)
+
+void perf_prev_permutation(perf_state &state)
+{
+    std::vector<int> host = state.input<int>(0, small_values);
+    compute::vector<int> vec(state.size(), state.context());
+
+    while(state.keep_running()){
+        upload(host, vec, state.queue());
+        state.start_timer();
+        compute::prev_permutation(vec.begin(), vec.end(), state.queue());
+        state.stop_timer();
+    }
+}
+PERF_BENCHMARK("prev_permutation", perf_prev_permutation)
+
+template<class Engine>
+void perf_random_number_engine(perf_state &state)
+{
+    typedef typename Engine::result_type T;
+
+    Engine engine(state.queue());
+    compute::vector<T> vec(state.size(), state.context());
+
+    while(state.keep_running()){
+        state.start_timer();
+        engine.generate(vec.begin(), vec.end(), state.queue());
+        state.stop_timer();
+    }
+}
+PERF_BENCHMARK_NO_INPUT(
+    "random_number_engine/default_random_engine",
+    perf_random_number_engine<compute::default_random_engine>
+)
+PERF_BENCHMARK_NO_INPUT(
+    "random_number_engine/mersenne_twister_engine",
+    perf_random_number_engine<compute::mt19937>
+)
+PERF_BENCHMARK_NO_INPUT(
+    "random_number_engine/linear_congruential_engine",
+    perf_random_number_engine<compute::linear_congruential_engine<> >
+)
+PERF_BENCHMARK_NO_INPUT(
+    "random_number_engine/threefry_engine",
+    perf_random_number_engine<compute::threefry_engine<> >
+)
+
+void perf_reduce_by_key(perf_state &state)
+{
+    // sorted keys so the distribution determines the length of the runs
+    std::vector<int> host_keys = state.input<int>(
+        state.size(), 0, static_cast<unsigned int>(state.size() / 512 + 1)
+    );
+    std::sort(host_keys.begin(), host_keys.end());
+    std::vector<int> host_values = state.input<int>(1, small_values);
+
+    compute::vector<int> keys(host_keys.begin(), host_keys.end(), state.queue());
+    compute::vector<int> values(host_values.begin(), host_values.end(), state.queue());
+    compute::vector<int> keys_result(state.size(), state.context());
+    compute::vector<int> values_result(state.size(), state.context());
+
+    while(state.keep_running()){
+        state.start_timer();
+        compute::reduce_by_key(
+            keys.begin(), keys.end(), values.begin(),
+            keys_result.begin(), values_result.begin(), state.queue()
+        );
+        state.stop_timer();
+    }
+}
+PERF_BENCHMARK("reduce_by_key", perf_reduce_by_key)
+
+void perf_reverse(perf_state &state)
+{
+    std::vector<int> host = state.input<int>();
+    compute::vector<int> vec(host.begin(), host.end(), state.queue());
+
+    while(state.keep_running()){
+        state.start_timer();
+        compute::reverse(vec.begin(), vec.end(), state.queue());
+        state.stop_timer();
+    }
+}
+PERF_BENCHMARK("reverse", perf_reverse)
+
+void perf_reverse_copy(perf_state &state)
+{
+    std::vector<int> host = state.input<int>();
+    compute::vector<int> input(host.begin(), host.end(), state.queue());
+    compute::vector<int> output(state.size(), state.context());
+
+    while(state.keep_running()){
+        state.start_timer();
+        compute::reverse_copy(input.begin(), input.end(), output.begin(), state.queue());
+        state.stop_timer();
+    }
+}
+PERF_BENCHMARK("reverse_copy", perf_reverse_copy)
+
+void perf_rotate(perf_state &state)
+{
+    std::vector<int> host = state.input<int>();
+    compute::vector<int> vec(host.begin(), host.end(), state.queue());
+
+    while(state.keep_running()){
+        state.start_timer();
+        compute::rotate(
+            vec.begin(), vec.begin() + state.size() / 2, vec.end(), state.queue()
+        );
+        state.stop_timer();
+    }
+}
+PERF_BENCHMARK("rotate", perf_rotate)
+
+void perf_rotate_copy(perf_state &state)
+{
+    std::vector<int> host = state.input<int>();
+    compute::vector<int> input(host.begin(), host.end(), state.queue());
+    compute::vector<int> output(state.size(), state.context());
+
+    while(state.keep_running()){
+        state.start_timer();
+        compute::rotate_copy(
+            input.begin(), input.begin() + state.size() / 2, input.end(),
+            output.begin(), state.queue()
+        );
+        state.stop_timer();
+    }
+}
+PERF_BENCHMARK("rotate_copy", perf_rotate_copy)
+
+template<class T>
+void perf_saxpy(perf_state &state)
+{
+    std::vector<T> host_x = state.input<T>(0, 1000);
+    std::vector<T> host_y = state.input<T>(1, 1000);
+    compute::vector<T> x(host_x.begin(), host_x.end(), state.queue());
+    compute::vector<T> y(host_y.begin(), host_y.end(), state.queue());
+    compute::vector<T> result(state.size(), state.context());
+
+    while(state.keep_running()){
+        state.start_timer();
+        compute::transform(
+            x.begin(), x.end(), y.begin(), result.begin(), T(2.5) * _1 + _2, state.queue()
+        );
+        state.stop_timer();
+    }
+}
+PERF_BENCHMARK("saxpy", perf_saxpy<float>)
+
+void perf_search(perf_state &state)
+{
+    std::vector<int> host = state.input<int>(0, small_values);
+    compute::vector<int> vec(host.begin(), host.end(), state.queue());
+
+    int pattern[] = { 2, 6, 6, 7, 8, 4 };
+    compute::vector<int> pattern_vec(pattern, pattern + 6, state.queue());
+
+    while(state.keep_running()){
+        state.start_timer();
+        compute::search(
+            vec.begin(), vec.end(), pattern_vec.begin(), pattern_vec.end(), state.queue()
+        );
+        state.stop_timer();
+    }
+}
+PERF_BENCHMARK("search", perf_search)
+
+// random text of lower case letters and the 32 words of 2 to 6 letters
+// searched for by the search_any benchmarks
+void search_any_input(perf_state &state,
+                      std::vector<char> &text,
+                      std::vector<std::string> &words)
+{
+    std::vector<unsigned char> letters = state.input<unsigned char>(0, 26);
+    text.resize(letters.size());
+    for(size_t i = 0; i < letters.size(); i++){
+        text[i] = static_cast<char>('a' + letters[i]);
+    }
+
+    std::vector<unsigned char> word_letters = perf_generate<unsigned char>(
+        32 * 6, perf_uniform, 26, 1
+    );
+    words.resize(32);
+    for(size_t i = 0; i < words.size(); i++){
+        words[i].resize(2 + i % 5);
+        for(size_t j = 0; j < words[i].size(); j++){
+            words[i][j] = static_cast<char>('a' + word_letters[i * 6 + j]);
+        }
+    }
+}
+
+void perf_search_any(perf_state &state)
+{
+    std::vector<char> host_text;
+    std::vector<std::string> words;
+    search_any_input(state, host_text, words);
+
+    compute::vector<char> text(host_text.begin(), host_text.end(), state.queue());
+    compute::vector<compute::uint2_> matches(state.size(), state.context());
+
+    while(state.keep_running()){
+        state.start_timer();
+        compute::search_any(
+            text.begin(), text.end(), words.begin(), words.end(),
+            matches.begin(), matches.end(), state.queue()
+        );
+        state.stop_timer();
+    }
+}
+PERF_BENCHMARK("search_any", perf_search_any)
+
+// searches for each word with std::search() as perf_stl_search_any
+void perf_stl_search_any(perf_state &state)
+{
+    std::vector<char> text;
+    std::vector<std::string> words;
+    search_any_input(state, text, words);
+
+    while(state.keep_running()){
+        state.start_timer();
+        size_t match_count = 0;
+        for(size_t i = 0; i < words.size(); i++){
+            std::vector<char>::iterator iter = text.begin();
+            for(;;){
+                iter = std::search(iter, text.end(), words[i].begin(), words[i].end());
+                if(iter == text.end()){
+                    break;
+                }
+                match_count++;
+                ++iter;
+            }
+        }
+        state.stop_timer();
+        (void) match_count;
+    }
+}
+PERF_BENCHMARK("search_any/stl", perf_stl_search_any)
+
+void perf_search_n(perf_state &state)
+{
+    std::vector<int> host = state.input<int>(0, small_values);
+    compute::vector<int> vec(host.begin(), host.end(), state.queue());
+
+    while(state.keep_running()){
+        state.start_timer();
+        compute::search_n(vec.begin(), vec.end(), 5, 2, state.queue());
+        state.stop_timer();
+    }
+}
+PERF_BENCHMARK("search_n", perf_search_n)
+
+#define PERF_SET_OPERATION(name) \
+    void perf_ ## name(perf_state &state) \
+    { \
+        compute::vector<int> v1(state.context()); \
+        compute::vector<int> v2(state.context()); \
+        sorted_halves(state, small_values, v1, v2); \
+        compute::vector<int> result(state.size(), state.context()); \
+        \
+        while(state.keep_running()){ \
+            state.start_timer(); \
+            compute::name( \
+                v1.begin(), v1.end(), v2.begin(), v2.end(), \
+                result.begin(), state.queue() \
+            ); \
+            state.stop_timer(); \
+        } \
+    } \
+    PERF_BENCHMARK(#name, perf_ ## name)
+
+PERF_SET_OPERATION(set_difference)
+PERF_SET_OPERATION(set_intersection)
+PERF_SET_OPERATION(set_symmetric_difference)
+PERF_SET_OPERATION(set_union)
+
+#undef PERF_SET_OPERATION
+
+template<class T>
+void perf_sort(perf_state &state)
+{
+    std::vector<T> host = state.input<T>();
+    compute::vector<T> vec(state.size(), state.context());
+
+    while(state.keep_running()){
+        upload(host, vec, state.queue());
+        state.start_timer();
+        compute::sort(vec.begin(), vec.end(), state.queue());
+        state.stop_timer();
+    }
+}
+PERF_BENCHMARK("sort/int", perf_sort<int>)
+PERF_BENCHMARK("sort/uint", perf_sort<compute::uint_>)
+PERF_BENCHMARK("sort/float", perf_sort<float>)
+
+void perf_sort_by_key(perf_state &state)
+{
+    std::vector<compute::uint_> host_keys = state.input<compute::uint_>(0);
+    std::vector<compute::uint_> host_values = state.input<compute::uint_>(1);
+    compute::vector<compute::uint_> keys(state.size(), state.context());
+    compute::vector<compute::uint_> values(state.size(), state.context());
+
+    while(state.keep_running()){
+        upload(host_keys, keys, state.queue());
+        upload(host_values, values, state.queue());
+        state.start_timer();
+        compute::sort_by_key(keys.begin(), keys.end(), values.begin(), state.queue());
+        state.stop_timer();
+    }
+}
+PERF_BENCHMARK("sort_by_key", perf_sort_by_key)
+
+// sort_by_key() for wide values, moving the values through the sort or
+// sorting the keys with their indices followed by a gather of the values
+template<class T, bool Index>
+void perf_sort_by_key_payload(perf_state &state)
+{
+    typedef typename compute::scalar_type<T>::type scalar_type;
+
+    std::vector<compute::int_> host_keys = state.input<compute::int_>();
+    std::vector<T> host_values(state.size());
+    for(size_t i = 0; i < host_values.size(); i++){
+        host_values[i] = T(static_cast<scalar_type>(i));
+    }
+    compute::vector<compute::int_> keys(state.size(), state.context());
+    compute::vector<T> values(state.size(), state.context());
+
+    boost::shared_ptr<compute::detail::parameter_cache> params =
+        compute::detail::parameter_cache::get_global_cache(state.queue().get_device());
+    const std::string cache_key =
+        std::string("__boost_sort_by_key_") + compute::type_name<compute::int_>();
+    const compute::uint_ threshold =
+        params->get(cache_key, "index_payload_size_threshold", 16);
+    params->set(
+        cache_key,
+        "index_payload_size_threshold",
+        Index ? compute::uint_(0) : (std::numeric_limits<compute::uint_>::max)()
+    );
+
+    while(state.keep_running()){
+        upload(host_keys, keys, state.queue());
+        upload(host_values, values, state.queue());
+        state.start_timer();
+        compute::sort_by_key(keys.begin(), keys.end(), values.begin(), state.queue());
+        state.stop_timer();
+    }
+
+    params->set(cache_key, "index_payload_size_threshold", threshold);
+}
+
+PERF_BENCHMARK("sort_by_key_payload/ulong/direct",
+               (perf_sort_by_key_payload<compute::ulong_, false>))
+PERF_BENCHMARK("sort_by_key_payload/ulong/index",
+               (perf_sort_by_key_payload<compute::ulong_, true>))
+PERF_BENCHMARK("sort_by_key_payload/uint4/direct",
+               (perf_sort_by_key_payload<compute::uint4_, false>))
+PERF_BENCHMARK("sort_by_key_payload/uint4/index",
+               (perf_sort_by_key_payload<compute::uint4_, true>))
+PERF_BENCHMARK("sort_by_key_payload/ulong4/direct",
+               (perf_sort_by_key_payload<compute::ulong4_, false>))
+PERF_BENCHMARK("sort_by_key_payload/ulong4/index",
+               (perf_sort_by_key_payload<compute::ulong4_, true>))
+PERF_BENCHMARK("sort_by_key_payload/ulong8/direct",
+               (perf_sort_by_key_payload<compute::ulong8_, false>))
+PERF_BENCHMARK("sort_by_key_payload/ulong8/index",
+               (perf_sort_by_key_payload<compute::ulong8_, true>))
+PERF_BENCHMARK("sort_by_key_payload/ulong16/direct",
+               (perf_sort_by_key_payload<compute::ulong16_, false>))
+PERF_BENCHMARK("sort_by_key_payload/ulong16/index",
+               (perf_sort_by_key_payload<compute::ulong16_, true>))
+
+void perf_stable_partition(perf_state &state)
+{
+    std::vector<int> host = state.input<int>(0, small_values);
+    compute::vector<int> vec(state.size(), state.context());
+
+    while(state.keep_running()){
+        upload(host, vec, state.queue());
+        state.start_timer();
+        compute::stable_partition(vec.begin(), vec.end(), _1 < 10, state.queue());
+        state.stop_timer();
+    }
+}
+PERF_BENCHMARK("stable_partition", perf_stable_partition)
+
+void perf_uniform_int_distribution(perf_state &state)
+{
+    compute::vector<compute::uint_> vec(state.size(), state.context());
+    compute::default_random_engine rng(state.queue());
+    compute::uniform_int_distribution<compute::uint_> dist(0, 1);
+
+    while(state.keep_running()){
+        state.start_timer();
+        dist.generate(vec.begin(), vec.end(), rng, state.queue());
+        state.stop_timer();
+    }
+}
+PERF_BENCHMARK_NO_INPUT("uniform_int_distribution", perf_uniform_int_distribution)
+
+void perf_unique(perf_state &state)
+{
+    std::vector<int> host = state.input<int>(0, small_values);
+    compute::vector<int> vec(state.size(), state.context());
+
+    while(state.keep_running()){
+        upload(host, vec, state.queue());
+        state.start_timer();
+        compute::unique(vec.begin(), vec.end(), state.queue());
+        state.stop_timer();
+    }
+}
+PERF_BENCHMARK("unique", perf_unique)
+
+void perf_unique_copy(perf_state &state)
+{
+    std::vector<int> host = state.input<int>(0, small_values);
+    compute::vector<int> input(host.begin(), host.end(), state.queue());
+    compute::vector<int> output(state.size(), state.context());
+
+    while(state.keep_running()){
+        state.start_timer();
+        compute::unique_copy(input.begin(), input.end(), output.begin(), state.queue());
+        state.stop_timer();
+    }
+}
+PERF_BENCHMARK("unique_copy", perf_unique_copy)
+
+// parses a comma separated list of sizes. "a:b" adds each power of two
+// from a to b.
+std::vector<size_t> parse_sizes(const std::string &list)
+{
+    std::vector<size_t> sizes;
+
+    std::stringstream stream(list);
+    std::string item;
+    while(std::getline(stream, item, ',')){
+        const size_t colon = item.find(':');
+        if(colon == std::string::npos){
+            sizes.push_back(std::strtoul(item.c_str(), 0, 10));
+        }
+        else {
+            size_t first = std::strtoul(item.substr(0, colon).c_str(), 0, 10);
+            size_t last = std::strtoul(item.substr(colon + 1).c_str(), 0, 10);
+            for(size_t size = (std::max)(first, size_t(1)); size <= last; size *= 2){
+                sizes.push_back(size);
+            }
+        }
+    }
+
+    return sizes;
+}
+
+std::string json_escape(const std::string &str)
+{
+    std::string escaped;
+    for(size_t i = 0; i < str.size(); i++){
+        if(str[i] == '"' || str[i] == '\\'){
+            escaped += '\\';
+        }
+        escaped += str[i] < ' ' ? ' ' : str[i];
+    }
+    return escaped;
+}
+
+void write_json_samples(std::ostream &stream, const std::vector<double> &samples)
+{
+    stream << "[";
+    for(size_t i = 0; i < samples.size(); i++){
+        stream << (i ? ", " : "") << static_cast<unsigned long long>(samples[i]);
+    }
+    stream << "]";
+}
+
+void write_json_stats(std::ostream &stream, const perf_stats &stats)
+{
+    stream << "{\"median\": " << stats.median
+           << ", \"mean\": " << stats.mean
+           << ", \"stddev\": " << stats.stddev
+           << ", \"min\": " << stats.min
+           << ", \"max\": " << stats.max << "}";
+}
+
+struct perf_result
+{
+    std::string name;
+    size_t size;
+    perf_distribution distribution;
+    size_t trials;
+    double warmup_time;
+    double build_time;
+    std::vector<double> host_times;
+    std::vector<double> device_times;
+    bool has_device_times;
+};
+
+void write_json(std::ostream &stream,
+                const compute::device &device,
+                const std::vector<perf_result> &results)
+{
+    stream << std::setprecision(12);
+    stream << "{\n";
+    stream << "  \"context\": {\n";
+    stream << "    \"device\": \"" << json_escape(device.name()) << "\",\n";
+    stream << "    \"platform\": \"" << json_escape(device.platform().name()) << "\",\n";
+    stream << "    \"driver_version\": \"" << json_escape(device.driver_version()) << "\"\n";
+    stream << "  },\n";
+    stream << "  \"benchmarks\": [";
+    for(size_t i = 0; i < results.size(); i++){
+        const perf_result &r = results[i];
+
+        stream << (i ? ",\n" : "\n");
+        stream << "    {\"name\": \"" << json_escape(r.name) << "\""
+               << ", \"size\": " << r.size
+               << ", \"distribution\": \"" << perf_distribution_name(r.distribution) << "\""
+               << ", \"trials\": " << r.trials
+               << ", \"warmup_ns\": " << static_cast<unsigned long long>(r.warmup_time)
+               << ", \"build_ns\": " << static_cast<unsigned long long>(r.build_time)
+               << ",\n     \"host_ns\": ";
+        write_json_samples(stream, r.host_times);
+        stream << ",\n     \"host_stats\": ";
+        write_json_stats(stream, perf_compute_stats(r.host_times));
+        if(r.has_device_times){
+            stream << ",\n     \"device_ns\": ";
+            write_json_samples(stream, r.device_times);
+            stream << ",\n     \"device_stats\": ";
+            write_json_stats(stream, perf_compute_stats(r.device_times));
+        }
+        stream << "}";
+    }
+    stream << "\n  ]\n";
+    stream << "}\n";
+}
+
+int main(int argc, char *argv[])
+{
+    po::options_description options("options");
+    options.add_options()
+        ("help", "show usage instructions")
+        ("list", "list the benchmarks and exit")
+        ("filter", po::value<std::string>()->default_value(""),
+            "only run benchmarks whose name contains this string")
+        ("sizes", po::value<std::string>()->default_value("1048576"),
+            "comma separated input sizes (\"a:b\" for the powers of two from a to b)")
+        ("distributions", po::value<std::string>()->default_value("uniform"),
+            "comma separated input distributions (uniform, sorted, reversed, "
+            "few_unique, zipf) or \"all\"")
+        ("trials", po::value<size_t>()->default_value(10), "number of measured trials")
+        ("warmup", po::value<size_t>()->default_value(1), "number of warm-up trials")
+        ("seed", po::value<unsigned int>()->default_value(5489u), "input random seed")
+        ("json", po::value<std::string>(), "write the results as JSON to this file")
+    ;
+
+    po::variables_map vm;
+    po::store(po::parse_command_line(argc, argv, options), vm);
+    po::notify(vm);
+
+    if(vm.count("help")){
+        std::cout << options << std::endl;
+        return 0;
+    }
+
+    std::vector<perf_benchmark> benchmarks;
+    const std::string filter = vm["filter"].as<std::string>();
+    for(size_t i = 0; i < perf_benchmarks().size(); i++){
+        if(perf_benchmarks()[i].name.find(filter) != std::string::npos){
+            benchmarks.push_back(perf_benchmarks()[i]);
+        }
+    }
+
+    if(vm.count("list")){
+        for(size_t i = 0; i < benchmarks.size(); i++){
+            std::cout << benchmarks[i].name << std::endl;
+        }
+        return 0;
+    }
+
+    const std::vector<size_t> sizes = parse_sizes(vm["sizes"].as<std::string>());
+
+    std::vector<perf_distribution> distributions;
+    std::string distribution_list = vm["distributions"].as<std::string>();
+    if(distribution_list == "all"){
+        distribution_list = "uniform,sorted,reversed,few_unique,zipf";
+    }
+    std::stringstream distribution_stream(distribution_list);
+    std::string distribution_name;
+    while(std::getline(distribution_stream, distribution_name, ',')){
+        perf_distribution distribution;
+        if(!perf_parse_distribution(distribution_name, distribution)){
+            std::cerr << "error: unknown distribution '"
+                      << distribution_name << "'" << std::endl;
+            return -1;
+        }
+        distributions.push_back(distribution);
+    }
+
+    const size_t trials = vm["trials"].as<size_t>();
+    const size_t warmup = vm["warmup"].as<size_t>();
+    const unsigned int seed = vm["seed"].as<unsigned int>();
+
+    compute::device device = compute::system::default_device();
+    compute::context context(device);
+    compute::command_queue queue(
+        context, device, compute::command_queue::enable_profiling
+    );
+    std::cout << "device: " << device.name() << std::endl;
+
+    std::cout << std::left
+              << std::setw(48) << "benchmark"
+              << std::setw(12) << "size"
+              << std::setw(12) << "input"
+              << std::right
+              << std::setw(12) << "host (ms)"
+              << std::setw(10) << "+/-"
+              << std::setw(12) << "device (ms)"
+              << std::endl;
+
+    std::vector<perf_result> results;
+    for(size_t i = 0; i < benchmarks.size(); i++){
+        for(size_t j = 0; j < sizes.size(); j++){
+            for(size_t k = 0; k < distributions.size(); k++){
+                // benchmarks which do not use the input are only run once
+                if(!benchmarks[i].uses_input && k > 0){
+                    break;
+                }
+
+                perf_state state(
+                    queue, sizes[j], distributions[k], warmup, trials, seed
+                );
+                benchmarks[i].function(state);
+
+                perf_result result;
+                result.name = benchmarks[i].name;
+                result.size = sizes[j];
+                result.distribution = distributions[k];
+                result.trials = trials;
+                result.warmup_time = state.warmup_time();
+                result.build_time = state.build_time();
+                result.host_times = state.host_times();
+                result.device_times = state.device_times();
+                result.has_device_times = state.has_device_times();
+                results.push_back(result);
+
+                const perf_stats host = perf_compute_stats(result.host_times);
+                const perf_stats device_stats = perf_compute_stats(result.device_times);
+
+                std::cout << std::left
+                          << std::setw(48) << result.name
+                          << std::setw(12) << result.size
+                          << std::setw(12) << perf_distribution_name(result.distribution)
+                          << std::right << std::fixed << std::setprecision(3)
+                          << std::setw(12) << host.median / 1e6
+                          << std::setw(10) << host.stddev / 1e6;
+                if(result.has_device_times){
+                    std::cout << std::setw(12) << device_stats.median / 1e6;
+                }
+                else {
+                    std::cout << std::setw(12) << "-";
+                }
+                std::cout << std::endl;
+            }
+        }
+    }
+
+    if(vm.count("json")){
+        std::ofstream file(vm["json"].as<std::string>().c_str());
+        write_json(file, device, results);
+    }
+
+    return 0;
+}
@@ -0,0 +1,136 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://boostorg.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#include <iostream>
+#include <vector>
+
+#include <boost/compute/system.hpp>
+#include <boost/compute/algorithm/copy.hpp>
+#include <boost/compute/algorithm/copy_if.hpp>
+#include <boost/compute/algorithm/reduce_by_key.hpp>
+#include <boost/compute/algorithm/sort_by_key.hpp>
+#include <boost/compute/algorithm/transform.hpp>
+#include <boost/compute/container/vector.hpp>
+#include <boost/compute/lambda.hpp>
+#include <boost/compute/utility/command_graph.hpp>
+
+#include "perf.hpp"
+
+namespace compute = boost::compute;
+
+// runs the copy -> transform -> sort_by_key -> reduce_by_key -> copy_if ->
+// copy pipeline and returns once all commands have been enqueued
+void run_pipeline(const std::vector<int> &host_keys,
+                  const std::vector<int> &host_values,
+                  std::vector<int> &host_result,
+                  compute::vector<int> &keys,
+                  compute::vector<int> &values,
+                  compute::vector<int> &reduced_keys,
+                  compute::vector<int> &reduced_values,
+                  compute::vector<int> &result,
+                  compute::command_queue &queue)
+{
+    using compute::lambda::_1;
+
+    compute::copy(host_keys.begin(), host_keys.end(), keys.begin(), queue);
+    compute::copy(host_values.begin(), host_values.end(), values.begin(), queue);
+    compute::transform(
+        values.begin(), values.end(), values.begin(), _1 * 3 + 1, queue
+    );
+    compute::sort_by_key(keys.begin(), keys.end(), values.begin(), queue);
+    compute::reduce_by_key(
+        keys.begin(), keys.end(), values.begin(),
+        reduced_keys.begin(), reduced_values.begin(), queue
+    );
+    compute::copy_if(
+        reduced_values.begin(), reduced_values.end(), result.begin(),
+        _1 > 100, queue
+    );
+    compute::copy(result.begin(), result.end(), host_result.begin(), queue);
+}
+
+int main(int argc, char *argv[])
+{
+    perf_parse_args(argc, argv);
+    std::cout << "size: " << PERF_N << std::endl;
+
+    compute::device device = compute::system::default_device();
+    compute::context context(device);
+    compute::command_queue queue(context, device);
+    std::cout << "device: " << device.name() << std::endl;
+
+    // keys in [0, 16) so that reduce_by_key produces a fixed number of groups
+    std::vector<int> host_keys(PERF_N);
+    std::vector<int> host_values = generate_random_vector<int>(PERF_N);
+    for(size_t i = 0; i < PERF_N; i++){
+        host_keys[i] = static_cast<int>(std::rand() % 16);
+        host_values[i] %= 1000;
+    }
+    std::vector<int> host_result(PERF_N);
+
+    compute::vector<int> keys(PERF_N, context);
+    compute::vector<int> values(PERF_N, context);
+    compute::vector<int> reduced_keys(PERF_N, context);
+    compute::vector<int> reduced_values(PERF_N, context);
+    compute::vector<int> result(PERF_N, context);
+
+    // warm up the program cache
+    run_pipeline(host_keys, host_values, host_result, keys, values,
+                 reduced_keys, reduced_values, result, queue);
+    queue.finish();
+
+    // host time to enqueue the pipeline with direct algorithm calls
+    perf_timer direct_host;
+    perf_timer direct_total;
+    for(size_t trial = 0; trial < PERF_TRIALS; trial++){
+        direct_total.start();
+        direct_host.start();
+        run_pipeline(host_keys, host_values, host_result, keys, values,
+                     reduced_keys, reduced_values, result, queue);
+        direct_host.stop();
+        queue.finish();
+        direct_total.stop();
+    }
+
+    // record the pipeline once
+    compute::command_graph graph(queue);
+    graph.begin_recording();
+    run_pipeline(host_keys, host_values, host_result, keys, values,
+                 reduced_keys, reduced_values, result, queue);
+    graph.end_recording();
+    queue.finish();
+
+    // replay with the host vectors bound as parameters
+    graph.rebind(&host_keys[0], &host_keys[0]);
+    graph.rebind(&host_values[0], &host_values[0]);
+    graph.rebind(&host_result[0], &host_result[0]);
+
+    perf_timer replay_host;
+    perf_timer replay_total;
+    for(size_t trial = 0; trial < PERF_TRIALS; trial++){
+        replay_total.start();
+        replay_host.start();
+        compute::event event = graph.replay(queue);
+        replay_host.stop();
+        event.wait();
+        replay_total.stop();
+    }
+
+    std::cout << "commands: " << graph.size() << std::endl;
+    std::cout << "direct host overhead: "
+              << direct_host.min_time() / 1e3 << " us" << std::endl;
+    std::cout << "replay host overhead: "
+              << replay_host.min_time() / 1e3 << " us" << std::endl;
+    std::cout << "direct total: "
+              << direct_total.min_time() / 1e6 << " ms" << std::endl;
+    std::cout << "time: " << replay_total.min_time() / 1e6 << " ms" << std::endl;
+
+    return 0;
+}
@@ -0,0 +1,157 @@
+#!/usr/bin/python
+
+# Copyright (c) 2014 Kyle Lutz <kyle.r.lutz@gmail.com>
+# Distributed under the Boost Software License, Version 1.0
+# See accompanying file LICENSE_1_0.txt or copy at
+# http://www.boost.org/LICENSE_1_0.txt
+#
+# See http://boostorg.github.com/compute for more information.
+
+# compares two sets of results written by perf_benchmarks --json and
+# reports the benchmarks which got significantly slower or faster.
+#
+# a change is reported when the mann-whitney u test finds the samples
+# differ (p < alpha) and the medians differ by more than the threshold.
+# exits with status 1 if any benchmark regressed.
+#
+# usage: perf_compare.py [--alpha 0.01] [--threshold 0.05] [--host]
+#                        base.json new.json
+
+import json
+import math
+import sys
+from optparse import OptionParser
+
+def median(samples):
+    s = sorted(samples)
+    n = len(s)
+    if n == 0:
+        return 0.0
+    if n % 2:
+        return float(s[n // 2])
+    return (s[n // 2 - 1] + s[n // 2]) / 2.0
+
+def mann_whitney_u(a, b):
+    """returns the two-sided p-value of the mann-whitney u test using the
+    normal approximation (with tie correction)"""
+    n1 = len(a)
+    n2 = len(b)
+    if n1 == 0 or n2 == 0:
+        return 1.0
+
+    # rank the pooled samples, giving ties their average rank
+    pooled = sorted([(x, 0) for x in a] + [(x, 1) for x in b])
+    ranks = [0.0] * len(pooled)
+    ties = 0.0
+    i = 0
+    while i < len(pooled):
+        j = i
+        while j + 1 < len(pooled) and pooled[j + 1][0] == pooled[i][0]:
+            j += 1
+        for k in range(i, j + 1):
+            ranks[k] = (i + j) / 2.0 + 1
+        t = j - i + 1
+        ties += t ** 3 - t
+        i = j + 1
+
+    r1 = sum(ranks[k] for k in range(len(pooled)) if pooled[k][1] == 0)
+    u1 = r1 - n1 * (n1 + 1) / 2.0
+    mu = n1 * n2 / 2.0
+
+    n = n1 + n2
+    variance = n1 * n2 / 12.0 * ((n + 1) - ties / (n * (n - 1)))
+    if variance <= 0:
+        return 1.0
+
+    # continuity correction
+    z = (abs(u1 - mu) - 0.5) / math.sqrt(variance)
+    if z < 0:
+        z = 0.0
+    return math.erfc(z / math.sqrt(2))
+
+def load(filename):
+    with open(filename) as f:
+        data = json.load(f)
+
+    results = {}
+    for b in data['benchmarks']:
+        results[(b['name'], b['size'], b['distribution'])] = b
+    return data.get('context', {}), results
+
+def samples(benchmark, use_host):
+    if not use_host and 'device_ns' in benchmark:
+        return benchmark['device_ns'], 'device'
+    return benchmark['host_ns'], 'host'
+
+def main():
+    parser = OptionParser(usage='%prog [options] base.json new.json')
+    parser.add_option('--alpha', type='float', default=0.01,
+                      help='significance level (default: 0.01)')
+    parser.add_option('--threshold', type='float', default=0.05,
+                      help='minimum relative change in the median (default: 0.05)')
+    parser.add_option('--host', action='store_true', default=False,
+                      help='compare host times even if device times are available')
+    parser.add_option('--all', action='store_true', default=False,
+                      help='show all benchmarks, not only the changed ones')
+    (options, args) = parser.parse_args()
+
+    if len(args) != 2:
+        parser.print_help()
+        return 2
+
+    base_context, base = load(args[0])
+    new_context, new = load(args[1])
+
+    if base_context.get('device') != new_context.get('device'):
+        print('warning: comparing results from different devices (%s and %s)' %
+              (base_context.get('device'), new_context.get('device')))
+
+    regressions = 0
+    improvements = 0
+
+    print('%-48s %10s %-12s %8s %12s %12s %8s %8s  %s' %
+          ('benchmark', 'size', 'input', 'time', 'base (ms)', 'new (ms)',
+           'change', 'p', ''))
+
+    for key in sorted(base.keys()):
+        if key not in new:
+            continue
+
+        base_samples, kind = samples(base[key], options.host)
+        new_samples, new_kind = samples(new[key], options.host)
+        if kind != new_kind:
+            base_samples, kind = samples(base[key], True)
+            new_samples, new_kind = samples(new[key], True)
+
+        base_median = median(base_samples)
+        new_median = median(new_samples)
+        if base_median > 0:
+            change = (new_median - base_median) / base_median
+        else:
+            change = 0.0
+        p = mann_whitney_u(base_samples, new_samples)
+
+        status = ''
+        if p < options.alpha and abs(change) > options.threshold:
+            if change > 0:
+                status = 'REGRESSION'
+                regressions += 1
+            else:
+                status = 'improvement'
+                improvements += 1
+
+        if status or options.all:
+            print('%-48s %10d %-12s %8s %12.3f %12.3f %+7.1f%% %8.4f  %s' %
+                  (key[0], key[1], key[2], kind, base_median / 1e6,
+                   new_median / 1e6, change * 100, p, status))
+
+    missing = [k for k in base.keys() if k not in new]
+    if missing:
+        print('%d benchmarks missing from %s' % (len(missing), args[1]))
+
+    print('%d regressions, %d improvements' % (regressions, improvements))
+
+    return 1 if regressions else 0
+
+if __name__ == '__main__':
+    sys.exit(main())
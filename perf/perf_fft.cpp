@@ -0,0 +1,155 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://boostorg.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+// Measures batched forward fft_plan transforms for doubling lengths and
+// batch sizes and reports GFLOP/s counting 5 * n * log2(n) floating
+// point operations per transform of n values. With --2d the transforms
+// are square two-dimensional transforms of n * n values.
+
+#include <cmath>
+#include <complex>
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+#include <boost/program_options.hpp>
+
+#include <boost/compute/system.hpp>
+#include <boost/compute/algorithm/copy.hpp>
+#include <boost/compute/container/vector.hpp>
+#include <boost/compute/fft/fft_plan.hpp>
+
+#include "perf.hpp"
+
+namespace po = boost::program_options;
+namespace compute = boost::compute;
+
+template<class T>
+double perf_fft(size_t length,
+                size_t batch_size,
+                bool two_dimensional,
+                size_t trials,
+                compute::command_queue &queue)
+{
+    const compute::context &context = queue.get_context();
+    const size_t size = two_dimensional ? length * length : length;
+
+    std::vector<std::complex<T> > host_data(size * batch_size);
+    for(size_t i = 0; i < host_data.size(); i++){
+        host_data[i] = std::complex<T>(T(std::rand() % 1000) / 1000, 0);
+    }
+
+    compute::vector<std::complex<T> > input(host_data.begin(), host_data.end(), queue);
+    compute::vector<std::complex<T> > output(host_data.size(), context);
+
+    compute::fft_plan<T> plan = two_dimensional ?
+        compute::fft_plan<T>(length, length, batch_size, context) :
+        compute::fft_plan<T>(length, batch_size, context);
+
+    // compile the kernels
+    plan.forward(input.begin(), output.begin(), queue);
+    queue.finish();
+
+    perf_timer t;
+    for(size_t trial = 0; trial < trials; trial++){
+        t.start();
+        plan.forward(input.begin(), output.begin(), queue);
+        queue.finish();
+        t.stop();
+    }
+
+    // floating point operations per nanosecond
+    const double flops =
+        5.0 * double(size) * std::log(double(size)) / std::log(2.0) * double(batch_size);
+    return flops / t.min_time();
+}
+
+template<class T>
+void perf_sweep(const po::variables_map &vm, compute::command_queue &queue)
+{
+    const bool two_dimensional = vm.count("2d") != 0;
+    const size_t trials = vm["trials"].as<size_t>();
+    const size_t max_values = vm["max-values"].as<size_t>();
+
+    for(size_t length = vm["min-length"].as<size_t>();
+        length <= vm["max-length"].as<size_t>();
+        length *= 2){
+        const size_t size = two_dimensional ? length * length : length;
+
+        for(size_t batch_size = vm["min-batch"].as<size_t>();
+            batch_size <= vm["max-batch"].as<size_t>();
+            batch_size *= 4){
+            if(size * batch_size > max_values){
+                break;
+            }
+
+            const double gflops =
+                perf_fft<T>(length, batch_size, two_dimensional, trials, queue);
+
+            std::cout << "length: " << length;
+            if(two_dimensional){
+                std::cout << "x" << length;
+            }
+            std::cout << " batch: " << batch_size
+                      << " GFLOP/s: " << gflops << std::endl;
+        }
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    // setup command line arguments
+    po::options_description options("options");
+    options.add_options()
+        ("help", "show usage instructions")
+        ("min-length", po::value<size_t>()->default_value(16), "smallest transform length")
+        ("max-length", po::value<size_t>()->default_value(4096), "largest transform length")
+        ("min-batch", po::value<size_t>()->default_value(1), "smallest batch size")
+        ("max-batch", po::value<size_t>()->default_value(4096), "largest batch size")
+        ("max-values", po::value<size_t>()->default_value(1 << 24), "largest number of values in a batch")
+        ("trials", po::value<size_t>()->default_value(3), "number of trials to run")
+        ("2d", "measure two-dimensional transforms")
+        ("double", "use double precision values")
+    ;
+
+    // parse command line
+    po::variables_map vm;
+    po::store(po::parse_command_line(argc, argv, options), vm);
+    po::notify(vm);
+
+    if(vm.count("help")){
+        std::cout << options << std::endl;
+        return 0;
+    }
+
+    if(!compute::fft_plan<float>::is_supported_length(vm["min-length"].as<size_t>())){
+        std::cerr << "ERROR: min-length must be a product of 2, 3 and 5" << std::endl;
+        return -1;
+    }
+
+    // setup context and queue for the default device
+    compute::device device = boost::compute::system::default_device();
+    compute::context context(device);
+    compute::command_queue queue(context, device);
+    std::cout << "device: " << device.name() << std::endl;
+
+    if(vm.count("double")){
+        if(!device.supports_extension("cl_khr_fp64")){
+            std::cerr << "ERROR: device does not support double" << std::endl;
+            return -1;
+        }
+        perf_sweep<double>(vm, queue);
+    }
+    else {
+        perf_sweep<float>(vm, queue);
+    }
+
+    return 0;
+}
@@ -0,0 +1,112 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013-2014 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://boostorg.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#include <algorithm>
+#include <iostream>
+#include <vector>
+
+#include <boost/program_options.hpp>
+
+#include <boost/compute/system.hpp>
+#include <boost/compute/algorithm/copy.hpp>
+#include <boost/compute/algorithm/histogram.hpp>
+#include <boost/compute/container/vector.hpp>
+
+#include "perf.hpp"
+
+namespace po = boost::program_options;
+namespace compute = boost::compute;
+
+int main(int argc, char *argv[])
+{
+    // setup command line arguments
+    po::options_description options("options");
+    options.add_options()
+        ("help", "show usage instructions")
+        ("size", po::value<size_t>()->default_value(8192), "input size")
+        ("trials", po::value<size_t>()->default_value(3), "number of trials to run")
+        ("bins", po::value<compute::uint_>()->default_value(256), "number of bins")
+    ;
+    po::positional_options_description positional_options;
+    positional_options.add("size", 1);
+
+    // parse command line
+    po::variables_map vm;
+    po::store(
+        po::command_line_parser(argc, argv)
+            .options(options).positional(positional_options).run(),
+        vm
+    );
+    po::notify(vm);
+
+    if(vm.count("help")){
+        std::cout << options << std::endl;
+        return 0;
+    }
+
+    const size_t size = vm["size"].as<size_t>();
+    const size_t trials = vm["trials"].as<size_t>();
+    const compute::uint_ bins = vm["bins"].as<compute::uint_>();
+    std::cout << "size: " << size << std::endl;
+    std::cout << "bins: " << bins << std::endl;
+
+    // setup context and queue for the default device
+    compute::device device = compute::system::default_device();
+    compute::context context(device);
+    compute::command_queue queue(context, device);
+    std::cout << "device: " << device.name() << std::endl;
+
+    // create vector of random numbers on the host
+    std::vector<compute::uint_> host_vector(size);
+    for(size_t i = 0; i < size; i++){
+        host_vector[i] = static_cast<compute::uint_>(rand()) % bins;
+    }
+
+    // create vector on the device and copy the data
+    compute::vector<compute::uint_> device_vector(
+        host_vector.begin(), host_vector.end(), queue
+    );
+    compute::vector<compute::uint_> device_counts(bins, context);
+
+    perf_timer t;
+    for(size_t trial = 0; trial < trials; trial++){
+        t.start();
+        compute::histogram_even(
+            device_vector.begin(), device_vector.end(),
+            bins, compute::uint_(0), bins,
+            device_counts.begin(), queue
+        );
+        queue.finish();
+        t.stop();
+    }
+    std::cout << "time: " << t.min_time() / 1e6 << " ms" << std::endl;
+
+    // verify histogram is correct
+    std::vector<compute::uint_> host_counts(bins, 0);
+    for(size_t i = 0; i < size; i++){
+        host_counts[host_vector[i]]++;
+    }
+
+    std::vector<compute::uint_> counts(bins);
+    compute::copy(device_counts.begin(), device_counts.end(), counts.begin(), queue);
+
+    for(compute::uint_ i = 0; i < bins; i++){
+        if(counts[i] != host_counts[i]){
+            std::cout << "ERROR: "
+                      << "device_counts[" << i << "] (" << counts[i] << ") "
+                      << "!= "
+                      << "host_counts[" << i << "] (" << host_counts[i] << ")"
+                      << std::endl;
+            return -1;
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,253 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://boostorg.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+// Measures sort(), reduce() and find() on the host and on the device for
+// 10 to 10^8 elements. With --tune the sizes from which the device is
+// faster are stored as the host crossovers of the device.
+
+// the host backend is opt-in
+#define BOOST_COMPUTE_USE_HOST_BACKEND
+
+#include <algorithm>
+#include <iostream>
+#include <limits>
+#include <string>
+#include <vector>
+
+#include <boost/program_options.hpp>
+
+#include <boost/compute/system.hpp>
+#include <boost/compute/algorithm/copy.hpp>
+#include <boost/compute/algorithm/find.hpp>
+#include <boost/compute/algorithm/reduce.hpp>
+#include <boost/compute/algorithm/sort.hpp>
+#include <boost/compute/algorithm/detail/host_backend.hpp>
+#include <boost/compute/container/vector.hpp>
+#include <boost/compute/detail/parameter_cache.hpp>
+
+#include "perf.hpp"
+
+namespace po = boost::program_options;
+namespace compute = boost::compute;
+
+using compute::int_;
+using compute::uint_;
+
+// the ranges are processed on the host or on the device by setting the
+// crossover of the algorithm to the largest value or to zero
+void set_crossover(const std::string &algorithm,
+                   const std::string &parameter,
+                   uint_ value,
+                   compute::command_queue &queue)
+{
+    boost::shared_ptr<compute::detail::parameter_cache> params =
+        compute::detail::parameter_cache::get_global_cache(queue.get_device());
+
+    params->set(std::string("__boost_") + algorithm + "_int", parameter, value);
+}
+
+double perf_sort(const std::vector<int_> &data,
+                 bool host_iterators,
+                 size_t trials,
+                 compute::command_queue &queue)
+{
+    compute::vector<int_> device_data(data.size(), queue.get_context());
+    std::vector<int_> host_data(data.size());
+
+    perf_timer t;
+    for(size_t trial = 0; trial < trials; trial++){
+        if(host_iterators){
+            std::copy(data.begin(), data.end(), host_data.begin());
+            t.start();
+            compute::sort(host_data.begin(), host_data.end(), queue);
+            t.stop();
+        }
+        else {
+            compute::copy(data.begin(), data.end(), device_data.begin(), queue);
+            queue.finish();
+            t.start();
+            compute::sort(device_data.begin(), device_data.end(), queue);
+            queue.finish();
+            t.stop();
+        }
+    }
+    return t.min_time();
+}
+
+double perf_reduce(const std::vector<int_> &data,
+                   bool host_iterators,
+                   size_t trials,
+                   compute::command_queue &queue)
+{
+    compute::vector<int_> device_data(data.begin(), data.end(), queue);
+
+    perf_timer t;
+    for(size_t trial = 0; trial < trials; trial++){
+        int_ sum = 0;
+        t.start();
+        if(host_iterators){
+            compute::reduce(data.begin(), data.end(), &sum, queue);
+        }
+        else {
+            compute::reduce(device_data.begin(), device_data.end(), &sum, queue);
+        }
+        t.stop();
+    }
+    return t.min_time();
+}
+
+double perf_find(const std::vector<int_> &data,
+                 bool host_iterators,
+                 size_t trials,
+                 compute::command_queue &queue)
+{
+    (void) host_iterators;
+
+    compute::vector<int_> device_data(data.begin(), data.end(), queue);
+
+    // search for a value which is not in the range
+    perf_timer t;
+    for(size_t trial = 0; trial < trials; trial++){
+        t.start();
+        compute::find(device_data.begin(), device_data.end(), -1, queue);
+        t.stop();
+    }
+    return t.min_time();
+}
+
+typedef double (*perf_function)(const std::vector<int_> &,
+                                bool,
+                                size_t,
+                                compute::command_queue &);
+
+// runs the benchmark for each size on the host and on the device and
+// returns the first size for which the device is faster
+size_t perf_crossover(const std::string &algorithm,
+                      perf_function function,
+                      bool host_iterators,
+                      const std::vector<size_t> &sizes,
+                      size_t trials,
+                      compute::command_queue &queue)
+{
+    const std::string parameter =
+        host_iterators ? "host_crossover" : "mapped_host_crossover";
+
+    size_t crossover = 0;
+    for(size_t i = 0; i < sizes.size(); i++){
+        std::vector<int_> data(sizes[i]);
+        for(size_t j = 0; j < data.size(); j++){
+            data[j] = static_cast<int_>(rand() % 1000000);
+        }
+
+        set_crossover(algorithm, parameter, (std::numeric_limits<uint_>::max)(), queue);
+        const double host_time = function(data, host_iterators, trials, queue);
+
+        set_crossover(algorithm, parameter, 0, queue);
+        const double device_time = function(data, host_iterators, trials, queue);
+
+        std::cout << algorithm << " (" << parameter << ")"
+                  << " size: " << sizes[i]
+                  << " host: " << host_time / 1e6 << " ms"
+                  << " device: " << device_time / 1e6 << " ms" << std::endl;
+
+        if(crossover == 0 && device_time < host_time){
+            crossover = sizes[i];
+        }
+    }
+
+    // the host is faster for all sizes
+    if(crossover == 0){
+        crossover = sizes.back();
+    }
+
+    return crossover;
+}
+
+int main(int argc, char *argv[])
+{
+    // setup command line arguments
+    po::options_description options("options");
+    options.add_options()
+        ("help", "show usage instructions")
+        ("min-size", po::value<size_t>()->default_value(10), "smallest input size")
+        ("max-size", po::value<size_t>()->default_value(100000000), "largest input size")
+        ("trials", po::value<size_t>()->default_value(3), "number of trials to run")
+        ("tune", "store the measured crossovers for the device")
+    ;
+
+    // parse command line
+    po::variables_map vm;
+    po::store(po::parse_command_line(argc, argv, options), vm);
+    po::notify(vm);
+
+    if(vm.count("help")){
+        std::cout << options << std::endl;
+        return 0;
+    }
+
+    const size_t trials = vm["trials"].as<size_t>();
+
+    // sizes by powers of ten
+    std::vector<size_t> sizes;
+    for(size_t size = vm["min-size"].as<size_t>();
+        size <= vm["max-size"].as<size_t>();
+        size *= 10){
+        sizes.push_back(size);
+    }
+    if(sizes.empty()){
+        std::cerr << "ERROR: min-size is larger than max-size" << std::endl;
+        return -1;
+    }
+
+    // setup context and queue for the default device
+    compute::device device = boost::compute::system::default_device();
+    compute::context context(device);
+    compute::command_queue queue(context, device);
+    std::cout << "device: " << device.name() << std::endl;
+
+    boost::shared_ptr<compute::detail::parameter_cache> params =
+        compute::detail::parameter_cache::get_global_cache(device);
+
+    const char *algorithms[] = { "sort", "reduce", "find" };
+    const perf_function functions[] = { perf_sort, perf_reduce, perf_find };
+
+    for(size_t i = 0; i < 3; i++){
+        const std::string cache_key = std::string("__boost_") + algorithms[i] + "_int";
+
+        // find() is only supported for device iterators
+        for(int host_iterators = 0; host_iterators < (i == 2 ? 1 : 2); host_iterators++){
+            const std::string parameter =
+                host_iterators ? "host_crossover" : "mapped_host_crossover";
+
+            // save
+            const uint_ saved = params->get(
+                cache_key,
+                parameter,
+                compute::detail::default_host_crossover(algorithms[i], host_iterators == 0)
+            );
+
+            const size_t crossover = perf_crossover(
+                algorithms[i], functions[i], host_iterators != 0, sizes, trials, queue
+            );
+            std::cout << algorithms[i] << " (" << parameter << ")"
+                      << " crossover: " << crossover << std::endl;
+
+            // store the measured crossover or restore the previous one
+            if(vm.count("tune")){
+                params->set(cache_key, parameter, static_cast<uint_>(crossover));
+            }
+            else {
+                params->set(cache_key, parameter, saved);
+            }
+        }
+    }
+
+    return 0;
+}
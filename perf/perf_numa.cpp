@@ -0,0 +1,137 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://boostorg.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#include <algorithm>
+#include <iostream>
+#include <vector>
+
+#include <boost/compute/lambda.hpp>
+#include <boost/compute/system.hpp>
+#include <boost/compute/algorithm/copy.hpp>
+#include <boost/compute/algorithm/fill.hpp>
+#include <boost/compute/algorithm/reduce.hpp>
+#include <boost/compute/algorithm/transform.hpp>
+#include <boost/compute/container/vector.hpp>
+#include <boost/compute/utility/numa.hpp>
+
+#include "perf.hpp"
+
+namespace compute = boost::compute;
+
+float rand_float()
+{
+    return (float(rand()) / float(RAND_MAX)) * 1000.f;
+}
+
+// runs a saxpy transform followed by a reduction of the result
+template<class Queue>
+void run_saxpy_sum(compute::vector<float> &x,
+                   compute::vector<float> &y,
+                   compute::vector<float> &result,
+                   float *sum,
+                   Queue &queue)
+{
+    using compute::lambda::_1;
+    using compute::lambda::_2;
+
+    compute::transform(
+        x.begin(), x.end(), y.begin(), result.begin(), 2.5f * _1 + _2, queue
+    );
+    compute::reduce(result.begin(), result.end(), sum, queue);
+}
+
+// runs the benchmark with buffers placed by first_touch() (if first_touch
+// is true) or by a single host copy and returns the minimum time
+double perf_numa_queues(const std::vector<float> &host_x,
+                        const std::vector<float> &host_y,
+                        bool first_touch,
+                        compute::multi_queue &queues)
+{
+    const compute::context context = queues.get_context();
+    compute::command_queue &queue = queues.get_queue(0);
+
+    compute::vector<float> x(host_x.size(), context);
+    compute::vector<float> y(host_y.size(), context);
+    compute::vector<float> result(host_x.size(), context);
+    if(first_touch){
+        compute::first_touch(x.begin(), x.end(), queues);
+        compute::first_touch(y.begin(), y.end(), queues);
+        compute::first_touch(result.begin(), result.end(), queues);
+    }
+    compute::copy(host_x.begin(), host_x.end(), x.begin(), queue);
+    compute::copy(host_y.begin(), host_y.end(), y.begin(), queue);
+    if(!first_touch){
+        compute::fill(result.begin(), result.end(), 0.f, queue);
+    }
+    queue.finish();
+
+    float sum = 0;
+    run_saxpy_sum(x, y, result, &sum, queues);
+
+    perf_timer t;
+    for(size_t trial = 0; trial < PERF_TRIALS; trial++){
+        t.start();
+        run_saxpy_sum(x, y, result, &sum, queues);
+        t.stop();
+    }
+
+    return t.min_time();
+}
+
+int main(int argc, char *argv[])
+{
+    perf_parse_args(argc, argv);
+    std::cout << "size: " << PERF_N << std::endl;
+
+    compute::device device = compute::system::default_device();
+    std::cout << "device: " << device.name() << std::endl;
+
+    std::vector<float> host_x(PERF_N);
+    std::vector<float> host_y(PERF_N);
+    std::generate(host_x.begin(), host_x.end(), rand_float);
+    std::generate(host_y.begin(), host_y.end(), rand_float);
+
+    // whole device with a single queue
+    double single_time = 0;
+    {
+        compute::context context(device);
+        compute::command_queue queue(context, device);
+
+        compute::vector<float> x(host_x.begin(), host_x.end(), queue);
+        compute::vector<float> y(host_y.begin(), host_y.end(), queue);
+        compute::vector<float> result(PERF_N, context);
+
+        float sum = 0;
+        run_saxpy_sum(x, y, result, &sum, queue);
+
+        perf_timer t;
+        for(size_t trial = 0; trial < PERF_TRIALS; trial++){
+            t.start();
+            run_saxpy_sum(x, y, result, &sum, queue);
+            t.stop();
+        }
+        single_time = t.min_time();
+    }
+
+    // one queue per numa node
+    compute::multi_queue queues = compute::make_numa_queues(device);
+    std::cout << "numa nodes: " << queues.size() << std::endl;
+
+    const double numa_time = perf_numa_queues(host_x, host_y, false, queues);
+    const double first_touch_time = perf_numa_queues(host_x, host_y, true, queues);
+
+    std::cout << "single queue: " << single_time / 1e6 << " ms" << std::endl;
+    std::cout << "numa queues: " << numa_time / 1e6 << " ms" << std::endl;
+    std::cout << "numa queues with first touch: "
+              << first_touch_time / 1e6 << " ms" << std::endl;
+    std::cout << "time: " << first_touch_time / 1e6 << " ms" << std::endl;
+
+    return 0;
+}
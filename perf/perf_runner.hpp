@@ -0,0 +1,404 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://boostorg.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#ifndef PERF_RUNNER_HPP
+#define PERF_RUNNER_HPP
+
+// this header contains the benchmark registry, input generators and
+// statistics used by the perf_benchmarks runner. benchmarks are registered
+// with PERF_BENCHMARK() and time the work between start_timer() and
+// stop_timer() in each iteration of a keep_running() loop:
+//
+//   void perf_sort(perf_state &state)
+//   {
+//       std::vector<int> host = state.input<int>();
+//       compute::vector<int> vec(host.size(), state.context());
+//
+//       while(state.keep_running()){
+//           compute::copy(host.begin(), host.end(), vec.begin(), state.queue());
+//           state.start_timer();
+//           compute::sort(vec.begin(), vec.end(), state.queue());
+//           state.stop_timer();
+//       }
+//   }
+//   PERF_BENCHMARK("sort/int", perf_sort)
+
+#include <cmath>
+#include <string>
+#include <vector>
+#include <algorithm>
+
+#include <boost/preprocessor/cat.hpp>
+#include <boost/random/mersenne_twister.hpp>
+#include <boost/random/uniform_int_distribution.hpp>
+#include <boost/random/uniform_real_distribution.hpp>
+#include <boost/timer/timer.hpp>
+
+#include <boost/compute/command_queue.hpp>
+#include <boost/compute/utility/profiler.hpp>
+
+// distributions of the values in the generated input
+enum perf_distribution {
+    perf_uniform,
+    perf_sorted,
+    perf_reversed,
+    perf_few_unique,
+    perf_zipf
+};
+
+inline const char* perf_distribution_name(perf_distribution distribution)
+{
+    static const char *names[] = {
+        "uniform", "sorted", "reversed", "few_unique", "zipf"
+    };
+
+    return names[distribution];
+}
+
+inline bool perf_parse_distribution(const std::string &name,
+                                    perf_distribution &distribution)
+{
+    for(int i = perf_uniform; i <= perf_zipf; i++){
+        if(name == perf_distribution_name(static_cast<perf_distribution>(i))){
+            distribution = static_cast<perf_distribution>(i);
+            return true;
+        }
+    }
+
+    return false;
+}
+
+// generates size values in [0, max_value) with distribution. the same seed
+// always gives the same values.
+template<class T>
+inline std::vector<T> perf_generate(size_t size,
+                                    perf_distribution distribution,
+                                    unsigned int max_value,
+                                    unsigned int seed)
+{
+    boost::random::mt19937 rng(seed);
+    max_value = (std::max)(max_value, 1u);
+
+    std::vector<unsigned int> values(size);
+    if(distribution == perf_few_unique){
+        // 16 distinct values spread over the range
+        boost::random::uniform_int_distribution<unsigned int> index(0, 15);
+        for(size_t i = 0; i < size; i++){
+            values[i] = static_cast<unsigned int>(
+                (static_cast<double>(index(rng)) / 16.0) * max_value
+            );
+        }
+    }
+    else if(distribution == perf_zipf){
+        // zipf distribution (s = 1.1) over the first values in the range so
+        // that a few values are very common and most are rare
+        const size_t ranks = (std::min)(size_t(max_value), size_t(4096));
+
+        std::vector<double> cdf(ranks);
+        double sum = 0;
+        for(size_t k = 0; k < ranks; k++){
+            sum += 1.0 / std::pow(static_cast<double>(k + 1), 1.1);
+            cdf[k] = sum;
+        }
+
+        boost::random::uniform_real_distribution<double> u(0.0, sum);
+        for(size_t i = 0; i < size; i++){
+            values[i] = static_cast<unsigned int>(
+                std::lower_bound(cdf.begin(), cdf.end() - 1, u(rng)) - cdf.begin()
+            );
+        }
+    }
+    else {
+        boost::random::uniform_int_distribution<unsigned int> value(0, max_value - 1);
+        for(size_t i = 0; i < size; i++){
+            values[i] = value(rng);
+        }
+
+        if(distribution == perf_sorted){
+            std::sort(values.begin(), values.end());
+        }
+        else if(distribution == perf_reversed){
+            std::sort(values.begin(), values.end());
+            std::reverse(values.begin(), values.end());
+        }
+    }
+
+    std::vector<T> result(size);
+    for(size_t i = 0; i < size; i++){
+        result[i] = static_cast<T>(values[i]);
+    }
+    return result;
+}
+
+// summary statistics for a set of samples
+struct perf_stats
+{
+    perf_stats()
+        : median(0), mean(0), stddev(0), min(0), max(0)
+    {
+    }
+
+    double median;
+    double mean;
+    double stddev;
+    double min;
+    double max;
+};
+
+inline perf_stats perf_compute_stats(std::vector<double> samples)
+{
+    perf_stats stats;
+    if(samples.empty()){
+        return stats;
+    }
+
+    std::sort(samples.begin(), samples.end());
+
+    const size_t n = samples.size();
+    stats.min = samples.front();
+    stats.max = samples.back();
+    stats.median = n % 2 ? samples[n / 2]
+                         : (samples[n / 2 - 1] + samples[n / 2]) / 2.0;
+
+    double sum = 0;
+    for(size_t i = 0; i < n; i++){
+        sum += samples[i];
+    }
+    stats.mean = sum / n;
+
+    double variance = 0;
+    for(size_t i = 0; i < n; i++){
+        variance += (samples[i] - stats.mean) * (samples[i] - stats.mean);
+    }
+    stats.stddev = n > 1 ? std::sqrt(variance / (n - 1)) : 0.0;
+
+    return stats;
+}
+
+// the state passed to a benchmark. it provides the queue and input, runs
+// the warm-up and measured iterations and collects the host and device
+// time of each.
+class perf_state
+{
+public:
+    perf_state(const boost::compute::command_queue &queue,
+               size_t size,
+               perf_distribution distribution,
+               size_t warmup,
+               size_t trials,
+               unsigned int seed)
+        : m_queue(queue),
+          m_size(size),
+          m_distribution(distribution),
+          m_warmup(warmup),
+          m_trials(trials),
+          m_seed(seed),
+          m_iteration(0),
+          m_timing(false),
+          m_warmup_time(0),
+          m_build_time(0),
+          m_profiled(false)
+    {
+        m_timer.stop();
+    }
+
+    size_t size() const
+    {
+        return m_size;
+    }
+
+    perf_distribution distribution() const
+    {
+        return m_distribution;
+    }
+
+    boost::compute::command_queue& queue()
+    {
+        return m_queue;
+    }
+
+    boost::compute::context context() const
+    {
+        return m_queue.get_context();
+    }
+
+    // returns the input values for the benchmark. index selects different
+    // values for benchmarks which take several inputs.
+    template<class T>
+    std::vector<T> input(size_t index = 0, unsigned int max_value = 1u << 24) const
+    {
+        return input<T>(m_size, index, max_value);
+    }
+
+    template<class T>
+    std::vector<T> input(size_t size, size_t index, unsigned int max_value) const
+    {
+        return perf_generate<T>(
+            size, m_distribution, max_value, m_seed + static_cast<unsigned int>(index)
+        );
+    }
+
+    // returns true while there are warm-up or measured iterations to run
+    bool keep_running()
+    {
+        if(m_timing){
+            stop_timer();
+        }
+
+        return m_iteration++ < m_warmup + m_trials;
+    }
+
+    bool is_warmup() const
+    {
+        return m_iteration <= m_warmup;
+    }
+
+    // starts timing the work for the current iteration. all previously
+    // enqueued work (e.g. copying the input) is finished first.
+    void start_timer()
+    {
+        m_queue.finish();
+
+        m_profiler.clear();
+        m_profiler.start();
+        m_timing = true;
+        m_timer.start();
+    }
+
+    // waits for the work enqueued since start_timer() and records its time
+    void stop_timer()
+    {
+        m_queue.finish();
+        m_timer.stop();
+        m_profiler.stop();
+        m_timing = false;
+
+        const double host_time = static_cast<double>(m_timer.elapsed().wall);
+
+        double device_time = 0;
+        double build_time = 0;
+        bool profiled = false;
+
+        typedef boost::compute::profiler::record record;
+        const std::vector<record> &records = m_profiler.records();
+        for(size_t i = 0; i < records.size(); i++){
+            if(records[i].kind == record::build){
+                build_time += static_cast<double>(records[i].host_time());
+            }
+            else if(records[i].profiled){
+                device_time += static_cast<double>(records[i].device_time());
+                profiled = true;
+            }
+        }
+
+        if(is_warmup()){
+            m_warmup_time += host_time;
+        }
+        else {
+            m_host_times.push_back(host_time);
+            m_device_times.push_back(device_time);
+            m_profiled = m_profiled || profiled;
+        }
+        m_build_time += build_time;
+    }
+
+    // host times of the measured iterations in nanoseconds
+    const std::vector<double>& host_times() const
+    {
+        return m_host_times;
+    }
+
+    // device times (sum of the profiled commands) of the measured
+    // iterations in nanoseconds
+    const std::vector<double>& device_times() const
+    {
+        return m_device_times;
+    }
+
+    // returns true if any of the commands had device times
+    bool has_device_times() const
+    {
+        return m_profiled;
+    }
+
+    // total host time of the warm-up iterations in nanoseconds
+    double warmup_time() const
+    {
+        return m_warmup_time;
+    }
+
+    // total time spent building programs in nanoseconds
+    double build_time() const
+    {
+        return m_build_time;
+    }
+
+private:
+    boost::compute::command_queue m_queue;
+    size_t m_size;
+    perf_distribution m_distribution;
+    size_t m_warmup;
+    size_t m_trials;
+    unsigned int m_seed;
+    size_t m_iteration;
+    bool m_timing;
+    boost::timer::cpu_timer m_timer;
+    boost::compute::profiler m_profiler;
+    std::vector<double> m_host_times;
+    std::vector<double> m_device_times;
+    double m_warmup_time;
+    double m_build_time;
+    bool m_profiled;
+};
+
+typedef void (*perf_benchmark_function)(perf_state &state);
+
+struct perf_benchmark
+{
+    std::string name;
+    perf_benchmark_function function;
+    // false if the benchmark does not use the generated input (e.g. fill)
+    // and only needs to be run with one distribution
+    bool uses_input;
+};
+
+inline std::vector<perf_benchmark>& perf_benchmarks()
+{
+    static std::vector<perf_benchmark> benchmarks;
+
+    return benchmarks;
+}
+
+struct perf_benchmark_registrar
+{
+    perf_benchmark_registrar(const char *name,
+                             perf_benchmark_function function,
+                             bool uses_input)
+    {
+        perf_benchmark benchmark;
+        benchmark.name = name;
+        benchmark.function = function;
+        benchmark.uses_input = uses_input;
+
+        perf_benchmarks().push_back(benchmark);
+    }
+};
+
+// registers function as the benchmark with name
+#define PERF_BENCHMARK(name, function) \
+    static perf_benchmark_registrar \
+        BOOST_PP_CAT(perf_benchmark_registrar_, __LINE__)(name, function, true);
+
+// registers function as a benchmark which does not use the input
+#define PERF_BENCHMARK_NO_INPUT(name, function) \
+    static perf_benchmark_registrar \
+        BOOST_PP_CAT(perf_benchmark_registrar_, __LINE__)(name, function, false);
+
+#endif // PERF_RUNNER_HPP
@@ -0,0 +1,152 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://boostorg.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+// Measures sort_by_key() for payloads of 8 to 128 bytes, moving the values
+// through the sort and sorting the keys with their indices followed by a
+// gather of the values.
+
+#include <algorithm>
+#include <iostream>
+#include <limits>
+#include <string>
+#include <vector>
+
+#include <boost/program_options.hpp>
+
+#include <boost/compute/system.hpp>
+#include <boost/compute/algorithm/copy.hpp>
+#include <boost/compute/algorithm/is_sorted.hpp>
+#include <boost/compute/algorithm/sort_by_key.hpp>
+#include <boost/compute/container/vector.hpp>
+#include <boost/compute/detail/parameter_cache.hpp>
+#include <boost/compute/types/fundamental.hpp>
+#include <boost/compute/type_traits/scalar_type.hpp>
+#include <boost/compute/type_traits/type_name.hpp>
+
+#include "perf.hpp"
+
+namespace po = boost::program_options;
+namespace compute = boost::compute;
+
+template<class T>
+double perf_sort_by_key(const std::vector<compute::int_>& keys,
+                        const size_t trials,
+                        compute::command_queue& queue)
+{
+    const compute::context &context = queue.get_context();
+
+    std::vector<T> values(keys.size());
+    for(size_t i = 0; i < values.size(); i++){
+        values[i] = T(static_cast<typename compute::scalar_type<T>::type>(i));
+    }
+
+    compute::vector<compute::int_> device_keys(keys.size(), context);
+    compute::vector<T> device_values(values.size(), context);
+
+    perf_timer t;
+    for(size_t trial = 0; trial < trials; trial++){
+        compute::copy(keys.begin(), keys.end(), device_keys.begin(), queue);
+        compute::copy(values.begin(), values.end(), device_values.begin(), queue);
+
+        t.start();
+        compute::sort_by_key(
+            device_keys.begin(), device_keys.end(), device_values.begin(), queue
+        );
+        queue.finish();
+        t.stop();
+
+        if(!compute::is_sorted(device_keys.begin(), device_keys.end(), queue)){
+            std::cerr << "ERROR: is_sorted() returned false" << std::endl;
+        }
+    }
+    return t.min_time();
+}
+
+template<class T>
+void perf_payload(const std::vector<compute::int_>& keys,
+                  const size_t trials,
+                  compute::command_queue& queue)
+{
+    boost::shared_ptr<compute::detail::parameter_cache>
+        params = compute::detail::parameter_cache::get_global_cache(queue.get_device());
+
+    const std::string cache_key =
+        std::string("__boost_sort_by_key_") + compute::type_name<compute::int_>();
+    const compute::uint_ threshold =
+        params->get(cache_key, "index_payload_size_threshold", 16);
+
+    // move the values through the sort
+    params->set(cache_key, "index_payload_size_threshold",
+                (std::numeric_limits<compute::uint_>::max)());
+    const double direct = perf_sort_by_key<T>(keys, trials, queue);
+
+    // sort the keys with indices and gather the values
+    params->set(cache_key, "index_payload_size_threshold", 0);
+    const double index = perf_sort_by_key<T>(keys, trials, queue);
+
+    params->set(cache_key, "index_payload_size_threshold", threshold);
+
+    std::cout << "payload: " << sizeof(T) << " bytes ("
+              << compute::type_name<T>() << ")"
+              << " direct: " << direct / 1e6 << " ms"
+              << " index: " << index / 1e6 << " ms"
+              << " (" << (sizeof(T) > threshold ? "index" : "direct")
+              << " by default)" << std::endl;
+}
+
+int main(int argc, char *argv[])
+{
+    // setup command line arguments
+    po::options_description options("options");
+    options.add_options()
+        ("help", "show usage instructions")
+        ("size", po::value<size_t>()->default_value(8192), "input size")
+        ("trials", po::value<size_t>()->default_value(3), "number of trials to run")
+    ;
+    po::positional_options_description positional_options;
+    positional_options.add("size", 1);
+
+    // parse command line
+    po::variables_map vm;
+    po::store(
+        po::command_line_parser(argc, argv)
+            .options(options).positional(positional_options).run(),
+        vm
+    );
+    po::notify(vm);
+
+    if(vm.count("help")){
+        std::cout << options << std::endl;
+        return 0;
+    }
+
+    const size_t size = vm["size"].as<size_t>();
+    const size_t trials = vm["trials"].as<size_t>();
+    std::cout << "size: " << size << std::endl;
+
+    // setup context and queue for the default device
+    compute::device device = boost::compute::system::default_device();
+    compute::context context(device);
+    compute::command_queue queue(context, device);
+    std::cout << "device: " << device.name() << std::endl;
+
+    // create vector of random keys on the host
+    std::vector<compute::int_> keys(size);
+    std::generate(keys.begin(), keys.end(), rand);
+
+    // sweep over the payload sizes
+    perf_payload<compute::ulong_>(keys, trials, queue);
+    perf_payload<compute::uint4_>(keys, trials, queue);
+    perf_payload<compute::ulong4_>(keys, trials, queue);
+    perf_payload<compute::ulong8_>(keys, trials, queue);
+    perf_payload<compute::ulong16_>(keys, trials, queue);
+
+    return 0;
+}
@@ -0,0 +1,64 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://boostorg.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#include <algorithm>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "perf.hpp"
+
+char rand_char()
+{
+    return static_cast<char>('a' + (rand() % 26));
+}
+
+int main(int argc, char *argv[])
+{
+    perf_parse_args(argc, argv);
+    std::cout << "size: " << PERF_N << std::endl;
+
+    // create random text on the host
+    std::vector<char> host_text(PERF_N);
+    std::generate(host_text.begin(), host_text.end(), rand_char);
+
+    // search for 32 random words of 2 to 6 characters
+    std::vector<std::string> words(32);
+    for(size_t i = 0; i < words.size(); i++){
+        words[i].resize(2 + i % 5);
+        std::generate(words[i].begin(), words[i].end(), rand_char);
+    }
+
+    size_t match_count = 0;
+
+    perf_timer t;
+    for(size_t trial = 0; trial < PERF_TRIALS; trial++){
+        t.start();
+        match_count = 0;
+        for(size_t i = 0; i < words.size(); i++){
+            std::vector<char>::iterator iter = host_text.begin();
+            for(;;){
+                iter = std::search(
+                    iter, host_text.end(), words[i].begin(), words[i].end()
+                );
+                if(iter == host_text.end()){
+                    break;
+                }
+                match_count++;
+                ++iter;
+            }
+        }
+        t.stop();
+    }
+    std::cout << "time: " << t.min_time() / 1e6 << " ms" << std::endl;
+    std::cout << "matches: " << match_count << std::endl;
+
+    return 0;
+}
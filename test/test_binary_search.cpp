@@ -11,15 +11,20 @@
 #define BOOST_TEST_MODULE TestBinarySearch
 #include <boost/test/unit_test.hpp>
 
+#include <algorithm>
+#include <cstdlib>
 #include <iterator>
+#include <vector>
 
 #include <boost/compute/command_queue.hpp>
 #include <boost/compute/algorithm/binary_search.hpp>
+#include <boost/compute/algorithm/copy.hpp>
 #include <boost/compute/algorithm/fill.hpp>
 #include <boost/compute/algorithm/lower_bound.hpp>
 #include <boost/compute/algorithm/upper_bound.hpp>
 #include <boost/compute/container/vector.hpp>
 
+#include "check_macros.hpp"
 #include "context_setup.hpp"
 
 BOOST_AUTO_TEST_CASE(binary_search_int)
@@ -99,4 +104,92 @@ BOOST_AUTO_TEST_CASE(range_bounds_int)
     BOOST_CHECK(boost::compute::upper_bound(vector.begin(), vector.end(), int(10), queue) == vector.end());
 }
 
+BOOST_AUTO_TEST_CASE(vectorized_bounds_int)
+{
+    int data[] = { 1, 2, 2, 2, 3, 3, 4, 5 };
+    boost::compute::vector<int> vector(data, data + 8, queue);
+
+    int needles_data[] = { 3, 0, 2, 6, 5, 1 };
+    boost::compute::vector<int> needles(needles_data, needles_data + 6, queue);
+
+//! [vectorized_lower_bound]
+boost::compute::vector<boost::compute::uint_> indices(needles.size(), context);
+boost::compute::lower_bound(
+    vector.begin(), vector.end(), needles.begin(), needles.end(), indices.begin(), queue
+);
+//! [vectorized_lower_bound]
+    CHECK_RANGE_EQUAL(boost::compute::uint_, 6, indices, (4, 0, 1, 8, 7, 0));
+
+    boost::compute::upper_bound(
+        vector.begin(), vector.end(), needles.begin(), needles.end(), indices.begin(), queue
+    );
+    CHECK_RANGE_EQUAL(boost::compute::uint_, 6, indices, (6, 0, 4, 8, 8, 1));
+
+    boost::compute::vector<int> found(needles.size(), context);
+    boost::compute::binary_search(
+        vector.begin(), vector.end(), needles.begin(), needles.end(), found.begin(), queue
+    );
+    CHECK_RANGE_EQUAL(int, 6, found, (1, 0, 1, 0, 1, 1));
+}
+
+BOOST_AUTO_TEST_CASE(vectorized_bounds_many_needles)
+{
+    // enough needles to be sorted before searching, with small and large
+    // sorted ranges to search with the merge path and the binary search
+    const size_t needle_count = 100000;
+    const size_t sizes[] = { 1000, 4000000 };
+
+    std::vector<int> host_needles(needle_count);
+    for(size_t i = 0; i < needle_count; i++){
+        host_needles[i] = std::rand() % 2200 - 100;
+    }
+    boost::compute::vector<int> needles(host_needles.begin(), host_needles.end(), queue);
+
+    for(size_t s = 0; s < 2; s++){
+        std::vector<int> host_data(sizes[s]);
+        for(size_t i = 0; i < host_data.size(); i++){
+            host_data[i] = static_cast<int>(i * 2000 / host_data.size());
+        }
+        boost::compute::vector<int> data(host_data.begin(), host_data.end(), queue);
+
+        boost::compute::vector<boost::compute::uint_> lower(needle_count, context);
+        boost::compute::vector<boost::compute::uint_> upper(needle_count, context);
+        boost::compute::vector<boost::compute::uchar_> found(needle_count, context);
+        boost::compute::lower_bound(
+            data.begin(), data.end(), needles.begin(), needles.end(), lower.begin(), queue
+        );
+        boost::compute::upper_bound(
+            data.begin(), data.end(), needles.begin(), needles.end(), upper.begin(), queue
+        );
+        boost::compute::binary_search(
+            data.begin(), data.end(), needles.begin(), needles.end(), found.begin(), queue
+        );
+
+        std::vector<boost::compute::uint_> host_lower(needle_count);
+        std::vector<boost::compute::uint_> host_upper(needle_count);
+        std::vector<boost::compute::uchar_> host_found(needle_count);
+        boost::compute::copy(lower.begin(), lower.end(), host_lower.begin(), queue);
+        boost::compute::copy(upper.begin(), upper.end(), host_upper.begin(), queue);
+        boost::compute::copy(found.begin(), found.end(), host_found.begin(), queue);
+
+        size_t errors = 0;
+        for(size_t i = 0; i < needle_count; i++){
+            const int needle = host_needles[i];
+            const size_t expected_lower =
+                std::lower_bound(host_data.begin(), host_data.end(), needle) - host_data.begin();
+            const size_t expected_upper =
+                std::upper_bound(host_data.begin(), host_data.end(), needle) - host_data.begin();
+            const bool expected_found =
+                std::binary_search(host_data.begin(), host_data.end(), needle);
+
+            if(host_lower[i] != expected_lower ||
+               host_upper[i] != expected_upper ||
+               (host_found[i] != 0) != expected_found){
+                errors++;
+            }
+        }
+        BOOST_CHECK_EQUAL(errors, size_t(0));
+    }
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,251 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://boostorg.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#define BOOST_TEST_MODULE TestCommandGraph
+#include <boost/test/unit_test.hpp>
+
+#include <vector>
+
+#ifdef BOOST_COMPUTE_USE_CPP11
+#include <thread>
+#endif // BOOST_COMPUTE_USE_CPP11
+
+#include <boost/compute/system.hpp>
+#include <boost/compute/algorithm/copy.hpp>
+#include <boost/compute/algorithm/fill.hpp>
+#include <boost/compute/algorithm/reduce_by_key.hpp>
+#include <boost/compute/algorithm/sort_by_key.hpp>
+#include <boost/compute/algorithm/transform.hpp>
+#include <boost/compute/container/mapped_view.hpp>
+#include <boost/compute/container/vector.hpp>
+#include <boost/compute/lambda.hpp>
+#include <boost/compute/utility/command_graph.hpp>
+
+#include "check_macros.hpp"
+#include "context_setup.hpp"
+
+namespace compute = boost::compute;
+
+BOOST_AUTO_TEST_CASE(empty_graph)
+{
+    compute::command_graph graph(queue);
+    BOOST_CHECK(graph.empty());
+    BOOST_CHECK(graph.replayable());
+    BOOST_CHECK(!graph.is_recording());
+
+    graph.begin_recording();
+    BOOST_CHECK(graph.is_recording());
+    graph.end_recording();
+
+    BOOST_CHECK_EQUAL(graph.size(), size_t(0));
+    graph.replay(queue);
+}
+
+BOOST_AUTO_TEST_CASE(replay_transform)
+{
+    using compute::lambda::_1;
+
+    int data[] = { 1, 2, 3, 4 };
+    compute::vector<int> input(data, data + 4, queue);
+    compute::vector<int> output(4, context);
+
+    compute::command_graph graph(queue);
+    graph.begin_recording();
+    compute::transform(
+        input.begin(), input.end(), output.begin(), _1 * 2 + 1, queue
+    );
+    graph.end_recording();
+    BOOST_CHECK_EQUAL(graph.size(), size_t(1));
+
+    // commands are executed while recording
+    CHECK_RANGE_EQUAL(int, 4, output, (3, 5, 7, 9));
+
+    // replay with new values in the input buffer
+    int data2[] = { 10, 20, 30, 40 };
+    compute::copy(data2, data2 + 4, input.begin(), queue);
+    compute::fill(output.begin(), output.end(), 0, queue);
+    graph.replay(queue).wait();
+    CHECK_RANGE_EQUAL(int, 4, output, (21, 41, 61, 81));
+
+    // replay twice more
+    graph.replay().wait();
+    graph.replay().wait();
+    CHECK_RANGE_EQUAL(int, 4, output, (21, 41, 61, 81));
+}
+
+BOOST_AUTO_TEST_CASE(rebind_buffers)
+{
+    using compute::lambda::_1;
+
+    int data[] = { 1, 2, 3, 4 };
+    compute::vector<int> input(data, data + 4, queue);
+    compute::vector<int> output(4, context);
+
+    compute::command_graph graph(queue);
+    graph.begin_recording();
+    compute::transform(
+        input.begin(), input.end(), output.begin(), _1 - 1, queue
+    );
+    compute::transform(
+        output.begin(), output.end(), output.begin(), _1 * _1, queue
+    );
+    graph.end_recording();
+    BOOST_CHECK_EQUAL(graph.size(), size_t(2));
+    CHECK_RANGE_EQUAL(int, 4, output, (0, 1, 4, 9));
+
+    int data2[] = { 5, 6, 7, 8 };
+    compute::vector<int> input2(data2, data2 + 4, queue);
+    compute::vector<int> output2(4, context);
+
+    graph.rebind(input.get_buffer(), input2.get_buffer());
+    graph.rebind(output.get_buffer(), output2.get_buffer());
+    graph.replay().wait();
+
+    CHECK_RANGE_EQUAL(int, 4, output2, (16, 25, 36, 49));
+    CHECK_RANGE_EQUAL(int, 4, output, (0, 1, 4, 9));
+}
+
+BOOST_AUTO_TEST_CASE(replay_pipeline)
+{
+    using compute::lambda::_1;
+
+    int keys[] = { 3, 1, 2, 1, 3, 2, 1, 3 };
+    int values[] = { 1, 2, 3, 4, 5, 6, 7, 8 };
+
+    compute::vector<int> device_keys(8, context);
+    compute::vector<int> device_values(8, context);
+    compute::vector<int> result_keys(8, context);
+    compute::vector<int> result_values(8, context);
+    std::vector<int> host_values(3);
+
+    compute::command_graph graph(queue);
+    graph.begin_recording();
+    compute::copy(keys, keys + 8, device_keys.begin(), queue);
+    compute::copy(values, values + 8, device_values.begin(), queue);
+    compute::transform(
+        device_values.begin(), device_values.end(),
+        device_values.begin(), _1 * 10, queue
+    );
+    compute::sort_by_key(
+        device_keys.begin(), device_keys.end(), device_values.begin(), queue
+    );
+    compute::reduce_by_key(
+        device_keys.begin(), device_keys.end(), device_values.begin(),
+        result_keys.begin(), result_values.begin(), queue
+    );
+    compute::copy(
+        result_values.begin(), result_values.begin() + 3,
+        host_values.begin(), queue
+    );
+    graph.end_recording();
+    BOOST_CHECK(graph.replayable());
+
+    BOOST_CHECK_EQUAL(host_values[0], 130);
+    BOOST_CHECK_EQUAL(host_values[1], 90);
+    BOOST_CHECK_EQUAL(host_values[2], 140);
+
+    // new input with the same key structure
+    int new_values[] = { 2, 2, 2, 2, 2, 2, 2, 1 };
+    std::vector<int> new_host_values(3);
+    graph.rebind(static_cast<const void *>(values),
+                 static_cast<const void *>(new_values));
+    graph.rebind(&host_values[0], &new_host_values[0]);
+    graph.replay().wait();
+
+    BOOST_CHECK_EQUAL(new_host_values[0], 60);
+    BOOST_CHECK_EQUAL(new_host_values[1], 40);
+    BOOST_CHECK_EQUAL(new_host_values[2], 50);
+
+    // original host values are untouched
+    BOOST_CHECK_EQUAL(host_values[0], 130);
+}
+
+BOOST_AUTO_TEST_CASE(unbound_reads_are_not_replayed)
+{
+    int data[] = { 1, 2, 3, 4 };
+    compute::vector<int> input(data, data + 4, queue);
+
+    int host[4] = { 0, 0, 0, 0 };
+
+    compute::command_graph graph(queue);
+    graph.begin_recording();
+    compute::copy(input.begin(), input.end(), host, queue);
+    graph.end_recording();
+    BOOST_CHECK_EQUAL(host[3], 4);
+
+    host[3] = 0;
+    graph.replay().wait();
+    BOOST_CHECK_EQUAL(host[3], 0);
+
+    graph.rebind(host, host);
+    graph.replay().wait();
+    BOOST_CHECK_EQUAL(host[3], 4);
+}
+
+BOOST_AUTO_TEST_CASE(other_queues_are_not_recorded)
+{
+    using compute::lambda::_1;
+
+    compute::command_queue other_queue(context, device);
+
+    compute::vector<int> vec(4, context);
+    compute::fill(vec.begin(), vec.end(), 1, queue);
+
+    compute::command_graph graph(queue);
+    graph.begin_recording();
+    compute::transform(vec.begin(), vec.end(), vec.begin(), _1 + 1, other_queue);
+    other_queue.finish();
+    graph.end_recording();
+
+    BOOST_CHECK(graph.empty());
+}
+
+#ifdef BOOST_COMPUTE_USE_CPP11
+BOOST_AUTO_TEST_CASE(other_threads_are_not_recorded)
+{
+    compute::vector<int> vec(4, context);
+
+    compute::command_graph graph(queue);
+    graph.begin_recording();
+    std::thread thread([&](){
+        compute::fill(vec.begin(), vec.end(), 1, queue);
+        queue.finish();
+    });
+    thread.join();
+    graph.end_recording();
+
+    BOOST_CHECK(graph.empty());
+    CHECK_RANGE_EQUAL(int, 4, vec, (1, 1, 1, 1));
+}
+#endif // BOOST_COMPUTE_USE_CPP11
+
+BOOST_AUTO_TEST_CASE(unsupported_commands)
+{
+    int data[] = { 1, 2, 3, 4 };
+    compute::vector<int> vec(data, data + 4, queue);
+
+    compute::command_graph graph(queue);
+    graph.begin_recording();
+    int *ptr = static_cast<int *>(
+        queue.enqueue_map_buffer(vec.get_buffer(), CL_MAP_READ, 0, vec.size() * sizeof(int))
+    );
+    BOOST_CHECK_EQUAL(ptr[0], 1);
+    queue.enqueue_unmap_buffer(vec.get_buffer(), ptr).wait();
+    graph.end_recording();
+
+    BOOST_CHECK(!graph.replayable());
+    BOOST_CHECK_THROW(graph.replay(), compute::opencl_error);
+
+    graph.clear();
+    BOOST_CHECK(graph.empty());
+    BOOST_CHECK(graph.replayable());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -11,6 +11,10 @@
 #define BOOST_TEST_MODULE TestContext
 #include <boost/test/unit_test.hpp>
 
+#include <algorithm>
+#include <iostream>
+#include <vector>
+
 #include <boost/compute/system.hpp>
 #include <boost/compute/context.hpp>
 
@@ -64,4 +68,48 @@ BOOST_AUTO_TEST_CASE(multiple_devices)
     }
 }
 
+#ifdef BOOST_COMPUTE_CL_VERSION_1_2
+BOOST_AUTO_TEST_CASE(get_devices_retains_sub_devices)
+{
+    REQUIRES_OPENCL_VERSION(1,2);
+
+    if(device.compute_units() < 2){
+        std::cout << "skipping test: "
+                  << "device does not have enough compute units"
+                  << std::endl;
+        return;
+    }
+
+    const std::vector<cl_device_partition_property> properties =
+        device.get_info<std::vector<cl_device_partition_property> >(
+            CL_DEVICE_PARTITION_PROPERTIES
+        );
+    if(std::find(properties.begin(), properties.end(),
+                 CL_DEVICE_PARTITION_EQUALLY) == properties.end()){
+        std::cout << "skipping test: "
+                  << "device does not support CL_DEVICE_PARTITION_EQUALLY"
+                  << std::endl;
+        return;
+    }
+
+    std::vector<compute::device> sub_devices =
+        device.partition_equally(device.compute_units() / 2);
+    compute::context sub_context(sub_devices[0]);
+
+    const cl_uint references =
+        sub_devices[0].get_info<cl_uint>(CL_DEVICE_REFERENCE_COUNT);
+
+    // the returned devices release their sub-devices when destroyed
+    for(size_t i = 0; i < 3; i++){
+        std::vector<compute::device> devices = sub_context.get_devices();
+        BOOST_REQUIRE_EQUAL(devices.size(), size_t(1));
+        BOOST_CHECK(devices[0] == sub_devices[0]);
+    }
+
+    BOOST_CHECK_EQUAL(
+        sub_devices[0].get_info<cl_uint>(CL_DEVICE_REFERENCE_COUNT), references
+    );
+}
+#endif // BOOST_COMPUTE_CL_VERSION_1_2
+
 BOOST_AUTO_TEST_SUITE_END()
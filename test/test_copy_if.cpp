@@ -11,6 +11,8 @@
 #define BOOST_TEST_MODULE TestCopyIf
 #include <boost/test/unit_test.hpp>
 
+#include <vector>
+
 #include <boost/compute/lambda.hpp>
 #include <boost/compute/algorithm/copy_if.hpp>
 #include <boost/compute/container/vector.hpp>
@@ -116,4 +118,70 @@ BOOST_AUTO_TEST_CASE(copy_index_if_int)
     CHECK_RANGE_EQUAL(int, 7, output, (0, 2, 5, 6, -1, -1, -1));
 }
 
+BOOST_AUTO_TEST_CASE(copy_if_large)
+{
+    using ::boost::compute::_1;
+
+    // not a multiple of the number of values flagged by each work-item
+    std::vector<int> host(10007);
+    for(size_t i = 0; i < host.size(); i++){
+        host[i] = int((i * 7) % 13);
+    }
+    compute::vector<int> input(host.begin(), host.end(), queue);
+    compute::vector<int> output(input.size(), context);
+
+    std::vector<int> expected;
+    for(size_t i = 0; i < host.size(); i++){
+        if(host[i] > 8){
+            expected.push_back(host[i]);
+        }
+    }
+
+    compute::vector<int>::iterator iter = compute::copy_if(
+        input.begin() + 1, input.end(), output.begin() + 2, _1 > 8, queue
+    );
+    if(host[0] > 8){
+        expected.erase(expected.begin());
+    }
+    BOOST_CHECK_EQUAL(
+        std::distance(output.begin() + 2, iter), std::ptrdiff_t(expected.size())
+    );
+
+    std::vector<int> result(expected.size());
+    compute::copy(output.begin() + 2, iter, result.begin(), queue);
+    BOOST_CHECK(result == expected);
+
+    // no values copied
+    iter = compute::copy_if(
+        input.begin(), input.end(), output.begin(), _1 > 20, queue
+    );
+    BOOST_CHECK(iter == output.begin());
+}
+
+BOOST_AUTO_TEST_CASE(copy_if_async_int)
+{
+    using ::boost::compute::_1;
+
+    int data[] = { 1, 6, 3, 5, 8, 2, 4 };
+    bc::vector<int> input(data, data + 7, queue);
+    bc::vector<int> output(input.size(), -1, queue);
+
+    bc::future<bc::vector<int>::iterator> future =
+        bc::copy_if_async(input.begin(), input.end(),
+                          output.begin(), _1 < 5, queue);
+    BOOST_CHECK(future.valid());
+    BOOST_CHECK(future.get() == output.begin() + 4);
+    CHECK_RANGE_EQUAL(int, 7, output, (1, 3, 2, 4, -1, -1, -1));
+
+    // no values copied
+    future = bc::copy_if_async(input.begin(), input.end(),
+                               output.begin(), _1 > 20, queue);
+    BOOST_CHECK(future.get() == output.begin());
+
+    // empty input
+    future = bc::copy_if_async(input.begin(), input.begin(),
+                               output.begin(), _1 < 5, queue);
+    BOOST_CHECK(future.get() == output.begin());
+}
+
 BOOST_AUTO_TEST_SUITE_END()
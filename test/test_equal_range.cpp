@@ -18,6 +18,7 @@
 #include <boost/compute/algorithm/equal_range.hpp>
 #include <boost/compute/container/vector.hpp>
 
+#include "check_macros.hpp"
 #include "context_setup.hpp"
 
 BOOST_AUTO_TEST_CASE(equal_range_int)
@@ -70,4 +71,24 @@ BOOST_AUTO_TEST_CASE(equal_range_int)
     BOOST_CHECK_EQUAL(std::distance(range6.first, range6.second), ptrdiff_t(0));
 }
 
+BOOST_AUTO_TEST_CASE(vectorized_equal_range_int)
+{
+    int data[] = { 1, 2, 2, 2, 3, 3, 4, 5 };
+    boost::compute::vector<int> vector(data, data + 8, queue);
+
+    int needles_data[] = { 0, 1, 2, 3, 4, 5, 6 };
+    boost::compute::vector<int> needles(needles_data, needles_data + 7, queue);
+
+    boost::compute::vector<boost::compute::uint_> lower(7, context);
+    boost::compute::vector<boost::compute::uint_> upper(7, context);
+    boost::compute::equal_range(
+        vector.begin(), vector.end(),
+        needles.begin(), needles.end(),
+        lower.begin(), upper.begin(),
+        queue
+    );
+    CHECK_RANGE_EQUAL(boost::compute::uint_, 7, lower, (0, 0, 1, 4, 6, 7, 8));
+    CHECK_RANGE_EQUAL(boost::compute::uint_, 7, upper, (0, 1, 4, 6, 7, 8, 8));
+}
+
 BOOST_AUTO_TEST_SUITE_END()
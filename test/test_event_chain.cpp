@@ -0,0 +1,230 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://boostorg.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#define BOOST_TEST_MODULE TestEventChain
+#include <boost/test/unit_test.hpp>
+
+#ifdef BOOST_COMPUTE_USE_CPP11
+#include <chrono>
+#include <future>
+#include <vector>
+#endif // BOOST_COMPUTE_USE_CPP11
+
+#include <boost/compute/system.hpp>
+#include <boost/compute/user_event.hpp>
+#include <boost/compute/algorithm/copy.hpp>
+#include <boost/compute/algorithm/sort.hpp>
+#include <boost/compute/algorithm/transform.hpp>
+#include <boost/compute/async/event_chain.hpp>
+#include <boost/compute/container/vector.hpp>
+#include <boost/compute/lambda.hpp>
+
+#include "check_macros.hpp"
+#include "context_setup.hpp"
+
+namespace compute = boost::compute;
+
+static bool supports_out_of_order_queues(const compute::device &device)
+{
+    cl_command_queue_properties properties =
+        device.get_info<cl_command_queue_properties>(CL_DEVICE_QUEUE_PROPERTIES);
+
+    return (properties & CL_QUEUE_OUT_OF_ORDER_EXEC_MODE_ENABLE) != 0;
+}
+
+BOOST_AUTO_TEST_CASE(in_order_chain)
+{
+    using compute::lambda::_1;
+
+    int data[] = { 4, 2, 3, 1 };
+    compute::vector<int> vec(data, data + 4, queue);
+
+    compute::event event;
+    {
+        compute::event_chain chain(queue);
+        BOOST_CHECK(chain.empty());
+
+        compute::transform(vec.begin(), vec.end(), vec.begin(), _1 * 10, queue);
+        compute::sort(vec.begin(), vec.end(), queue);
+        BOOST_CHECK(!chain.empty());
+
+        event = chain.last_event();
+    }
+    event.wait();
+
+    CHECK_RANGE_EQUAL(int, 4, vec, (10, 20, 30, 40));
+}
+
+BOOST_AUTO_TEST_CASE(chain_waits_for_events)
+{
+    using compute::lambda::_1;
+
+    if(!supports_out_of_order_queues(device)){
+        return;
+    }
+
+    compute::command_queue ooo_queue(
+        context, device, compute::command_queue::enable_out_of_order_execution
+    );
+
+    int data[] = { 1, 2, 3, 4 };
+    compute::vector<int> input(data, data + 4, queue);
+    compute::vector<int> tmp(4, context);
+    compute::vector<int> output(4, context);
+    queue.finish();
+
+    // nothing in the chain may run before the gate is opened
+    compute::user_event gate(context);
+
+    compute::event event;
+    {
+        compute::event_chain chain(ooo_queue, compute::wait_list(gate));
+        compute::transform(
+            input.begin(), input.end(), tmp.begin(), _1 * 2, ooo_queue
+        );
+        compute::transform(
+            tmp.begin(), tmp.end(), output.begin(), _1 + 1, ooo_queue
+        );
+        event = chain.last_event();
+    }
+
+    gate.set_status(CL_COMPLETE);
+    event.wait();
+
+    CHECK_RANGE_EQUAL(int, 4, output, (3, 5, 7, 9));
+}
+
+BOOST_AUTO_TEST_CASE(independent_chains)
+{
+    using compute::lambda::_1;
+    using compute::lambda::_2;
+
+    if(!supports_out_of_order_queues(device)){
+        return;
+    }
+
+    compute::command_queue ooo_queue(
+        context, device, compute::command_queue::enable_out_of_order_execution
+    );
+
+    int data_a[] = { 8, 6, 4, 2 };
+    int data_b[] = { 7, 5, 3, 1 };
+    compute::vector<int> a(data_a, data_a + 4, queue);
+    compute::vector<int> b(data_b, data_b + 4, queue);
+    compute::vector<int> c(4, context);
+    queue.finish();
+
+    compute::wait_list sorted;
+    {
+        compute::event_chain chain(ooo_queue);
+        compute::sort(a.begin(), a.end(), ooo_queue);
+        sorted.insert(chain.last_event());
+    }
+    {
+        compute::event_chain chain(ooo_queue);
+        compute::sort(b.begin(), b.end(), ooo_queue);
+        sorted.insert(chain.last_event());
+    }
+    {
+        compute::event_chain chain(ooo_queue, sorted);
+        compute::transform(
+            a.begin(), a.end(), b.begin(), c.begin(), _1 - _2, ooo_queue
+        );
+        chain.wait();
+    }
+
+    CHECK_RANGE_EQUAL(int, 4, c, (1, 1, 1, 1));
+}
+
+BOOST_AUTO_TEST_CASE(nested_chains)
+{
+    using compute::lambda::_1;
+
+    if(!supports_out_of_order_queues(device)){
+        return;
+    }
+
+    compute::command_queue ooo_queue(
+        context, device, compute::command_queue::enable_out_of_order_execution
+    );
+
+    int data[] = { 1, 2, 3, 4 };
+    compute::vector<int> vec(data, data + 4, queue);
+    queue.finish();
+
+    compute::user_event gate(context);
+
+    compute::event event;
+    {
+        compute::event_chain outer(ooo_queue, compute::wait_list(gate));
+        compute::transform(vec.begin(), vec.end(), vec.begin(), _1 + 1, ooo_queue);
+        {
+            compute::event_chain inner(ooo_queue);
+            compute::transform(vec.begin(), vec.end(), vec.begin(), _1 * 2, ooo_queue);
+        }
+        compute::transform(vec.begin(), vec.end(), vec.begin(), _1 - 3, ooo_queue);
+        event = outer.last_event();
+    }
+
+    gate.set_status(CL_COMPLETE);
+    event.wait();
+
+    CHECK_RANGE_EQUAL(int, 4, vec, (1, 3, 5, 7));
+}
+
+#ifdef BOOST_COMPUTE_USE_CPP11
+BOOST_AUTO_TEST_CASE(other_threads_are_not_chained)
+{
+    using compute::lambda::_1;
+
+    compute::vector<int> vec(4, context);
+    compute::fill(vec.begin(), vec.end(), 0, queue);
+    queue.finish();
+
+    compute::command_queue other_queue(context, device);
+    compute::user_event gate(context);
+
+    {
+        compute::event_chain chain(queue, compute::wait_list(gate));
+
+        // commands from other threads do not wait for the closed gate
+        std::future<std::vector<int> > result = std::async(std::launch::async, [&](){
+            compute::transform(vec.begin(), vec.end(), vec.begin(), _1 + 3, queue);
+            queue.finish();
+
+            std::vector<int> host(4);
+            compute::copy(vec.begin(), vec.end(), host.begin(), other_queue);
+            return host;
+        });
+        const bool finished =
+            result.wait_for(std::chrono::seconds(30)) == std::future_status::ready;
+        gate.set_status(CL_COMPLETE);
+
+        BOOST_CHECK(finished);
+        BOOST_CHECK(result.get() == std::vector<int>(4, 3));
+    }
+}
+#endif // BOOST_COMPUTE_USE_CPP11
+
+BOOST_AUTO_TEST_CASE(empty_chain_last_event)
+{
+    compute::user_event gate(context);
+
+    compute::event_chain chain(queue, compute::wait_list(gate));
+    BOOST_CHECK(chain.empty());
+
+    compute::event event = chain.last_event();
+    BOOST_CHECK(event.get() != 0);
+
+    gate.set_status(CL_COMPLETE);
+    event.wait();
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,264 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://boostorg.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#define BOOST_TEST_MODULE TestFFT
+#include <boost/test/unit_test.hpp>
+
+#include <cmath>
+#include <complex>
+#include <cstdlib>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <boost/compute/algorithm/copy.hpp>
+#include <boost/compute/container/vector.hpp>
+#include <boost/compute/detail/parameter_cache.hpp>
+#include <boost/compute/fft/fft_plan.hpp>
+#include <boost/compute/type_traits/type_name.hpp>
+
+#include "context_setup.hpp"
+
+namespace bc = boost::compute;
+
+// computes the discrete fourier transforms of the batch of count
+// transforms of length values which are stride values apart
+template<class T>
+void host_dft(std::vector<std::complex<T> > &data,
+              size_t length,
+              size_t stride,
+              size_t count,
+              size_t inner_count,
+              size_t inner_distance,
+              size_t outer_distance)
+{
+    const double pi = 3.14159265358979323846;
+
+    for(size_t b = 0; b < count; b++){
+        const size_t offset =
+            (b / inner_count) * outer_distance + (b % inner_count) * inner_distance;
+
+        std::vector<std::complex<double> > result(length);
+        for(size_t k = 0; k < length; k++){
+            for(size_t j = 0; j < length; j++){
+                const double angle = -2 * pi * double((j * k) % length) / length;
+                result[k] += std::complex<double>(data[offset + j * stride]) *
+                             std::complex<double>(std::cos(angle), std::sin(angle));
+            }
+        }
+        for(size_t k = 0; k < length; k++){
+            data[offset + k * stride] = std::complex<T>(result[k]);
+        }
+    }
+}
+
+template<class T>
+std::vector<std::complex<T> > random_signal(size_t size)
+{
+    std::vector<std::complex<T> > signal(size);
+    for(size_t i = 0; i < size; i++){
+        signal[i] = std::complex<T>(
+            T(std::rand() % 2000) / 1000 - 1, T(std::rand() % 2000) / 1000 - 1
+        );
+    }
+    return signal;
+}
+
+template<class T>
+void check_close(const std::vector<std::complex<T> > &actual,
+                 const std::vector<std::complex<T> > &expected,
+                 double tolerance)
+{
+    BOOST_REQUIRE_EQUAL(actual.size(), expected.size());
+    for(size_t i = 0; i < actual.size(); i++){
+        BOOST_REQUIRE_SMALL(std::abs(actual[i] - expected[i]), T(tolerance));
+    }
+}
+
+// checks the forward transform and the inverse transform of a batch of
+// one-dimensional transforms against the host
+template<class T>
+void check_fft_1d(size_t length,
+                  size_t batch_size,
+                  bc::command_queue &queue,
+                  double tolerance = 1e-4)
+{
+    const bc::context &context = queue.get_context();
+
+    std::vector<std::complex<T> > signal = random_signal<T>(length * batch_size);
+    std::vector<std::complex<T> > expected = signal;
+    host_dft(expected, length, 1, batch_size, batch_size, length, 0);
+
+    bc::vector<std::complex<T> > input(signal.begin(), signal.end(), queue);
+    bc::vector<std::complex<T> > output(signal.size(), context);
+
+    bc::fft_plan<T> plan(length, batch_size, context);
+    plan.forward(input.begin(), output.begin(), queue);
+
+    std::vector<std::complex<T> > result(signal.size());
+    bc::copy(output.begin(), output.end(), result.begin(), queue);
+    check_close(result, expected, tolerance * length);
+
+    // the inverse transform scales by 1/length
+    plan.inverse(output.begin(), output.begin(), queue);
+    bc::copy(output.begin(), output.end(), result.begin(), queue);
+    check_close(result, signal, tolerance);
+}
+
+// sets the largest length of float transforms which are transformed in
+// local memory for the lifetime of the object
+class scoped_max_local_length
+{
+public:
+    scoped_max_local_length(bc::uint_ length, bc::command_queue &queue)
+        : m_key("__boost_fft_" + std::string(bc::type_name<std::complex<float> >())),
+          m_parameters(bc::detail::parameter_cache::get_global_cache(queue.get_device()))
+    {
+        m_saved = m_parameters->get(
+            m_key,
+            "max_local_length",
+            bc::detail::fft_default_max_local_length<float>(queue.get_device())
+        );
+        m_parameters->set(m_key, "max_local_length", length);
+    }
+
+    ~scoped_max_local_length()
+    {
+        m_parameters->set(m_key, "max_local_length", m_saved);
+    }
+
+private:
+    std::string m_key;
+    boost::shared_ptr<bc::detail::parameter_cache> m_parameters;
+    bc::uint_ m_saved;
+};
+
+BOOST_AUTO_TEST_CASE(supported_lengths)
+{
+    BOOST_CHECK(bc::fft_plan<float>::is_supported_length(1));
+    BOOST_CHECK(bc::fft_plan<float>::is_supported_length(1024));
+    BOOST_CHECK(bc::fft_plan<float>::is_supported_length(1000));
+    BOOST_CHECK(bc::fft_plan<float>::is_supported_length(2 * 3 * 5 * 8));
+    BOOST_CHECK(!bc::fft_plan<float>::is_supported_length(0));
+    BOOST_CHECK(!bc::fft_plan<float>::is_supported_length(7));
+    BOOST_CHECK(!bc::fft_plan<float>::is_supported_length(2 * 11));
+
+    BOOST_CHECK_THROW(bc::fft_plan<float>(7, 1, context), std::invalid_argument);
+    BOOST_CHECK_THROW(bc::fft_plan<float>(8, 14, 1, context), std::invalid_argument);
+}
+
+BOOST_AUTO_TEST_CASE(fft_radix)
+{
+    // single stages and the butterflies of each radix
+    check_fft_1d<float>(1, 3, queue);
+    check_fft_1d<float>(2, 5, queue);
+    check_fft_1d<float>(3, 5, queue);
+    check_fft_1d<float>(4, 5, queue);
+    check_fft_1d<float>(5, 5, queue);
+}
+
+BOOST_AUTO_TEST_CASE(fft_power_of_two)
+{
+    check_fft_1d<float>(8, 7, queue);
+    check_fft_1d<float>(32, 3, queue);
+    check_fft_1d<float>(256, 2, queue);
+    check_fft_1d<float>(1024, 2, queue);
+}
+
+BOOST_AUTO_TEST_CASE(fft_mixed_radix)
+{
+    check_fft_1d<float>(6, 4, queue);
+    check_fft_1d<float>(60, 3, queue);
+    check_fft_1d<float>(125, 2, queue);
+    check_fft_1d<float>(243, 2, queue);
+    check_fft_1d<float>(2 * 3 * 5 * 16, 2, queue);
+}
+
+BOOST_AUTO_TEST_CASE(fft_global_stages)
+{
+    // transform all lengths with one kernel per stage
+    scoped_max_local_length max_local_length(0, queue);
+
+    check_fft_1d<float>(2, 3, queue);
+    check_fft_1d<float>(16, 3, queue);
+    check_fft_1d<float>(120, 3, queue);
+    check_fft_1d<float>(1000, 2, queue);
+}
+
+BOOST_AUTO_TEST_CASE(fft_offset)
+{
+    const size_t length = 48;
+    const size_t batch_size = 3;
+
+    std::vector<std::complex<float> > signal =
+        random_signal<float>(length * batch_size + 5);
+    std::vector<std::complex<float> > expected(signal.begin() + 5, signal.end());
+    host_dft(expected, length, 1, batch_size, batch_size, length, 0);
+
+    bc::vector<std::complex<float> > input(signal.begin(), signal.end(), queue);
+    bc::vector<std::complex<float> > output(length * batch_size + 2, context);
+
+    bc::fft_plan<float> plan(length, batch_size, context);
+    plan.forward(input.begin() + 5, output.begin() + 2, queue);
+
+    std::vector<std::complex<float> > result(length * batch_size);
+    bc::copy(output.begin() + 2, output.end(), result.begin(), queue);
+    check_close(result, expected, 1e-4 * length);
+}
+
+BOOST_AUTO_TEST_CASE(fft_2d)
+{
+    const size_t width = 16;
+    const size_t height = 15;
+    const size_t batch_size = 3;
+    const size_t size = width * height;
+
+    std::vector<std::complex<float> > signal = random_signal<float>(size * batch_size);
+    std::vector<std::complex<float> > expected = signal;
+    host_dft(expected, width, 1, height * batch_size, height * batch_size, width, 0);
+    host_dft(expected, height, width, width * batch_size, width, 1, size);
+
+    bc::vector<std::complex<float> > vector(signal.begin(), signal.end(), queue);
+
+    // in place
+    bc::fft_plan<float> plan(width, height, batch_size, context);
+    BOOST_CHECK_EQUAL(plan.size(), size);
+    BOOST_CHECK_EQUAL(plan.batch_size(), batch_size);
+    plan.forward(vector.begin(), vector.begin(), queue);
+
+    std::vector<std::complex<float> > result(signal.size());
+    bc::copy(vector.begin(), vector.end(), result.begin(), queue);
+    check_close(result, expected, 1e-4 * size);
+
+    plan.inverse(vector.begin(), vector.begin(), queue);
+    bc::copy(vector.begin(), vector.end(), result.begin(), queue);
+    check_close(result, signal, 1e-4);
+
+    // with one kernel per stage
+    scoped_max_local_length max_local_length(0, queue);
+    bc::fft_plan<float> global_plan(width, height, batch_size, context);
+    bc::copy(signal.begin(), signal.end(), vector.begin(), queue);
+    global_plan.forward(vector.begin(), vector.begin(), queue);
+    bc::copy(vector.begin(), vector.end(), result.begin(), queue);
+    check_close(result, expected, 1e-4 * size);
+}
+
+BOOST_AUTO_TEST_CASE(fft_double)
+{
+    if(!device.supports_extension("cl_khr_fp64")){
+        std::cout << "skipping test: device does not support double" << std::endl;
+        return;
+    }
+
+    check_fft_1d<double>(360, 2, queue, 1e-9);
+    check_fft_1d<double>(4096, 1, queue, 1e-9);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
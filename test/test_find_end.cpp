@@ -17,6 +17,8 @@
 #include <boost/compute/container/vector.hpp>
 #include <boost/compute/types/fundamental.hpp>
 
+#include <vector>
+
 #include "check_macros.hpp"
 #include "context_setup.hpp"
 
@@ -60,4 +62,21 @@ BOOST_AUTO_TEST_CASE(find_end_string)
     BOOST_CHECK(iter == (vectort.begin() + 15));
 }
 
+BOOST_AUTO_TEST_CASE(find_end_large)
+{
+    std::vector<bc::int_> text(5000);
+    for(size_t i = 0; i < text.size(); i++){
+        text[i] = static_cast<bc::int_>(i % 7);
+    }
+    bc::vector<bc::int_> vectort(text.begin(), text.end(), queue);
+
+    bc::int_ pattern[] = {4, 5, 6, 0};
+    bc::vector<bc::int_> vectorp(pattern, pattern + 4, queue);
+
+    bc::vector<bc::int_>::iterator iter =
+        bc::find_end(vectort.begin(), vectort.end(),
+                     vectorp.begin(), vectorp.end(), queue);
+    BOOST_CHECK(iter == vectort.begin() + 4995);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
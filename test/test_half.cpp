@@ -0,0 +1,222 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://boostorg.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#define BOOST_TEST_MODULE TestHalf
+#include <boost/test/unit_test.hpp>
+
+#include <algorithm>
+#include <cstdlib>
+#include <limits>
+#include <string>
+#include <vector>
+
+#include <boost/compute/function.hpp>
+#include <boost/compute/algorithm/copy.hpp>
+#include <boost/compute/algorithm/reduce.hpp>
+#include <boost/compute/algorithm/sort.hpp>
+#include <boost/compute/algorithm/transform.hpp>
+#include <boost/compute/container/vector.hpp>
+#include <boost/compute/functional/common.hpp>
+#include <boost/compute/functional/math.hpp>
+#include <boost/compute/types/fundamental.hpp>
+#include <boost/compute/type_traits/type_name.hpp>
+
+#include "context_setup.hpp"
+
+namespace bc = boost::compute;
+
+using bc::half_;
+
+BOOST_AUTO_TEST_CASE(half_type_name)
+{
+    BOOST_CHECK(std::string(bc::type_name<half_>()) == "half");
+    BOOST_CHECK_EQUAL(sizeof(half_), size_t(2));
+}
+
+BOOST_AUTO_TEST_CASE(half_conversion)
+{
+    BOOST_CHECK_EQUAL(half_(0.0f).bits(), 0x0000);
+    BOOST_CHECK_EQUAL(half_(-0.0f).bits(), 0x8000);
+    BOOST_CHECK_EQUAL(half_(1.0f).bits(), 0x3c00);
+    BOOST_CHECK_EQUAL(half_(-2.0f).bits(), 0xc000);
+    BOOST_CHECK_EQUAL(half_(0.5f).bits(), 0x3800);
+    BOOST_CHECK_EQUAL(half_(65504.0f).bits(), 0x7bff);
+
+    // overflow to infinity
+    BOOST_CHECK_EQUAL(half_(65520.0f).bits(), 0x7c00);
+    BOOST_CHECK_EQUAL(half_(-1e10f).bits(), 0xfc00);
+    BOOST_CHECK_EQUAL(half_(std::numeric_limits<float>::infinity()).bits(), 0x7c00);
+
+    // rounding to the nearest even value
+    BOOST_CHECK_EQUAL(half_(1.0f + 1.0f / 2048).bits(), 0x3c00);
+    BOOST_CHECK_EQUAL(half_(1.0f + 3.0f / 2048).bits(), 0x3c02);
+    BOOST_CHECK_EQUAL(half_(1.0f + 1.0f / 4096).bits(), 0x3c00);
+
+    // subnormal values
+    BOOST_CHECK_EQUAL(half_(std::ldexp(1.0f, -24)).bits(), 0x0001);
+    BOOST_CHECK_EQUAL(half_(std::ldexp(1.0f, -25)).bits(), 0x0000);
+    BOOST_CHECK_EQUAL(half_(std::ldexp(3.0f, -26)).bits(), 0x0001);
+    BOOST_CHECK_EQUAL(half_(std::ldexp(1023.0f, -24)).bits(), 0x03ff);
+    BOOST_CHECK_EQUAL(float(half_::from_bits(0x0001)), std::ldexp(1.0f, -24));
+
+    // nan
+    const float nan = float(half_(std::numeric_limits<float>::quiet_NaN()));
+    BOOST_CHECK(nan != nan);
+
+    // every value except nan converts to float and back without changes
+    for(bc::uint_ bits = 0; bits < 0x10000; bits++){
+        const half_ value = half_::from_bits(static_cast<bc::ushort_>(bits));
+        const bool is_nan = (bits & 0x7c00) == 0x7c00 && (bits & 0x3ff) != 0;
+        if(!is_nan){
+            BOOST_REQUIRE_EQUAL(half_(float(value)).bits(), bits);
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(copy_float_to_half)
+{
+    float data[] = { 1.0f, -2.5f, 0.125f, 1000.0f, 3.14159f, 65504.0f };
+    bc::vector<half_> half_vector(6, context);
+
+    bc::copy(data, data + 6, half_vector.begin(), queue);
+
+    // the bits stored on the device
+    std::vector<half_> host_half(6);
+    bc::copy(half_vector.begin(), half_vector.end(), host_half.begin(), queue);
+    for(size_t i = 0; i < 6; i++){
+        BOOST_CHECK_EQUAL(host_half[i].bits(), half_(data[i]).bits());
+    }
+
+    // back to float
+    std::vector<float> host_float(6);
+    bc::copy(half_vector.begin(), half_vector.end(), host_float.begin(), queue);
+    for(size_t i = 0; i < 6; i++){
+        BOOST_CHECK_EQUAL(host_float[i], float(half_(data[i])));
+    }
+}
+
+BOOST_AUTO_TEST_CASE(copy_half_on_device)
+{
+    std::vector<float> data(1000);
+    for(size_t i = 0; i < data.size(); i++){
+        data[i] = static_cast<float>(i) * 0.25f - 100.0f;
+    }
+
+    bc::vector<float> input(data.begin(), data.end(), queue);
+    bc::vector<half_> half_vector(1003, context);
+    bc::vector<float> output(1000, context);
+
+    // to an offset in the half buffer and back
+    bc::copy(input.begin(), input.end(), half_vector.begin() + 3, queue);
+    bc::copy(half_vector.begin() + 3, half_vector.end(), output.begin(), queue);
+
+    std::vector<float> result(1000);
+    bc::copy(output.begin(), output.end(), result.begin(), queue);
+    for(size_t i = 0; i < result.size(); i++){
+        BOOST_REQUIRE_EQUAL(result[i], data[i]);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(transform_half)
+{
+    BOOST_COMPUTE_FUNCTION(float, scale_add, (float x),
+    {
+        return x * 2.0f + 1.0f;
+    });
+
+    std::vector<half_> data(500);
+    for(size_t i = 0; i < data.size(); i++){
+        data[i] = half_(static_cast<float>(i) * 0.5f);
+    }
+
+    bc::vector<half_> input(data.begin(), data.end(), queue);
+    bc::vector<half_> output(500, context);
+
+    bc::transform(input.begin(), input.end(), output.begin(), scale_add, queue);
+
+    std::vector<half_> result(500);
+    bc::copy(output.begin(), output.end(), result.begin(), queue);
+    for(size_t i = 0; i < result.size(); i++){
+        BOOST_REQUIRE_EQUAL(
+            result[i].bits(), half_(float(data[i]) * 2.0f + 1.0f).bits()
+        );
+    }
+
+    // half to float
+    bc::vector<float> float_output(500, context);
+    bc::transform(
+        input.begin(), input.end(), float_output.begin(), bc::sqrt<float>(), queue
+    );
+    std::vector<float> float_result(500);
+    bc::copy(float_output.begin(), float_output.end(), float_result.begin(), queue);
+    for(size_t i = 0; i < float_result.size(); i++){
+        BOOST_REQUIRE_CLOSE(float_result[i] + 1, std::sqrt(float(data[i])) + 1, 1e-4f);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(reduce_half)
+{
+    std::vector<half_> data(10000);
+    float max_value = 0;
+    for(size_t i = 0; i < data.size(); i++){
+        data[i] = half_(static_cast<float>(i % 100) * 0.25f);
+        max_value = (std::max)(max_value, float(data[i]));
+    }
+
+    bc::vector<half_> vector(data.begin(), data.end(), queue);
+
+    // the sum is computed in float and exceeds the range of half
+    float sum = 0;
+    bc::reduce(vector.begin(), vector.end(), &sum, queue);
+    BOOST_CHECK_EQUAL(sum, 123750.0f);
+
+    half_ max;
+    bc::reduce(vector.begin(), vector.end(), &max, bc::max<half_>(), queue);
+    BOOST_CHECK_EQUAL(float(max), max_value);
+
+    // host iterators
+    sum = 0;
+    bc::reduce(data.begin(), data.begin() + 100, &sum, queue);
+    BOOST_CHECK_EQUAL(sum, 1237.5f);
+}
+
+BOOST_AUTO_TEST_CASE(sort_half)
+{
+    std::vector<half_> data(5000);
+    for(size_t i = 0; i < data.size(); i++){
+        data[i] = half_(static_cast<float>(std::rand() % 20000 - 10000) / 16);
+    }
+
+    std::vector<float> expected(data.begin(), data.end());
+    std::sort(expected.begin(), expected.end());
+
+    bc::vector<half_> vector(data.begin(), data.end(), queue);
+    bc::sort(vector.begin(), vector.end(), queue);
+
+    std::vector<half_> result(data.size());
+    bc::copy(vector.begin(), vector.end(), result.begin(), queue);
+    for(size_t i = 0; i < result.size(); i++){
+        BOOST_REQUIRE_EQUAL(float(result[i]), expected[i]);
+    }
+
+    bc::sort(vector.begin(), vector.end(), bc::greater<half_>(), queue);
+    bc::copy(vector.begin(), vector.end(), result.begin(), queue);
+    for(size_t i = 0; i < result.size(); i++){
+        BOOST_REQUIRE_EQUAL(float(result[i]), expected[expected.size() - i - 1]);
+    }
+
+    // host iterators
+    bc::sort(data.begin(), data.end(), queue);
+    for(size_t i = 0; i < data.size(); i++){
+        BOOST_REQUIRE_EQUAL(float(data[i]), expected[i]);
+    }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
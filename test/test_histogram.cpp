@@ -0,0 +1,129 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://boostorg.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#define BOOST_TEST_MODULE TestHistogram
+#include <boost/test/unit_test.hpp>
+
+#include <vector>
+
+#include <boost/compute/system.hpp>
+#include <boost/compute/algorithm/copy.hpp>
+#include <boost/compute/algorithm/histogram.hpp>
+#include <boost/compute/algorithm/iota.hpp>
+#include <boost/compute/container/vector.hpp>
+
+#include "check_macros.hpp"
+#include "context_setup.hpp"
+
+namespace compute = boost::compute;
+
+BOOST_AUTO_TEST_CASE(histogram_even_int)
+{
+    int data[] = { 0, 5, 12, 99, 100, -1, 45, 47, 50, 9 };
+    compute::vector<int> input(data, data + 10, queue);
+
+//! [histogram_even]
+compute::vector<compute::uint_> counts(10, context);
+compute::histogram_even(
+    input.begin(), input.end(), 10, 0, 100, counts.begin(), queue
+);
+//! [histogram_even]
+
+    CHECK_RANGE_EQUAL(compute::uint_, 10, counts, (3, 1, 0, 0, 2, 1, 0, 0, 0, 1));
+}
+
+BOOST_AUTO_TEST_CASE(histogram_even_float)
+{
+    float data[] = { 0.0f, 0.49f, 0.5f, 0.99f, 1.0f, -0.1f, 0.25f, 0.75f };
+    compute::vector<float> input(data, data + 8, queue);
+
+    compute::vector<int> counts(4, context);
+    compute::histogram_even(
+        input.begin(), input.end(), 4, 0.0f, 1.0f, counts.begin(), queue
+    );
+    CHECK_RANGE_EQUAL(int, 4, counts, (1, 2, 1, 2));
+}
+
+BOOST_AUTO_TEST_CASE(histogram_even_empty)
+{
+    compute::vector<int> input(context);
+    compute::vector<compute::uint_> counts(3, context);
+    compute::histogram_even(
+        input.begin(), input.end(), 3, 0, 3, counts.begin(), queue
+    );
+    CHECK_RANGE_EQUAL(compute::uint_, 3, counts, (0, 0, 0));
+}
+
+BOOST_AUTO_TEST_CASE(histogram_range_float)
+{
+    float data[] = { 0.5f, 1.5f, 2.5f, 10.0f, 100.0f, -5.0f, 1.0f, 4.0f, 3.9f };
+    compute::vector<float> input(data, data + 9, queue);
+
+    float boundaries_data[] = { 0.0f, 1.0f, 4.0f, 10.0f };
+    compute::vector<float> boundaries(boundaries_data, boundaries_data + 4, queue);
+
+    compute::vector<compute::uint_> counts(3, context);
+    compute::histogram_range(
+        input.begin(), input.end(),
+        boundaries.begin(), boundaries.end(),
+        counts.begin(),
+        queue
+    );
+    CHECK_RANGE_EQUAL(compute::uint_, 3, counts, (1, 4, 1));
+}
+
+BOOST_AUTO_TEST_CASE(histogram_even_many_values)
+{
+    const size_t size = 100000;
+    compute::vector<compute::uint_> input(size, context);
+    compute::iota(input.begin(), input.end(), compute::uint_(0), queue);
+
+    compute::vector<compute::uint_> counts(100, context);
+    compute::histogram_even(
+        input.begin(), input.end(), 100,
+        compute::uint_(0), compute::uint_(size),
+        counts.begin(), queue
+    );
+
+    std::vector<compute::uint_> host_counts(100);
+    compute::copy(counts.begin(), counts.end(), host_counts.begin(), queue);
+    for(size_t i = 0; i < host_counts.size(); i++){
+        BOOST_CHECK_EQUAL(host_counts[i], compute::uint_(size / 100));
+    }
+}
+
+BOOST_AUTO_TEST_CASE(histogram_even_large_bin_count)
+{
+    // too many bins for local memory, uses the sort-based fallback
+    const compute::uint_ bins = 1 << 20;
+    const size_t size = 50000;
+
+    compute::vector<compute::uint_> input(size, context);
+    compute::iota(input.begin(), input.end(), compute::uint_(0), queue);
+
+    compute::vector<compute::uint_> counts(bins, context);
+    compute::histogram_even(
+        input.begin(), input.end(), bins,
+        compute::uint_(0), compute::uint_(2 * bins),
+        counts.begin(), queue
+    );
+
+    std::vector<compute::uint_> host_counts(bins);
+    compute::copy(counts.begin(), counts.end(), host_counts.begin(), queue);
+    for(size_t i = 0; i < bins; i++){
+        compute::uint_ expected = i < size / 2 ? 2 : 0;
+        if(host_counts[i] != expected){
+            BOOST_CHECK_EQUAL(host_counts[i], expected);
+            break;
+        }
+    }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,293 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://boostorg.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#define BOOST_TEST_MODULE TestHostBackend
+#include <boost/test/unit_test.hpp>
+
+// the host backend is opt-in
+#define BOOST_COMPUTE_USE_HOST_BACKEND
+
+#include <algorithm>
+#include <cstdlib>
+#include <functional>
+#include <limits>
+#include <numeric>
+#include <string>
+#include <vector>
+
+#include <boost/compute/system.hpp>
+#include <boost/compute/function.hpp>
+#include <boost/compute/algorithm/copy.hpp>
+#include <boost/compute/algorithm/find.hpp>
+#include <boost/compute/algorithm/reduce.hpp>
+#include <boost/compute/algorithm/sort.hpp>
+#include <boost/compute/algorithm/stable_sort.hpp>
+#include <boost/compute/algorithm/detail/host_backend.hpp>
+#include <boost/compute/container/vector.hpp>
+#include <boost/compute/detail/parameter_cache.hpp>
+
+#include "check_macros.hpp"
+#include "context_setup.hpp"
+
+namespace bc = boost::compute;
+
+// sets a crossover parameter and restores it when going out of scope
+class scoped_crossover
+{
+public:
+    scoped_crossover(const bc::device &device,
+                     const std::string &cache_key,
+                     const std::string &parameter,
+                     bc::uint_ value)
+        : m_parameters(bc::detail::parameter_cache::get_global_cache(device)),
+          m_cache_key(cache_key),
+          m_parameter(parameter)
+    {
+        m_value = m_parameters->get(m_cache_key, m_parameter, 0);
+        m_parameters->set(m_cache_key, m_parameter, value);
+    }
+
+    ~scoped_crossover()
+    {
+        m_parameters->set(m_cache_key, m_parameter, m_value);
+    }
+
+private:
+    boost::shared_ptr<bc::detail::parameter_cache> m_parameters;
+    std::string m_cache_key;
+    std::string m_parameter;
+    bc::uint_ m_value;
+};
+
+BOOST_AUTO_TEST_CASE(sort_small_device_range)
+{
+    using bc::int_;
+
+    std::vector<int_> data(100);
+    for(size_t i = 0; i < data.size(); i++){
+        data[i] = static_cast<int_>(std::rand() % 1000) - 500;
+    }
+    bc::vector<int_> vector(data.begin(), data.end(), queue);
+
+    // only the mapped part of the buffer is sorted
+    bc::sort(vector.begin() + 10, vector.begin() + 60, queue);
+    std::sort(data.begin() + 10, data.begin() + 60);
+
+    std::vector<int_> host(data.size());
+    bc::copy(vector.begin(), vector.end(), host.begin(), queue);
+    BOOST_CHECK(host == data);
+
+    bc::sort(vector.begin(), vector.end(), bc::greater<int_>(), queue);
+    std::sort(data.begin(), data.end(), std::greater<int_>());
+    bc::copy(vector.begin(), vector.end(), host.begin(), queue);
+    BOOST_CHECK(host == data);
+}
+
+BOOST_AUTO_TEST_CASE(sort_host_and_device_agree)
+{
+    using bc::float_;
+
+    std::vector<float_> data(3000);
+    for(size_t i = 0; i < data.size(); i++){
+        data[i] = static_cast<float_>(std::rand()) / RAND_MAX;
+    }
+    bc::vector<float_> on_host(data.begin(), data.end(), queue);
+    bc::vector<float_> on_device(data.begin(), data.end(), queue);
+
+    {
+        scoped_crossover crossover(
+            device, "__boost_sort_float", "mapped_host_crossover", 1 << 30
+        );
+        bc::sort(on_host.begin(), on_host.end(), queue);
+    }
+    {
+        scoped_crossover crossover(
+            device, "__boost_sort_float", "mapped_host_crossover", 0
+        );
+        bc::sort(on_device.begin(), on_device.end(), queue);
+    }
+
+    std::sort(data.begin(), data.end());
+    std::vector<float_> host(data.size());
+    bc::copy(on_host.begin(), on_host.end(), host.begin(), queue);
+    BOOST_CHECK(host == data);
+    bc::copy(on_device.begin(), on_device.end(), host.begin(), queue);
+    BOOST_CHECK(host == data);
+}
+
+BOOST_AUTO_TEST_CASE(stable_sort_host_iterators)
+{
+    using bc::int_;
+
+    int_ data[] = { 5, -1, 3, 3, 0, 9, -7, 2 };
+    std::vector<int_> vector(data, data + 8);
+
+    bc::stable_sort(vector.begin(), vector.end(), bc::greater<int_>(), queue);
+
+    int_ expected[] = { 9, 5, 3, 3, 2, 0, -1, -7 };
+    BOOST_CHECK(std::equal(vector.begin(), vector.end(), expected));
+}
+
+BOOST_AUTO_TEST_CASE(sort_custom_function_small)
+{
+    using bc::int_;
+
+    // has no host equivalent so it is always sorted on the device
+    BOOST_COMPUTE_FUNCTION(bool, abs_less, (int_ a, int_ b),
+    {
+        return abs(a) < abs(b);
+    });
+
+    int_ data[] = { 5, -1, 3, -4, 0, 9, -7, 2 };
+    bc::vector<int_> vector(data, data + 8, queue);
+    bc::sort(vector.begin(), vector.end(), abs_less, queue);
+    CHECK_RANGE_EQUAL(int_, 8, vector, (0, -1, 2, 3, -4, 5, -7, 9));
+}
+
+BOOST_AUTO_TEST_CASE(reduce_small)
+{
+    using bc::int_;
+
+    std::vector<int_> data(1000);
+    for(size_t i = 0; i < data.size(); i++){
+        data[i] = static_cast<int_>(i % 17) - 8;
+    }
+    const int_ expected = std::accumulate(data.begin(), data.end(), 0);
+    bc::vector<int_> vector(data.begin(), data.end(), queue);
+
+    // reduced to a host value
+    int_ sum = 0;
+    bc::reduce(vector.begin(), vector.end(), &sum, queue);
+    BOOST_CHECK_EQUAL(sum, expected);
+
+    // reduced to a device value
+    bc::vector<int_> result(1, context);
+    bc::reduce(vector.begin() + 1, vector.end(), result.begin(), queue);
+    BOOST_CHECK_EQUAL(result.begin().read(queue), expected - data[0]);
+
+    // host iterators
+    sum = 0;
+    bc::reduce(data.begin(), data.end(), &sum, bc::plus<int_>(), queue);
+    BOOST_CHECK_EQUAL(sum, expected);
+}
+
+BOOST_AUTO_TEST_CASE(reduce_host_and_device_agree)
+{
+    using bc::int_;
+
+    std::vector<int_> data(5000);
+    for(size_t i = 0; i < data.size(); i++){
+        data[i] = static_cast<int_>(std::rand() % 100);
+    }
+    const int_ expected = std::accumulate(data.begin(), data.end(), 0);
+    bc::vector<int_> vector(data.begin(), data.end(), queue);
+
+    int_ sum = 0;
+    {
+        scoped_crossover crossover(
+            device, "__boost_reduce_int", "mapped_host_crossover", 0
+        );
+        bc::reduce(vector.begin(), vector.end(), &sum, queue);
+    }
+    BOOST_CHECK_EQUAL(sum, expected);
+
+    sum = 0;
+    {
+        scoped_crossover crossover(
+            device, "__boost_reduce_int", "mapped_host_crossover", 1 << 30
+        );
+        bc::reduce(vector.begin(), vector.end(), &sum, queue);
+    }
+    BOOST_CHECK_EQUAL(sum, expected);
+}
+
+BOOST_AUTO_TEST_CASE(find_small)
+{
+    using bc::int_;
+
+    int_ data[] = { 4, 8, 15, 16, 23, 42, 15, 8 };
+    bc::vector<int_> vector(data, data + 8, queue);
+
+    bc::vector<int_>::iterator iter =
+        bc::find(vector.begin(), vector.end(), 15, queue);
+    BOOST_CHECK(iter == vector.begin() + 2);
+
+    iter = bc::find(vector.begin() + 3, vector.end(), 15, queue);
+    BOOST_CHECK(iter == vector.begin() + 6);
+
+    iter = bc::find(vector.begin(), vector.end(), 7, queue);
+    BOOST_CHECK(iter == vector.end());
+
+    iter = bc::find(vector.begin(), vector.begin(), 4, queue);
+    BOOST_CHECK(iter == vector.begin());
+}
+
+BOOST_AUTO_TEST_CASE(crossover_boundary)
+{
+    using bc::int_;
+
+    scoped_crossover crossover(
+        device, "__boost_sort_int", "mapped_host_crossover", 100
+    );
+    BOOST_CHECK(bc::detail::use_host_backend<int_>("sort", 99, true, queue));
+    BOOST_CHECK(!bc::detail::use_host_backend<int_>("sort", 100, true, queue));
+
+    // both sides of the crossover sort the same
+    for(size_t size = 99; size <= 100; size++){
+        std::vector<int_> data(size);
+        for(size_t i = 0; i < data.size(); i++){
+            data[i] = static_cast<int_>(std::rand() % 1000) - 500;
+        }
+        bc::vector<int_> vector(data.begin(), data.end(), queue);
+
+        bc::sort(vector.begin(), vector.end(), queue);
+        std::sort(data.begin(), data.end());
+
+        std::vector<int_> host(data.size());
+        bc::copy(vector.begin(), vector.end(), host.begin(), queue);
+        BOOST_CHECK(host == data);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(sort_nan_on_host)
+{
+    using bc::float_;
+
+    const float_ nan = std::numeric_limits<float_>::quiet_NaN();
+    const float_ inf = std::numeric_limits<float_>::infinity();
+
+    float_ data[] = { 3.0f, nan, -1.0f, inf, nan, -inf, 0.5f, nan, -2.0f };
+    bc::vector<float_> vector(data, data + 9, queue);
+
+    scoped_crossover crossover(
+        device, "__boost_sort_float", "mapped_host_crossover", 1 << 30
+    );
+
+    // nan values are ordered after +inf as by the radix sort
+    bc::sort(vector.begin(), vector.end(), queue);
+
+    std::vector<float_> host(9);
+    bc::copy(vector.begin(), vector.end(), host.begin(), queue);
+    float_ expected[] = { -inf, -2.0f, -1.0f, 0.5f, 3.0f, inf };
+    BOOST_CHECK(std::equal(expected, expected + 6, host.begin()));
+    for(size_t i = 6; i < 9; i++){
+        BOOST_CHECK(host[i] != host[i]);
+    }
+
+    // and before -inf in descending order
+    bc::sort(vector.begin(), vector.end(), bc::greater<float_>(), queue);
+    bc::copy(vector.begin(), vector.end(), host.begin(), queue);
+    for(size_t i = 0; i < 3; i++){
+        BOOST_CHECK(host[i] != host[i]);
+    }
+    BOOST_CHECK(std::equal(expected, expected + 6, host.rbegin()));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
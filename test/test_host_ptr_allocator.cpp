@@ -0,0 +1,232 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://boostorg.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#define BOOST_TEST_MODULE TestHostPtrAllocator
+#include <boost/test/unit_test.hpp>
+
+#include <algorithm>
+#include <list>
+#include <vector>
+
+#include <boost/compute/algorithm/copy.hpp>
+#include <boost/compute/algorithm/fill.hpp>
+#include <boost/compute/algorithm/reduce.hpp>
+#include <boost/compute/algorithm/sort.hpp>
+#include <boost/compute/algorithm/stable_sort.hpp>
+#include <boost/compute/algorithm/transform.hpp>
+#include <boost/compute/allocator/host_ptr_allocator.hpp>
+#include <boost/compute/container/vector.hpp>
+#include <boost/compute/functional/math.hpp>
+
+#include "check_macros.hpp"
+#include "context_setup.hpp"
+
+namespace compute = boost::compute;
+
+BOOST_AUTO_TEST_CASE(vector_with_host_ptr_allocator)
+{
+    compute::vector<int, compute::host_ptr_allocator<int> > vector(context);
+    vector.push_back(12, queue);
+    vector.push_back(24, queue);
+    vector.push_back(36, queue);
+    CHECK_RANGE_EQUAL(int, 3, vector, (12, 24, 36));
+}
+
+BOOST_AUTO_TEST_CASE(host_memory_is_page_aligned)
+{
+    compute::vector<float, compute::host_ptr_allocator<float> > vector(
+        100, context
+    );
+
+    void *host_ptr = vector.get_buffer().get_info<void *>(CL_MEM_HOST_PTR);
+    BOOST_CHECK(host_ptr != 0);
+    BOOST_CHECK_EQUAL(reinterpret_cast<size_t>(host_ptr) % 4096, size_t(0));
+}
+
+BOOST_AUTO_TEST_CASE(copy_to_and_from_aliased_host_memory)
+{
+    compute::vector<int, compute::host_ptr_allocator<int> > vector(
+        8, context
+    );
+
+    int *host_ptr = static_cast<int *>(
+        vector.get_buffer().get_info<void *>(CL_MEM_HOST_PTR)
+    );
+    for(int i = 0; i < 8; i++){
+        host_ptr[i] = i * 2;
+    }
+
+    // only synchronizes the buffer with its host memory
+    compute::copy(host_ptr, host_ptr + 8, vector.begin(), queue);
+    CHECK_RANGE_EQUAL(int, 8, vector, (0, 2, 4, 6, 8, 10, 12, 14));
+
+    compute::fill(vector.begin(), vector.end(), 7, queue);
+    compute::copy(vector.begin(), vector.end(), host_ptr, queue);
+    for(int i = 0; i < 8; i++){
+        BOOST_CHECK_EQUAL(host_ptr[i], 7);
+    }
+
+    // copy to an offset in the buffer
+    compute::copy(host_ptr + 2, host_ptr + 4, vector.begin() + 2, queue);
+    CHECK_RANGE_EQUAL(int, 8, vector, (7, 7, 7, 7, 7, 7, 7, 7));
+}
+
+BOOST_AUTO_TEST_CASE(copy_async_to_aliased_host_memory)
+{
+    compute::vector<int, compute::host_ptr_allocator<int> > vector(
+        4, context
+    );
+
+    int *host_ptr = static_cast<int *>(
+        vector.get_buffer().get_info<void *>(CL_MEM_HOST_PTR)
+    );
+    std::fill(host_ptr, host_ptr + 4, 3);
+
+    compute::future<compute::vector<int>::iterator> future =
+        compute::copy_async(host_ptr, host_ptr + 4, vector.begin(), queue);
+    BOOST_CHECK(future.get() == vector.end());
+    CHECK_RANGE_EQUAL(int, 4, vector, (3, 3, 3, 3));
+}
+
+BOOST_AUTO_TEST_CASE(sort_host_vector)
+{
+    int data[] = { 5, 2, 9, 1, 7, 3, 8, 0, 6, 4 };
+    std::vector<int> vector(data, data + 10);
+
+    compute::sort(vector.begin(), vector.end(), queue);
+    for(int i = 0; i < 10; i++){
+        BOOST_CHECK_EQUAL(vector[i], i);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(stable_sort_host_vector)
+{
+    int data[] = { 5, 2, 9, 1, 7, 3, 8, 0, 6, 4 };
+    std::vector<int> vector(data, data + 10);
+
+    compute::stable_sort(
+        vector.begin(), vector.end(), compute::greater<int>(), queue
+    );
+    for(int i = 0; i < 10; i++){
+        BOOST_CHECK_EQUAL(vector[i], 9 - i);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(transform_host_vector)
+{
+    float data[] = { 1.0f, -2.0f, 3.0f, -4.0f };
+    std::vector<float> input(data, data + 4);
+    std::vector<float> output(4);
+
+    std::vector<float>::iterator iter = compute::transform(
+        input.begin(), input.end(), output.begin(), compute::fabs<float>(), queue
+    );
+    BOOST_CHECK(iter == output.end());
+    BOOST_CHECK_EQUAL(output[0], 1.0f);
+    BOOST_CHECK_EQUAL(output[1], 2.0f);
+    BOOST_CHECK_EQUAL(output[2], 3.0f);
+    BOOST_CHECK_EQUAL(output[3], 4.0f);
+
+    // input is not modified
+    BOOST_CHECK_EQUAL(input[1], -2.0f);
+}
+
+BOOST_AUTO_TEST_CASE(transform_host_vector_in_place)
+{
+    int data[] = { 1, 2, 3, 4, 5 };
+    std::vector<int> vector(data, data + 5);
+
+    compute::transform(
+        vector.begin(), vector.end(), vector.begin(), vector.begin(),
+        compute::multiplies<int>(), queue
+    );
+    BOOST_CHECK_EQUAL(vector[0], 1);
+    BOOST_CHECK_EQUAL(vector[1], 4);
+    BOOST_CHECK_EQUAL(vector[2], 9);
+    BOOST_CHECK_EQUAL(vector[3], 16);
+    BOOST_CHECK_EQUAL(vector[4], 25);
+}
+
+BOOST_AUTO_TEST_CASE(transform_host_list_to_device)
+{
+    std::list<int> list;
+    list.push_back(-1);
+    list.push_back(2);
+    list.push_back(-3);
+
+    compute::vector<int> vector(3, context);
+    compute::transform(
+        list.begin(), list.end(), vector.begin(), compute::abs<int>(), queue
+    );
+    CHECK_RANGE_EQUAL(int, 3, vector, (1, 2, 3));
+}
+
+BOOST_AUTO_TEST_CASE(reduce_host_vector)
+{
+    std::vector<int> vector(1000);
+    for(size_t i = 0; i < vector.size(); i++){
+        vector[i] = static_cast<int>(i);
+    }
+
+    int sum = 0;
+    compute::reduce(vector.begin(), vector.end(), &sum, queue);
+    BOOST_CHECK_EQUAL(sum, 499500);
+
+    int max = 0;
+    compute::reduce(
+        vector.begin(), vector.end(), &max, compute::max<int>(), queue
+    );
+    BOOST_CHECK_EQUAL(max, 999);
+}
+
+BOOST_AUTO_TEST_CASE(transform_host_vector_to_device_then_free)
+{
+    compute::vector<int> vector(1000, context);
+    {
+        std::vector<int> input(1000);
+        for(size_t i = 0; i < input.size(); i++){
+            input[i] = -static_cast<int>(i);
+        }
+
+        compute::transform(
+            input.begin(), input.end(), vector.begin(), compute::abs<int>(), queue
+        );
+
+        // the device must be done with the host memory once transform()
+        // returns even though the output is on the device
+        std::fill(input.begin(), input.end(), 7);
+    }
+
+    std::vector<int> host(vector.size());
+    compute::copy(vector.begin(), vector.end(), host.begin(), queue);
+    for(size_t i = 0; i < host.size(); i++){
+        BOOST_REQUIRE_EQUAL(host[i], static_cast<int>(i));
+    }
+}
+
+BOOST_AUTO_TEST_CASE(reduce_host_vector_to_device_then_free)
+{
+    compute::vector<int> sum(1, context);
+    {
+        std::vector<int> input(1000);
+        for(size_t i = 0; i < input.size(); i++){
+            input[i] = static_cast<int>(i);
+        }
+
+        compute::reduce(input.begin(), input.end(), sum.begin(), queue);
+
+        // the input may be changed as soon as reduce() returns
+        std::fill(input.begin(), input.end(), 0);
+    }
+
+    BOOST_CHECK_EQUAL(int(sum[0]), 499500);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,170 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://boostorg.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#define BOOST_TEST_MODULE TestLiteralHoisting
+#include <boost/test/unit_test.hpp>
+
+#include <boost/compute/system.hpp>
+#include <boost/compute/algorithm/copy.hpp>
+#include <boost/compute/algorithm/count_if.hpp>
+#include <boost/compute/algorithm/transform.hpp>
+#include <boost/compute/container/vector.hpp>
+#include <boost/compute/functional/bind.hpp>
+#include <boost/compute/functional/operator.hpp>
+#include <boost/compute/iterator/constant_iterator.hpp>
+#include <boost/compute/lambda.hpp>
+#include <boost/compute/random/default_random_engine.hpp>
+#include <boost/compute/random/uniform_int_distribution.hpp>
+#include <boost/compute/utility/program_cache.hpp>
+
+#include "check_macros.hpp"
+#include "context_setup.hpp"
+
+namespace compute = boost::compute;
+
+// with literal hoisting enabled, constant values end up as kernel arguments
+// and the number of programs in the cache stays the same no matter how many
+// different values are used
+
+#ifndef BOOST_COMPUTE_NO_LITERAL_HOISTING
+BOOST_AUTO_TEST_CASE(hoist_lambda_literals)
+{
+    using compute::lambda::_1;
+
+    int data[] = { 1, 2, 3, 4 };
+    compute::vector<int> input(data, data + 4, queue);
+    compute::vector<int> output(4, context);
+
+    boost::shared_ptr<compute::program_cache> cache =
+        compute::program_cache::get_global_cache(context);
+    cache->clear();
+
+    compute::transform(
+        input.begin(), input.end(), output.begin(), _1 * 0 + 1, queue
+    );
+    CHECK_RANGE_EQUAL(int, 4, output, (1, 1, 1, 1));
+    const size_t programs = cache->size();
+
+    for(int i = 1; i < 1000; i++){
+        compute::transform(
+            input.begin(), input.end(), output.begin(), _1 * i + 1, queue
+        );
+    }
+    CHECK_RANGE_EQUAL(int, 4, output, (1000, 1999, 2998, 3997));
+    BOOST_CHECK_EQUAL(cache->size(), programs);
+
+    // typed literals
+    compute::vector<compute::uint_> uints(4, context);
+    compute::transform(
+        input.begin(), input.end(), uints.begin(), _1 + compute::uint_(0), queue
+    );
+    const size_t uint_programs = cache->size();
+    for(compute::uint_ i = 1; i < 1000; i++){
+        compute::transform(
+            input.begin(), input.end(), uints.begin(), _1 + i, queue
+        );
+    }
+    CHECK_RANGE_EQUAL(compute::uint_, 4, uints, (1000, 1001, 1002, 1003));
+    BOOST_CHECK_EQUAL(cache->size(), uint_programs);
+}
+
+BOOST_AUTO_TEST_CASE(hoist_constant_iterator_value)
+{
+    compute::vector<float> output(4, context);
+
+    boost::shared_ptr<compute::program_cache> cache =
+        compute::program_cache::get_global_cache(context);
+    cache->clear();
+
+    compute::copy(
+        compute::make_constant_iterator(0.0f, 0),
+        compute::make_constant_iterator(0.0f, 4),
+        output.begin(),
+        queue
+    );
+    const size_t programs = cache->size();
+
+    for(int i = 1; i < 1000; i++){
+        compute::copy(
+            compute::make_constant_iterator(i * 0.5f, 0),
+            compute::make_constant_iterator(i * 0.5f, 4),
+            output.begin(),
+            queue
+        );
+    }
+    CHECK_RANGE_EQUAL(float, 4, output, (499.5f, 499.5f, 499.5f, 499.5f));
+    BOOST_CHECK_EQUAL(cache->size(), programs);
+}
+
+BOOST_AUTO_TEST_CASE(hoist_bound_arguments)
+{
+    using compute::placeholders::_1;
+
+    int data[] = { 1, 2, 3, 4, 5, 6, 7, 8 };
+    compute::vector<int> input(data, data + 8, queue);
+
+    boost::shared_ptr<compute::program_cache> cache =
+        compute::program_cache::get_global_cache(context);
+    cache->clear();
+
+    BOOST_CHECK_EQUAL(
+        compute::count_if(input.begin(), input.end(),
+                          compute::bind(compute::less<int>(), _1, 0), queue),
+        size_t(0)
+    );
+    const size_t programs = cache->size();
+
+    for(int i = 1; i < 1000; i++){
+        size_t expected = static_cast<size_t>((std::min)(i - 1, 8));
+        size_t count = compute::count_if(
+            input.begin(), input.end(),
+            compute::bind(compute::less<int>(), _1, i), queue
+        );
+        if(count != expected){
+            BOOST_CHECK_EQUAL(count, expected);
+            break;
+        }
+    }
+    BOOST_CHECK_EQUAL(cache->size(), programs);
+}
+
+BOOST_AUTO_TEST_CASE(hoist_uniform_int_distribution_bounds)
+{
+    using compute::lambda::_1;
+
+    compute::vector<compute::uint_> vec(64, context);
+    compute::default_random_engine engine(queue);
+
+    boost::shared_ptr<compute::program_cache> cache =
+        compute::program_cache::get_global_cache(context);
+    cache->clear();
+
+    size_t programs = 0;
+    for(compute::uint_ i = 1; i < 100; i++){
+        compute::uniform_int_distribution<compute::uint_> distribution(i, 2 * i);
+        distribution.generate(vec.begin(), vec.end(), engine, queue);
+
+        size_t out_of_range = compute::count_if(
+            vec.begin(), vec.end(), _1 < i || _1 > 2 * i, queue
+        );
+        if(out_of_range != 0){
+            BOOST_CHECK_EQUAL(out_of_range, size_t(0));
+            break;
+        }
+
+        if(i == 1){
+            programs = cache->size();
+        }
+    }
+    BOOST_CHECK_EQUAL(cache->size(), programs);
+}
+#endif // BOOST_COMPUTE_NO_LITERAL_HOISTING
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,321 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://boostorg.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#define BOOST_TEST_MODULE TestMultiQueue
+#include <boost/test/unit_test.hpp>
+
+#include <algorithm>
+#include <cstdlib>
+#include <functional>
+#include <iostream>
+#include <numeric>
+#include <vector>
+
+#include <boost/compute/system.hpp>
+#include <boost/compute/multi_queue.hpp>
+#include <boost/compute/algorithm/copy.hpp>
+#include <boost/compute/algorithm/copy_if.hpp>
+#include <boost/compute/algorithm/fill.hpp>
+#include <boost/compute/algorithm/reduce.hpp>
+#include <boost/compute/algorithm/sort.hpp>
+#include <boost/compute/algorithm/transform.hpp>
+#include <boost/compute/container/vector.hpp>
+#include <boost/compute/lambda.hpp>
+
+#include "check_macros.hpp"
+#include "context_setup.hpp"
+
+namespace compute = boost::compute;
+
+// returns a multi_queue with count queues for device
+static compute::multi_queue make_queues(const compute::context &context,
+                                        const compute::device &device,
+                                        size_t count)
+{
+    std::vector<compute::command_queue> queues;
+    for(size_t i = 0; i < count; i++){
+        queues.push_back(
+            compute::command_queue(
+                context, device, compute::command_queue::enable_profiling
+            )
+        );
+    }
+
+    return compute::multi_queue(queues);
+}
+
+static std::vector<int> random_ints(size_t count)
+{
+    std::vector<int> values(count);
+    for(size_t i = 0; i < count; i++){
+        values[i] = std::rand() % 1000 - 500;
+    }
+
+    return values;
+}
+
+BOOST_AUTO_TEST_CASE(partition)
+{
+    compute::multi_queue queues = make_queues(context, device, 3);
+    BOOST_CHECK_EQUAL(queues.size(), size_t(3));
+    BOOST_CHECK(queues.get_context() == context);
+
+    std::vector<double> weights;
+    weights.push_back(1.0);
+    weights.push_back(2.0);
+    weights.push_back(1.0);
+    queues.set_weights(weights);
+
+    std::vector<size_t> offsets = queues.partition(100);
+    BOOST_CHECK_EQUAL(offsets.size(), size_t(4));
+    BOOST_CHECK_EQUAL(offsets[0], size_t(0));
+    BOOST_CHECK_EQUAL(offsets[1], size_t(25));
+    BOOST_CHECK_EQUAL(offsets[2], size_t(75));
+    BOOST_CHECK_EQUAL(offsets[3], size_t(100));
+
+    offsets = queues.partition(0);
+    BOOST_CHECK_EQUAL(offsets[3], size_t(0));
+
+    // invalid weights
+    BOOST_CHECK_THROW(
+        queues.set_weights(std::vector<double>(2, 1.0)), compute::opencl_error
+    );
+    BOOST_CHECK_THROW(
+        queues.set_weights(std::vector<double>(3, 0.0)), compute::opencl_error
+    );
+}
+
+BOOST_AUTO_TEST_CASE(update_weights)
+{
+    compute::multi_queue queues = make_queues(context, device, 2);
+    queues.set_weights(std::vector<double>(2, 1.0));
+
+    // the second queue processed the same number of elements in a third of
+    // the time so its weight moves towards three times the first
+    std::vector<size_t> counts(2, 1000);
+    std::vector<double> times;
+    times.push_back(300.0);
+    times.push_back(100.0);
+    queues.update_weights(counts, times);
+
+    BOOST_CHECK_CLOSE(queues.get_weight(0) + queues.get_weight(1), 2.0, 1e-6);
+    BOOST_CHECK_CLOSE(queues.get_weight(0), 0.75, 1e-6);
+    BOOST_CHECK_CLOSE(queues.get_weight(1), 1.25, 1e-6);
+}
+
+BOOST_AUTO_TEST_CASE(transform)
+{
+    using compute::lambda::_1;
+    using compute::lambda::_2;
+
+    compute::multi_queue queues = make_queues(context, device, 3);
+
+    std::vector<int> host = random_ints(1000);
+    compute::vector<int> input(host.begin(), host.end(), queue);
+    compute::vector<int> output(host.size(), context);
+    queue.finish();
+
+    compute::vector<int>::iterator end = compute::transform(
+        input.begin(), input.end(), output.begin(), _1 * 2 + 1, queues
+    );
+    BOOST_CHECK(end == output.end());
+
+    std::vector<int> result(host.size());
+    compute::copy(output.begin(), output.end(), result.begin(), queue);
+    for(size_t i = 0; i < host.size(); i++){
+        BOOST_CHECK_EQUAL(result[i], host[i] * 2 + 1);
+    }
+
+    // binary transform
+    compute::transform(
+        input.begin(), input.end(), output.begin(), output.begin(), _1 - _2, queues
+    );
+    compute::copy(output.begin(), output.end(), result.begin(), queue);
+    for(size_t i = 0; i < host.size(); i++){
+        BOOST_CHECK_EQUAL(result[i], -host[i] - 1);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(transform_to_offset_output)
+{
+    using compute::lambda::_1;
+
+    compute::multi_queue queues = make_queues(context, device, 3);
+
+    // the parts written by each device are copied behind the offset
+    std::vector<int> host = random_ints(1000);
+    compute::vector<int> input(host.begin(), host.end(), queue);
+    compute::vector<int> output(host.size() + 10, context);
+    compute::fill(output.begin(), output.end(), -1, queue);
+    queue.finish();
+
+    compute::vector<int>::iterator end = compute::transform(
+        input.begin(), input.end(), output.begin() + 5, _1 * 3, queues
+    );
+    BOOST_CHECK(end == output.end() - 5);
+
+    std::vector<int> result(output.size());
+    compute::copy(output.begin(), output.end(), result.begin(), queue);
+    for(size_t i = 0; i < 5; i++){
+        BOOST_CHECK_EQUAL(result[i], -1);
+        BOOST_CHECK_EQUAL(result[result.size() - 1 - i], -1);
+    }
+    for(size_t i = 0; i < host.size(); i++){
+        BOOST_CHECK_EQUAL(result[i + 5], host[i] * 3);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(reduce)
+{
+    compute::multi_queue queues = make_queues(context, device, 3);
+
+    std::vector<int> host = random_ints(1234);
+    compute::vector<int> vec(host.begin(), host.end(), queue);
+    queue.finish();
+
+    int sum = 0;
+    compute::reduce(vec.begin(), vec.end(), &sum, queues);
+    BOOST_CHECK_EQUAL(sum, std::accumulate(host.begin(), host.end(), 0));
+
+    int max = 0;
+    compute::reduce(vec.begin(), vec.end(), &max, compute::max<int>(), queues);
+    BOOST_CHECK_EQUAL(max, *std::max_element(host.begin(), host.end()));
+
+    // result on the device
+    compute::vector<int> result(1, context);
+    compute::reduce(vec.begin(), vec.begin() + 2, result.begin(), queues);
+    BOOST_CHECK_EQUAL(int(result[0]), host[0] + host[1]);
+}
+
+BOOST_AUTO_TEST_CASE(sort)
+{
+    compute::multi_queue queues = make_queues(context, device, 3);
+
+    // uneven weights so that the parts and merges have different sizes
+    std::vector<double> weights;
+    weights.push_back(1.0);
+    weights.push_back(3.0);
+    weights.push_back(2.0);
+    queues.set_weights(weights);
+    queues.set_load_balancing(false);
+
+    std::vector<int> host = random_ints(3000);
+    compute::vector<int> vec(host.begin(), host.end(), queue);
+    queue.finish();
+
+    compute::sort(vec.begin(), vec.end(), queues);
+    BOOST_CHECK(queues.get_weights() == weights);
+
+    std::sort(host.begin(), host.end());
+    std::vector<int> result(host.size());
+    compute::copy(vec.begin(), vec.end(), result.begin(), queue);
+    BOOST_CHECK(result == host);
+
+    // descending order
+    compute::sort(vec.begin(), vec.end(), compute::greater<int>(), queues);
+    std::reverse(host.begin(), host.end());
+    compute::copy(vec.begin(), vec.end(), result.begin(), queue);
+    BOOST_CHECK(result == host);
+}
+
+BOOST_AUTO_TEST_CASE(sort_with_empty_parts)
+{
+    compute::multi_queue queues = make_queues(context, device, 4);
+
+    int data[] = { 5, 3, 1, 4, 2 };
+    compute::vector<int> vec(data, data + 5, queue);
+    queue.finish();
+
+    compute::sort(vec.begin(), vec.end(), queues);
+    CHECK_RANGE_EQUAL(int, 5, vec, (1, 2, 3, 4, 5));
+
+    // fewer elements than queues
+    compute::sort(vec.begin(), vec.begin() + 2, compute::greater<int>(), queues);
+    CHECK_RANGE_EQUAL(int, 5, vec, (2, 1, 3, 4, 5));
+}
+
+BOOST_AUTO_TEST_CASE(copy_if)
+{
+    using compute::lambda::_1;
+
+    compute::multi_queue queues = make_queues(context, device, 3);
+
+    std::vector<int> host = random_ints(2000);
+    compute::vector<int> input(host.begin(), host.end(), queue);
+    compute::vector<int> output(host.size(), context);
+    queue.finish();
+
+    compute::vector<int>::iterator end = compute::copy_if(
+        input.begin(), input.end(), output.begin(), _1 > 100, queues
+    );
+
+    std::vector<int> expected;
+    for(size_t i = 0; i < host.size(); i++){
+        if(host[i] > 100){
+            expected.push_back(host[i]);
+        }
+    }
+
+    BOOST_CHECK_EQUAL(size_t(end - output.begin()), expected.size());
+    std::vector<int> result(expected.size());
+    compute::copy(output.begin(), end, result.begin(), queue);
+    BOOST_CHECK(result == expected);
+}
+
+#ifdef BOOST_COMPUTE_CL_VERSION_1_2
+BOOST_AUTO_TEST_CASE(sub_devices)
+{
+    REQUIRES_OPENCL_VERSION(1,2);
+
+    if(device.compute_units() < 2){
+        std::cout << "skipping test: "
+                  << "device does not have enough compute units"
+                  << std::endl;
+        return;
+    }
+
+    const std::vector<cl_device_partition_property> properties =
+        device.get_info<std::vector<cl_device_partition_property> >(
+            CL_DEVICE_PARTITION_PROPERTIES
+        );
+    if(std::find(properties.begin(), properties.end(),
+                 CL_DEVICE_PARTITION_EQUALLY) == properties.end()){
+        std::cout << "skipping test: "
+                  << "device does not support CL_DEVICE_PARTITION_EQUALLY"
+                  << std::endl;
+        return;
+    }
+
+    // split the device into two sub-devices
+    std::vector<compute::device> sub_devices =
+        device.partition_equally((device.compute_units() + 1) / 2);
+    compute::context sub_context(sub_devices);
+    compute::multi_queue queues(sub_context);
+    BOOST_CHECK_EQUAL(queues.size(), sub_devices.size());
+
+    std::vector<int> host = random_ints(5000);
+    compute::vector<int> vec(host.begin(), host.end(), queues.get_queue(0));
+    queues.finish();
+
+    compute::sort(vec.begin(), vec.end(), queues);
+    compute::sort(vec.begin(), vec.end(), queues);
+
+    std::sort(host.begin(), host.end());
+    std::vector<int> result(host.size());
+    compute::copy(vec.begin(), vec.end(), result.begin(), queues.get_queue(0));
+    BOOST_CHECK(result == host);
+
+    for(size_t i = 0; i < queues.size(); i++){
+        BOOST_CHECK_GT(queues.get_weight(i), 0.0);
+    }
+}
+#endif // BOOST_COMPUTE_CL_VERSION_1_2
+
+BOOST_AUTO_TEST_SUITE_END()
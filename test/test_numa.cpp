@@ -0,0 +1,132 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://boostorg.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#define BOOST_TEST_MODULE TestNuma
+#include <boost/test/unit_test.hpp>
+
+#include <algorithm>
+#include <numeric>
+#include <vector>
+
+#include <boost/compute/system.hpp>
+#include <boost/compute/algorithm/copy.hpp>
+#include <boost/compute/algorithm/iota.hpp>
+#include <boost/compute/algorithm/reduce.hpp>
+#include <boost/compute/algorithm/transform.hpp>
+#include <boost/compute/container/vector.hpp>
+#include <boost/compute/lambda.hpp>
+#include <boost/compute/utility/numa.hpp>
+
+#include "check_macros.hpp"
+#include "context_setup.hpp"
+
+namespace compute = boost::compute;
+
+BOOST_AUTO_TEST_CASE(partition_by_numa_node)
+{
+    std::vector<compute::device> nodes = compute::partition_by_numa_node(device);
+    BOOST_REQUIRE(!nodes.empty());
+
+    if(nodes.size() == 1){
+        // not partitioned
+        BOOST_CHECK(nodes[0] == device);
+    }
+    else {
+        size_t compute_units = 0;
+        for(size_t i = 0; i < nodes.size(); i++){
+            BOOST_CHECK(nodes[i] != device);
+            compute_units += nodes[i].compute_units();
+        }
+        BOOST_CHECK_LE(compute_units, size_t(device.compute_units()));
+    }
+}
+
+BOOST_AUTO_TEST_CASE(make_numa_queues)
+{
+    std::vector<compute::device> nodes = compute::partition_by_numa_node(device);
+
+    compute::multi_queue queues = compute::make_numa_queues(device);
+    BOOST_CHECK_EQUAL(queues.size(), nodes.size());
+    BOOST_CHECK(!queues.load_balancing());
+    for(size_t i = 0; i < queues.size(); i++){
+        BOOST_CHECK(queues.can_measure(i));
+    }
+}
+
+BOOST_AUTO_TEST_CASE(first_touch)
+{
+    compute::multi_queue queues = compute::make_numa_queues(device);
+
+    // the buffers are in the context of the sub-devices
+    compute::command_queue &queue = queues.get_queue(0);
+
+    compute::vector<int> vec(10, queues.get_context());
+    compute::first_touch(vec.begin(), vec.end(), 7, queues);
+    CHECK_RANGE_EQUAL(int, 10, vec, (7, 7, 7, 7, 7, 7, 7, 7, 7, 7));
+
+    compute::first_touch(vec.begin() + 2, vec.begin() + 5, queues);
+    CHECK_RANGE_EQUAL(int, 10, vec, (7, 7, 0, 0, 0, 7, 7, 7, 7, 7));
+
+    // empty range
+    compute::first_touch(vec.begin(), vec.begin(), 1, queues);
+    CHECK_RANGE_EQUAL(int, 10, vec, (7, 7, 0, 0, 0, 7, 7, 7, 7, 7));
+}
+
+BOOST_AUTO_TEST_CASE(first_touch_unaligned)
+{
+    compute::multi_queue queues = compute::make_numa_queues(device);
+    compute::command_queue &queue = queues.get_queue(0);
+
+    // the parts start at aligned elements, the elements before the first
+    // aligned one are written separately
+    std::vector<int> host(1000, 1);
+    compute::vector<int> vec(host.begin(), host.end(), queue);
+    queue.finish();
+
+    compute::first_touch(vec.begin() + 3, vec.end() - 3, 5, queues);
+
+    std::fill(host.begin() + 3, host.end() - 3, 5);
+    std::vector<int> result(host.size());
+    compute::copy(vec.begin(), vec.end(), result.begin(), queue);
+    BOOST_CHECK(result == host);
+}
+
+BOOST_AUTO_TEST_CASE(transform_reduce)
+{
+    using compute::lambda::_1;
+
+    compute::multi_queue queues = compute::make_numa_queues(device);
+    compute::command_queue &queue = queues.get_queue(0);
+
+    const size_t n = 10000;
+    compute::vector<int> input(n, queues.get_context());
+    compute::vector<int> output(n, queues.get_context());
+    compute::first_touch(input.begin(), input.end(), queues);
+    compute::first_touch(output.begin(), output.end(), queues);
+
+    compute::iota(input.begin(), input.end(), 0, queue);
+    queue.finish();
+
+    compute::transform(
+        input.begin(), input.end(), output.begin(), _1 * 2, queues
+    );
+
+    int sum = 0;
+    compute::reduce(output.begin(), output.end(), &sum, queues);
+    BOOST_CHECK_EQUAL(sum, int(n * (n - 1)));
+
+    // the weights are not changed by the algorithms
+    std::vector<double> weights = queues.get_weights();
+    compute::reduce(input.begin(), input.end(), &sum, queues);
+    BOOST_CHECK_EQUAL(sum, int(n * (n - 1) / 2));
+    BOOST_CHECK(queues.get_weights() == weights);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -11,13 +11,17 @@
 #define BOOST_TEST_MODULE TestPartition
 #include <boost/test/unit_test.hpp>
 
+#include <vector>
+
 #include <boost/compute/system.hpp>
 #include <boost/compute/functional.hpp>
 #include <boost/compute/command_queue.hpp>
+#include <boost/compute/algorithm/copy.hpp>
 #include <boost/compute/algorithm/partition.hpp>
 #include <boost/compute/algorithm/partition_copy.hpp>
 #include <boost/compute/algorithm/is_partitioned.hpp>
 #include <boost/compute/container/vector.hpp>
+#include <boost/compute/lambda.hpp>
 
 #include "check_macros.hpp"
 #include "context_setup.hpp"
@@ -79,4 +83,71 @@ BOOST_AUTO_TEST_CASE(partition_small_vector)
     CHECK_RANGE_EQUAL(float, 2, vector, (-1.0f, 1.0f));
 }
 
+BOOST_AUTO_TEST_CASE(partition_copy_int)
+{
+    int data[] = { 1, 6, 3, 5, 8, 2, 4 };
+    bc::vector<int> input(data, data + 7, queue);
+    bc::vector<int> output_true(7, context);
+    bc::vector<int> output_false(7, context);
+
+    std::pair<bc::vector<int>::iterator, bc::vector<int>::iterator> ends =
+        bc::partition_copy(input.begin(),
+                           input.end(),
+                           output_true.begin(),
+                           output_false.begin(),
+                           bc::_1 % 2 == 0,
+                           queue);
+    BOOST_CHECK(ends.first == output_true.begin() + 4);
+    BOOST_CHECK(ends.second == output_false.begin() + 3);
+    CHECK_RANGE_EQUAL(int, 4, output_true, (6, 8, 2, 4));
+    CHECK_RANGE_EQUAL(int, 3, output_false, (1, 3, 5));
+}
+
+BOOST_AUTO_TEST_CASE(partition_copy_large)
+{
+    // not a multiple of the number of values flagged by each work-item
+    std::vector<int> host(5003);
+    for(size_t i = 0; i < host.size(); i++){
+        host[i] = int((i * 31) % 17);
+    }
+    bc::vector<int> input(host.begin(), host.end(), queue);
+    bc::vector<int> output_true(host.size(), context);
+    bc::vector<int> output_false(host.size(), context);
+
+    std::vector<int> expected_true;
+    std::vector<int> expected_false;
+    for(size_t i = 0; i < host.size(); i++){
+        if(host[i] < 5){
+            expected_true.push_back(host[i]);
+        }
+        else {
+            expected_false.push_back(host[i]);
+        }
+    }
+
+    std::pair<bc::vector<int>::iterator, bc::vector<int>::iterator> ends =
+        bc::partition_copy(input.begin(),
+                           input.end(),
+                           output_true.begin(),
+                           output_false.begin(),
+                           bc::_1 < 5,
+                           queue);
+    BOOST_CHECK_EQUAL(
+        std::distance(output_true.begin(), ends.first),
+        std::ptrdiff_t(expected_true.size())
+    );
+    BOOST_CHECK_EQUAL(
+        std::distance(output_false.begin(), ends.second),
+        std::ptrdiff_t(expected_false.size())
+    );
+
+    std::vector<int> result_true(expected_true.size());
+    bc::copy(output_true.begin(), ends.first, result_true.begin(), queue);
+    BOOST_CHECK(result_true == expected_true);
+
+    std::vector<int> result_false(expected_false.size());
+    bc::copy(output_false.begin(), ends.second, result_false.begin(), queue);
+    BOOST_CHECK(result_false == expected_false);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
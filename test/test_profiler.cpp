@@ -0,0 +1,266 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://boostorg.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#define BOOST_TEST_MODULE TestProfiler
+#include <boost/test/unit_test.hpp>
+
+#include <sstream>
+#include <string>
+#include <vector>
+
+#ifdef BOOST_COMPUTE_USE_CPP11
+#include <future>
+#include <thread>
+#endif // BOOST_COMPUTE_USE_CPP11
+
+#include <boost/compute/system.hpp>
+#include <boost/compute/algorithm/copy.hpp>
+#include <boost/compute/algorithm/fill.hpp>
+#include <boost/compute/algorithm/reduce.hpp>
+#include <boost/compute/algorithm/sort.hpp>
+#include <boost/compute/algorithm/transform.hpp>
+#include <boost/compute/container/vector.hpp>
+#include <boost/compute/lambda.hpp>
+#include <boost/compute/utility/profiler.hpp>
+
+#include "context_setup.hpp"
+
+namespace compute = boost::compute;
+
+typedef compute::profiler::record record;
+
+static size_t count_records(const std::vector<record> &records,
+                            record::kind_type kind)
+{
+    size_t count = 0;
+    for(size_t i = 0; i < records.size(); i++){
+        if(records[i].kind == kind){
+            count++;
+        }
+    }
+    return count;
+}
+
+BOOST_AUTO_TEST_CASE(record_algorithm)
+{
+    using compute::lambda::_1;
+
+    compute::command_queue profiled_queue(
+        context, device, compute::command_queue::enable_profiling
+    );
+
+    int data[] = { 5, 1, 4, 2, 3, 8, 7, 6 };
+
+    compute::profiler profiler;
+    profiler.start();
+    BOOST_CHECK(profiler.is_running());
+
+    compute::vector<int> vec(data, data + 8, profiled_queue);
+    compute::transform(vec.begin(), vec.end(), vec.begin(), _1 * 2, profiled_queue);
+    profiled_queue.finish();
+
+    profiler.stop();
+    BOOST_CHECK(!profiler.is_running());
+
+    // not recorded
+    compute::fill(vec.begin(), vec.end(), 0, profiled_queue);
+    profiled_queue.finish();
+
+    const std::vector<record> &records = profiler.records();
+    BOOST_CHECK_EQUAL(count_records(records, record::allocation), size_t(1));
+    BOOST_CHECK_EQUAL(count_records(records, record::write), size_t(1));
+    BOOST_CHECK_EQUAL(count_records(records, record::fill), size_t(0));
+    BOOST_CHECK_GE(count_records(records, record::kernel), size_t(1));
+
+    bool found_transform = false;
+    for(size_t i = 0; i < records.size(); i++){
+        const record &r = records[i];
+
+        if(r.kind == record::algorithm && r.name == "transform"){
+            found_transform = true;
+            BOOST_CHECK(r.region.empty());
+            BOOST_CHECK_GE(r.host_end, r.host_start);
+        }
+        else if(r.kind == record::write){
+            BOOST_CHECK_EQUAL(r.bytes, 8 * sizeof(int));
+            BOOST_CHECK(r.profiled);
+        }
+        else if(r.kind == record::kernel){
+            // transform is implemented with copy()
+            BOOST_CHECK_EQUAL(r.region.substr(0, 9), std::string("transform"));
+            BOOST_CHECK(r.queue == profiled_queue.get());
+            BOOST_CHECK_EQUAL(r.work_dim, size_t(1));
+            // small copies run as a single work-item on cpu devices
+            BOOST_CHECK_GE(r.global_work_size[0], size_t(1));
+            BOOST_CHECK(r.profiled);
+            BOOST_CHECK_GE(r.device_end, r.device_start);
+        }
+    }
+    BOOST_CHECK(found_transform);
+}
+
+BOOST_AUTO_TEST_CASE(record_binary_transform)
+{
+    int data[] = { 5, 1, 4, 2, 3, 8, 7, 6 };
+    compute::vector<int> vec(data, data + 8, queue);
+
+    compute::profiler profiler;
+    profiler.start();
+    compute::transform(
+        vec.begin(), vec.end(), vec.begin(), vec.begin(), compute::plus<int>(), queue
+    );
+    queue.finish();
+    profiler.stop();
+
+    bool found_transform = false;
+    const std::vector<record> &records = profiler.records();
+    for(size_t i = 0; i < records.size(); i++){
+        if(records[i].kind == record::algorithm && records[i].name == "transform"){
+            found_transform = true;
+        }
+        else if(records[i].kind == record::kernel){
+            BOOST_CHECK_EQUAL(records[i].region.substr(0, 9), std::string("transform"));
+        }
+    }
+    BOOST_CHECK(found_transform);
+    BOOST_CHECK_GE(count_records(records, record::kernel), size_t(1));
+}
+
+#ifdef BOOST_COMPUTE_USE_CPP11
+BOOST_AUTO_TEST_CASE(profilers_on_other_threads)
+{
+    using compute::lambda::_1;
+
+    compute::vector<int> vec(8, context);
+    compute::fill(vec.begin(), vec.end(), 1, queue);
+
+    compute::profiler profiler;
+    profiler.start();
+
+    // the other thread profiles while this thread runs transform()
+    std::promise<void> started;
+    std::promise<void> done;
+    std::future<void> done_future = done.get_future();
+    size_t other_records = 0;
+    std::thread thread([&](){
+        compute::profiler other_profiler;
+        other_profiler.start();
+        started.set_value();
+        done_future.wait();
+        other_profiler.stop();
+        other_records = other_profiler.records().size();
+    });
+
+    started.get_future().wait();
+    compute::transform(vec.begin(), vec.end(), vec.begin(), _1 + 1, queue);
+    queue.finish();
+    done.set_value();
+    thread.join();
+
+    profiler.stop();
+
+    BOOST_CHECK_EQUAL(other_records, size_t(0));
+    BOOST_CHECK_GE(count_records(profiler.records(), record::algorithm), size_t(1));
+}
+#endif // BOOST_COMPUTE_USE_CPP11
+
+BOOST_AUTO_TEST_CASE(record_program_cache)
+{
+    compute::vector<float> vec(64, context);
+    compute::fill(vec.begin(), vec.end(), 1.5f, queue);
+
+    compute::profiler profiler;
+    profiler.start();
+
+    // a new program is built for the first reduction and found in the cache
+    // for the second
+    compute::vector<float> result(1, context);
+    compute::reduce(vec.begin(), vec.end(), result.begin(), compute::max<float>(), queue);
+    compute::reduce(vec.begin(), vec.end(), result.begin(), compute::max<float>(), queue);
+    queue.finish();
+
+    profiler.stop();
+
+    const std::vector<record> &records = profiler.records();
+    BOOST_CHECK_GE(count_records(records, record::build), size_t(1));
+    BOOST_CHECK_GE(count_records(records, record::cache_hit), size_t(1));
+
+    size_t calls = 0;
+    for(size_t i = 0; i < records.size(); i++){
+        if(records[i].kind == record::algorithm && records[i].region.empty()){
+            BOOST_CHECK_EQUAL(records[i].name, std::string("reduce"));
+            calls++;
+        }
+        else if(records[i].kind == record::build){
+            BOOST_CHECK_EQUAL(records[i].region.substr(0, 6), std::string("reduce"));
+        }
+    }
+    BOOST_CHECK_EQUAL(calls, size_t(2));
+
+    profiler.clear();
+    BOOST_CHECK(profiler.records().empty());
+}
+
+BOOST_AUTO_TEST_CASE(nested_algorithms)
+{
+    int data[] = { 3, 9, 1, 7, 5 };
+    compute::vector<int> vec(data, data + 5, queue);
+    queue.finish();
+
+    compute::profiler profiler;
+    profiler.start();
+    compute::sort(vec.begin(), vec.end(), queue);
+    profiler.stop();
+
+    const std::vector<record> &records = profiler.records();
+    BOOST_REQUIRE(!records.empty());
+    BOOST_CHECK(records[0].kind == record::algorithm);
+    BOOST_CHECK_EQUAL(records[0].name, std::string("sort"));
+
+    // everything else happens within the call to sort()
+    for(size_t i = 1; i < records.size(); i++){
+        BOOST_CHECK_EQUAL(records[i].region.substr(0, 4), std::string("sort"));
+    }
+}
+
+BOOST_AUTO_TEST_CASE(write_trace)
+{
+    compute::command_queue profiled_queue(
+        context, device, compute::command_queue::enable_profiling
+    );
+
+    compute::profiler profiler;
+    profiler.start();
+
+    compute::vector<int> vec(100, context);
+    compute::fill(vec.begin(), vec.end(), 2, profiled_queue);
+    int sum = 0;
+    compute::reduce(vec.begin(), vec.end(), &sum, profiled_queue);
+    BOOST_CHECK_EQUAL(sum, 200);
+
+    profiler.stop();
+
+    std::stringstream trace;
+    profiler.write_chrome_trace(trace);
+    const std::string json = trace.str();
+    BOOST_CHECK_EQUAL(json.substr(0, 15), std::string("{\"traceEvents\":"));
+    BOOST_CHECK(json.find("\"name\":\"reduce\"") != std::string::npos);
+    BOOST_CHECK(json.find("\"cat\":\"kernel\"") != std::string::npos);
+    BOOST_CHECK(json.find("\"cat\":\"read\"") != std::string::npos);
+    BOOST_CHECK(json.find("\"bytes\":400") != std::string::npos);
+
+    const std::string summary = profiler.summary();
+    BOOST_CHECK(summary.find("algorithm calls:") != std::string::npos);
+    BOOST_CHECK(summary.find("reduce") != std::string::npos);
+    BOOST_CHECK(summary.find("kernels:") != std::string::npos);
+    BOOST_CHECK(summary.find("allocations: ") != std::string::npos);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -14,6 +14,7 @@
 #include <boost/compute/lambda.hpp>
 #include <boost/compute/system.hpp>
 #include <boost/compute/functional.hpp>
+#include <boost/compute/algorithm/iota.hpp>
 #include <boost/compute/algorithm/reduce.hpp>
 #include <boost/compute/container/vector.hpp>
 #include <boost/compute/iterator/constant_iterator.hpp>
@@ -276,4 +277,93 @@ BOOST_AUTO_TEST_CASE(reduce_uchar_to_float)
     BOOST_CHECK_EQUAL(sum, 500);
 }
 
+BOOST_AUTO_TEST_CASE(reduce_multiple)
+{
+    using compute::lambda::_1;
+
+    int data[] = { 4, -2, 9, 1, 7, 3, -5, 8 };
+    compute::vector<int> vector(data, data + 8, queue);
+
+    boost::tuple<int, int, int, int, int> result;
+    compute::reduce(
+        vector.begin(), vector.end(),
+        boost::make_tuple(
+            boost::make_tuple(_1 * 0 + 1, compute::plus<int>(), 0),
+            boost::make_tuple(_1, compute::plus<int>(), 0),
+            boost::make_tuple(_1 * _1, compute::plus<int>(), 0),
+            boost::make_tuple(_1, compute::min<int>(), 100),
+            boost::make_tuple(_1, compute::max<int>(), -100)
+        ),
+        &result,
+        queue
+    );
+    BOOST_CHECK_EQUAL(boost::get<0>(result), 8);
+    BOOST_CHECK_EQUAL(boost::get<1>(result), 25);
+    BOOST_CHECK_EQUAL(boost::get<2>(result), 249);
+    BOOST_CHECK_EQUAL(boost::get<3>(result), -5);
+    BOOST_CHECK_EQUAL(boost::get<4>(result), 9);
+
+    // initial values are applied once
+    boost::tuple<int, float> offset_result;
+    compute::reduce(
+        vector.begin(), vector.end(),
+        boost::make_tuple(
+            boost::make_tuple(_1, compute::plus<int>(), 100),
+            boost::make_tuple(_1 * 0.5f, compute::plus<float>(), 1.0f)
+        ),
+        &offset_result,
+        queue
+    );
+    BOOST_CHECK_EQUAL(boost::get<0>(offset_result), 125);
+    BOOST_CHECK_CLOSE(boost::get<1>(offset_result), 13.5f, 1e-4f);
+}
+
+BOOST_AUTO_TEST_CASE(reduce_multiple_empty)
+{
+    using compute::lambda::_1;
+
+    compute::vector<float> vector(context);
+
+    boost::tuple<float, float> result;
+    compute::reduce(
+        vector.begin(), vector.end(),
+        boost::make_tuple(
+            boost::make_tuple(_1, compute::plus<float>(), 0.0f),
+            boost::make_tuple(_1, compute::max<float>(), -1.0f)
+        ),
+        &result,
+        queue
+    );
+    BOOST_CHECK_EQUAL(boost::get<0>(result), 0.0f);
+    BOOST_CHECK_EQUAL(boost::get<1>(result), -1.0f);
+}
+
+BOOST_AUTO_TEST_CASE(reduce_multiple_large)
+{
+    using compute::lambda::_1;
+
+    const compute::uint_ size = 100000;
+    compute::vector<compute::uint_> vector(size, context);
+    compute::iota(vector.begin(), vector.end(), compute::uint_(0), queue);
+
+    compute::vector<boost::tuple<compute::uint_, compute::uint_> > result(1, context);
+    compute::reduce(
+        vector.begin(), vector.end(),
+        boost::make_tuple(
+            boost::make_tuple(_1 % 7, compute::plus<compute::uint_>(), compute::uint_(0)),
+            boost::make_tuple(_1, compute::max<compute::uint_>(), compute::uint_(0))
+        ),
+        result.begin(),
+        queue
+    );
+
+    boost::tuple<compute::uint_, compute::uint_> host_result = result[0];
+    compute::uint_ sum_mod_7 = 0;
+    for(compute::uint_ i = 0; i < size; i++){
+        sum_mod_7 += i % 7;
+    }
+    BOOST_CHECK_EQUAL(boost::get<0>(host_result), sum_mod_7);
+    BOOST_CHECK_EQUAL(boost::get<1>(host_result), size - 1);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -11,9 +11,13 @@
 #define BOOST_TEST_MODULE TestReduceByKey
 #include <boost/test/unit_test.hpp>
 
+#include <cstdlib>
+#include <vector>
+
 #include <boost/compute/lambda.hpp>
 #include <boost/compute/system.hpp>
 #include <boost/compute/functional.hpp>
+#include <boost/compute/algorithm/copy.hpp>
 #include <boost/compute/algorithm/inclusive_scan.hpp>
 #include <boost/compute/algorithm/reduce_by_key.hpp>
 #include <boost/compute/container/vector.hpp>
@@ -207,4 +211,80 @@ BOOST_AUTO_TEST_CASE(reduce_by_key_int2_long_vector)
         (int2_(137, -137), int2_(540, -540), int2_(324, -324), int2_(23, -23)));
 }
 
+BOOST_AUTO_TEST_CASE(reduce_by_key_result_size)
+{
+    int keys[] = { 0, 2, -3, -3, -3, -3, -3, 4 };
+    int data[] = { 1, 1, 1, 1, 1, 2, 5, 1 };
+
+    bc::vector<int> keys_input(keys, keys + 8, queue);
+    bc::vector<int> values_input(data, data + 8, queue);
+    bc::vector<int> keys_output(8, context);
+    bc::vector<int> values_output(8, context);
+
+//! [reduce_by_key_result_size]
+// the number of reduced values is written to a device buffer
+bc::vector<bc::uint_> result_size(1, context);
+bc::reduce_by_key(keys_input.begin(), keys_input.end(), values_input.begin(),
+                  keys_output.begin(), values_output.begin(),
+                  bc::plus<int>(), bc::equal_to<int>(),
+                  result_size.begin(), queue);
+// result_size = { 4 }
+//! [reduce_by_key_result_size]
+
+    CHECK_RANGE_EQUAL(bc::uint_, 1, result_size, (4));
+    CHECK_RANGE_EQUAL(int, 4, keys_output,   (0, 2, -3,  4));
+    CHECK_RANGE_EQUAL(int, 4, values_output, (1, 1, 10, 1));
+}
+
+BOOST_AUTO_TEST_CASE(reduce_by_key_many_segments)
+{
+    // enough values for many work-groups with segments crossing their
+    // boundaries
+    const size_t size = 2000000;
+
+    std::vector<int> host_keys(size);
+    std::vector<int> host_values(size);
+    int key = 0;
+    for(size_t i = 0; i < size; i++){
+        if(std::rand() % 100 == 0){
+            key++;
+        }
+        host_keys[i] = key;
+        host_values[i] = std::rand() % 10;
+    }
+
+    std::vector<int> expected_keys;
+    std::vector<int> expected_values;
+    for(size_t i = 0; i < size; i++){
+        if(i == 0 || host_keys[i] != host_keys[i-1]){
+            expected_keys.push_back(host_keys[i]);
+            expected_values.push_back(0);
+        }
+        expected_values.back() += host_values[i];
+    }
+
+    bc::vector<int> keys_input(host_keys.begin(), host_keys.end(), queue);
+    bc::vector<int> values_input(host_values.begin(), host_values.end(), queue);
+    bc::vector<int> keys_output(size, context);
+    bc::vector<int> values_output(size, context);
+    bc::vector<bc::uint_> result_size(1, context);
+
+    bc::reduce_by_key(keys_input.begin(), keys_input.end(), values_input.begin(),
+                      keys_output.begin(), values_output.begin(),
+                      bc::plus<int>(), bc::equal_to<int>(),
+                      result_size.begin(), queue);
+
+    const size_t segments = expected_keys.size();
+    BOOST_CHECK_EQUAL(size_t(result_size[0]), segments);
+
+    std::vector<int> output_keys(segments);
+    std::vector<int> output_values(segments);
+    bc::copy(keys_output.begin(), keys_output.begin() + segments,
+             output_keys.begin(), queue);
+    bc::copy(values_output.begin(), values_output.begin() + segments,
+             output_values.begin(), queue);
+    BOOST_CHECK(output_keys == expected_keys);
+    BOOST_CHECK(output_values == expected_values);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
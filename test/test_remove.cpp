@@ -13,6 +13,8 @@
 
 #include <boost/compute/algorithm/remove.hpp>
 #include <boost/compute/algorithm/remove_if.hpp>
+#include <boost/compute/algorithm/remove_copy_if.hpp>
+#include <boost/compute/lambda.hpp>
 #include <boost/compute/container/vector.hpp>
 
 #include "check_macros.hpp"
@@ -52,4 +54,35 @@ BOOST_AUTO_TEST_CASE(remove_int)
     BOOST_VERIFY(iter == vector.begin());
 }
 
+BOOST_AUTO_TEST_CASE(remove_copy_if_int)
+{
+    using ::boost::compute::_1;
+
+    int data[] = { 1, 2, 1, 3, 2, 4, 3, 4, 5 };
+    bc::vector<int> input(data, data + 9, queue);
+    bc::vector<int> output(9, context);
+
+    bc::vector<int>::iterator iter = bc::remove_copy_if(
+        input.begin(), input.end(), output.begin(), _1 % 2 == 0, queue
+    );
+    BOOST_CHECK(iter == output.begin() + 5);
+    CHECK_RANGE_EQUAL(int, 5, output, (1, 1, 3, 3, 5));
+    CHECK_RANGE_EQUAL(int, 9, input, (1, 2, 1, 3, 2, 4, 3, 4, 5));
+}
+
+BOOST_AUTO_TEST_CASE(remove_copy_if_async_int)
+{
+    using ::boost::compute::_1;
+
+    int data[] = { 1, 2, 1, 3, 2, 4, 3, 4, 5 };
+    bc::vector<int> input(data, data + 9, queue);
+    bc::vector<int> output(9, context);
+
+    bc::future<bc::vector<int>::iterator> future = bc::remove_copy_if_async(
+        input.begin(), input.end(), output.begin(), _1 % 2 == 0, queue
+    );
+    BOOST_CHECK(future.get() == output.begin() + 5);
+    CHECK_RANGE_EQUAL(int, 5, output, (1, 1, 3, 3, 5));
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,134 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://boostorg.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#define BOOST_TEST_MODULE TestRunLengthEncode
+#include <boost/test/unit_test.hpp>
+
+#include <cstdlib>
+#include <vector>
+
+#include <boost/compute/system.hpp>
+#include <boost/compute/command_queue.hpp>
+#include <boost/compute/algorithm/copy.hpp>
+#include <boost/compute/algorithm/run_length_decode.hpp>
+#include <boost/compute/algorithm/run_length_encode.hpp>
+#include <boost/compute/container/vector.hpp>
+
+#include "check_macros.hpp"
+#include "context_setup.hpp"
+
+namespace bc = boost::compute;
+
+BOOST_AUTO_TEST_CASE(run_length_encode_int)
+{
+    int data[] = { 1, 1, 1, 2, 3, 3, 1, 1, 4, 4, 4, 4 };
+    bc::vector<int> input(data, data + 12, queue);
+
+//! [run_length_encode_int]
+bc::vector<int> values(input.size(), context);
+bc::vector<bc::uint_> counts(input.size(), context);
+
+std::pair<bc::vector<int>::iterator, bc::vector<bc::uint_>::iterator> end =
+    bc::run_length_encode(
+        input.begin(), input.end(), values.begin(), counts.begin(), queue
+    );
+
+// values = { 1, 2, 3, 1, 4 }
+// counts = { 3, 1, 2, 2, 4 }
+//! [run_length_encode_int]
+
+    BOOST_CHECK(end.first == values.begin() + 5);
+    BOOST_CHECK(end.second == counts.begin() + 5);
+    CHECK_RANGE_EQUAL(int, 5, values, (1, 2, 3, 1, 4));
+    CHECK_RANGE_EQUAL(bc::uint_, 5, counts, (3, 1, 2, 2, 4));
+}
+
+BOOST_AUTO_TEST_CASE(run_length_decode_int)
+{
+    int values_data[] = { 7, 2, 9, 5 };
+    bc::uint_ counts_data[] = { 2, 1, 0, 3 };
+
+//! [run_length_decode_int]
+bc::vector<int> values(values_data, values_data + 4, queue);
+bc::vector<bc::uint_> counts(counts_data, counts_data + 4, queue);
+
+bc::vector<int> output(6, context);
+bc::run_length_decode(
+    values.begin(), values.end(), counts.begin(), output.begin(), queue
+);
+
+// output = { 7, 7, 2, 5, 5, 5 }
+//! [run_length_decode_int]
+
+    CHECK_RANGE_EQUAL(int, 6, output, (7, 7, 2, 5, 5, 5));
+}
+
+BOOST_AUTO_TEST_CASE(run_length_empty)
+{
+    bc::vector<int> input(context);
+    bc::vector<int> values(1, context);
+    bc::vector<bc::uint_> counts(1, context);
+
+    std::pair<bc::vector<int>::iterator, bc::vector<bc::uint_>::iterator> end =
+        bc::run_length_encode(
+            input.begin(), input.end(), values.begin(), counts.begin(), queue
+        );
+    BOOST_CHECK(end.first == values.begin());
+    BOOST_CHECK(end.second == counts.begin());
+
+    bc::vector<int> output(1, context);
+    bc::vector<int>::iterator output_end = bc::run_length_decode(
+        values.begin(), values.begin(), counts.begin(), output.begin(), queue
+    );
+    BOOST_CHECK(output_end == output.begin());
+}
+
+BOOST_AUTO_TEST_CASE(run_length_round_trip)
+{
+    const size_t size = 100000;
+
+    std::vector<int> host_input(size);
+    int value = 0;
+    for(size_t i = 0; i < size; i++){
+        if(std::rand() % 8 == 0){
+            value = std::rand() % 16;
+        }
+        host_input[i] = value;
+    }
+
+    bc::vector<int> input(host_input.begin(), host_input.end(), queue);
+    bc::vector<int> values(size, context);
+    bc::vector<bc::uint_> counts(size, context);
+
+    std::pair<bc::vector<int>::iterator, bc::vector<bc::uint_>::iterator> end =
+        bc::run_length_encode(
+            input.begin(), input.end(), values.begin(), counts.begin(), queue
+        );
+
+    size_t host_runs = 1;
+    for(size_t i = 1; i < size; i++){
+        if(host_input[i] != host_input[i-1]){
+            host_runs++;
+        }
+    }
+    BOOST_CHECK_EQUAL(size_t(end.first - values.begin()), host_runs);
+
+    bc::vector<int> output(size, context);
+    bc::vector<int>::iterator output_end = bc::run_length_decode(
+        values.begin(), end.first, counts.begin(), output.begin(), queue
+    );
+    BOOST_CHECK(output_end == output.end());
+
+    std::vector<int> host_output(size);
+    bc::copy(output.begin(), output.end(), host_output.begin(), queue);
+    BOOST_CHECK(host_output == host_input);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
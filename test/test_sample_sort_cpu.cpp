@@ -0,0 +1,182 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://boostorg.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#define BOOST_TEST_MODULE TestSampleSortOnCPU
+#include <boost/test/unit_test.hpp>
+
+#include <algorithm>
+#include <cstdlib>
+#include <functional>
+#include <utility>
+#include <vector>
+
+#include <boost/compute/system.hpp>
+#include <boost/compute/algorithm/copy.hpp>
+#include <boost/compute/algorithm/detail/merge_sort_on_cpu.hpp>
+#include <boost/compute/algorithm/detail/sample_sort_on_cpu.hpp>
+#include <boost/compute/container/vector.hpp>
+#include <boost/compute/functional/operator.hpp>
+
+#include "check_macros.hpp"
+#include "context_setup.hpp"
+
+namespace bc = boost::compute;
+
+BOOST_AUTO_TEST_CASE(sample_sort_int)
+{
+    using bc::int_;
+
+    std::vector<int_> data(10000);
+    for(size_t i = 0; i < data.size(); i++){
+        data[i] = static_cast<int_>(std::rand() % 20000) - 10000;
+    }
+    bc::vector<int_> vector(data.begin(), data.end(), queue);
+
+    // small buckets so that the values are split into many of them
+    bc::vector<int_>::iterator dummy;
+    bc::detail::sample_sort_on_cpu(
+        vector.begin(), dummy, bc::less<int_>(),
+        vector.size(), 256, 16, false, queue
+    );
+
+    std::vector<int_> host(data.size());
+    bc::copy(vector.begin(), vector.end(), host.begin(), queue);
+    std::sort(data.begin(), data.end());
+    BOOST_CHECK(host == data);
+
+    bc::detail::sample_sort_on_cpu(
+        vector.begin(), dummy, bc::greater<int_>(),
+        vector.size(), 1000, 64, false, queue
+    );
+
+    bc::copy(vector.begin(), vector.end(), host.begin(), queue);
+    std::sort(data.begin(), data.end(), std::greater<int_>());
+    BOOST_CHECK(host == data);
+}
+
+BOOST_AUTO_TEST_CASE(sample_sort_by_key_is_stable)
+{
+    using bc::uint_;
+
+    // few distinct keys so most keys are equal to a splitter
+    std::vector<uint_> keys(8000);
+    std::vector<uint_> values(keys.size());
+    for(size_t i = 0; i < keys.size(); i++){
+        keys[i] = static_cast<uint_>(std::rand() % 13);
+        values[i] = static_cast<uint_>(i);
+    }
+    bc::vector<uint_> device_keys(keys.begin(), keys.end(), queue);
+    bc::vector<uint_> device_values(values.begin(), values.end(), queue);
+
+    bc::detail::sample_sort_on_cpu(
+        device_keys.begin(), device_values.begin(), bc::less<uint_>(),
+        device_keys.size(), 128, 16, true, queue
+    );
+
+    std::vector<std::pair<uint_, uint_> > expected(keys.size());
+    for(size_t i = 0; i < keys.size(); i++){
+        expected[i] = std::make_pair(keys[i], values[i]);
+    }
+    std::stable_sort(expected.begin(), expected.end());
+
+    bc::copy(device_keys.begin(), device_keys.end(), keys.begin(), queue);
+    bc::copy(device_values.begin(), device_values.end(), values.begin(), queue);
+    for(size_t i = 0; i < keys.size(); i++){
+        BOOST_REQUIRE_EQUAL(keys[i], expected[i].first);
+        BOOST_REQUIRE_EQUAL(values[i], expected[i].second);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(sample_sort_equal_keys)
+{
+    using bc::float_;
+
+    // all splitters are equal to the keys
+    bc::vector<float_> vector(5000, 1.5f, queue);
+    bc::vector<float_>::iterator dummy;
+    bc::detail::sample_sort_on_cpu(
+        vector.begin(), dummy, bc::less<float_>(),
+        vector.size(), 256, 16, false, queue
+    );
+
+    std::vector<float_> host(vector.size());
+    bc::copy(vector.begin(), vector.end(), host.begin(), queue);
+    BOOST_CHECK(std::count(host.begin(), host.end(), 1.5f) == 5000);
+}
+
+BOOST_AUTO_TEST_CASE(sample_sort_small_buckets)
+{
+    using bc::int_;
+
+    // fewer values than a sample of oversampling values for each bucket
+    for(size_t size = 2; size < 200; size += 37){
+        std::vector<int_> data(size);
+        for(size_t i = 0; i < data.size(); i++){
+            data[i] = static_cast<int_>(std::rand() % 100);
+        }
+        bc::vector<int_> vector(data.begin(), data.end(), queue);
+
+        bc::vector<int_>::iterator dummy;
+        bc::detail::sample_sort_on_cpu(
+            vector.begin(), dummy, bc::less<int_>(),
+            vector.size(), 1, 4, false, queue
+        );
+
+        std::vector<int_> host(data.size());
+        bc::copy(vector.begin(), vector.end(), host.begin(), queue);
+        std::sort(data.begin(), data.end());
+        BOOST_CHECK(host == data);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(sample_sort_by_key_equal_keys_is_stable)
+{
+    using bc::uint_;
+
+    // all splitters are equal so the keys are spread over all buckets
+    std::vector<uint_> values(6000);
+    for(size_t i = 0; i < values.size(); i++){
+        values[i] = static_cast<uint_>(i);
+    }
+    bc::vector<uint_> device_keys(values.size(), uint_(7), queue);
+    bc::vector<uint_> device_values(values.begin(), values.end(), queue);
+
+    bc::detail::sample_sort_on_cpu(
+        device_keys.begin(), device_values.begin(), bc::less<uint_>(),
+        device_keys.size(), 100, 16, true, queue
+    );
+
+    std::vector<uint_> host(values.size());
+    bc::copy(device_values.begin(), device_values.end(), host.begin(), queue);
+    BOOST_CHECK(host == values);
+}
+
+BOOST_AUTO_TEST_CASE(merge_sort_on_cpu_large)
+{
+    using bc::int_;
+
+    // large enough for merge_sort_on_cpu() to use the sample sort
+    std::vector<int_> data(300000);
+    for(size_t i = 0; i < data.size(); i++){
+        data[i] = static_cast<int_>(std::rand());
+    }
+    bc::vector<int_> vector(data.begin(), data.end(), queue);
+
+    bc::detail::merge_sort_on_cpu(
+        vector.begin(), vector.end(), bc::less<int_>(), queue
+    );
+
+    std::vector<int_> host(data.size());
+    bc::copy(vector.begin(), vector.end(), host.begin(), queue);
+    std::sort(data.begin(), data.end());
+    BOOST_CHECK(host == data);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
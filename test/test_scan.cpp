@@ -487,4 +487,27 @@ BOOST_AUTO_TEST_CASE(exclusive_scan_int_custom_function)
     CHECK_RANGE_EQUAL(int, 5, vector, (1, 2, 8, 16, 64));
 }
 
+BOOST_AUTO_TEST_CASE(inclusive_scan_int_offset_output)
+{
+    // more values than a single block so that the block sums are added
+    // to the output, which starts at an offset in its buffer
+    size_t size = 1000;
+    std::vector<int> host_vector(size);
+    for(size_t i = 0; i < size; i++){
+        host_vector[i] = int(i % 7);
+    }
+    bc::vector<int> input(host_vector.begin(), host_vector.end(), queue);
+    bc::vector<int> output(size + 5, int(-1), queue);
+
+    bc::inclusive_scan(input.begin(), input.end(), output.begin() + 5, queue);
+
+    std::vector<int> expected(size + 5, -1);
+    std::partial_sum(host_vector.begin(), host_vector.end(), expected.begin() + 5);
+
+    std::vector<int> result(size + 5);
+    bc::copy(output.begin(), output.end(), result.begin(), queue);
+    BOOST_CHECK_EQUAL_COLLECTIONS(result.begin(), result.end(),
+                                  expected.begin(), expected.end());
+}
+
 BOOST_AUTO_TEST_SUITE_END()
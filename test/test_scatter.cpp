@@ -12,6 +12,7 @@
 #include <boost/test/unit_test.hpp>
 
 #include <boost/compute/system.hpp>
+#include <boost/compute/algorithm/fill.hpp>
 #include <boost/compute/algorithm/scatter.hpp>
 #include <boost/compute/container/vector.hpp>
 #include <boost/compute/iterator/constant_buffer_iterator.hpp>
@@ -54,4 +55,18 @@ BOOST_AUTO_TEST_CASE(scatter_constant_indices)
     CHECK_RANGE_EQUAL(int, 5, output, (1, 3, 5, 4, 2));
 }
 
+BOOST_AUTO_TEST_CASE(scatter_with_offsets)
+{
+    int input_data[] = { 1, 2, 3, 4, 5 };
+    bc::vector<int> input(input_data, input_data + 5, queue);
+
+    int map_data[] = { 2, 1, 0 };
+    bc::vector<int> map(map_data, map_data + 3, queue);
+
+    bc::vector<int> output(5, context);
+    bc::fill(output.begin(), output.end(), 0, queue);
+    bc::scatter(input.begin() + 1, input.begin() + 4, map.begin(), output.begin() + 1, queue);
+    CHECK_RANGE_EQUAL(int, 5, output, (0, 4, 3, 2, 0));
+}
+
 BOOST_AUTO_TEST_SUITE_END()
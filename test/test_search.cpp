@@ -17,6 +17,9 @@
 #include <boost/compute/container/vector.hpp>
 #include <boost/compute/types/fundamental.hpp>
 
+#include <algorithm>
+#include <vector>
+
 #include "check_macros.hpp"
 #include "context_setup.hpp"
 
@@ -69,4 +72,75 @@ BOOST_AUTO_TEST_CASE(search_string)
     BOOST_CHECK(iter == vectort.begin() + 2);
 }
 
+BOOST_AUTO_TEST_CASE(search_large)
+{
+    // matches near the tile and block boundaries of the search
+    std::vector<bc::char_> text(10000, 'a');
+    const size_t positions[] = { 2044, 2048, 4095, 9996 };
+    for(size_t i = 0; i < 4; i++){
+        std::copy(
+            "abcd", "abcd" + 4, text.begin() + static_cast<std::ptrdiff_t>(positions[i])
+        );
+    }
+    bc::vector<bc::char_> vectort(text.begin(), text.end(), queue);
+
+    bc::char_ pattern[] = "abcd";
+    bc::vector<bc::char_> vectorp(pattern, pattern + 4, queue);
+
+    bc::vector<bc::char_>::iterator iter =
+        bc::search(vectort.begin(), vectort.end(),
+                   vectorp.begin(), vectorp.end(), queue);
+    BOOST_CHECK(iter == vectort.begin() + 2044);
+
+    iter =
+        bc::search(vectort.begin() + 2045, vectort.end(),
+                   vectorp.begin(), vectorp.end(), queue);
+    BOOST_CHECK(iter == vectort.begin() + 2048);
+
+    iter =
+        bc::search(vectort.begin() + 4096, vectort.end(),
+                   vectorp.begin(), vectorp.end(), queue);
+    BOOST_CHECK(iter == vectort.begin() + 9996);
+
+    iter =
+        bc::search(vectort.begin() + 4096, vectort.end() - 1,
+                   vectorp.begin(), vectorp.end(), queue);
+    BOOST_CHECK(iter == vectort.end() - 1);
+}
+
+BOOST_AUTO_TEST_CASE(search_float)
+{
+    float data[] = {1.5f, 2.5f, 3.5f, 2.5f, 3.5f, 4.5f};
+    bc::vector<float> vectort(data, data + 6, queue);
+
+    float datap[] = {2.5f, 3.5f, 4.5f};
+    bc::vector<float> vectorp(datap, datap + 3, queue);
+
+    bc::vector<float>::iterator iter =
+        bc::search(vectort.begin(), vectort.end(),
+                   vectorp.begin(), vectorp.end(), queue);
+    BOOST_CHECK(iter == vectort.begin() + 3);
+}
+
+BOOST_AUTO_TEST_CASE(search_empty_and_long_pattern)
+{
+    int data[] = {1, 2, 3};
+    bc::vector<bc::int_> vectort(data, data + 3, queue);
+
+    int datap[] = {1, 2, 3, 4};
+    bc::vector<bc::int_> vectorp(datap, datap + 4, queue);
+
+    // an empty pattern matches at the beginning of the text
+    bc::vector<bc::int_>::iterator iter =
+        bc::search(vectort.begin(), vectort.end(),
+                   vectorp.begin(), vectorp.begin(), queue);
+    BOOST_CHECK(iter == vectort.begin());
+
+    // a pattern longer than the text is not found
+    iter =
+        bc::search(vectort.begin(), vectort.end(),
+                   vectorp.begin(), vectorp.end(), queue);
+    BOOST_CHECK(iter == vectort.end());
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,201 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://boostorg.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#define BOOST_TEST_MODULE TestSearchAny
+#include <boost/test/unit_test.hpp>
+
+#include <algorithm>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+#include <boost/compute/command_queue.hpp>
+#include <boost/compute/algorithm/copy.hpp>
+#include <boost/compute/algorithm/search_any.hpp>
+#include <boost/compute/container/vector.hpp>
+#include <boost/compute/types/fundamental.hpp>
+
+#include "check_macros.hpp"
+#include "context_setup.hpp"
+
+namespace bc = boost::compute;
+
+BOOST_AUTO_TEST_CASE(search_any_words)
+{
+    std::string text = "ushers said she has his hers";
+    bc::vector<bc::char_> vectort(text.begin(), text.end(), queue);
+
+    std::vector<std::string> words;
+    words.push_back("he");
+    words.push_back("she");
+    words.push_back("his");
+    words.push_back("hers");
+
+    bc::vector<bc::uint2_> matches(text.size() * words.size(), context);
+    bc::vector<bc::uint2_>::iterator end = bc::search_any(
+        vectort.begin(), vectort.end(),
+        words.begin(), words.end(),
+        matches.begin(), queue
+    );
+    BOOST_CHECK_EQUAL(std::distance(matches.begin(), end), 8);
+
+    // ordered by the end of the matches
+    CHECK_RANGE_EQUAL(
+        bc::uint2_, 8, matches,
+        (bc::uint2_(1, 1), bc::uint2_(2, 0), bc::uint2_(2, 3),
+         bc::uint2_(12, 1), bc::uint2_(13, 0), bc::uint2_(20, 2),
+         bc::uint2_(24, 0), bc::uint2_(24, 3))
+    );
+}
+
+BOOST_AUTO_TEST_CASE(search_any_no_matches)
+{
+    std::string text = "abcabcabc";
+    bc::vector<bc::char_> vectort(text.begin(), text.end(), queue);
+
+    std::vector<std::string> words;
+    words.push_back("");
+    words.push_back("abd");
+    words.push_back("cc");
+
+    bc::vector<bc::uint2_> matches(10, context);
+    bc::vector<bc::uint2_>::iterator end = bc::search_any(
+        vectort.begin(), vectort.end(),
+        words.begin(), words.end(),
+        matches.begin(), queue
+    );
+    BOOST_CHECK(end == matches.begin());
+
+    // empty text
+    end = bc::search_any(
+        vectort.begin(), vectort.begin(),
+        words.begin(), words.end(),
+        matches.begin(), queue
+    );
+    BOOST_CHECK(end == matches.begin());
+}
+
+BOOST_AUTO_TEST_CASE(search_any_bounded)
+{
+    // overlapping patterns match more often than the length of the text
+    std::string text = "aaaa";
+    bc::vector<bc::char_> vectort(text.begin(), text.end(), queue);
+
+    std::vector<std::string> words;
+    words.push_back("a");
+    words.push_back("aa");
+    words.push_back("aaa");
+
+    // only count the matches
+    bc::vector<bc::uint2_> matches(6, bc::uint2_(7, 7), queue);
+    size_t count = bc::search_any(
+        vectort.begin(), vectort.end(),
+        words.begin(), words.end(),
+        matches.begin(), matches.begin(), queue
+    );
+    BOOST_CHECK_EQUAL(count, size_t(9));
+    CHECK_RANGE_EQUAL(
+        bc::uint2_, 6, matches,
+        (bc::uint2_(7, 7), bc::uint2_(7, 7), bc::uint2_(7, 7),
+         bc::uint2_(7, 7), bc::uint2_(7, 7), bc::uint2_(7, 7))
+    );
+
+    // the matches past the end of the result range are not written
+    count = bc::search_any(
+        vectort.begin(), vectort.end(),
+        words.begin(), words.end(),
+        matches.begin(), matches.begin() + 4, queue
+    );
+    BOOST_CHECK_EQUAL(count, size_t(9));
+
+    std::vector<bc::uint2_> host_matches(6);
+    bc::copy(matches.begin(), matches.end(), host_matches.begin(), queue);
+    BOOST_CHECK_EQUAL(host_matches[0], bc::uint2_(0, 0));
+    for(size_t i = 1; i < 4; i++){
+        const size_t id = host_matches[i][1];
+        BOOST_CHECK(id < words.size());
+        BOOST_CHECK_EQUAL(host_matches[i][0] + words[id].size(), i < 3 ? 2 : 3);
+    }
+    BOOST_CHECK_EQUAL(host_matches[4], bc::uint2_(7, 7));
+    BOOST_CHECK_EQUAL(host_matches[5], bc::uint2_(7, 7));
+
+    // all of the matches fit
+    matches.resize(count, queue);
+    count = bc::search_any(
+        vectort.begin(), vectort.end(),
+        words.begin(), words.end(),
+        matches.begin(), matches.end(), queue
+    );
+    BOOST_CHECK_EQUAL(count, size_t(9));
+    bc::copy(matches.end() - 1, matches.end(), host_matches.begin(), queue);
+    BOOST_CHECK_EQUAL(host_matches[0][0] + words[host_matches[0][1]].size(), 4);
+}
+
+BOOST_AUTO_TEST_CASE(search_any_large)
+{
+    // random text over a small alphabet so the patterns match often and
+    // cross the chunks and tiles of the search
+    std::string text(20000, 'a');
+    for(size_t i = 0; i < text.size(); i++){
+        text[i] = static_cast<char>('a' + std::rand() % 3);
+    }
+    bc::vector<bc::char_> vectort(text.begin(), text.end(), queue);
+
+    std::vector<std::string> words;
+    words.push_back("abc");
+    words.push_back("bca");
+    words.push_back("c");
+    words.push_back("aaaaaa");
+    words.push_back("abcabcab");
+    words.push_back("bc");
+
+    // expected matches ordered by their end
+    std::vector<std::pair<size_t, size_t> > expected;
+    for(size_t end = 1; end <= text.size(); end++){
+        for(size_t id = 0; id < words.size(); id++){
+            const size_t length = words[id].size();
+            if(length <= end && text.compare(end - length, length, words[id]) == 0){
+                expected.push_back(std::make_pair(end, id));
+            }
+        }
+    }
+
+    bc::vector<bc::uint2_> matches(text.size() * words.size(), context);
+    bc::vector<bc::uint2_>::iterator end = bc::search_any(
+        vectort.begin(), vectort.end(),
+        words.begin(), words.end(),
+        matches.begin(), queue
+    );
+    BOOST_REQUIRE_EQUAL(
+        static_cast<size_t>(std::distance(matches.begin(), end)), expected.size()
+    );
+
+    std::vector<bc::uint2_> host_matches(expected.size());
+    bc::copy(matches.begin(), end, host_matches.begin(), queue);
+
+    // the order of the matches which end at the same position depends on
+    // the automaton so only their ends are compared in order
+    std::vector<std::pair<size_t, size_t> > found;
+    for(size_t i = 0; i < host_matches.size(); i++){
+        const size_t id = host_matches[i][1];
+        found.push_back(std::make_pair(host_matches[i][0] + words[id].size(), id));
+    }
+    for(size_t i = 0; i < expected.size(); ){
+        size_t j = i;
+        while(j < expected.size() && expected[j].first == expected[i].first){
+            j++;
+        }
+        std::sort(found.begin() + i, found.begin() + j);
+        i = j;
+    }
+    BOOST_CHECK(found == expected);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,185 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://boostorg.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#define BOOST_TEST_MODULE TestSoaVector
+#include <boost/test/unit_test.hpp>
+
+#include <algorithm>
+#include <vector>
+
+#include <boost/compute/system.hpp>
+#include <boost/compute/function.hpp>
+#include <boost/compute/algorithm/copy.hpp>
+#include <boost/compute/algorithm/reduce.hpp>
+#include <boost/compute/algorithm/sort_by_key.hpp>
+#include <boost/compute/algorithm/transform.hpp>
+#include <boost/compute/container/soa_vector.hpp>
+#include <boost/compute/container/vector.hpp>
+#include <boost/compute/types/struct.hpp>
+#include <boost/compute/types/tuple.hpp>
+
+struct tick
+{
+    float price;
+    boost::compute::uint_ volume;
+    boost::compute::ulong_ time;
+    boost::compute::float2_ spread;
+};
+
+BOOST_COMPUTE_ADAPT_STRUCT(tick, tick, (price, volume, time, spread))
+
+#include "check_macros.hpp"
+#include "context_setup.hpp"
+
+namespace bc = boost::compute;
+
+std::vector<tick> make_ticks(size_t count)
+{
+    std::vector<tick> ticks(count);
+    for(size_t i = 0; i < count; i++){
+        ticks[i].price = static_cast<float>(i) / 2;
+        ticks[i].volume = static_cast<bc::uint_>(3 * i + 1);
+        ticks[i].time = static_cast<bc::ulong_>((i * 7919) % count);
+        ticks[i].spread = bc::float2_(float(i), -float(i));
+    }
+    return ticks;
+}
+
+BOOST_AUTO_TEST_CASE(empty)
+{
+    bc::soa_vector<tick> ticks(context);
+    BOOST_CHECK(ticks.empty());
+    BOOST_CHECK_EQUAL(ticks.size(), size_t(0));
+    BOOST_CHECK_EQUAL(bc::soa_vector<tick>::columns(), size_t(4));
+    BOOST_CHECK(ticks.begin(&tick::price) == ticks.end(&tick::price));
+}
+
+BOOST_AUTO_TEST_CASE(convert_to_columns_and_back)
+{
+    std::vector<tick> host = make_ticks(1000);
+
+    // from host structs
+    bc::soa_vector<tick> ticks(host.begin(), host.end(), queue);
+    BOOST_CHECK_EQUAL(ticks.size(), size_t(1000));
+
+    std::vector<bc::uint_> volumes(1000);
+    bc::copy(ticks.begin(&tick::volume), ticks.end(&tick::volume), volumes.begin(), queue);
+    for(size_t i = 0; i < volumes.size(); i++){
+        BOOST_REQUIRE_EQUAL(volumes[i], host[i].volume);
+    }
+
+    // back to device structs
+    bc::vector<tick> structs(1000, context);
+    ticks.copy_to(structs.begin(), queue);
+
+    std::vector<tick> result(1000);
+    bc::copy(structs.begin(), structs.end(), result.begin(), queue);
+    for(size_t i = 0; i < result.size(); i++){
+        BOOST_REQUIRE_EQUAL(result[i].price, host[i].price);
+        BOOST_REQUIRE_EQUAL(result[i].volume, host[i].volume);
+        BOOST_REQUIRE_EQUAL(result[i].time, host[i].time);
+        BOOST_REQUIRE_EQUAL(result[i].spread[1], host[i].spread[1]);
+    }
+
+    // from device structs
+    bc::soa_vector<tick> copy(context);
+    copy.assign(structs.begin() + 10, structs.begin() + 20, queue);
+    BOOST_CHECK_EQUAL(copy.size(), size_t(10));
+
+    tick t = copy.get(3, queue);
+    BOOST_CHECK_EQUAL(t.price, host[13].price);
+    BOOST_CHECK_EQUAL(t.time, host[13].time);
+    BOOST_CHECK_EQUAL(t.spread[0], host[13].spread[0]);
+}
+
+BOOST_AUTO_TEST_CASE(column_algorithms)
+{
+    std::vector<tick> host = make_ticks(500);
+    bc::soa_vector<tick> ticks(host.begin(), host.end(), queue);
+
+    // reduce of one column
+    bc::uint_ total = 0;
+    bc::reduce(ticks.begin(&tick::volume), ticks.end(&tick::volume), &total, queue);
+    BOOST_CHECK_EQUAL(total, bc::uint_(3 * (499 * 500 / 2) + 500));
+
+    // transform of two columns zipped together
+    BOOST_COMPUTE_FUNCTION(float, notional, (boost::tuple<float, bc::uint_> x),
+    {
+        return boost_tuple_get(x, 0) * boost_tuple_get(x, 1);
+    });
+
+    bc::vector<float> notionals(500, context);
+    bc::transform(
+        ticks.zip_begin(&tick::price, &tick::volume),
+        ticks.zip_end(&tick::price, &tick::volume),
+        notionals.begin(),
+        notional,
+        queue
+    );
+    BOOST_CHECK_EQUAL(notionals[10], host[10].price * host[10].volume);
+
+    // sort_by_key of two columns
+    bc::sort_by_key(
+        ticks.begin(&tick::time), ticks.end(&tick::time), ticks.begin(&tick::price), queue
+    );
+    std::vector<float> prices(500);
+    bc::copy(ticks.begin(&tick::price), ticks.end(&tick::price), prices.begin(), queue);
+    for(size_t i = 0; i < host.size(); i++){
+        BOOST_REQUIRE_EQUAL(prices[host[i].time], host[i].price);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(sort_rows)
+{
+    std::vector<tick> host = make_ticks(3000);
+    bc::soa_vector<tick> ticks(host.begin(), host.end(), queue);
+
+    ticks.sort_by(&tick::time, queue);
+
+    std::vector<tick> result(3000);
+    ticks.copy_to(result.begin(), queue);
+    for(size_t i = 0; i < result.size(); i++){
+        const tick &expected = host[(i * 1679) % 3000];
+        BOOST_REQUIRE_EQUAL(result[i].time, bc::ulong_(i));
+        BOOST_REQUIRE_EQUAL(result[i].time, expected.time);
+        BOOST_REQUIRE_EQUAL(result[i].price, expected.price);
+        BOOST_REQUIRE_EQUAL(result[i].volume, expected.volume);
+        BOOST_REQUIRE_EQUAL(result[i].spread[0], expected.spread[0]);
+    }
+
+    // descending
+    ticks.sort_by(&tick::volume, bc::greater<bc::uint_>(), queue);
+    BOOST_CHECK_EQUAL(ticks.get(0, queue).volume, bc::uint_(3 * 2999 + 1));
+    BOOST_CHECK_EQUAL(ticks.get(2999, queue).volume, bc::uint_(1));
+}
+
+BOOST_AUTO_TEST_CASE(resize_and_copy)
+{
+    std::vector<tick> host = make_ticks(100);
+    bc::soa_vector<tick> ticks(host.begin(), host.end(), queue);
+
+    ticks.resize(150, queue);
+    BOOST_CHECK_EQUAL(ticks.size(), size_t(150));
+    BOOST_CHECK_EQUAL(ticks.get(99, queue).volume, host[99].volume);
+
+    ticks.resize(20, queue);
+    BOOST_CHECK_EQUAL(ticks.size(), size_t(20));
+
+    bc::soa_vector<tick> copy(ticks, queue);
+    BOOST_CHECK_EQUAL(copy.size(), size_t(20));
+    BOOST_CHECK_EQUAL(copy.get(19, queue).price, host[19].price);
+
+    bc::soa_vector<tick> other(context);
+    other.swap(copy);
+    BOOST_CHECK(copy.empty());
+    BOOST_CHECK_EQUAL(other.get(5, queue).time, host[5].time);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -26,6 +26,16 @@ struct custom_struct
 
 BOOST_COMPUTE_ADAPT_STRUCT(custom_struct, custom_struct, (x, y, zw))
 
+struct wide_struct
+{
+    boost::compute::int4_ a;
+    boost::compute::int4_ b;
+    boost::compute::int4_ c;
+    boost::compute::int4_ d;
+};
+
+BOOST_COMPUTE_ADAPT_STRUCT(wide_struct, wide_struct, (a, b, c, d))
+
 #include "check_macros.hpp"
 #include "context_setup.hpp"
 
@@ -204,4 +214,51 @@ BOOST_AUTO_TEST_CASE(sort_custom_struct_by_int)
     BOOST_CHECK(compute::is_sorted(values.begin(), values.end(), sort_custom_struct, queue) == true);
 }
 
+// values wider than the keys are sorted with their indices and gathered
+BOOST_AUTO_TEST_CASE(sort_wide_struct_by_int)
+{
+    using boost::compute::int_;
+    using boost::compute::int4_;
+
+    const int_ n = 5000;
+    std::vector<int_> host_keys(n);
+    std::vector<wide_struct> host_values(n);
+    for(int_ i = 0; i < n; i++){
+        const int_ key = (i * 7919) % n;
+        host_keys[i] = key;
+        host_values[i].a = int4_(key, i, 0, 1);
+        host_values[i].b = int4_(2, 3, 4, 5);
+        host_values[i].c = int4_(6, 7, 8, 9);
+        host_values[i].d = int4_(key, key, key, key);
+    }
+
+    compute::vector<int_> keys(host_keys.begin(), host_keys.end(), queue);
+    compute::vector<wide_struct> values(host_values.begin(), host_values.end(), queue);
+
+    compute::sort_by_key(keys.begin(), keys.end(), values.begin(), queue);
+
+    compute::copy(keys.begin(), keys.end(), host_keys.begin(), queue);
+    compute::copy(values.begin(), values.end(), host_values.begin(), queue);
+    for(int_ i = 0; i < n; i++){
+        BOOST_REQUIRE_EQUAL(host_keys[i], i);
+        BOOST_REQUIRE_EQUAL(host_values[i].a[0], i);
+        BOOST_REQUIRE_EQUAL((host_values[i].a[1] * 7919) % n, i);
+        BOOST_REQUIRE_EQUAL(host_values[i].c[3], 9);
+        BOOST_REQUIRE_EQUAL(host_values[i].d[2], i);
+    }
+
+    // descending order
+    compute::sort_by_key(
+        keys.begin(), keys.end(), values.begin(), compute::greater<int_>(), queue
+    );
+
+    compute::copy(keys.begin(), keys.end(), host_keys.begin(), queue);
+    compute::copy(values.begin(), values.end(), host_values.begin(), queue);
+    for(int_ i = 0; i < n; i++){
+        BOOST_REQUIRE_EQUAL(host_keys[i], n - 1 - i);
+        BOOST_REQUIRE_EQUAL(host_values[i].a[0], n - 1 - i);
+        BOOST_REQUIRE_EQUAL(host_values[i].d[3], n - 1 - i);
+    }
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -11,9 +11,13 @@
 #define BOOST_TEST_MODULE TestStablePartition
 #include <boost/test/unit_test.hpp>
 
+#include <vector>
+#include <algorithm>
+
 #include <boost/compute/system.hpp>
 #include <boost/compute/functional.hpp>
 #include <boost/compute/command_queue.hpp>
+#include <boost/compute/algorithm/copy.hpp>
 #include <boost/compute/algorithm/stable_partition.hpp>
 #include <boost/compute/container/vector.hpp>
 
@@ -22,6 +26,14 @@
 
 namespace bc = boost::compute;
 
+struct is_positive
+{
+    bool operator()(int x) const
+    {
+        return x > 0;
+    }
+};
+
 BOOST_AUTO_TEST_CASE(partition_int)
 {
     int dataset[] = {1, 1, -2, 0, 5, -1, 2, 4, 0, -1};
@@ -35,4 +47,29 @@ BOOST_AUTO_TEST_CASE(partition_int)
     BOOST_VERIFY(iter == vector.begin()+5);
 }
 
+BOOST_AUTO_TEST_CASE(partition_large)
+{
+    std::vector<int> host(4099);
+    for(size_t i = 0; i < host.size(); i++){
+        host[i] = int((i * 13) % 101) - 50;
+    }
+    bc::vector<int> vector(host.begin(), host.end(), queue);
+
+    std::vector<int> expected = host;
+    std::vector<int>::iterator expected_iter = std::stable_partition(
+        expected.begin(), expected.end(), is_positive()
+    );
+
+    bc::vector<int>::iterator iter =
+        bc::stable_partition(vector.begin(), vector.end(), bc::_1 > 0, queue);
+    BOOST_CHECK_EQUAL(
+        std::distance(vector.begin(), iter),
+        std::distance(expected.begin(), expected_iter)
+    );
+
+    std::vector<int> result(host.size());
+    bc::copy(vector.begin(), vector.end(), result.begin(), queue);
+    BOOST_CHECK(result == expected);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -11,6 +11,10 @@
 #define BOOST_TEST_MODULE TestStableSortByKey
 #include <boost/test/unit_test.hpp>
 
+#include <algorithm>
+#include <utility>
+#include <vector>
+
 #include <boost/compute/system.hpp>
 #include <boost/compute/algorithm/stable_sort_by_key.hpp>
 #include <boost/compute/algorithm/is_sorted.hpp>
@@ -203,4 +207,36 @@ BOOST_AUTO_TEST_CASE(stable_sort_mid_uint_by_uint)
     BOOST_CHECK((values.begin() + 2).read(queue) == 2);
 }
 
+BOOST_AUTO_TEST_CASE(stable_sort_ulong4_by_int)
+{
+    using boost::compute::int_;
+    using boost::compute::ulong_;
+    using boost::compute::ulong4_;
+
+    // few distinct keys, the values are sorted with their indices
+    const int_ size = 3000;
+    std::vector<int_> keys_data(size);
+    std::vector<ulong4_> values_data(size);
+    std::vector<std::pair<int_, int_> > expected(size);
+    for(int_ i = 0; i < size; i++){
+        keys_data[i] = (i * 31) % 17;
+        values_data[i] = ulong4_(ulong_(i), 1, 2, ulong_(keys_data[i]));
+        expected[i] = std::make_pair(keys_data[i], i);
+    }
+    std::stable_sort(expected.begin(), expected.end());
+
+    compute::vector<int_> keys(keys_data.begin(), keys_data.end(), queue);
+    compute::vector<ulong4_> values(values_data.begin(), values_data.end(), queue);
+
+    compute::stable_sort_by_key(keys.begin(), keys.end(), values.begin(), queue);
+
+    compute::copy(keys.begin(), keys.end(), keys_data.begin(), queue);
+    compute::copy(values.begin(), values.end(), values_data.begin(), queue);
+    for(int_ i = 0; i < size; i++){
+        BOOST_REQUIRE_EQUAL(keys_data[i], expected[i].first);
+        BOOST_REQUIRE_EQUAL(values_data[i][0], ulong_(expected[i].second));
+        BOOST_REQUIRE_EQUAL(values_data[i][3], ulong_(expected[i].first));
+    }
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,202 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://boostorg.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#define BOOST_TEST_MODULE TestStringColumn
+#include <boost/test/unit_test.hpp>
+
+#include <algorithm>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+#include <boost/compute/command_queue.hpp>
+#include <boost/compute/algorithm/copy.hpp>
+#include <boost/compute/container/string_column.hpp>
+#include <boost/compute/container/vector.hpp>
+#include <boost/compute/types/fundamental.hpp>
+
+#include "check_macros.hpp"
+#include "context_setup.hpp"
+
+namespace bc = boost::compute;
+
+static std::vector<std::string> make_words()
+{
+    std::vector<std::string> words;
+    words.push_back("pear");
+    words.push_back("apple");
+    words.push_back("");
+    words.push_back("applesauce");
+    words.push_back("banana");
+    words.push_back("apple");
+    words.push_back("applesauces");
+    words.push_back("app");
+    return words;
+}
+
+BOOST_AUTO_TEST_CASE(construct_and_copy)
+{
+    std::vector<std::string> words = make_words();
+    bc::string_column column(words.begin(), words.end(), queue);
+
+    BOOST_CHECK_EQUAL(column.size(), words.size());
+    BOOST_CHECK_EQUAL(column.chars_size(), size_t(44));
+    CHECK_RANGE_EQUAL(bc::uint_, 4, column.offsets(), (0, 4, 9, 9));
+
+    BOOST_CHECK_EQUAL(column.get(1, queue), "apple");
+    BOOST_CHECK_EQUAL(column.get(2, queue), "");
+
+    std::vector<std::string> host(words.size());
+    column.copy_to(host.begin(), queue);
+    BOOST_CHECK(host == words);
+
+    // empty column
+    bc::string_column empty(context);
+    BOOST_CHECK(empty.empty());
+    BOOST_CHECK_EQUAL(empty.size(), size_t(0));
+}
+
+BOOST_AUTO_TEST_CASE(hash_strings)
+{
+    std::vector<std::string> words = make_words();
+    bc::string_column column(words.begin(), words.end(), queue);
+
+    bc::vector<bc::ulong_> hashes(column.size(), context);
+    column.hash(hashes.begin(), queue);
+
+    std::vector<bc::ulong_> host(hashes.size());
+    bc::copy(hashes.begin(), hashes.end(), host.begin(), queue);
+
+    // equal strings have equal hashes
+    BOOST_CHECK_EQUAL(host[1], host[5]);
+    BOOST_CHECK(host[0] != host[1]);
+    BOOST_CHECK(host[3] != host[6]);
+}
+
+BOOST_AUTO_TEST_CASE(equal_and_compare)
+{
+    std::vector<std::string> a;
+    a.push_back("abc");
+    a.push_back("abc");
+    a.push_back("abd");
+    a.push_back("ab");
+    a.push_back("");
+    a.push_back("\xff");
+
+    std::vector<std::string> b;
+    b.push_back("abc");
+    b.push_back("abd");
+    b.push_back("abc");
+    b.push_back("abc");
+    b.push_back("");
+    b.push_back("a");
+
+    bc::string_column column_a(a.begin(), a.end(), queue);
+    bc::string_column column_b(b.begin(), b.end(), queue);
+
+    bc::vector<bc::int_> result(a.size(), context);
+    column_a.equal(column_b, result.begin(), queue);
+    CHECK_RANGE_EQUAL(bc::int_, 6, result, (1, 0, 0, 0, 1, 0));
+
+    // characters compare as unsigned values
+    column_a.compare(column_b, result.begin(), queue);
+    CHECK_RANGE_EQUAL(bc::int_, 6, result, (0, -1, 1, -1, 0, 1));
+}
+
+BOOST_AUTO_TEST_CASE(prefixes)
+{
+    std::vector<std::string> words = make_words();
+    bc::string_column column(words.begin(), words.end(), queue);
+
+    bc::string_column prefixes = column.prefix(4, queue);
+    BOOST_CHECK_EQUAL(prefixes.size(), words.size());
+    BOOST_CHECK_EQUAL(prefixes.get(1, queue), "appl");
+    BOOST_CHECK_EQUAL(prefixes.get(2, queue), "");
+    BOOST_CHECK_EQUAL(prefixes.get(7, queue), "app");
+
+    bc::vector<bc::ulong_> packed(column.size(), context);
+    column.packed_prefixes(packed.begin(), queue);
+    BOOST_CHECK_EQUAL(bc::ulong_(packed[0]), bc::ulong_(0x7065617200000000ULL));
+    BOOST_CHECK_EQUAL(bc::ulong_(packed[2]), bc::ulong_(0));
+}
+
+BOOST_AUTO_TEST_CASE(sort_words)
+{
+    std::vector<std::string> words = make_words();
+    bc::string_column column(words.begin(), words.end(), queue);
+
+    bc::vector<bc::uint_> indices(context);
+    column.sort_indices(indices, queue);
+    CHECK_RANGE_EQUAL(bc::uint_, 8, indices, (2, 7, 1, 5, 3, 6, 4, 0));
+
+    column.sort(queue);
+
+    std::vector<std::string> host(words.size());
+    column.copy_to(host.begin(), queue);
+    std::sort(words.begin(), words.end());
+    BOOST_CHECK(host == words);
+}
+
+BOOST_AUTO_TEST_CASE(sort_large)
+{
+    // many strings with long common prefixes
+    std::vector<std::string> words(3000);
+    for(size_t i = 0; i < words.size(); i++){
+        words[i] = std::string(std::rand() % 3 ? "prefix/" : "prefix/common/");
+        const size_t length = std::rand() % 12;
+        for(size_t j = 0; j < length; j++){
+            words[i] += static_cast<char>('a' + std::rand() % 4);
+        }
+    }
+
+    bc::string_column column(words.begin(), words.end(), queue);
+    column.sort(queue);
+
+    std::vector<std::string> host(words.size());
+    column.copy_to(host.begin(), queue);
+    std::sort(words.begin(), words.end());
+    BOOST_CHECK(host == words);
+
+    // gather the sorted strings in reverse order
+    std::vector<bc::uint_> reverse(words.size());
+    for(size_t i = 0; i < reverse.size(); i++){
+        reverse[i] = static_cast<bc::uint_>(reverse.size() - 1 - i);
+    }
+    bc::vector<bc::uint_> indices(reverse.begin(), reverse.end(), queue);
+    bc::string_column reversed = column.gather(indices, queue);
+    BOOST_CHECK_EQUAL(reversed.get(0, queue), words.back());
+    BOOST_CHECK_EQUAL(reversed.get(words.size() - 1, queue), words.front());
+}
+
+BOOST_AUTO_TEST_CASE(sort_ties)
+{
+    // duplicates and strings which differ only in their length or after
+    // embedded null characters
+    std::vector<std::string> words;
+    for(size_t i = 0; i < 200; i++){
+        std::string word("key");
+        word.append(std::rand() % 4, '\0');
+        if(std::rand() % 2){
+            word += "/value";
+            word.append(std::rand() % 3, static_cast<char>('a' + std::rand() % 2));
+        }
+        words.push_back(word);
+    }
+
+    bc::string_column column(words.begin(), words.end(), queue);
+    column.sort(queue);
+
+    std::vector<std::string> host(words.size());
+    column.copy_to(host.begin(), queue);
+    std::sort(words.begin(), words.end());
+    BOOST_CHECK(host == words);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -12,10 +12,24 @@
 #include <boost/test/unit_test.hpp>
 
 #include <iostream>
+#include <vector>
 
 #include <boost/compute/core.hpp>
 #include <boost/compute/svm.hpp>
+#include <boost/compute/algorithm/copy.hpp>
+#include <boost/compute/algorithm/count_if.hpp>
+#include <boost/compute/algorithm/exclusive_scan.hpp>
+#include <boost/compute/algorithm/fill.hpp>
+#include <boost/compute/algorithm/find.hpp>
+#include <boost/compute/algorithm/inclusive_scan.hpp>
+#include <boost/compute/algorithm/iota.hpp>
+#include <boost/compute/algorithm/reduce.hpp>
+#include <boost/compute/algorithm/scatter.hpp>
+#include <boost/compute/algorithm/sort.hpp>
+#include <boost/compute/algorithm/sort_by_key.hpp>
+#include <boost/compute/algorithm/transform.hpp>
 #include <boost/compute/container/vector.hpp>
+#include <boost/compute/lambda.hpp>
 #include <boost/compute/utility/source.hpp>
 
 #include "quirks.hpp"
@@ -108,6 +122,137 @@ BOOST_AUTO_TEST_CASE(sum_svm_kernel)
 
     compute::svm_free(context, ptr);
 }
+
+BOOST_AUTO_TEST_CASE(transform_svm_ptr)
+{
+    REQUIRES_OPENCL_VERSION(2, 0);
+
+    cl_int data[] = { -1, 2, -3, 4, -5, 6, -7, 8 };
+    compute::svm_ptr<cl_int> input = compute::svm_alloc<cl_int>(context, 8);
+    compute::svm_ptr<cl_int> output = compute::svm_alloc<cl_int>(context, 8);
+    compute::copy(data, data + 8, input, queue);
+
+    compute::transform(input, input + 8, output, compute::abs<cl_int>(), queue);
+    compute::copy(output, output + 8, data, queue);
+    CHECK_HOST_RANGE_EQUAL(cl_int, 8, data, (1, 2, 3, 4, 5, 6, 7, 8));
+
+    // offset pointers
+    compute::transform(
+        output + 2, output + 6, output, output, compute::plus<cl_int>(), queue
+    );
+    compute::copy(output, output + 8, data, queue);
+    CHECK_HOST_RANGE_EQUAL(cl_int, 8, data, (4, 6, 8, 10, 5, 6, 7, 8));
+
+    compute::svm_free(context, input);
+    compute::svm_free(context, output);
+}
+
+BOOST_AUTO_TEST_CASE(reduce_svm_ptr)
+{
+    REQUIRES_OPENCL_VERSION(2, 0);
+
+    compute::svm_ptr<cl_int> ptr = compute::svm_alloc<cl_int>(context, 1000);
+    compute::iota(ptr, ptr + 1000, 0, queue);
+
+    cl_int sum = 0;
+    compute::reduce(ptr, ptr + 1000, &sum, queue);
+    BOOST_CHECK_EQUAL(sum, 499500);
+
+    cl_int max = 0;
+    compute::reduce(ptr, ptr + 1000, &max, compute::max<cl_int>(), queue);
+    BOOST_CHECK_EQUAL(max, 999);
+
+    using compute::lambda::_1;
+    BOOST_CHECK_EQUAL(compute::count_if(ptr, ptr + 1000, _1 < 10, queue), 10);
+    BOOST_CHECK(compute::find(ptr, ptr + 1000, 42, queue) == ptr + 42);
+
+    compute::svm_free(context, ptr);
+}
+
+BOOST_AUTO_TEST_CASE(scan_svm_ptr)
+{
+    REQUIRES_OPENCL_VERSION(2, 0);
+
+    // large enough to scan in more than one block
+    const size_t size = 1024;
+    compute::svm_ptr<cl_int> input = compute::svm_alloc<cl_int>(context, size);
+    compute::svm_ptr<cl_int> output = compute::svm_alloc<cl_int>(context, size);
+    compute::fill(input, input + size, 1, queue);
+
+    std::vector<cl_int> host(size);
+    compute::inclusive_scan(input, input + size, output, queue);
+    compute::copy(output, output + size, host.begin(), queue);
+    for(size_t i = 0; i < size; i++){
+        BOOST_CHECK_EQUAL(host[i], static_cast<cl_int>(i + 1));
+    }
+
+    compute::exclusive_scan(input, input + size, output, queue);
+    compute::copy(output, output + size, host.begin(), queue);
+    for(size_t i = 0; i < size; i++){
+        BOOST_CHECK_EQUAL(host[i], static_cast<cl_int>(i));
+    }
+
+    compute::svm_free(context, input);
+    compute::svm_free(context, output);
+}
+
+BOOST_AUTO_TEST_CASE(sort_svm_ptr)
+{
+    REQUIRES_OPENCL_VERSION(2, 0);
+
+    const size_t size = 1000;
+    std::vector<cl_int> host(size);
+    for(size_t i = 0; i < size; i++){
+        host[i] = static_cast<cl_int>((i * 7919) % size);
+    }
+
+    compute::svm_ptr<cl_int> keys = compute::svm_alloc<cl_int>(context, size);
+    compute::svm_ptr<cl_int> values = compute::svm_alloc<cl_int>(context, size);
+    compute::copy(host.begin(), host.end(), keys, queue);
+
+    compute::sort(keys, keys + size, queue);
+    compute::copy(keys, keys + size, host.begin(), queue);
+    for(size_t i = 0; i < size; i++){
+        BOOST_CHECK_EQUAL(host[i], static_cast<cl_int>(i));
+    }
+
+    // sort by key in descending order
+    compute::iota(values, values + size, 0, queue);
+    compute::sort_by_key(
+        keys, keys + size, values, compute::greater<cl_int>(), queue
+    );
+    compute::copy(values, values + size, host.begin(), queue);
+    for(size_t i = 0; i < size; i++){
+        BOOST_CHECK_EQUAL(host[i], static_cast<cl_int>(size - 1 - i));
+    }
+
+    compute::svm_free(context, keys);
+    compute::svm_free(context, values);
+}
+
+BOOST_AUTO_TEST_CASE(scatter_svm_ptr)
+{
+    REQUIRES_OPENCL_VERSION(2, 0);
+
+    cl_int data[] = { 1, 2, 3, 4 };
+    cl_uint map_data[] = { 3, 2, 1, 0 };
+    compute::svm_ptr<cl_int> input = compute::svm_alloc<cl_int>(context, 4);
+    compute::svm_ptr<cl_uint> map = compute::svm_alloc<cl_uint>(context, 4);
+    compute::svm_ptr<cl_int> output = compute::svm_alloc<cl_int>(context, 5);
+    compute::copy(data, data + 4, input, queue);
+    compute::copy(map_data, map_data + 4, map, queue);
+    compute::fill(output, output + 5, 0, queue);
+
+    compute::scatter(input, input + 4, map, output + 1, queue);
+
+    cl_int result[5];
+    compute::copy(output, output + 5, result, queue);
+    CHECK_HOST_RANGE_EQUAL(cl_int, 5, result, (0, 4, 3, 2, 1));
+
+    compute::svm_free(context, input);
+    compute::svm_free(context, map);
+    compute::svm_free(context, output);
+}
 #endif // BOOST_COMPUTE_CL_VERSION_2_0
 
 #ifdef BOOST_COMPUTE_CL_VERSION_2_1
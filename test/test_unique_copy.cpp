@@ -11,6 +11,9 @@
 #define BOOST_TEST_MODULE TestUniqueCopy
 #include <boost/test/unit_test.hpp>
 
+#include <vector>
+
+#include <boost/compute/algorithm/copy.hpp>
 #include <boost/compute/algorithm/unique_copy.hpp>
 #include <boost/compute/container/vector.hpp>
 
@@ -34,4 +37,44 @@ BOOST_AUTO_TEST_CASE(unique_copy_int)
     CHECK_RANGE_EQUAL(int, 5, result, (1, 6, 4, 2, 4));
 }
 
+BOOST_AUTO_TEST_CASE(unique_copy_large)
+{
+    // runs of 1 to 5 equal values
+    std::vector<int> host;
+    std::vector<int> expected;
+    for(int i = 0; host.size() < 5000; i++){
+        for(int j = 0; j < i % 5 + 1; j++){
+            host.push_back(i);
+        }
+        expected.push_back(i);
+    }
+
+    bc::vector<int> input(host.begin(), host.end(), queue);
+    bc::vector<int> output(host.size(), context);
+
+    bc::vector<int>::iterator iter =
+        bc::unique_copy(input.begin(), input.end(), output.begin(), queue);
+    BOOST_CHECK_EQUAL(
+        std::distance(output.begin(), iter), std::ptrdiff_t(expected.size())
+    );
+
+    std::vector<int> result(expected.size());
+    bc::copy(output.begin(), iter, result.begin(), queue);
+    BOOST_CHECK(result == expected);
+}
+
+BOOST_AUTO_TEST_CASE(unique_copy_async_int)
+{
+    int data[] = {1, 6, 6, 4, 2, 2, 4};
+
+    bc::vector<int> input(data, data + 7, queue);
+    bc::vector<int> result(5, context);
+
+    bc::future<bc::vector<int>::iterator> future =
+        bc::unique_copy_async(input.begin(), input.end(), result.begin(), queue);
+
+    BOOST_CHECK(future.get() == result.begin() + 5);
+    CHECK_RANGE_EQUAL(int, 5, result, (1, 6, 4, 2, 4));
+}
+
 BOOST_AUTO_TEST_SUITE_END()
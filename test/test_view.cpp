@@ -0,0 +1,320 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2013 Kyle Lutz <kyle.r.lutz@gmail.com>
+//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+// See http://boostorg.github.com/compute for more information.
+//---------------------------------------------------------------------------//
+
+#define BOOST_TEST_MODULE TestView
+#include <boost/test/unit_test.hpp>
+
+#include <vector>
+#include <algorithm>
+
+#include <boost/compute/lambda.hpp>
+#include <boost/compute/function.hpp>
+#include <boost/compute/functional.hpp>
+#include <boost/compute/container/vector.hpp>
+#include <boost/compute/view.hpp>
+
+#include "check_macros.hpp"
+#include "context_setup.hpp"
+
+namespace compute = boost::compute;
+namespace view = boost::compute::view;
+
+BOOST_AUTO_TEST_CASE(copy_range)
+{
+    int data[] = { 1, 2, 3, 4, 5 };
+    compute::vector<int> input(data, data + 5, queue);
+    compute::vector<int> output(5, context);
+
+    compute::vector<int>::iterator end =
+        view::copy(view::all(input), output.begin(), queue);
+    BOOST_CHECK(end == output.end());
+    CHECK_RANGE_EQUAL(int, 5, output, (1, 2, 3, 4, 5));
+}
+
+BOOST_AUTO_TEST_CASE(copy_transform)
+{
+    using compute::lambda::_1;
+
+    int data[] = { 1, 2, 3, 4, 5 };
+    compute::vector<int> input(data, data + 5, queue);
+    compute::vector<int> output(5, context);
+
+    view::copy(
+        view::all(input) | view::transform(_1 * 2) | view::transform(_1 + 1),
+        output.begin(),
+        queue
+    );
+    CHECK_RANGE_EQUAL(int, 5, output, (3, 5, 7, 9, 11));
+}
+
+BOOST_AUTO_TEST_CASE(copy_filter_transform)
+{
+    using compute::abs;
+    using compute::lambda::_1;
+
+    int data[] = { -2, -3, -4, -5, -6, -7, -8, -9 };
+    compute::vector<int> input(data, data + 8, queue);
+    compute::vector<int> output(8, context);
+
+    compute::vector<int>::iterator end = view::copy(
+        view::all(input) | view::filter(_1 % 2 != 0) | view::transform(abs<int>()),
+        output.begin(),
+        queue
+    );
+    BOOST_CHECK_EQUAL(std::distance(output.begin(), end), 4);
+    CHECK_RANGE_EQUAL(int, 4, output, (3, 5, 7, 9));
+}
+
+BOOST_AUTO_TEST_CASE(copy_transform_filter)
+{
+    using compute::lambda::_1;
+
+    int data[] = { 1, 2, 3, 4, 5, 6, 7, 8 };
+    compute::vector<int> input(data, data + 8, queue);
+    compute::vector<int> output(8, context);
+
+    // the filter is applied to the transformed values
+    compute::vector<int>::iterator end = view::copy(
+        view::filter(
+            view::transform(view::all(input), _1 * _1), _1 > 20
+        ),
+        output.begin(),
+        queue
+    );
+    BOOST_CHECK_EQUAL(std::distance(output.begin(), end), 4);
+    CHECK_RANGE_EQUAL(int, 4, output, (25, 36, 49, 64));
+}
+
+BOOST_AUTO_TEST_CASE(copy_filter_to_host)
+{
+    using compute::lambda::_1;
+
+    int data[] = { 5, 1, 4, 2, 3, 6 };
+    compute::vector<int> input(data, data + 6, queue);
+
+    std::vector<int> host(6, 0);
+    std::vector<int>::iterator end = view::copy(
+        view::all(input) | view::filter(_1 > 2) | view::filter(_1 < 6),
+        host.begin(),
+        queue
+    );
+    BOOST_CHECK_EQUAL(std::distance(host.begin(), end), 3);
+    BOOST_CHECK_EQUAL(host[0], 5);
+    BOOST_CHECK_EQUAL(host[1], 4);
+    BOOST_CHECK_EQUAL(host[2], 3);
+}
+
+BOOST_AUTO_TEST_CASE(copy_filter_none)
+{
+    using compute::lambda::_1;
+
+    int data[] = { 1, 2, 3, 4 };
+    compute::vector<int> input(data, data + 4, queue);
+    compute::vector<int> output(4, context);
+
+    compute::vector<int>::iterator end = view::copy(
+        view::all(input) | view::filter(_1 > 10), output.begin(), queue
+    );
+    BOOST_CHECK(end == output.begin());
+}
+
+BOOST_AUTO_TEST_CASE(reduce_filter_transform)
+{
+    using compute::lambda::_1;
+
+    std::vector<float> host(10000);
+    for(size_t i = 0; i < host.size(); i++){
+        host[i] = static_cast<float>(int(i % 7) - 3);
+    }
+    compute::vector<float> input(host.begin(), host.end(), queue);
+
+    float expected = 0;
+    for(size_t i = 0; i < host.size(); i++){
+        if(host[i] > 0){
+            expected += host[i] * host[i];
+        }
+    }
+
+    // device result
+    compute::vector<float> result(1, context);
+    view::reduce(
+        view::all(input) | view::filter(_1 > 0) | view::transform(_1 * _1),
+        result.begin(),
+        queue
+    );
+    BOOST_CHECK_CLOSE(float(result[0]), expected, 1e-4);
+
+    // host result
+    float sum = 0;
+    view::reduce(
+        view::all(input) | view::filter(_1 > 0) | view::transform(_1 * _1),
+        &sum,
+        queue
+    );
+    BOOST_CHECK_CLOSE(sum, expected, 1e-4);
+}
+
+BOOST_AUTO_TEST_CASE(reduce_with_function)
+{
+    using compute::lambda::_1;
+
+    std::vector<int> host(5000);
+    for(size_t i = 0; i < host.size(); i++){
+        host[i] = int((i * 7919) % 5003);
+    }
+    compute::vector<int> input(host.begin(), host.end(), queue);
+
+    int max_value = 0;
+    view::reduce(
+        view::all(input) | view::transform(_1 + 1),
+        &max_value,
+        compute::max<int>(),
+        queue
+    );
+    BOOST_CHECK_EQUAL(max_value, *std::max_element(host.begin(), host.end()) + 1);
+}
+
+BOOST_AUTO_TEST_CASE(reduce_filter_none)
+{
+    using compute::lambda::_1;
+
+    int data[] = { 1, 2, 3, 4 };
+    compute::vector<int> input(data, data + 4, queue);
+
+    // the result is not modified if no values pass the filter
+    int result = 42;
+    view::reduce(view::all(input) | view::filter(_1 > 4), &result, queue);
+    BOOST_CHECK_EQUAL(result, 42);
+
+    compute::vector<int> device_result(1, context);
+    device_result[0] = 24;
+    view::reduce(
+        view::all(input) | view::filter(_1 > 4), device_result.begin(), queue
+    );
+    BOOST_CHECK_EQUAL(int(device_result[0]), 24);
+}
+
+BOOST_AUTO_TEST_CASE(accumulate_filter)
+{
+    using compute::lambda::_1;
+
+    std::vector<int> host(3000);
+    for(size_t i = 0; i < host.size(); i++){
+        host[i] = int(i);
+    }
+    compute::vector<int> input(host.begin(), host.end(), queue);
+
+    int expected = 100;
+    for(size_t i = 0; i < host.size(); i++){
+        if(host[i] % 3 == 0){
+            expected += host[i];
+        }
+    }
+
+    BOOST_CHECK_EQUAL(
+        view::accumulate(view::all(input) | view::filter(_1 % 3 == 0), 100, queue),
+        expected
+    );
+
+    // returns init if no values pass the filter
+    BOOST_CHECK_EQUAL(
+        view::accumulate(view::all(input) | view::filter(_1 < 0), 100, queue),
+        100
+    );
+
+    // returns init for empty views
+    BOOST_CHECK_EQUAL(
+        view::accumulate(view::all(input.begin(), input.begin()), 7, queue),
+        7
+    );
+}
+
+BOOST_AUTO_TEST_CASE(count_filter)
+{
+    using compute::lambda::_1;
+
+    std::vector<int> host(4096);
+    size_t less_than_3 = 0;
+    for(size_t i = 0; i < host.size(); i++){
+        host[i] = int(i % 10);
+        if(host[i] < 3){
+            less_than_3++;
+        }
+    }
+    compute::vector<int> input(host.begin(), host.end(), queue);
+
+    BOOST_CHECK_EQUAL(view::count(view::all(input), queue), size_t(4096));
+    BOOST_CHECK_EQUAL(
+        view::count(view::all(input) | view::filter(_1 < 3), queue),
+        less_than_3
+    );
+    BOOST_CHECK_EQUAL(
+        view::count(
+            view::all(input) | view::transform(_1 * 2) | view::filter(_1 == 8),
+            queue
+        ),
+        size_t(410)
+    );
+}
+
+BOOST_AUTO_TEST_CASE(zip_transform)
+{
+    using compute::lambda::_1;
+    using compute::lambda::_2;
+
+    float a_data[] = { 1.f, 2.f, 3.f, 4.f };
+    float b_data[] = { 5.f, 6.f, 7.f, 8.f };
+    compute::vector<float> a(a_data, a_data + 4, queue);
+    compute::vector<float> b(b_data, b_data + 4, queue);
+    compute::vector<float> output(4, context);
+
+    view::copy(
+        view::zip(view::all(a), view::all(b)) | view::transform(_1 * _2),
+        output.begin(),
+        queue
+    );
+    CHECK_RANGE_EQUAL(float, 4, output, (5.f, 12.f, 21.f, 32.f));
+
+    // dot product with a single kernel
+    float dot = 0;
+    view::reduce(
+        view::zip(view::all(a), view::all(b)) | view::transform(_1 * _2),
+        &dot,
+        queue
+    );
+    BOOST_CHECK_CLOSE(dot, 70.f, 1e-4);
+
+    // filter on the zipped values
+    BOOST_CHECK_EQUAL(
+        view::count(
+            view::zip(view::all(a), view::all(b)) | view::filter(_1 + _2 > 9.f),
+            queue
+        ),
+        size_t(2)
+    );
+}
+
+BOOST_AUTO_TEST_CASE(transform_function)
+{
+    BOOST_COMPUTE_FUNCTION(float, half_value, (int x),
+    {
+        return x / 2.0f;
+    });
+
+    int data[] = { 2, 4, 6, 8, 10 };
+    compute::vector<int> input(data, data + 5, queue);
+
+    float sum = view::accumulate(
+        view::transform(view::all(input), half_value), 0.f, queue
+    );
+    BOOST_CHECK_CLOSE(sum, 15.f, 1e-4);
+}
+
+BOOST_AUTO_TEST_SUITE_END()